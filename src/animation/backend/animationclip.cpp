@@ -41,6 +41,7 @@
 #include <Qt3DAnimation/private/qanimationcliploader_p.h>
 #include <Qt3DAnimation/private/animationlogging_p.h>
 #include <Qt3DAnimation/private/managers_p.h>
+#include <Qt3DAnimation/private/mappingcache_p.h>
 #include <Qt3DAnimation/private/gltfimporter_p.h>
 #include <Qt3DCore/private/qurlhelper_p.h>
 
@@ -74,6 +75,8 @@ AnimationClip::AnimationClip()
 
 void AnimationClip::cleanup()
 {
+    if (m_handler)
+        m_handler->mappingCache()->invalidateClip(peerId());
     setEnabled(false);
     m_handler = nullptr;
     m_source.clear();
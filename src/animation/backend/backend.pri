@@ -30,7 +30,9 @@ HEADERS += \
     $$PWD/animationclip_p.h \
     $$PWD/clock_p.h \
     $$PWD/skeleton_p.h \
-    $$PWD/gltfimporter_p.h
+    $$PWD/levelofdetail_p.h \
+    $$PWD/gltfimporter_p.h \
+    $$PWD/mappingcache_p.h
 
 SOURCES += \
     $$PWD/handler.cpp \
@@ -58,4 +60,5 @@ SOURCES += \
     $$PWD/animationclip.cpp \
     $$PWD/clock.cpp \
     $$PWD/skeleton.cpp \
+    $$PWD/levelofdetail.cpp \
     $$PWD/gltfimporter.cpp
@@ -42,6 +42,7 @@
 #include <Qt3DAnimation/private/clipblendvalue_p.h>
 #include <Qt3DAnimation/private/lerpclipblend_p.h>
 #include <Qt3DAnimation/private/job_common_p.h>
+#include <Qt3DAnimation/private/mappingcache_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -89,10 +90,8 @@ void BuildBlendTreesJob::run()
         const ChannelMapper *mapper = m_handler->channelMapperManager()->lookupResource(blendClipAnimator->mapperId());
         if (!mapper)
             continue;
-        const QList<ChannelNameAndType> channelNamesAndTypes
-                = buildRequiredChannelsAndTypes(m_handler, mapper);
-        const QList<ComponentIndices> channelComponentIndices
-                = assignChannelComponentIndices(channelNamesAndTypes);
+        MappingCache *mappingCache = m_handler->mappingCache();
+        const ChannelMapperLayout mapperLayout = mappingCache->mapperLayout(mapper);
 
         // Find the leaf value nodes of the blend tree and for each of them
         // create a set of format indices that can later be used to map the
@@ -117,9 +116,7 @@ void BuildBlendTreesJob::run()
             AnimationClip *clip = m_handler->animationClipLoaderManager()->lookupResource(clipId);
             Q_ASSERT(clip);
 
-            const ClipFormat format = generateClipFormatIndices(channelNamesAndTypes,
-                                                                channelComponentIndices,
-                                                                clip);
+            const ClipFormat format = mappingCache->clipFormat(mapper, clip);
             valueNode->setClipFormat(blendClipAnimator->peerId(), format);
 
             // this BlendClipAnimator needs to be notified when the clip has been loaded
@@ -181,19 +178,10 @@ void BuildBlendTreesJob::run()
         // Finally, build the mapping data vector for this blended clip animator. This
         // gets used during the final stage of evaluation when sending the property changes
         // out to the targets of the animation. We do the costly work once up front.
-        const QList<Qt3DCore::QNodeId> channelMappingIds = mapper->mappingIds();
-        QList<ChannelMapping *> channelMappings;
-        channelMappings.reserve(channelMappingIds.size());
-        for (const auto mappingId : channelMappingIds) {
-            ChannelMapping *mapping = m_handler->channelMappingManager()->lookupResource(mappingId);
-            Q_ASSERT(mapping);
-            channelMappings.push_back(mapping);
-        }
-
         const QList<MappingData> mappingDataVec
-                = buildPropertyMappings(channelMappings,
-                                        channelNamesAndTypes,
-                                        channelComponentIndices,
+                = buildPropertyMappings(mapper->mappings(),
+                                        mapperLayout.namesAndTypes,
+                                        mapperLayout.componentIndices,
                                         blendTreeChannelMask);
         blendClipAnimator->setMappingData(mappingDataVec);
     }
@@ -40,6 +40,7 @@
 #include <Qt3DAnimation/private/qchannelmapper_p.h>
 #include <Qt3DAnimation/private/animationlogging_p.h>
 #include <Qt3DAnimation/private/managers_p.h>
+#include <Qt3DAnimation/private/mappingcache_p.h>
 
 #include <algorithm>
 
@@ -57,6 +58,8 @@ ChannelMapper::ChannelMapper()
 
 void ChannelMapper::cleanup()
 {
+    if (m_handler)
+        m_handler->mappingCache()->invalidateMapper(peerId());
     setEnabled(false);
     m_mappingIds.clear();
     m_mappings.clear();
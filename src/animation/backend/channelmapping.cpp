@@ -83,6 +83,15 @@ void ChannelMapping::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firs
     if (!node)
         return;
 
+    const MappingType oldMappingType = m_mappingType;
+    const QString oldChannelName = m_channelName;
+    const Qt3DCore::QNodeId oldTargetId = m_targetId;
+    const int oldType = m_type;
+    const char *oldPropertyName = m_propertyName;
+    const int oldComponentCount = m_componentCount;
+    const QAnimationCallback *oldCallback = m_callback;
+    const Qt3DCore::QNodeId oldSkeletonId = m_skeletonId;
+
     const QChannelMapping *channelMapping = qobject_cast<const QChannelMapping *>(frontEnd);
     if (channelMapping) {
         m_mappingType = ChannelMappingType;
@@ -111,6 +120,21 @@ void ChannelMapping::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firs
         m_callback = d->m_callback;
         m_callbackFlags = d->m_callbackFlags;
     }
+
+    // Any resolved mapping data referencing this mapping is now outdated. Only
+    // flag it when something used by the resolution changed, as this drops
+    // the whole mapping cache.
+    const bool mappingChanged = firstTime
+            || m_mappingType != oldMappingType
+            || m_channelName != oldChannelName
+            || m_targetId != oldTargetId
+            || m_type != oldType
+            || qstrcmp(m_propertyName, oldPropertyName) != 0
+            || m_componentCount != oldComponentCount
+            || m_callback != oldCallback
+            || m_skeletonId != oldSkeletonId;
+    if (mappingChanged)
+        setDirty(Handler::ChannelMappingsDirty);
 }
 
 Skeleton *ChannelMapping::skeleton() const
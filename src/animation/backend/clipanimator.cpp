@@ -42,6 +42,7 @@
 #include <Qt3DAnimation/private/animationclip_p.h>
 #include <Qt3DAnimation/private/managers_p.h>
 #include <Qt3DAnimation/private/animationlogging_p.h>
+#include <Qt3DAnimation/private/levelofdetail_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -61,6 +62,9 @@ ClipAnimator::ClipAnimator()
     , m_currentLoop(0)
     , m_normalizedLocalTime(-1.0f)
     , m_lastNormalizedLocalTime(-1.0f)
+    , m_levelOfDetailId()
+    , m_evaluationInterval(1)
+    , m_framesSinceEvaluation(0)
 {
 }
 
@@ -113,6 +117,10 @@ void ClipAnimator::cleanup()
     m_loops = 1;
     m_clipFormat = ClipFormat();
     m_normalizedLocalTime = m_lastNormalizedLocalTime = -1.0f;
+    m_levelOfDetailId = Qt3DCore::QNodeId();
+    m_levelOfDetailFrameIntervals.clear();
+    m_evaluationInterval = 1;
+    m_framesSinceEvaluation = 0;
 }
 
 void ClipAnimator::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstTime)
@@ -139,6 +147,11 @@ void ClipAnimator::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstT
     if (!qFuzzyCompare(m_normalizedLocalTime, node->normalizedTime()))
         setNormalizedLocalTime(node->normalizedTime());
 
+    // The current index itself is read from the LevelOfDetail backend
+    // when the animator is evaluated
+    m_levelOfDetailId = Qt3DCore::qIdForNode(node->levelOfDetail());
+    m_levelOfDetailFrameIntervals = node->levelOfDetailFrameIntervals();
+
     if (firstTime)
         setDirty(Handler::ClipAnimatorDirty);
 }
@@ -168,6 +181,55 @@ void ClipAnimator::setLastNormalizedLocalTime(float normalizedTime)
     m_lastNormalizedLocalTime = normalizedTime;
 }
 
+void ClipAnimator::setEvaluationInterval(int evaluationInterval)
+{
+    m_evaluationInterval = evaluationInterval;
+    // Offset animators sharing the same interval so that their
+    // evaluations get spread over the frames of the interval
+    m_framesSinceEvaluation = evaluationInterval > 1
+            ? int(peerId().id() % quint64(evaluationInterval))
+            : 0;
+}
+
+// Called once per frame for running animators. Returns true if the animator
+// has to be evaluated this frame. Skipped frames still advance the animator's
+// time since the next evaluation computes the elapsed time from the last
+// evaluated frame.
+bool ClipAnimator::advanceEvaluationFrame()
+{
+    const int evaluationInterval = levelOfDetailEvaluationInterval();
+    if (m_evaluationInterval != evaluationInterval)
+        setEvaluationInterval(evaluationInterval);
+
+    if (m_evaluationInterval == 1 || isSeeking()) {
+        m_framesSinceEvaluation = 0;
+        return true;
+    }
+
+    // Frozen
+    if (m_evaluationInterval <= 0)
+        return false;
+
+    if (++m_framesSinceEvaluation < m_evaluationInterval)
+        return false;
+
+    m_framesSinceEvaluation = 0;
+    return true;
+}
+
+// Returns the evaluation interval matching the current index of the
+// LevelOfDetail backend, or 1 if the animator isn't level of detail driven
+int ClipAnimator::levelOfDetailEvaluationInterval() const
+{
+    if (m_levelOfDetailId.isNull() || m_levelOfDetailFrameIntervals.isEmpty() || !m_handler)
+        return 1;
+
+    const LevelOfDetail *levelOfDetail = m_handler->levelOfDetailManager()->lookupResource(m_levelOfDetailId);
+    const int currentIndex = levelOfDetail ? levelOfDetail->currentIndex() : 0;
+    const int index = qBound(0, currentIndex, int(m_levelOfDetailFrameIntervals.size()) - 1);
+    return m_levelOfDetailFrameIntervals.at(index);
+}
+
 } // namespace Animation
 } // namespace Qt3DAnimation
 
@@ -112,7 +112,16 @@ public:
                 && !qFuzzyCompare(m_lastNormalizedLocalTime, m_normalizedLocalTime);
     }
 
+    Qt3DCore::QNodeId levelOfDetailId() const { return m_levelOfDetailId; }
+    QList<int> levelOfDetailFrameIntervals() const { return m_levelOfDetailFrameIntervals; }
+
+    void setEvaluationInterval(int evaluationInterval);
+    int evaluationInterval() const { return m_evaluationInterval; }
+    bool advanceEvaluationFrame();
+
 private:
+    int levelOfDetailEvaluationInterval() const;
+
     Qt3DCore::QNodeId m_clipId;
     Qt3DCore::QNodeId m_mapperId;
     Qt3DCore::QNodeId m_clockId;
@@ -129,6 +138,12 @@ private:
 
     float m_normalizedLocalTime;
     float m_lastNormalizedLocalTime;
+
+    // Level of detail
+    Qt3DCore::QNodeId m_levelOfDetailId;
+    QList<int> m_levelOfDetailFrameIntervals;
+    int m_evaluationInterval;
+    int m_framesSinceEvaluation;
 };
 
 } // namespace Animation
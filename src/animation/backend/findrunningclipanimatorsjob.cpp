@@ -39,6 +39,7 @@
 #include <Qt3DAnimation/private/managers_p.h>
 #include <Qt3DAnimation/private/animationlogging_p.h>
 #include <Qt3DAnimation/private/animationutils_p.h>
+#include <Qt3DAnimation/private/mappingcache_p.h>
 #include <Qt3DAnimation/private/job_common_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -74,8 +75,6 @@ void FindRunningClipAnimatorsJob::run()
         const bool seeking = clipAnimator->isSeeking();
         m_handler->setClipAnimatorRunning(clipAnimatorHandle, canRun && (seeking || running));
 
-        // TODO: Actually check if this is needed first, currently we re-build this every time
-        // canRun (or the normalized time) is true.
         if (!canRun || !(seeking || running))
             continue;
 
@@ -85,25 +84,14 @@ void FindRunningClipAnimatorsJob::run()
         // blended clip animator for consistency and ease of maintenance.
         const ChannelMapper *mapper = m_handler->channelMapperManager()->lookupResource(clipAnimator->mapperId());
         Q_ASSERT(mapper);
-        const QList<ChannelMapping *> channelMappings = mapper->mappings();
-
-        const QList<ChannelNameAndType> channelNamesAndTypes
-                = buildRequiredChannelsAndTypes(m_handler, mapper);
-        const QList<ComponentIndices> channelComponentIndices
-                = assignChannelComponentIndices(channelNamesAndTypes);
-
         const AnimationClip *clip = m_handler->animationClipLoaderManager()->lookupResource(clipAnimator->clipId());
         Q_ASSERT(clip);
-        const ClipFormat format = generateClipFormatIndices(channelNamesAndTypes,
-                                                            channelComponentIndices,
-                                                            clip);
-        clipAnimator->setClipFormat(format);
 
-        const QList<MappingData> mappingData = buildPropertyMappings(channelMappings,
-                                                                       channelNamesAndTypes,
-                                                                       format.formattedComponentIndices,
-                                                                       format.sourceClipMask);
-        clipAnimator->setMappingData(mappingData);
+        // The resolution only depends on the mapper and the clip, reuse it if another
+        // animator (or this one, before a clip switch) already resolved that pair
+        const ClipMapping clipMapping = m_handler->mappingCache()->clipMapping(mapper, clip);
+        clipAnimator->setClipFormat(clipMapping.format);
+        clipAnimator->setMappingData(clipMapping.mappingData);
     }
 
     qCDebug(Jobs) << "Running clip animators =" << m_handler->runningClipAnimators();
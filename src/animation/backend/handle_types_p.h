@@ -64,6 +64,7 @@ class BlendedClipAnimator;
 class ChannelMapping;
 class ChannelMapper;
 class Skeleton;
+class LevelOfDetail;
 
 typedef Qt3DCore::QHandle<AnimationClip> HAnimationClip;
 typedef Qt3DCore::QHandle<ClipAnimator> HClipAnimator;
@@ -71,6 +72,7 @@ typedef Qt3DCore::QHandle<BlendedClipAnimator> HBlendedClipAnimator;
 typedef Qt3DCore::QHandle<ChannelMapping> HChannelMapping;
 typedef Qt3DCore::QHandle<ChannelMapper> HChannelMapper;
 typedef Qt3DCore::QHandle<Skeleton> HSkeleton;
+typedef Qt3DCore::QHandle<LevelOfDetail> HLevelOfDetail;
 
 } // namespace Animation
 } // namespace Qt3DAnimation
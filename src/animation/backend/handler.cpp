@@ -36,6 +36,7 @@
 
 #include "handler_p.h"
 #include <Qt3DAnimation/private/managers_p.h>
+#include <Qt3DAnimation/private/mappingcache_p.h>
 #include <Qt3DAnimation/private/loadanimationclipjob_p.h>
 #include <Qt3DAnimation/private/findrunningclipanimatorsjob_p.h>
 #include <Qt3DAnimation/private/evaluateclipanimatorjob_p.h>
@@ -60,6 +61,8 @@ Handler::Handler()
     , m_channelMapperManager(new ChannelMapperManager)
     , m_clipBlendNodeManager(new ClipBlendNodeManager)
     , m_skeletonManager(new SkeletonManager)
+    , m_levelOfDetailManager(new LevelOfDetailManager)
+    , m_mappingCache(new MappingCache(this))
     , m_loadAnimationClipJob(new LoadAnimationClipJob)
     , m_findRunningClipAnimatorsJob(new FindRunningClipAnimatorsJob)
     , m_buildBlendTreesJob(new BuildBlendTreesJob)
@@ -81,10 +84,13 @@ void Handler::setDirty(DirtyFlag flag, Qt3DCore::QNodeId nodeId)
         QMutexLocker lock(&m_mutex);
         const auto handle = m_animationClipLoaderManager->lookupHandle(nodeId);
         m_dirtyAnimationClips.push_back(handle);
+        // The channels of the clip will change once it has been reloaded
+        m_mappingCache->invalidateClip(nodeId);
         break;
     }
 
     case ChannelMappingsDirty: {
+        m_mappingCache->invalidate();
         break;
     }
 
@@ -228,9 +234,26 @@ std::vector<Qt3DCore::QAspectJobPtr> Handler::jobsToExecute(qint64 time)
     if (!m_runningClipAnimators.isEmpty()) {
         qCDebug(HandlerLogic) << "Added EvaluateClipAnimatorJobs";
 
+        // Skip the animators whose level of detail does not require
+        // an evaluation this frame. Animators frozen by their level of detail
+        // are never evaluated and so can't remove themselves from the running
+        // set once stopped or disabled, drop them here instead.
+        QList<HClipAnimator> clipAnimatorsToEvaluate;
+        clipAnimatorsToEvaluate.reserve(m_runningClipAnimators.size());
+        for (auto it = m_runningClipAnimators.begin(); it != m_runningClipAnimators.end();) {
+            ClipAnimator *clipAnimator = m_clipAnimatorManager->data(*it);
+            if (!clipAnimator->isEnabled() || (!clipAnimator->isRunning() && !clipAnimator->isSeeking())) {
+                it = m_runningClipAnimators.erase(it);
+                continue;
+            }
+            if (clipAnimator->advanceEvaluationFrame())
+                clipAnimatorsToEvaluate.push_back(*it);
+            ++it;
+        }
+
         // Ensure we have a job per clip animator
         const int oldSize = m_evaluateClipAnimatorJobs.size();
-        const int newSize = m_runningClipAnimators.size();
+        const int newSize = clipAnimatorsToEvaluate.size();
         if (oldSize < newSize) {
             m_evaluateClipAnimatorJobs.resize(newSize);
             for (int i = oldSize; i < newSize; ++i) {
@@ -241,7 +264,7 @@ std::vector<Qt3DCore::QAspectJobPtr> Handler::jobsToExecute(qint64 time)
 
         // Set each job up with an animator to process and set dependencies
         for (int i = 0; i < newSize; ++i) {
-            m_evaluateClipAnimatorJobs[i]->setClipAnimator(m_runningClipAnimators[i]);
+            m_evaluateClipAnimatorJobs[i]->setClipAnimator(clipAnimatorsToEvaluate[i]);
             Qt3DCore::QAspectJobPrivate::get(m_evaluateClipAnimatorJobs[i].data())->clearDependencies();
             if (hasLoadAnimationClipJob)
                 m_evaluateClipAnimatorJobs[i]->addDependency(m_loadAnimationClipJob);
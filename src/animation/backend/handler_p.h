@@ -77,6 +77,8 @@ class ChannelMapper;
 class ChannelMapperManager;
 class ClipBlendNodeManager;
 class SkeletonManager;
+class LevelOfDetailManager;
+class MappingCache;
 
 class FindRunningClipAnimatorsJob;
 class LoadAnimationClipJob;
@@ -118,6 +120,8 @@ public:
     ChannelMapperManager *channelMapperManager() const Q_DECL_NOTHROW { return m_channelMapperManager.data(); }
     ClipBlendNodeManager *clipBlendNodeManager() const Q_DECL_NOTHROW { return m_clipBlendNodeManager.data(); }
     SkeletonManager *skeletonManager() const Q_DECL_NOTHROW { return m_skeletonManager.data(); }
+    LevelOfDetailManager *levelOfDetailManager() const Q_DECL_NOTHROW { return m_levelOfDetailManager.data(); }
+    MappingCache *mappingCache() const Q_DECL_NOTHROW { return m_mappingCache.data(); }
 
     std::vector<Qt3DCore::QAspectJobPtr> jobsToExecute(qint64 time);
 
@@ -135,6 +139,8 @@ private:
     QScopedPointer<ChannelMapperManager> m_channelMapperManager;
     QScopedPointer<ClipBlendNodeManager> m_clipBlendNodeManager;
     QScopedPointer<SkeletonManager> m_skeletonManager;
+    QScopedPointer<LevelOfDetailManager> m_levelOfDetailManager;
+    QScopedPointer<MappingCache> m_mappingCache;
 
     QList<HAnimationClip> m_dirtyAnimationClips;
     QList<HClipAnimator> m_dirtyClipAnimators;
@@ -60,6 +60,7 @@
 #include <Qt3DAnimation/private/channelmapping_p.h>
 #include <Qt3DAnimation/private/channelmapper_p.h>
 #include <Qt3DAnimation/private/skeleton_p.h>
+#include <Qt3DAnimation/private/levelofdetail_p.h>
 #include <Qt3DCore/private/qresourcemanager_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -140,6 +141,14 @@ public:
     SkeletonManager() {}
 };
 
+class LevelOfDetailManager : public Qt3DCore::QResourceManager<
+        LevelOfDetail,
+        Qt3DCore::QNodeId>
+{
+public:
+    LevelOfDetailManager() {}
+};
+
 } // namespace Animation
 } // namespace Qt3DAnimation
 
@@ -149,6 +158,7 @@ Q_DECLARE_RESOURCE_INFO(Qt3DAnimation::Animation::BlendedClipAnimator, Q_REQUIRE
 Q_DECLARE_RESOURCE_INFO(Qt3DAnimation::Animation::ChannelMapping, Q_REQUIRES_CLEANUP)
 Q_DECLARE_RESOURCE_INFO(Qt3DAnimation::Animation::ChannelMapper, Q_REQUIRES_CLEANUP)
 Q_DECLARE_RESOURCE_INFO(Qt3DAnimation::Animation::Skeleton, Q_REQUIRES_CLEANUP)
+Q_DECLARE_RESOURCE_INFO(Qt3DAnimation::Animation::LevelOfDetail, Q_REQUIRES_CLEANUP)
 
 QT_END_NAMESPACE
 
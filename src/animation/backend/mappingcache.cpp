@@ -0,0 +1,155 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "mappingcache_p.h"
+#include <Qt3DAnimation/private/animationclip_p.h>
+#include <Qt3DAnimation/private/channelmapper_p.h>
+#include <Qt3DAnimation/private/handler_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DAnimation {
+namespace Animation {
+
+MappingCache::MappingCache(Handler *handler)
+    : m_handler(handler)
+{
+}
+
+ChannelMapperLayout MappingCache::mapperLayout(const ChannelMapper *mapper)
+{
+    QMutexLocker lock(&m_mutex);
+    return mapperLayoutLocked(mapper);
+}
+
+ClipFormat MappingCache::clipFormat(const ChannelMapper *mapper, const AnimationClip *clip)
+{
+    QMutexLocker lock(&m_mutex);
+    return clipMappingEntryLocked(mapper, clip).mapping.format;
+}
+
+ClipMapping MappingCache::clipMapping(const ChannelMapper *mapper, const AnimationClip *clip)
+{
+    QMutexLocker lock(&m_mutex);
+    ClipMappingEntry &entry = clipMappingEntryLocked(mapper, clip);
+    if (!entry.hasMappingData) {
+        const ChannelMapperLayout &layout = mapperLayoutLocked(mapper);
+        entry.mapping.mappingData = buildPropertyMappings(mapper->mappings(),
+                                                          layout.namesAndTypes,
+                                                          entry.mapping.format.formattedComponentIndices,
+                                                          entry.mapping.format.sourceClipMask);
+        entry.hasMappingData = true;
+    }
+    return entry.mapping;
+}
+
+// Called when a mapper, a mapping or a skeleton used by a mapping changed
+void MappingCache::invalidate()
+{
+    QMutexLocker lock(&m_mutex);
+    m_mapperLayouts.clear();
+    m_clipMappings.clear();
+}
+
+// Called when a clip is about to be (re)loaded or has been destroyed
+void MappingCache::invalidateClip(Qt3DCore::QNodeId clipId)
+{
+    QMutexLocker lock(&m_mutex);
+    for (auto it = m_clipMappings.begin(); it != m_clipMappings.end(); ) {
+        if (it.key().second == clipId)
+            it = m_clipMappings.erase(it);
+        else
+            ++it;
+    }
+}
+
+// Called when a mapper has been destroyed
+void MappingCache::invalidateMapper(Qt3DCore::QNodeId mapperId)
+{
+    QMutexLocker lock(&m_mutex);
+    m_mapperLayouts.remove(mapperId);
+    for (auto it = m_clipMappings.begin(); it != m_clipMappings.end(); ) {
+        if (it.key().first == mapperId)
+            it = m_clipMappings.erase(it);
+        else
+            ++it;
+    }
+}
+
+int MappingCache::mapperLayoutCount() const
+{
+    QMutexLocker lock(&m_mutex);
+    return int(m_mapperLayouts.size());
+}
+
+int MappingCache::clipMappingCount() const
+{
+    QMutexLocker lock(&m_mutex);
+    return int(m_clipMappings.size());
+}
+
+const ChannelMapperLayout &MappingCache::mapperLayoutLocked(const ChannelMapper *mapper)
+{
+    auto it = m_mapperLayouts.find(mapper->peerId());
+    if (it == m_mapperLayouts.end()) {
+        ChannelMapperLayout layout;
+        layout.namesAndTypes = buildRequiredChannelsAndTypes(m_handler, mapper);
+        layout.componentIndices = assignChannelComponentIndices(layout.namesAndTypes);
+        it = m_mapperLayouts.insert(mapper->peerId(), layout);
+    }
+    return it.value();
+}
+
+MappingCache::ClipMappingEntry &MappingCache::clipMappingEntryLocked(const ChannelMapper *mapper,
+                                                                     const AnimationClip *clip)
+{
+    const ClipMappingKey key(mapper->peerId(), clip->peerId());
+    auto it = m_clipMappings.find(key);
+    if (it == m_clipMappings.end()) {
+        const ChannelMapperLayout &layout = mapperLayoutLocked(mapper);
+        ClipMappingEntry entry;
+        entry.mapping.format = generateClipFormatIndices(layout.namesAndTypes,
+                                                         layout.componentIndices,
+                                                         clip);
+        it = m_clipMappings.insert(key, entry);
+    }
+    return it.value();
+}
+
+} // namespace Animation
+} // namespace Qt3DAnimation
+
+QT_END_NAMESPACE
@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL3$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or later as published by the Free
+** Software Foundation and appearing in the file LICENSE.GPL included in
+** the packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 2.0 requirements will be
+** met: http://www.gnu.org/licenses/gpl-2.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DANIMATION_ANIMATION_MAPPINGCACHE_P_H
+#define QT3DANIMATION_ANIMATION_MAPPINGCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DAnimation/private/animationutils_p.h>
+#include <Qt3DCore/qnodeid.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DAnimation {
+namespace Animation {
+
+class Handler;
+class AnimationClip;
+class ChannelMapper;
+
+struct ChannelMapperLayout
+{
+    QList<ChannelNameAndType> namesAndTypes;
+    QList<ComponentIndices> componentIndices;
+};
+
+struct ClipMapping
+{
+    ClipFormat format;
+    QList<MappingData> mappingData;
+};
+
+// Resolving the channels of a mapper against the channels of a clip involves
+// many string comparisons. The results only depend on the mapper (and its
+// mappings and skeletons) and on the clip, so they are computed once and then
+// shared between all animators using the same (mapper, clip) pair. Switching
+// the clip of an animator to an already resolved clip is then only a matter
+// of copying implicitly shared containers.
+class Q_AUTOTEST_EXPORT MappingCache
+{
+public:
+    explicit MappingCache(Handler *handler);
+
+    ChannelMapperLayout mapperLayout(const ChannelMapper *mapper);
+    ClipFormat clipFormat(const ChannelMapper *mapper, const AnimationClip *clip);
+    ClipMapping clipMapping(const ChannelMapper *mapper, const AnimationClip *clip);
+
+    void invalidate();
+    void invalidateClip(Qt3DCore::QNodeId clipId);
+    void invalidateMapper(Qt3DCore::QNodeId mapperId);
+
+    int mapperLayoutCount() const;
+    int clipMappingCount() const;
+
+private:
+    struct ClipMappingEntry
+    {
+        ClipMapping mapping;
+        bool hasMappingData = false;
+    };
+    using ClipMappingKey = QPair<Qt3DCore::QNodeId, Qt3DCore::QNodeId>;
+
+    const ChannelMapperLayout &mapperLayoutLocked(const ChannelMapper *mapper);
+    ClipMappingEntry &clipMappingEntryLocked(const ChannelMapper *mapper, const AnimationClip *clip);
+
+    Handler *m_handler;
+    mutable QMutex m_mutex;
+    QHash<Qt3DCore::QNodeId, ChannelMapperLayout> m_mapperLayouts;
+    QHash<ClipMappingKey, ClipMappingEntry> m_clipMappings;
+};
+
+} // namespace Animation
+} // namespace Qt3DAnimation
+
+QT_END_NAMESPACE
+
+#endif // QT3DANIMATION_ANIMATION_MAPPINGCACHE_P_H
@@ -72,9 +72,12 @@ void Skeleton::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstTime)
 
     auto dnode = Qt3DCore::QAbstractSkeletonPrivate::get(node);
 
-    // TODO: Mark joint info as dirty so we can rebuild any indexes used
+    // Mark joint info as dirty so we can rebuild any indexes used
     // by the animators and channel mappings.
-    m_jointNames = dnode->m_jointNames;
+    if (m_jointNames != dnode->m_jointNames) {
+        m_jointNames = dnode->m_jointNames;
+        setDirty(Handler::ChannelMappingsDirty);
+    }
     m_jointLocalPoses = dnode->m_localPoses;
 }
 
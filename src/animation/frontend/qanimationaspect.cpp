@@ -55,7 +55,9 @@
 #include <Qt3DAnimation/private/clipblendvalue_p.h>
 #include <Qt3DAnimation/private/additiveclipblend_p.h>
 #include <Qt3DAnimation/private/skeleton_p.h>
+#include <Qt3DAnimation/private/levelofdetail_p.h>
 #include <Qt3DCore/qabstractskeleton.h>
+#include <Qt3DRender/qlevelofdetail.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -128,6 +130,11 @@ QAnimationAspect::QAnimationAspect(QAnimationAspectPrivate &dd, QObject *parent)
     registerBackendType<Qt3DCore::QAbstractSkeleton>(
         QSharedPointer<Animation::NodeFunctor<Animation::Skeleton, Animation::SkeletonManager>>::create(d->m_handler.data(),
                                                                                                         d->m_handler->skeletonManager()));
+    // The animators evaluated at a level of detail driven rate read the current index of
+    // the level of detail from this backend rather than from the frontend
+    registerBackendType<Qt3DRender::QLevelOfDetail>(
+        QSharedPointer<Animation::NodeFunctor<Animation::LevelOfDetail, Animation::LevelOfDetailManager>>::create(d->m_handler.data(),
+                                                                                                                  d->m_handler->levelOfDetailManager()));
 }
 
 /*! \internal */
@@ -50,6 +50,7 @@ namespace Qt3DAnimation {
 QClipAnimatorPrivate::QClipAnimatorPrivate()
     : Qt3DAnimation::QAbstractClipAnimatorPrivate()
     , m_clip(nullptr)
+    , m_levelOfDetail(nullptr)
 {
 }
 
@@ -83,6 +84,10 @@ bool QClipAnimatorPrivate::canPlay() const
     The properties for controlling the animator are provided by the AbstractClipAnimator base
     class.
 
+    To reduce the cost of animators whose targets are far away, a LevelOfDetail can be assigned
+    to the levelOfDetail property. The current index of that LevelOfDetail then selects an
+    entry of levelOfDetailFrameIntervals, which controls how often the animator is evaluated.
+
     \sa {Qt3DAnimation::QAbstractClipAnimator}{AbstractClipAnimator}, {Qt3DAnimation::QAbstractAnimationClip}{AbstractAnimationClip}, {Qt3DAnimation::QChannelMapper}{ChannelMapper}, {Qt3DAnimation::QBlendedClipAnimator}{BlendedClipAnimator}
 */
 
@@ -107,6 +112,11 @@ bool QClipAnimatorPrivate::canPlay() const
     The properties for controlling the animator are provided by the QAbstractClipAnimator base
     class.
 
+    To reduce the cost of animators whose targets are far away, a Qt3DRender::QLevelOfDetail can
+    be assigned to the levelOfDetail property. The current index of that QLevelOfDetail then
+    selects an entry of levelOfDetailFrameIntervals, which controls how often the animator is
+    evaluated.
+
     \sa Qt3DAnimation::QAbstractClipAnimator, Qt3DAnimation::QAbstractAnimationClip,
         Qt3DAnimation::QChannelMapper, Qt3DAnimation::QBlendedClipAnimator
 */
@@ -163,6 +173,87 @@ void QClipAnimator::setClip(QAbstractAnimationClip *clip)
     emit clipChanged(clip);
 }
 
+/*!
+    \qmlproperty LevelOfDetail Qt3D.Animation::ClipAnimator::levelOfDetail
+    \since 6.0
+
+    This property holds the LevelOfDetail whose current index selects the evaluation
+    rate of the animator from levelOfDetailFrameIntervals. The LevelOfDetail is usually
+    aggregated by the same Entity as the animator.
+*/
+/*!
+    \property QClipAnimator::levelOfDetail
+    \since 6.0
+
+    This property holds the Qt3DRender::QLevelOfDetail whose current index selects the
+    evaluation rate of the animator from levelOfDetailFrameIntervals. The QLevelOfDetail is
+    usually aggregated by the same QEntity as the animator.
+*/
+Qt3DRender::QLevelOfDetail *QClipAnimator::levelOfDetail() const
+{
+    Q_D(const QClipAnimator);
+    return d->m_levelOfDetail;
+}
+
+/*!
+    \qmlproperty list<int> Qt3D.Animation::ClipAnimator::levelOfDetailFrameIntervals
+    \since 6.0
+
+    This property holds, for each index of the levelOfDetail, the number of frames between two
+    evaluations of the animator. An interval of 1 evaluates the animator every frame, an interval
+    of 0 freezes it. Indices past the end of the list use the last interval. When the list is
+    empty or no levelOfDetail is set, the animator is evaluated every frame.
+
+    Time keeps advancing while evaluations are skipped, so when an animator is evaluated
+    again it jumps to the correct position in the clip.
+*/
+/*!
+    \property QClipAnimator::levelOfDetailFrameIntervals
+    \since 6.0
+
+    This property holds, for each index of the levelOfDetail, the number of frames between two
+    evaluations of the animator. An interval of 1 evaluates the animator every frame, an interval
+    of 0 freezes it. Indices past the end of the list use the last interval. When the list is
+    empty or no levelOfDetail is set, the animator is evaluated every frame.
+
+    Time keeps advancing while evaluations are skipped, so when an animator is evaluated
+    again it jumps to the correct position in the clip.
+*/
+QList<int> QClipAnimator::levelOfDetailFrameIntervals() const
+{
+    Q_D(const QClipAnimator);
+    return d->m_levelOfDetailFrameIntervals;
+}
+
+void QClipAnimator::setLevelOfDetail(Qt3DRender::QLevelOfDetail *levelOfDetail)
+{
+    Q_D(QClipAnimator);
+    if (d->m_levelOfDetail == levelOfDetail)
+        return;
+
+    if (d->m_levelOfDetail)
+        d->unregisterDestructionHelper(d->m_levelOfDetail);
+
+    if (levelOfDetail && !levelOfDetail->parent())
+        levelOfDetail->setParent(this);
+    d->m_levelOfDetail = levelOfDetail;
+
+    // Ensures proper bookkeeping
+    if (d->m_levelOfDetail)
+        d->registerDestructionHelper(d->m_levelOfDetail, &QClipAnimator::setLevelOfDetail, d->m_levelOfDetail);
+    emit levelOfDetailChanged(levelOfDetail);
+}
+
+void QClipAnimator::setLevelOfDetailFrameIntervals(const QList<int> &intervals)
+{
+    Q_D(QClipAnimator);
+    if (d->m_levelOfDetailFrameIntervals == intervals)
+        return;
+
+    d->m_levelOfDetailFrameIntervals = intervals;
+    emit levelOfDetailFrameIntervalsChanged(intervals);
+}
+
 } // namespace Qt3DAnimation
 
 QT_END_NAMESPACE
@@ -43,6 +43,7 @@
 #include <Qt3DAnimation/qt3danimation_global.h>
 #include <Qt3DAnimation/qabstractclipanimator.h>
 #include <Qt3DAnimation/qabstractanimationclip.h>
+#include <Qt3DRender/qlevelofdetail.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -54,18 +55,26 @@ class Q_3DANIMATIONSHARED_EXPORT QClipAnimator : public Qt3DAnimation::QAbstract
 {
     Q_OBJECT
     Q_PROPERTY(Qt3DAnimation::QAbstractAnimationClip *clip READ clip WRITE setClip NOTIFY clipChanged)
+    Q_PROPERTY(Qt3DRender::QLevelOfDetail *levelOfDetail READ levelOfDetail WRITE setLevelOfDetail NOTIFY levelOfDetailChanged)
+    Q_PROPERTY(QList<int> levelOfDetailFrameIntervals READ levelOfDetailFrameIntervals WRITE setLevelOfDetailFrameIntervals NOTIFY levelOfDetailFrameIntervalsChanged)
 
 public:
     explicit QClipAnimator(Qt3DCore::QNode *parent = nullptr);
     ~QClipAnimator();
 
     Qt3DAnimation::QAbstractAnimationClip *clip() const;
+    Qt3DRender::QLevelOfDetail *levelOfDetail() const;
+    QList<int> levelOfDetailFrameIntervals() const;
 
 public Q_SLOTS:
     void setClip(Qt3DAnimation::QAbstractAnimationClip *clip);
+    void setLevelOfDetail(Qt3DRender::QLevelOfDetail *levelOfDetail);
+    void setLevelOfDetailFrameIntervals(const QList<int> &intervals);
 
 Q_SIGNALS:
     void clipChanged(Qt3DAnimation::QAbstractAnimationClip *clip);
+    void levelOfDetailChanged(Qt3DRender::QLevelOfDetail *levelOfDetail);
+    void levelOfDetailFrameIntervalsChanged(const QList<int> &intervals);
 
 protected:
     QClipAnimator(QClipAnimatorPrivate &dd, Qt3DCore::QNode *parent = nullptr);
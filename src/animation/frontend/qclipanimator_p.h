@@ -55,6 +55,10 @@
 
 QT_BEGIN_NAMESPACE
 
+namespace Qt3DRender {
+class QLevelOfDetail;
+}
+
 namespace Qt3DAnimation {
 
 class QAbstractAnimationClip;
@@ -69,6 +73,8 @@ public:
     Q_DECLARE_PUBLIC(QClipAnimator)
 
     QAbstractAnimationClip *m_clip;
+    Qt3DRender::QLevelOfDetail *m_levelOfDetail;
+    QList<int> m_levelOfDetailFrameIntervals;
 };
 
 struct QClipAnimatorData : public QAbstractClipAnimatorData
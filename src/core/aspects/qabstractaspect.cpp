@@ -54,6 +54,10 @@
 #include <Qt3DCore/private/qscene_p.h>
 #include <Qt3DCore/private/qnode_p.h>
 
+#if QT_CONFIG(concurrent)
+#include <QtConcurrent/QtConcurrent>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DCore {
@@ -175,12 +179,14 @@ void QAbstractAspect::registerBackendType(const QMetaObject &obj, const QBackend
 {
     Q_D(QAbstractAspect);
     d->m_backendCreatorFunctors.insert(&obj, functor);
+    d->m_resolvedMappers.clear();
 }
 
 void QAbstractAspect::unregisterBackendType(const QMetaObject &obj)
 {
     Q_D(QAbstractAspect);
     d->m_backendCreatorFunctors.remove(&obj);
+    d->m_resolvedMappers.clear();
 }
 
 QVariant QAbstractAspect::executeCommand(const QStringList &args)
@@ -198,16 +204,33 @@ std::vector<QAspectJobPtr> QAbstractAspect::jobsToExecute(qint64 time)
 QBackendNodeMapperPtr QAbstractAspectPrivate::mapperForNode(const QMetaObject *metaObj) const
 {
     Q_ASSERT(metaObj);
-    QBackendNodeMapperPtr mapper;
 
-    while (metaObj != nullptr && mapper.isNull()) {
-        mapper = m_backendCreatorFunctors.value(metaObj);
-        metaObj = metaObj->superClass();
+    // Only called from the main thread while the aspect jobs aren't running
+    const auto it = m_resolvedMappers.constFind(metaObj);
+    if (it != m_resolvedMappers.cend())
+        return it.value();
+
+    QBackendNodeMapperPtr mapper;
+    const QMetaObject *superClass = metaObj;
+    while (superClass != nullptr && mapper.isNull()) {
+        mapper = m_backendCreatorFunctors.value(superClass);
+        superClass = superClass->superClass();
     }
+    m_resolvedMappers.insert(metaObj, mapper);
     return mapper;
 }
 
 void QAbstractAspectPrivate::syncDirtyFrontEndNodes(const QList<QNode *> &nodes)
+{
+    std::vector<ConcurrentNodeSync> concurrentSyncs;
+    syncDirtyFrontEndNodes(nodes, concurrentSyncs);
+    syncConcurrentNodes(concurrentSyncs);
+}
+
+// Syncs the nodes whose backends require it to happen sequentially and
+// appends the other ones to concurrentSyncs
+void QAbstractAspectPrivate::syncDirtyFrontEndNodes(const QList<QNode *> &nodes,
+                                                    std::vector<ConcurrentNodeSync> &concurrentSyncs)
 {
     for (auto node: qAsConst(nodes)) {
         const QMetaObject *metaObj = QNodePrivate::get(node)->m_typeInfo;
@@ -220,8 +243,41 @@ void QAbstractAspectPrivate::syncDirtyFrontEndNodes(const QList<QNode *> &nodes)
         if (!backend)
             continue;
 
-        syncDirtyFrontEndNode(node, backend, false);
+        if (QBackendNodePrivate::get(backend)->m_threadSafeSync)
+            concurrentSyncs.push_back({ this, node, backend, false });
+        else
+            syncDirtyFrontEndNode(node, backend, false);
+    }
+}
+
+void QAbstractAspectPrivate::syncConcurrentNodes(std::vector<ConcurrentNodeSync> &syncs)
+{
+    const auto syncRange = [&syncs] (size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const ConcurrentNodeSync &sync = syncs[i];
+            sync.aspect->syncDirtyFrontEndNode(sync.node, sync.backend, sync.firstTime);
+        }
+    };
+
+#if QT_CONFIG(concurrent)
+    // Below this, dispatching to the thread pool costs more than it saves
+    const size_t minConcurrentSyncCount = 1024;
+    const size_t syncChunkSize = 256;
+
+    if (syncs.size() >= minConcurrentSyncCount) {
+        std::vector<std::pair<size_t, size_t>> chunks;
+        chunks.reserve(syncs.size() / syncChunkSize + 1);
+        for (size_t i = 0; i < syncs.size(); i += syncChunkSize)
+            chunks.push_back({ i, std::min(i + syncChunkSize, syncs.size()) });
+
+        QtConcurrent::blockingMap(chunks, [&syncRange] (const std::pair<size_t, size_t> &chunk) {
+            syncRange(chunk.first, chunk.second);
+        });
+        return;
     }
+#endif
+
+    syncRange(0, syncs.size());
 }
 
 void QAbstractAspectPrivate::syncDirtyFrontEndNode(QNode *node, QBackendNode *backend, bool firstTime) const
@@ -264,6 +320,15 @@ void QAbstractAspectPrivate::syncDirtyEntityComponentNodes(const QList<Component
 }
 
 QBackendNode *QAbstractAspectPrivate::createBackendNode(const NodeTreeChange &change) const
+{
+    return createBackendNode(change, nullptr);
+}
+
+// Creates the backend node for change. If concurrentSyncs is provided and the
+// backend can be synced concurrently, its first sync is appended to it rather
+// than performed right away
+QBackendNode *QAbstractAspectPrivate::createBackendNode(const NodeTreeChange &change,
+                                                        std::vector<ConcurrentNodeSync> *concurrentSyncs) const
 {
     const QMetaObject *metaObj = change.metaObj;
     const QBackendNodeMapperPtr backendNodeMapper = mapperForNode(metaObj);
@@ -292,11 +357,41 @@ QBackendNode *QAbstractAspectPrivate::createBackendNode(const NodeTreeChange &ch
     QBackendNodePrivate *backendPriv = QBackendNodePrivate::get(backend);
     backendPriv->setEnabled(node->isEnabled());
 
-    syncDirtyFrontEndNode(node, backend, true);
+    if (concurrentSyncs && backendPriv->m_threadSafeSync)
+        concurrentSyncs->push_back({ this, node, backend, true });
+    else
+        syncDirtyFrontEndNode(node, backend, true);
 
     return backend;
 }
 
+void QAbstractAspectPrivate::createBackendNodes(QList<NodeTreeChange>::const_iterator begin,
+                                                QList<NodeTreeChange>::const_iterator end,
+                                                std::vector<ConcurrentNodeSync> &concurrentSyncs) const
+{
+    // Give the aspect a chance to preallocate storage for each node type
+    QHash<const QMetaObject *, int> nodeCountPerType;
+    for (auto it = begin; it != end; ++it)
+        ++nodeCountPerType[it->metaObj];
+    for (auto it = nodeCountPerType.cbegin(), typeEnd = nodeCountPerType.cend(); it != typeEnd; ++it)
+        reserveBackendNodes(it.key(), it.value());
+
+    for (auto it = begin; it != end; ++it)
+        createBackendNode(*it, &concurrentSyncs);
+}
+
+/*!
+ * \internal
+ *
+ * Called before \a count nodes of type \a metaObj get their backend created.
+ * Aspects can reimplement this to preallocate their backend storage.
+ */
+void QAbstractAspectPrivate::reserveBackendNodes(const QMetaObject *metaObj, int count) const
+{
+    Q_UNUSED(metaObj);
+    Q_UNUSED(count);
+}
+
 void QAbstractAspectPrivate::clearBackendNode(const NodeTreeChange &change) const
 {
     const QMetaObject *metaObj = change.metaObj;
@@ -317,8 +412,9 @@ void QAbstractAspectPrivate::setRootAndCreateNodes(QEntity *rootObject, const QL
     m_root = rootObject;
     m_rootId = rootObject->id();
 
-    for (const NodeTreeChange &change : nodesChanges)
-        createBackendNode(change);
+    std::vector<ConcurrentNodeSync> concurrentSyncs;
+    createBackendNodes(nodesChanges.cbegin(), nodesChanges.cend(), concurrentSyncs);
+    syncConcurrentNodes(concurrentSyncs);
 }
 
 
@@ -348,6 +444,10 @@ std::vector<QAspectJobPtr> QAbstractAspectPrivate::jobsToExecute(qint64 time)
     return res;
 }
 
+void QAbstractAspectPrivate::jobsRunning()
+{
+}
+
 void QAbstractAspectPrivate::jobsDone()
 {
 }
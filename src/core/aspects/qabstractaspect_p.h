@@ -62,6 +62,8 @@
 #include <QMutex>
 #include <QList>
 
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DCore {
@@ -125,12 +127,28 @@ public:
     QAbstractAspectJobManager *jobManager() const;
 
     std::vector<QAspectJobPtr> jobsToExecute(qint64 time) override;
+    void jobsRunning() override;   // called on the main thread while the jobs run on the thread pool
     void jobsDone() override;      // called when all the jobs are completed
     void frameDone() override;     // called when frame is completed (after the jobs), safe to wait until next frame here
 
+    // A frontend node whose backend can be synced concurrently
+    struct ConcurrentNodeSync
+    {
+        const QAbstractAspectPrivate *aspect;
+        QNode *node;
+        QBackendNode *backend;
+        bool firstTime;
+    };
+
     QBackendNode *createBackendNode(const NodeTreeChange &change) const;
+    void createBackendNodes(QList<NodeTreeChange>::const_iterator begin,
+                            QList<NodeTreeChange>::const_iterator end,
+                            std::vector<ConcurrentNodeSync> &concurrentSyncs) const;
+    virtual void reserveBackendNodes(const QMetaObject *metaObj, int count) const;
     void clearBackendNode(const NodeTreeChange &change) const;
     void syncDirtyFrontEndNodes(const QList<QNode *> &nodes);
+    void syncDirtyFrontEndNodes(const QList<QNode *> &nodes, std::vector<ConcurrentNodeSync> &concurrentSyncs);
+    static void syncConcurrentNodes(std::vector<ConcurrentNodeSync> &syncs);
     void syncDirtyEntityComponentNodes(const QList<ComponentRelationshipChange> &nodes);
     virtual void syncDirtyFrontEndNode(QNode *node, QBackendNode *backend, bool firstTime) const;
     void sendPropertyMessages(QNode *node, QBackendNode *backend) const;
@@ -144,6 +162,8 @@ public:
 
     Q_DECLARE_PUBLIC(QAbstractAspect)
 
+    QBackendNode *createBackendNode(const NodeTreeChange &change,
+                                    std::vector<ConcurrentNodeSync> *concurrentSyncs) const;
     QBackendNodeMapperPtr mapperForNode(const QMetaObject *metaObj) const;
 
     QEntity *m_root;
@@ -152,6 +172,8 @@ public:
     QAbstractAspectJobManager *m_jobManager;
     QChangeArbiter *m_arbiter;
     QHash<const QMetaObject*, QBackendNodeMapperPtr> m_backendCreatorFunctors;
+    // Mappers resolved through the superclass chain, per node metaobject
+    mutable QHash<const QMetaObject*, QBackendNodeMapperPtr> m_resolvedMappers;
     QMutex m_singleShotMutex;
     std::vector<QAspectJobPtr> m_singleShotJobs;
 
@@ -222,6 +222,8 @@ QAspectEngine::QAspectEngine(QObject *parent)
     Q_D(QAspectEngine);
     d->m_scene = new QScene(this);
     d->m_aspectManager = new QAspectManager(this);
+    connect(d->m_aspectManager, &QAspectManager::nodeInsertionProgress,
+            this, &QAspectEngine::nodeInsertionProgress);
 }
 
 /*!
@@ -438,6 +440,81 @@ void QAspectEngine::processFrame()
     d->m_aspectManager->processFrame();
 }
 
+/*!
+ * Sets the maximum number of nodes, \a maxNodesPerFrame, whose backends are
+ * created in a single frame when nodes are added to an already running scene.
+ *
+ * When a budget is set, each newly added subtree is queued and inserted in
+ * a later frame. A subtree is always inserted as a whole so that partially
+ * created entities are never processed by the aspects; a single subtree
+ * larger than the budget is therefore inserted on its own. The initial
+ * scene set with setRootEntity() is not affected.
+ *
+ * A value of 0, the default, disables the limit.
+ *
+ * \sa setNodeInsertionTimeBudget(), nodeInsertionProgress()
+ */
+void QAspectEngine::setNodeInsertionBudget(int maxNodesPerFrame)
+{
+    Q_D(QAspectEngine);
+    d->m_aspectManager->setNodeInsertionBudget(maxNodesPerFrame);
+}
+
+/*!
+ * \return the maximum number of nodes inserted per frame, or 0 if unlimited.
+ */
+int QAspectEngine::nodeInsertionBudget() const
+{
+    Q_D(const QAspectEngine);
+    return d->m_aspectManager->nodeInsertionBudget();
+}
+
+/*!
+ * Sets the time, in \a msecs milliseconds, that may be spent creating the
+ * backends of added nodes in a single frame. Once that time has elapsed,
+ * remaining subtrees are inserted in the following frames.
+ *
+ * A value of 0, the default, disables the limit.
+ *
+ * \sa setNodeInsertionBudget(), nodeInsertionProgress()
+ */
+void QAspectEngine::setNodeInsertionTimeBudget(int msecs)
+{
+    Q_D(QAspectEngine);
+    d->m_aspectManager->setNodeInsertionTimeBudget(msecs);
+}
+
+/*!
+ * \return the time in milliseconds that may be spent inserting nodes per
+ * frame, or 0 if unlimited.
+ */
+int QAspectEngine::nodeInsertionTimeBudget() const
+{
+    Q_D(const QAspectEngine);
+    return d->m_aspectManager->nodeInsertionTimeBudget();
+}
+
+/*!
+ * \return the number of added nodes still waiting for their backends to be
+ * created.
+ */
+int QAspectEngine::pendingNodeInsertionCount() const
+{
+    Q_D(const QAspectEngine);
+    return d->m_aspectManager->pendingNodeInsertionCount();
+}
+
+/*!
+ * \fn void Qt3DCore::QAspectEngine::nodeInsertionProgress(int insertedNodeCount, int totalNodeCount)
+ *
+ * This signal is emitted after each frame in which queued nodes were inserted
+ * while a node insertion budget is in effect. \a insertedNodeCount of the
+ * \a totalNodeCount nodes queued since insertion last caught up have been
+ * inserted; both values are equal once all queued nodes are inserted.
+ *
+ * \sa setNodeInsertionBudget(), setNodeInsertionTimeBudget()
+ */
+
 QNode *QAspectEngine::lookupNode(QNodeId id) const
 {
     Q_D(const QAspectEngine);
@@ -89,9 +89,18 @@ public:
 
     void processFrame();
 
+    void setNodeInsertionBudget(int maxNodesPerFrame);
+    int nodeInsertionBudget() const;
+    void setNodeInsertionTimeBudget(int msecs);
+    int nodeInsertionTimeBudget() const;
+    int pendingNodeInsertionCount() const;
+
     QNode *lookupNode(QNodeId id) const override;
     QList<QNode *> lookupNodes(const QList<QNodeId> &ids) const override;
 
+Q_SIGNALS:
+    void nodeInsertionProgress(int insertedNodeCount, int totalNodeCount);
+
 private:
     Q_DECLARE_PRIVATE(QAspectEngine)
 };
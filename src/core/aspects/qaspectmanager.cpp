@@ -42,6 +42,7 @@
 #include <Qt3DCore/qabstractaspect.h>
 #include <Qt3DCore/qentity.h>
 #include <QtCore/QAbstractEventDispatcher>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QEventLoop>
 #include <QtCore/QThread>
 #include <QtCore/QWaitCondition>
@@ -71,6 +72,8 @@
 #include <QtCore/QAbstractAnimation>
 #endif
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DCore {
@@ -112,6 +115,24 @@ int RequestFrameEvent::requestEventType = QEvent::registerEventType();
 } // anonymous
 #endif
 
+namespace {
+
+void createBackendNodes(const QList<QAbstractAspect *> &aspects,
+                        QList<NodeTreeChange>::const_iterator begin,
+                        QList<NodeTreeChange>::const_iterator end)
+{
+    std::vector<QAbstractAspectPrivate::ConcurrentNodeSync> concurrentSyncs;
+    for (QAbstractAspect *aspect : aspects)
+        aspect->d_func()->createBackendNodes(begin, end, concurrentSyncs);
+    QAbstractAspectPrivate::syncConcurrentNodes(concurrentSyncs);
+
+    // Backends were created from the complete frontend state
+    for (auto it = begin; it != end; ++it)
+        QNodePrivate::get(it->node)->clearChangedFields();
+}
+
+} // anonymous
+
 /*!
     \class Qt3DCore::QAspectManager
     \internal
@@ -127,6 +148,11 @@ QAspectManager::QAspectManager(QAspectEngine *parent)
     , m_simulationLoopRunning(false)
     , m_driveMode(QAspectEngine::Automatic)
     , m_postConstructorInit(nullptr)
+    , m_firstPendingInsertion(0)
+    , m_pendingInsertionNodeCount(0)
+    , m_insertedNodeCount(0)
+    , m_nodeInsertionBudget(0)
+    , m_nodeInsertionTimeBudget(0)
 #if QT_CONFIG(animation)
     , m_simulationAnimation(nullptr)
 #endif
@@ -280,6 +306,14 @@ void QAspectManager::setRootEntity(Qt3DCore::QEntity *root, const QList<QNode *>
 
     m_root = root;
 
+    // Subtrees queued for the previous scene are no longer relevant
+    m_firstPendingInsertion += int(m_pendingInsertions.size());
+    m_pendingInsertions.clear();
+    m_pendingNodeInsertions.clear();
+    m_pendingRelationshipNodes.clear();
+    m_pendingInsertionNodeCount = 0;
+    m_insertedNodeCount = 0;
+
     if (m_root) {
 
         QList<NodeTreeChange> nodeTreeChanges;
@@ -296,6 +330,9 @@ void QAspectManager::setRootEntity(Qt3DCore::QEntity *root, const QList<QNode *>
 
         for (QAbstractAspect *aspect : qAsConst(m_aspects))
             aspect->d_func()->setRootAndCreateNodes(m_root, nodeTreeChanges);
+
+        for (QNode *n : nodes)
+            QNodePrivate::get(n)->clearChangedFields();
     }
 }
 
@@ -318,6 +355,15 @@ void QAspectManager::addNodes(const QList<QNode *> &nodes)
                                 node });
     }
 
+    // When insertion is budgeted, the subtree is queued as a whole so that it
+    // can be inserted in a later frame without ever being partially created.
+    // Subtrees keep being queued while others are waiting, even once the
+    // budget is lifted, as they may be children of the queued ones
+    if ((isInsertionBudgeted() || !m_pendingInsertions.isEmpty()) && !treeChanges.isEmpty()) {
+        queuePendingInsertion(std::move(treeChanges));
+        return;
+    }
+
     m_nodeTreeChanges += treeChanges;
 }
 
@@ -341,6 +387,29 @@ void QAspectManager::removeNodes(const QList<QNode *> &nodes)
                                                [&node] (const NodeTreeChange &change) { return change.id == node->id(); }),
                                 m_nodeTreeChanges.end());
 
+        // Likewise for subtrees still waiting for their insertion. The node
+        // is only forgotten here, it is dropped from its subtree on insertion
+        const auto pendingIt = m_pendingNodeInsertions.constFind(node->id());
+        if (pendingIt != m_pendingNodeInsertions.cend()) {
+            ++m_pendingInsertions[pendingIt.value() - m_firstPendingInsertion].removedNodeCount;
+            --m_pendingInsertionNodeCount;
+            m_pendingNodeInsertions.erase(pendingIt);
+        }
+
+        // The node is going away, so are its relationships, which are
+        // cleared in place and skipped when replayed
+        const QList<QPair<int, int>> relationshipPositions = m_pendingRelationshipNodes.values(node);
+        if (!relationshipPositions.isEmpty()) {
+            m_pendingRelationshipNodes.remove(node);
+            for (const QPair<int, int> &position : relationshipPositions) {
+                PendingInsertion &insertion = m_pendingInsertions[position.first - m_firstPendingInsertion];
+                ComponentRelationshipChange &change = insertion.relationshipChanges[position.second];
+                m_pendingRelationshipNodes.remove(change.node == node ? change.subNode : change.node, position);
+                change.node = nullptr;
+                change.subNode = nullptr;
+            }
+        }
+
         m_nodeTreeChanges.push_back({ node->id(),
                                       QNodePrivate::get(node)->m_typeInfo,
                                       NodeTreeChange::Removed,
@@ -499,6 +568,142 @@ void QAspectManager::requestNextFrame()
 #endif
 }
 
+/*!
+ * \internal
+ *
+ * Limits node insertion to at most \a maxNodesPerFrame nodes per frame. A value
+ * of 0 disables the limit.
+ */
+void QAspectManager::setNodeInsertionBudget(int maxNodesPerFrame)
+{
+    m_nodeInsertionBudget = qMax(0, maxNodesPerFrame);
+}
+
+/*!
+ * \internal
+ *
+ * Limits node insertion to roughly \a msecs milliseconds per frame. A value
+ * of 0 disables the limit.
+ */
+void QAspectManager::setNodeInsertionTimeBudget(int msecs)
+{
+    m_nodeInsertionTimeBudget = qMax(0, msecs);
+}
+
+bool QAspectManager::isInsertionBudgeted() const
+{
+    return m_nodeInsertionBudget > 0 || m_nodeInsertionTimeBudget > 0;
+}
+
+// Main Thread -> queues the subtree made of nodes for a later insertion
+void QAspectManager::queuePendingInsertion(QList<NodeTreeChange> &&nodes)
+{
+    const int insertion = m_firstPendingInsertion + int(m_pendingInsertions.size());
+    m_pendingNodeInsertions.reserve(m_pendingNodeInsertions.size() + nodes.size());
+    for (const NodeTreeChange &change : qAsConst(nodes))
+        m_pendingNodeInsertions.insert(change.id, insertion);
+    m_pendingInsertionNodeCount += int(nodes.size());
+    m_pendingInsertions.push_back({ std::move(nodes), {}, 0 });
+}
+
+// Main Thread -> creates the backends of pending subtrees until the frame's
+// budget is exhausted. At least one subtree is inserted per frame so that
+// progress is always made, even if that subtree alone exceeds the budget
+void QAspectManager::insertPendingNodes()
+{
+    if (m_pendingInsertions.isEmpty())
+        return;
+
+    const bool budgeted = isInsertionBudgeted();
+    QElapsedTimer timer;
+    timer.start();
+
+    int insertedNodes = 0;
+    while (!m_pendingInsertions.isEmpty()) {
+        PendingInsertion &insertion = m_pendingInsertions.first();
+        const int insertionSize = int(insertion.nodes.size()) - insertion.removedNodeCount;
+        if (budgeted && insertedNodes > 0 && insertionSize > 0) {
+            if (m_nodeInsertionBudget > 0 && insertedNodes + insertionSize > m_nodeInsertionBudget)
+                break;
+            if (m_nodeInsertionTimeBudget > 0 && timer.elapsed() >= m_nodeInsertionTimeBudget)
+                break;
+        }
+
+        // Nodes destroyed while waiting are dropped, the others stop being pending
+        if (insertion.removedNodeCount > 0) {
+            insertion.nodes.erase(std::remove_if(insertion.nodes.begin(), insertion.nodes.end(),
+                                                 [this] (const NodeTreeChange &change) {
+                                                     return m_pendingNodeInsertions.value(change.id, -1) != m_firstPendingInsertion;
+                                                 }),
+                                  insertion.nodes.end());
+        }
+        for (const NodeTreeChange &change : qAsConst(insertion.nodes))
+            m_pendingNodeInsertions.remove(change.id);
+
+        createBackendNodes(m_aspects, insertion.nodes.cbegin(), insertion.nodes.cend());
+
+        // Replay the relationship changes which were waiting for these
+        // backends, except for those of destroyed nodes
+        QList<ComponentRelationshipChange> relationshipChanges;
+        relationshipChanges.reserve(insertion.relationshipChanges.size());
+        for (int i = 0, m = int(insertion.relationshipChanges.size()); i < m; ++i) {
+            const ComponentRelationshipChange &change = insertion.relationshipChanges.at(i);
+            if (!change.node)
+                continue;
+            m_pendingRelationshipNodes.remove(change.node, qMakePair(m_firstPendingInsertion, i));
+            m_pendingRelationshipNodes.remove(change.subNode, qMakePair(m_firstPendingInsertion, i));
+            relationshipChanges.push_back(change);
+        }
+        if (!relationshipChanges.isEmpty()) {
+            for (QAbstractAspect *aspect : qAsConst(m_aspects))
+                QAbstractAspectPrivate::get(aspect)->syncDirtyEntityComponentNodes(relationshipChanges);
+        }
+        insertedNodes += int(insertion.nodes.size());
+        m_pendingInsertions.removeFirst();
+        ++m_firstPendingInsertion;
+    }
+
+    m_pendingInsertionNodeCount -= insertedNodes;
+    m_insertedNodeCount += insertedNodes;
+    const int totalNodeCount = m_insertedNodeCount + m_pendingInsertionNodeCount;
+    qCDebug(Aspects) << "Inserted" << m_insertedNodeCount << "of" << totalNodeCount << "pending nodes";
+    emit nodeInsertionProgress(m_insertedNodeCount, totalNodeCount);
+
+    // Progress is reported relative to the current burst of insertions
+    if (m_pendingInsertions.isEmpty())
+        m_insertedNodeCount = 0;
+}
+
+// Main Thread -> moves the relationship changes involving nodes whose backends
+// are still waiting to be inserted out of changes. Each one is queued with the
+// last pending subtree it involves, so that both its entity and component
+// backends exist when it gets replayed
+void QAspectManager::deferPendingRelationshipChanges(QList<ComponentRelationshipChange> &changes)
+{
+    if (m_pendingInsertions.isEmpty())
+        return;
+
+    // Changes are partitioned in one pass, the remaining ones keep their order
+    QList<ComponentRelationshipChange> readyChanges;
+    readyChanges.reserve(changes.size());
+    for (const ComponentRelationshipChange &change : qAsConst(changes)) {
+        const int insertion = qMax(m_pendingNodeInsertions.value(change.node->id(), -1),
+                                   m_pendingNodeInsertions.value(change.subNode->id(), -1));
+        if (insertion < 0) {
+            readyChanges.push_back(change);
+            continue;
+        }
+
+        QList<ComponentRelationshipChange> &deferredChanges
+                = m_pendingInsertions[insertion - m_firstPendingInsertion].relationshipChanges;
+        const QPair<int, int> position(insertion, int(deferredChanges.size()));
+        deferredChanges.push_back(change);
+        m_pendingRelationshipNodes.insert(change.node, position);
+        m_pendingRelationshipNodes.insert(change.subNode, position);
+    }
+    changes = std::move(readyChanges);
+}
+
 void QAspectManager::processFrame()
 {
     qCDebug(Aspects) << "Processing Frame";
@@ -529,33 +734,50 @@ void QAspectManager::processFrame()
 
         // Add and Remove Nodes
         const QList<NodeTreeChange> nodeTreeChanges = std::move(m_nodeTreeChanges);
-        for (const NodeTreeChange &change : nodeTreeChanges) {
-            // Buckets ensure that even if we have intermingled node added / removed
-            // buckets, we preserve the order of the sequences
-
-            for (QAbstractAspect *aspect : qAsConst(m_aspects)) {
-                switch (change.type) {
-                case NodeTreeChange::Added:
-                    aspect->d_func()->createBackendNode(change);
-                    break;
-                case NodeTreeChange::Removed:
-                    aspect->d_func()->clearBackendNode(change);
-                    break;
-                }
+        auto changeIt = nodeTreeChanges.cbegin();
+        const auto changesEnd = nodeTreeChanges.cend();
+        while (changeIt != changesEnd) {
+            // Consecutive additions are created in bulk while removals are
+            // handled in between, so that even if we have intermingled node
+            // added / removed sequences, we preserve their order
+            if (changeIt->type == NodeTreeChange::Added) {
+                const auto addedEnd = std::find_if(changeIt, changesEnd, [] (const NodeTreeChange &change) {
+                    return change.type != NodeTreeChange::Added;
+                });
+                createBackendNodes(m_aspects, changeIt, addedEnd);
+                changeIt = addedEnd;
+            } else {
+                for (QAbstractAspect *aspect : qAsConst(m_aspects))
+                    aspect->d_func()->clearBackendNode(*changeIt);
+                ++changeIt;
             }
         }
 
-        // Sync node / subnode relationship changes
-        const auto dirtySubNodes = m_changeArbiter->takeDirtyEntityComponentNodes();
+        // Insert as many pending subtrees as the budget allows
+        insertPendingNodes();
+
+        // Sync node / subnode relationship changes. The ones involving nodes
+        // that are still pending are replayed once these get inserted
+        auto dirtySubNodes = m_changeArbiter->takeDirtyEntityComponentNodes();
+        deferPendingRelationshipChanges(dirtySubNodes);
         if (dirtySubNodes.size())
             for (QAbstractAspect *aspect : qAsConst(m_aspects))
                 QAbstractAspectPrivate::get(aspect)->syncDirtyEntityComponentNodes(dirtySubNodes);
 
         // Sync property updates
         const auto dirtyFrontEndNodes = m_changeArbiter->takeDirtyFrontEndNodes();
-        if (dirtyFrontEndNodes.size())
+        if (dirtyFrontEndNodes.size()) {
+            // Backends which can be synced concurrently are gathered across all
+            // aspects and spread over the thread pool once the others are done
+            std::vector<QAbstractAspectPrivate::ConcurrentNodeSync> concurrentSyncs;
             for (QAbstractAspect *aspect : qAsConst(m_aspects))
-                QAbstractAspectPrivate::get(aspect)->syncDirtyFrontEndNodes(dirtyFrontEndNodes);
+                QAbstractAspectPrivate::get(aspect)->syncDirtyFrontEndNodes(dirtyFrontEndNodes, concurrentSyncs);
+            QAbstractAspectPrivate::syncConcurrentNodes(concurrentSyncs);
+
+            // All aspects have now consumed the recorded field changes
+            for (QNode *node : dirtyFrontEndNodes)
+                QNodePrivate::get(node)->clearChangedFields();
+        }
     }
 
     // For each Aspect
@@ -55,12 +55,14 @@
 #include <Qt3DCore/qabstractfrontendnodemanager.h>
 #include <Qt3DCore/qnode.h>
 #include <Qt3DCore/qnodeid.h>
+#include <QtCore/QHash>
 #include <QtCore/QList>
 #include <QtCore/QObject>
 #include <QtCore/QScopedPointer>
 #include <QtCore/QSemaphore>
 #include <QtCore/QVariant>
 
+#include <Qt3DCore/private/qchangearbiter_p.h>
 #include <Qt3DCore/private/qt3dcore_global_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -126,11 +128,24 @@ public:
     int jobsInLastFrame() const { return m_jobsInLastFrame; }
     void dumpJobsOnNextFrame();
 
+    void setNodeInsertionBudget(int maxNodesPerFrame);
+    int nodeInsertionBudget() const { return m_nodeInsertionBudget; }
+    void setNodeInsertionTimeBudget(int msecs);
+    int nodeInsertionTimeBudget() const { return m_nodeInsertionTimeBudget; }
+    int pendingNodeInsertionCount() const { return m_pendingInsertionNodeCount; }
+
+Q_SIGNALS:
+    void nodeInsertionProgress(int insertedNodeCount, int totalNodeCount);
+
 private:
 #if !QT_CONFIG(animation)
     bool event(QEvent *event) override;
 #endif
     void requestNextFrame();
+    bool isInsertionBudgeted() const;
+    void queuePendingInsertion(QList<NodeTreeChange> &&nodes);
+    void insertPendingNodes();
+    void deferPendingRelationshipChanges(QList<ComponentRelationshipChange> &changes);
 
     QAspectEngine *m_engine;
     QList<QAbstractAspect *> m_aspects;
@@ -145,6 +160,30 @@ private:
     QList<NodeTreeChange> m_nodeTreeChanges;
     NodePostConstructorInit* m_postConstructorInit;
 
+    // Subtrees waiting to be inserted when node insertion is budgeted. Each
+    // entry holds the nodes of one subtree and is never split across frames,
+    // along with the entity / component relationship changes involving these
+    // nodes, which can only be synced once their backends exist
+    struct PendingInsertion
+    {
+        QList<NodeTreeChange> nodes;
+        QList<ComponentRelationshipChange> relationshipChanges;
+        int removedNodeCount = 0; // Nodes destroyed before their insertion
+    };
+    QList<PendingInsertion> m_pendingInsertions;
+    // Pending insertions are numbered in their queuing order, this is the
+    // number of the first one in m_pendingInsertions
+    int m_firstPendingInsertion;
+    // Number of the pending insertion of each node still waiting for it
+    QHash<QNodeId, int> m_pendingNodeInsertions;
+    // Deferred relationship changes of each node they involve, as the number
+    // of their pending insertion and their index in its relationshipChanges
+    QMultiHash<const QNode *, QPair<int, int>> m_pendingRelationshipNodes;
+    int m_pendingInsertionNodeCount;
+    int m_insertedNodeCount;
+    int m_nodeInsertionBudget;
+    int m_nodeInsertionTimeBudget;
+
 #if QT_CONFIG(animation)
     RequestFrameAnimation *m_simulationAnimation;
 #endif
@@ -44,7 +44,9 @@
 #include <QtCore/QDebug>
 #include <QtCore/QThread>
 #include <QtCore/QFuture>
+#include <Qt3DCore/private/qaspectjob_p.h>
 #include <Qt3DCore/private/qaspectmanager_p.h>
+#include <Qt3DCore/private/qsysteminformationservice_p_p.h>
 #include <Qt3DCore/private/qthreadpooler_p.h>
 #include <Qt3DCore/private/task_p.h>
 
@@ -74,6 +76,16 @@ void QAspectJobManager::enqueueJobs(const std::vector<QAspectJobPtr> &jobQueue)
     if (systemService)
         systemService->writePreviousFrameTraces();
 
+    // Name the job types so that the collected stats can be reported
+    QSystemInformationServicePrivate *dservice = systemService && systemService->isTraceEnabled()
+            ? QSystemInformationServicePrivate::get(systemService) : nullptr;
+    if (dservice) {
+        for (const QAspectJobPtr &job : jobQueue) {
+            const QAspectJobPrivate *jobD = QAspectJobPrivate::get(job.data());
+            dservice->registerJobTypeName(jobD->m_jobId.typeAndInstance[0], jobD->m_jobName);
+        }
+    }
+
     // Convert QJobs to Tasks
     QHash<QAspectJob *, AspectTaskRunnable *> tasksMap;
     QList<RunnableInterface *> taskList;
@@ -92,12 +104,16 @@ void QAspectJobManager::enqueueJobs(const std::vector<QAspectJobPtr> &jobQueue)
 
         int dependerCount = 0;
         for (const QWeakPointer<QAspectJob> &dep : deps) {
-            AspectTaskRunnable *taskDependee = tasksMap.value(dep.toStrongRef().data());
+            const QAspectJobPtr dependee = dep.toStrongRef();
+            AspectTaskRunnable *taskDependee = tasksMap.value(dependee.data());
             // The dependencies here are not hard requirements, i.e., the dependencies
             // not in the jobQueue should already have their data ready.
             if (taskDependee) {
                 taskDependee->m_dependers.append(taskDepender);
                 ++dependerCount;
+                if (dservice)
+                    dservice->addJobDependency(QAspectJobPrivate::get(dependee.data())->m_jobId,
+                                               QAspectJobPrivate::get(job.data())->m_jobId);
             }
         }
 
@@ -68,6 +68,7 @@ public:
 
 private:
     virtual std::vector<QAspectJobPtr> jobsToExecute(qint64 time) = 0;
+    virtual void jobsRunning() = 0;
     virtual void jobsDone() = 0;
     virtual void frameDone() = 0;
 
@@ -10,6 +10,7 @@ HEADERS += \
     $$PWD/qbackendnode_p.h \
     $$PWD/qbackendnode.h \
     $$PWD/qnodeid.h \
+    $$PWD/qnodelookuptable_p.h \
     $$PWD/qnodevisitor_p.h \
     $$PWD/propertychangehandler_p.h \
     $$PWD/qdestructionidandtypecollector_p.h \
@@ -21,6 +22,7 @@ SOURCES += \
     $$PWD/qentity.cpp \
     $$PWD/qbackendnode.cpp \
     $$PWD/qnodeid.cpp \
+    $$PWD/qnodelookuptable.cpp \
     $$PWD/qnodevisitor.cpp \
     $$PWD/qabstractnodefactory.cpp \
     $$PWD/propertychangehandler.cpp \
@@ -58,6 +58,7 @@ QBackendNodePrivate::QBackendNodePrivate(QBackendNode::Mode mode)
     : q_ptr(nullptr)
     , m_mode(mode)
     , m_enabled(false)
+    , m_threadSafeSync(false)
 {
 }
 
@@ -77,6 +77,10 @@ public:
 
     QNodeId m_peerId;
     bool m_enabled;
+    // Set by backends whose syncFromFrontEnd only touches the backend node
+    // itself or thread safe state, allowing the aspect to sync them
+    // concurrently with other such nodes
+    bool m_threadSafeSync;
 
     virtual void addedToEntity(QNode *frontend);
     virtual void removedFromEntity(QNode *frontend);
@@ -71,6 +71,9 @@ QNodePrivate::QNodePrivate()
     , m_hasBackendNode(false)
     , m_enabled(true)
     , m_notifiedParent(false)
+    , m_dirtyGeneration(0)
+    , m_dirtyIndex(-1)
+    , m_changedFields(0)
     , m_propertyChangesSetup(false)
     , m_signals(this)
 {
@@ -586,6 +589,17 @@ void QNodePrivate::markDirty(QScene::DirtyNodeSet changes)
         m_scene->markDirty(changes);
 }
 
+/*!
+    \internal
+
+    Resets the fields recorded by markFieldsChanged(). Called by the aspect
+    manager once every aspect had the opportunity to sync the node.
+ */
+void QNodePrivate::clearChangedFields()
+{
+    m_changedFields = 0;
+}
+
 /*!
     \internal
  */
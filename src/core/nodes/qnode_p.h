@@ -91,6 +91,10 @@ public:
     virtual void update();
     void markDirty(QScene::DirtyNodeSet changes);
 
+    void markFieldsChanged(quint32 fields) { m_changedFields |= fields; }
+    virtual void clearChangedFields();
+    virtual void propertyChanged(int propertyIndex);
+
     Q_DECLARE_PUBLIC(QNode)
 
     // For now this just protects access to the m_changeArbiter.
@@ -105,6 +109,17 @@ public:
     bool m_enabled;
     bool m_notifiedParent;
 
+    // Dirty list bookkeeping owned by QChangeArbiter: the node is in the
+    // arbiter's dirty list when m_dirtyGeneration matches the arbiter's
+    // current generation, at position m_dirtyIndex
+    quint64 m_dirtyGeneration;
+    int m_dirtyIndex;
+
+    // Fields changed since the node was last synced by all aspects. Frontend
+    // setters record them and the meaning of each bit is defined by the node
+    // type, so that backends only consume what changed in syncFromFrontEnd
+    quint32 m_changedFields;
+
     static QNodePrivate *get(QNode *q);
     static const QNodePrivate *get(const QNode *q);
     static void nodePtrDeleter(QNode *q);
@@ -181,7 +196,6 @@ private:
     void _q_setParentHelper(QNode *parent);
     void registerNotifiedProperties();
     void unregisterNotifiedProperties();
-    void propertyChanged(int propertyIndex);
 
     void setSceneHelper(QNode *root);
     void unsetSceneHelper(QNode *root);
@@ -0,0 +1,240 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB)
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qnodelookuptable_p.h"
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+namespace {
+
+const int MinimumCapacityLog2 = 4;
+
+} // anonymous
+
+// Fibonacci hashing spreads the sequential node ids over the table
+inline quint64 QNodeLookupTable::Table::firstSlot(quint64 key) const
+{
+    return (key * Q_UINT64_C(0x9E3779B97F4A7C15)) >> shift;
+}
+
+QNodeLookupTable::Table::Table(int capacityLog2)
+    : shift(64 - capacityLog2)
+    , mask((quint64(1) << capacityLog2) - 1)
+    , slots(new Slot[size_t(1) << capacityLog2]())
+{
+}
+
+/*!
+    \class Qt3DCore::QNodeLookupTable
+    \internal
+*/
+QNodeLookupTable::QNodeLookupTable()
+    : m_table(new Table(MinimumCapacityLog2))
+    , m_activeLookups(0)
+    , m_size(0)
+    , m_tombstones(0)
+{
+}
+
+QNodeLookupTable::~QNodeLookupTable()
+{
+    delete m_table.load();
+}
+
+int QNodeLookupTable::capacity() const
+{
+    return int(m_table.load(std::memory_order_relaxed)->mask + 1);
+}
+
+// Linear probing. Tables are never full so the probe always ends on the
+// key or on an empty slot
+QNode *QNodeLookupTable::find(const Table *table, quint64 key)
+{
+    quint64 index = table->firstSlot(key);
+    for (;;) {
+        const Slot &slot = table->slots[index];
+        const quint64 slotKey = slot.key.load(std::memory_order_acquire);
+        if (slotKey == key)
+            return slot.value.load(std::memory_order_acquire);
+        if (slotKey == 0)
+            return nullptr;
+        index = (index + 1) & table->mask;
+    }
+}
+
+// Any thread
+QNode *QNodeLookupTable::lookup(QNodeId id) const
+{
+    if (id.isNull())
+        return nullptr;
+
+    // Announcing the lookup before loading the table prevents the writer
+    // from freeing the table while we probe it
+    m_activeLookups.fetch_add(1);
+    QNode *node = find(m_table.load(), id.id());
+    m_activeLookups.fetch_sub(1, std::memory_order_release);
+    return node;
+}
+
+// Any thread
+QList<QNode *> QNodeLookupTable::lookup(const QList<QNodeId> &ids) const
+{
+    QList<QNode *> nodes(ids.size());
+
+    m_activeLookups.fetch_add(1);
+    const Table *table = m_table.load();
+    int index = 0;
+    for (QNodeId id : ids)
+        nodes[index++] = id.isNull() ? nullptr : find(table, id.id());
+    m_activeLookups.fetch_sub(1, std::memory_order_release);
+
+    return nodes;
+}
+
+// Writer thread only
+void QNodeLookupTable::insert(QNodeId id, QNode *node)
+{
+    if (id.isNull() || node == nullptr)
+        return;
+
+    // Keep at least half of the slots empty so that probes stay short
+    if (quint64(m_size + m_tombstones + 1) * 2 > m_table.load(std::memory_order_relaxed)->mask + 1)
+        rebuild(m_size + 1);
+
+    Table *table = m_table.load(std::memory_order_relaxed);
+    const quint64 key = id.id();
+    quint64 index = table->firstSlot(key);
+    for (;;) {
+        Slot &slot = table->slots[index];
+        const quint64 slotKey = slot.key.load(std::memory_order_relaxed);
+        if (slotKey == key) {
+            if (slot.value.load(std::memory_order_relaxed) == nullptr) {
+                ++m_size;
+                --m_tombstones;
+            }
+            slot.value.store(node, std::memory_order_release);
+            break;
+        }
+        if (slotKey == 0) {
+            // Publish the value before the key so that readers finding
+            // the key always see the node
+            slot.value.store(node, std::memory_order_relaxed);
+            slot.key.store(key, std::memory_order_release);
+            ++m_size;
+            break;
+        }
+        index = (index + 1) & table->mask;
+    }
+
+    reclaimRetiredTables();
+}
+
+// Writer thread only
+void QNodeLookupTable::remove(QNodeId id)
+{
+    if (id.isNull())
+        return;
+
+    Table *table = m_table.load(std::memory_order_relaxed);
+    const quint64 key = id.id();
+    quint64 index = table->firstSlot(key);
+    for (;;) {
+        Slot &slot = table->slots[index];
+        const quint64 slotKey = slot.key.load(std::memory_order_relaxed);
+        if (slotKey == key) {
+            // The key stays in place as a tombstone so that probes for
+            // other keys going through this slot remain valid
+            if (slot.value.load(std::memory_order_relaxed) != nullptr) {
+                slot.value.store(nullptr, std::memory_order_release);
+                --m_size;
+                ++m_tombstones;
+            }
+            break;
+        }
+        if (slotKey == 0)
+            break;
+        index = (index + 1) & table->mask;
+    }
+
+    reclaimRetiredTables();
+}
+
+// Writer thread only. Copies the live entries into a new table sized for
+// minimumSize entries at a quarter load, dropping the tombstones
+void QNodeLookupTable::rebuild(int minimumSize)
+{
+    int capacityLog2 = MinimumCapacityLog2;
+    while ((quint64(1) << capacityLog2) < quint64(minimumSize) * 4)
+        ++capacityLog2;
+
+    Table *oldTable = m_table.load(std::memory_order_relaxed);
+    Table *newTable = new Table(capacityLog2);
+    for (quint64 i = 0; i <= oldTable->mask; ++i) {
+        const Slot &slot = oldTable->slots[i];
+        const quint64 key = slot.key.load(std::memory_order_relaxed);
+        QNode *node = slot.value.load(std::memory_order_relaxed);
+        if (key == 0 || node == nullptr)
+            continue;
+        quint64 index = newTable->firstSlot(key);
+        while (newTable->slots[index].key.load(std::memory_order_relaxed) != 0)
+            index = (index + 1) & newTable->mask;
+        newTable->slots[index].value.store(node, std::memory_order_relaxed);
+        newTable->slots[index].key.store(key, std::memory_order_relaxed);
+    }
+    m_tombstones = 0;
+
+    // Readers still probing the old table keep it alive until they are done
+    m_table.store(newTable);
+    m_retiredTables.emplace_back(oldTable);
+    reclaimRetiredTables();
+}
+
+// Writer thread only
+void QNodeLookupTable::reclaimRetiredTables()
+{
+    // Any lookup starting after this check loads the current table
+    if (!m_retiredTables.empty() && m_activeLookups.load() == 0)
+        m_retiredTables.clear();
+}
+
+} // namespace Qt3DCore
+
+QT_END_NAMESPACE
@@ -0,0 +1,122 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB)
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DCORE_QNODELOOKUPTABLE_P_H
+#define QT3DCORE_QNODELOOKUPTABLE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DCore/qnodeid.h>
+#include <Qt3DCore/private/qt3dcore_global_p.h>
+#include <QtCore/QList>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+class QNode;
+
+// Open addressing id -> node map with a single writer and lock free readers.
+// Writes (insert/remove) must all happen on the same thread while lookups can
+// run concurrently from any thread. Removed entries are kept as tombstones
+// until the table is rebuilt and replaced tables are only freed once no
+// lookup can still be using them
+class Q_3DCORE_PRIVATE_EXPORT QNodeLookupTable
+{
+public:
+    QNodeLookupTable();
+    ~QNodeLookupTable();
+
+    void insert(QNodeId id, QNode *node);
+    void remove(QNodeId id);
+
+    QNode *lookup(QNodeId id) const;
+    QList<QNode *> lookup(const QList<QNodeId> &ids) const;
+
+    int size() const { return m_size; }
+    int capacity() const;
+
+private:
+    struct Slot
+    {
+        std::atomic<quint64> key;
+        std::atomic<QNode *> value;
+    };
+
+    struct Table
+    {
+        explicit Table(int capacityLog2);
+        quint64 firstSlot(quint64 key) const;
+
+        const int shift;
+        const quint64 mask;
+        std::unique_ptr<Slot[]> slots;
+    };
+
+    static QNode *find(const Table *table, quint64 key);
+    void rebuild(int minimumCapacity);
+    void reclaimRetiredTables();
+
+    std::atomic<Table *> m_table;
+    mutable std::atomic<int> m_activeLookups;
+    std::vector<std::unique_ptr<Table>> m_retiredTables;
+    int m_size;
+    int m_tombstones;
+
+    Q_DISABLE_COPY(QNodeLookupTable)
+};
+
+} // namespace Qt3DCore
+
+QT_END_NAMESPACE
+
+#endif // QT3DCORE_QNODELOOKUPTABLE_P_H
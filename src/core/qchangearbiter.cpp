@@ -48,17 +48,33 @@
 
 #include <Qt3DCore/private/corelogging_p.h>
 #include <Qt3DCore/private/qabstractaspectjobmanager_p.h>
+#include <Qt3DCore/private/qnode_p.h>
 #include <Qt3DCore/private/qscene_p.h>
 
+#include <atomic>
 #include <mutex>
 
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DCore {
 
+namespace {
+
+// Generations are unique across arbiters so that a node stamped by one
+// arbiter is never mistaken as dirty by another one
+quint64 nextDirtyGeneration()
+{
+    static std::atomic<quint64> generation{0};
+    return ++generation;
+}
+
+} // anonymous
+
 QChangeArbiter::QChangeArbiter(QObject *parent)
     : QObject(parent)
     , m_scene(nullptr)
+    , m_dirtyGeneration(nextDirtyGeneration())
+    , m_removedDirtyFrontEndNodeCount(0)
 {
 }
 
@@ -78,7 +94,12 @@ QScene *QChangeArbiter::scene() const
 
 void QChangeArbiter::addDirtyFrontEndNode(QNode *node)
 {
-    if (!m_dirtyFrontEndNodes.contains(node)) {
+    // Membership is tracked on the node itself so that marking many
+    // nodes dirty in a frame doesn't require searching the list
+    QNodePrivate *d = QNodePrivate::get(node);
+    if (d->m_dirtyGeneration != m_dirtyGeneration) {
+        d->m_dirtyGeneration = m_dirtyGeneration;
+        d->m_dirtyIndex = int(m_dirtyFrontEndNodes.size());
         m_dirtyFrontEndNodes += node;
         emit receivedChange();
     }
@@ -93,15 +114,30 @@ void QChangeArbiter::addDirtyEntityComponentNodes(QEntity *entity, QComponent *c
 
 void QChangeArbiter::removeDirtyFrontEndNode(QNode *node)
 {
-    m_dirtyFrontEndNodes.removeOne(node);
-    m_dirtyEntityComponentNodeChanges.erase(std::remove_if(m_dirtyEntityComponentNodeChanges.begin(), m_dirtyEntityComponentNodeChanges.end(), [node](const ComponentRelationshipChange &elt) {
-                                    return elt.node == node || elt.subNode == node;
-                                }), m_dirtyEntityComponentNodeChanges.end());
+    QNodePrivate *d = QNodePrivate::get(node);
+    if (d->m_dirtyGeneration == m_dirtyGeneration) {
+        Q_ASSERT(m_dirtyFrontEndNodes.at(d->m_dirtyIndex) == node);
+        m_dirtyFrontEndNodes[d->m_dirtyIndex] = nullptr;
+        ++m_removedDirtyFrontEndNodeCount;
+    }
+    d->m_dirtyGeneration = 0;
+    d->m_dirtyIndex = -1;
+
+    if (!m_dirtyEntityComponentNodeChanges.isEmpty())
+        m_dirtyEntityComponentNodeChanges.erase(std::remove_if(m_dirtyEntityComponentNodeChanges.begin(), m_dirtyEntityComponentNodeChanges.end(), [node](const ComponentRelationshipChange &elt) {
+                                        return elt.node == node || elt.subNode == node;
+                                    }), m_dirtyEntityComponentNodeChanges.end());
 }
 
 QList<QNode *> QChangeArbiter::takeDirtyFrontEndNodes()
 {
-    return std::move(m_dirtyFrontEndNodes);
+    QList<QNode *> dirtyNodes = std::move(m_dirtyFrontEndNodes);
+    m_dirtyFrontEndNodes.clear();
+    if (m_removedDirtyFrontEndNodeCount > 0)
+        dirtyNodes.removeAll(nullptr);
+    m_removedDirtyFrontEndNodeCount = 0;
+    m_dirtyGeneration = nextDirtyGeneration();
+    return dirtyNodes;
 }
 
 QList<ComponentRelationshipChange> QChangeArbiter::takeDirtyEntityComponentNodes()
@@ -109,6 +145,21 @@ QList<ComponentRelationshipChange> QChangeArbiter::takeDirtyEntityComponentNodes
     return std::move(m_dirtyEntityComponentNodeChanges);
 }
 
+QList<QNode *> QChangeArbiter::dirtyFrontEndNodes() const
+{
+    QList<QNode *> dirtyNodes = m_dirtyFrontEndNodes;
+    if (m_removedDirtyFrontEndNodeCount > 0)
+        dirtyNodes.removeAll(nullptr);
+    return dirtyNodes;
+}
+
+void QChangeArbiter::clearDirtyFrontEndNodes()
+{
+    m_dirtyFrontEndNodes.clear();
+    m_removedDirtyFrontEndNodeCount = 0;
+    m_dirtyGeneration = nextDirtyGeneration();
+}
+
 } // namespace Qt3DCore
 
 QT_END_NAMESPACE
@@ -112,9 +112,20 @@ Q_SIGNALS:
     void receivedChange();
 
 protected:
+    QList<QNode *> dirtyFrontEndNodes() const;
+    void clearDirtyFrontEndNodes();
+
     QScene *m_scene;
     QList<QNode *> m_dirtyFrontEndNodes;
     QList<ComponentRelationshipChange> m_dirtyEntityComponentNodeChanges;
+
+private:
+    // Bumped whenever the dirty list is taken or cleared, which resets the
+    // membership of every node at once
+    quint64 m_dirtyGeneration;
+    // Nodes removed from m_dirtyFrontEndNodes leave a nullptr slot behind
+    // that is compacted when the list is taken
+    int m_removedDirtyFrontEndNodeCount;
 };
 
 } // namespace Qt3DCore
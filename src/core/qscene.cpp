@@ -44,6 +44,7 @@
 #include <QtCore/QReadLocker>
 
 #include <Qt3DCore/private/qnode_p.h>
+#include <Qt3DCore/private/qnodelookuptable_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -61,7 +62,7 @@ public:
     }
 
     QAspectEngine *m_engine;
-    QHash<QNodeId, QNode *> m_nodeLookupTable;
+    QNodeLookupTable m_nodeLookupTable;
     QMultiHash<QNodeId, QNodeId> m_componentToEntities;
     QChangeArbiter *m_arbiter;
     QScopedPointer<NodePostConstructorInit> m_postConstructorInit;
@@ -92,7 +93,6 @@ void QScene::addObservable(QNode *observable)
 {
     Q_D(QScene);
     if (observable != nullptr) {
-        QWriteLocker lock(&d->m_lock);
         d->m_nodeLookupTable.insert(observable->id(), observable);
         if (d->m_arbiter != nullptr)
             observable->d_func()->setArbiter(d->m_arbiter);
@@ -104,30 +104,23 @@ void QScene::removeObservable(QNode *observable)
 {
     Q_D(QScene);
     if (observable != nullptr) {
-        QWriteLocker lock(&d->m_lock);
         const QNodeId nodeUuid = observable->id();
         d->m_nodeLookupTable.remove(nodeUuid);
         observable->d_func()->setArbiter(nullptr);
     }
 }
 
-// Called by any thread
+// Called by any thread, lock free
 QNode *QScene::lookupNode(QNodeId id) const
 {
     Q_D(const QScene);
-    QReadLocker lock(&d->m_lock);
-    return d->m_nodeLookupTable.value(id);
+    return d->m_nodeLookupTable.lookup(id);
 }
 
 QList<QNode *> QScene::lookupNodes(const QList<QNodeId> &ids) const
 {
     Q_D(const QScene);
-    QReadLocker lock(&d->m_lock);
-    QList<QNode *> nodes(ids.size());
-    int index = 0;
-    for (QNodeId id : ids)
-        nodes[index++] = d->m_nodeLookupTable.value(id);
-    return nodes;
+    return d->m_nodeLookupTable.lookup(ids);
 }
 
 QNode *QScene::rootNode() const
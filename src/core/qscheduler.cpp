@@ -135,6 +135,8 @@ int QScheduler::scheduleAndWaitForFrameAspectJobs(qint64 time, bool dumpJobs)
 
     // Do any other work here that the aspect thread can usefully be doing
     // whilst the threadpool works its way through the jobs
+    for (QAbstractAspect *aspect : aspects)
+        QAbstractAspectPrivate::get(aspect)->jobsRunning();
 
     const int totalJobs = m_aspectManager->jobManager()->waitForAllJobs();
 
@@ -56,6 +56,7 @@
 #include <QtCore/QReadLocker>
 #include <QtCore/QReadWriteLock>
 #include <QtCore/QtGlobal>
+#include <algorithm>
 #include <limits>
 
 #include <Qt3DCore/private/qhandle_p.h>
@@ -238,6 +239,7 @@ public:
             allocateBucket();
         typename Handle::Data *d = freeList;
         freeList = freeList->nextFree;
+        --freeCount;
         d->counter = allocCounter;
         allocCounter += 2; // ensure this will never clash with a pointer in nextFree by keeping the lowest bit set
         Handle handle(d);
@@ -251,6 +253,7 @@ public:
         typename Handle::Data *d = handle.data_ptr();
         d->nextFree = freeList;
         freeList = d;
+        ++freeCount;
         performCleanup(&static_cast<QHandleData<T> *>(d)->data, std::integral_constant<bool, QResourceInfo<T>::needsCleanup>{});
     }
 
@@ -259,6 +262,18 @@ public:
         return h.operator->();
     }
 
+    // Makes sure count resources can be allocated without further allocations
+    void reserve(int count)
+    {
+        while (freeCount < count)
+            allocateBucket();
+        // Grow geometrically so that repeated reservations don't
+        // reallocate the handles on each call
+        const size_t required = m_activeHandles.size() + size_t(count);
+        if (m_activeHandles.capacity() < required)
+            m_activeHandles.reserve(std::max(required, 2 * m_activeHandles.capacity()));
+    }
+
     void for_each(std::function<void(T*)> f)
     {
         Bucket *b = firstBucket;
@@ -292,6 +307,7 @@ private:
     Bucket *firstBucket = 0;
     std::vector<Handle> m_activeHandles;
     typename Handle::Data *freeList = 0;
+    int freeCount = 0;
     int allocCounter = 1;
 
     void allocateBucket()
@@ -308,8 +324,9 @@ private:
         for (int i = 0; i < Bucket::NumEntries - 1; ++i) {
             b->data[i].nextFree = &b->data[i + 1];
         }
-        b->data[Bucket::NumEntries - 1].nextFree = nullptr;
+        b->data[Bucket::NumEntries - 1].nextFree = freeList;
         freeList = &b->data[0];
+        freeCount += Bucket::NumEntries;
     }
 
     void deallocateBuckets()
@@ -427,6 +444,16 @@ public:
         return ret;
     }
 
+    // Preallocates storage for count additional resources
+    void reserve(int count)
+    {
+        typename LockingPolicy<QResourceManager>::WriteLocker lock(this);
+        Allocator::reserve(count);
+        const qsizetype required = m_keyToHandleMap.size() + count;
+        if (m_keyToHandleMap.capacity() < required)
+            m_keyToHandleMap.reserve(std::max(required, 2 * m_keyToHandleMap.capacity()));
+    }
+
     ValueType *getOrCreateResource(const KeyType &id)
     {
         const Handle handle = getOrAcquireHandle(id);
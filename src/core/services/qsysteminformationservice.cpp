@@ -50,6 +50,8 @@
 #include <QtCore/QDateTime>
 #include <QtCore/QUrl>
 #include <QtCore/QDir>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
 #include <QtGui/QDesktopServices>
 
 #include <Qt3DCore/QAspectEngine>
@@ -58,6 +60,8 @@
 #include <Qt3DCore/private/qaspectengine_p.h>
 #include <Qt3DCore/private/aspectcommanddebugger_p.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 namespace  {
@@ -91,12 +95,23 @@ QSystemInformationServicePrivate::QSystemInformationServicePrivate(QAspectEngine
     , m_submissionStorage(nullptr)
     , m_frameId(0)
     , m_commandDebugger(nullptr)
+    , m_traceFormat(BinaryTrace)
+    , m_frameStartTime(0)
+    , m_nextFrameTrace(0)
+    , m_maxFrameTraces(600)
 {
     m_traceEnabled = qEnvironmentVariableIsSet("QT3D_TRACE_ENABLED");
     m_graphicsTraceEnabled = qEnvironmentVariableIsSet("QT3D_GRAPHICS_TRACE_ENABLED");
     if (m_traceEnabled || m_graphicsTraceEnabled)
         m_jobsStatTimer.start();
 
+    // The Chrome trace format keeps the last frames in memory so that it can
+    // stay enabled and be captured at any time
+    if (qgetenv("QT3D_TRACE_FORMAT").toLower() == QByteArrayLiteral("chrome"))
+        m_traceFormat = ChromeTrace;
+    if (qEnvironmentVariableIsSet("QT3D_TRACE_FRAME_COUNT"))
+        m_maxFrameTraces = qMax(1, qEnvironmentVariableIntValue("QT3D_TRACE_FRAME_COUNT"));
+
     const bool commandServerEnabled = qEnvironmentVariableIsSet("QT3D_COMMAND_SERVER_ENABLED");
     if (commandServerEnabled) {
         m_commandDebugger = new Debug::AspectCommandDebugger(q_func());
@@ -104,7 +119,11 @@ QSystemInformationServicePrivate::QSystemInformationServicePrivate(QAspectEngine
     }
 }
 
-QSystemInformationServicePrivate::~QSystemInformationServicePrivate() = default;
+QSystemInformationServicePrivate::~QSystemInformationServicePrivate()
+{
+    if (!m_frameTraces.isEmpty())
+        writeChromeTrace();
+}
 
 QSystemInformationServicePrivate *QSystemInformationServicePrivate::get(QSystemInformationService *q)
 {
@@ -154,6 +173,39 @@ void QSystemInformationServicePrivate::writeFrameJobLogStats()
 
     using JobRunStats = QSystemInformationServicePrivate::JobRunStats;
 
+    if (m_frameStatsHandler || m_traceFormat == ChromeTrace) {
+        FrameTrace frame;
+        frame.frameId = m_frameId;
+        frame.startTime = m_frameStartTime;
+        frame.endTime = m_jobsStatTimer.nsecsElapsed();
+        frame.dependencies.swap(m_pendingDependencies);
+
+        for (QList<JobRunStats> *storage : qAsConst(m_localStorages)) {
+            frame.jobStats += *storage;
+            storage->clear();
+        }
+
+        {
+            QMutexLocker lock(&m_localStoragesMutex);
+            if (m_submissionStorage != nullptr)
+                frame.submissionStats.swap(*m_submissionStorage);
+            frame.counters.swap(m_pendingCounters);
+        }
+
+        if (m_frameStatsHandler) {
+            m_frameStatsHandler(frame.frameId, frame.jobStats, frame.submissionStats);
+        } else if (m_frameTraces.size() < m_maxFrameTraces) {
+            m_frameTraces.push_back(std::move(frame));
+        } else {
+            m_frameTraces[m_nextFrameTrace] = std::move(frame);
+            m_nextFrameTrace = (m_nextFrameTrace + 1) % m_maxFrameTraces;
+        }
+
+        m_frameStartTime = m_jobsStatTimer.nsecsElapsed();
+        ++m_frameId;
+        return;
+    }
+
     if (!m_traceFile) {
         const QString fileName = QStringLiteral("trace_") + QCoreApplication::applicationName() +
                                  QDateTime::currentDateTime().toString(QStringLiteral("_yyMMdd-hhmmss_")) +
@@ -215,7 +267,177 @@ void QSystemInformationServicePrivate::updateTracing()
             m_jobsStatTimer.start();
     } else {
         m_traceFile.reset();
+        if (!m_frameTraces.isEmpty())
+            writeChromeTrace();
+        QMutexLocker lock(&m_localStoragesMutex);
+        m_pendingDependencies.clear();
+        m_pendingCounters.clear();
+    }
+}
+
+void QSystemInformationServicePrivate::addJobDependency(const JobId &dependee, const JobId &depender)
+{
+    if ((!m_traceEnabled && !m_graphicsTraceEnabled) || m_traceFormat != ChromeTrace)
+        return;
+    m_pendingDependencies.push_back({ dependee, depender });
+}
+
+void QSystemInformationServicePrivate::addCounterEntry(const char *name, qint64 value)
+{
+    if ((!m_traceEnabled && !m_graphicsTraceEnabled) || m_traceFormat != ChromeTrace)
+        return;
+    const qint64 time = m_jobsStatTimer.nsecsElapsed();
+    QMutexLocker lock(&m_localStoragesMutex);
+    m_pendingCounters.push_back({ time, name, value });
+}
+
+// Writes the frames of the ring buffer as Chrome Trace Event JSON, which can
+// be opened with chrome://tracing or https://ui.perfetto.dev, and empties it
+QString QSystemInformationServicePrivate::writeChromeTrace()
+{
+    if (m_frameTraces.isEmpty())
+        return {};
+
+    const QString fileName = QStringLiteral("trace_") + QCoreApplication::applicationName() +
+                             QDateTime::currentDateTime().toString(QStringLiteral("_yyMMdd-hhmmss_")) +
+                             QSysInfo::productType() + QStringLiteral("_") + QSysInfo::buildAbi() + QStringLiteral(".json");
+#ifdef Q_OS_ANDROID
+    QFile file(QStandardPaths::writableLocation(QStandardPaths::DownloadLocation) + QStringLiteral("/") + fileName);
+#else
+    QFile file(fileName);
+#endif
+    if (!file.open(QFile::WriteOnly|QFile::Truncate)) {
+        qCritical("Failed to open trace file");
+        return {};
     }
+
+    // Oldest frame first
+    std::rotate(m_frameTraces.begin(), m_frameTraces.begin() + m_nextFrameTrace, m_frameTraces.end());
+    const QList<FrameTrace> frames = std::move(m_frameTraces);
+    m_frameTraces.clear();
+    m_nextFrameTrace = 0;
+
+    const auto toUs = [] (qint64 nsecs) { return double(nsecs) / 1000.0; };
+    const int pid = int(QCoreApplication::applicationPid());
+    bool firstEvent = true;
+    const auto writeEvent = [&] (QJsonObject event) {
+        event.insert(QLatin1String("pid"), pid);
+        if (!firstEvent)
+            file.write(",\n");
+        firstEvent = false;
+        file.write(QJsonDocument(event).toJson(QJsonDocument::Compact));
+    };
+    const auto writeThreadName = [&] (int tid, const QString &name) {
+        writeEvent({ { QLatin1String("name"), QLatin1String("thread_name") },
+                     { QLatin1String("ph"), QLatin1String("M") },
+                     { QLatin1String("tid"), tid },
+                     { QLatin1String("args"), QJsonObject { { QLatin1String("name"), name } } } });
+    };
+
+    // Small thread ids, 0 being the track of the frames
+    QHash<quint64, int> workerTids;
+    QHash<quint64, int> submissionTids;
+    const auto tidFor = [&] (QHash<quint64, int> &tids, quint64 threadId, const QString &namePrefix) {
+        auto it = tids.constFind(threadId);
+        if (it != tids.cend())
+            return it.value();
+        const int tid = workerTids.size() + submissionTids.size() + 1;
+        tids.insert(threadId, tid);
+        writeThreadName(tid, namePrefix + QString::number(tids.size()));
+        return tid;
+    };
+
+    file.write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    writeEvent({ { QLatin1String("name"), QLatin1String("process_name") },
+                 { QLatin1String("ph"), QLatin1String("M") },
+                 { QLatin1String("args"), QJsonObject { { QLatin1String("name"), QCoreApplication::applicationName() } } } });
+    writeThreadName(0, QStringLiteral("Frames"));
+
+    int flowId = 0;
+    for (const FrameTrace &frame : frames) {
+        const QString frameName = QStringLiteral("Frame ") + QString::number(frame.frameId);
+        writeEvent({ { QLatin1String("name"), frameName },
+                     { QLatin1String("ph"), QLatin1String("i") },
+                     { QLatin1String("s"), QLatin1String("g") },
+                     { QLatin1String("tid"), 0 },
+                     { QLatin1String("ts"), toUs(frame.startTime) } });
+        writeEvent({ { QLatin1String("name"), frameName },
+                     { QLatin1String("cat"), QLatin1String("frame") },
+                     { QLatin1String("ph"), QLatin1String("X") },
+                     { QLatin1String("tid"), 0 },
+                     { QLatin1String("ts"), toUs(frame.startTime) },
+                     { QLatin1String("dur"), toUs(frame.endTime - frame.startTime) } });
+
+        QHash<quint64, QPair<const JobRunStats *, int>> jobs;
+        const auto writeSpans = [&] (const QList<JobRunStats> &stats, bool submission) {
+            for (const JobRunStats &stat : stats) {
+                const int tid = submission
+                        ? tidFor(submissionTids, stat.threadId, QStringLiteral("Submission Thread "))
+                        : tidFor(workerTids, stat.threadId, QStringLiteral("Job Thread "));
+                if (!submission)
+                    jobs.insert(stat.jobId.id, { &stat, tid });
+                writeEvent({ { QLatin1String("name"), jobTypeName(stat.jobId.typeAndInstance[0]) },
+                             { QLatin1String("cat"), submission ? QLatin1String("submission") : QLatin1String("job") },
+                             { QLatin1String("ph"), QLatin1String("X") },
+                             { QLatin1String("tid"), tid },
+                             { QLatin1String("ts"), toUs(stat.startTime) },
+                             { QLatin1String("dur"), toUs(stat.endTime - stat.startTime) },
+                             { QLatin1String("args"), QJsonObject {
+                                   { QLatin1String("frame"), qint64(frame.frameId) },
+                                   { QLatin1String("instance"), qint64(stat.jobId.typeAndInstance[1]) } } } });
+            }
+        };
+        writeSpans(frame.jobStats, false);
+        writeSpans(frame.submissionStats, true);
+
+        // Dependency arrows, bound to the spans of the dependee and depender
+        for (const auto &dependency : frame.dependencies) {
+            const auto dependee = jobs.constFind(dependency.first.id);
+            const auto depender = jobs.constFind(dependency.second.id);
+            if (dependee == jobs.cend() || depender == jobs.cend())
+                continue;
+            ++flowId;
+            writeEvent({ { QLatin1String("name"), QLatin1String("dependency") },
+                         { QLatin1String("cat"), QLatin1String("dependency") },
+                         { QLatin1String("ph"), QLatin1String("s") },
+                         { QLatin1String("id"), flowId },
+                         { QLatin1String("tid"), dependee->second },
+                         { QLatin1String("ts"), toUs(dependee->first->startTime) } });
+            writeEvent({ { QLatin1String("name"), QLatin1String("dependency") },
+                         { QLatin1String("cat"), QLatin1String("dependency") },
+                         { QLatin1String("ph"), QLatin1String("f") },
+                         { QLatin1String("bp"), QLatin1String("e") },
+                         { QLatin1String("id"), flowId },
+                         { QLatin1String("tid"), depender->second },
+                         { QLatin1String("ts"), toUs(depender->first->startTime) } });
+        }
+
+        for (const CounterEntry &counter : frame.counters) {
+            writeEvent({ { QLatin1String("name"), QLatin1String(counter.name) },
+                         { QLatin1String("ph"), QLatin1String("C") },
+                         { QLatin1String("tid"), 0 },
+                         { QLatin1String("ts"), toUs(counter.time) },
+                         { QLatin1String("args"), QJsonObject { { QLatin1String("value"), counter.value } } } });
+        }
+    }
+
+    file.write("\n]}\n");
+    return file.fileName();
+}
+
+void QSystemInformationServicePrivate::registerJobTypeName(quint32 jobType, const QString &name)
+{
+    if (!name.isEmpty() && !m_jobTypeNames.contains(jobType))
+        m_jobTypeNames.insert(jobType, name);
+}
+
+QString QSystemInformationServicePrivate::jobTypeName(quint32 jobType) const
+{
+    const auto it = m_jobTypeNames.constFind(jobType);
+    if (it != m_jobTypeNames.cend())
+        return it.value();
+    return QString::number(jobType);
 }
 
 
@@ -404,6 +626,9 @@ QVariant QSystemInformationService::executeCommand(const QString &command)
         return  {isTraceEnabled()};
     }
 
+    if (command == QLatin1String("tracing capture"))
+        return { d->writeChromeTrace() };
+
     if (command == QLatin1String("glprofiling on")) {
         setGraphicsTraceEnabled(true);
         return  {isTraceEnabled()};
@@ -55,6 +55,9 @@
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
 #include <QtCore/QMutex>
+#include <QtCore/QHash>
+
+#include <functional>
 
 #include <Qt3DCore/qt3dcore_global.h>
 #include <Qt3DCore/private/qt3dcore_global_p.h>
@@ -92,6 +95,34 @@ public:
         quint64 threadId;
     };
 
+    struct CounterEntry
+    {
+        qint64 time;
+        const char *name; // Static string
+        qint64 value;
+    };
+
+    struct FrameTrace
+    {
+        quint32 frameId = 0;
+        qint64 startTime = 0;
+        qint64 endTime = 0;
+        QList<JobRunStats> jobStats;
+        QList<JobRunStats> submissionStats;
+        QList<QPair<JobId, JobId>> dependencies; // Dependee, depender
+        QList<CounterEntry> counters;
+    };
+
+    enum TraceFormat {
+        BinaryTrace,    // .qt3d file written every frame
+        ChromeTrace     // Chrome Trace Event JSON file written from the last frames on demand
+    };
+
+    // Receives the stats of each frame in place of the trace file when set
+    using FrameStatsHandler = std::function<void (quint32 frameId,
+                                                  const QList<JobRunStats> &jobStats,
+                                                  const QList<JobRunStats> &submissionStats)>;
+
     QSystemInformationServicePrivate(QAspectEngine *aspectEngine, const QString &description);
     ~QSystemInformationServicePrivate();
 
@@ -106,6 +137,18 @@ public:
     void writeFrameJobLogStats();
     void updateTracing();
 
+    // Main thread, when jobs are enqueued
+    void addJobDependency(const JobId &dependee, const JobId &depender);
+
+    // Aspect and submission threads
+    void addCounterEntry(const char *name, qint64 value);
+
+    QString writeChromeTrace();
+
+    // Main thread, when jobs are enqueued
+    void registerJobTypeName(quint32 jobType, const QString &name);
+    QString jobTypeName(quint32 jobType) const;
+
     QAspectEngine *m_aspectEngine;
     bool m_traceEnabled;
     bool m_graphicsTraceEnabled;
@@ -121,6 +164,19 @@ public:
     QScopedPointer<QFile> m_traceFile;
     quint32 m_frameId;
 
+    FrameStatsHandler m_frameStatsHandler;
+    QHash<quint32, QString> m_jobTypeNames;
+
+    TraceFormat m_traceFormat;
+    qint64 m_frameStartTime;
+    QList<QPair<JobId, JobId>> m_pendingDependencies;
+    QList<CounterEntry> m_pendingCounters;
+
+    // Ring buffer of the last m_maxFrameTraces frames, in ChromeTrace format
+    QList<FrameTrace> m_frameTraces;
+    int m_nextFrameTrace;
+    int m_maxFrameTraces;
+
     Debug::AspectCommandDebugger *m_commandDebugger;
 
     Q_DECLARE_PUBLIC(QSystemInformationService)
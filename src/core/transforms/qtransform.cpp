@@ -53,6 +53,7 @@ QTransformPrivate::QTransformPrivate()
     , m_translation()
     , m_eulerRotationAngles()
     , m_matrixDirty(false)
+    , m_worldMatrixUpdatesEnabled(true)
 {
     m_shareable = false;
 }
@@ -144,6 +145,20 @@ QTransformPrivate::~QTransformPrivate()
     \since 5.14
  */
 
+/*!
+    \qmlproperty bool Transform::worldMatrixUpdatesEnabled
+
+    Holds whether \l worldMatrix is kept up to date. Writing back the world
+    matrices has a cost for scenes with many moving entities. Setting this to
+    false stops updating the world matrix of this transform as well as those
+    of the transforms of every Entity below the one referencing it. Once set
+    back to true, these world matrices are refreshed on the next frame.
+
+    Defaults to true.
+
+    \since 6.0
+ */
+
 /*!
     \qmlmethod quaternion Transform::fromAxisAndAngle(vector3d axis, real angle)
     Creates a quaternion from \a axis and \a angle.
@@ -234,12 +249,18 @@ QTransform::QTransform(QTransformPrivate &dd, QNode *parent)
 
 void QTransformPrivate::setWorldMatrix(const QMatrix4x4 &worldMatrix)
 {
-    Q_Q(QTransform);
     if (m_worldMatrix == worldMatrix)
         return;
-    const bool blocked = q->blockNotifications(true);
     m_worldMatrix = worldMatrix;
-    emit q->worldMatrixChanged(worldMatrix);
+    notifyWorldMatrixChanged();
+}
+
+// Lets batched updates store all world matrices before notifying
+void QTransformPrivate::notifyWorldMatrixChanged()
+{
+    Q_Q(QTransform);
+    const bool blocked = q->blockNotifications(true);
+    emit q->worldMatrixChanged(m_worldMatrix);
     q->blockNotifications(blocked);
 }
 
@@ -266,6 +287,9 @@ void QTransform::setMatrix(const QMatrix4x4 &m)
         d->m_rotation = r;
         d->m_translation = t;
         d->m_eulerRotationAngles = d->m_rotation.toEulerAngles();
+        d->markFieldsChanged(QTransformPrivate::RotationField
+                             | QTransformPrivate::ScaleField
+                             | QTransformPrivate::TranslationField);
         emit scale3DChanged(s);
         emit rotationChanged(r);
         emit translationChanged(t);
@@ -291,6 +315,7 @@ void QTransform::setRotationX(float rotationX)
     if (rotation != d->m_rotation) {
         d->m_rotation = rotation;
         d->m_matrixDirty = true;
+        d->markFieldsChanged(QTransformPrivate::RotationField);
         emit rotationChanged(rotation);
     }
 
@@ -312,6 +337,7 @@ void QTransform::setRotationY(float rotationY)
     if (rotation != d->m_rotation) {
         d->m_rotation = rotation;
         d->m_matrixDirty = true;
+        d->markFieldsChanged(QTransformPrivate::RotationField);
         emit rotationChanged(rotation);
     }
 
@@ -332,6 +358,7 @@ void QTransform::setRotationZ(float rotationZ)
     if (rotation != d->m_rotation) {
         d->m_rotation = rotation;
         d->m_matrixDirty = true;
+        d->markFieldsChanged(QTransformPrivate::RotationField);
         emit rotationChanged(rotation);
     }
 
@@ -381,6 +408,35 @@ QMatrix4x4 QTransform::worldMatrix() const
     return d->m_worldMatrix;
 }
 
+/*!
+    \property QTransform::worldMatrixUpdatesEnabled
+
+    Holds whether \l worldMatrix is kept up to date. Writing back the world
+    matrices has a cost for scenes with many moving entities. Setting this to
+    false stops updating the world matrix of this transform as well as those
+    of the transforms of every QEntity below the one referencing it. Once set
+    back to true, these world matrices are refreshed on the next frame.
+
+    Defaults to true.
+
+    \since 6.0
+ */
+bool QTransform::worldMatrixUpdatesEnabled() const
+{
+    Q_D(const QTransform);
+    return d->m_worldMatrixUpdatesEnabled;
+}
+
+void QTransform::setWorldMatrixUpdatesEnabled(bool enabled)
+{
+    Q_D(QTransform);
+    if (d->m_worldMatrixUpdatesEnabled != enabled) {
+        d->m_worldMatrixUpdatesEnabled = enabled;
+        d->markFieldsChanged(QTransformPrivate::WorldMatrixUpdatesField);
+        emit worldMatrixUpdatesEnabledChanged(enabled);
+    }
+}
+
 /*!
     \property Qt3DCore::QTransform::rotationX
 
@@ -420,6 +476,7 @@ void QTransform::setScale3D(const QVector3D &scale)
     if (scale != d->m_scale) {
         d->m_scale = scale;
         d->m_matrixDirty = true;
+        d->markFieldsChanged(QTransformPrivate::ScaleField);
         emit scale3DChanged(scale);
 
         const bool wasBlocked = blockNotifications(true);
@@ -471,6 +528,7 @@ void QTransform::setRotation(const QQuaternion &rotation)
         const QVector3D oldRotation = d->m_eulerRotationAngles;
         d->m_eulerRotationAngles = d->m_rotation.toEulerAngles();
         d->m_matrixDirty = true;
+        d->markFieldsChanged(QTransformPrivate::RotationField);
         emit rotationChanged(rotation);
 
         const bool wasBlocked = blockNotifications(true);
@@ -502,6 +560,7 @@ void QTransform::setTranslation(const QVector3D &translation)
     if (translation != d->m_translation) {
         d->m_translation = translation;
         d->m_matrixDirty = true;
+        d->markFieldsChanged(QTransformPrivate::TranslationField);
         emit translationChanged(translation);
 
         const bool wasBlocked = blockNotifications(true);
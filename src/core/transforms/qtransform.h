@@ -62,6 +62,7 @@ class Q_3DCORESHARED_EXPORT QTransform : public QComponent
     Q_PROPERTY(float rotationY READ rotationY WRITE setRotationY NOTIFY rotationYChanged)
     Q_PROPERTY(float rotationZ READ rotationZ WRITE setRotationZ NOTIFY rotationZChanged)
     Q_PROPERTY(QMatrix4x4 worldMatrix READ worldMatrix NOTIFY worldMatrixChanged REVISION 14)
+    Q_PROPERTY(bool worldMatrixUpdatesEnabled READ worldMatrixUpdatesEnabled WRITE setWorldMatrixUpdatesEnabled NOTIFY worldMatrixUpdatesEnabledChanged REVISION 16)
 
 public:
     explicit QTransform(QNode *parent = nullptr);
@@ -90,6 +91,7 @@ public:
 
     QMatrix4x4 matrix() const;
     QMatrix4x4 worldMatrix() const;
+    bool worldMatrixUpdatesEnabled() const;
 
     float rotationX() const;
     float rotationY() const;
@@ -105,6 +107,7 @@ public Q_SLOTS:
     void setRotationX(float rotationX);
     void setRotationY(float rotationY);
     void setRotationZ(float rotationZ);
+    void setWorldMatrixUpdatesEnabled(bool enabled);
 
 Q_SIGNALS:
     void scaleChanged(float scale);
@@ -116,6 +119,7 @@ Q_SIGNALS:
     void rotationYChanged(float rotationY);
     void rotationZChanged(float rotationZ);
     void worldMatrixChanged(const QMatrix4x4 &worldMatrix);
+    Q_REVISION(16) void worldMatrixUpdatesEnabledChanged(bool enabled);
 
 protected:
     explicit QTransform(QTransformPrivate &dd, QNode *parent = nullptr);
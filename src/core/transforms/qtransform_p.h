@@ -65,6 +65,14 @@ public:
     QTransformPrivate();
     ~QTransformPrivate();
 
+    // Fields recorded with markFieldsChanged()
+    enum ChangedField : quint32 {
+        RotationField = 1 << 0,
+        ScaleField = 1 << 1,
+        TranslationField = 1 << 2,
+        WorldMatrixUpdatesField = 1 << 3
+    };
+
     // Stored in this order as QQuaternion is bigger than QVector3D
     // Operations are applied in the order of:
     // scale, rotation, translation
@@ -79,8 +87,10 @@ public:
     QMatrix4x4 m_worldMatrix;
 
     bool m_dirty;
+    bool m_worldMatrixUpdatesEnabled;
 
     void setWorldMatrix(const QMatrix4x4 &worldMatrix);
+    void notifyWorldMatrixChanged();
     void update() override;
 };
 
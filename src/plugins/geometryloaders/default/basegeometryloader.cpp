@@ -39,12 +39,16 @@
 
 #include "basegeometryloader_p.h"
 
+#include <QtCore/QBuffer>
+#include <QtCore/QFileDevice>
+
 #include <Qt3DCore/qattribute.h>
 #include <Qt3DCore/qbuffer.h>
 #include <Qt3DCore/qgeometry.h>
 
 #include <Qt3DRender/private/qaxisalignedboundingbox_p.h>
 #include <Qt3DRender/private/renderlogging_p.h>
+#include <Qt3DRender/private/vertexattributegenerators_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -59,6 +63,7 @@ BaseGeometryLoader::BaseGeometryLoader()
     , m_generateTangents(true)
     , m_centerMesh(false)
     , m_geometry(nullptr)
+    , m_hasGeneratedGeometry(false)
 {
 }
 
@@ -69,9 +74,13 @@ Qt3DCore::QGeometry *BaseGeometryLoader::geometry() const
 
 bool BaseGeometryLoader::load(QIODevice *ioDev, const QString &subMesh)
 {
+    m_hasGeneratedGeometry = false;
     if (!doLoad(ioDev, subMesh))
         return false;
 
+    if (m_hasGeneratedGeometry)
+        return true;
+
     if (m_normals.isEmpty())
         generateAveragedNormals(m_points, m_normals, m_indices);
 
@@ -93,29 +102,20 @@ bool BaseGeometryLoader::load(QIODevice *ioDev, const QString &subMesh)
     return true;
 }
 
+// The vertex attribute generators work on packed float arrays
+static_assert(sizeof(QVector2D) == 2 * sizeof(float), "QVector2D is expected to be packed");
+static_assert(sizeof(QVector3D) == 3 * sizeof(float), "QVector3D is expected to be packed");
+static_assert(sizeof(QVector4D) == 4 * sizeof(float), "QVector4D is expected to be packed");
+
 void BaseGeometryLoader::generateAveragedNormals(const QList<QVector3D> &points,
                                                  QList<QVector3D> &normals,
                                                  const QList<unsigned int> &faces) const
 {
-    for (int i = 0; i < points.size(); ++i)
-        normals.append(QVector3D());
-
-    for (int i = 0; i < faces.size(); i += 3) {
-        const QVector3D &p1 = points[ faces[i]   ];
-        const QVector3D &p2 = points[ faces[i+1] ];
-        const QVector3D &p3 = points[ faces[i+2] ];
-
-        const QVector3D a = p2 - p1;
-        const QVector3D b = p3 - p1;
-        const QVector3D n = QVector3D::crossProduct(a, b).normalized();
-
-        normals[ faces[i]   ] += n;
-        normals[ faces[i+1] ] += n;
-        normals[ faces[i+2] ] += n;
-    }
-
-    for (int i = 0; i < normals.size(); ++i)
-        normals[i].normalize();
+    normals.resize(points.size());
+    VertexAttributeGenerators::generateAveragedNormals(reinterpret_cast<const float *>(points.constData()), 3,
+                                                       points.size(),
+                                                       faces.constData(), faces.size(),
+                                                       reinterpret_cast<float *>(normals.data()), 3);
 }
 
 void BaseGeometryLoader::generateGeometry()
@@ -153,33 +153,55 @@ void BaseGeometryLoader::generateGeometry()
         }
     } // of buffer filling loop
 
+    createGeometry(bufferBytes, count, hasTextureCoordinates(), hasNormals(), hasTangents());
+}
+
+// Creates m_geometry from vertices interleaved in the position, texture
+// coordinates, normal and tangent order, and from m_indices
+void BaseGeometryLoader::createGeometry(const QByteArray &vertexBytes, int count,
+                                        bool hasTexCoords, bool hasNormals, bool hasTangents)
+{
+    int offset = sizeof(float) * 3;
+    const int texCoordOffset = hasTexCoords ? offset : -1;
+    offset += hasTexCoords ? sizeof(float) * 2 : 0;
+    const int normalOffset = hasNormals ? offset : -1;
+    offset += hasNormals ? sizeof(float) * 3 : 0;
+    const int tangentOffset = hasTangents ? offset : -1;
+    offset += hasTangents ? sizeof(float) * 4 : 0;
+
+    createGeometry(vertexBytes, count, offset, 0, texCoordOffset, normalOffset, tangentOffset);
+}
+
+// Creates m_geometry from float vertex attributes laid out at the given byte
+// offsets of vertices stride bytes apart, and from m_indices. Attributes with
+// a negative offset are not present
+void BaseGeometryLoader::createGeometry(const QByteArray &vertexBytes, int count, quint32 stride,
+                                        int positionOffset, int texCoordOffset,
+                                        int normalOffset, int tangentOffset)
+{
     auto *buf = new Qt3DCore::QBuffer();
-    buf->setData(bufferBytes);
+    buf->setData(vertexBytes);
 
     if (m_geometry)
         qDebug(BaseGeometryLoaderLog, "Existing geometry instance getting overridden.");
     m_geometry = new QGeometry();
 
-    QAttribute *positionAttribute = new QAttribute(buf, QAttribute::defaultPositionAttributeName(), QAttribute::Float, 3, count, 0, stride);
+    QAttribute *positionAttribute = new QAttribute(buf, QAttribute::defaultPositionAttributeName(), QAttribute::Float, 3, count, positionOffset, stride);
     m_geometry->addAttribute(positionAttribute);
-    quint32 offset = sizeof(float) * 3;
 
-    if (hasTextureCoordinates()) {
-        QAttribute *texCoordAttribute = new QAttribute(buf, QAttribute::defaultTextureCoordinateAttributeName(),  QAttribute::Float, 2, count, offset, stride);
+    if (texCoordOffset >= 0) {
+        QAttribute *texCoordAttribute = new QAttribute(buf, QAttribute::defaultTextureCoordinateAttributeName(),  QAttribute::Float, 2, count, texCoordOffset, stride);
         m_geometry->addAttribute(texCoordAttribute);
-        offset += sizeof(float) * 2;
     }
 
-    if (hasNormals()) {
-        QAttribute *normalAttribute = new QAttribute(buf, QAttribute::defaultNormalAttributeName(), QAttribute::Float, 3, count, offset, stride);
+    if (normalOffset >= 0) {
+        QAttribute *normalAttribute = new QAttribute(buf, QAttribute::defaultNormalAttributeName(), QAttribute::Float, 3, count, normalOffset, stride);
         m_geometry->addAttribute(normalAttribute);
-        offset += sizeof(float) * 3;
     }
 
-    if (hasTangents()) {
-        QAttribute *tangentAttribute = new QAttribute(buf, QAttribute::defaultTangentAttributeName(),QAttribute::Float, 4, count, offset, stride);
+    if (tangentOffset >= 0) {
+        QAttribute *tangentAttribute = new QAttribute(buf, QAttribute::defaultTangentAttributeName(),QAttribute::Float, 4, count, tangentOffset, stride);
         m_geometry->addAttribute(tangentAttribute);
-        offset += sizeof(float) * 4;
     }
 
     QByteArray indexBytes;
@@ -206,6 +228,45 @@ void BaseGeometryLoader::generateGeometry()
     m_geometry->addAttribute(indexAttribute);
 }
 
+DeviceContent::DeviceContent(QIODevice *ioDev)
+    : m_data(nullptr)
+    , m_size(0)
+    , m_file(qobject_cast<QFileDevice *>(ioDev))
+    , m_mappedData(nullptr)
+{
+    const qint64 offset = ioDev->pos();
+    const qint64 size = ioDev->size() - offset;
+
+    if (m_file && !ioDev->isSequential() && size > 0)
+        m_mappedData = m_file->map(offset, size);
+    if (m_mappedData) {
+        m_data = reinterpret_cast<const char *>(m_mappedData);
+        m_size = size;
+        ioDev->seek(offset + size);
+        return;
+    }
+
+    // Loaders handle CRLF line endings themselves, so the raw content of
+    // buffers can be used even when they were opened in text mode
+    QT_PREPEND_NAMESPACE(QBuffer) *buffer = qobject_cast<QT_PREPEND_NAMESPACE(QBuffer) *>(ioDev);
+    if (buffer) {
+        m_data = buffer->data().constData() + offset;
+        m_size = buffer->data().size() - offset;
+        ioDev->seek(buffer->data().size());
+        return;
+    }
+
+    m_storage = ioDev->readAll();
+    m_data = m_storage.constData();
+    m_size = m_storage.size();
+}
+
+DeviceContent::~DeviceContent()
+{
+    if (m_mappedData)
+        m_file->unmap(m_mappedData);
+}
+
 void BaseGeometryLoader::generateTangents(const QList<QVector3D> &points,
                                           const QList<QVector3D> &normals,
                                           const QList<unsigned  int> &faces,
@@ -213,53 +274,13 @@ void BaseGeometryLoader::generateTangents(const QList<QVector3D> &points,
                                           QList<QVector4D> &tangents) const
 {
     tangents.clear();
-    QList<QVector3D> tan1Accum;
-    QList<QVector3D> tan2Accum;
-
-    tan1Accum.resize(points.size());
-    tan2Accum.resize(points.size());
     tangents.resize(points.size());
-
-    // Compute the tangent vector
-    for (int i = 0; i < faces.size(); i += 3) {
-        const QVector3D &p1 = points[ faces[i] ];
-        const QVector3D &p2 = points[ faces[i+1] ];
-        const QVector3D &p3 = points[ faces[i+2] ];
-
-        const QVector2D &tc1 = texCoords[ faces[i] ];
-        const QVector2D &tc2 = texCoords[ faces[i+1] ];
-        const QVector2D &tc3 = texCoords[ faces[i+2] ];
-
-        const QVector3D q1 = p2 - p1;
-        const QVector3D q2 = p3 - p1;
-        const float s1 = tc2.x() - tc1.x(), s2 = tc3.x() - tc1.x();
-        const float t1 = tc2.y() - tc1.y(), t2 = tc3.y() - tc1.y();
-        const float r = 1.0f / (s1 * t2 - s2 * t1);
-        const QVector3D tan1((t2 * q1.x() - t1 * q2.x()) * r,
-                             (t2 * q1.y() - t1 * q2.y()) * r,
-                             (t2 * q1.z() - t1 * q2.z()) * r);
-        const QVector3D tan2((s1 * q2.x() - s2 * q1.x()) * r,
-                             (s1 * q2.y() - s2 * q1.y()) * r,
-                             (s1 * q2.z() - s2 * q1.z()) * r);
-        tan1Accum[ faces[i]   ] += tan1;
-        tan1Accum[ faces[i+1] ] += tan1;
-        tan1Accum[ faces[i+2] ] += tan1;
-        tan2Accum[ faces[i]   ] += tan2;
-        tan2Accum[ faces[i+1] ] += tan2;
-        tan2Accum[ faces[i+2] ] += tan2;
-    }
-
-    for (int i = 0; i < points.size(); ++i) {
-        const QVector3D &n = normals[i];
-        const QVector3D &t1 = tan1Accum[i];
-        const QVector3D &t2 = tan2Accum[i];
-
-        // Gram-Schmidt orthogonalize
-        tangents[i] = QVector4D(QVector3D(t1 - QVector3D::dotProduct(n, t1) * n).normalized(), 0.0f);
-
-        // Store handedness in w
-        tangents[i].setW((QVector3D::dotProduct(QVector3D::crossProduct(n, t1), t2) < 0.0f) ? -1.0f : 1.0f);
-    }
+    VertexAttributeGenerators::generateTangents(reinterpret_cast<const float *>(points.constData()), 3,
+                                                reinterpret_cast<const float *>(normals.constData()), 3,
+                                                reinterpret_cast<const float *>(texCoords.constData()), 2,
+                                                points.size(),
+                                                faces.constData(), faces.size(),
+                                                reinterpret_cast<float *>(tangents.data()), 4);
 }
 
 void BaseGeometryLoader::center(QList<QVector3D> &points)
@@ -53,6 +53,7 @@
 
 #include <QtCore/QObject>
 #include <QtCore/QList>
+#include <QtCore/QByteArray>
 
 #include <QtGui/QVector2D>
 #include <QtGui/QVector3D>
@@ -65,6 +66,7 @@
 QT_BEGIN_NAMESPACE
 
 class QIODevice;
+class QFileDevice;
 class QString;
 
 namespace Qt3DCore {
@@ -108,7 +110,16 @@ protected:
     void generateAveragedNormals(const QList<QVector3D>& points,
                                  QList<QVector3D>& normals,
                                  const QList<unsigned int>& faces) const;
+    bool needsPostProcessing(bool hasNormals, bool hasTexCoords) const
+    {
+        return !hasNormals || (m_generateTangents && hasTexCoords) || m_centerMesh;
+    }
     void generateGeometry();
+    void createGeometry(const QByteArray &vertexBytes, int count,
+                        bool hasTexCoords, bool hasNormals, bool hasTangents);
+    void createGeometry(const QByteArray &vertexBytes, int count, quint32 stride,
+                        int positionOffset, int texCoordOffset,
+                        int normalOffset, int tangentOffset);
     void generateTangents(const QList<QVector3D>& points,
                           const QList<QVector3D>& normals,
                           const QList<unsigned int>& faces,
@@ -127,6 +138,33 @@ protected:
     QList<unsigned int> m_indices;
 
     Qt3DCore::QGeometry *m_geometry;
+    // Set by doLoad when it created m_geometry itself, skipping generateGeometry
+    bool m_hasGeneratedGeometry;
+};
+
+/*
+ * Gives access to the remaining content of a device without copying it
+ * when possible: local files are memory mapped and buffers are used in
+ * place. Other devices are read into memory.
+ */
+class DeviceContent
+{
+public:
+    explicit DeviceContent(QIODevice *ioDev);
+    ~DeviceContent();
+
+    const char *data() const { return m_data; }
+    qint64 size() const { return m_size; }
+    bool isMapped() const { return m_mappedData != nullptr; }
+
+private:
+    Q_DISABLE_COPY(DeviceContent)
+
+    const char *m_data;
+    qint64 m_size;
+    QByteArray m_storage;
+    QFileDevice *m_file;
+    uchar *m_mappedData;
 };
 
 struct FaceIndices
@@ -39,8 +39,14 @@
 
 #include "objgeometryloader.h"
 
+#include <QtCore/QHash>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QThread>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <cstring>
+#include <numeric>
 
 QT_BEGIN_NAMESPACE
 
@@ -48,171 +54,499 @@ namespace Qt3DRender {
 
 Q_LOGGING_CATEGORY(ObjGeometryLoaderLog, "Qt3D.ObjGeometryLoader", QtWarningMsg)
 
-static void addFaceVertex(const FaceIndices &faceIndices,
-                          QList<FaceIndices> &faceIndexVector,
-                          QHash<FaceIndices, unsigned int> &faceIndexMap);
+inline size_t qHash(const FaceIndices &faceIndices, size_t seed = 0) noexcept
+{
+    return qHashMulti(seed, faceIndices.positionIndex,
+                      faceIndices.texCoordIndex, faceIndices.normalIndex);
+}
+
+namespace {
 
-inline uint qHash(const FaceIndices &faceIndices)
+// Files smaller than this are parsed as a single chunk
+const qint64 MinimumChunkSize = 1 << 20;
+
+struct Token
 {
-    return faceIndices.positionIndex
-            + 10 * faceIndices.texCoordIndex
-            + 100 * faceIndices.normalIndex;
+    const char *begin;
+    const char *end;
+
+    int size() const { return int(end - begin); }
+    bool operator==(const char *keyword) const
+    {
+        return size() == int(qstrlen(keyword)) && memcmp(begin, keyword, size()) == 0;
+    }
+};
+
+using LineTokens = QVarLengthArray<Token, 16>;
+
+inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
 }
 
-bool ObjGeometryLoader::doLoad(QIODevice *ioDev, const QString &subMesh)
+void tokenize(const char *begin, const char *end, LineTokens &tokens)
 {
-    // Parse faces taking into account each vertex in a face can index different indices
-    // for the positions, normals and texture coords;
-    // Generate unique vertices (in OpenGL parlance) and output to points, texCoords,
-    // normals and calculate mapping from faces to unique indices
+    tokens.clear();
+    const char *it = begin;
+    while (it != end) {
+        while (it != end && isSpace(*it))
+            ++it;
+        if (it == end)
+            break;
+        const char *tokenBegin = it;
+        while (it != end && !isSpace(*it))
+            ++it;
+        tokens.append({ tokenBegin, it });
+    }
+}
+
+// Parses the common "[-]ddd.ddd[e[-]dd]" form exactly as long as the mantissa
+// fits in 19 digits and the power of ten is exactly representable, and falls
+// back to qstrntod for everything else
+float parseFloat(const Token &token)
+{
+    static const double powersOf10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    const int maxExponent = int(sizeof(powersOf10) / sizeof(powersOf10[0])) - 1;
+
+    const char *it = token.begin;
+    const char *end = token.end;
+    bool negative = false;
+    if (it != end && (*it == '-' || *it == '+'))
+        negative = (*it++ == '-');
+
+    quint64 mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool hasDigits = false;
+    while (it != end && *it >= '0' && *it <= '9') {
+        hasDigits = true;
+        if (mantissa != 0 || *it != '0')
+            ++digits;
+        mantissa = mantissa * 10 + quint64(*it++ - '0');
+    }
+    if (it != end && *it == '.') {
+        ++it;
+        while (it != end && *it >= '0' && *it <= '9') {
+            hasDigits = true;
+            if (mantissa != 0 || *it != '0')
+                ++digits;
+            mantissa = mantissa * 10 + quint64(*it++ - '0');
+            --exponent;
+        }
+    }
+    if (hasDigits && it != end && (*it == 'e' || *it == 'E')) {
+        ++it;
+        bool negativeExponent = false;
+        if (it != end && (*it == '-' || *it == '+'))
+            negativeExponent = (*it++ == '-');
+        int explicitExponent = 0;
+        while (it != end && *it >= '0' && *it <= '9' && explicitExponent < 10000)
+            explicitExponent = explicitExponent * 10 + (*it++ - '0');
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+
+    if (!hasDigits || it != end || digits > 19 || exponent < -maxExponent || exponent > maxExponent)
+        return float(qstrntod(token.begin, token.size(), nullptr, nullptr));
+
+    double value = double(mantissa);
+    if (exponent < 0)
+        value /= powersOf10[-exponent];
+    else
+        value *= powersOf10[exponent];
+    return float(negative ? -value : value);
+}
+
+// Same semantics as strtol for the decimal integers found in face elements:
+// parsing stops at the first non digit and an empty string gives 0
+int parseInt(const char *it, const char *end)
+{
+    bool negative = false;
+    if (it != end && (*it == '-' || *it == '+'))
+        negative = (*it++ == '-');
+    int value = 0;
+    while (it != end && *it >= '0' && *it <= '9')
+        value = value * 10 + (*it++ - '0');
+    return negative ? -value : value;
+}
+
+struct ObjSection
+{
+    QString name;
+    int positionBegin;
+    int texCoordBegin;
+    int normalBegin;
+    int cornerBegin;
+};
+
+// Part of a chunk which belongs to a submesh that was not skipped
+struct KeptRange
+{
+    int positionBegin;
+    int positionEnd;
+    int positionTarget;
+    int texCoordBegin;
+    int texCoordEnd;
+    int texCoordTarget;
+    int normalBegin;
+    int normalEnd;
+    int normalTarget;
+    int cornerBegin;
+    int cornerEnd;
+    unsigned int positionsOffset;
+    unsigned int texCoordsOffset;
+    unsigned int normalsOffset;
+};
+
+struct ObjChunk
+{
+    const char *begin = nullptr;
+    const char *end = nullptr;
+
+    // Parsing output, face corners hold zero based indices which do not
+    // account for skipped submeshes yet and are triangulated as fans
     QList<QVector3D> positions;
-    QList<QVector3D> normals;
     QList<QVector2D> texCoords;
-    QHash<FaceIndices, unsigned int> faceIndexMap;
-    QList<FaceIndices> faceIndexVector;
+    QList<QVector3D> normals;
+    QList<FaceIndices> corners;
+    QList<ObjSection> sections;
 
-    bool skipping = false;
-    int positionsOffset = 0;
-    int normalsOffset = 0;
-    int texCoordsOffset = 0;
+    QList<KeptRange> keptRanges;
 
-    QRegularExpression subMeshMatch(subMesh);
-    if (!subMeshMatch.isValid())
-        subMeshMatch.setPattern(QLatin1String("^(") + subMesh + QLatin1String(")$"));
-    Q_ASSERT(subMeshMatch.isValid());
+    // Local deduplication output, merged into the global vertex list
+    QList<FaceIndices> uniqueCorners;
+    QList<unsigned int> localIndices;
+    QList<unsigned int> localToGlobal;
+    int indexOffset = 0;
+};
 
-    char lineBuffer[1024];
-    const char *line;
-    QByteArray longLine;
-    while (!ioDev->atEnd()) {
-        // try to read into lineBuffer first, if the line fits (common case) we can do this without expensive allocations
-        // if not, fall back to dynamically allocated QByteArrays
-        auto lineSize = ioDev->readLine(lineBuffer, sizeof(lineBuffer));
-        if (lineSize == sizeof(lineBuffer) - 1 && lineBuffer[lineSize - 1] != '\n') {
-            longLine = QByteArray(lineBuffer, lineSize);
-            longLine += ioDev->readLine();
-            line = longLine.constData();
-            lineSize = longLine.size();
-        } else {
-            line = lineBuffer;
-        }
+class ObjChunkParser
+{
+public:
+    explicit ObjChunkParser(bool loadTextureCoords)
+        : m_loadTextureCoords(loadTextureCoords)
+    {}
+
+    void operator()(ObjChunk &chunk) const
+    {
+        LineTokens tokens;
+        QVarLengthArray<FaceIndices, 4> face; // try to avoid allocations in the common case of triangulated data
 
-        if (lineSize > 0 && line[0] != '#') {
-            if (line[lineSize - 1] == '\n')
-                --lineSize; // chop newline
-            if (line[lineSize - 1] == '\r')
-                --lineSize; // chop newline also for CRLF format
-            while (line[lineSize - 1] == ' ' || line[lineSize - 1] == '\t')
-                --lineSize; // chop trailing spaces
+        const char *line = chunk.begin;
+        while (line < chunk.end) {
+            const char *lineEnd = static_cast<const char *>(memchr(line, '\n', chunk.end - line));
+            if (!lineEnd)
+                lineEnd = chunk.end;
+            const char *next = lineEnd + 1;
 
-            const ByteArraySplitter tokens(line, line + lineSize, ' ', Qt::SkipEmptyParts);
+            tokenize(line, lineEnd, tokens);
+            line = next;
+            if (tokens.isEmpty() || *tokens[0].begin == '#')
+                continue;
 
-            if (qstrncmp(tokens.charPtrAt(0), "v ", 2) == 0) {
+            const Token &keyword = tokens[0];
+            if (keyword == "v") {
                 if (tokens.size() < 4) {
                     qCWarning(ObjGeometryLoaderLog) << "Unsupported number of components in vertex";
                 } else {
-                    if (!skipping) {
-                        const float x = tokens.floatAt(1);
-                        const float y = tokens.floatAt(2);
-                        const float z = tokens.floatAt(3);
-                        positions.append(QVector3D(x, y, z));
-                    } else {
-                        positionsOffset++;
-                    }
+                    chunk.positions.append(QVector3D(parseFloat(tokens[1]),
+                                                     parseFloat(tokens[2]),
+                                                     parseFloat(tokens[3])));
                 }
-            } else if (m_loadTextureCoords && qstrncmp(tokens.charPtrAt(0), "vt ", 3) == 0) {
+            } else if (m_loadTextureCoords && keyword == "vt") {
                 if (tokens.size() < 3) {
                     qCWarning(ObjGeometryLoaderLog) << "Unsupported number of components in texture coordinate";
                 } else {
-                    if (!skipping) {
-                        // Process texture coordinate
-                        const float s = tokens.floatAt(1);
-                        const float t = tokens.floatAt(2);
-                        texCoords.append(QVector2D(s, t));
-                    } else {
-                        ++texCoordsOffset;
-                    }
+                    chunk.texCoords.append(QVector2D(parseFloat(tokens[1]),
+                                                     parseFloat(tokens[2])));
                 }
-            } else if (qstrncmp(tokens.charPtrAt(0), "vn ", 3) == 0) {
+            } else if (keyword == "vn") {
                 if (tokens.size() < 4) {
                     qCWarning(ObjGeometryLoaderLog) << "Unsupported number of components in vertex normal";
                 } else {
-                    if (!skipping) {
-                        const float x = tokens.floatAt(1);
-                        const float y = tokens.floatAt(2);
-                        const float z = tokens.floatAt(3);
-                        normals.append(QVector3D(x, y, z));
-                    } else {
-                        ++normalsOffset;
-                    }
-                }
-            } else if (!skipping && tokens.size() >= 4 && qstrncmp(tokens.charPtrAt(0), "f ", 2) == 0) {
-                // Process face
-                int faceVertices = tokens.size() - 1;
-
-                QVarLengthArray<FaceIndices, 4> face; // try to avoid allocations in the common case of triangulated data
-                face.reserve(faceVertices);
-
-                for (int i = 0; i < faceVertices; i++) {
-                    FaceIndices faceIndices;
-                    const ByteArraySplitter indices = tokens.splitterAt(i + 1, '/', Qt::KeepEmptyParts);
-                    switch (indices.size()) {
-                    case 3:
-                        faceIndices.normalIndex = indices.intAt(2) - 1 - normalsOffset;  // fall through
-                        Q_FALLTHROUGH();
-                    case 2:
-                        faceIndices.texCoordIndex = indices.intAt(1) - 1 - texCoordsOffset; // fall through
-                        Q_FALLTHROUGH();
-                    case 1:
-                        faceIndices.positionIndex = indices.intAt(0) - 1 - positionsOffset;
-                        break;
-                    default:
-                        qCWarning(ObjGeometryLoaderLog) << "Unsupported number of indices in face element";
-                    }
-
-                    face.append(faceIndices);
+                    chunk.normals.append(QVector3D(parseFloat(tokens[1]),
+                                                   parseFloat(tokens[2]),
+                                                   parseFloat(tokens[3])));
                 }
+            } else if (keyword == "f" && tokens.size() >= 4) {
+                face.clear();
+                for (int i = 1; i < tokens.size(); ++i)
+                    face.append(parseFaceIndices(tokens[i]));
 
                 // If number of edges in face is greater than 3,
                 // decompose into triangles as a triangle fan.
-                FaceIndices v0 = face[0];
-                FaceIndices v1 = face[1];
-                FaceIndices v2 = face[2];
-
-                // First face
-                addFaceVertex(v0, faceIndexVector, faceIndexMap);
-                addFaceVertex(v1, faceIndexVector, faceIndexMap);
-                addFaceVertex(v2, faceIndexVector, faceIndexMap);
-
-                for (int i = 3; i < face.size(); ++i) {
-                    v1 = v2;
-                    v2 = face[i];
-                    addFaceVertex(v0, faceIndexVector, faceIndexMap);
-                    addFaceVertex(v1, faceIndexVector, faceIndexMap);
-                    addFaceVertex(v2, faceIndexVector, faceIndexMap);
+                for (int i = 2; i < face.size(); ++i) {
+                    chunk.corners.append(face[0]);
+                    chunk.corners.append(face[i - 1]);
+                    chunk.corners.append(face[i]);
                 }
-
-                // end of face
-            } else if (qstrncmp(tokens.charPtrAt(0), "o ", 2) == 0) {
+            } else if (keyword == "o") {
                 if (tokens.size() < 2) {
                     qCWarning(ObjGeometryLoaderLog) << "Missing submesh name";
                 } else {
-                    if (!subMesh.isEmpty() ) {
-                        const QString objName = tokens.stringAt(1);
-                        QRegularExpressionMatch match = subMeshMatch.match(objName);
-                        skipping = !match.hasMatch();
-                    }
+                    chunk.sections.append({ QString::fromLatin1(tokens[1].begin, tokens[1].size()),
+                                            int(chunk.positions.size()),
+                                            int(chunk.texCoords.size()),
+                                            int(chunk.normals.size()),
+                                            int(chunk.corners.size()) });
                 }
             }
-        } // empty input line
-    } // while (!ioDev->atEnd())
+        }
+    }
+
+private:
+    static FaceIndices parseFaceIndices(const Token &token)
+    {
+        FaceIndices faceIndices;
+        unsigned int *indices[] = { &faceIndices.positionIndex,
+                                    &faceIndices.texCoordIndex,
+                                    &faceIndices.normalIndex };
+        unsigned int values[3];
+        int count = 0;
+        const char *begin = token.begin;
+        while (true) {
+            const char *end = static_cast<const char *>(memchr(begin, '/', token.end - begin));
+            if (!end)
+                end = token.end;
+            if (count == 3) {
+                qCWarning(ObjGeometryLoaderLog) << "Unsupported number of indices in face element";
+                return FaceIndices();
+            }
+            values[count++] = unsigned(parseInt(begin, end) - 1);
+            if (end == token.end)
+                break;
+            begin = end + 1;
+        }
+        for (int i = 0; i < count; ++i)
+            *indices[i] = values[i];
+        return faceIndices;
+    }
+
+    const bool m_loadTextureCoords;
+};
+
+QList<ObjChunk> splitIntoChunks(const char *data, qint64 size)
+{
+    const int threadCount = qMax(1, QThread::idealThreadCount());
+    const qint64 chunkCount = qBound(qint64(1), size / MinimumChunkSize, qint64(threadCount) * 4);
+    const qint64 chunkSize = size / chunkCount;
 
-    // Iterate over the faceIndexMap and pull out pos, texCoord and normal data
-    // thereby generating unique vertices of data (by OpenGL definition)
-    const int vertexCount = faceIndexMap.size();
+    QList<ObjChunk> chunks;
+    chunks.reserve(chunkCount);
+    const char *end = data + size;
+    const char *begin = data;
+    while (begin < end) {
+        const char *chunkEnd = end;
+        if (end - begin > chunkSize + chunkSize / 2) {
+            chunkEnd = static_cast<const char *>(memchr(begin + chunkSize, '\n', end - begin - chunkSize));
+            chunkEnd = chunkEnd ? chunkEnd + 1 : end;
+        }
+        ObjChunk chunk;
+        chunk.begin = begin;
+        chunk.end = chunkEnd;
+        chunks.append(std::move(chunk));
+        begin = chunkEnd;
+    }
+    return chunks;
+}
+
+template<typename T>
+void copyRange(const QList<T> &source, int begin, int end, T *target)
+{
+    std::copy(source.cbegin() + begin, source.cbegin() + end, target);
+}
+
+} // anonymous
+
+bool ObjGeometryLoader::doLoad(QIODevice *ioDev, const QString &subMesh)
+{
+    // Parse faces taking into account each vertex in a face can index different indices
+    // for the positions, normals and texture coords;
+    // Generate unique vertices (in OpenGL parlance) and output to points, texCoords,
+    // normals and calculate mapping from faces to unique indices
+    //
+    // The content is split into line aligned chunks which are parsed concurrently,
+    // submesh selection is then resolved in file order and the face corners of each
+    // chunk are deduplicated concurrently before being merged in file order
+    const DeviceContent content(ioDev);
+    QList<ObjChunk> chunks = splitIntoChunks(content.data(), content.size());
+
+    QtConcurrent::blockingMap(chunks, ObjChunkParser(m_loadTextureCoords));
+
+    QRegularExpression subMeshMatch(subMesh);
+    if (!subMeshMatch.isValid())
+        subMeshMatch.setPattern(QLatin1String("^(") + subMesh + QLatin1String(")$"));
+    Q_ASSERT(subMeshMatch.isValid());
+
+    // Indices in faces are relative to the whole file, offsets account for
+    // the positions, texture coordinates and normals of skipped submeshes
+    bool skipping = false;
+    unsigned int positionsOffset = 0;
+    unsigned int normalsOffset = 0;
+    unsigned int texCoordsOffset = 0;
+    int positionCount = 0;
+    int texCoordCount = 0;
+    int normalCount = 0;
+
+    for (ObjChunk &chunk : chunks) {
+        ObjSection sectionStart = { QString(), 0, 0, 0, 0 };
+        const auto closeSection = [&] (const ObjSection &sectionEnd) {
+            if (skipping) {
+                positionsOffset += sectionEnd.positionBegin - sectionStart.positionBegin;
+                texCoordsOffset += sectionEnd.texCoordBegin - sectionStart.texCoordBegin;
+                normalsOffset += sectionEnd.normalBegin - sectionStart.normalBegin;
+                return;
+            }
+            chunk.keptRanges.append({ sectionStart.positionBegin, sectionEnd.positionBegin, positionCount,
+                                      sectionStart.texCoordBegin, sectionEnd.texCoordBegin, texCoordCount,
+                                      sectionStart.normalBegin, sectionEnd.normalBegin, normalCount,
+                                      sectionStart.cornerBegin, sectionEnd.cornerBegin,
+                                      positionsOffset, texCoordsOffset, normalsOffset });
+            positionCount += sectionEnd.positionBegin - sectionStart.positionBegin;
+            texCoordCount += sectionEnd.texCoordBegin - sectionStart.texCoordBegin;
+            normalCount += sectionEnd.normalBegin - sectionStart.normalBegin;
+        };
+
+        for (const ObjSection &section : qAsConst(chunk.sections)) {
+            closeSection(section);
+            if (!subMesh.isEmpty()) {
+                QRegularExpressionMatch match = subMeshMatch.match(section.name);
+                skipping = !match.hasMatch();
+            }
+            sectionStart = section;
+        }
+        closeSection({ QString(), int(chunk.positions.size()), int(chunk.texCoords.size()),
+                       int(chunk.normals.size()), int(chunk.corners.size()) });
+    }
+
+    QList<QVector3D> positions(positionCount);
+    QList<QVector2D> texCoords(texCoordCount);
+    QList<QVector3D> normals(normalCount);
+    QVector3D *positionData = positions.data();
+    QVector2D *texCoordData = texCoords.data();
+    QVector3D *normalData = normals.data();
+
+    QtConcurrent::blockingMap(chunks, [&] (ObjChunk &chunk) {
+        QHash<FaceIndices, unsigned int> faceIndexMap;
+        for (const KeptRange &range : qAsConst(chunk.keptRanges)) {
+            copyRange(chunk.positions, range.positionBegin, range.positionEnd, positionData + range.positionTarget);
+            copyRange(chunk.texCoords, range.texCoordBegin, range.texCoordEnd, texCoordData + range.texCoordTarget);
+            copyRange(chunk.normals, range.normalBegin, range.normalEnd, normalData + range.normalTarget);
+
+            for (int i = range.cornerBegin; i < range.cornerEnd; ++i) {
+                FaceIndices faceIndices = chunk.corners.at(i);
+                faceIndices.positionIndex -= range.positionsOffset;
+                if (faceIndices.texCoordIndex != std::numeric_limits<unsigned int>::max())
+                    faceIndices.texCoordIndex -= range.texCoordsOffset;
+                if (faceIndices.normalIndex != std::numeric_limits<unsigned int>::max())
+                    faceIndices.normalIndex -= range.normalsOffset;
+
+                if (faceIndices.positionIndex == std::numeric_limits<unsigned int>::max()) {
+                    qCWarning(ObjGeometryLoaderLog) << "Missing position index";
+                    continue;
+                }
+
+                auto it = faceIndexMap.find(faceIndices);
+                if (it == faceIndexMap.end()) {
+                    it = faceIndexMap.insert(faceIndices, unsigned(chunk.uniqueCorners.size()));
+                    chunk.uniqueCorners.append(faceIndices);
+                }
+                chunk.localIndices.append(it.value());
+            }
+        }
+
+        // Release parsing output early, only the deduplicated corners are needed from now on
+        chunk.positions = QList<QVector3D>();
+        chunk.texCoords = QList<QVector2D>();
+        chunk.normals = QList<QVector3D>();
+        chunk.corners = QList<FaceIndices>();
+    });
+
+    // Merge in file order so vertices keep the order of their first use
+    QHash<FaceIndices, unsigned int> faceIndexMap;
+    QList<FaceIndices> uniqueCorners;
+    int indexCount = 0;
+    for (ObjChunk &chunk : chunks) {
+        chunk.localToGlobal.reserve(chunk.uniqueCorners.size());
+        for (const FaceIndices &faceIndices : qAsConst(chunk.uniqueCorners)) {
+            auto it = faceIndexMap.find(faceIndices);
+            if (it == faceIndexMap.end()) {
+                it = faceIndexMap.insert(faceIndices, unsigned(uniqueCorners.size()));
+                uniqueCorners.append(faceIndices);
+            }
+            chunk.localToGlobal.append(it.value());
+        }
+        chunk.indexOffset = indexCount;
+        indexCount += chunk.localIndices.size();
+    }
+
+    m_indices.resize(indexCount);
+    unsigned int *indexData = m_indices.data();
+    QtConcurrent::blockingMap(chunks, [indexData] (const ObjChunk &chunk) {
+        unsigned int *indices = indexData + chunk.indexOffset;
+        for (const unsigned int localIndex : chunk.localIndices)
+            *indices++ = chunk.localToGlobal.at(localIndex);
+    });
+    chunks.clear();
+
+    // Pull out pos, texCoord and normal data for each unique vertex (by OpenGL definition)
+    const int vertexCount = int(uniqueCorners.size());
     const bool hasTexCoords = !texCoords.isEmpty();
     const bool hasNormals = !normals.isEmpty();
 
+    QList<int> vertexBlocks((vertexCount + 0xffff) >> 16);
+    std::iota(vertexBlocks.begin(), vertexBlocks.end(), 0);
+    const auto forEachVertex = [&] (const auto &function) {
+        QtConcurrent::blockingMap(vertexBlocks, [&] (int block) {
+            const int end = qMin(vertexCount, (block + 1) << 16);
+            for (int i = block << 16; i < end; ++i)
+                function(i);
+        });
+    };
+    const auto position = [&] (int i) {
+        const uint positionIndex = uniqueCorners.at(i).positionIndex;
+        return (positionIndex < uint(positions.size())) ? positions.at(positionIndex) : QVector3D();
+    };
+    const auto texCoord = [&] (int i) {
+        const uint texCoordIndex = uniqueCorners.at(i).texCoordIndex;
+        return (texCoordIndex < uint(texCoords.size())) ? texCoords.at(texCoordIndex) : QVector2D();
+    };
+    const auto normal = [&] (int i) {
+        const uint normalIndex = uniqueCorners.at(i).normalIndex;
+        return (normalIndex < uint(normals.size())) ? normals.at(normalIndex) : QVector3D();
+    };
+
+    // Without any post processing to run, write the interleaved vertex buffer directly
+    if (!needsPostProcessing(hasNormals, hasTexCoords)) {
+        const int elementSize = 3 + (hasTexCoords ? 2 : 0) + 3;
+        QByteArray bufferBytes;
+        bufferBytes.resize(elementSize * sizeof(float) * vertexCount);
+        float *vertices = reinterpret_cast<float *>(bufferBytes.data());
+
+        forEachVertex([&] (int i) {
+            float *fptr = vertices + i * elementSize;
+            const QVector3D p = position(i);
+            *fptr++ = p.x();
+            *fptr++ = p.y();
+            *fptr++ = p.z();
+            if (hasTexCoords) {
+                const QVector2D t = texCoord(i);
+                *fptr++ = t.x();
+                *fptr++ = t.y();
+            }
+            const QVector3D n = normal(i);
+            *fptr++ = n.x();
+            *fptr++ = n.y();
+            *fptr++ = n.z();
+        });
+
+        createGeometry(bufferBytes, vertexCount, hasTexCoords, true, false);
+        m_hasGeneratedGeometry = true;
+        return true;
+    }
+
     m_points.resize(vertexCount);
     m_texCoords.clear();
     if (hasTexCoords)
@@ -221,43 +555,20 @@ bool ObjGeometryLoader::doLoad(QIODevice *ioDev, const QString &subMesh)
     if (hasNormals)
         m_normals.resize(vertexCount);
 
-    for (auto it = faceIndexMap.cbegin(), endIt = faceIndexMap.cend(); it != endIt; ++it) {
-        const uint positionIndex = it.key().positionIndex;
-        const uint texCoordIndex = it.key().texCoordIndex;
-        const uint normalIndex = it.key().normalIndex;
-
-        m_points[it.value()] = (positionIndex < uint(positions.size())) ? positions[positionIndex] : QVector3D();
+    QVector3D *points = m_points.data();
+    QVector2D *vertexTexCoords = m_texCoords.data();
+    QVector3D *vertexNormals = m_normals.data();
+    forEachVertex([&] (int i) {
+        points[i] = position(i);
         if (hasTexCoords)
-            m_texCoords[it.value()] = (texCoordIndex < uint(texCoords.size())) ? texCoords[texCoordIndex] : QVector2D();
+            vertexTexCoords[i] = texCoord(i);
         if (hasNormals)
-            m_normals[it.value()] = (normalIndex < uint(normals.size())) ? normals[normalIndex] : QVector3D();
-    }
-
-    // Now iterate over the face indices and lookup the unique vertex index
-    const int indexCount = faceIndexVector.size();
-    m_indices.clear();
-    m_indices.reserve(indexCount);
-    for (const FaceIndices faceIndices : qAsConst(faceIndexVector)) {
-        const unsigned int i = faceIndexMap.value(faceIndices);
-        m_indices.append(i);
-    }
+            vertexNormals[i] = normal(i);
+    });
 
     return true;
 }
 
-static void addFaceVertex(const FaceIndices &faceIndices,
-                          QList<FaceIndices> &faceIndexVector,
-                          QHash<FaceIndices, unsigned int> &faceIndexMap)
-{
-    if (faceIndices.positionIndex != std::numeric_limits<unsigned int>::max()) {
-        faceIndexVector.append(faceIndices);
-        if (!faceIndexMap.contains(faceIndices))
-            faceIndexMap.insert(faceIndices, faceIndexMap.size());
-    } else {
-        qCWarning(ObjGeometryLoaderLog) << "Missing position index";
-    }
-}
-
 } // namespace Qt3DRender
 
 QT_END_NAMESPACE
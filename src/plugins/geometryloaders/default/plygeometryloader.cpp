@@ -39,8 +39,14 @@
 
 #include "plygeometryloader.h"
 
-#include <QtCore/QDataStream>
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QSysInfo>
+#include <QtCore/QTextStream>
+#include <QtCore/QtEndian>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
 
 QT_BEGIN_NAMESPACE
 
@@ -48,8 +54,6 @@ namespace Qt3DRender {
 
 Q_LOGGING_CATEGORY(PlyGeometryLoaderLog, "Qt3D.PlyGeometryLoader", QtWarningMsg)
 
-namespace {
-
 class PlyDataReader
 {
 public:
@@ -59,6 +63,8 @@ public:
     virtual float readFloatValue(PlyGeometryLoader::DataType type) = 0;
 };
 
+namespace {
+
 class AsciiPlyDataReader : public PlyDataReader
 {
 public:
@@ -87,11 +93,12 @@ private:
 class BinaryPlyDataReader : public PlyDataReader
 {
 public:
-    BinaryPlyDataReader(QIODevice *ioDev, QDataStream::ByteOrder byteOrder)
-        : m_stream(ioDev)
+    BinaryPlyDataReader(const char *data, qint64 size, PlyGeometryLoader::Format format)
+        : m_data(data)
+        , m_end(data + size)
+        , m_bigEndian(format == PlyGeometryLoader::FormatBinaryBigEndian)
+        , m_truncated(false)
     {
-        ioDev->setTextModeEnabled(false);
-        m_stream.setByteOrder(byteOrder);
     }
 
     int readIntValue(PlyGeometryLoader::DataType type) override
@@ -104,69 +111,32 @@ public:
         return readValue<float>(type);
     }
 
+    const char *position() const { return m_data; }
+    qint64 bytesAvailable() const { return m_end - m_data; }
+    void skip(qint64 bytes) { m_data += qMin(bytes, bytesAvailable()); }
+    bool isTruncated() const { return m_truncated; }
+
 private:
     template <typename T>
     T readValue(PlyGeometryLoader::DataType type)
     {
         switch (type) {
         case PlyGeometryLoader::Int8:
-        {
-            qint8 value;
-            m_stream >> value;
-            return value;
-        }
-
+            return read<qint8>();
         case PlyGeometryLoader::Uint8:
-        {
-            quint8 value;
-            m_stream >> value;
-            return value;
-        }
-
+            return read<quint8>();
         case PlyGeometryLoader::Int16:
-        {
-            qint16 value;
-            m_stream >> value;
-            return value;
-        }
-
+            return read<qint16>();
         case PlyGeometryLoader::Uint16:
-        {
-            quint16 value;
-            m_stream >> value;
-            return value;
-        }
-
+            return read<quint16>();
         case PlyGeometryLoader::Int32:
-        {
-            qint32 value;
-            m_stream >> value;
-            return value;
-        }
-
+            return read<qint32>();
         case PlyGeometryLoader::Uint32:
-        {
-            quint32 value;
-            m_stream >> value;
-            return value;
-        }
-
+            return read<quint32>();
         case PlyGeometryLoader::Float32:
-        {
-            m_stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
-            float value;
-            m_stream >> value;
-            return value;
-        }
-
+            return read<float>();
         case PlyGeometryLoader::Float64:
-        {
-            m_stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
-            double value;
-            m_stream >> value;
-            return value;
-        }
-
+            return read<double>();
         default:
             break;
         }
@@ -174,9 +144,109 @@ private:
         return 0;
     }
 
-    QDataStream m_stream;
+    template <typename V>
+    V read()
+    {
+        if (bytesAvailable() < qint64(sizeof(V))) {
+            m_truncated = true;
+            m_data = m_end;
+            return V(0);
+        }
+        V value;
+        if constexpr (sizeof(V) == 1)
+            memcpy(&value, m_data, 1);
+        else if (m_bigEndian)
+            value = qFromBigEndian<V>(m_data);
+        else
+            value = qFromLittleEndian<V>(m_data);
+        m_data += sizeof(V);
+        return value;
+    }
+
+    const char *m_data;
+    const char *m_end;
+    const bool m_bigEndian;
+    bool m_truncated;
 };
 
+// Byte layout of a vertex element whose properties all have a fixed size
+struct PlyVertexLayout
+{
+    int stride = 0;
+    int positionOffset = -1;
+    int texCoordOffset = -1;
+    int normalOffset = -1;
+    // All properties are 32 bit wide, so the whole block can be byte swapped at once
+    bool wordsOnly = true;
+    bool isValid = false;
+};
+
+int dataTypeSize(PlyGeometryLoader::DataType type)
+{
+    switch (type) {
+    case PlyGeometryLoader::Int8:
+    case PlyGeometryLoader::Uint8:
+        return 1;
+    case PlyGeometryLoader::Int16:
+    case PlyGeometryLoader::Uint16:
+        return 2;
+    case PlyGeometryLoader::Int32:
+    case PlyGeometryLoader::Uint32:
+    case PlyGeometryLoader::Float32:
+        return 4;
+    case PlyGeometryLoader::Float64:
+        return 8;
+    default:
+        break;
+    }
+    return 0;
+}
+
+// Returns the layout of the vertex element if its positions, normals and
+// texture coordinates are float32 components stored next to each other
+PlyVertexLayout vertexLayout(const PlyGeometryLoader::Element &element)
+{
+    PlyVertexLayout layout;
+    int componentOffsets[PlyGeometryLoader::PropertyUnknown];
+    std::fill(std::begin(componentOffsets), std::end(componentOffsets), -1);
+
+    for (const PlyGeometryLoader::Property &property : element.properties) {
+        const int size = dataTypeSize(property.dataType);
+        if (size == 0)
+            return layout;
+        if (property.type != PlyGeometryLoader::PropertyUnknown) {
+            if (property.dataType != PlyGeometryLoader::Float32)
+                return layout;
+            componentOffsets[property.type] = layout.stride;
+        }
+        layout.wordsOnly &= (size == 4);
+        layout.stride += size;
+    }
+
+    const auto vectorOffset = [&componentOffsets] (PlyGeometryLoader::PropertyType first, int componentCount, bool *ok) {
+        const int offset = componentOffsets[first];
+        for (int i = 0; i < componentCount; ++i) {
+            const int componentOffset = componentOffsets[first + i];
+            if ((offset < 0) != (componentOffset < 0)
+                    || (offset >= 0 && componentOffset != offset + i * int(sizeof(float))))
+                *ok = false;
+        }
+        return offset;
+    };
+
+    bool ok = true;
+    layout.positionOffset = vectorOffset(PlyGeometryLoader::PropertyX, 3, &ok);
+    layout.normalOffset = vectorOffset(PlyGeometryLoader::PropertyNormalX, 3, &ok);
+    layout.texCoordOffset = vectorOffset(PlyGeometryLoader::PropertyTextureU, 2, &ok);
+
+    // Attributes need 4 bytes aligned offsets when the block is used as is
+    const auto isAligned = [] (int offset) { return offset < 0 || offset % 4 == 0; };
+    layout.isValid = ok && layout.positionOffset >= 0
+            && isAligned(layout.stride) && isAligned(layout.positionOffset)
+            && isAligned(layout.normalOffset) && isAligned(layout.texCoordOffset);
+    return layout;
+}
+
 }
 
 static PlyGeometryLoader::DataType toPlyDataType(const QString &typeName)
@@ -338,95 +408,167 @@ bool PlyGeometryLoader::parseHeader(QIODevice *ioDev)
 
 bool PlyGeometryLoader::parseMesh(QIODevice *ioDev)
 {
-    QScopedPointer<PlyDataReader> dataReader;
+    if (m_format == FormatAscii) {
+        AsciiPlyDataReader dataReader(ioDev);
+        for (const auto &element : qAsConst(m_elements))
+            parseElement(element, &dataReader);
+        return true;
+    }
 
-    switch (m_format) {
-    case FormatAscii:
-        dataReader.reset(new AsciiPlyDataReader(ioDev));
-        break;
+    // Binary content is read in place from memory, vertex blocks
+    // are then either used as is or converted in bulk
+    ioDev->setTextModeEnabled(false);
+    const DeviceContent content(ioDev);
+    BinaryPlyDataReader dataReader(content.data(), content.size(), m_format);
+
+    QByteArray vertexBytes;
+    PlyVertexLayout layout;
+    int vertexCount = 0;
+    const bool hasSingleVertexElement = std::count_if(m_elements.cbegin(), m_elements.cend(),
+                                                      [] (const Element &element) {
+                                                          return element.type == ElementVertex;
+                                                      }) == 1;
+
+    for (const auto &element : qAsConst(m_elements)) {
+        if (element.type == ElementVertex && hasSingleVertexElement) {
+            layout = vertexLayout(element);
+            const qint64 blockSize = qint64(layout.stride) * element.count;
+            if (layout.isValid && (layout.wordsOnly || m_format == nativeFormat())
+                    && blockSize <= dataReader.bytesAvailable()) {
+                vertexBytes.resize(blockSize);
+                if (!layout.wordsOnly)
+                    memcpy(vertexBytes.data(), dataReader.position(), blockSize);
+                else if (m_format == FormatBinaryBigEndian)
+                    qFromBigEndian<quint32>(dataReader.position(), blockSize / 4, vertexBytes.data());
+                else
+                    qFromLittleEndian<quint32>(dataReader.position(), blockSize / 4, vertexBytes.data());
+                dataReader.skip(blockSize);
+                vertexCount = element.count;
+                continue;
+            }
+        }
 
-    case FormatBinaryLittleEndian:
-        dataReader.reset(new BinaryPlyDataReader(ioDev, QDataStream::LittleEndian));
-        break;
+        parseElement(element, &dataReader);
+    }
 
-    default:
-        dataReader.reset(new BinaryPlyDataReader(ioDev, QDataStream::BigEndian));
-        break;
+    if (dataReader.isTruncated()) {
+        qCDebug(PlyGeometryLoaderLog) << "Unexpected end of PLY file";
+        return false;
     }
 
-    for (auto &element : qAsConst(m_elements)) {
-        if (element.type == ElementVertex) {
-            m_points.reserve(element.count);
+    if (vertexBytes.isEmpty())
+        return true;
 
-            if (m_hasNormals)
-                m_normals.reserve(element.count);
+    const bool hasNormals = layout.normalOffset >= 0;
+    const bool hasTexCoords = layout.texCoordOffset >= 0;
 
-            if (m_hasTexCoords)
-                m_texCoords.reserve(element.count);
+    // Expose the vertex block with the file layout when nothing has to be generated
+    if (!needsPostProcessing(hasNormals, hasTexCoords)) {
+        createGeometry(vertexBytes, vertexCount, layout.stride, layout.positionOffset,
+                       layout.texCoordOffset, layout.normalOffset, -1);
+        m_hasGeneratedGeometry = true;
+        return true;
+    }
+
+    m_points.resize(vertexCount);
+    if (hasNormals)
+        m_normals.resize(vertexCount);
+    if (hasTexCoords)
+        m_texCoords.resize(vertexCount);
+
+    const char *vertex = vertexBytes.constData();
+    for (int i = 0; i < vertexCount; ++i, vertex += layout.stride) {
+        const float *position = reinterpret_cast<const float *>(vertex + layout.positionOffset);
+        m_points[i] = QVector3D(position[0], position[1], position[2]);
+        if (hasNormals) {
+            const float *normal = reinterpret_cast<const float *>(vertex + layout.normalOffset);
+            m_normals[i] = QVector3D(normal[0], normal[1], normal[2]);
+        }
+        if (hasTexCoords) {
+            const float *texCoord = reinterpret_cast<const float *>(vertex + layout.texCoordOffset);
+            m_texCoords[i] = QVector2D(texCoord[0], texCoord[1]);
         }
+    }
+
+    return true;
+}
+
+PlyGeometryLoader::Format PlyGeometryLoader::nativeFormat()
+{
+    return QSysInfo::ByteOrder == QSysInfo::BigEndian ? FormatBinaryBigEndian
+                                                      : FormatBinaryLittleEndian;
+}
 
-        for (int i = 0; i < element.count; ++i) {
-            QVector3D point;
-            QVector3D normal;
-            QVector2D texCoord;
+void PlyGeometryLoader::parseElement(const Element &element, PlyDataReader *dataReader)
+{
+    if (element.type == ElementVertex) {
+        m_points.reserve(m_points.size() + element.count);
 
-            QList<unsigned int> faceIndices;
+        if (m_hasNormals)
+            m_normals.reserve(m_normals.size() + element.count);
 
-            for (auto &property : element.properties) {
-                if (property.dataType == TypeList) {
-                    const int listSize = dataReader->readIntValue(property.listSizeType);
+        if (m_hasTexCoords)
+            m_texCoords.reserve(m_texCoords.size() + element.count);
+    }
 
-                    if (element.type == ElementFace)
-                        faceIndices.reserve(listSize);
+    QVarLengthArray<unsigned int, 8> faceIndices;
 
-                    for (int j = 0; j < listSize; ++j) {
-                        const unsigned int value = dataReader->readIntValue(property.listElementType);
+    for (int i = 0; i < element.count; ++i) {
+        QVector3D point;
+        QVector3D normal;
+        QVector2D texCoord;
 
-                        if (element.type == ElementFace)
-                            faceIndices.append(value);
-                    }
-                } else {
-                    float value = dataReader->readFloatValue(property.dataType);
-
-                    if (element.type == ElementVertex) {
-                        switch (property.type) {
-                        case PropertyX: point.setX(value); break;
-                        case PropertyY: point.setY(value); break;
-                        case PropertyZ: point.setZ(value); break;
-                        case PropertyNormalX: normal.setX(value); break;
-                        case PropertyNormalY: normal.setY(value); break;
-                        case PropertyNormalZ: normal.setZ(value); break;
-                        case PropertyTextureU: texCoord.setX(value); break;
-                        case PropertyTextureV: texCoord.setY(value); break;
-                        default: break;
-                        }
+        faceIndices.clear();
+
+        for (auto &property : element.properties) {
+            if (property.dataType == TypeList) {
+                const int listSize = dataReader->readIntValue(property.listSizeType);
+
+                for (int j = 0; j < listSize; ++j) {
+                    const unsigned int value = dataReader->readIntValue(property.listElementType);
+
+                    if (element.type == ElementFace)
+                        faceIndices.append(value);
+                }
+            } else {
+                float value = dataReader->readFloatValue(property.dataType);
+
+                if (element.type == ElementVertex) {
+                    switch (property.type) {
+                    case PropertyX: point.setX(value); break;
+                    case PropertyY: point.setY(value); break;
+                    case PropertyZ: point.setZ(value); break;
+                    case PropertyNormalX: normal.setX(value); break;
+                    case PropertyNormalY: normal.setY(value); break;
+                    case PropertyNormalZ: normal.setZ(value); break;
+                    case PropertyTextureU: texCoord.setX(value); break;
+                    case PropertyTextureV: texCoord.setY(value); break;
+                    default: break;
                     }
                 }
             }
+        }
 
-            if (element.type == ElementVertex) {
-                m_points.append(point);
-
-                if (m_hasNormals)
-                    m_normals.append(normal);
+        if (element.type == ElementVertex) {
+            m_points.append(point);
 
-                if (m_hasTexCoords)
-                    m_texCoords.append(texCoord);
-            } else if (element.type == ElementFace) {
-                if (faceIndices.size() >= 3) {
-                    // decompose face into triangle fan
+            if (m_hasNormals)
+                m_normals.append(normal);
 
-                    for (int j = 1; j < faceIndices.size() - 1; ++j) {
-                        m_indices.append(faceIndices[0]);
-                        m_indices.append(faceIndices[j]);
-                        m_indices.append(faceIndices[j + 1]);
-                    }
+            if (m_hasTexCoords)
+                m_texCoords.append(texCoord);
+        } else if (element.type == ElementFace) {
+            if (faceIndices.size() >= 3) {
+                // decompose face into triangle fan
+
+                for (int j = 1; j < faceIndices.size() - 1; ++j) {
+                    m_indices.append(faceIndices[0]);
+                    m_indices.append(faceIndices[j]);
+                    m_indices.append(faceIndices[j + 1]);
                 }
             }
         }
     }
-
-    return true;
 }
 
 /*!
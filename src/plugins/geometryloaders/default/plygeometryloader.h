@@ -57,6 +57,8 @@ QT_BEGIN_NAMESPACE
 
 namespace Qt3DRender {
 
+class PlyDataReader;
+
 #define PLYGEOMETRYLOADER_EXT QLatin1String("ply")
 
 class PlyGeometryLoader : public BaseGeometryLoader
@@ -120,6 +122,8 @@ protected:
 private:
     bool parseHeader(QIODevice *ioDev);
     bool parseMesh(QIODevice *ioDev);
+    void parseElement(const Element &element, PlyDataReader *dataReader);
+    static Format nativeFormat();
 
     Format m_format;
     QList<Element> m_elements;
@@ -39,8 +39,10 @@
 
 #include "stlgeometryloader.h"
 
-#include <QtCore/QDataStream>
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QtEndian>
+
+#include <numeric>
 
 QT_BEGIN_NAMESPACE
 
@@ -100,39 +102,64 @@ bool StlGeometryLoader::loadAscii(QIODevice *ioDev)
 bool StlGeometryLoader::loadBinary(QIODevice *ioDev)
 {
     static const int headerSize = 80;
-
-    if (ioDev->read(headerSize).size() != headerSize)
-        return false;
+    static const int triangleSize = 50;
 
     ioDev->setTextModeEnabled(false);
 
-    QDataStream stream(ioDev);
-    stream.setByteOrder(QDataStream::LittleEndian);
-    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
-
-    quint32 triangleCount;
-    stream >> triangleCount;
-
-    if (quint64(ioDev->size()) != headerSize + sizeof(quint32) + (triangleCount * 50))
+    const DeviceContent content(ioDev);
+    if (content.size() < headerSize + qint64(sizeof(quint32)))
         return false;
 
-    m_points.reserve(triangleCount * 3);
-    m_indices.reserve(triangleCount * 3);
-
-    for (unsigned i = 0; i < triangleCount; ++i) {
-        QVector3D normal;
-        stream >> normal;
+    const quint32 triangleCount = qFromLittleEndian<quint32>(content.data() + headerSize);
 
-        for (int j = 0; j < 3; ++j) {
-            QVector3D point;
-            stream >> point;
-            m_points.append(point);
+    if (quint64(content.size()) != headerSize + sizeof(quint32) + (quint64(triangleCount) * triangleSize))
+        return false;
 
-            m_indices.append((i * 3) + j);
+    const int vertexCount = triangleCount * 3;
+    const char *triangle = content.data() + headerSize + sizeof(quint32);
+
+    m_indices.resize(vertexCount);
+    std::iota(m_indices.begin(), m_indices.end(), 0u);
+
+    // Each triangle holds a normal, three positions and an attribute count. The
+    // stored normal is ignored and normals are generated from the positions. As
+    // no vertex is shared, they are the face normals and can be computed while
+    // writing the interleaved vertex buffer directly
+    if (!needsPostProcessing(true, false)) {
+        QByteArray bufferBytes;
+        bufferBytes.resize(vertexCount * 6 * sizeof(float));
+        float *fptr = reinterpret_cast<float *>(bufferBytes.data());
+
+        for (quint32 i = 0; i < triangleCount; ++i, triangle += triangleSize) {
+            float positions[9];
+            qFromLittleEndian<float>(triangle + 3 * sizeof(float), 9, positions);
+
+            const QVector3D p1(positions[0], positions[1], positions[2]);
+            const QVector3D p2(positions[3], positions[4], positions[5]);
+            const QVector3D p3(positions[6], positions[7], positions[8]);
+            const QVector3D n = QVector3D::crossProduct(p2 - p1, p3 - p1).normalized();
+
+            for (int j = 0; j < 3; ++j) {
+                *fptr++ = positions[j * 3];
+                *fptr++ = positions[j * 3 + 1];
+                *fptr++ = positions[j * 3 + 2];
+                *fptr++ = n.x();
+                *fptr++ = n.y();
+                *fptr++ = n.z();
+            }
         }
 
-        quint16 attributeCount;
-        stream >> attributeCount;
+        createGeometry(bufferBytes, vertexCount, false, true, false);
+        m_hasGeneratedGeometry = true;
+        return true;
+    }
+
+    m_points.resize(vertexCount);
+    for (quint32 i = 0; i < triangleCount; ++i, triangle += triangleSize) {
+        float positions[9];
+        qFromLittleEndian<float>(triangle + 3 * sizeof(float), 9, positions);
+        for (int j = 0; j < 3; ++j)
+            m_points[i * 3 + j] = QVector3D(positions[j * 3], positions[j * 3 + 1], positions[j * 3 + 2]);
     }
 
     return true;
@@ -673,7 +673,7 @@ void Renderer::setSceneRoot(Entity *sgRoot)
     m_cleanupJob->setRoot(m_renderSceneRoot);
 
     // Set all flags to dirty
-    m_dirtyBits.marked |= AbstractRenderer::AllDirty;
+    m_dirtyBits.marked.fetchAndOrRelaxed(AbstractRenderer::AllDirty);
 }
 
 void Renderer::setSettings(RenderSettings *settings)
@@ -1685,19 +1685,19 @@ Renderer::ViewSubmissionResultData Renderer::submitRenderViews(const std::vector
 void Renderer::markDirty(BackendNodeDirtySet changes, BackendNode *node)
 {
     Q_UNUSED(node);
-    m_dirtyBits.marked |= changes;
+    m_dirtyBits.marked.fetchAndOrRelaxed(int(changes));
 }
 
 Renderer::BackendNodeDirtySet Renderer::dirtyBits()
 {
-    return m_dirtyBits.marked;
+    return BackendNodeDirtySet(QFlag(m_dirtyBits.marked.loadRelaxed()));
 }
 
 #if defined(QT_BUILD_INTERNAL)
 void Renderer::clearDirtyBits(BackendNodeDirtySet changes)
 {
     m_dirtyBits.remaining &= ~changes;
-    m_dirtyBits.marked &= ~changes;
+    m_dirtyBits.marked.fetchAndAndRelaxed(~int(changes));
 }
 #endif
 
@@ -1706,7 +1706,7 @@ bool Renderer::shouldRender() const
     // Only render if something changed during the last frame, or the last frame
     // was not rendered successfully (or render-on-demand is disabled)
     return (m_settings->renderPolicy() == QRenderSettings::Always
-            || m_dirtyBits.marked != 0
+            || m_dirtyBits.marked.loadRelaxed() != 0
             || m_dirtyBits.remaining != 0
             || !m_lastFrameCorrect.loadRelaxed());
 }
@@ -1781,8 +1781,8 @@ std::vector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
     // Remove previous dependencies
     m_cleanupJob->removeDependency(QWeakPointer<QAspectJob>());
 
-    const BackendNodeDirtySet dirtyBitsForFrame = m_dirtyBits.marked | m_dirtyBits.remaining;
-    m_dirtyBits.marked = {};
+    const BackendNodeDirtySet dirtyBitsForFrame = BackendNodeDirtySet(QFlag(m_dirtyBits.marked.fetchAndStoreRelaxed(0)))
+            | m_dirtyBits.remaining;
     m_dirtyBits.remaining = {};
     BackendNodeDirtySet notCleared = {};
 
@@ -1999,7 +1999,7 @@ void Renderer::performCompute(const RenderView *, RenderCommand *command)
                 command->m_workGroups[2]);
     }
     // HACK: Reset the compute flag to dirty
-    m_dirtyBits.marked |= AbstractRenderer::ComputeDirty;
+    m_dirtyBits.marked.fetchAndOrRelaxed(AbstractRenderer::ComputeDirty);
 
 #if defined(QT3D_RENDER_ASPECT_OPENGL_DEBUG)
     int err = m_submissionContext->openGLContext()->functions()->glGetError();
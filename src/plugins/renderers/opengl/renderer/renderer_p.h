@@ -341,7 +341,7 @@ private:
     QAtomicInt m_exposed;
 
     struct DirtyBits {
-        BackendNodeDirtySet marked; // marked dirty since last job build
+        QAtomicInt marked; // marked dirty since last job build, possibly from concurrent syncs
         BackendNodeDirtySet remaining; // remaining dirty after jobs have finished
     };
     DirtyBits m_dirtyBits;
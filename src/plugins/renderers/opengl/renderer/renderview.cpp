@@ -1342,26 +1342,17 @@ void RenderView::updateLightUniforms(RenderCommand *command, const Entity *entit
     const std::vector<int> &lightUniformNamesIds = shader->lightUniformsNamesIds();
     if (!lightUniformNamesIds.empty()) {
         // Pick which lights to take in to account.
-        // For now decide based on the distance by taking the MAX_LIGHTS closest lights.
-        // Replace with more sophisticated mechanisms later.
-        // Copy vector so that we can sort it concurrently and we only want to sort the one for the current command
-        std::vector<LightSource> lightSources = m_lightSources;
-
-        if (lightSources.size() > 1) {
-            const Vector3D entityCenter = entity->worldBoundingVolume()->center();
-            std::sort(lightSources.begin(), lightSources.end(),
-                      [&] (const LightSource &a, const LightSource &b) {
-                const float distA = entityCenter.distanceToPoint(a.entity->worldBoundingVolume()->center());
-                const float distB = entityCenter.distanceToPoint(b.entity->worldBoundingVolume()->center());
-                return distA < distB;
-            });
-            m_lightSources = {lightSources.begin(), lightSources.begin() + std::min(lightSources.size(), size_t(MAX_LIGHTS)) };
-        }
+        // For now decide based on the distance by taking the MAX_LIGHTS closest lights,
+        // looked up in the light grid built once per RenderView.
+        int closestLightIndices[MAX_LIGHTS];
+        const int closestLightCount = m_lightGrid.closestLights(entity->worldBoundingVolume()->center(),
+                                                                MAX_LIGHTS, closestLightIndices);
 
         int lightIdx = 0;
-        for (const LightSource &lightSource : m_lightSources) {
+        for (int i = 0; i < closestLightCount; ++i) {
             if (lightIdx == MAX_LIGHTS)
                 break;
+            const LightSource &lightSource = m_lightSources[closestLightIndices[i]];
             const Entity *lightEntity = lightSource.entity;
             const Matrix4x4 lightWorldTransform = *(lightEntity->worldTransform());
             const Vector3D worldPos = lightWorldTransform * Vector3D(0.0f, 0.0f, 0.0f);
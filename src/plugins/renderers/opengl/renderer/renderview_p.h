@@ -61,6 +61,7 @@
 #include <Qt3DRender/private/handle_types_p.h>
 #include <Qt3DRender/private/qsortpolicy_p.h>
 #include <Qt3DRender/private/lightsource_p.h>
+#include <Qt3DRender/private/lightgrid_p.h>
 #include <Qt3DRender/private/qmemorybarrier_p.h>
 #include <Qt3DRender/private/qrendercapture_p.h>
 #include <Qt3DRender/private/qblitframebuffer_p.h>
@@ -246,7 +247,11 @@ public:
     void setSurface(QSurface *surface) { m_surface = surface; }
     QSurface *surface() const { return m_surface; }
 
-    void setLightSources(const std::vector<LightSource> &lightSources) Q_DECL_NOTHROW { m_lightSources = lightSources; }
+    void setLightSources(const std::vector<LightSource> &lightSources)
+    {
+        m_lightSources = lightSources;
+        m_lightGrid.build(m_lightSources);
+    }
     void setEnvironmentLight(EnvironmentLight *environmentLight) Q_DECL_NOTHROW { m_environmentLight = environmentLight; }
 
     void updateMatrices();
@@ -343,7 +348,8 @@ private:
     Vector3D m_eyeViewDir;
 
     MaterialParameterGathererData m_parameters;
-    mutable std::vector<LightSource> m_lightSources;
+    std::vector<LightSource> m_lightSources;
+    LightGrid m_lightGrid;
     EnvironmentLight *m_environmentLight = nullptr;
 
     enum StandardUniform
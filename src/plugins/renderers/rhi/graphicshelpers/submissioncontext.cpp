@@ -92,7 +92,10 @@
 #if QT_CONFIG(vulkan)
 #include <QtGui/private/qrhivulkan_p.h>
 #endif
+#include <algorithm>
 #include <bitset>
+#include <cstring>
+#include <limits>
 
 QT_BEGIN_NAMESPACE
 
@@ -159,6 +162,64 @@ namespace {
 //    }
 //}
 
+// Normalizes integer components to floats like the OpenGL renderer does,
+// the smallest signed value being mapped to -1 as well
+template<typename T>
+void expandNormalizedComponents(const char *source, uint count, uint componentCount, uint stride,
+                                float *destination) noexcept
+{
+    const float scale = 1.0f / float(std::numeric_limits<T>::max());
+    for (uint i = 0; i < count; ++i) {
+        const char *element = source + size_t(i) * stride;
+        for (uint c = 0; c < componentCount; ++c) {
+            T value;
+            std::memcpy(&value, element + c * sizeof(T), sizeof(T));
+            *destination++ = std::max(float(value) * scale, -1.0f);
+        }
+    }
+}
+
+// Converts the elements of attribute that fit in data to the tightly packed
+// format of SubmissionContext::expandedAttributeStride
+QByteArray expandAttributeData(const Attribute *attribute, const QByteArray &data)
+{
+    const QAttribute::VertexBaseType type = attribute->vertexBaseType();
+    const uint componentSize = type == QAttribute::Byte || type == QAttribute::UnsignedByte ? 1 : 2;
+    const uint elementSize = componentSize * attribute->vertexSize();
+    const uint stride = attribute->byteStride() > 0 ? attribute->byteStride() : elementSize;
+    const qsizetype available = data.size() - qsizetype(attribute->byteOffset());
+    const uint count = available < qsizetype(elementSize)
+            ? 0U
+            : std::min(attribute->count(), uint((available - elementSize) / stride + 1));
+
+    QByteArray expanded(qsizetype(count) * SubmissionContext::expandedAttributeStride(attribute),
+                        Qt::Uninitialized);
+    const char *source = data.constData() + attribute->byteOffset();
+    if (type == QAttribute::UnsignedByte) {
+        // 3 components get padded to 4, with the 1 vertex inputs default to
+        char *destination = expanded.data();
+        for (uint i = 0; i < count; ++i, destination += 4) {
+            std::memcpy(destination, source + size_t(i) * stride, 3);
+            destination[3] = char(0xff);
+        }
+        return expanded;
+    }
+
+    float *destination = reinterpret_cast<float *>(expanded.data());
+    switch (type) {
+    case QAttribute::Byte:
+        expandNormalizedComponents<qint8>(source, count, attribute->vertexSize(), stride, destination);
+        break;
+    case QAttribute::Short:
+        expandNormalizedComponents<qint16>(source, count, attribute->vertexSize(), stride, destination);
+        break;
+    default:
+        expandNormalizedComponents<quint16>(source, count, attribute->vertexSize(), stride, destination);
+        break;
+    }
+    return expanded;
+}
+
 // Render States Helpers
 
 template<typename GenericState>
@@ -829,6 +890,7 @@ QImage SubmissionContext::readFramebuffer(const QRect &rect)
 void SubmissionContext::releaseResources()
 {
     m_renderBufferHash.clear();
+    m_expandedAttributes.clear();
     RHI_UNIMPLEMENTED;
 
     // Free RHI resources
@@ -1332,6 +1394,11 @@ void SubmissionContext::updateBuffer(Buffer *buffer)
     if (it != m_renderBufferHash.end())
         uploadDataToRHIBuffer(
                 buffer, m_renderer->rhiResourceManagers()->rhiBufferManager()->data(it.value()));
+
+    for (ExpandedAttribute &expanded : m_expandedAttributes) {
+        if (expanded.bufferId == buffer->peerId())
+            expanded.stale = true;
+    }
 }
 
 QByteArray SubmissionContext::downloadBufferContent(Buffer *buffer)
@@ -1360,6 +1427,22 @@ void SubmissionContext::releaseBuffer(Qt3DCore::QNodeId bufferId)
         // Remove Id - HRHIBuffer entry
         m_renderBufferHash.erase(it);
     }
+    releaseExpandedAttributes(bufferId);
+}
+
+void SubmissionContext::releaseExpandedAttributes(Qt3DCore::QNodeId bufferId)
+{
+    RHIBufferManager *bufferManager = m_renderer->rhiResourceManagers()->rhiBufferManager();
+    for (auto it = m_expandedAttributes.begin(); it != m_expandedAttributes.end();) {
+        if (it->bufferId != bufferId) {
+            ++it;
+            continue;
+        }
+        if (RHIBuffer *expandedBuffer = bufferManager->lookupResource(it.key()))
+            expandedBuffer->destroy();
+        bufferManager->releaseResource(it.key());
+        it = m_expandedAttributes.erase(it);
+    }
 }
 
 bool SubmissionContext::hasRHIBufferForBuffer(Buffer *buffer)
@@ -1377,6 +1460,52 @@ RHIBuffer *SubmissionContext::rhiBufferForRenderBuffer(Buffer *buf)
             m_renderBufferHash.value(buf->peerId()));
 }
 
+// QRhi only has vertex input formats for floats, unsigned integers and
+// normalized unsigned bytes with 1, 2 or 4 components. Other normalized
+// integers, such as the ones KHR_mesh_quantization allows, are expanded into
+// buffers of their own, keyed by the id of the attribute
+bool SubmissionContext::isExpandedAttribute(const Attribute *attribute) noexcept
+{
+    if (attribute->attributeType() != QAttribute::VertexAttribute
+            || attribute->vertexSize() < 1 || attribute->vertexSize() > 4)
+        return false;
+    switch (attribute->vertexBaseType()) {
+    case QAttribute::Byte:
+    case QAttribute::Short:
+    case QAttribute::UnsignedShort:
+        return true;
+    case QAttribute::UnsignedByte:
+        return attribute->vertexSize() == 3;
+    default:
+        return false;
+    }
+}
+
+// Unsigned bytes are padded to 4 components, anything else becomes floats
+uint SubmissionContext::expandedAttributeStride(const Attribute *attribute) noexcept
+{
+    if (attribute->vertexBaseType() == QAttribute::UnsignedByte)
+        return 4;
+    return attribute->vertexSize() * uint(sizeof(float));
+}
+
+RHIBuffer *SubmissionContext::rhiBufferForExpandedAttribute(const Attribute *attribute,
+                                                            Buffer *buffer)
+{
+    const ExpandedAttribute layout = { buffer->peerId(),     attribute->vertexBaseType(),
+                                       attribute->vertexSize(), attribute->count(),
+                                       attribute->byteStride(), attribute->byteOffset(),
+                                       false };
+    RHIBuffer *expandedBuffer = m_renderer->rhiResourceManagers()->rhiBufferManager()
+            ->getOrCreateResource(attribute->peerId());
+    const auto it = m_expandedAttributes.constFind(attribute->peerId());
+    if (it == m_expandedAttributes.cend() || *it != layout) {
+        expandedBuffer->allocate(expandAttributeData(attribute, buffer->data()), false);
+        m_expandedAttributes.insert(attribute->peerId(), layout);
+    }
+    return expandedBuffer;
+}
+
 HRHIBuffer SubmissionContext::createRHIBufferFor(Buffer *buffer)
 {
     m_renderer->rhiResourceManagers()->rhiBufferManager()->getOrCreateResource(buffer->peerId());
@@ -53,6 +53,7 @@
 //
 
 #include <rhibuffer_p.h>
+#include <Qt3DCore/qattribute.h>
 #include <Qt3DRender/qclearbuffers.h>
 #include <Qt3DRender/private/handle_types_p.h>
 #include <Qt3DRender/qblitframebuffer.h>
@@ -170,6 +171,11 @@ public:
     bool hasRHIBufferForBuffer(Buffer *buffer);
     RHIBuffer *rhiBufferForRenderBuffer(Buffer *buf);
 
+    // Vertex attributes QRhi has no input format for, uploaded expanded
+    static bool isExpandedAttribute(const Attribute *attribute) noexcept;
+    static uint expandedAttributeStride(const Attribute *attribute) noexcept;
+    RHIBuffer *rhiBufferForExpandedAttribute(const Attribute *attribute, Buffer *buffer);
+
     // Parameters
     bool setParameters(ShaderParameterPack &parameterPack, RHIShader *shader);
 
@@ -206,6 +212,7 @@ private:
     void uploadDataToRHIBuffer(Buffer *buffer, RHIBuffer *b);
     QByteArray downloadDataFromRHIBuffer(Buffer *buffer, RHIBuffer *b);
     bool bindRHIBuffer(RHIBuffer *buffer, RHIBuffer::Type type);
+    void releaseExpandedAttributes(Qt3DCore::QNodeId bufferId);
 
     // States
     void applyState(const StateVariant &state, QRhiGraphicsPipeline *graphicsPipeline);
@@ -217,6 +224,30 @@ private:
     QSize m_surfaceSize;
 
     QHash<Qt3DCore::QNodeId, HRHIBuffer> m_renderBufferHash;
+
+    // The layout expanded attributes were uploaded with, stale once it or
+    // the content of their buffer changed
+    struct ExpandedAttribute
+    {
+        Qt3DCore::QNodeId bufferId;
+        Qt3DCore::QAttribute::VertexBaseType type;
+        uint vertexSize;
+        uint count;
+        uint byteStride;
+        uint byteOffset;
+        bool stale;
+
+        bool operator==(const ExpandedAttribute &other) const noexcept
+        {
+            return bufferId == other.bufferId && type == other.type
+                    && vertexSize == other.vertexSize && count == other.count
+                    && byteStride == other.byteStride && byteOffset == other.byteOffset
+                    && stale == other.stale;
+        }
+        bool operator!=(const ExpandedAttribute &other) const noexcept { return !(*this == other); }
+    };
+    QHash<Qt3DCore::QNodeId, ExpandedAttribute> m_expandedAttributes;
+
     QHash<Qt3DCore::QNodeId, GLuint> m_renderTargets;
     QHash<GLuint, QSize> m_renderTargetsSize;
     QAbstractTexture::TextureFormat m_renderTargetFormat;
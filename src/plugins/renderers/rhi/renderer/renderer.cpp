@@ -85,6 +85,7 @@
 #include <Qt3DRender/qcameralens.h>
 #include <Qt3DCore/private/qabstractaspectjobmanager_p.h>
 #include <Qt3DCore/private/qaspectmanager_p.h>
+#include <Qt3DCore/private/qbuffer_p.h>
 #include <Qt3DCore/private/qsysteminformationservice_p.h>
 #include <Qt3DCore/private/qsysteminformationservice_p_p.h>
 #include <Qt3DRender/private/resourceaccessor_p.h>
@@ -378,6 +379,11 @@ void Renderer::setServices(QServiceLocator *services)
     m_services = services;
 
     m_nodesManager->sceneManager()->setDownloadService(m_services->downloadHelperService());
+
+    // Name the submission phases in the traces
+    auto dservice = QSystemInformationServicePrivate::get(m_services->systemInformation());
+    dservice->registerJobTypeName(JobTypes::FrameSubmissionPart1, QStringLiteral("FrameSubmissionPart1"));
+    dservice->registerJobTypeName(JobTypes::FrameSubmissionPart2, QStringLiteral("FrameSubmissionPart2"));
 }
 
 QRenderAspect *Renderer::aspect() const
@@ -544,6 +550,10 @@ void Renderer::shutdown()
     QMutexLocker lock(&m_hasBeenInitializedMutex);
 
     qCDebug(Backend) << Q_FUNC_INFO << "Requesting renderer shutdown";
+
+    // A pipelined frame has begun drawing and must be ended
+    submitPreparedFrame();
+
     m_running.storeRelaxed(0);
 
     // We delete any renderqueue that we may not have had time to render
@@ -622,7 +632,7 @@ void Renderer::setSceneRoot(Entity *sgRoot)
     m_cleanupJob->setRoot(m_renderSceneRoot);
 
     // Set all flags to dirty
-    m_dirtyBits.marked |= AbstractRenderer::AllDirty;
+    m_dirtyBits.marked.fetchAndOrRelaxed(AbstractRenderer::AllDirty);
 }
 
 void Renderer::setSettings(RenderSettings *settings)
@@ -640,7 +650,6 @@ RenderSettings *Renderer::settings() const
 // This will wait until renderQueue is ready or shutdown was requested
 void Renderer::render(bool swapBuffers)
 {
-    Renderer::ViewSubmissionResultData submissionData;
     bool beganDrawing = false;
 
     // Blocking until RenderQueue is full
@@ -650,20 +659,28 @@ void Renderer::render(bool swapBuffers)
     if (!canSubmit)
         return;
 
+    // A prepared frame which wasn't submitted while the jobs were running,
+    // e.g. because pipelining was disabled since, must end before the next
+    // one begins
+    if (submitPreparedFrame())
+        m_cleanGraphicsResourcesPending = true;
+
+    // When pipelined, the resources released by the frame which was submitted
+    // while the jobs were running could only be cleaned up now that they are done
+    if (m_cleanGraphicsResourcesPending) {
+        m_cleanGraphicsResourcesPending = false;
+        cleanGraphicsResources();
+    }
+
     m_shouldSwapBuffers = swapBuffers;
     const std::vector<Render::Rhi::RenderView *> &renderViews = m_renderQueue.nextFrameQueue();
     const bool queueIsEmpty = m_renderQueue.targetRenderViewCount() == 0;
 
-    bool mustCleanResources = false;
-
     // RenderQueue is complete (but that means it may be of size 0)
     if (!queueIsEmpty) {
         QTaskLogger submissionStatsPart1(m_services->systemInformation(),
                                          { JobTypes::FrameSubmissionPart1, 0 },
                                          QTaskLogger::Submission);
-        QTaskLogger submissionStatsPart2(m_services->systemInformation(),
-                                         { JobTypes::FrameSubmissionPart2, 0 },
-                                         QTaskLogger::Submission);
 
         std::vector<RHIPassInfo> rhiPassesInfo;
 
@@ -715,52 +732,93 @@ void Renderer::render(bool swapBuffers)
         }
 
         // Only try to submit the RenderViews if the preprocessing was successful
-        // This part of the submission is happening in parallel to the RV building for the next
-        // frame
         if (beganDrawing) {
-            submissionStatsPart1.end(submissionStatsPart2.restart());
-
-            // 3) Submit the render commands for frame n (making sure we never reference
-            // something that could be changing) Render using current device state and renderer
-            // configuration
-            submissionData = submitRenderViews(rhiPassesInfo);
+            // 3) Upload the data of the RenderCommands and record the draw
+            // calls, after which the RenderViews are no longer needed
+            for (RHIPassInfo &passInfo : rhiPassesInfo)
+                recordCommandsSubmission(passInfo);
+
+            if (m_services->systemInformation()->isTraceEnabled()) {
+                qint64 drawCount = 0;
+                for (const RHIPassInfo &passInfo : rhiPassesInfo) {
+                    for (const RHIViewInfo &viewInfo : passInfo.views)
+                        drawCount += qint64(viewInfo.draws.size());
+                }
+                auto dservice = QSystemInformationServicePrivate::get(m_services->systemInformation());
+                dservice->addCounterEntry("Entities", m_nodesManager->renderNodesManager()->count());
+                dservice->addCounterEntry("Render Commands", drawCount);
+            }
 
-            // Perform any required cleanup of the Graphics resources (Buffers deleted, Shader
-            // deleted...)
-            mustCleanResources = true;
+            m_preparedFrame.passesInfo = std::move(rhiPassesInfo);
+            m_preparedFrame.surface = surface;
+            m_hasPreparedFrame = true;
         }
 
         // Execute the pending shell commands
         m_commandExecuter->performAsynchronousCommandExecution(renderViews);
+    }
+
+    // Reset RenderQueue and destroy the renderViews
+    m_renderQueue.reset();
+
+    // When pipelined, the frame is submitted by submitPendingFrame while the
+    // jobs of the next frame are running
+    if (!m_pipelinedRendering && submitPreparedFrame()) {
+        // Perform any required cleanup of the Graphics resources (Buffers deleted, Shader
+        // deleted...)
+        cleanGraphicsResources();
+    }
+
+    // We allow the RenderTickClock service to proceed to the next frame
+    // In turn this will allow the aspect manager to request a new set of jobs
+    // to be performed for each aspect
+    m_vsyncFrameAdvanceService->proceedToNextFrame();
+}
+
+// Main thread, called by the aspect while the jobs of the next frame are
+// running when rendering is pipelined
+void Renderer::submitPendingFrame()
+{
+    // Releasing resources would race with the running jobs, this is
+    // deferred until the next frame gets prepared
+    if (submitPreparedFrame())
+        m_cleanGraphicsResourcesPending = true;
+}
+
+// Returns true if a frame was submitted
+bool Renderer::submitPreparedFrame()
+{
+    if (!m_hasPreparedFrame)
+        return false;
+
+    const PreparedFrame frame = std::move(m_preparedFrame);
+    m_preparedFrame = {};
+    m_hasPreparedFrame = false;
+
+    ViewSubmissionResultData submissionData;
+    {
+        QTaskLogger submissionStatsPart2(m_services->systemInformation(),
+                                         { JobTypes::FrameSubmissionPart2, 0 },
+                                         QTaskLogger::Submission);
 
-        // Delete all the RenderViews which will clear the allocators
-        // that were used for their allocation
+        // 4) Submit the render commands for frame n (making sure we never reference
+        // something that could be changing) Render using current device state and renderer
+        // configuration
+        submissionData = submitRenderViews(frame);
     }
 
-    // Perform the last swapBuffers calls after the proceedToNextFrame
-    // as this allows us to gain a bit of time for the preparation of the
-    // next frame
+    // Perform the last swapBuffers calls
     // Finish up with last surface used in the list of RenderViews
-    if (beganDrawing) {
+    {
         SurfaceLocker surfaceLock(submissionData.surface);
-        // Finish up with last surface used in the list of RenderViews
         const bool swapBuffers =
                 true // submissionData.lastBoundFBOId == m_submissionContext->defaultFBO()
                 && surfaceLock.isSurfaceValid()
                 && m_shouldSwapBuffers;
         m_submissionContext->endDrawing(swapBuffers);
-
-        if (mustCleanResources)
-            cleanGraphicsResources();
     }
 
-    // Reset RenderQueue and destroy the renderViews
-    m_renderQueue.reset();
-
-    // We allow the RenderTickClock service to proceed to the next frame
-    // In turn this will allow the aspect manager to request a new set of jobs
-    // to be performed for each aspect
-    m_vsyncFrameAdvanceService->proceedToNextFrame();
+    return true;
 }
 
 // Called by RenderViewJobs
@@ -812,15 +870,32 @@ QSurfaceFormat Renderer::format()
 }
 
 namespace {
+std::optional<QRhiVertexInputAttribute::Format> rhiFloatAttributeType(uint vertexSize) {
+    if (vertexSize == 1)
+        return QRhiVertexInputAttribute::Float;
+    if (vertexSize == 2)
+        return QRhiVertexInputAttribute::Float2;
+    if (vertexSize == 3)
+        return QRhiVertexInputAttribute::Float3;
+    if (vertexSize == 4)
+        return QRhiVertexInputAttribute::Float4;
+    return std::nullopt;
+}
+
 std::optional<QRhiVertexInputAttribute::Format> rhiAttributeType(Attribute *attr) {
     switch (attr->vertexBaseType()) {
     case QAttribute::Byte:
+    case QAttribute::Short:
+    case QAttribute::UnsignedShort:
+        // Uploaded as floats, see SubmissionContext::isExpandedAttribute
+        return rhiFloatAttributeType(attr->vertexSize());
     case QAttribute::UnsignedByte: {
         if (attr->vertexSize() == 1)
             return QRhiVertexInputAttribute::UNormByte;
         if (attr->vertexSize() == 2)
             return QRhiVertexInputAttribute::UNormByte2;
-        if (attr->vertexSize() == 4)
+        // 3 components get padded to 4 when uploaded
+        if (attr->vertexSize() == 3 || attr->vertexSize() == 4)
             return QRhiVertexInputAttribute::UNormByte4;
         break;
     }
@@ -835,17 +910,8 @@ std::optional<QRhiVertexInputAttribute::Format> rhiAttributeType(Attribute *attr
             return QRhiVertexInputAttribute::UInt4;
         break;
     }
-    case QAttribute::Float: {
-        if (attr->vertexSize() == 1)
-            return QRhiVertexInputAttribute::Float;
-        if (attr->vertexSize() == 2)
-            return QRhiVertexInputAttribute::Float2;
-        if (attr->vertexSize() == 3)
-            return QRhiVertexInputAttribute::Float3;
-        if (attr->vertexSize() == 4)
-            return QRhiVertexInputAttribute::Float4;
-        break;
-    }
+    case QAttribute::Float:
+        return rhiFloatAttributeType(attr->vertexSize());
     default:
         break;
     }
@@ -1531,7 +1597,12 @@ bool Renderer::prepareGeometryInputBindings(const Geometry *geometry, const RHIS
         const QRhiVertexInputBinding::Classification classification = isPerInstanceAttr
                 ? QRhiVertexInputBinding::PerInstance
                 : QRhiVertexInputBinding::PerVertex;
-        const BufferBinding binding = { attrib->bufferId(), attrib->byteStride(),
+        // Expanded attributes are bound to buffers of their own, tightly packed
+        const bool isExpandedAttr = SubmissionContext::isExpandedAttribute(attrib);
+        const BufferBinding binding = { isExpandedAttr ? attrib->peerId() : attrib->bufferId(),
+                                        isExpandedAttr
+                                                ? SubmissionContext::expandedAttributeStride(attrib)
+                                                : attrib->byteStride(),
                                         classification,
                                         isPerInstanceAttr ? attrib->divisor() : 1U };
 
@@ -1565,7 +1636,7 @@ bool Renderer::prepareGeometryInputBindings(const Geometry *geometry, const RHIS
         rhiAttributes.push_back({ bindingIndex,
                                   location,
                                   *attributeType,
-                                  attrib->byteOffset() });
+                                  isExpandedAttr ? 0U : attrib->byteOffset() });
 
         attributeNameToBinding.insert(attrib->nameId(), bindingIndex);
     }
@@ -1606,6 +1677,8 @@ bool Renderer::prepareGeometryInputBindings(const Geometry *geometry, const RHIS
 void Renderer::updateResources()
 {
     {
+        const bool traceEnabled = m_services->systemInformation()->isTraceEnabled();
+        qint64 uploadedBytes = 0;
         const std::vector<HBuffer> dirtyBufferHandles = std::move(m_dirtyBuffers);
         for (const HBuffer &handle : dirtyBufferHandles) {
             Buffer *buffer = m_nodesManager->bufferManager()->data(handle);
@@ -1614,6 +1687,11 @@ void Renderer::updateResources()
             if (buffer == nullptr)
                 continue;
 
+            if (traceEnabled) {
+                for (const Qt3DCore::QBufferUpdate &update : buffer->pendingBufferUpdates())
+                    uploadedBytes += update.offset >= 0 ? update.data.size() : buffer->data().size();
+            }
+
             // Forces creation if it doesn't exit
             // Also note the binding point doesn't really matter here, we just upload data
             if (!m_submissionContext->hasRHIBufferForBuffer(buffer))
@@ -1622,6 +1700,10 @@ void Renderer::updateResources()
             m_submissionContext->updateBuffer(buffer);
             buffer->unsetDirty();
         }
+        if (traceEnabled) {
+            QSystemInformationServicePrivate::get(m_services->systemInformation())
+                    ->addCounterEntry("Uploaded Buffer Bytes", uploadedBytes);
+        }
     }
 
 #ifndef SHADER_LOADING_IN_COMMAND_THREAD
@@ -1815,8 +1897,10 @@ void Renderer::downloadGLBuffers()
 // Happens in RenderThread context when all RenderViewJobs are done
 // Returns the id of the last bound FBO
 Renderer::ViewSubmissionResultData
-Renderer::submitRenderViews(const std::vector<RHIPassInfo> &rhiPassesInfo)
+Renderer::submitRenderViews(const PreparedFrame &frame)
 {
+    const std::vector<RHIPassInfo> &rhiPassesInfo = frame.passesInfo;
+
     QElapsedTimer timer;
     quint64 queueElapsed = 0;
     timer.start();
@@ -1828,7 +1912,8 @@ Renderer::submitRenderViews(const std::vector<RHIPassInfo> &rhiPassesInfo)
 
     // We might not want to render on the default FBO
     QSurface *surface = nullptr;
-    QSurface *previousSurface = nullptr;
+    // Drawing was begun on that surface when the frame was prepared
+    QSurface *previousSurface = frame.surface;
     QSurface *lastUsedSurface = nullptr;
 
     const int rhiPassesCount = rhiPassesInfo.size();
@@ -1837,15 +1922,6 @@ Renderer::submitRenderViews(const std::vector<RHIPassInfo> &rhiPassesInfo)
         // Initialize GraphicsContext for drawing
         const RHIPassInfo &rhiPassInfo = rhiPassesInfo.at(i);
 
-        // Initialize Previous surface the first time we enter this loop
-        if (i == 0) {
-            for (const RenderView *rv : rhiPassInfo.rvs) {
-                previousSurface = rv->surface();
-                if (previousSurface)
-                    break;
-            }
-        }
-
         // Check if using the same surface as the previous RHIPassInfo.
         // If not, we have to free up the context from the previous surface
         // and make the context current on the new surface
@@ -1985,19 +2061,19 @@ Renderer::submitRenderViews(const std::vector<RHIPassInfo> &rhiPassesInfo)
 void Renderer::markDirty(BackendNodeDirtySet changes, BackendNode *node)
 {
     Q_UNUSED(node);
-    m_dirtyBits.marked |= changes;
+    m_dirtyBits.marked.fetchAndOrRelaxed(int(changes));
 }
 
 Renderer::BackendNodeDirtySet Renderer::dirtyBits()
 {
-    return m_dirtyBits.marked;
+    return BackendNodeDirtySet(QFlag(m_dirtyBits.marked.loadRelaxed()));
 }
 
 #if defined(QT_BUILD_INTERNAL)
 void Renderer::clearDirtyBits(BackendNodeDirtySet changes)
 {
     m_dirtyBits.remaining &= ~changes;
-    m_dirtyBits.marked &= ~changes;
+    m_dirtyBits.marked.fetchAndAndRelaxed(~int(changes));
 }
 #endif
 
@@ -2005,7 +2081,7 @@ bool Renderer::shouldRender() const
 {
     // Only render if something changed during the last frame, or the last frame
     // was not rendered successfully (or render-on-demand is disabled)
-    return (m_settings->renderPolicy() == QRenderSettings::Always || m_dirtyBits.marked != 0
+    return (m_settings->renderPolicy() == QRenderSettings::Always || m_dirtyBits.marked.loadRelaxed() != 0
             || m_dirtyBits.remaining != 0 || !m_lastFrameCorrect.loadRelaxed());
 }
 
@@ -2072,8 +2148,8 @@ std::vector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
     // Remove previous dependencies
     m_cleanupJob->removeDependency(QWeakPointer<QAspectJob>());
 
-    const BackendNodeDirtySet dirtyBitsForFrame = m_dirtyBits.marked | m_dirtyBits.remaining;
-    m_dirtyBits.marked = {};
+    const BackendNodeDirtySet dirtyBitsForFrame = BackendNodeDirtySet(QFlag(m_dirtyBits.marked.fetchAndStoreRelaxed(0)))
+            | m_dirtyBits.remaining;
     m_dirtyBits.remaining = {};
     BackendNodeDirtySet notCleared = {};
 
@@ -2301,6 +2377,8 @@ bool Renderer::uploadBuffersForCommand(QRhiCommandBuffer *cb, const RenderView *
                 m_RHIResourceManagers->rhiBufferManager()->lookupResource(buffer->peerId());
         switch (attrib->attributeType()) {
         case QAttribute::VertexAttribute: {
+            if (SubmissionContext::isExpandedAttribute(attrib))
+                hbuf = m_submissionContext->rhiBufferForExpandedAttribute(attrib, buffer);
             if (!hbuf->bind(&*m_submissionContext, RHIBuffer::Type::ArrayBuffer))
                 return false;
             assert(hbuf->rhiBuffer());
@@ -2338,18 +2416,13 @@ bool Renderer::uploadBuffersForCommand(QRhiCommandBuffer *cb, const RenderView *
     return true;
 }
 
-bool Renderer::performDraw(QRhiCommandBuffer *cb, const QRhiViewport &vp,
-                           const QRhiScissor *scissor, RenderCommand &command)
+// Records the state needed to draw a RenderCommand, creating its shader
+// resource bindings if required. Returns false if there is nothing to draw
+bool Renderer::prepareDraw(RenderCommand &command, RHIDrawInfo &draw)
 {
     RHIGraphicsPipeline *pipeline = command.pipeline;
     if (!pipeline)
-        return true;
-
-    // Setup the rendering pass
-    cb->setGraphicsPipeline(pipeline->pipeline());
-    cb->setViewport(vp);
-    if (scissor)
-        cb->setScissor(*scissor);
+        return false;
 
     // We need to create new resource bindings for each RC as each RC might potentially
     // have different textures or reference custom UBOs (if using Parameters with UBOs directly).
@@ -2373,45 +2446,56 @@ bool Renderer::performDraw(QRhiCommandBuffer *cb, const QRhiViewport &vp,
         qCWarning(Backend) << "Failed to create ShaderResourceBindings";
         return false;
     }
-    const std::vector<QRhiCommandBuffer::DynamicOffset> offsets = pipeline->uboSet()->offsets(command);
 
-    cb->setShaderResources(command.shaderResourceBindings,
-                           offsets.size(),
-                           offsets.data());
-
-    // Send the draw command
-    if (Q_UNLIKELY(!command.indexBuffer)) {
-        cb->setVertexInput(0, command.vertex_input.size(), command.vertex_input.data());
-        cb->draw(command.m_primitiveCount, command.m_instanceCount, command.m_firstVertex,
-                 command.m_firstInstance);
-    } else {
-        auto indexFormat = rhiIndexFormat(command.indexAttribute->vertexBaseType());
-        auto indexOffset = command.indexAttribute->byteOffset();
-        cb->setVertexInput(0, command.vertex_input.size(), command.vertex_input.data(),
-                           command.indexBuffer, indexOffset, indexFormat);
-        cb->drawIndexed(command.m_primitiveCount, command.m_instanceCount, command.m_indexOffset,
-                        command.m_indexAttributeByteOffset, command.m_firstInstance);
+    draw.pipeline = pipeline->pipeline();
+    draw.shaderResourceBindings = command.shaderResourceBindings;
+    draw.offsets = pipeline->uboSet()->offsets(command);
+    draw.vertexInput = command.vertex_input;
+    draw.primitiveCount = command.m_primitiveCount;
+    draw.instanceCount = command.m_instanceCount;
+    draw.firstVertex = command.m_firstVertex;
+    draw.firstIndex = command.m_indexOffset;
+    draw.vertexOffset = command.m_indexAttributeByteOffset;
+    draw.firstInstance = command.m_firstInstance;
+    if (command.indexBuffer) {
+        draw.indexBuffer = command.indexBuffer;
+        draw.indexFormat = rhiIndexFormat(command.indexAttribute->vertexBaseType());
+        draw.indexBufferOffset = command.indexAttribute->byteOffset();
     }
     return true;
 }
 
-// Called by RenderView->submit() in RenderThread context
-// Returns true, if all RenderCommands were sent to the GPU
-bool Renderer::executeCommandsSubmission(const RHIPassInfo &passInfo)
+void Renderer::performDraw(QRhiCommandBuffer *cb, const RHIViewInfo &view, const RHIDrawInfo &draw)
 {
-    bool allCommandsIssued = true;
+    // Setup the rendering pass
+    cb->setGraphicsPipeline(draw.pipeline);
+    cb->setViewport(view.viewport);
+    if (view.hasScissor)
+        cb->setScissor(view.scissor);
 
-    const std::vector<RenderView *> &renderViews = passInfo.rvs;
-    QColor clearColor;
-    QRhiDepthStencilClearValue clearDepthStencil;
+    cb->setShaderResources(draw.shaderResourceBindings,
+                           draw.offsets.size(),
+                           draw.offsets.data());
 
-    // Submit the commands to the underlying graphics API (RHI)
-    QRhiCommandBuffer *cb = m_submissionContext->currentFrameCommandBuffer();
+    // Send the draw command
+    if (Q_UNLIKELY(!draw.indexBuffer)) {
+        cb->setVertexInput(0, draw.vertexInput.size(), draw.vertexInput.data());
+        cb->draw(draw.primitiveCount, draw.instanceCount, draw.firstVertex, draw.firstInstance);
+    } else {
+        cb->setVertexInput(0, draw.vertexInput.size(), draw.vertexInput.data(),
+                           draw.indexBuffer, draw.indexBufferOffset, draw.indexFormat);
+        cb->drawIndexed(draw.primitiveCount, draw.instanceCount, draw.firstIndex,
+                        draw.vertexOffset, draw.firstInstance);
+    }
+}
 
-    // Upload data for all RenderCommands
-    for (RenderView *rv : renderViews) {
-        // Render drawing commands
+// Uploads the data of the RenderCommands of a pass and records its draw calls
+void Renderer::recordCommandsSubmission(RHIPassInfo &passInfo)
+{
+    QRhiCommandBuffer *cb = m_submissionContext->currentFrameCommandBuffer();
 
+    passInfo.views.reserve(passInfo.rvs.size());
+    for (RenderView *rv : passInfo.rvs) {
         // Upload UBOs for pipelines used in current RV
         const std::vector<RHIGraphicsPipeline *> &rvPipelines = m_rvToPipelines[rv];
         for (RHIGraphicsPipeline *pipeline : rvPipelines) {
@@ -2436,14 +2520,70 @@ bool Renderer::executeCommandsSubmission(const RHIPassInfo &passInfo)
 
         // Record clear information
         if (rv->clearTypes() != QClearBuffers::None) {
-            clearColor = [=] {
+            passInfo.clearColor = [=] {
                 auto col = rv->globalClearColorBufferInfo().clearColor;
                 return QColor::fromRgbF(col.x(), col.y(), col.z(), col.w());
             }();
-            clearDepthStencil = { rv->clearDepthValue(), (quint32)rv->clearStencilValue() };
+            passInfo.clearDepthStencil = { rv->clearDepthValue(), (quint32)rv->clearStencilValue() };
+        }
+
+        RHIViewInfo viewInfo;
+        // Viewport
+        {
+            const float x = rv->viewport().x() * rv->surfaceSize().width();
+            const float y = (1. - rv->viewport().y() - rv->viewport().height())
+                    * rv->surfaceSize().height();
+            const float w = rv->viewport().width() * rv->surfaceSize().width();
+            const float h = rv->viewport().height() * rv->surfaceSize().height();
+            //            qDebug() << x << y << w << h;
+            viewInfo.viewport = { x, y, w, h };
         }
+        // Scissoring
+        {
+            RenderStateSet *ss = rv->stateSet();
+            if (ss == nullptr)
+                ss = m_defaultRenderStateSet;
+            StateVariant *scissorTestSVariant =
+                    m_submissionContext->getState(ss, StateMask::ScissorStateMask);
+            if (scissorTestSVariant) {
+                const ScissorTest *scissorTest =
+                        static_cast<const ScissorTest *>(scissorTestSVariant->constState());
+                const auto &scissorValues = scissorTest->values();
+                viewInfo.scissor = { std::get<0>(scissorValues), std::get<1>(scissorValues),
+                                     std::get<2>(scissorValues), std::get<3>(scissorValues) };
+                viewInfo.hasScissor = true;
+            }
+        }
+
+        // Record drawing commands
+        viewInfo.draws.reserve(rv->commandCount());
+        rv->forEachCommand([&] (RenderCommand &command) {
+            if (Q_UNLIKELY(!command.isValid()))
+                return;
+
+            if (command.m_type == RenderCommand::Draw) {
+                RHIDrawInfo draw;
+                if (prepareDraw(command, draw))
+                    viewInfo.draws.push_back(std::move(draw));
+            }
+        });
+
+        passInfo.views.push_back(std::move(viewInfo));
     }
 
+    // The RenderViews are destroyed before the pass gets executed
+    passInfo.rvs.clear();
+}
+
+// Executes a pass recorded by recordCommandsSubmission
+// Returns true, if all RenderCommands were sent to the GPU
+bool Renderer::executeCommandsSubmission(const RHIPassInfo &passInfo)
+{
+    bool allCommandsIssued = true;
+
+    // Submit the commands to the underlying graphics API (RHI)
+    QRhiCommandBuffer *cb = m_submissionContext->currentFrameCommandBuffer();
+
     // Lookup the render target
     QRhiRenderTarget *rhiRenderTarget{};
     {
@@ -2474,50 +2614,13 @@ bool Renderer::executeCommandsSubmission(const RHIPassInfo &passInfo)
     // Draw the commands
 
     // Begin pass
-    cb->beginPass(rhiRenderTarget, clearColor, clearDepthStencil,
+    cb->beginPass(rhiRenderTarget, passInfo.clearColor, passInfo.clearDepthStencil,
                   m_submissionContext->m_currentUpdates);
 
-    // Per Pass Global States
-    for (RenderView *rv : renderViews) {
-        // Viewport
-        QRhiViewport vp;
-        QRhiScissor scissor;
-        bool hasScissor = false;
-        {
-            const float x = rv->viewport().x() * rv->surfaceSize().width();
-            const float y = (1. - rv->viewport().y() - rv->viewport().height())
-                    * rv->surfaceSize().height();
-            const float w = rv->viewport().width() * rv->surfaceSize().width();
-            const float h = rv->viewport().height() * rv->surfaceSize().height();
-            //            qDebug() << x << y << w << h;
-            vp = { x, y, w, h };
-        }
-        // Scissoring
-        {
-            RenderStateSet *ss = rv->stateSet();
-            if (ss == nullptr)
-                ss = m_defaultRenderStateSet;
-            StateVariant *scissorTestSVariant =
-                    m_submissionContext->getState(ss, StateMask::ScissorStateMask);
-            if (scissorTestSVariant) {
-                const ScissorTest *scissorTest =
-                        static_cast<const ScissorTest *>(scissorTestSVariant->constState());
-                const auto &scissorValues = scissorTest->values();
-                scissor = { std::get<0>(scissorValues), std::get<1>(scissorValues),
-                            std::get<2>(scissorValues), std::get<3>(scissorValues) };
-                hasScissor = true;
-            }
-        }
-
-        // Render drawing commands
-        rv->forEachCommand([&] (RenderCommand &command) {
-            if (Q_UNLIKELY(!command.isValid()))
-                return;
-
-            if (command.m_type == RenderCommand::Draw) {
-                performDraw(cb, vp, hasScissor ? &scissor : nullptr, command);
-            }
-        });
+    // Render drawing commands
+    for (const RHIViewInfo &view : passInfo.views) {
+        for (const RHIDrawInfo &draw : view.draws)
+            performDraw(cb, view, draw);
     }
 
     cb->endPass();
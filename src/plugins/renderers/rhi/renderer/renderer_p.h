@@ -80,6 +80,7 @@
 #include <rhihandle_types_p.h>
 #include <renderview_p.h>
 
+#include <QColor>
 #include <QHash>
 #include <QMatrix4x4>
 #include <QObject>
@@ -257,17 +258,63 @@ public:
                          Qt3DCore::QNodeId outputRenderTargetId, QRect inputRect, QRect outputRect,
                          GLuint defaultFramebuffer);
 
+    // Draw call recorded from a RenderCommand. It holds everything needed to
+    // submit it so that the RenderCommands can be updated for the next frame
+    // while it is being submitted
+    struct RHIDrawInfo
+    {
+        QRhiGraphicsPipeline *pipeline = nullptr;
+        QRhiShaderResourceBindings *shaderResourceBindings = nullptr;
+        std::vector<QRhiCommandBuffer::DynamicOffset> offsets;
+        QVarLengthArray<QRhiCommandBuffer::VertexInput, 8> vertexInput;
+        QRhiBuffer *indexBuffer = nullptr;
+        quint32 indexBufferOffset = 0;
+        QRhiCommandBuffer::IndexFormat indexFormat = QRhiCommandBuffer::IndexUInt16;
+        quint32 primitiveCount = 0;
+        quint32 instanceCount = 0;
+        quint32 firstVertex = 0;
+        quint32 firstIndex = 0;
+        qint32 vertexOffset = 0;
+        quint32 firstInstance = 0;
+    };
+
+    struct RHIViewInfo
+    {
+        QRhiViewport viewport;
+        QRhiScissor scissor;
+        bool hasScissor = false;
+        std::vector<RHIDrawInfo> draws;
+    };
+
     struct RHIPassInfo
     {
         std::vector<RenderView *> rvs;
         QSurface *surface = nullptr;
         Qt3DCore::QNodeId renderTargetId;
         AttachmentPack attachmentPack;
+
+        // Recorded by recordCommandsSubmission, after which rvs is cleared
+        QColor clearColor;
+        QRhiDepthStencilClearValue clearDepthStencil;
+        std::vector<RHIViewInfo> views;
+    };
+
+    // A frame whose draw calls have been recorded and which only remains to
+    // be submitted. It no longer references the RenderViews it was built from
+    struct PreparedFrame
+    {
+        std::vector<RHIPassInfo> passesInfo;
+        QSurface *surface = nullptr; // Surface beginDrawing was called for
     };
 
     std::vector<RHIPassInfo> prepareCommandsSubmission(const std::vector<RenderView *> &renderViews);
+    void recordCommandsSubmission(RHIPassInfo &passInfo);
     bool executeCommandsSubmission(const RHIPassInfo &passInfo);
 
+    void setPipelinedRendering(bool pipelined) override { m_pipelinedRendering = pipelined; }
+    bool isPipelinedRendering() const override { return m_pipelinedRendering; }
+    void submitPendingFrame() override;
+
     // For Scene3D/Scene2D rendering
     void setOpenGLContext(QOpenGLContext *context) override;
     void setRHIContext(QRhi *ctx) override;
@@ -299,7 +346,7 @@ public:
         QSurface *surface;
     };
 
-    ViewSubmissionResultData submitRenderViews(const std::vector<RHIPassInfo> &rhiPassesInfo);
+    ViewSubmissionResultData submitRenderViews(const PreparedFrame &frame);
 
     RendererCache<RenderCommand> *cache() { return &m_cache; }
     void setScreen(QScreen *scr) override;
@@ -344,7 +391,7 @@ private:
 
     struct DirtyBits
     {
-        BackendNodeDirtySet marked; // marked dirty since last job build
+        QAtomicInt marked; // marked dirty since last job build, possibly from concurrent syncs
         BackendNodeDirtySet remaining; // remaining dirty after jobs have finished
     };
     DirtyBits m_dirtyBits;
@@ -415,6 +462,14 @@ private:
 
     bool m_hasSwapChain = false;
 
+    // When pipelined, render() only prepares the frame and submitPendingFrame()
+    // submits it while the jobs of the next frame are running
+    bool m_pipelinedRendering = false;
+    PreparedFrame m_preparedFrame;
+    bool m_hasPreparedFrame = false;
+    bool m_cleanGraphicsResourcesPending = false;
+    bool submitPreparedFrame();
+
     int m_jobsInLastFrame = 0;
 
     float m_textureTransform[4];
@@ -438,8 +493,8 @@ private:
 
     bool uploadBuffersForCommand(QRhiCommandBuffer *cb, const RenderView *rv,
                                  RenderCommand &command);
-    bool performDraw(QRhiCommandBuffer *cb, const QRhiViewport &vp, const QRhiScissor *scissor,
-                     RenderCommand &command);
+    bool prepareDraw(RenderCommand &command, RHIDrawInfo &draw);
+    void performDraw(QRhiCommandBuffer *cb, const RHIViewInfo &view, const RHIDrawInfo &draw);
 };
 
 } // namespace Rhi
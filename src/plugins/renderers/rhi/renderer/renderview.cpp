@@ -910,10 +910,13 @@ EntityRenderCommandData RenderView::buildDrawRenderCommands(const Entity **entit
                         }
 
                         if (attribute->attributeType() == QAttribute::VertexAttribute) {
+                            // Expanded attributes get bound tightly packed
+                            const bool isExpanded = SubmissionContext::isExpandedAttribute(attribute);
                             command.m_attributeInfo.push_back({ attribute->nameId(),
                                                                 attribute->divisor() == 0 ? QRhiVertexInputBinding::PerVertex : QRhiVertexInputBinding::PerInstance,
-                                                                size_t(attribute->byteStride()),
-                                                                size_t(attribute->byteOffset()),
+                                                                isExpanded ? size_t(SubmissionContext::expandedAttributeStride(attribute))
+                                                                           : size_t(attribute->byteStride()),
+                                                                isExpanded ? size_t(0) : size_t(attribute->byteOffset()),
                                                                 size_t(attribute->divisor()) });
                         }
                     }
@@ -1099,11 +1102,10 @@ void RenderView::updateRenderCommand(const EntityRenderCommandDataSubView &subVi
                          RenderCommand &command) {
 
         // Pick which lights to take in to account.
-        // For now decide based on the distance by taking the MAX_LIGHTS closest lights.
-        // Replace with more sophisticated mechanisms later.
-        // Copy vector so that we can sort it concurrently and we only want to sort the one for the
-        // current command
-        std::vector<LightSource> lightSources;
+        // For now decide based on the distance by taking the MAX_LIGHTS closest lights,
+        // looked up in the light grid built once per RenderView.
+        int closestLightIndices[MAX_LIGHTS];
+        int closestLightCount = 0;
         EnvironmentLight *environmentLight = nullptr;
 
         if (command.m_type == RenderCommand::Draw) {
@@ -1114,20 +1116,8 @@ void RenderView::updateRenderCommand(const EntityRenderCommandDataSubView &subVi
                     entity->worldBoundingVolume()->center() - m_eyePos, m_eyeViewDir);
 
             environmentLight = m_environmentLight;
-            lightSources = m_lightSources;
-
-            if (lightSources.size() > 1) {
-                const Vector3D entityCenter = entity->worldBoundingVolume()->center();
-                std::sort(lightSources.begin(), lightSources.end(),
-                          [&](const LightSource &a, const LightSource &b) {
-                              const float distA = entityCenter.distanceToPoint(
-                                      a.entity->worldBoundingVolume()->center());
-                              const float distB = entityCenter.distanceToPoint(
-                                      b.entity->worldBoundingVolume()->center());
-                              return distA < distB;
-                          });
-                m_lightSources = {lightSources.begin(), lightSources.begin() + std::min(lightSources.size(), size_t(MAX_LIGHTS)) };
-            }
+            closestLightCount = m_lightGrid.closestLights(entity->worldBoundingVolume()->center(),
+                                                          MAX_LIGHTS, closestLightIndices);
         } else { // Compute
             // Note: if frameCount has reached 0 in the previous frame, isEnabled
             // would be false
@@ -1141,7 +1131,8 @@ void RenderView::updateRenderCommand(const EntityRenderCommandDataSubView &subVi
         // setShaderAndUniforms can initialize a localData
         // make sure this is cleared before we leave this function
 
-        setShaderAndUniforms(&command, globalParameters, entity, lightSources, environmentLight);
+        setShaderAndUniforms(&command, globalParameters, entity, closestLightIndices,
+                             closestLightCount, environmentLight);
 
         // Update CommandUBO (Qt3D standard uniforms)
         const Matrix4x4 worldTransform = *(entity->worldTransform());
@@ -1335,7 +1326,7 @@ void RenderView::applyParameter(const Parameter *param, RenderCommand *command,
 
 void RenderView::setShaderAndUniforms(RenderCommand *command, ParameterInfoList &parameters,
                                       const Entity *entity,
-                                      const std::vector<LightSource> &activeLightSources,
+                                      const int *activeLightIndices, int activeLightCount,
                                       EnvironmentLight *environmentLight) const
 {
     Q_UNUSED(entity);
@@ -1411,9 +1402,10 @@ void RenderView::setShaderAndUniforms(RenderCommand *command, ParameterInfoList
 
         // Lights
         int lightIdx = 0;
-        for (const LightSource &lightSource : activeLightSources) {
+        for (int i = 0; i < activeLightCount; ++i) {
             if (lightIdx == MAX_LIGHTS)
                 break;
+            const LightSource &lightSource = m_lightSources[activeLightIndices[i]];
             const Entity *lightEntity = lightSource.entity;
             const Matrix4x4 lightWorldTransform = *(lightEntity->worldTransform());
             const Vector3D worldPos = lightWorldTransform * Vector3D(0.0f, 0.0f, 0.0f);
@@ -1457,7 +1449,7 @@ void RenderView::setShaderAndUniforms(RenderCommand *command, ParameterInfoList
                             UniformValue(qMax((environmentLight ? 0 : 1), lightIdx)));
 
         // If no active light sources and no environment light, add a default light
-        if (activeLightSources.empty() && !environmentLight) {
+        if (activeLightCount == 0 && !environmentLight) {
             // Note: implicit conversion of values to UniformValue
             setUniformValue(command->m_parameterPack, LIGHT_POSITION_NAMES[0],
                     Vector3D(10.0f, 10.0f, 0.0f));
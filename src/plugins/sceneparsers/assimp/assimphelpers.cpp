@@ -39,8 +39,12 @@
 
 #include "assimphelpers.h"
 
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
 #include <QtCore/QFileDevice>
 #include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
 #include <QtCore/QUrl>
 #include <QtCore/QDir>
 #include <QtCore/QDebug>
@@ -209,12 +213,35 @@ Assimp::IOStream *AssimpIOSystem::Open(const char *pFile, const char *pMode)
 
     if (const QIODevice::OpenMode openMode = openModeFromText(cleanedMode.data())) {
         QScopedPointer<QFile> file(new QFile(fileName));
-        if (file->open(openMode))
+        if (file->open(openMode)) {
+            if (openMode & QIODevice::ReadOnly)
+                recordOpenedFile(fileName);
             return new AssimpIOStream(file.take());
+        }
     }
     return nullptr;
 }
 
+/*!
+ * Returns the files opened for reading so far, each listed once with its
+ * size and modification time when it was first opened.
+ */
+QList<SceneDependency> AssimpIOSystem::openedFiles() const
+{
+    return m_openedFiles;
+}
+
+void AssimpIOSystem::recordOpenedFile(const QString &fileName)
+{
+    const QFileInfo info(fileName);
+    const QString path = info.absoluteFilePath();
+    for (const SceneDependency &dependency : qAsConst(m_openedFiles)) {
+        if (dependency.path == path)
+            return;
+    }
+    m_openedFiles.push_back({ path, info.size(), info.lastModified().toMSecsSinceEpoch() });
+}
+
 /*!
  * Closes the Assimp::IOStream \a pFile.
  */
@@ -224,6 +251,254 @@ void AssimpIOSystem::Close(Assimp::IOStream *pFile)
     delete pFile;
 }
 
+namespace {
+
+const char *const SceneCacheDirVariable = "QT3D_ASSIMP_CACHE_DIR";
+constexpr quint32 SceneCacheMagic = 0x51334143; // "Q3AC"
+// To be increased whenever the format or the conversion of scenes change
+constexpr quint32 SceneCacheVersion = 2;
+
+quint32 floatCount(const MeshData &mesh)
+{
+    return 6 + (mesh.hasTangents ? 3 : 0) + (mesh.hasTextureCoordinates ? 2 : 0) + (mesh.hasColors ? 4 : 0);
+}
+
+quint32 morphFloatCount(const MeshData &mesh)
+{
+    return ((mesh.morphAttributes & MeshData::MorphPositions) ? 3 : 0)
+            + ((mesh.morphAttributes & MeshData::MorphNormals) ? 3 : 0)
+            + ((mesh.morphAttributes & MeshData::MorphTangents) ? 3 : 0)
+            + ((mesh.morphAttributes & MeshData::MorphTextureCoordinates) ? 2 : 0)
+            + ((mesh.morphAttributes & MeshData::MorphColors) ? 4 : 0);
+}
+
+// Checks that a scene read from the cache can be turned into nodes safely
+bool isValid(const SceneData &scene)
+{
+    if (scene.nodes.isEmpty())
+        return false;
+
+    for (int i = 0, m = scene.nodes.size(); i < m; ++i) {
+        const NodeData &node = scene.nodes.at(i);
+        for (quint32 mesh : node.meshes) {
+            if (mesh >= quint32(scene.meshes.size()))
+                return false;
+        }
+        // Children follow their parent, which also rules out cycles
+        for (qint32 child : node.children) {
+            if (child <= i || child >= m)
+                return false;
+        }
+        if (node.camera >= scene.cameras.size())
+            return false;
+    }
+
+    for (const MeshData &mesh : scene.meshes) {
+        if (mesh.materialIndex >= quint32(scene.materials.size()))
+            return false;
+        if (quint64(mesh.vertexData.size()) != quint64(mesh.vertexCount) * floatCount(mesh) * sizeof(float))
+            return false;
+        if (quint64(mesh.indexData.size()) != quint64(mesh.indexCount) * (mesh.hasUIntIndices ? 4 : 2))
+            return false;
+        for (const QByteArray &target : mesh.morphTargets) {
+            if (quint64(target.size()) != quint64(mesh.vertexCount) * morphFloatCount(mesh) * sizeof(float))
+                return false;
+        }
+    }
+    return true;
+}
+
+// Checks that the files read along with a cached scene didn't change since
+bool isUpToDate(const QList<SceneDependency> &dependencies)
+{
+    for (const SceneDependency &dependency : dependencies) {
+        const QFileInfo info(dependency.path);
+        if (!info.exists() || info.size() != dependency.size
+                || info.lastModified().toMSecsSinceEpoch() != dependency.lastModified)
+            return false;
+    }
+    return true;
+}
+
+} // anonymous
+
+static QDataStream &operator<<(QDataStream &stream, const SceneDependency &dependency)
+{
+    return stream << dependency.path << dependency.size << dependency.lastModified;
+}
+
+static QDataStream &operator>>(QDataStream &stream, SceneDependency &dependency)
+{
+    return stream >> dependency.path >> dependency.size >> dependency.lastModified;
+}
+
+static QDataStream &operator<<(QDataStream &stream, const MeshData &mesh)
+{
+    return stream << mesh.name << mesh.materialIndex << mesh.vertexCount
+                  << mesh.hasTangents << mesh.hasTextureCoordinates << mesh.hasColors
+                  << mesh.vertexData << mesh.hasUIntIndices << mesh.indexCount << mesh.indexData
+                  << mesh.morphAttributes << mesh.morphTargets;
+}
+
+static QDataStream &operator>>(QDataStream &stream, MeshData &mesh)
+{
+    return stream >> mesh.name >> mesh.materialIndex >> mesh.vertexCount
+                  >> mesh.hasTangents >> mesh.hasTextureCoordinates >> mesh.hasColors
+                  >> mesh.vertexData >> mesh.hasUIntIndices >> mesh.indexCount >> mesh.indexData
+                  >> mesh.morphAttributes >> mesh.morphTargets;
+}
+
+static QDataStream &operator<<(QDataStream &stream, const TextureData &texture)
+{
+    return stream << texture.parameterName << texture.path << texture.wrapModeX << texture.wrapModeY;
+}
+
+static QDataStream &operator>>(QDataStream &stream, TextureData &texture)
+{
+    return stream >> texture.parameterName >> texture.path >> texture.wrapModeX >> texture.wrapModeY;
+}
+
+static QDataStream &operator<<(QDataStream &stream, const MaterialData &material)
+{
+    return stream << material.name << material.type << material.parameters << material.textures;
+}
+
+static QDataStream &operator>>(QDataStream &stream, MaterialData &material)
+{
+    return stream >> material.name >> material.type >> material.parameters >> material.textures;
+}
+
+static QDataStream &operator<<(QDataStream &stream, const CameraData &camera)
+{
+    return stream << camera.name << camera.horizontalFieldOfView << camera.aspectRatio
+                  << camera.nearPlane << camera.farPlane << camera.transform;
+}
+
+static QDataStream &operator>>(QDataStream &stream, CameraData &camera)
+{
+    return stream >> camera.name >> camera.horizontalFieldOfView >> camera.aspectRatio
+                  >> camera.nearPlane >> camera.farPlane >> camera.transform;
+}
+
+static QDataStream &operator<<(QDataStream &stream, const NodeData &node)
+{
+    return stream << node.name << node.transform << node.meshes << node.children << node.camera;
+}
+
+static QDataStream &operator>>(QDataStream &stream, NodeData &node)
+{
+    return stream >> node.name >> node.transform >> node.meshes >> node.children >> node.camera;
+}
+
+/*!
+ *  \class Qt3DRender::AssimpHelper::SceneCache
+ *
+ *  \internal
+ *
+ *  \brief Stores scenes converted by the Assimp importer on disk, so that
+ *  importing them again doesn't need Assimp.
+ *
+ *  The cache is enabled by setting the QT3D_ASSIMP_CACHE_DIR environment
+ *  variable to the directory holding it. Entries are keyed by the content of
+ *  the scene, the absolute path of its file and the import options. Since
+ *  other files are found relative to the scene, the same content read from
+ *  different directories gets different entries. Other files Assimp read the
+ *  scene from, such as the materials of OBJ files, are stored in the entry
+ *  along with their size and modification time: the entry is ignored once
+ *  any of them changed.
+ */
+
+/*!
+ *  Returns \c true when the cache directory is set.
+ */
+bool SceneCache::isEnabled()
+{
+    return qEnvironmentVariableIsSet(SceneCacheDirVariable);
+}
+
+/*!
+ *  Returns the key of the scene read from \a source imported with
+ *  \a options, or an empty key when \a source couldn't be read. The
+ *  \a sourcePath of scenes read from files is part of the key.
+ */
+QByteArray SceneCache::key(QIODevice *source, const QByteArray &options, const QString &sourcePath)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(options);
+    if (!sourcePath.isEmpty())
+        hash.addData(QFileInfo(sourcePath).absoluteFilePath().toUtf8());
+    if (!hash.addData(source))
+        return QByteArray();
+    return hash.result().toHex();
+}
+
+QString SceneCache::filePath(const QByteArray &key)
+{
+    const QDir dir(qEnvironmentVariable(SceneCacheDirVariable));
+    return dir.absoluteFilePath(QString::fromLatin1(key) + QLatin1String(".qt3dassimp"));
+}
+
+/*!
+ *  Loads the scene cached for \a key into \a scene. Returns \c false when
+ *  it isn't cached, its entry is invalid or one of the files it was read
+ *  from changed.
+ */
+bool SceneCache::load(const QByteArray &key, SceneData &scene)
+{
+    QFile file(filePath(key));
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (magic != SceneCacheMagic || version != SceneCacheVersion)
+        return false;
+
+    QList<SceneDependency> dependencies;
+    stream >> dependencies;
+    if (stream.status() == QDataStream::Ok && !isUpToDate(dependencies))
+        return false;
+
+    SceneData cachedScene;
+    stream >> cachedScene.nodes >> cachedScene.meshes >> cachedScene.materials >> cachedScene.cameras;
+    if (stream.status() != QDataStream::Ok || !isValid(cachedScene)) {
+        qWarning() << Q_FUNC_INFO << "Ignoring invalid cache entry" << file.fileName();
+        return false;
+    }
+
+    scene = std::move(cachedScene);
+    return true;
+}
+
+/*!
+ *  Stores \a scene in the cache under \a key, along with the \a dependencies
+ *  it was read from besides the source of the key.
+ */
+void SceneCache::save(const QByteArray &key, const SceneData &scene,
+                      const QList<SceneDependency> &dependencies)
+{
+    const QString path = filePath(key);
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    // Entries are written atomically, as other processes may read them
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << Q_FUNC_INFO << "Couldn't open cache entry" << path;
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << SceneCacheMagic << SceneCacheVersion;
+    stream << dependencies;
+    stream << scene.nodes << scene.meshes << scene.materials << scene.cameras;
+    if (stream.status() != QDataStream::Ok || !file.commit())
+        qWarning() << Q_FUNC_INFO << "Couldn't write cache entry" << path;
+}
+
 } // namespace AssimpHelper
 } // namespace Qt3DRender
 
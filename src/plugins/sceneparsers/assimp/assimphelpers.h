@@ -55,6 +55,11 @@
 #include <assimp/IOStream.hpp>
 #include <assimp/IOSystem.hpp>
 #include <QtCore/QIODevice>
+#include <QtCore/QList>
+#include <QtCore/QPair>
+#include <QtCore/QString>
+#include <QtCore/QVariant>
+#include <QtGui/QMatrix4x4>
 
 QT_BEGIN_NAMESPACE
 
@@ -79,6 +84,15 @@ private:
     QIODevice *const m_device;
 };
 
+// File read by Assimp while importing a scene, as it was when read
+struct SceneDependency
+{
+    QString path;
+    qint64 size = -1;
+    // Milliseconds since the epoch
+    qint64 lastModified = 0;
+};
+
 //CUSTOM FILE IMPORTER TO HANDLE QT RESOURCES WITHIN ASSIMP
 class AssimpIOSystem : public Assimp::IOSystem
 {
@@ -87,6 +101,113 @@ public :
     char getOsSeparator() const override;
     Assimp::IOStream *Open(const char *pFile, const char *pMode) override;
     void Close(Assimp::IOStream *pFile) override;
+
+    QList<SceneDependency> openedFiles() const;
+
+private:
+    void recordOpenedFile(const QString &fileName);
+
+    QList<SceneDependency> m_openedFiles;
+};
+
+// Scene converted from an aiScene, independent from both Assimp and the Qt3D
+// nodes created from it, so that it can be built in parallel and cached
+struct MeshData
+{
+    enum MorphAttribute {
+        MorphPositions = 0x1,
+        MorphNormals = 0x2,
+        MorphTangents = 0x4,
+        MorphTextureCoordinates = 0x8,
+        MorphColors = 0x10
+    };
+
+    QString name;
+    quint32 materialIndex = 0;
+    quint32 vertexCount = 0;
+    bool hasTangents = false;
+    bool hasTextureCoordinates = false;
+    bool hasColors = false;
+    // Interleaved float positions, normals, tangents, texture coordinates
+    // and colors
+    QByteArray vertexData;
+    // 16 bit indices when they fit, 32 bit otherwise
+    bool hasUIntIndices = false;
+    quint32 indexCount = 0;
+    QByteArray indexData;
+    // Targets hold the attributes of morphAttributes, interleaved in the same
+    // order as vertexData
+    quint32 morphAttributes = 0;
+    QList<QByteArray> morphTargets;
+};
+
+struct TextureData
+{
+    QString parameterName;
+    // Relative to the directory of the scene
+    QString path;
+    qint32 wrapModeX = 0;
+    qint32 wrapModeY = 0;
+};
+
+struct MaterialData
+{
+    enum Type {
+        PhongMaterial,
+        DiffuseMapMaterial,
+        DiffuseSpecularMapMaterial
+    };
+
+    QString name;
+    qint32 type = PhongMaterial;
+    QList<QPair<QString, QVariant>> parameters;
+    QList<TextureData> textures;
+};
+
+struct CameraData
+{
+    QString name;
+    float horizontalFieldOfView = 0.0f;
+    float aspectRatio = 1.0f;
+    float nearPlane = 0.0f;
+    float farPlane = 0.0f;
+    QMatrix4x4 transform;
+};
+
+struct NodeData
+{
+    QString name;
+    QMatrix4x4 transform;
+    QList<quint32> meshes;
+    QList<qint32> children;
+    qint32 camera = -1;
+};
+
+struct SceneData
+{
+    // Depth first, starting with the root node
+    QList<NodeData> nodes;
+    QList<MeshData> meshes;
+    QList<MaterialData> materials;
+    QList<CameraData> cameras;
+};
+
+// Stores converted scenes in the directory set by QT3D_ASSIMP_CACHE_DIR,
+// keyed by the hash of the source content, of its path and of the import
+// options. The other files the scene was read from are checked when loading
+// entries
+class SceneCache
+{
+public:
+    static bool isEnabled();
+    static QByteArray key(QIODevice *source, const QByteArray &options,
+                          const QString &sourcePath = QString());
+    static bool load(const QByteArray &key, SceneData &scene);
+    static void save(const QByteArray &key, const SceneData &scene,
+                     const QList<SceneDependency> &dependencies);
+
+private:
+    static QString filePath(const QByteArray &key);
 };
 
 } // namespace AssimpHelper
@@ -61,10 +61,13 @@
 #include <Qt3DExtras/qphongmaterial.h>
 #include <Qt3DAnimation/qkeyframeanimation.h>
 #include <Qt3DAnimation/qmorphinganimation.h>
+#include <QtCore/QBuffer>
 #include <QtCore/QFileInfo>
 #include <QtGui/QColor>
+#include <QtConcurrent/qtconcurrentmap.h>
 
 #include <qmath.h>
+#include <numeric>
 
 #include <Qt3DCore/private/qabstractnodefactory_p.h>
 #include <Qt3DCore/private/qurlhelper_p.h>
@@ -129,6 +132,19 @@ const QString TANGENT_ATTRIBUTE_NAME = QAttribute::defaultTangentAttributeName()
 const QString TEXTCOORD_ATTRIBUTE_NAME = QAttribute::defaultTextureCoordinateAttributeName();
 const QString COLOR_ATTRIBUTE_NAME = QAttribute::defaultColorAttributeName();
 
+// Removes points and lines, keeping only triangles
+const int ASSIMP_REMOVED_PRIMITIVES = aiPrimitiveType_LINE | aiPrimitiveType_POINT;
+// aiProcess_Triangulate decomposes polygons with more than 3 points in triangles
+// aiProcess_SortByPType makes sure that meshes data are triangles
+const unsigned int ASSIMP_POST_PROCESS_STEPS = aiProcess_SortByPType
+        | aiProcess_Triangulate
+        | aiProcess_GenSmoothNormals
+        | aiProcess_FlipUVs;
+
+// The vertex data of aiMesh is copied as packed floats
+static_assert(sizeof(aiVector3D) == 3 * sizeof(float), "aiVector3D is expected to hold floats");
+static_assert(sizeof(aiColor4D) == 4 * sizeof(float), "aiColor4D is expected to hold floats");
+
 /*
  * Returns a QMatrix4x4 from \a matrix;
  */
@@ -148,15 +164,24 @@ inline QString aiStringToQString(const aiString &str)
     return QString::fromUtf8(str.data, int(str.length));
 }
 
-QMaterial *createBestApproachingMaterial(const aiMaterial *assimpMaterial)
+AssimpHelper::MaterialData::Type bestApproachingMaterialType(const aiMaterial *assimpMaterial)
 {
     aiString path; // unused but necessary
     const bool hasDiffuseTexture = (assimpMaterial->GetTexture(aiTextureType_DIFFUSE, 0, &path) == AI_SUCCESS);
     const bool hasSpecularTexture = (assimpMaterial->GetTexture(aiTextureType_SPECULAR, 0, &path) == AI_SUCCESS);
 
     if (hasDiffuseTexture && hasSpecularTexture)
-        return QAbstractNodeFactory::createNode<QDiffuseSpecularMapMaterial>("QDiffuseSpecularMapMaterial");
+        return AssimpHelper::MaterialData::DiffuseSpecularMapMaterial;
     if (hasDiffuseTexture)
+        return AssimpHelper::MaterialData::DiffuseMapMaterial;
+    return AssimpHelper::MaterialData::PhongMaterial;
+}
+
+QMaterial *createMaterial(int type)
+{
+    if (type == AssimpHelper::MaterialData::DiffuseSpecularMapMaterial)
+        return QAbstractNodeFactory::createNode<QDiffuseSpecularMapMaterial>("QDiffuseSpecularMapMaterial");
+    if (type == AssimpHelper::MaterialData::DiffuseMapMaterial)
         return QAbstractNodeFactory::createNode<QDiffuseMapMaterial>("QDiffuseMapMaterial");
     return QAbstractNodeFactory::createNode<QPhongMaterial>("QPhongMaterial");
 }
@@ -248,6 +273,16 @@ QAttribute *createIndexAttribute(Qt3DCore::QBuffer *buffer,
     return attribute;
 }
 
+/*
+ * Copies \a count elements of \a size floats, \a sourceStride floats apart in
+ * \a source, to \a destination where they are \a stride floats apart.
+ */
+void interleave(float *destination, uint stride, const float *source, uint sourceStride, uint size, uint count)
+{
+    for (uint i = 0; i < count; ++i)
+        memcpy(destination + i * stride, source + i * sourceStride, size * sizeof(float));
+}
+
 QTextureWrapMode::WrapMode wrapModeFromaiTextureMapMode(int mode)
 {
     switch (mode) {
@@ -431,22 +466,21 @@ bool AssimpImporter::areFileTypesSupported(const QStringList &extensions) const
  */
 Qt3DCore::QEntity *AssimpImporter::scene(const QString &id)
 {
-    // m_aiScene shouldn't be null.
-    // If it is either, the file failed to be imported or
+    // The scene data shouldn't be empty.
+    // If it is, the file failed to be imported or
     // setFilePath was not called
-    if (m_scene == nullptr || m_scene->m_aiScene == nullptr)
+    if (m_scene == nullptr || m_scene->m_data.nodes.isEmpty())
         return nullptr;
 
-    aiNode *rootNode = m_scene->m_aiScene->mRootNode;
+    int rootNode = 0;
     // if id specified, tries to find node
-    if (!id.isEmpty() &&
-            !(rootNode = rootNode->FindNode(id.toUtf8().constData()))) {
+    if (!id.isEmpty() && (rootNode = findNode(id)) < 0) {
         qCDebug(AssimpImporterLog) << Q_FUNC_INFO << " Couldn't find requested scene node";
         return nullptr;
     }
 
-    // Builds the Qt3D scene using the Assimp aiScene
-    // and the various dicts filled previously by parse
+    // Builds the Qt3D scene using the scene data converted from
+    // the Assimp aiScene by parse
     Qt3DCore::QEntity *n = node(rootNode);
     if (m_scene->m_animations.size() > 0) {
         qWarning() << "No target found for " << m_scene->m_animations.size() << " animations!";
@@ -464,11 +498,24 @@ Qt3DCore::QEntity *AssimpImporter::scene(const QString &id)
  */
 Qt3DCore::QEntity *AssimpImporter::node(const QString &id)
 {
-    if (m_scene == nullptr || m_scene->m_aiScene == nullptr)
+    if (m_scene == nullptr || m_scene->m_data.nodes.isEmpty())
         return nullptr;
-    parse();
-    aiNode *n = m_scene->m_aiScene->mRootNode->FindNode(id.toUtf8().constData());
-    return node(n);
+    const int n = findNode(id);
+    return n >= 0 ? node(n) : nullptr;
+}
+
+/*!
+ *  Returns the index of the first node named \a name in depth first order,
+ *  or -1 if there is none.
+ */
+int AssimpImporter::findNode(const QString &name) const
+{
+    const auto &nodes = m_scene->m_data.nodes;
+    for (int i = 0, m = nodes.size(); i < m; ++i) {
+        if (nodes.at(i).name == name)
+            return i;
+    }
+    return -1;
 }
 
 template <typename T>
@@ -483,18 +530,17 @@ void findAnimationsForNode(QList<T *> &animations, QList<T *> &result, const QSt
 }
 
 /*!
- * Returns a Node from an Assimp aiNode \a node.
+ * Returns a Node from the node at \a nodeIndex in the scene data.
  */
-Qt3DCore::QEntity *AssimpImporter::node(aiNode *node)
+Qt3DCore::QEntity *AssimpImporter::node(int nodeIndex)
 {
-    if (node == nullptr)
-        return nullptr;
+    const AssimpHelper::NodeData &nodeData = m_scene->m_data.nodes.at(nodeIndex);
     QEntity *entityNode = QAbstractNodeFactory::createNode<Qt3DCore::QEntity>("QEntity");
-    entityNode->setObjectName(aiStringToQString(node->mName));
+    entityNode->setObjectName(nodeData.name);
 
     // Add Meshes to the node
-    for (uint i = 0; i < node->mNumMeshes; i++) {
-        uint meshIndex = node->mMeshes[i];
+    for (int i = 0; i < nodeData.meshes.size(); i++) {
+        const uint meshIndex = nodeData.meshes.at(i);
         QGeometryRenderer *mesh = loadMesh(meshIndex);
 
         // mesh material
@@ -508,7 +554,7 @@ Qt3DCore::QEntity *AssimpImporter::node(aiNode *node)
             QList<Qt3DAnimation::QMorphingAnimation *> animations;
             findAnimationsForNode<Qt3DAnimation::QMorphingAnimation>(m_scene->m_morphAnimations,
                                                                   animations,
-                                                                  aiStringToQString(node->mName));
+                                                                  nodeData.name);
             const auto morphTargetList = morphingAnimations.at(0)->morphTargetList();
             for (Qt3DAnimation::QMorphingAnimation *anim : qAsConst(animations)) {
                 anim->setParent(entityNode);
@@ -523,11 +569,11 @@ Qt3DCore::QEntity *AssimpImporter::node(aiNode *node)
             }
             morphingAnimations[0]->deleteLater();
         } else {
-            uint materialIndex = m_scene->m_aiScene->mMeshes[meshIndex]->mMaterialIndex;
+            uint materialIndex = m_scene->m_data.meshes.at(meshIndex).materialIndex;
             material = loadMaterial(materialIndex);
         }
 
-        if (node->mNumMeshes == 1) {
+        if (nodeData.meshes.size() == 1) {
             if (material)
                 entityNode->addComponent(material);
             // mesh
@@ -547,25 +593,22 @@ Qt3DCore::QEntity *AssimpImporter::node(aiNode *node)
     }
 
     // Add Children to Node
-    for (uint i = 0; i < node->mNumChildren; i++) {
-        // this-> is necessary here otherwise
-        // it conflicts with the variable node
-        QEntity *child = this->node(node->mChildren[i]);
+    for (int childIndex : nodeData.children) {
+        QEntity *child = node(childIndex);
         // Are we sure each child are unique ???
         if (child != nullptr)
             child->setParent(entityNode);
     }
 
     // Add Transformations
-    const QMatrix4x4 qTransformMatrix = aiMatrix4x4ToQMatrix4x4(node->mTransformation);
     Qt3DCore::QTransform *transform = QAbstractNodeFactory::createNode<Qt3DCore::QTransform>("QTransform");
-    transform->setMatrix(qTransformMatrix);
+    transform->setMatrix(nodeData.transform);
     entityNode->addComponent(transform);
 
     QList<Qt3DAnimation::QKeyframeAnimation *> animations;
     findAnimationsForNode<Qt3DAnimation::QKeyframeAnimation>(m_scene->m_animations,
                                                           animations,
-                                                          aiStringToQString(node->mName));
+                                                          nodeData.name);
 
     for (Qt3DAnimation::QKeyframeAnimation *anim : qAsConst(animations)) {
         anim->setTarget(transform);
@@ -573,9 +616,10 @@ Qt3DCore::QEntity *AssimpImporter::node(aiNode *node)
     }
 
     // Add Camera
-    auto camera = loadCamera(node);
-    if (camera)
+    if (nodeData.camera >= 0) {
+        QEntity *camera = loadCamera(nodeData.camera);
         camera->setParent(entityNode);
+    }
 
     // TO DO : Add lights ....
 
@@ -585,7 +629,8 @@ Qt3DCore::QEntity *AssimpImporter::node(aiNode *node)
 /*!
  * Reads the scene file pointed by \a path and launches the parsing of
  * the scene using Assimp, after having cleaned up previously saved values
- * from eventual previous parsings.
+ * from eventual previous parsings. Scenes found in the cache are read from
+ * it instead.
  */
 void AssimpImporter::readSceneFile(const QString &path)
 {
@@ -593,30 +638,33 @@ void AssimpImporter::readSceneFile(const QString &path)
 
     m_scene = new SceneImporter();
 
-    // SET THIS TO REMOVE POINTS AND LINES -> HAVE ONLY TRIANGLES
-    m_scene->m_importer->SetPropertyInteger(AI_CONFIG_PP_SBP_REMOVE, aiPrimitiveType_LINE|aiPrimitiveType_POINT);
+    QFile file(path);
+    if (AssimpHelper::SceneCache::isEnabled() && file.open(QIODevice::ReadOnly)
+            && readCachedScene(&file, path))
+        return;
+    file.close();
+
+    m_scene->m_importer->SetPropertyInteger(AI_CONFIG_PP_SBP_REMOVE, ASSIMP_REMOVED_PRIMITIVES);
     // SET CUSTOM FILE HANDLER TO HANDLE FILE READING THROUGH QT (RESOURCES, SOCKET ...)
-    m_scene->m_importer->SetIOHandler(new AssimpHelper::AssimpIOSystem());
+    AssimpHelper::AssimpIOSystem *ioSystem = new AssimpHelper::AssimpIOSystem();
+    m_scene->m_importer->SetIOHandler(ioSystem);
 
-    // type and aiProcess_Triangulate discompose polygons with more than 3 points in triangles
-    // aiProcess_SortByPType makes sure that meshes data are triangles
     m_scene->m_aiScene = m_scene->m_importer->ReadFile(path.toUtf8().constData(),
-                                                       aiProcess_SortByPType|
-                                                       aiProcess_Triangulate|
-                                                       aiProcess_GenSmoothNormals|
-                                                       aiProcess_FlipUVs);
+                                                       ASSIMP_POST_PROCESS_STEPS);
     if (m_scene->m_aiScene == nullptr) {
         qCWarning(AssimpImporterLog) << "Assimp scene import failed" << m_scene->m_importer->GetErrorString();
         QSceneImporter::logError(QString::fromUtf8(m_scene->m_importer->GetErrorString()));
         return ;
     }
     parse();
+    cacheScene(ioSystem, path);
 }
 
 /*!
  * Reads the scene file pointed by \a path and launches the parsing of
  * the scene using Assimp, after having cleaned up previously saved values
- * from eventual previous parsings.
+ * from eventual previous parsings. Scenes found in the cache are read from
+ * it instead.
  */
 void AssimpImporter::readSceneData(const QByteArray& data, const QString &basePath)
 {
@@ -625,23 +673,64 @@ void AssimpImporter::readSceneData(const QByteArray& data, const QString &basePa
 
     m_scene = new SceneImporter();
 
-    // SET THIS TO REMOVE POINTS AND LINES -> HAVE ONLY TRIANGLES
-    m_scene->m_importer->SetPropertyInteger(AI_CONFIG_PP_SBP_REMOVE, aiPrimitiveType_LINE|aiPrimitiveType_POINT);
+    QBuffer buffer;
+    buffer.setData(data);
+    if (AssimpHelper::SceneCache::isEnabled() && buffer.open(QIODevice::ReadOnly)
+            && readCachedScene(&buffer))
+        return;
+
+    m_scene->m_importer->SetPropertyInteger(AI_CONFIG_PP_SBP_REMOVE, ASSIMP_REMOVED_PRIMITIVES);
     // SET CUSTOM FILE HANDLER TO HANDLE FILE READING THROUGH QT (RESOURCES, SOCKET ...)
-    m_scene->m_importer->SetIOHandler(new AssimpHelper::AssimpIOSystem());
+    AssimpHelper::AssimpIOSystem *ioSystem = new AssimpHelper::AssimpIOSystem();
+    m_scene->m_importer->SetIOHandler(ioSystem);
 
-    // type and aiProcess_Triangulate discompose polygons with more than 3 points in triangles
-    // aiProcess_SortByPType makes sure that meshes data are triangles
     m_scene->m_aiScene = m_scene->m_importer->ReadFileFromMemory(data.data(), data.size(),
-                                                                 aiProcess_SortByPType|
-                                                                 aiProcess_Triangulate|
-                                                                 aiProcess_GenSmoothNormals|
-                                                                 aiProcess_FlipUVs);
+                                                                 ASSIMP_POST_PROCESS_STEPS);
     if (m_scene->m_aiScene == nullptr) {
         qCWarning(AssimpImporterLog) << "Assimp scene import failed";
         return ;
     }
     parse();
+    cacheScene(ioSystem);
+}
+
+/*!
+ * Computes the cache key of the scene read from \a source, the file at
+ * \a sourcePath if any, and reads the scene from the cache. Returns \c true
+ * if it was cached.
+ */
+bool AssimpImporter::readCachedScene(QIODevice *source, const QString &sourcePath)
+{
+    const QByteArray options = QByteArray::number(ASSIMP_POST_PROCESS_STEPS) + ':'
+            + QByteArray::number(ASSIMP_REMOVED_PRIMITIVES);
+    m_scene->m_cacheKey = AssimpHelper::SceneCache::key(source, options, sourcePath);
+    if (m_scene->m_cacheKey.isEmpty()
+            || !AssimpHelper::SceneCache::load(m_scene->m_cacheKey, m_scene->m_data))
+        return false;
+
+    qCDebug(AssimpImporterLog) << "Read scene from the cache" << m_scene->m_cacheKey;
+    m_sceneParsed = true;
+    return true;
+}
+
+/*!
+ * Stores the parsed scene in the cache, unless it has animations which are
+ * only converted from the aiScene. The files \a ioSystem opened besides
+ * \a sourcePath, whose content is part of the key, are stored along with it.
+ */
+void AssimpImporter::cacheScene(const AssimpHelper::AssimpIOSystem *ioSystem, const QString &sourcePath)
+{
+    if (m_scene->m_cacheKey.isEmpty() || m_scene->m_aiScene->mNumAnimations > 0)
+        return;
+
+    const QString source = sourcePath.isEmpty() ? QString() : QFileInfo(sourcePath).absoluteFilePath();
+    QList<AssimpHelper::SceneDependency> dependencies;
+    const QList<AssimpHelper::SceneDependency> openedFiles = ioSystem->openedFiles();
+    for (const AssimpHelper::SceneDependency &file : openedFiles) {
+        if (file.path != source)
+            dependencies.push_back(file);
+    }
+    AssimpHelper::SceneCache::save(m_scene->m_cacheKey, m_scene->m_data, dependencies);
 }
 
 /*!
@@ -664,11 +753,70 @@ void AssimpImporter::parse()
         // Set parsed flags
         m_sceneParsed = !m_sceneParsed;
 
+        convertScene();
         for (uint i = 0; i < m_scene->m_aiScene->mNumAnimations; i++)
             loadAnimation(i);
     }
 }
 
+/*!
+ * Converts the Assimp aiScene to scene data. Meshes and materials, which
+ * hold most of the data, are converted in parallel.
+ */
+void AssimpImporter::convertScene()
+{
+    const aiScene *scene = m_scene->m_aiScene;
+    AssimpHelper::SceneData &data = m_scene->m_data;
+
+    data.meshes.resize(scene->mNumMeshes);
+    data.materials.resize(scene->mNumMaterials);
+    AssimpHelper::MeshData *meshes = data.meshes.data();
+    AssimpHelper::MaterialData *materials = data.materials.data();
+
+    QList<uint> indices(qMax(scene->mNumMeshes, scene->mNumMaterials));
+    std::iota(indices.begin(), indices.end(), 0U);
+    QtConcurrent::blockingMap(indices, [scene, meshes, materials] (uint i) {
+        if (i < scene->mNumMeshes)
+            meshes[i] = meshData(scene->mMeshes[i]);
+        if (i < scene->mNumMaterials)
+            materials[i] = materialData(scene->mMaterials[i]);
+    });
+
+    data.cameras.reserve(scene->mNumCameras);
+    for (uint i = 0; i < scene->mNumCameras; ++i)
+        data.cameras.append(cameraData(scene->mCameras[i]));
+
+    convertNode(scene->mRootNode);
+}
+
+/*!
+ * Appends \a node and its children to the scene data, and returns its index.
+ */
+int AssimpImporter::convertNode(const aiNode *node)
+{
+    const aiScene *scene = m_scene->m_aiScene;
+    QList<AssimpHelper::NodeData> &nodes = m_scene->m_data.nodes;
+
+    AssimpHelper::NodeData nodeData;
+    nodeData.name = aiStringToQString(node->mName);
+    nodeData.transform = aiMatrix4x4ToQMatrix4x4(node->mTransformation);
+    nodeData.meshes = QList<quint32>(node->mMeshes, node->mMeshes + node->mNumMeshes);
+    for (uint i = 0; i < scene->mNumCameras; ++i) {
+        if (scene->mCameras[i]->mName == node->mName) {
+            nodeData.camera = int(i);
+            break;
+        }
+    }
+
+    const int index = nodes.size();
+    nodes.append(nodeData);
+    for (uint i = 0; i < node->mNumChildren; i++) {
+        const int child = convertNode(node->mChildren[i]);
+        nodes[index].children.append(child);
+    }
+    return index;
+}
+
 /*!
  * Converts the provided Assimp aiMaterial identified by \a materialIndex to a
  * Qt3D material
@@ -677,9 +825,43 @@ void AssimpImporter::parse()
 QMaterial *AssimpImporter::loadMaterial(uint materialIndex)
 {
     // Generates default material based on what the assimp material contains
-    aiMaterial *assimpMaterial = m_scene->m_aiScene->mMaterials[materialIndex];
-    QMaterial *material = createBestApproachingMaterial(assimpMaterial);
+    const AssimpHelper::MaterialData &data = m_scene->m_data.materials.at(materialIndex);
+    QMaterial *material = createMaterial(data.type);
     // Material Name
+    if (!data.name.isNull())
+        material->setObjectName(data.name);
+
+    for (const auto &parameter : data.parameters)
+        setParameterValue(parameter.first, material, parameter.second);
+
+    for (const AssimpHelper::TextureData &textureData : data.textures) {
+        const QString fullPath = m_sceneDir.absoluteFilePath(textureData.path);
+        QAbstractTexture *tex = QAbstractNodeFactory::createNode<QTexture2D>("QTexture2D");
+        QTextureImage *texImage = QAbstractNodeFactory::createNode<QTextureImage>("QTextureImage");
+        texImage->setSource(QUrl::fromLocalFile(fullPath));
+        texImage->setMirrored(false);
+        tex->addTextureImage(texImage);
+
+        QTextureWrapMode wrapMode;
+        wrapMode.setX(QTextureWrapMode::WrapMode(textureData.wrapModeX));
+        wrapMode.setY(QTextureWrapMode::WrapMode(textureData.wrapModeY));
+        tex->setWrapMode(wrapMode);
+
+        qCDebug(AssimpImporterLog) << Q_FUNC_INFO << " Loaded Texture " << fullPath;
+        setParameterValue(textureData.parameterName, material, QVariant::fromValue(tex));
+    }
+
+    return material;
+}
+
+/*!
+ * Converts the Assimp aiMaterial \a assimpMaterial to material data. Safe to
+ * call from any thread.
+ */
+AssimpHelper::MaterialData AssimpImporter::materialData(const aiMaterial *assimpMaterial)
+{
+    AssimpHelper::MaterialData material;
+    material.type = bestApproachingMaterialType(assimpMaterial);
     copyMaterialName(material, assimpMaterial);
     copyMaterialColorProperties(material, assimpMaterial);
     copyMaterialBoolProperties(material, assimpMaterial);
@@ -692,12 +874,12 @@ QMaterial *AssimpImporter::loadMaterial(uint materialIndex)
 }
 
 /*!
- * Converts the Assimp aiMesh mesh identified by \a meshIndex to a QGeometryRenderer
+ * Converts the mesh data identified by \a meshIndex to a QGeometryRenderer
  * \sa QGeometryRenderer
  */
 QGeometryRenderer *AssimpImporter::loadMesh(uint meshIndex)
 {
-    aiMesh *mesh = m_scene->m_aiScene->mMeshes[meshIndex];
+    const AssimpHelper::MeshData &mesh = m_scene->m_data.meshes.at(meshIndex);
 
     QGeometryRenderer *geometryRenderer = QAbstractNodeFactory::createNode<QGeometryRenderer>("QGeometryRenderer");
     QGeometry *meshGeometry = QAbstractNodeFactory::createNode<QGeometry>("QGeometry");
@@ -712,63 +894,24 @@ QGeometryRenderer *AssimpImporter::loadMesh(uint meshIndex)
     // Primitive are always triangles with the current Assimp's configuration
 
     // Vertices and Normals always present with the current Assimp's configuration
-    aiVector3D *vertices = mesh->mVertices;
-    aiVector3D *normals = mesh->mNormals;
-    aiColor4D *colors = mesh->mColors[0];
-    // Tangents and TextureCoord not always present
-    bool hasTangent = mesh->HasTangentsAndBitangents();
-    bool hasTexture = mesh->HasTextureCoords(0);
-    bool hasColor = (colors != NULL); // NULL defined by Assimp
-    aiVector3D *tangents = hasTangent ? mesh->mTangents : nullptr;
-    aiVector3D *textureCoord = hasTexture ? mesh->mTextureCoords[0] : nullptr;
-
-    // Add values in raw float array
-    ushort chunkSize = 6 + (hasTangent ? 3 : 0) + (hasTexture ? 2 : 0) + (hasColor ? 4 : 0);
-    QByteArray bufferArray;
-    bufferArray.resize(chunkSize * mesh->mNumVertices * sizeof(float));
-    float *vbufferContent = reinterpret_cast<float*>(bufferArray.data());
-    for (uint i = 0; i < mesh->mNumVertices; i++) {
-        uint idx = i * chunkSize;
-        // position
-        vbufferContent[idx] = vertices[i].x;
-        vbufferContent[idx + 1] = vertices[i].y;
-        vbufferContent[idx + 2] = vertices[i].z;
-        // normals
-        vbufferContent[idx + 3] = normals[i].x;
-        vbufferContent[idx + 4] = normals[i].y;
-        vbufferContent[idx + 5] = normals[i].z;
-
-        if (hasTangent) {
-            vbufferContent[idx + 6] = tangents[i].x;
-            vbufferContent[idx + 7] = tangents[i].y;
-            vbufferContent[idx + 8] = tangents[i].z;
-        }
-        if (hasTexture) {
-            char offset =  (hasTangent ? 9 : 6);
-            vbufferContent[idx + offset] = textureCoord[i].x;
-            vbufferContent[idx + offset + 1] = textureCoord[i].y;
-        }
-        if (hasColor) {
-            char offset = 6 + (hasTangent ? 3 : 0) + (hasTexture ? 2 : 0);
-            vbufferContent[idx + offset] = colors[i].r;
-            vbufferContent[idx + offset + 1] = colors[i].g;
-            vbufferContent[idx + offset + 2] = colors[i].b;
-            vbufferContent[idx + offset + 3] = colors[i].a;
-        }
-    }
+    const bool hasTangent = mesh.hasTangents;
+    const bool hasTexture = mesh.hasTextureCoordinates;
+    const bool hasColor = mesh.hasColors;
+    const ushort chunkSize = 6 + (hasTangent ? 3 : 0) + (hasTexture ? 2 : 0) + (hasColor ? 4 : 0);
 
-    vertexBuffer->setData(bufferArray);
+    // Meshes used by several nodes share their data
+    vertexBuffer->setData(mesh.vertexData);
 
     // Add vertex attributes to the mesh with the right array
     QAttribute *positionAttribute = createAttribute(vertexBuffer, VERTICES_ATTRIBUTE_NAME,
                                           QAttribute::Float, 3,
-                                          mesh->mNumVertices,
+                                          mesh.vertexCount,
                                           0,
                                           chunkSize * sizeof(float));
 
     QAttribute *normalAttribute = createAttribute(vertexBuffer, NORMAL_ATTRIBUTE_NAME,
                                           QAttribute::Float, 3,
-                                          mesh->mNumVertices,
+                                          mesh.vertexCount,
                                           3 * sizeof(float),
                                           chunkSize * sizeof(float));
 
@@ -778,7 +921,7 @@ QGeometryRenderer *AssimpImporter::loadMesh(uint meshIndex)
     if (hasTangent) {
         QAttribute *tangentsAttribute = createAttribute(vertexBuffer, TANGENT_ATTRIBUTE_NAME,
                                               QAttribute::Float, 3,
-                                              mesh->mNumVertices,
+                                              mesh.vertexCount,
                                               6 * sizeof(float),
                                               chunkSize * sizeof(float));
         meshGeometry->addAttribute(tangentsAttribute);
@@ -787,7 +930,7 @@ QGeometryRenderer *AssimpImporter::loadMesh(uint meshIndex)
     if (hasTexture) {
         QAttribute *textureCoordAttribute = createAttribute(vertexBuffer, TEXTCOORD_ATTRIBUTE_NAME,
                                               QAttribute::Float, 2,
-                                              mesh->mNumVertices,
+                                              mesh.vertexCount,
                                               (hasTangent ? 9 : 6) * sizeof(float),
                                               chunkSize * sizeof(float));
         meshGeometry->addAttribute(textureCoordAttribute);
@@ -796,55 +939,25 @@ QGeometryRenderer *AssimpImporter::loadMesh(uint meshIndex)
     if (hasColor) {
         QAttribute *colorAttribute = createAttribute(vertexBuffer, COLOR_ATTRIBUTE_NAME,
                                               QAttribute::Float, 4,
-                                              mesh->mNumVertices,
+                                              mesh.vertexCount,
                                               (6 + (hasTangent ? 3 : 0) + (hasTexture ? 2 : 0)) * sizeof(float),
                                               chunkSize * sizeof(float));
         meshGeometry->addAttribute(colorAttribute);
     }
 
-    QAttribute::VertexBaseType indiceType;
-    QByteArray ibufferContent;
-    uint indices = mesh->mNumFaces * 3;
-    // If there are less than 65535 indices, indices can then fit in ushort
-    // which saves video memory
-    if (indices >= USHRT_MAX) {
-        indiceType = QAttribute::UnsignedInt;
-        ibufferContent.resize(indices * sizeof(quint32));
-        for (uint i = 0; i < mesh->mNumFaces; i++) {
-            aiFace face = mesh->mFaces[i];
-            Q_ASSERT(face.mNumIndices == 3);
-            memcpy(&reinterpret_cast<quint32*>(ibufferContent.data())[i * 3], face.mIndices, 3 * sizeof(uint));
-        }
-    }
-    else {
-        indiceType = QAttribute::UnsignedShort;
-        ibufferContent.resize(indices * sizeof(quint16));
-        for (uint i = 0; i < mesh->mNumFaces; i++) {
-            aiFace face = mesh->mFaces[i];
-            Q_ASSERT(face.mNumIndices == 3);
-            for (ushort j = 0; j < face.mNumIndices; j++)
-                reinterpret_cast<quint16*>(ibufferContent.data())[i * 3 + j] = face.mIndices[j];
-        }
-    }
-
-    indexBuffer->setData(ibufferContent);
+    indexBuffer->setData(mesh.indexData);
 
     // Add indices attributes
-    QAttribute *indexAttribute = createIndexAttribute(indexBuffer, indiceType, 1, indices);
+    const QAttribute::VertexBaseType indiceType = mesh.hasUIntIndices ? QAttribute::UnsignedInt
+                                                                      : QAttribute::UnsignedShort;
+    QAttribute *indexAttribute = createIndexAttribute(indexBuffer, indiceType, 1, mesh.indexCount);
     indexAttribute->setAttributeType(QAttribute::IndexAttribute);
 
     meshGeometry->addAttribute(indexAttribute);
 
-    if (mesh->mNumAnimMeshes > 0) {
-
-        aiAnimMesh *animesh = mesh->mAnimMeshes[0];
-
-        if (animesh->mNumVertices != mesh->mNumVertices)
-            return geometryRenderer;
-
+    if (!mesh.morphTargets.isEmpty()) {
         Qt3DAnimation::QMorphingAnimation *morphingAnimation
                 = new Qt3DAnimation::QMorphingAnimation(geometryRenderer);
-        QList<QString> names;
         QList<Qt3DAnimation::QMorphTarget *> targets;
         uint voff = 0;
         uint noff = 0;
@@ -852,123 +965,201 @@ QGeometryRenderer *AssimpImporter::loadMesh(uint meshIndex)
         uint texoff = 0;
         uint coloff = 0;
         uint offset = 0;
-        if (animesh->mVertices) {
-            names.push_back(VERTICES_ATTRIBUTE_NAME);
+        if (mesh.morphAttributes & AssimpHelper::MeshData::MorphPositions)
             offset += 3;
-        }
-        if (animesh->mNormals) {
-            names.push_back(NORMAL_ATTRIBUTE_NAME);
+        if (mesh.morphAttributes & AssimpHelper::MeshData::MorphNormals) {
             noff = offset;
             offset += 3;
         }
-        if (animesh->mTangents) {
-            names.push_back(TANGENT_ATTRIBUTE_NAME);
+        if (mesh.morphAttributes & AssimpHelper::MeshData::MorphTangents) {
             tanoff = offset;
             offset += 3;
         }
-        if (animesh->mTextureCoords[0]) {
-            names.push_back(TEXTCOORD_ATTRIBUTE_NAME);
+        if (mesh.morphAttributes & AssimpHelper::MeshData::MorphTextureCoordinates) {
             texoff = offset;
             offset += 2;
         }
-        if (animesh->mColors[0]) {
-            names.push_back(COLOR_ATTRIBUTE_NAME);
+        if (mesh.morphAttributes & AssimpHelper::MeshData::MorphColors) {
             coloff = offset;
+            offset += 4;
         }
+        const uint clumpSize = offset;
 
-        ushort clumpSize = (animesh->mVertices ? 3 : 0)
-                            + (animesh->mNormals ? 3 : 0)
-                            + (animesh->mTangents ? 3 : 0)
-                            + (animesh->mColors[0] ? 4 : 0)
-                            + (animesh->mTextureCoords[0] ? 2 : 0);
-
-
-        for (uint i = 0; i < mesh->mNumAnimMeshes; i++) {
-            aiAnimMesh *animesh = mesh->mAnimMeshes[i];
+        for (const QByteArray &targetBufferArray : mesh.morphTargets) {
             Qt3DAnimation::QMorphTarget *target = new Qt3DAnimation::QMorphTarget(geometryRenderer);
             targets.push_back(target);
             QList<QAttribute *> attributes;
-            QByteArray targetBufferArray;
-            targetBufferArray.resize(clumpSize * mesh->mNumVertices * sizeof(float));
-            float *dst = reinterpret_cast<float *>(targetBufferArray.data());
-
-            for (uint j = 0; j < mesh->mNumVertices; j++) {
-                if (animesh->mVertices) {
-                    *dst++ = animesh->mVertices[j].x;
-                    *dst++ = animesh->mVertices[j].y;
-                    *dst++ = animesh->mVertices[j].z;
-                }
-                if (animesh->mNormals) {
-                    *dst++ = animesh->mNormals[j].x;
-                    *dst++ = animesh->mNormals[j].y;
-                    *dst++ = animesh->mNormals[j].z;
-                }
-                if (animesh->mTangents) {
-                    *dst++ = animesh->mTangents[j].x;
-                    *dst++ = animesh->mTangents[j].y;
-                    *dst++ = animesh->mTangents[j].z;
-                }
-                if (animesh->mTextureCoords[0]) {
-                    *dst++ = animesh->mTextureCoords[0][j].x;
-                    *dst++ = animesh->mTextureCoords[0][j].y;
-                }
-                if (animesh->mColors[0]) {
-                    *dst++ = animesh->mColors[0][j].r;
-                    *dst++ = animesh->mColors[0][j].g;
-                    *dst++ = animesh->mColors[0][j].b;
-                    *dst++ = animesh->mColors[0][j].a;
-                }
-            }
 
             Qt3DCore::QBuffer *targetBuffer
                     = QAbstractNodeFactory::createNode<Qt3DCore::QBuffer>("QBuffer");
             targetBuffer->setData(targetBufferArray);
             targetBuffer->setParent(meshGeometry);
 
-            if (animesh->mVertices) {
+            if (mesh.morphAttributes & AssimpHelper::MeshData::MorphPositions) {
                 attributes.push_back(createAttribute(targetBuffer, VERTICES_ATTRIBUTE_NAME,
                                                      QAttribute::Float, 3,
-                                                     animesh->mNumVertices, voff * sizeof(float),
+                                                     mesh.vertexCount, voff * sizeof(float),
                                                      clumpSize * sizeof(float), meshGeometry));
             }
-            if (animesh->mNormals) {
+            if (mesh.morphAttributes & AssimpHelper::MeshData::MorphNormals) {
                 attributes.push_back(createAttribute(targetBuffer, NORMAL_ATTRIBUTE_NAME,
                                                      QAttribute::Float, 3,
-                                                     animesh->mNumVertices, noff * sizeof(float),
+                                                     mesh.vertexCount, noff * sizeof(float),
                                                      clumpSize * sizeof(float), meshGeometry));
             }
-            if (animesh->mTangents) {
+            if (mesh.morphAttributes & AssimpHelper::MeshData::MorphTangents) {
                 attributes.push_back(createAttribute(targetBuffer, TANGENT_ATTRIBUTE_NAME,
                                                      QAttribute::Float, 3,
-                                                     animesh->mNumVertices, tanoff * sizeof(float),
+                                                     mesh.vertexCount, tanoff * sizeof(float),
                                                      clumpSize * sizeof(float), meshGeometry));
             }
-            if (animesh->mTextureCoords[0]) {
+            if (mesh.morphAttributes & AssimpHelper::MeshData::MorphTextureCoordinates) {
                 attributes.push_back(createAttribute(targetBuffer, TEXTCOORD_ATTRIBUTE_NAME,
                                                      QAttribute::Float, 2,
-                                                     animesh->mNumVertices, texoff * sizeof(float),
+                                                     mesh.vertexCount, texoff * sizeof(float),
                                                      clumpSize * sizeof(float), meshGeometry));
             }
-            if (animesh->mColors[0]) {
+            if (mesh.morphAttributes & AssimpHelper::MeshData::MorphColors) {
                 attributes.push_back(createAttribute(targetBuffer, COLOR_ATTRIBUTE_NAME,
                                                      QAttribute::Float, 4,
-                                                     animesh->mNumVertices, coloff * sizeof(float),
+                                                     mesh.vertexCount, coloff * sizeof(float),
                                                      clumpSize * sizeof(float), meshGeometry));
             }
             target->setAttributes(attributes);
         }
         morphingAnimation->setMorphTargets(targets);
-        morphingAnimation->setTargetName(aiStringToQString(mesh->mName));
+        morphingAnimation->setTargetName(mesh.name);
         morphingAnimation->setTarget(geometryRenderer);
     }
 
-    qCDebug(AssimpImporterLog) << Q_FUNC_INFO << " Mesh " << aiStringToQString(mesh->mName)
-                               << " Vertices " << mesh->mNumVertices << " Faces "
-                               << mesh->mNumFaces << " Indices " << indices;
+    qCDebug(AssimpImporterLog) << Q_FUNC_INFO << " Mesh " << mesh.name
+                               << " Vertices " << mesh.vertexCount << " Faces "
+                               << mesh.indexCount / 3 << " Indices " << mesh.indexCount;
 
     return geometryRenderer;
 }
 
+/*!
+ * Converts the Assimp aiMesh \a mesh to mesh data. Safe to call from any
+ * thread.
+ */
+AssimpHelper::MeshData AssimpImporter::meshData(const aiMesh *mesh)
+{
+    AssimpHelper::MeshData data;
+    data.name = aiStringToQString(mesh->mName);
+    data.materialIndex = mesh->mMaterialIndex;
+    data.vertexCount = mesh->mNumVertices;
+
+    // Vertices and Normals always present with the current Assimp's configuration
+    const aiColor4D *colors = mesh->mColors[0];
+    // Tangents and TextureCoord not always present
+    data.hasTangents = mesh->HasTangentsAndBitangents();
+    data.hasTextureCoordinates = mesh->HasTextureCoords(0);
+    data.hasColors = (colors != NULL); // NULL defined by Assimp
+
+    // Add values in raw float array, one attribute at a time
+    const uint chunkSize = 6 + (data.hasTangents ? 3 : 0) + (data.hasTextureCoordinates ? 2 : 0)
+            + (data.hasColors ? 4 : 0);
+    data.vertexData.resize(chunkSize * mesh->mNumVertices * sizeof(float));
+    float *vbufferContent = reinterpret_cast<float *>(data.vertexData.data());
+    interleave(vbufferContent, chunkSize, &mesh->mVertices[0].x, 3, 3, mesh->mNumVertices);
+    interleave(vbufferContent + 3, chunkSize, &mesh->mNormals[0].x, 3, 3, mesh->mNumVertices);
+    uint offset = 6;
+    if (data.hasTangents) {
+        interleave(vbufferContent + offset, chunkSize, &mesh->mTangents[0].x, 3, 3, mesh->mNumVertices);
+        offset += 3;
+    }
+    if (data.hasTextureCoordinates) {
+        interleave(vbufferContent + offset, chunkSize, &mesh->mTextureCoords[0][0].x, 3, 2, mesh->mNumVertices);
+        offset += 2;
+    }
+    if (data.hasColors)
+        interleave(vbufferContent + offset, chunkSize, &colors[0].r, 4, 4, mesh->mNumVertices);
+
+    data.indexCount = mesh->mNumFaces * 3;
+    // If there are less than 65535 indices, indices can then fit in ushort
+    // which saves video memory
+    data.hasUIntIndices = data.indexCount >= USHRT_MAX;
+    if (data.hasUIntIndices) {
+        data.indexData.resize(data.indexCount * sizeof(quint32));
+        quint32 *indices = reinterpret_cast<quint32 *>(data.indexData.data());
+        for (uint i = 0; i < mesh->mNumFaces; i++) {
+            const aiFace &face = mesh->mFaces[i];
+            Q_ASSERT(face.mNumIndices == 3);
+            memcpy(&indices[i * 3], face.mIndices, 3 * sizeof(uint));
+        }
+    } else {
+        data.indexData.resize(data.indexCount * sizeof(quint16));
+        quint16 *indices = reinterpret_cast<quint16 *>(data.indexData.data());
+        for (uint i = 0; i < mesh->mNumFaces; i++) {
+            const aiFace &face = mesh->mFaces[i];
+            Q_ASSERT(face.mNumIndices == 3);
+            for (ushort j = 0; j < face.mNumIndices; j++)
+                indices[i * 3 + j] = face.mIndices[j];
+        }
+    }
+
+    if (mesh->mNumAnimMeshes == 0 || mesh->mAnimMeshes[0]->mNumVertices != mesh->mNumVertices)
+        return data;
+
+    // All targets use the attributes of the first one
+    const aiAnimMesh *firstAnimMesh = mesh->mAnimMeshes[0];
+    if (firstAnimMesh->mVertices)
+        data.morphAttributes |= AssimpHelper::MeshData::MorphPositions;
+    if (firstAnimMesh->mNormals)
+        data.morphAttributes |= AssimpHelper::MeshData::MorphNormals;
+    if (firstAnimMesh->mTangents)
+        data.morphAttributes |= AssimpHelper::MeshData::MorphTangents;
+    if (firstAnimMesh->mTextureCoords[0])
+        data.morphAttributes |= AssimpHelper::MeshData::MorphTextureCoordinates;
+    if (firstAnimMesh->mColors[0])
+        data.morphAttributes |= AssimpHelper::MeshData::MorphColors;
+
+    const uint clumpSize = (firstAnimMesh->mVertices ? 3 : 0)
+            + (firstAnimMesh->mNormals ? 3 : 0)
+            + (firstAnimMesh->mTangents ? 3 : 0)
+            + (firstAnimMesh->mTextureCoords[0] ? 2 : 0)
+            + (firstAnimMesh->mColors[0] ? 4 : 0);
+
+    data.morphTargets.reserve(mesh->mNumAnimMeshes);
+    for (uint i = 0; i < mesh->mNumAnimMeshes; i++) {
+        const aiAnimMesh *animesh = mesh->mAnimMeshes[i];
+        // Attributes missing from a target are left zeroed
+        QByteArray targetBufferArray(clumpSize * mesh->mNumVertices * sizeof(float), '\0');
+        float *dst = reinterpret_cast<float *>(targetBufferArray.data());
+        const uint count = qMin(animesh->mNumVertices, mesh->mNumVertices);
+
+        offset = 0;
+        if (data.morphAttributes & AssimpHelper::MeshData::MorphPositions) {
+            if (animesh->mVertices)
+                interleave(dst + offset, clumpSize, &animesh->mVertices[0].x, 3, 3, count);
+            offset += 3;
+        }
+        if (data.morphAttributes & AssimpHelper::MeshData::MorphNormals) {
+            if (animesh->mNormals)
+                interleave(dst + offset, clumpSize, &animesh->mNormals[0].x, 3, 3, count);
+            offset += 3;
+        }
+        if (data.morphAttributes & AssimpHelper::MeshData::MorphTangents) {
+            if (animesh->mTangents)
+                interleave(dst + offset, clumpSize, &animesh->mTangents[0].x, 3, 3, count);
+            offset += 3;
+        }
+        if (data.morphAttributes & AssimpHelper::MeshData::MorphTextureCoordinates) {
+            if (animesh->mTextureCoords[0])
+                interleave(dst + offset, clumpSize, &animesh->mTextureCoords[0][0].x, 3, 2, count);
+            offset += 2;
+        }
+        if (data.morphAttributes & AssimpHelper::MeshData::MorphColors) {
+            if (animesh->mColors[0])
+                interleave(dst + offset, clumpSize, &animesh->mColors[0][0].r, 4, 4, count);
+        }
+        data.morphTargets.append(targetBufferArray);
+    }
+
+    return data;
+}
+
 /*!
  * Converts the provided Assimp aiTexture at \a textureIndex to a Texture
  * \sa Texture
@@ -1011,44 +1202,46 @@ QAbstractLight *AssimpImporter::loadLight(uint lightIndex)
 }
 
 /*!
- * Converts the provided Assimp aiCamera in a node to a camera entity
+ * Converts the camera data at \a cameraIndex to a camera entity
  */
-Qt3DCore::QEntity *AssimpImporter::loadCamera(aiNode *node)
+Qt3DCore::QEntity *AssimpImporter::loadCamera(int cameraIndex)
 {
-    aiCamera *assimpCamera = nullptr;
-
-    for (uint i = 0; i < m_scene->m_aiScene->mNumCameras; ++i) {
-        auto camera = m_scene->m_aiScene->mCameras[i];
-        if (camera->mName == node->mName) {
-            assimpCamera = camera;
-            break;
-        }
-    }
-
-    if (assimpCamera == nullptr)
-        return nullptr;
+    const AssimpHelper::CameraData &cameraData = m_scene->m_data.cameras.at(cameraIndex);
 
     QEntity *camera = QAbstractNodeFactory::createNode<Qt3DCore::QEntity>("QEntity");
     QCameraLens *lens = QAbstractNodeFactory::createNode<QCameraLens>("QCameraLens");
 
-    lens->setObjectName(aiStringToQString(assimpCamera->mName));
-    lens->setPerspectiveProjection(qRadiansToDegrees(assimpCamera->mHorizontalFOV),
-                                   qMax(assimpCamera->mAspect, 1.0f),
-                                   assimpCamera->mClipPlaneNear,
-                                   assimpCamera->mClipPlaneFar);
+    lens->setObjectName(cameraData.name);
+    lens->setPerspectiveProjection(cameraData.horizontalFieldOfView,
+                                   cameraData.aspectRatio,
+                                   cameraData.nearPlane,
+                                   cameraData.farPlane);
     camera->addComponent(lens);
 
-    QMatrix4x4 m;
-    m.lookAt(QVector3D(assimpCamera->mPosition.x, assimpCamera->mPosition.y, assimpCamera->mPosition.z),
-             QVector3D(assimpCamera->mLookAt.x, assimpCamera->mLookAt.y, assimpCamera->mLookAt.z),
-             QVector3D(assimpCamera->mUp.x, assimpCamera->mUp.y, assimpCamera->mUp.z));
     Qt3DCore::QTransform *transform = QAbstractNodeFactory::createNode<Qt3DCore::QTransform>("QTransform");
-    transform->setMatrix(m);
+    transform->setMatrix(cameraData.transform);
     camera->addComponent(transform);
 
     return camera;
 }
 
+/*!
+ * Converts the Assimp aiCamera \a assimpCamera to camera data
+ */
+AssimpHelper::CameraData AssimpImporter::cameraData(const aiCamera *assimpCamera)
+{
+    AssimpHelper::CameraData camera;
+    camera.name = aiStringToQString(assimpCamera->mName);
+    camera.horizontalFieldOfView = qRadiansToDegrees(assimpCamera->mHorizontalFOV);
+    camera.aspectRatio = qMax(assimpCamera->mAspect, 1.0f);
+    camera.nearPlane = assimpCamera->mClipPlaneNear;
+    camera.farPlane = assimpCamera->mClipPlaneFar;
+    camera.transform.lookAt(QVector3D(assimpCamera->mPosition.x, assimpCamera->mPosition.y, assimpCamera->mPosition.z),
+                            QVector3D(assimpCamera->mLookAt.x, assimpCamera->mLookAt.y, assimpCamera->mLookAt.z),
+                            QVector3D(assimpCamera->mUp.x, assimpCamera->mUp.y, assimpCamera->mUp.z));
+    return camera;
+}
+
 int findTimeIndex(const QList<float> &times, float time) {
     for (int i = 0; i < times.size(); i++) {
         if (qFuzzyCompare(times[i], time))
@@ -1191,52 +1384,53 @@ void AssimpImporter::loadAnimation(uint animationIndex)
 }
 
 /*!
- *  Sets the object name of \a material to the name of \a assimpMaterial.
+ *  Sets the name of \a material to the name of \a assimpMaterial.
  */
-void AssimpImporter::copyMaterialName(QMaterial *material, aiMaterial *assimpMaterial)
+void AssimpImporter::copyMaterialName(AssimpHelper::MaterialData &material, const aiMaterial *assimpMaterial)
 {
     aiString name;
     if (assimpMaterial->Get(AI_MATKEY_NAME, name) == aiReturn_SUCCESS) {
         // May not be necessary
         // Kept for debug purposes at the moment
-        material->setObjectName(aiStringToQString(name));
-        qCDebug(AssimpImporterLog) << Q_FUNC_INFO << "Assimp Material " << material->objectName();
+        material.name = aiStringToQString(name);
+        qCDebug(AssimpImporterLog) << Q_FUNC_INFO << "Assimp Material " << material.name;
     }
 }
 
 /*!
  *  Fills \a material color properties with \a assimpMaterial color properties.
  */
-void AssimpImporter::copyMaterialColorProperties(QMaterial *material, aiMaterial *assimpMaterial)
+void AssimpImporter::copyMaterialColorProperties(AssimpHelper::MaterialData &material, const aiMaterial *assimpMaterial)
 {
+    auto &parameters = material.parameters;
     aiColor3D color;
     if (assimpMaterial->Get(AI_MATKEY_COLOR_DIFFUSE, color) == aiReturn_SUCCESS)
-        setParameterValue(ASSIMP_MATERIAL_DIFFUSE_COLOR, material, QColor::fromRgbF(color.r, color.g, color.b));
+        parameters.append({ ASSIMP_MATERIAL_DIFFUSE_COLOR, QColor::fromRgbF(color.r, color.g, color.b) });
     if (assimpMaterial->Get(AI_MATKEY_COLOR_SPECULAR, color) == aiReturn_SUCCESS)
-        setParameterValue(ASSIMP_MATERIAL_SPECULAR_COLOR, material, QColor::fromRgbF(color.r, color.g, color.b));
+        parameters.append({ ASSIMP_MATERIAL_SPECULAR_COLOR, QColor::fromRgbF(color.r, color.g, color.b) });
     if (assimpMaterial->Get(AI_MATKEY_COLOR_AMBIENT, color) == aiReturn_SUCCESS)
-        setParameterValue(ASSIMP_MATERIAL_AMBIENT_COLOR, material, QColor::fromRgbF(color.r, color.g, color.b));
+        parameters.append({ ASSIMP_MATERIAL_AMBIENT_COLOR, QColor::fromRgbF(color.r, color.g, color.b) });
     if (assimpMaterial->Get(AI_MATKEY_COLOR_EMISSIVE, color) == aiReturn_SUCCESS)
-        setParameterValue(ASSIMP_MATERIAL_EMISSIVE_COLOR, material, QColor::fromRgbF(color.r, color.g, color.b));
+        parameters.append({ ASSIMP_MATERIAL_EMISSIVE_COLOR, QColor::fromRgbF(color.r, color.g, color.b) });
     if (assimpMaterial->Get(AI_MATKEY_COLOR_TRANSPARENT, color) == aiReturn_SUCCESS)
-        setParameterValue(ASSIMP_MATERIAL_TRANSPARENT_COLOR, material, QColor::fromRgbF(color.r, color.g, color.b));
+        parameters.append({ ASSIMP_MATERIAL_TRANSPARENT_COLOR, QColor::fromRgbF(color.r, color.g, color.b) });
     if (assimpMaterial->Get(AI_MATKEY_COLOR_REFLECTIVE, color) == aiReturn_SUCCESS)
-        setParameterValue(ASSIMP_MATERIAL_REFLECTIVE_COLOR, material, QColor::fromRgbF(color.r, color.g, color.b));
+        parameters.append({ ASSIMP_MATERIAL_REFLECTIVE_COLOR, QColor::fromRgbF(color.r, color.g, color.b) });
 }
 
 /*!
  * Retrieves a \a material bool property.
  */
-void AssimpImporter::copyMaterialBoolProperties(QMaterial *material, aiMaterial *assimpMaterial)
+void AssimpImporter::copyMaterialBoolProperties(AssimpHelper::MaterialData &material, const aiMaterial *assimpMaterial)
 {
     int value;
     if (assimpMaterial->Get(AI_MATKEY_TWOSIDED, value) == aiReturn_SUCCESS)
-        setParameterValue(ASSIMP_MATERIAL_IS_TWOSIDED, material, (value == 0) ? false : true);
+        material.parameters.append({ ASSIMP_MATERIAL_IS_TWOSIDED, (value == 0) ? false : true });
     if (assimpMaterial->Get(AI_MATKEY_ENABLE_WIREFRAME, value) == aiReturn_SUCCESS)
-        setParameterValue(ASSIMP_MATERIAL_IS_WIREFRAME, material, (value == 0) ? false : true);
+        material.parameters.append({ ASSIMP_MATERIAL_IS_WIREFRAME, (value == 0) ? false : true });
 }
 
-void AssimpImporter::copyMaterialShadingModel(QMaterial *material, aiMaterial *assimpMaterial)
+void AssimpImporter::copyMaterialShadingModel(AssimpHelper::MaterialData &material, const aiMaterial *assimpMaterial)
 {
     Q_UNUSED(material);
     Q_UNUSED(assimpMaterial);
@@ -1247,7 +1441,7 @@ void AssimpImporter::copyMaterialShadingModel(QMaterial *material, aiMaterial *a
     //    AssimpIO::assimpMaterialAttributesMap[AI_MATKEY_BLEND_FUNC] = &AssimpIO::getMaterialBlendingFunction;
 }
 
-void AssimpImporter::copyMaterialBlendingFunction(QMaterial *material, aiMaterial *assimpMaterial)
+void AssimpImporter::copyMaterialBlendingFunction(AssimpHelper::MaterialData &material, const aiMaterial *assimpMaterial)
 {
     Q_UNUSED(material);
     Q_UNUSED(assimpMaterial);
@@ -1257,60 +1451,42 @@ void AssimpImporter::copyMaterialBlendingFunction(QMaterial *material, aiMateria
 /*!
  *
  */
-void AssimpImporter::copyMaterialTextures(QMaterial *material, aiMaterial *assimpMaterial)
+void AssimpImporter::copyMaterialTextures(AssimpHelper::MaterialData &material, const aiMaterial *assimpMaterial)
 {
-    static const aiTextureType textureType[] = {aiTextureType_AMBIENT,
-                                                aiTextureType_DIFFUSE,
-                                                aiTextureType_DISPLACEMENT,
-                                                aiTextureType_EMISSIVE,
-                                                aiTextureType_HEIGHT,
-                                                aiTextureType_LIGHTMAP,
-                                                aiTextureType_NORMALS,
-                                                aiTextureType_OPACITY,
-                                                aiTextureType_REFLECTION,
-                                                aiTextureType_SHININESS,
-                                                aiTextureType_SPECULAR};
-
-    if (m_scene->m_textureToParameterName.isEmpty()) {
-        m_scene->m_textureToParameterName.insert(aiTextureType_AMBIENT, ASSIMP_MATERIAL_AMBIENT_TEXTURE);
-        m_scene->m_textureToParameterName.insert(aiTextureType_DIFFUSE, ASSIMP_MATERIAL_DIFFUSE_TEXTURE);
-        m_scene->m_textureToParameterName.insert(aiTextureType_DISPLACEMENT, ASSIMP_MATERIAL_DISPLACEMENT_TEXTURE);
-        m_scene->m_textureToParameterName.insert(aiTextureType_EMISSIVE, ASSIMP_MATERIAL_EMISSIVE_TEXTURE);
-        m_scene->m_textureToParameterName.insert(aiTextureType_HEIGHT, ASSIMP_MATERIAL_HEIGHT_TEXTURE);
-        m_scene->m_textureToParameterName.insert(aiTextureType_LIGHTMAP, ASSIMP_MATERIAL_LIGHTMAP_TEXTURE);
-        m_scene->m_textureToParameterName.insert(aiTextureType_NORMALS, ASSIMP_MATERIAL_NORMALS_TEXTURE);
-        m_scene->m_textureToParameterName.insert(aiTextureType_OPACITY, ASSIMP_MATERIAL_OPACITY_TEXTURE);
-        m_scene->m_textureToParameterName.insert(aiTextureType_REFLECTION, ASSIMP_MATERIAL_REFLECTION_TEXTURE);
-        m_scene->m_textureToParameterName.insert(aiTextureType_SHININESS, ASSIMP_MATERIAL_SHININESS_TEXTURE);
-        m_scene->m_textureToParameterName.insert(aiTextureType_SPECULAR, ASSIMP_MATERIAL_SPECULAR_TEXTURE);
-    }
+    static const QPair<aiTextureType, QString> textureTypes[] = {
+        { aiTextureType_AMBIENT, ASSIMP_MATERIAL_AMBIENT_TEXTURE },
+        { aiTextureType_DIFFUSE, ASSIMP_MATERIAL_DIFFUSE_TEXTURE },
+        { aiTextureType_DISPLACEMENT, ASSIMP_MATERIAL_DISPLACEMENT_TEXTURE },
+        { aiTextureType_EMISSIVE, ASSIMP_MATERIAL_EMISSIVE_TEXTURE },
+        { aiTextureType_HEIGHT, ASSIMP_MATERIAL_HEIGHT_TEXTURE },
+        { aiTextureType_LIGHTMAP, ASSIMP_MATERIAL_LIGHTMAP_TEXTURE },
+        { aiTextureType_NORMALS, ASSIMP_MATERIAL_NORMALS_TEXTURE },
+        { aiTextureType_OPACITY, ASSIMP_MATERIAL_OPACITY_TEXTURE },
+        { aiTextureType_REFLECTION, ASSIMP_MATERIAL_REFLECTION_TEXTURE },
+        { aiTextureType_SHININESS, ASSIMP_MATERIAL_SHININESS_TEXTURE },
+        { aiTextureType_SPECULAR, ASSIMP_MATERIAL_SPECULAR_TEXTURE }
+    };
 
-    for (unsigned int i = 0; i < sizeof(textureType)/sizeof(textureType[0]); i++) {
+    for (const auto &textureType : textureTypes) {
         aiString path;
-        if (assimpMaterial->GetTexture(textureType[i], 0, &path) == AI_SUCCESS) {
-            const QString fullPath = m_sceneDir.absoluteFilePath(texturePath(path));
-            // Load texture if not already loaded
-            QAbstractTexture *tex = QAbstractNodeFactory::createNode<QTexture2D>("QTexture2D");
-            QTextureImage *texImage = QAbstractNodeFactory::createNode<QTextureImage>("QTextureImage");
-            texImage->setSource(QUrl::fromLocalFile(fullPath));
-            texImage->setMirrored(false);
-            tex->addTextureImage(texImage);
+        if (assimpMaterial->GetTexture(textureType.first, 0, &path) == AI_SUCCESS) {
+            AssimpHelper::TextureData texture;
+            texture.parameterName = textureType.second;
+            // Resolved against the scene directory when the texture is created
+            texture.path = texturePath(path);
 
             // Set proper wrapping mode
-            QTextureWrapMode wrapMode(QTextureWrapMode::Repeat);
+            texture.wrapModeX = QTextureWrapMode::Repeat;
+            texture.wrapModeY = QTextureWrapMode::Repeat;
             int xMode = 0;
             int yMode = 0;
 
-            if (assimpMaterial->Get(AI_MATKEY_MAPPINGMODE_U(textureType[i], 0), xMode) == aiReturn_SUCCESS)
-                wrapMode.setX(wrapModeFromaiTextureMapMode(xMode));
-            if (assimpMaterial->Get(AI_MATKEY_MAPPINGMODE_V(textureType[i], 0), yMode) == aiReturn_SUCCESS)
-                wrapMode.setY(wrapModeFromaiTextureMapMode(yMode));
-
-            tex->setWrapMode(wrapMode);
+            if (assimpMaterial->Get(AI_MATKEY_MAPPINGMODE_U(textureType.first, 0), xMode) == aiReturn_SUCCESS)
+                texture.wrapModeX = wrapModeFromaiTextureMapMode(xMode);
+            if (assimpMaterial->Get(AI_MATKEY_MAPPINGMODE_V(textureType.first, 0), yMode) == aiReturn_SUCCESS)
+                texture.wrapModeY = wrapModeFromaiTextureMapMode(yMode);
 
-            qCDebug(AssimpImporterLog) << Q_FUNC_INFO << " Loaded Texture " << fullPath;
-            setParameterValue(m_scene->m_textureToParameterName[textureType[i]],
-                    material, QVariant::fromValue(tex));
+            material.textures.append(texture);
         }
     }
 }
@@ -1318,19 +1494,20 @@ void AssimpImporter::copyMaterialTextures(QMaterial *material, aiMaterial *assim
 /*!
  * Retrieves a \a material float property.
  */
-void AssimpImporter::copyMaterialFloatProperties(QMaterial *material, aiMaterial *assimpMaterial)
+void AssimpImporter::copyMaterialFloatProperties(AssimpHelper::MaterialData &material, const aiMaterial *assimpMaterial)
 {
+    auto &parameters = material.parameters;
     float value = 0;
     if (assimpMaterial->Get(AI_MATKEY_OPACITY, value) == aiReturn_SUCCESS)
-        setParameterValue(ASSIMP_MATERIAL_OPACITY, material, value);
+        parameters.append({ ASSIMP_MATERIAL_OPACITY, value });
     if (assimpMaterial->Get(AI_MATKEY_SHININESS, value) == aiReturn_SUCCESS)
-        setParameterValue(ASSIMP_MATERIAL_SHININESS, material, value);
+        parameters.append({ ASSIMP_MATERIAL_SHININESS, value });
     if (assimpMaterial->Get(AI_MATKEY_SHININESS_STRENGTH, value) == aiReturn_SUCCESS)
-        setParameterValue(ASSIMP_MATERIAL_SHININESS_STRENGTH, material, value);
+        parameters.append({ ASSIMP_MATERIAL_SHININESS_STRENGTH, value });
     if (assimpMaterial->Get(AI_MATKEY_REFRACTI, value) == aiReturn_SUCCESS)
-        setParameterValue(ASSIMP_MATERIAL_REFRACTI, material, value);
+        parameters.append({ ASSIMP_MATERIAL_REFRACTI, value });
     if (assimpMaterial->Get(AI_MATKEY_REFLECTIVITY, value) == aiReturn_SUCCESS)
-        setParameterValue(ASSIMP_MATERIAL_REFLECTIVITY, material, value);
+        parameters.append({ ASSIMP_MATERIAL_REFLECTIVITY, value });
 }
 
 AssimpRawTextureImage::AssimpRawTextureImage(QNode *parent)
@@ -106,28 +106,37 @@ private:
     static bool areAssimpExtensions(const QStringList &extensions);
     static QStringList assimpSupportedFormats();
 
-    Qt3DCore::QEntity *node(aiNode *node);
+    Qt3DCore::QEntity *node(int nodeIndex);
+    int findNode(const QString &name) const;
 
     void readSceneFile(const QString &file);
     void readSceneData(const QByteArray& data, const QString &basePath);
+    bool readCachedScene(QIODevice *source, const QString &sourcePath = QString());
+    void cacheScene(const AssimpHelper::AssimpIOSystem *ioSystem, const QString &sourcePath = QString());
 
     void cleanup();
     void parse();
 
+    void convertScene();
+    int convertNode(const aiNode *node);
+    static AssimpHelper::MeshData meshData(const aiMesh *mesh);
+    static AssimpHelper::MaterialData materialData(const aiMaterial *assimpMaterial);
+    static AssimpHelper::CameraData cameraData(const aiCamera *assimpCamera);
+
     QMaterial *loadMaterial(uint materialIndex);
     QGeometryRenderer *loadMesh(uint meshIndex);
     QAbstractTexture *loadEmbeddedTexture(uint textureIndex);
     QAbstractLight *loadLight(uint lightIndex);
-    Qt3DCore::QEntity *loadCamera(aiNode *node);
+    Qt3DCore::QEntity *loadCamera(int cameraIndex);
     void loadAnimation(uint animationIndex);
 
-    void copyMaterialName(QMaterial *material, aiMaterial *assimpMaterial);
-    void copyMaterialColorProperties(QMaterial *material, aiMaterial *assimpMaterial);
-    void copyMaterialFloatProperties(QMaterial *material, aiMaterial *assimpMaterial);
-    void copyMaterialBoolProperties(QMaterial *material, aiMaterial *assimpMaterial);
-    void copyMaterialShadingModel(QMaterial *material, aiMaterial *assimpMaterial);
-    void copyMaterialBlendingFunction(QMaterial *material, aiMaterial *assimpMaterial);
-    void copyMaterialTextures(QMaterial *material, aiMaterial *assimpMaterial);
+    static void copyMaterialName(AssimpHelper::MaterialData &material, const aiMaterial *assimpMaterial);
+    static void copyMaterialColorProperties(AssimpHelper::MaterialData &material, const aiMaterial *assimpMaterial);
+    static void copyMaterialFloatProperties(AssimpHelper::MaterialData &material, const aiMaterial *assimpMaterial);
+    static void copyMaterialBoolProperties(AssimpHelper::MaterialData &material, const aiMaterial *assimpMaterial);
+    static void copyMaterialShadingModel(AssimpHelper::MaterialData &material, const aiMaterial *assimpMaterial);
+    static void copyMaterialBlendingFunction(AssimpHelper::MaterialData &material, const aiMaterial *assimpMaterial);
+    static void copyMaterialTextures(AssimpHelper::MaterialData &material, const aiMaterial *assimpMaterial);
 
     class SceneImporter {
     public :
@@ -138,7 +147,10 @@ private:
         Assimp::Importer *m_importer;
         mutable const aiScene *m_aiScene;
 
-        QHash<aiTextureType, QString> m_textureToParameterName;
+        // The scene converted from m_aiScene, or read from the cache
+        AssimpHelper::SceneData m_data;
+        QByteArray m_cacheKey;
+
         QList<Qt3DAnimation::QKeyframeAnimation *> m_animations;
         QList<Qt3DAnimation::QMorphingAnimation *> m_morphAnimations;
     };
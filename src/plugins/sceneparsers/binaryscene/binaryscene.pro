@@ -0,0 +1,16 @@
+TARGET = binarysceneimport
+QT += core-private concurrent 3dcore 3dcore-private 3drender 3drender-private 3dextras
+
+HEADERS += \
+    binarysceneimporter.h
+
+SOURCES += \
+    main.cpp \
+    binarysceneimporter.cpp
+
+DISTFILES += \
+    binaryscene.json
+
+PLUGIN_TYPE = sceneparsers
+PLUGIN_CLASS_NAME = BinarySceneImportPlugin
+load(qt_plugin)
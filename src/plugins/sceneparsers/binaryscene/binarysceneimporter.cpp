@@ -0,0 +1,518 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB)
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "binarysceneimporter.h"
+
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qmetaobject.h>
+#include <QtConcurrent/qtconcurrentmap.h>
+
+#include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/qbuffer.h>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DCore/qgeometry.h>
+#include <Qt3DCore/qgeometryview.h>
+#include <Qt3DCore/qtransform.h>
+#include <Qt3DRender/qcamera.h>
+#include <Qt3DRender/qcameralens.h>
+#include <Qt3DRender/qdirectionallight.h>
+#include <Qt3DRender/qgeometryrenderer.h>
+#include <Qt3DRender/qmaterial.h>
+#include <Qt3DRender/qmesh.h>
+#include <Qt3DRender/qpointlight.h>
+#include <Qt3DRender/qspotlight.h>
+#include <Qt3DRender/qtexture.h>
+#include <Qt3DRender/qtextureimage.h>
+#include <Qt3DExtras/qdiffusemapmaterial.h>
+#include <Qt3DExtras/qdiffusespecularmapmaterial.h>
+#include <Qt3DExtras/qdiffusespecularmaterial.h>
+#include <Qt3DExtras/qgoochmaterial.h>
+#include <Qt3DExtras/qmetalroughmaterial.h>
+#include <Qt3DExtras/qmorphphongmaterial.h>
+#include <Qt3DExtras/qnormaldiffusemapalphamaterial.h>
+#include <Qt3DExtras/qnormaldiffusemapmaterial.h>
+#include <Qt3DExtras/qnormaldiffusespecularmapmaterial.h>
+#include <Qt3DExtras/qpervertexcolormaterial.h>
+#include <Qt3DExtras/qphongalphamaterial.h>
+#include <Qt3DExtras/qphongmaterial.h>
+#include <Qt3DExtras/qtexturematerial.h>
+
+#include <numeric>
+
+#include <Qt3DCore/private/qabstractnodefactory_p.h>
+#include <Qt3DCore/private/qurlhelper_p.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt3DCore;
+using namespace Qt3DExtras;
+
+namespace Qt3DRender {
+
+Q_LOGGING_CATEGORY(BinarySceneImporterLog, "Qt3D.BinarySceneImport", QtWarningMsg)
+
+namespace {
+
+const QLatin1String SCENE_FILE_SUFFIX("qt3dscene");
+
+// Creates a node when className is the class of T
+template<typename T>
+QNode *createNode(const QByteArray &className)
+{
+    if (className != T::staticMetaObject.className())
+        return nullptr;
+    // Node factories know the types by their unqualified names
+    const QByteArray type = className.mid(className.lastIndexOf(':') + 1);
+    return QAbstractNodeFactory::createNode<T>(type.constData());
+}
+
+using NodeCreator = QNode *(*)(const QByteArray &);
+
+const NodeCreator entityCreators[] = {
+    createNode<QEntity>,
+    createNode<QCamera>
+};
+
+const NodeCreator componentCreators[] = {
+    createNode<Qt3DCore::QTransform>,
+    createNode<QCameraLens>,
+    createNode<QPointLight>,
+    createNode<QDirectionalLight>,
+    createNode<QSpotLight>,
+    createNode<QGeometryRenderer>,
+    createNode<QMesh>,
+    createNode<QPhongMaterial>,
+    createNode<QPhongAlphaMaterial>,
+    createNode<QDiffuseMapMaterial>,
+    createNode<QDiffuseSpecularMapMaterial>,
+    createNode<QDiffuseSpecularMaterial>,
+    createNode<QNormalDiffuseMapMaterial>,
+    createNode<QNormalDiffuseMapAlphaMaterial>,
+    createNode<QNormalDiffuseSpecularMapMaterial>,
+    createNode<QGoochMaterial>,
+    createNode<QPerVertexColorMaterial>,
+    createNode<QMetalRoughMaterial>,
+    createNode<QMorphPhongMaterial>,
+    createNode<QTextureMaterial>
+};
+
+const NodeCreator textureCreators[] = {
+    createNode<QTexture1D>,
+    createNode<QTexture1DArray>,
+    createNode<QTexture2D>,
+    createNode<QTexture2DArray>,
+    createNode<QTexture3D>,
+    createNode<QTextureCubeMap>,
+    createNode<QTextureCubeMapArray>,
+    createNode<QTexture2DMultisample>,
+    createNode<QTexture2DMultisampleArray>,
+    createNode<QTextureRectangle>,
+    createNode<QTextureLoader>
+};
+
+template<size_t N>
+QNode *createNode(const NodeCreator (&creators)[N], const QByteArray &className)
+{
+    for (NodeCreator create : creators) {
+        if (QNode *node = create(className))
+            return node;
+    }
+    qCWarning(BinarySceneImporterLog) << "Unsupported class" << className;
+    return nullptr;
+}
+
+bool isComponentOfType(const QComponent *component, BinaryScene::ComponentRecord::Type type)
+{
+    switch (type) {
+    case BinaryScene::ComponentRecord::Transform:
+        return qobject_cast<const Qt3DCore::QTransform *>(component);
+    case BinaryScene::ComponentRecord::CameraLens:
+        return qobject_cast<const QCameraLens *>(component);
+    case BinaryScene::ComponentRecord::Light:
+        return qobject_cast<const QAbstractLight *>(component);
+    case BinaryScene::ComponentRecord::Material:
+        return qobject_cast<const QMaterial *>(component);
+    case BinaryScene::ComponentRecord::GeometryRenderer:
+        return qobject_cast<const QGeometryRenderer *>(component);
+    }
+    return false;
+}
+
+} // anonymous
+
+/*!
+    \class Qt3DRender::BinarySceneImporter
+    \inmodule Qt3DRender
+    \internal
+    \brief Loads scenes stored in the Qt3D binary scene format.
+
+    The scene description is read from a mapping of the file, and the buffer
+    contents are copied out of it in parallel without any conversion, so
+    loading is mostly bound by the time it takes to read the file.
+
+    \sa Qt3DRender::BinarySceneExporter
+*/
+
+BinarySceneImporter::BinarySceneImporter()
+    : QSceneImporter()
+{
+}
+
+BinarySceneImporter::~BinarySceneImporter()
+{
+}
+
+/*!
+    Sets the path of the file to import to \a source and reads its scene
+    description and buffers.
+*/
+void BinarySceneImporter::setSource(const QUrl &source)
+{
+    cleanup();
+
+    const QString path = QUrlHelper::urlToLocalFileOrQrc(source);
+    QFile file(path);
+    if (Q_UNLIKELY(!file.open(QIODevice::ReadOnly))) {
+        qCWarning(BinarySceneImporterLog) << "Couldn't open" << path << file.errorString();
+        return;
+    }
+
+    m_sceneDir = QFileInfo(path).dir();
+
+    const qint64 size = file.size();
+    const uchar *mapped = size > 0 ? file.map(0, size) : nullptr;
+    const bool loaded = mapped ? load(reinterpret_cast<const char *>(mapped), size)
+                               : load(file.readAll().constData(), size);
+    if (Q_UNLIKELY(!loaded))
+        qCWarning(BinarySceneImporterLog) << "Not a valid binary scene" << path;
+}
+
+/*!
+    Sets the \a basePath used to resolve the relative references of the
+    scene and reads the scene description and buffers from \a data.
+*/
+void BinarySceneImporter::setData(const QByteArray& data, const QString &basePath)
+{
+    cleanup();
+
+    m_sceneDir.setPath(basePath);
+    if (Q_UNLIKELY(!load(data.constData(), data.size())))
+        qCWarning(BinarySceneImporterLog) << "Not a valid binary scene";
+}
+
+/*!
+    Returns true if the \a extensions are supported by the binary scene
+    importer.
+*/
+bool BinarySceneImporter::areFileTypesSupported(const QStringList &extensions) const
+{
+    for (const QString &suffix : extensions) {
+        if (suffix.compare(SCENE_FILE_SUFFIX, Qt::CaseInsensitive) == 0)
+            return true;
+    }
+    return false;
+}
+
+/*!
+    Returns the entity named \a id and its children, or \c nullptr if there
+    is no such entity.
+*/
+Qt3DCore::QEntity *BinarySceneImporter::node(const QString &id)
+{
+    const int entityIndex = findEntity(id);
+    if (entityIndex < 0) {
+        qCWarning(BinarySceneImporterLog) << "Unknown node" << id;
+        return nullptr;
+    }
+    return createEntityTree(entityIndex);
+}
+
+/*!
+    Returns the root entity of the scene, or the entity named \a id when it
+    is set. Returns \c nullptr if no scene was loaded or no entity matches.
+*/
+Qt3DCore::QEntity *BinarySceneImporter::scene(const QString &id)
+{
+    if (m_description.entities.isEmpty())
+        return nullptr;
+    if (!id.isEmpty())
+        return node(id);
+    return createEntityTree(0);
+}
+
+bool BinarySceneImporter::load(const char *data, qint64 size)
+{
+    qint64 dataOffset = 0;
+    if (!BinaryScene::read(data, size, m_description, dataOffset))
+        return false;
+
+    // Copying out of the mapping reads the file from several threads
+    const QList<BinaryScene::BufferRecord> &buffers = m_description.buffers;
+    m_bufferData.resize(buffers.size());
+    QByteArray *bufferData = m_bufferData.data();
+    QList<int> indices(buffers.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    QtConcurrent::blockingMap(indices, [&buffers, bufferData, data, dataOffset] (int i) {
+        const BinaryScene::BufferRecord &buffer = buffers.at(i);
+        bufferData[i] = QByteArray(data + dataOffset + buffer.offset, qsizetype(buffer.size));
+    });
+
+    m_children.resize(m_description.entities.size());
+    for (int i = 1, m = m_description.entities.size(); i < m; ++i)
+        m_children[m_description.entities.at(i).parent].append(i);
+
+    qCDebug(BinarySceneImporterLog) << "Loaded" << m_description.entities.size() << "entities,"
+                                    << buffers.size() << "buffers";
+    return true;
+}
+
+void BinarySceneImporter::cleanup()
+{
+    m_description = BinaryScene::SceneDescription();
+    m_bufferData.clear();
+    m_children.clear();
+}
+
+int BinarySceneImporter::findEntity(const QString &name) const
+{
+    for (int i = 0, m = m_description.entities.size(); i < m; ++i) {
+        if (m_description.entities.at(i).name == name)
+            return i;
+    }
+    return -1;
+}
+
+Qt3DCore::QEntity *BinarySceneImporter::createEntityTree(int entityIndex)
+{
+    QEntity *entity = createEntity(entityIndex);
+
+    // Shared nodes are only shared within a tree, the next one gets its own
+    m_components.clear();
+    m_geometries.clear();
+    m_buffers.clear();
+    m_textures.clear();
+    return entity;
+}
+
+Qt3DCore::QEntity *BinarySceneImporter::createEntity(int entityIndex)
+{
+    const BinaryScene::EntityRecord &record = m_description.entities.at(entityIndex);
+    QNode *node = createNode(entityCreators, record.className);
+    QEntity *entity = node ? qobject_cast<QEntity *>(node) : nullptr;
+    if (!entity)
+        entity = QAbstractNodeFactory::createNode<QEntity>("QEntity");
+
+    entity->setObjectName(record.name);
+    entity->setEnabled(record.enabled);
+    setProperties(entity, record.properties);
+
+    // Cameras have their own lens and transform, which take the stored ones
+    QCamera *camera = qobject_cast<QCamera *>(entity);
+    for (qint32 componentIndex : record.components) {
+        const BinaryScene::ComponentRecord &componentRecord = m_description.components.at(componentIndex);
+        QComponent *cameraComponent = nullptr;
+        if (camera && componentRecord.type == BinaryScene::ComponentRecord::CameraLens)
+            cameraComponent = camera->lens();
+        else if (camera && componentRecord.type == BinaryScene::ComponentRecord::Transform)
+            cameraComponent = camera->transform();
+
+        if (cameraComponent) {
+            cameraComponent->setObjectName(componentRecord.name);
+            setProperties(cameraComponent, componentRecord.properties);
+        } else if (QComponent *component = this->component(componentIndex)) {
+            entity->addComponent(component);
+        }
+    }
+
+    for (int childIndex : m_children.at(entityIndex))
+        createEntity(childIndex)->setParent(entity);
+
+    return entity;
+}
+
+Qt3DCore::QComponent *BinarySceneImporter::component(int componentIndex)
+{
+    const auto it = m_components.constFind(componentIndex);
+    if (it != m_components.cend())
+        return it.value();
+
+    const BinaryScene::ComponentRecord &record = m_description.components.at(componentIndex);
+    QNode *node = createNode(componentCreators, record.className);
+    QComponent *component = qobject_cast<QComponent *>(node);
+    if (component && !isComponentOfType(component, record.type)) {
+        qCWarning(BinarySceneImporterLog) << "Unexpected component class" << record.className;
+        component = nullptr;
+    }
+    if (!component) {
+        delete node;
+        m_components.insert(componentIndex, nullptr);
+        return nullptr;
+    }
+
+    component->setObjectName(record.name);
+    QGeometryRenderer *renderer = qobject_cast<QGeometryRenderer *>(component);
+    if (renderer && record.geometry >= 0) {
+        // QGeometryView declares the properties of generic geometry renderers
+        QGeometryView *view = QAbstractNodeFactory::createNode<QGeometryView>("QGeometryView");
+        view->setGeometry(geometry(record.geometry));
+        setProperties(view, record.properties);
+        renderer->setView(view);
+    } else {
+        setProperties(component, record.properties);
+    }
+    setTextures(component, record.textures);
+
+    m_components.insert(componentIndex, component);
+    return component;
+}
+
+Qt3DCore::QGeometry *BinarySceneImporter::geometry(int geometryIndex)
+{
+    const auto it = m_geometries.constFind(geometryIndex);
+    if (it != m_geometries.cend())
+        return it.value();
+
+    const BinaryScene::GeometryRecord &record = m_description.geometries.at(geometryIndex);
+    QGeometry *geometry = QAbstractNodeFactory::createNode<QGeometry>("QGeometry");
+    geometry->setObjectName(record.name);
+
+    for (const BinaryScene::AttributeRecord &attributeRecord : record.attributes) {
+        QAttribute *attribute = QAbstractNodeFactory::createNode<QAttribute>("QAttribute");
+        attribute->setName(attributeRecord.name);
+        attribute->setAttributeType(QAttribute::AttributeType(attributeRecord.attributeType));
+        attribute->setVertexBaseType(QAttribute::VertexBaseType(attributeRecord.vertexBaseType));
+        attribute->setVertexSize(attributeRecord.vertexSize);
+        attribute->setCount(attributeRecord.count);
+        attribute->setByteStride(attributeRecord.byteStride);
+        attribute->setByteOffset(attributeRecord.byteOffset);
+        attribute->setDivisor(attributeRecord.divisor);
+        attribute->setBuffer(buffer(attributeRecord.buffer));
+        geometry->addAttribute(attribute);
+    }
+
+    m_geometries.insert(geometryIndex, geometry);
+    return geometry;
+}
+
+Qt3DCore::QBuffer *BinarySceneImporter::buffer(int bufferIndex)
+{
+    const auto it = m_buffers.constFind(bufferIndex);
+    if (it != m_buffers.cend())
+        return it.value();
+
+    const BinaryScene::BufferRecord &record = m_description.buffers.at(bufferIndex);
+    Qt3DCore::QBuffer *buffer = QAbstractNodeFactory::createNode<Qt3DCore::QBuffer>("QBuffer");
+    buffer->setUsage(Qt3DCore::QBuffer::UsageType(record.usage));
+    buffer->setData(m_bufferData.at(bufferIndex));
+
+    m_buffers.insert(bufferIndex, buffer);
+    return buffer;
+}
+
+QAbstractTexture *BinarySceneImporter::texture(int textureIndex)
+{
+    const auto it = m_textures.constFind(textureIndex);
+    if (it != m_textures.cend())
+        return it.value();
+
+    const BinaryScene::TextureRecord &record = m_description.textures.at(textureIndex);
+    QAbstractTexture *texture = qobject_cast<QAbstractTexture *>(createNode(textureCreators, record.className));
+    if (texture) {
+        texture->setObjectName(record.name);
+        setProperties(texture, record.properties);
+        texture->wrapMode()->setX(QTextureWrapMode::WrapMode(record.wrapModeX));
+        texture->wrapMode()->setY(QTextureWrapMode::WrapMode(record.wrapModeY));
+        texture->wrapMode()->setZ(QTextureWrapMode::WrapMode(record.wrapModeZ));
+
+        for (const BinaryScene::TextureImageRecord &imageRecord : record.images) {
+            QTextureImage *image = QAbstractNodeFactory::createNode<QTextureImage>("QTextureImage");
+            image->setSource(importValue(imageRecord.source).toUrl());
+            image->setMirrored(imageRecord.mirrored);
+            texture->addTextureImage(image);
+        }
+    }
+
+    m_textures.insert(textureIndex, texture);
+    return texture;
+}
+
+// Properties the object doesn't declare are ignored rather than added as
+// dynamic properties
+void BinarySceneImporter::setProperties(QObject *object, const QList<BinaryScene::Property> &properties) const
+{
+    const QMetaObject *metaObject = object->metaObject();
+    for (const BinaryScene::Property &property : properties) {
+        const int propertyIndex = metaObject->indexOfProperty(property.first.constData());
+        if (propertyIndex < 0 || !metaObject->property(propertyIndex).write(object, importValue(property.second)))
+            qCDebug(BinarySceneImporterLog) << "Couldn't set property" << property.first
+                                            << "of" << metaObject->className();
+    }
+}
+
+// Texture properties the object doesn't declare are ignored as well
+void BinarySceneImporter::setTextures(QObject *object, const QList<QPair<QByteArray, qint32>> &textures)
+{
+    const QMetaObject *metaObject = object->metaObject();
+    for (const auto &textureProperty : textures) {
+        const int propertyIndex = metaObject->indexOfProperty(textureProperty.first.constData());
+        QAbstractTexture *texture = propertyIndex >= 0 ? this->texture(textureProperty.second) : nullptr;
+        if (texture && !texture->parent())
+            texture->setParent(object);
+        if (!texture || !metaObject->property(propertyIndex).write(object, QVariant::fromValue(texture)))
+            qCDebug(BinarySceneImporterLog) << "Couldn't set texture property" << textureProperty.first
+                                            << "of" << metaObject->className();
+    }
+}
+
+// Relative URLs refer to local files relative to the scene
+QVariant BinarySceneImporter::importValue(const QVariant &value) const
+{
+    if (value.metaType().id() != QMetaType::QUrl)
+        return value;
+
+    const QUrl url = value.toUrl();
+    if (url.isEmpty() || !url.isRelative())
+        return value;
+    return QUrl::fromLocalFile(m_sceneDir.absoluteFilePath(url.path(QUrl::FullyDecoded)));
+}
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
@@ -0,0 +1,122 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB)
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef BINARYSCENEIMPORTER_H
+#define BINARYSCENEIMPORTER_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qdir.h>
+#include <QtCore/qhash.h>
+
+#include <Qt3DRender/private/binaryscene_p.h>
+#include <Qt3DRender/private/qsceneimporter_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+class QBuffer;
+class QComponent;
+class QEntity;
+class QGeometry;
+}
+
+namespace Qt3DRender {
+
+class QAbstractTexture;
+
+Q_DECLARE_LOGGING_CATEGORY(BinarySceneImporterLog)
+
+class BinarySceneImporter : public QSceneImporter
+{
+    Q_OBJECT
+
+public:
+    BinarySceneImporter();
+    ~BinarySceneImporter();
+
+    // SceneParserInterface interface
+    void setSource(const QUrl &source) final;
+    void setData(const QByteArray& data, const QString &basePath) final;
+    bool areFileTypesSupported(const QStringList &extensions) const final;
+    Qt3DCore::QEntity *node(const QString &id) final;
+    Qt3DCore::QEntity *scene(const QString &id = QString()) final;
+
+private:
+    bool load(const char *data, qint64 size);
+    void cleanup();
+    int findEntity(const QString &name) const;
+
+    Qt3DCore::QEntity *createEntityTree(int entityIndex);
+    Qt3DCore::QEntity *createEntity(int entityIndex);
+    Qt3DCore::QComponent *component(int componentIndex);
+    Qt3DCore::QGeometry *geometry(int geometryIndex);
+    Qt3DCore::QBuffer *buffer(int bufferIndex);
+    QAbstractTexture *texture(int textureIndex);
+    void setProperties(QObject *object, const QList<BinaryScene::Property> &properties) const;
+    void setTextures(QObject *object, const QList<QPair<QByteArray, qint32>> &textures);
+    QVariant importValue(const QVariant &value) const;
+
+    QDir m_sceneDir;
+    BinaryScene::SceneDescription m_description;
+    // Buffer contents copied out of the source
+    QList<QByteArray> m_bufferData;
+    QList<QList<int>> m_children;
+
+    // Nodes created for the entity tree being built, shared by its entities
+    QHash<int, Qt3DCore::QComponent *> m_components;
+    QHash<int, Qt3DCore::QGeometry *> m_geometries;
+    QHash<int, Qt3DCore::QBuffer *> m_buffers;
+    QHash<int, QAbstractTexture *> m_textures;
+};
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // BINARYSCENEIMPORTER_H
@@ -0,0 +1,16 @@
+TARGET = binarysceneexport
+QT += core-private 3dcore 3dcore-private 3drender 3drender-private
+
+HEADERS += \
+    binarysceneexporter.h
+
+SOURCES += \
+    main.cpp \
+    binarysceneexporter.cpp
+
+DISTFILES += \
+    binarysceneexport.json
+
+PLUGIN_TYPE = sceneparsers
+PLUGIN_CLASS_NAME = BinarySceneExportPlugin
+load(qt_plugin)
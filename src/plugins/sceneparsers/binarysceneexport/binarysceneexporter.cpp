@@ -0,0 +1,404 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB)
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "binarysceneexporter.h"
+
+#include <QtCore/qsavefile.h>
+#include <QtCore/qmetaobject.h>
+
+#include <algorithm>
+
+#include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/qbuffer.h>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DCore/qgeometry.h>
+#include <Qt3DCore/qgeometryview.h>
+#include <Qt3DCore/qtransform.h>
+#include <Qt3DRender/qabstractlight.h>
+#include <Qt3DRender/qabstracttexture.h>
+#include <Qt3DRender/qcamera.h>
+#include <Qt3DRender/qcameralens.h>
+#include <Qt3DRender/qgeometryrenderer.h>
+#include <Qt3DRender/qmaterial.h>
+#include <Qt3DRender/qmesh.h>
+#include <Qt3DRender/qtextureimage.h>
+#include <Qt3DRender/qtexturewrapmode.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt3DCore;
+
+namespace Qt3DRender {
+
+Q_LOGGING_CATEGORY(BinarySceneExporterLog, "Qt3D.BinarySceneExport", QtWarningMsg)
+
+namespace {
+
+const QString SCENE_FILE_SUFFIX = QStringLiteral(".qt3dscene");
+
+// Values of properties holding pointers or custom types are not stored
+bool isStorable(const QVariant &value)
+{
+    return value.isValid() && value.metaType().id() < QMetaType::User
+            && !(value.metaType().flags() & QMetaType::PointerToQObject)
+            && value.metaType().id() != QMetaType::VoidStar;
+}
+
+QAbstractTexture *textureFromValue(const QVariant &value)
+{
+    if (!(value.metaType().flags() & QMetaType::PointerToQObject))
+        return nullptr;
+    return qobject_cast<QAbstractTexture *>(value.value<QObject *>());
+}
+
+} // anonymous
+
+BinarySceneExporter::BinarySceneExporter()
+    : QSceneExporter()
+{
+}
+
+BinarySceneExporter::~BinarySceneExporter()
+{
+}
+
+/*!
+    \class Qt3DRender::BinarySceneExporter
+    \inmodule Qt3DRender
+    \internal
+    \brief Exports a 3D scene to the Qt3D binary scene format.
+
+    The binary scene format stores the entity tree with its transforms,
+    cameras, lights, materials and geometries so that it loads without
+    parsing: the buffer contents are laid out as they are uploaded and can be
+    used from a mapping of the file. Textures and meshes loaded from files
+    are stored as references, local files relative to the exported file.
+
+    Materials are stored by class and properties, so materials that are
+    only defined by their effect are not exported.
+*/
+
+/*!
+    Exports the scene to the Qt3D binary scene format.
+
+    \a sceneRoot is the root entity that will be exported.
+
+    \a outDir is the directory in which the scene file is created.
+
+    \a exportName is the base name of the created \c .qt3dscene file.
+
+    \a options is unused, the format has no export options.
+
+    Returns true if the export was carried out successfully.
+*/
+bool BinarySceneExporter::exportScene(QEntity *sceneRoot, const QString &outDir,
+                                      const QString &exportName, const QVariantHash &options)
+{
+    Q_UNUSED(options);
+
+    m_exportDir.setPath(outDir);
+    if (!m_exportDir.mkpath(QStringLiteral("."))) {
+        logError(QStringLiteral("Export directory could not be created: %1").arg(outDir));
+        return false;
+    }
+
+    exportEntity(sceneRoot, -1);
+
+    const QString fileName = m_exportDir.absoluteFilePath(exportName + SCENE_FILE_SUFFIX);
+    QSaveFile file(fileName);
+    const bool exported = file.open(QIODevice::WriteOnly)
+            && BinaryScene::write(&file, m_description, m_bufferData)
+            && file.commit();
+    if (!exported)
+        logError(QStringLiteral("Writing %1 failed: %2").arg(fileName, file.errorString()));
+    else
+        qCDebug(BinarySceneExporterLog) << "Exported" << m_description.entities.size()
+                                        << "entities to" << fileName;
+
+    clear();
+    return exported;
+}
+
+void BinarySceneExporter::exportEntity(const QEntity *entity, qint32 parent)
+{
+    const qint32 index = m_description.entities.size();
+
+    BinaryScene::EntityRecord record;
+    record.name = entity->objectName();
+    record.enabled = entity->isEnabled();
+    record.parent = parent;
+
+    // Cameras are entities which keep the view of their transform
+    if (const QCamera *camera = qobject_cast<const QCamera *>(entity)) {
+        record.className = QCamera::staticMetaObject.className();
+        record.properties.append({ QByteArrayLiteral("position"), camera->position() });
+        record.properties.append({ QByteArrayLiteral("upVector"), camera->upVector() });
+        record.properties.append({ QByteArrayLiteral("viewCenter"), camera->viewCenter() });
+    } else {
+        record.className = QEntity::staticMetaObject.className();
+    }
+
+    const auto components = entity->components();
+    for (const QComponent *component : components) {
+        const qint32 componentIndex = exportComponent(component);
+        if (componentIndex >= 0)
+            record.components.append(componentIndex);
+    }
+    m_description.entities.append(record);
+
+    const auto children = entity->children();
+    for (const QObject *child : children) {
+        if (const QEntity *childEntity = qobject_cast<const QEntity *>(child))
+            exportEntity(childEntity, index);
+    }
+}
+
+qint32 BinarySceneExporter::exportComponent(const QComponent *component)
+{
+    const auto it = m_componentIndices.constFind(component);
+    if (it != m_componentIndices.cend())
+        return it.value();
+
+    BinaryScene::ComponentRecord record;
+    record.className = component->metaObject()->className();
+    record.name = component->objectName();
+    const int firstProperty = QComponent::staticMetaObject.propertyCount();
+
+    if (const Qt3DCore::QTransform *transform = qobject_cast<const Qt3DCore::QTransform *>(component)) {
+        // The other transform properties are derived from the matrix
+        record.type = BinaryScene::ComponentRecord::Transform;
+        record.properties.append({ QByteArrayLiteral("matrix"), transform->matrix() });
+    } else if (const QCameraLens *lens = qobject_cast<const QCameraLens *>(component)) {
+        record.type = BinaryScene::ComponentRecord::CameraLens;
+        exportProperties(lens, firstProperty, -1, record.properties);
+        // Setting the matrix switches to a custom projection
+        if (lens->projectionType() != QCameraLens::CustomProjection) {
+            record.properties.erase(std::remove_if(record.properties.begin(), record.properties.end(),
+                                                   [] (const BinaryScene::Property &property) {
+                                                       return property.first == "projectionMatrix";
+                                                   }),
+                                    record.properties.end());
+        }
+    } else if (const QAbstractLight *light = qobject_cast<const QAbstractLight *>(component)) {
+        record.type = BinaryScene::ComponentRecord::Light;
+        exportProperties(light, firstProperty, -1, record.properties, &record.textures);
+    } else if (const QMaterial *material = qobject_cast<const QMaterial *>(component)) {
+        if (material->metaObject() == &QMaterial::staticMetaObject) {
+            qCDebug(BinarySceneExporterLog) << "Skipped material defined by its effect"
+                                            << material->objectName();
+            return -1;
+        }
+        record.type = BinaryScene::ComponentRecord::Material;
+        exportProperties(material, QMaterial::staticMetaObject.propertyCount(), -1,
+                         record.properties, &record.textures);
+    } else if (const QGeometryRenderer *renderer = qobject_cast<const QGeometryRenderer *>(component)) {
+        // Bounds are computed again from the geometry
+        const int firstRendererProperty = QBoundingVolume::staticMetaObject.propertyCount();
+        record.type = BinaryScene::ComponentRecord::GeometryRenderer;
+        if (qobject_cast<const QMesh *>(renderer)) {
+            // Loaded from its source again
+            exportProperties(renderer, firstRendererProperty, -1, record.properties);
+        } else {
+            // Other renderers are stored as generic ones with their geometry,
+            // which comes from the view when there is one
+            record.className = QGeometryRenderer::staticMetaObject.className();
+            const QGeometryView *view = renderer->view();
+            if (view) {
+                exportProperties(view, QNode::staticMetaObject.propertyCount(),
+                                 QGeometryView::staticMetaObject.propertyCount(), record.properties);
+            } else {
+                exportProperties(renderer, firstRendererProperty,
+                                 QGeometryRenderer::staticMetaObject.propertyCount(), record.properties);
+            }
+            const QGeometry *geometry = view ? view->geometry() : renderer->geometry();
+            if (geometry)
+                record.geometry = exportGeometry(geometry);
+        }
+    } else {
+        return -1;
+    }
+
+    const qint32 index = m_description.components.size();
+    m_description.components.append(record);
+    m_componentIndices.insert(component, index);
+    return index;
+}
+
+qint32 BinarySceneExporter::exportGeometry(const QGeometry *geometry)
+{
+    const auto it = m_geometryIndices.constFind(geometry);
+    if (it != m_geometryIndices.cend())
+        return it.value();
+
+    BinaryScene::GeometryRecord record;
+    record.name = geometry->objectName();
+
+    const auto attributes = geometry->attributes();
+    for (const QAttribute *attribute : attributes) {
+        if (!attribute->buffer())
+            continue;
+
+        BinaryScene::AttributeRecord attributeRecord;
+        attributeRecord.name = attribute->name();
+        attributeRecord.attributeType = attribute->attributeType();
+        attributeRecord.vertexBaseType = attribute->vertexBaseType();
+        attributeRecord.vertexSize = attribute->vertexSize();
+        attributeRecord.count = attribute->count();
+        attributeRecord.byteStride = attribute->byteStride();
+        attributeRecord.byteOffset = attribute->byteOffset();
+        attributeRecord.divisor = attribute->divisor();
+        attributeRecord.buffer = exportBuffer(attribute->buffer());
+        record.attributes.append(attributeRecord);
+    }
+
+    const qint32 index = m_description.geometries.size();
+    m_description.geometries.append(record);
+    m_geometryIndices.insert(geometry, index);
+    return index;
+}
+
+qint32 BinarySceneExporter::exportBuffer(const Qt3DCore::QBuffer *buffer)
+{
+    const auto it = m_bufferIndices.constFind(buffer);
+    if (it != m_bufferIndices.cend())
+        return it.value();
+
+    // Offsets and sizes are set when writing the data section
+    BinaryScene::BufferRecord record;
+    record.usage = buffer->usage();
+
+    const qint32 index = m_description.buffers.size();
+    m_description.buffers.append(record);
+    m_bufferData.append(buffer->data());
+    m_bufferIndices.insert(buffer, index);
+    return index;
+}
+
+qint32 BinarySceneExporter::exportTexture(QAbstractTexture *texture)
+{
+    const auto it = m_textureIndices.constFind(texture);
+    if (it != m_textureIndices.cend())
+        return it.value();
+
+    BinaryScene::TextureRecord record;
+    record.className = texture->metaObject()->className();
+    record.name = texture->objectName();
+    exportProperties(texture, QNode::staticMetaObject.propertyCount(), -1, record.properties);
+    record.wrapModeX = texture->wrapMode()->x();
+    record.wrapModeY = texture->wrapMode()->y();
+    record.wrapModeZ = texture->wrapMode()->z();
+
+    const auto textureImages = texture->textureImages();
+    for (QAbstractTextureImage *textureImage : textureImages) {
+        if (const QTextureImage *image = qobject_cast<const QTextureImage *>(textureImage)) {
+            BinaryScene::TextureImageRecord imageRecord;
+            imageRecord.source = exportValue(image->source()).toUrl();
+            imageRecord.mirrored = image->isMirrored();
+            record.images.append(imageRecord);
+        } else {
+            qCDebug(BinarySceneExporterLog) << "Skipped texture image"
+                                            << textureImage->metaObject()->className();
+        }
+    }
+
+    const qint32 index = m_description.textures.size();
+    m_description.textures.append(record);
+    m_textureIndices.insert(texture, index);
+    return index;
+}
+
+// Appends the writable properties of object in the [firstProperty, lastProperty)
+// range, up to the last property when lastProperty is -1. Texture properties
+// are appended to textures when it is set
+void BinarySceneExporter::exportProperties(const QObject *object, int firstProperty, int lastProperty,
+                                           QList<BinaryScene::Property> &properties,
+                                           QList<QPair<QByteArray, qint32>> *textures)
+{
+    const QMetaObject *metaObject = object->metaObject();
+    if (lastProperty < 0)
+        lastProperty = metaObject->propertyCount();
+
+    for (int i = firstProperty; i < lastProperty; ++i) {
+        const QMetaProperty property = metaObject->property(i);
+        if (!property.isWritable() || !property.isStored())
+            continue;
+
+        QVariant value = property.read(object);
+        if (QAbstractTexture *texture = textureFromValue(value)) {
+            if (textures)
+                textures->append({ QByteArray(property.name()), exportTexture(texture) });
+            continue;
+        }
+
+        // Enumerations are written back from their value
+        if (property.isEnumType() || property.isFlagType())
+            value = value.toInt();
+        if (isStorable(value))
+            properties.append({ QByteArray(property.name()), exportValue(value) });
+    }
+}
+
+// Local files are referred to relative to the exported file
+QVariant BinarySceneExporter::exportValue(const QVariant &value) const
+{
+    if (value.metaType().id() != QMetaType::QUrl)
+        return value;
+
+    const QUrl url = value.toUrl();
+    if (!url.isLocalFile())
+        return value;
+
+    QUrl relativeUrl;
+    relativeUrl.setPath(m_exportDir.relativeFilePath(url.toLocalFile()), QUrl::DecodedMode);
+    return relativeUrl;
+}
+
+void BinarySceneExporter::clear()
+{
+    m_description = BinaryScene::SceneDescription();
+    m_bufferData.clear();
+    m_componentIndices.clear();
+    m_geometryIndices.clear();
+    m_bufferIndices.clear();
+    m_textureIndices.clear();
+}
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
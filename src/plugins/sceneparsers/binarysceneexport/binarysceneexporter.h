@@ -0,0 +1,111 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB)
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef BINARYSCENEEXPORTER_H
+#define BINARYSCENEEXPORTER_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qdir.h>
+#include <QtCore/qhash.h>
+
+#include <Qt3DRender/private/binaryscene_p.h>
+#include <private/qsceneexporter_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+class QBuffer;
+class QComponent;
+class QEntity;
+class QGeometry;
+}
+
+namespace Qt3DRender {
+
+class QAbstractTexture;
+
+Q_DECLARE_LOGGING_CATEGORY(BinarySceneExporterLog)
+
+class BinarySceneExporter : public QSceneExporter
+{
+    Q_OBJECT
+
+public:
+    BinarySceneExporter();
+    ~BinarySceneExporter();
+
+    bool exportScene(Qt3DCore::QEntity *sceneRoot, const QString &outDir,
+                     const QString &exportName, const QVariantHash &options) final;
+
+private:
+    void exportEntity(const Qt3DCore::QEntity *entity, qint32 parent);
+    qint32 exportComponent(const Qt3DCore::QComponent *component);
+    qint32 exportGeometry(const Qt3DCore::QGeometry *geometry);
+    qint32 exportBuffer(const Qt3DCore::QBuffer *buffer);
+    qint32 exportTexture(QAbstractTexture *texture);
+    void exportProperties(const QObject *object, int firstProperty, int lastProperty,
+                          QList<BinaryScene::Property> &properties,
+                          QList<QPair<QByteArray, qint32>> *textures = nullptr);
+    QVariant exportValue(const QVariant &value) const;
+    void clear();
+
+    QDir m_exportDir;
+    BinaryScene::SceneDescription m_description;
+    QList<QByteArray> m_bufferData;
+    QHash<const Qt3DCore::QComponent *, qint32> m_componentIndices;
+    QHash<const Qt3DCore::QGeometry *, qint32> m_geometryIndices;
+    QHash<const Qt3DCore::QBuffer *, qint32> m_bufferIndices;
+    QHash<const QAbstractTexture *, qint32> m_textureIndices;
+};
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // BINARYSCENEEXPORTER_H
@@ -1,12 +1,14 @@
 TARGET = gltfsceneimport
-QT += core-private 3dcore 3dcore-private 3drender 3drender-private 3dextras
+QT += core-private concurrent 3dcore 3dcore-private 3drender 3drender-private 3dextras
 
 HEADERS += \
-    gltfimporter.h
+    gltfimporter.h \
+    meshoptdecoder.h
 
 SOURCES += \
     main.cpp \
-    gltfimporter.cpp
+    gltfimporter.cpp \
+    meshoptdecoder.cpp
 
 DISTFILES += \
     gltf.json
@@ -39,12 +39,19 @@
 ****************************************************************************/
 
 #include "gltfimporter.h"
+#include "meshoptdecoder.h"
 
 #include <QtCore/qdir.h>
+#include <QtCore/qendian.h>
+#include <QtCore/qfile.h>
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qjsonarray.h>
 #include <QtCore/qjsonobject.h>
 #include <QtCore/qmath.h>
+#include <QtCore/qset.h>
+
+#include <QtConcurrent/qtconcurrentmap.h>
+#include <QtConcurrent/qtconcurrentrun.h>
 
 #include <QtGui/qvector2d.h>
 
@@ -118,12 +125,17 @@
   *
   * Most of the reference samples are rendered correctly, with the following exceptions:
   *
-  * 'extensions' and 'extras' are ignored everywhere except in nodes.
+  * 'extensions' and 'extras' are ignored everywhere except in nodes, and
+  * in buffers and bufferViews for EXT_meshopt_compression. Integer vertex
+  * attributes allowed by KHR_mesh_quantization that aren't normalized are
+  * converted to floats. Normalized ones are kept as they are: QRhi has no
+  * vertex format for signed bytes, 16-bit integers and 3 components unsigned
+  * bytes, so the RHI renderer uploads these expanded into buffers of their own.
   *
   * asset
   *   generator, copyright, minVersion: not parsed
   * accessors
-  *   min, max, normalized, sparse: not parsed
+  *   min, max, sparse: not parsed
   * animations
   *   the whole object is not parsed
   * buffers
@@ -133,7 +145,7 @@
   * cameras
   *   all parsed
   * images
-  *   mimeType, bufferView, name: not parsed
+  *   mimeType, name: not parsed
   * materials
   *   emissiveTexture, emissiveFactor: not parsed
   *   alphaMode, alphaCutoff, doubleSided: not parsed
@@ -237,6 +249,12 @@
 #define KEY_NORMAL_TEX         QLatin1String("normalTexture")
 #define KEY_OCCLUSION_TEX      QLatin1String("occlusionTexture")
 #define KEY_INDEX              QLatin1String("index")
+#define KEY_NORMALIZED         QLatin1String("normalized")
+#define KEY_FILTER             QLatin1String("filter")
+#define KEY_FALLBACK           QLatin1String("fallback")
+#define KEY_MESHOPT_COMPRESSION QLatin1String("EXT_meshopt_compression")
+#define KEY_KHR_BINARY_GLTF     QLatin1String("KHR_binary_glTF")
+#define KEY_BINARY_GLTF_BUFFER  QLatin1String("binary_glTF")
 
 #define KEY_INSTANCE_TECHNIQUE  QLatin1String("instanceTechnique")
 #define KEY_INSTANCE_PROGRAM    QLatin1String("instanceProgram")
@@ -280,6 +298,21 @@ using namespace Qt3DExtras;
 
 namespace {
 
+// Binary glTF container, made of a header followed by a JSON chunk and an
+// optional binary chunk holding the buffer without uri
+constexpr quint32 GLB_MAGIC = 0x46546C67; // "glTF"
+constexpr quint32 GLB_VERSION = 2;
+constexpr qsizetype GLB_HEADER_SIZE = 12;
+constexpr qsizetype GLB_CHUNK_HEADER_SIZE = 8;
+constexpr quint32 GLB_CHUNK_JSON = 0x4E4F534A; // "JSON"
+constexpr quint32 GLB_CHUNK_BIN = 0x004E4942; // "BIN\0"
+
+// glTF 1.0 container of KHR_binary_glTF, made of a header followed by the
+// JSON content and the body of the "binary_glTF" buffer
+constexpr quint32 GLB_V1_VERSION = 1;
+constexpr qsizetype GLB_V1_HEADER_SIZE = 20;
+constexpr quint32 GLB_V1_CONTENT_FORMAT_JSON = 0;
+
 inline QVector3D jsonArrToVec3(const QJsonArray &array)
 {
     return QVector3D(array[0].toDouble(), array[1].toDouble(), array[2].toDouble());
@@ -308,6 +341,16 @@ inline QVariant vec4ToColorVariant(const QVariant &vec4Var)
     return QVariant(vec4ToQColor(vec4Var));
 }
 
+template<typename T>
+void dequantize(const char *source, int count, uint componentCount, uint stride, float *destination)
+{
+    for (int i = 0; i < count; ++i) {
+        const char *element = source + qsizetype(i) * stride;
+        for (uint c = 0; c < componentCount; ++c)
+            *destination++ = float(qFromLittleEndian<T>(element + c * sizeof(T)));
+    }
+}
+
 Qt3DRender::QFilterKey *buildFilterKey(const QString &key, const QJsonValue &val)
 {
     Qt3DRender::QFilterKey *fk = new Qt3DRender::QFilterKey;
@@ -391,7 +434,84 @@ bool GLTFImporter::setJSON(const QJsonDocument &json)
 
     m_json = json;
     m_parseDone = false;
+    m_sourceFile.reset();
+    m_sourceData.clear();
+    m_binaryChunk.clear();
+
+    return true;
+}
+
+/*!
+    Set binary glTF \a data as the file used for importing a scene. The binary
+    chunk is referenced rather than copied, so \a data must be kept alive
+    until the scene is parsed.
+    Returns true if the operation is successful.
+*/
+bool GLTFImporter::setBinaryGLTF(const QByteArray &data)
+{
+    if (!isBinaryGLTF(data))
+        return false;
+
+    const quint32 version = qFromLittleEndian<quint32>(data.constData() + 4);
+    if (version == GLB_V1_VERSION)
+        return setBinaryGLTFV1(data);
+    if (version != GLB_VERSION)
+        return false;
+
+    const qsizetype length = qMin<qsizetype>(qFromLittleEndian<quint32>(data.constData() + 8), data.size());
+    QByteArray jsonChunk;
+    QByteArray binaryChunk;
+    bool hasJsonChunk = false;
+    bool hasBinaryChunk = false;
+    qsizetype offset = GLB_HEADER_SIZE;
+    while (offset + GLB_CHUNK_HEADER_SIZE <= length) {
+        const qsizetype chunkLength = qFromLittleEndian<quint32>(data.constData() + offset);
+        const quint32 chunkType = qFromLittleEndian<quint32>(data.constData() + offset + 4);
+        offset += GLB_CHUNK_HEADER_SIZE;
+        if (chunkLength > length - offset)
+            return false;
+
+        const QByteArray chunk = QByteArray::fromRawData(data.constData() + offset, chunkLength);
+        if (chunkType == GLB_CHUNK_JSON && !hasJsonChunk) {
+            jsonChunk = chunk;
+            hasJsonChunk = true;
+        } else if (chunkType == GLB_CHUNK_BIN && !hasBinaryChunk) {
+            binaryChunk = chunk;
+            hasBinaryChunk = true;
+        }
+        // Chunks are 4 byte aligned
+        offset += (chunkLength + 3) & ~qsizetype(3);
+    }
+
+    if (!hasJsonChunk || !setJSON(qLoadGLTF(jsonChunk)))
+        return false;
 
+    m_binaryChunk = binaryChunk;
+    return true;
+}
+
+/*!
+    Sets the glTF 1.0 binary container \a data, whose body is the content of
+    the buffer named \c binary_glTF by the KHR_binary_glTF extension.
+    Returns true if the operation is successful.
+*/
+bool GLTFImporter::setBinaryGLTFV1(const QByteArray &data)
+{
+    if (data.size() < GLB_V1_HEADER_SIZE
+            || qFromLittleEndian<quint32>(data.constData() + 16) != GLB_V1_CONTENT_FORMAT_JSON)
+        return false;
+
+    const qsizetype length = qMin<qsizetype>(qFromLittleEndian<quint32>(data.constData() + 8), data.size());
+    const qsizetype contentLength = qFromLittleEndian<quint32>(data.constData() + 12);
+    if (contentLength > length - GLB_V1_HEADER_SIZE)
+        return false;
+
+    const QByteArray content = QByteArray::fromRawData(data.constData() + GLB_V1_HEADER_SIZE, contentLength);
+    if (!setJSON(qLoadGLTF(content)))
+        return false;
+
+    const qsizetype bodyOffset = GLB_V1_HEADER_SIZE + contentLength;
+    m_binaryChunk = QByteArray::fromRawData(data.constData() + bodyOffset, length - bodyOffset);
     return true;
 }
 
@@ -408,10 +528,20 @@ void GLTFImporter::setSource(const QUrl &source)
         qCWarning(GLTFImporterLog, "missing file: %ls", qUtf16PrintableImpl(path));
         return;
     }
-    QFile f(path);
-    f.open(QIODevice::ReadOnly);
 
-    if (Q_UNLIKELY(!setJSON(qLoadGLTF(f.readAll())))) {
+    // The source is mapped, binary glTF files keep it mapped until their
+    // buffer views have been copied out of the binary chunk. Sources that
+    // can't be mapped are read instead, and their content is kept alive.
+    QSharedPointer<QFile> file;
+    const QByteArray data = mapFile(path, file);
+    if (isBinaryGLTF(data)) {
+        if (Q_UNLIKELY(!setBinaryGLTF(data))) {
+            qCWarning(GLTFImporterLog, "not a valid binary glTF file");
+            return;
+        }
+        m_sourceFile = file;
+        m_sourceData = data;
+    } else if (Q_UNLIKELY(!setJSON(qLoadGLTF(data)))) {
         qCWarning(GLTFImporterLog, "not a JSON document");
         return;
     }
@@ -426,7 +556,13 @@ void GLTFImporter::setSource(const QUrl &source)
  */
 void GLTFImporter::setData(const QByteArray& data, const QString &basePath)
 {
-    if (Q_UNLIKELY(!setJSON(qLoadGLTF(data)))) {
+    if (isBinaryGLTF(data)) {
+        if (Q_UNLIKELY(!setBinaryGLTF(data))) {
+            qCWarning(GLTFImporterLog, "not a valid binary glTF file");
+            return;
+        }
+        m_sourceData = data;
+    } else if (Q_UNLIKELY(!setJSON(qLoadGLTF(data)))) {
         qCWarning(GLTFImporterLog, "not a JSON document");
         return;
     }
@@ -695,14 +831,30 @@ Qt3DCore::QEntity* GLTFImporter::scene(const QString &id)
 
 GLTFImporter::BufferData::BufferData()
     : length(0)
-    , data(nullptr)
+    , ownsData(false)
+    , isFallback(false)
 {
 }
 
 GLTFImporter::BufferData::BufferData(const QJsonObject &json)
     : length(json.value(KEY_BYTE_LENGTH).toInt()),
       path(json.value(KEY_URI).toString()),
-      data(nullptr)
+      ownsData(false),
+      isFallback(json.value(KEY_EXTENSIONS).toObject().value(KEY_MESHOPT_COMPRESSION)
+                 .toObject().value(KEY_FALLBACK).toBool())
+{
+}
+
+GLTFImporter::BufferViewData::BufferViewData()
+    : bufferOwnsData(false)
+    , offset(0)
+    , length(0)
+    , byteLength(0)
+    , stride(0)
+    , compression(NoCompression)
+    , filter(NoFilter)
+    , count(0)
+    , elementSize(0)
 {
 }
 
@@ -724,6 +876,7 @@ GLTFImporter::AccessorData::AccessorData()
     , count(0)
     , offset(0)
     , stride(0)
+    , normalized(false)
 {
 
 }
@@ -733,7 +886,8 @@ GLTFImporter::AccessorData::AccessorData(const QJsonObject &json, int major, int
       dataSize(accessorDataSizeFromJson(json.value(KEY_TYPE).toString())),
       count(json.value(KEY_COUNT).toInt()),
       offset(0),
-      stride(0)
+      stride(0),
+      normalized(json.value(KEY_NORMALIZED).toBool())
 {
     Q_UNUSED(minor);
 
@@ -755,7 +909,8 @@ bool GLTFImporter::isGLTFSupported(const QStringList &extensions)
 {
     for (auto suffix: qAsConst(extensions)) {
         suffix = suffix.toLower();
-        if (suffix == QLatin1String("json") || suffix == QLatin1String("gltf") || suffix == QLatin1String("qgltf"))
+        if (suffix == QLatin1String("json") || suffix == QLatin1String("gltf") || suffix == QLatin1String("qgltf")
+                || suffix == QLatin1String("glb"))
             return true;
     }
     return false;
@@ -766,6 +921,11 @@ bool GLTFImporter::isEmbeddedResource(const QString &url)
     return url.startsWith("data:");
 }
 
+bool GLTFImporter::isBinaryGLTF(const QByteArray &data)
+{
+    return data.size() >= GLB_HEADER_SIZE && qFromLittleEndian<quint32>(data.constData()) == GLB_MAGIC;
+}
+
 void GLTFImporter::renameFromJson(const QJsonObject &json, QObject * const object)
 {
     const auto name = json.value(KEY_NAME);
@@ -1135,10 +1295,10 @@ QMaterial *GLTFImporter::pbrMaterial(const QJsonObject &jsonObj)
                 const QJsonObject tObj = texArray.at(texObj.value(KEY_INDEX).toInt()).toObject();
                 const QString sourceId = QString::number(tObj.value(KEY_SOURCE).toInt());
                 QImage image;
-                if (m_imagePaths.contains(sourceId)) {
+                if (m_imageData.contains(sourceId)) {
+                    image = m_imageData.value(sourceId).result();
+                } else if (m_imagePaths.contains(sourceId)) {
                     image.load(m_imagePaths.value(sourceId));
-                } else if (m_imageData.contains(sourceId)) {
-                    image = m_imageData.value(sourceId);
                 } else {
                     return mrMaterial;
                 }
@@ -1348,8 +1508,14 @@ void GLTFImporter::parseV1()
     loadBufferData();
     for (auto it = views.begin(), end = views.end(); it != end; ++it)
         processJSONBufferView(it.key(), it.value().toObject());
+    loadBufferViews();
     unloadBufferData();
 
+    // Embedded images are decoded while the rest of the file is processed
+    const QJsonObject images = m_json.object().value(KEY_IMAGES).toObject();
+    for (auto it = images.begin(), end = images.end(); it != end; ++it)
+        processJSONImage(it.key(), it.value().toObject());
+
     const QJsonObject shaders = m_json.object().value(KEY_SHADERS).toObject();
     for (auto it = shaders.begin(), end = shaders.end(); it != end; ++it)
         processJSONShader(it.key(), it.value().toObject());
@@ -1366,10 +1532,6 @@ void GLTFImporter::parseV1()
     for (auto it = meshes.begin(), end = meshes.end(); it != end; ++it)
         processJSONMesh(it.key(), it.value().toObject());
 
-    const QJsonObject images = m_json.object().value(KEY_IMAGES).toObject();
-    for (auto it = images.begin(), end = images.end(); it != end; ++it)
-        processJSONImage(it.key(), it.value().toObject());
-
     const QJsonObject textures = m_json.object().value(KEY_TEXTURES).toObject();
     for (auto it = textures.begin(), end = textures.end(); it != end; ++it)
         processJSONTexture(it.key(), it.value().toObject());
@@ -1404,20 +1566,24 @@ void GLTFImporter::parseV2()
     loadBufferData();
     for (i = 0; i < views.count(); i++)
         processJSONBufferView(QString::number(i), views[i].toObject());
+    loadBufferViews();
     unloadBufferData();
 
+    // Embedded images are decoded while the rest of the file is processed
+    const QJsonArray images = m_json.object().value(KEY_IMAGES).toArray();
+    for (i = 0; i < images.count(); i++)
+        processJSONImage(QString::number(i), images[i].toObject());
+    prefetchMetalRoughImages();
+
     const QJsonArray accessors = m_json.object().value(KEY_ACCESSORS).toArray();
     for (i = 0; i < accessors.count(); i++)
         processJSONAccessor(QString::number(i), accessors[i].toObject());
+    dequantizeAccessors();
 
     const QJsonArray meshes = m_json.object().value(KEY_MESHES).toArray();
     for (i = 0; i < meshes.count(); i++)
         processJSONMesh(QString::number(i), meshes[i].toObject());
 
-    const QJsonArray images = m_json.object().value(KEY_IMAGES).toArray();
-    for (i = 0; i < images.count(); i++)
-        processJSONImage(QString::number(i), images[i].toObject());
-
     const QJsonArray textures = m_json.object().value(KEY_TEXTURES).toArray();
     for (i = 0; i < textures.count(); i++)
         processJSONTexture(QString::number(i), textures[i].toObject());
@@ -1444,8 +1610,10 @@ void GLTFImporter::cleanup()
     delete_if_without_parent(m_materialCache);
     m_materialCache.clear();
     m_bufferDatas.clear();
+    m_bufferViewDatas.clear();
     m_buffers.clear();
-    m_shaderPaths.clear();
+    m_bufferViewStrides.clear();
+    m_shaderSources.clear();
     delete_if_without_parent(m_programs);
     m_programs.clear();
     for (const auto &params : qAsConst(m_techniqueParameters))
@@ -1485,11 +1653,48 @@ void GLTFImporter::processJSONBuffer(const QString &id, const QJsonObject& json)
 
 void GLTFImporter::processJSONBufferView(const QString &id, const QJsonObject& json)
 {
+    BufferViewData view;
+    view.id = id;
+    view.byteLength = json.value(KEY_BYTE_LENGTH).toInt();
+    view.stride = json.value(KEY_BYTE_STRIDE).toInt();
+
+    // Compressed views read their content from the buffer of the extension,
+    // the one of the view being a fallback for importers lacking it
+    QJsonObject source = json;
+    const QJsonObject compression = json.value(KEY_EXTENSIONS).toObject()
+            .value(KEY_MESHOPT_COMPRESSION).toObject();
+    if (m_majorVersion > 1 && !compression.isEmpty()) {
+        const QString mode = compression.value(KEY_MODE).toString();
+        if (mode == QLatin1String("ATTRIBUTES"))
+            view.compression = BufferViewData::AttributesCompression;
+        else if (mode == QLatin1String("TRIANGLES"))
+            view.compression = BufferViewData::TrianglesCompression;
+        else if (mode == QLatin1String("INDICES"))
+            view.compression = BufferViewData::IndicesCompression;
+        else
+            qCWarning(GLTFImporterLog, "unsupported compression mode: %ls for view: %ls",
+                      qUtf16PrintableImpl(mode), qUtf16PrintableImpl(id));
+
+        if (view.compression != BufferViewData::NoCompression) {
+            source = compression;
+            view.count = compression.value(KEY_COUNT).toInt();
+            view.elementSize = compression.value(KEY_BYTE_STRIDE).toInt();
+
+            const QString filter = compression.value(KEY_FILTER).toString();
+            if (filter == QLatin1String("OCTAHEDRAL"))
+                view.filter = BufferViewData::OctahedralFilter;
+            else if (filter == QLatin1String("QUATERNION"))
+                view.filter = BufferViewData::QuaternionFilter;
+            else if (filter == QLatin1String("EXPONENTIAL"))
+                view.filter = BufferViewData::ExponentialFilter;
+        }
+    }
+
     QString bufName;
     if (m_majorVersion > 1) {
-        bufName = QString::number(json.value(KEY_BUFFER).toInt());
+        bufName = QString::number(source.value(KEY_BUFFER).toInt());
     } else {
-        bufName = json.value(KEY_BUFFER).toString();
+        bufName = source.value(KEY_BUFFER).toString();
     }
     const auto it = qAsConst(m_bufferDatas).find(bufName);
     if (Q_UNLIKELY(it == m_bufferDatas.cend())) {
@@ -1499,24 +1704,19 @@ void GLTFImporter::processJSONBufferView(const QString &id, const QJsonObject& j
     }
     const auto &bufferData = *it;
 
-    quint64 offset = 0;
-    const auto byteOffset = json.value(KEY_BYTE_OFFSET);
+    const auto byteOffset = source.value(KEY_BYTE_OFFSET);
     if (!byteOffset.isUndefined()) {
-        offset = byteOffset.toInt();
-        qCDebug(GLTFImporterLog, "bv: %ls has offset: %lld", qUtf16PrintableImpl(id), offset);
+        view.offset = byteOffset.toInt();
+        qCDebug(GLTFImporterLog, "bv: %ls has offset: %lld", qUtf16PrintableImpl(id), view.offset);
     }
 
-    quint64 len = json.value(KEY_BYTE_LENGTH).toInt();
+    view.length = source.value(KEY_BYTE_LENGTH).toInt();
+    view.bufferPath = bufferData.path;
+    view.bufferData = bufferData.data;
+    view.bufferOwnsData = bufferData.ownsData;
 
-    QByteArray bytes = bufferData.data->mid(offset, len);
-    if (Q_UNLIKELY(bytes.count() != int(len))) {
-        qCWarning(GLTFImporterLog, "failed to read sufficient bytes from: %ls for view %ls",
-                  qUtf16PrintableImpl(bufferData.path), qUtf16PrintableImpl(id));
-    }
-
-    Qt3DCore::QBuffer *b = new Qt3DCore::QBuffer();
-    b->setData(bytes);
-    m_buffers[id] = b;
+    // The content is copied or decoded by loadBufferViews
+    m_bufferViewDatas.append(view);
 }
 
 void GLTFImporter::processJSONShader(const QString &id, const QJsonObject &jsonObject)
@@ -1524,8 +1724,20 @@ void GLTFImporter::processJSONShader(const QString &id, const QJsonObject &jsonO
     // shaders are trivial for the moment, defer the real work
     // to the program section
     QString path = jsonObject.value(KEY_URI).toString();
-
-    if (!isEmbeddedResource(path)) {
+    const QJsonValue binaryView = jsonObject.value(KEY_EXTENSIONS).toObject()
+            .value(KEY_KHR_BINARY_GLTF).toObject().value(KEY_BUFFER_VIEW);
+
+    if (!binaryView.isUndefined()) {
+        // Shaders of binary glTF 1.0 files are stored in buffer views
+        const QString viewId = binaryView.toString();
+        const Qt3DCore::QBuffer *buffer = m_buffers.value(viewId, nullptr);
+        if (Q_UNLIKELY(!buffer)) {
+            qCWarning(GLTFImporterLog, "unknown buffer-view: %ls processing shader: %ls",
+                      qUtf16PrintableImpl(viewId), qUtf16PrintableImpl(id));
+            return;
+        }
+        m_shaderSources[id] = buffer->data();
+    } else if (!isEmbeddedResource(path)) {
         QFileInfo info(m_basePath, path);
         if (Q_UNLIKELY(!info.exists())) {
             qCWarning(GLTFImporterLog, "can't find shader %ls from path %ls",
@@ -1533,13 +1745,11 @@ void GLTFImporter::processJSONShader(const QString &id, const QJsonObject &jsonO
             return;
         }
 
-        m_shaderPaths[id] = info.absoluteFilePath();
+        m_shaderSources[id] = QShaderProgram::loadSource(QUrl::fromLocalFile(info.absoluteFilePath()));
     } else {
         const QByteArray base64Data = path.toLatin1().remove(0, path.indexOf(",") + 1);
-        m_shaderPaths[id] = QString(QByteArray::fromBase64(base64Data));
+        m_shaderSources[id] = QByteArray::fromBase64(base64Data);
     }
-
-
 }
 
 void GLTFImporter::processJSONProgram(const QString &id, const QJsonObject &jsonObject)
@@ -1547,10 +1757,10 @@ void GLTFImporter::processJSONProgram(const QString &id, const QJsonObject &json
     const QString fragName = jsonObject.value(KEY_FRAGMENT_SHADER).toString();
     const QString vertName = jsonObject.value(KEY_VERTEX_SHADER).toString();
 
-    const auto fragIt = qAsConst(m_shaderPaths).find(fragName);
-    const auto vertIt = qAsConst(m_shaderPaths).find(vertName);
+    const auto fragIt = qAsConst(m_shaderSources).find(fragName);
+    const auto vertIt = qAsConst(m_shaderSources).find(vertName);
 
-    if (Q_UNLIKELY(fragIt == m_shaderPaths.cend() || vertIt == m_shaderPaths.cend())) {
+    if (Q_UNLIKELY(fragIt == m_shaderSources.cend() || vertIt == m_shaderSources.cend())) {
         qCWarning(GLTFImporterLog, "program: %ls missing shader: %ls %ls",
                   qUtf16PrintableImpl(id), qUtf16PrintableImpl(fragName), qUtf16PrintableImpl(vertName));
         return;
@@ -1558,34 +1768,24 @@ void GLTFImporter::processJSONProgram(const QString &id, const QJsonObject &json
 
     QShaderProgram* prog = new QShaderProgram;
     prog->setObjectName(id);
-    prog->setFragmentShaderCode(QShaderProgram::loadSource(QUrl::fromLocalFile(fragIt.value())));
-    prog->setVertexShaderCode(QShaderProgram::loadSource(QUrl::fromLocalFile(vertIt.value())));
+    prog->setFragmentShaderCode(fragIt.value());
+    prog->setVertexShaderCode(vertIt.value());
 
     const QString tessCtrlName = jsonObject.value(KEY_TESS_CTRL_SHADER).toString();
-    if (!tessCtrlName.isEmpty()) {
-        const auto it = qAsConst(m_shaderPaths).find(tessCtrlName);
-        prog->setTessellationControlShaderCode(
-                    QShaderProgram::loadSource(QUrl::fromLocalFile(it.value())));
-    }
+    if (!tessCtrlName.isEmpty())
+        prog->setTessellationControlShaderCode(m_shaderSources.value(tessCtrlName));
 
     const QString tessEvalName = jsonObject.value(KEY_TESS_EVAL_SHADER).toString();
-    if (!tessEvalName.isEmpty()) {
-        const auto it = qAsConst(m_shaderPaths).find(tessEvalName);
-        prog->setTessellationEvaluationShaderCode(
-                    QShaderProgram::loadSource(QUrl::fromLocalFile(it.value())));
-    }
+    if (!tessEvalName.isEmpty())
+        prog->setTessellationEvaluationShaderCode(m_shaderSources.value(tessEvalName));
 
     const QString geomName = jsonObject.value(KEY_GEOMETRY_SHADER).toString();
-    if (!geomName.isEmpty()) {
-        const auto it = qAsConst(m_shaderPaths).find(geomName);
-        prog->setGeometryShaderCode(QShaderProgram::loadSource(QUrl::fromLocalFile(it.value())));
-    }
+    if (!geomName.isEmpty())
+        prog->setGeometryShaderCode(m_shaderSources.value(geomName));
 
     const QString computeName = jsonObject.value(KEY_COMPUTE_SHADER).toString();
-    if (!computeName.isEmpty()) {
-        const auto it = qAsConst(m_shaderPaths).find(computeName);
-        prog->setComputeShaderCode(QShaderProgram::loadSource(QUrl::fromLocalFile(it.value())));
-    }
+    if (!computeName.isEmpty())
+        prog->setComputeShaderCode(m_shaderSources.value(computeName));
 
     m_programs[id] = prog;
 }
@@ -1715,7 +1915,109 @@ void GLTFImporter::processJSONTechnique(const QString &id, const QJsonObject &js
 
 void GLTFImporter::processJSONAccessor(const QString &id, const QJsonObject& json)
 {
-    m_accessorDict[id] = AccessorData(json, m_majorVersion, m_minorVersion);
+    AccessorData accessor(json, m_majorVersion, m_minorVersion);
+    // glTF 2 interleaved attributes have their stride set on the buffer view
+    if (accessor.stride == 0)
+        accessor.stride = m_bufferViewStrides.value(accessor.bufferViewName);
+    m_accessorDict[id] = accessor;
+}
+
+/*!
+    Converts the vertex positions, normals, tangents and texture coordinates
+    using the integer types allowed by KHR_mesh_quantization without being
+    normalized to floats, in parallel. Renderers normalize all integer vertex
+    attributes and don't support all of these types.
+*/
+void GLTFImporter::dequantizeAccessors()
+{
+    QSet<QString> accessorIds;
+    const QJsonArray meshes = m_json.object().value(KEY_MESHES).toArray();
+    for (const QJsonValue &mesh : meshes) {
+        const QJsonArray primitives = mesh.toObject().value(KEY_PRIMITIVES).toArray();
+        for (const QJsonValue &primitive : primitives) {
+            const QJsonObject attrs = primitive.toObject().value(KEY_ATTRIBUTES).toObject();
+            for (auto it = attrs.begin(), end = attrs.end(); it != end; ++it) {
+                const QString &semantic = it.key();
+                if (semantic == QLatin1String("POSITION") || semantic == QLatin1String("NORMAL")
+                        || semantic == QLatin1String("TANGENT")
+                        || semantic.startsWith(QLatin1String("TEXCOORD_")))
+                    accessorIds.insert(QString::number(it.value().toInt()));
+            }
+        }
+    }
+
+    struct Conversion
+    {
+        QString id;
+        AccessorData accessor;
+        QByteArray source;
+        QByteArray data;
+    };
+    QList<Conversion> conversions;
+    for (const QString &id : qAsConst(accessorIds)) {
+        const auto it = qAsConst(m_accessorDict).find(id);
+        if (it == m_accessorDict.cend() || it->type == QAttribute::Float || it->normalized || it->count <= 0)
+            continue;
+        const Qt3DCore::QBuffer *buffer = m_buffers.value(it->bufferViewName, nullptr);
+        if (buffer)
+            conversions.append({ id, *it, buffer->data(), QByteArray() });
+    }
+
+    QtConcurrent::blockingMap(conversions, [] (Conversion &conversion) {
+        const AccessorData &accessor = conversion.accessor;
+        uint componentSize = 1;
+        if (accessor.type == QAttribute::Short || accessor.type == QAttribute::UnsignedShort)
+            componentSize = 2;
+        else if (accessor.type == QAttribute::UnsignedInt)
+            componentSize = 4;
+        const uint elementSize = componentSize * accessor.dataSize;
+        const uint stride = accessor.stride > 0 ? uint(accessor.stride) : elementSize;
+
+        const qsizetype end = qsizetype(accessor.offset) + qsizetype(accessor.count - 1) * stride + elementSize;
+        if (accessor.offset < 0 || end > conversion.source.size())
+            return;
+
+        conversion.data.resize(qsizetype(accessor.count) * accessor.dataSize * sizeof(float));
+        const char *source = conversion.source.constData() + accessor.offset;
+        float *destination = reinterpret_cast<float *>(conversion.data.data());
+        switch (accessor.type) {
+        case QAttribute::Byte:
+            dequantize<qint8>(source, accessor.count, accessor.dataSize, stride, destination);
+            break;
+        case QAttribute::UnsignedByte:
+            dequantize<quint8>(source, accessor.count, accessor.dataSize, stride, destination);
+            break;
+        case QAttribute::Short:
+            dequantize<qint16>(source, accessor.count, accessor.dataSize, stride, destination);
+            break;
+        case QAttribute::UnsignedShort:
+            dequantize<quint16>(source, accessor.count, accessor.dataSize, stride, destination);
+            break;
+        default:
+            dequantize<quint32>(source, accessor.count, accessor.dataSize, stride, destination);
+            break;
+        }
+    });
+
+    for (const Conversion &conversion : qAsConst(conversions)) {
+        if (Q_UNLIKELY(conversion.data.isEmpty())) {
+            qCWarning(GLTFImporterLog, "accessor %ls exceeds its buffer-view: %ls",
+                      qUtf16PrintableImpl(conversion.id),
+                      qUtf16PrintableImpl(conversion.accessor.bufferViewName));
+            continue;
+        }
+
+        const QString viewId = QLatin1String("dequantized:") + conversion.id;
+        Qt3DCore::QBuffer *b = new Qt3DCore::QBuffer();
+        b->setData(conversion.data);
+        m_buffers[viewId] = b;
+
+        AccessorData &accessor = m_accessorDict[conversion.id];
+        accessor.bufferViewName = viewId;
+        accessor.type = QAttribute::Float;
+        accessor.offset = 0;
+        accessor.stride = 0;
+    }
 }
 
 void GLTFImporter::processJSONMesh(const QString &id, const QJsonObject &json)
@@ -1883,8 +2185,24 @@ void GLTFImporter::processJSONMesh(const QString &id, const QJsonObject &json)
 void GLTFImporter::processJSONImage(const QString &id, const QJsonObject &jsonObject)
 {
     QString path = jsonObject.value(KEY_URI).toString();
-
-    if (!isEmbeddedResource(path)) {
+    const QJsonValue binaryView = jsonObject.value(KEY_EXTENSIONS).toObject()
+            .value(KEY_KHR_BINARY_GLTF).toObject().value(KEY_BUFFER_VIEW);
+    const bool inBufferView = (m_majorVersion > 1) ? path.isEmpty() && jsonObject.contains(KEY_BUFFER_VIEW)
+                                                   : !binaryView.isUndefined();
+
+    if (inBufferView) {
+        // Images of binary glTF files are stored in buffer views
+        const QString viewId = (m_majorVersion > 1)
+                ? QString::number(jsonObject.value(KEY_BUFFER_VIEW).toInt())
+                : binaryView.toString();
+        const Qt3DCore::QBuffer *buffer = m_buffers.value(viewId, nullptr);
+        if (Q_UNLIKELY(!buffer)) {
+            qCWarning(GLTFImporterLog, "unknown buffer-view: %ls processing image: %ls",
+                      qUtf16PrintableImpl(viewId), qUtf16PrintableImpl(id));
+            return;
+        }
+        m_imageData[id] = decodeImage(buffer->data());
+    } else if (!isEmbeddedResource(path)) {
         QFileInfo info(m_basePath, path);
         if (Q_UNLIKELY(!info.exists())) {
             qCWarning(GLTFImporterLog, "can't find image %ls from path %ls",
@@ -1895,9 +2213,7 @@ void GLTFImporter::processJSONImage(const QString &id, const QJsonObject &jsonOb
         m_imagePaths[id] = info.absoluteFilePath();
     } else {
         const QByteArray base64Data = path.toLatin1().remove(0, path.indexOf(",") + 1);
-        QImage image;
-        image.loadFromData(QByteArray::fromBase64(base64Data));
-        m_imageData[id] = image;
+        m_imageData[id] = decodeImage(QByteArray::fromBase64(base64Data));
     }
 }
 
@@ -1938,7 +2254,7 @@ void GLTFImporter::processJSONTexture(const QString &id, const QJsonObject &json
             return;
         }
 
-        QImage img = embImgIt.value();
+        QImage img = embImgIt.value().result();
         GLTFRawTextureImage *imageData = new GLTFRawTextureImage();
         imageData->setImage(img);
         tex->addTextureImage(imageData);
@@ -2061,11 +2377,120 @@ void GLTFImporter::processJSONRenderPass(const QString &id, const QJsonObject &j
 */
 void GLTFImporter::loadBufferData()
 {
-    for (auto &bufferData : m_bufferDatas) {
-        if (!bufferData.data) {
-            bufferData.data = new QByteArray(resolveLocalData(bufferData.path));
+    for (auto it = m_bufferDatas.begin(), end = m_bufferDatas.end(); it != end; ++it) {
+        BufferData &bufferData = it.value();
+        if (!bufferData.data.isNull() || bufferData.isFallback)
+            continue;
+
+        // The buffer without uri of a binary glTF file is its binary chunk,
+        // which glTF 1.0 files name binary_glTF
+        const bool isBinaryChunk = (m_majorVersion > 1)
+                ? bufferData.path.isEmpty()
+                : it.key() == KEY_BINARY_GLTF_BUFFER && !m_binaryChunk.isNull();
+        if (isBinaryChunk) {
+            bufferData.data = m_binaryChunk;
+            bufferData.ownsData = false;
+        } else if (isEmbeddedResource(bufferData.path)) {
+            bufferData.data = resolveLocalData(bufferData.path);
+            bufferData.ownsData = true;
+        } else {
+            // External files are mapped and only read when their views are copied
+            bufferData.data = mapFile(QDir(m_basePath).absoluteFilePath(bufferData.path), bufferData.file);
+            bufferData.ownsData = bufferData.file.isNull();
+        }
+    }
+}
+
+/*!
+    Copies the content of the buffer views out of their buffers and creates
+    their QBuffers. Views are copied in parallel, which is also where mapped
+    files get read and compressed views get decoded.
+*/
+void GLTFImporter::loadBufferViews()
+{
+    QtConcurrent::blockingMap(m_bufferViewDatas, [] (BufferViewData &view) {
+        const quint64 bufferSize = quint64(view.bufferData.size());
+        const quint64 length = view.offset < bufferSize ? qMin(view.length, bufferSize - view.offset) : 0;
+        const char *content = view.bufferData.constData() + (length ? view.offset : 0);
+
+        if (view.compression == BufferViewData::NoCompression) {
+            // Views covering a whole buffer share its content when it is owned
+            if (view.bufferOwnsData && view.offset == 0 && length == bufferSize)
+                view.data = view.bufferData;
+            else
+                view.data = QByteArray(content, qsizetype(length));
+            view.bufferData.clear();
+            return;
         }
+
+        const quint64 decodedSize = quint64(qMax(view.count, 0)) * quint64(qMax(view.elementSize, 0));
+        if (decodedSize != view.byteLength) {
+            view.bufferData.clear();
+            return;
+        }
+
+        view.data = QByteArray(qsizetype(decodedSize), Qt::Uninitialized);
+        uchar *destination = reinterpret_cast<uchar *>(view.data.data());
+        const uchar *source = reinterpret_cast<const uchar *>(content);
+        bool decoded = false;
+        switch (view.compression) {
+        case BufferViewData::AttributesCompression:
+            decoded = MeshoptDecoder::decodeVertexBuffer(destination, view.count, view.elementSize,
+                                                         source, qsizetype(length));
+            break;
+        case BufferViewData::TrianglesCompression:
+            decoded = MeshoptDecoder::decodeIndexBuffer(destination, view.count, view.elementSize,
+                                                        source, qsizetype(length));
+            break;
+        case BufferViewData::IndicesCompression:
+            decoded = MeshoptDecoder::decodeIndexSequence(destination, view.count, view.elementSize,
+                                                          source, qsizetype(length));
+            break;
+        default:
+            break;
+        }
+        view.bufferData.clear();
+
+        if (!decoded) {
+            view.data.clear();
+            return;
+        }
+
+        if (view.compression == BufferViewData::AttributesCompression) {
+            switch (view.filter) {
+            case BufferViewData::OctahedralFilter:
+                MeshoptDecoder::applyOctahedralFilter(destination, view.count, view.elementSize);
+                break;
+            case BufferViewData::QuaternionFilter:
+                MeshoptDecoder::applyQuaternionFilter(destination, view.count, view.elementSize);
+                break;
+            case BufferViewData::ExponentialFilter:
+                MeshoptDecoder::applyExponentialFilter(destination, view.count, view.elementSize);
+                break;
+            default:
+                break;
+            }
+        }
+    });
+
+    for (const BufferViewData &view : qAsConst(m_bufferViewDatas)) {
+        if (Q_UNLIKELY(view.compression != BufferViewData::NoCompression
+                       && view.data.isEmpty() && view.byteLength > 0)) {
+            qCWarning(GLTFImporterLog, "failed to decode compressed view %ls from: %ls",
+                      qUtf16PrintableImpl(view.id), qUtf16PrintableImpl(view.bufferPath));
+        } else if (Q_UNLIKELY(quint64(view.data.size()) != view.length
+                              && view.compression == BufferViewData::NoCompression)) {
+            qCWarning(GLTFImporterLog, "failed to read sufficient bytes from: %ls for view %ls",
+                      qUtf16PrintableImpl(view.bufferPath), qUtf16PrintableImpl(view.id));
+        }
+
+        Qt3DCore::QBuffer *b = new Qt3DCore::QBuffer();
+        b->setData(view.data);
+        m_buffers[view.id] = b;
+        if (view.stride > 0)
+            m_bufferViewStrides[view.id] = view.stride;
     }
+    m_bufferViewDatas.clear();
 }
 
 /*!
@@ -2073,9 +2498,32 @@ void GLTFImporter::loadBufferData()
 */
 void GLTFImporter::unloadBufferData()
 {
-    for (const auto &bufferData : qAsConst(m_bufferDatas)) {
-        QByteArray *data = bufferData.data;
-        delete data;
+    for (auto &bufferData : m_bufferDatas) {
+        bufferData.data.clear();
+        bufferData.file.reset();
+    }
+    m_binaryChunk.clear();
+    m_sourceData.clear();
+    m_sourceFile.reset();
+}
+
+/*!
+    Starts decoding the image files used as metallic-roughness maps, which
+    are split into separate textures when their material is created.
+*/
+void GLTFImporter::prefetchMetalRoughImages()
+{
+    const QJsonArray materials = m_json.object().value(KEY_MATERIALS).toArray();
+    const QJsonArray textures = m_json.object().value(KEY_TEXTURES).toArray();
+    for (const QJsonValue &material : materials) {
+        const QJsonValue texValue = material.toObject().value(KEY_PBR_METAL_ROUGH).toObject().value(KEY_METAL_ROUGH_TEX);
+        if (texValue.isUndefined())
+            continue;
+        const QJsonObject tObj = textures.at(texValue.toObject().value(KEY_INDEX).toInt()).toObject();
+        const QString sourceId = QString::number(tObj.value(KEY_SOURCE).toInt());
+        const auto pathIt = qAsConst(m_imagePaths).find(sourceId);
+        if (pathIt != m_imagePaths.cend() && !m_imageData.contains(sourceId))
+            m_imageData.insert(sourceId, decodeImage(pathIt.value()));
     }
 }
 
@@ -2096,6 +2544,45 @@ QByteArray GLTFImporter::resolveLocalData(const QString &path) const
     }
 }
 
+/*!
+    Maps the file at \a path, setting \a file to keep the mapping alive. The
+    returned array points into the mapping. When the file can't be mapped it
+    is read instead and \a file is reset.
+*/
+QByteArray GLTFImporter::mapFile(const QString &path, QSharedPointer<QFile> &file)
+{
+    file.reset(new QFile(path));
+    if (!file->open(QIODevice::ReadOnly)) {
+        file.reset();
+        return QByteArray();
+    }
+
+    const qint64 size = file->size();
+    const uchar *mapped = size > 0 ? file->map(0, size) : nullptr;
+    if (mapped)
+        return QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), qsizetype(size));
+
+    const QByteArray data = file->readAll();
+    file.reset();
+    return data;
+}
+
+QFuture<QImage> GLTFImporter::decodeImage(const QByteArray &encodedData)
+{
+    return QtConcurrent::run([encodedData] {
+        QImage image;
+        image.loadFromData(encodedData);
+        return image;
+    });
+}
+
+QFuture<QImage> GLTFImporter::decodeImage(const QString &path)
+{
+    return QtConcurrent::run([path] {
+        return QImage(path);
+    });
+}
+
 QVariant GLTFImporter::parameterValueFromJSON(int type, const QJsonValue &value) const
 {
     if (value.isBool()) {
@@ -54,16 +54,20 @@
 
 #include <Qt3DCore/qattribute.h>
 #include <Qt3DCore/qbuffer.h>
+#include <QtCore/qfuture.h>
 #include <QtCore/qjsondocument.h>
 #include <QtCore/qjsonobject.h>
 #include <QtCore/qhash.h>
 #include <QtCore/qloggingcategory.h>
+#include <QtCore/qsharedpointer.h>
+#include <QtGui/qimage.h>
 
 #include <Qt3DRender/private/qsceneimporter_p.h>
 
 QT_BEGIN_NAMESPACE
 
 class QByteArray;
+class QFile;
 
 namespace Qt3DCore {
 class QEntity;
@@ -97,6 +101,7 @@ public:
 
     void setBasePath(const QString& path);
     bool setJSON(const QJsonDocument &json);
+    bool setBinaryGLTF(const QByteArray &data);
 
     // SceneParserInterface interface
     void setSource(const QUrl &source) final;
@@ -114,10 +119,55 @@ private:
 
         quint64 length;
         QString path;
-        QByteArray *data;
+        // Owned content, or content pointing into the mapping of file or of
+        // the binary glTF source when ownsData is false
+        QByteArray data;
+        QSharedPointer<QFile> file;
+        bool ownsData;
+        // Buffers only used by views that can't be decoded are not loaded
+        bool isFallback;
         // type if ever useful
     };
 
+    class BufferViewData
+    {
+    public:
+        // Modes and filters of EXT_meshopt_compression
+        enum Compression {
+            NoCompression,
+            AttributesCompression,
+            TrianglesCompression,
+            IndicesCompression
+        };
+
+        enum Filter {
+            NoFilter,
+            OctahedralFilter,
+            QuaternionFilter,
+            ExponentialFilter
+        };
+
+        BufferViewData();
+
+        QString id;
+        QString bufferPath;
+        // Shallow copy of the buffer content, safe to read from any thread
+        QByteArray bufferData;
+        bool bufferOwnsData;
+        // Range of the content in the buffer, compressed or not
+        quint64 offset;
+        quint64 length;
+        // Size of the decoded content
+        quint64 byteLength;
+        int stride;
+        Compression compression;
+        Filter filter;
+        // Number and size of the compressed elements
+        int count;
+        int elementSize;
+        QByteArray data;
+    };
+
     class ParameterData
     {
     public:
@@ -140,15 +190,18 @@ private:
         int count;
         int offset;
         int stride;
+        bool normalized;
     };
 
     static bool isGLTFSupported(const QStringList &extensions);
     static bool isEmbeddedResource(const QString &url);
+    static bool isBinaryGLTF(const QByteArray &data);
     static void renameFromJson(const QJsonObject& json, QObject * const object );
     static bool hasStandardUniformNameFromSemantic(const QString &semantic);
     static QString standardAttributeNameFromSemantic(const QString &semantic);
     QParameter *parameterFromTechnique(QTechnique *technique, const QString &parameterName);
 
+    bool setBinaryGLTFV1(const QByteArray &data);
     Qt3DCore::QEntity *defaultScene();
     QMaterial *material(const QString &id);
     bool fillCamera(QCameraLens &lens, QCamera *cameraEntity, const QString &id) const;
@@ -173,9 +226,15 @@ private:
     void processJSONRenderPass(const QString &id, const QJsonObject &jsonObject);
 
     void loadBufferData();
+    void loadBufferViews();
     void unloadBufferData();
+    void prefetchMetalRoughImages();
+    void dequantizeAccessors();
 
     QByteArray resolveLocalData(const QString &path) const;
+    static QByteArray mapFile(const QString &path, QSharedPointer<QFile> &file);
+    static QFuture<QImage> decodeImage(const QByteArray &encodedData);
+    static QFuture<QImage> decodeImage(const QString &path);
 
     QVariant parameterValueFromJSON(int type, const QJsonValue &value) const;
     static Qt3DCore::QAttribute::VertexBaseType accessorTypeFromJSON(int componentType);
@@ -194,6 +253,12 @@ private:
 
     QJsonDocument m_json;
     QString m_basePath;
+
+    // Keep the binary chunk of a binary glTF source alive until its buffer
+    // views are loaded
+    QSharedPointer<QFile> m_sourceFile;
+    QByteArray m_sourceData;
+    QByteArray m_binaryChunk;
     bool m_parseDone;
     int m_majorVersion;
     int m_minorVersion;
@@ -212,9 +277,12 @@ private:
     QHash<QString, QMaterial*> m_materialCache;
 
     QHash<QString, BufferData> m_bufferDatas;
+    QList<BufferViewData> m_bufferViewDatas;
     QHash<QString, Qt3DCore::QBuffer*> m_buffers;
+    // Strides of the glTF 2 buffer views, which hold them instead of accessors
+    QHash<QString, int> m_bufferViewStrides;
 
-    QHash<QString, QString> m_shaderPaths;
+    QHash<QString, QByteArray> m_shaderSources;
     QHash<QString, QShaderProgram*> m_programs;
 
     QHash<QString, QTechnique *> m_techniques;
@@ -225,7 +293,8 @@ private:
 
     QHash<QString, QAbstractTexture*> m_textures;
     QHash<QString, QString> m_imagePaths;
-    QHash<QString, QImage> m_imageData;
+    // Images decoded on the global thread pool while the scene is built
+    QHash<QString, QFuture<QImage>> m_imageData;
     QHash<QString, QAbstractLight *> m_lights;
 };
 
@@ -0,0 +1,495 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB)
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "meshoptdecoder.h"
+
+#include <QtCore/qendian.h>
+
+#include <cmath>
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace MeshoptDecoder {
+
+namespace {
+
+constexpr uchar VertexHeader = 0xa0;
+constexpr uchar IndexHeader = 0xe0;
+constexpr uchar SequenceHeader = 0xd0;
+
+constexpr int ByteGroupSize = 16;
+constexpr int VertexBlockSizeBytes = 8192;
+constexpr int VertexBlockMaxSize = 256;
+constexpr int MaxVertexStride = 256;
+constexpr int TailMaxSize = 32;
+constexpr int IndexCodeAuxTableSize = 16;
+constexpr int IndexSequenceTailSize = 4;
+
+inline uchar unzigzag8(uchar v)
+{
+    return uchar(-(v & 1) ^ (v >> 1));
+}
+
+inline unsigned int unzigzag32(unsigned int v)
+{
+    return (v >> 1) ^ (0u - (v & 1));
+}
+
+// Vertices are encoded in blocks fitting in 8KB, of a multiple of 16 vertices
+int vertexBlockSize(int stride)
+{
+    return qMin((VertexBlockSizeBytes / stride) & ~(ByteGroupSize - 1), VertexBlockMaxSize);
+}
+
+// A group holds 16 bytes of 0, 2, 4 or 8 bits each. With 2 and 4 bits, bytes
+// whose value doesn't fit are set to all ones and follow the packed bits
+const uchar *decodeBytesGroup(const uchar *data, const uchar *end, uchar *out, int bitsLog2)
+{
+    if (bitsLog2 == 0) {
+        memset(out, 0, ByteGroupSize);
+        return data;
+    }
+
+    if (bitsLog2 == 3) {
+        if (end - data < ByteGroupSize)
+            return nullptr;
+        memcpy(out, data, ByteGroupSize);
+        return data + ByteGroupSize;
+    }
+
+    const int bits = 1 << bitsLog2;
+    const int packedSize = ByteGroupSize * bits / 8;
+    if (end - data < packedSize)
+        return nullptr;
+
+    const uchar escape = uchar((1 << bits) - 1);
+    const uchar *extra = data + packedSize;
+    for (int i = 0; i < ByteGroupSize; ++i) {
+        // Values are packed starting from the most significant bits
+        const int shift = 8 - bits - (i * bits) % 8;
+        const uchar value = (data[i * bits / 8] >> shift) & escape;
+        if (value == escape) {
+            if (extra == end)
+                return nullptr;
+            out[i] = *extra++;
+        } else {
+            out[i] = value;
+        }
+    }
+    return extra;
+}
+
+// Decodes size bytes, a multiple of 16, preceded by 2 bits per group
+const uchar *decodeBytes(const uchar *data, const uchar *end, uchar *out, int size)
+{
+    const int groupCount = size / ByteGroupSize;
+    const int headerSize = (groupCount + 3) / 4;
+    if (end - data < headerSize)
+        return nullptr;
+
+    const uchar *header = data;
+    data += headerSize;
+    for (int group = 0; group < groupCount && data; ++group) {
+        const int bitsLog2 = (header[group / 4] >> ((group % 4) * 2)) & 3;
+        data = decodeBytesGroup(data, end, out + group * ByteGroupSize, bitsLog2);
+    }
+    return data;
+}
+
+// Each byte of the vertices is stored as a stream of zigzag encoded deltas
+// to the same byte of the previous vertex
+const uchar *decodeVertexBlock(const uchar *data, const uchar *end, uchar *vertices,
+                               int count, int stride, uchar *lastVertex)
+{
+    uchar deltas[VertexBlockMaxSize];
+    const int alignedCount = (count + ByteGroupSize - 1) & ~(ByteGroupSize - 1);
+
+    for (int k = 0; k < stride; ++k) {
+        data = decodeBytes(data, end, deltas, alignedCount);
+        if (!data)
+            return nullptr;
+
+        uchar value = lastVertex[k];
+        for (int i = 0; i < count; ++i) {
+            value = uchar(value + unzigzag8(deltas[i]));
+            vertices[i * stride + k] = value;
+        }
+        lastVertex[k] = value;
+    }
+    return data;
+}
+
+unsigned int decodeVByte(const uchar *&data)
+{
+    const uchar lead = *data++;
+    if (lead < 128)
+        return lead;
+
+    unsigned int result = lead & 127;
+    unsigned int shift = 7;
+    for (int i = 0; i < 4; ++i) {
+        const uchar group = *data++;
+        result |= unsigned(group & 127) << shift;
+        shift += 7;
+        if (group < 128)
+            break;
+    }
+    return result;
+}
+
+inline unsigned int decodeIndex(const uchar *&data, unsigned int last)
+{
+    return last + unzigzag32(decodeVByte(data));
+}
+
+inline void writeIndex(uchar *destination, int i, int indexSize, unsigned int index)
+{
+    if (indexSize == 2)
+        qToLittleEndian<quint16>(quint16(index), destination + qsizetype(i) * 2);
+    else
+        qToLittleEndian<quint32>(index, destination + qsizetype(i) * 4);
+}
+
+// Recently used edges and vertices, indexed backwards from the last pushed
+struct IndexFifos
+{
+    unsigned int edges[16][2];
+    unsigned int vertices[16];
+    unsigned int edgeOffset = 0;
+    unsigned int vertexOffset = 0;
+
+    IndexFifos()
+    {
+        memset(edges, -1, sizeof(edges));
+        memset(vertices, -1, sizeof(vertices));
+    }
+
+    void pushEdge(unsigned int a, unsigned int b)
+    {
+        edges[edgeOffset][0] = a;
+        edges[edgeOffset][1] = b;
+        edgeOffset = (edgeOffset + 1) & 15;
+    }
+
+    void pushVertex(unsigned int v, bool condition = true)
+    {
+        vertices[vertexOffset] = v;
+        vertexOffset = (vertexOffset + (condition ? 1 : 0)) & 15;
+    }
+};
+
+} // anonymous
+
+bool decodeVertexBuffer(uchar *destination, int count, int stride, const uchar *data, qsizetype size)
+{
+    if (count < 0 || stride <= 0 || stride > MaxVertexStride || stride % 4 != 0)
+        return false;
+    if (size < 1 + stride)
+        return false;
+    if ((data[0] & 0xf0) != VertexHeader || (data[0] & 0x0f) > 0)
+        return false;
+
+    const uchar *end = data + size;
+
+    // The tail ends with the vertex the first one is encoded against
+    uchar lastVertex[MaxVertexStride];
+    memcpy(lastVertex, end - stride, stride);
+
+    const int blockSize = vertexBlockSize(stride);
+    const uchar *p = data + 1;
+    for (int offset = 0; offset < count; offset += blockSize) {
+        const int blockCount = qMin(blockSize, count - offset);
+        p = decodeVertexBlock(p, end, destination + qsizetype(offset) * stride,
+                              blockCount, stride, lastVertex);
+        if (!p)
+            return false;
+    }
+
+    return end - p == qMax(stride, TailMaxSize);
+}
+
+bool decodeIndexBuffer(uchar *destination, int count, int indexSize, const uchar *data, qsizetype size)
+{
+    if (count < 0 || count % 3 != 0 || (indexSize != 2 && indexSize != 4))
+        return false;
+    // Header, one code per triangle and the code table
+    if (size < 1 + count / 3 + IndexCodeAuxTableSize)
+        return false;
+    if ((data[0] & 0xf0) != IndexHeader)
+        return false;
+    const int version = data[0] & 0x0f;
+    if (version > 1)
+        return false;
+
+    IndexFifos fifos;
+    unsigned int next = 0;
+    unsigned int last = 0;
+    // Version 1 uses the last two vertex codes for last - 1 and last + 1
+    const int fecMax = version >= 1 ? 13 : 15;
+
+    const uchar *code = data + 1;
+    const uchar *p = code + count / 3;
+    // A triangle reads at most 16 bytes, the size of the code table ending
+    // the data, so reads are safe as long as p doesn't pass the table
+    const uchar *safeEnd = data + size - IndexCodeAuxTableSize;
+    const uchar *codeAuxTable = safeEnd;
+
+    for (int i = 0; i < count; i += 3) {
+        if (p > safeEnd)
+            return false;
+
+        const uchar codeTri = *code++;
+
+        if (codeTri < 0xf0) {
+            // Triangle sharing an edge from the fifo, the third vertex being
+            // the next one, one from the fifo or a free index
+            const int fe = codeTri >> 4;
+            const unsigned int a = fifos.edges[(fifos.edgeOffset - 1 - fe) & 15][0];
+            const unsigned int b = fifos.edges[(fifos.edgeOffset - 1 - fe) & 15][1];
+            const int fec = codeTri & 15;
+
+            if (fec < fecMax) {
+                const unsigned int c = fec == 0 ? next : fifos.vertices[(fifos.vertexOffset - 1 - fec) & 15];
+                if (fec == 0)
+                    ++next;
+
+                writeIndex(destination, i, indexSize, a);
+                writeIndex(destination, i + 1, indexSize, b);
+                writeIndex(destination, i + 2, indexSize, c);
+
+                fifos.pushVertex(c, fec == 0);
+                fifos.pushEdge(c, b);
+                fifos.pushEdge(a, c);
+            } else {
+                // 13 and 14 decode to last - 1 and last + 1
+                const unsigned int c = fec != 15 ? last + unsigned(fec - (fec ^ 3)) : decodeIndex(p, last);
+                last = c;
+
+                writeIndex(destination, i, indexSize, a);
+                writeIndex(destination, i + 1, indexSize, b);
+                writeIndex(destination, i + 2, indexSize, c);
+
+                fifos.pushVertex(c);
+                fifos.pushEdge(c, b);
+                fifos.pushEdge(a, c);
+            }
+        } else if (codeTri < 0xfe) {
+            // New triangle starting with the next vertex, the codes of the
+            // two others being looked up in the table
+            const uchar codeAux = codeAuxTable[codeTri & 15];
+            const int feb = codeAux >> 4;
+            const int fec = codeAux & 15;
+
+            const unsigned int a = next++;
+            const unsigned int b = feb == 0 ? next : fifos.vertices[(fifos.vertexOffset - feb) & 15];
+            if (feb == 0)
+                ++next;
+            const unsigned int c = fec == 0 ? next : fifos.vertices[(fifos.vertexOffset - fec) & 15];
+            if (fec == 0)
+                ++next;
+
+            writeIndex(destination, i, indexSize, a);
+            writeIndex(destination, i + 1, indexSize, b);
+            writeIndex(destination, i + 2, indexSize, c);
+
+            fifos.pushVertex(a);
+            fifos.pushVertex(b, feb == 0);
+            fifos.pushVertex(c, fec == 0);
+            fifos.pushEdge(b, a);
+            fifos.pushEdge(c, b);
+            fifos.pushEdge(a, c);
+        } else {
+            // New triangle with its codes stored in the data
+            const uchar codeAux = *p++;
+            const int fea = codeTri == 0xfe ? 0 : 15;
+            const int feb = codeAux >> 4;
+            const int fec = codeAux & 15;
+
+            // A zero code resets the next vertex
+            if (codeAux == 0)
+                next = 0;
+
+            unsigned int a = fea == 0 ? next++ : 0;
+            unsigned int b = feb == 0 ? next++ : fifos.vertices[(fifos.vertexOffset - feb) & 15];
+            unsigned int c = fec == 0 ? next++ : fifos.vertices[(fifos.vertexOffset - fec) & 15];
+
+            if (fea == 15)
+                last = a = decodeIndex(p, last);
+            if (feb == 15)
+                last = b = decodeIndex(p, last);
+            if (fec == 15)
+                last = c = decodeIndex(p, last);
+
+            writeIndex(destination, i, indexSize, a);
+            writeIndex(destination, i + 1, indexSize, b);
+            writeIndex(destination, i + 2, indexSize, c);
+
+            fifos.pushVertex(a);
+            fifos.pushVertex(b, feb == 0 || feb == 15);
+            fifos.pushVertex(c, fec == 0 || fec == 15);
+            fifos.pushEdge(b, a);
+            fifos.pushEdge(c, b);
+            fifos.pushEdge(a, c);
+        }
+    }
+
+    // All the data must have been consumed, up to the code table
+    return p == safeEnd;
+}
+
+bool decodeIndexSequence(uchar *destination, int count, int indexSize, const uchar *data, qsizetype size)
+{
+    if (count < 0 || (indexSize != 2 && indexSize != 4))
+        return false;
+    // Header, at least one byte per index and the tail
+    if (size < 1 + count + IndexSequenceTailSize)
+        return false;
+    if ((data[0] & 0xf0) != SequenceHeader || (data[0] & 0x0f) > 1)
+        return false;
+
+    const uchar *p = data + 1;
+    // An index reads at most 5 bytes, the tail makes reading safe while p
+    // is before it
+    const uchar *safeEnd = data + size - IndexSequenceTailSize;
+    unsigned int last[2] = { 0, 0 };
+
+    for (int i = 0; i < count; ++i) {
+        if (p >= safeEnd)
+            return false;
+
+        // The lowest bit selects which of two baselines the delta applies to
+        const unsigned int v = decodeVByte(p);
+        const unsigned int baseline = v & 1;
+        const unsigned int index = last[baseline] + unzigzag32(v >> 1);
+        last[baseline] = index;
+
+        writeIndex(destination, i, indexSize, index);
+    }
+
+    return p == safeEnd;
+}
+
+namespace {
+
+template<typename T>
+void applyOctahedralFilter(T *data, int count, int componentStride)
+{
+    const float max = float((1 << (sizeof(T) * 8 - 1)) - 1);
+    for (int i = 0; i < count; ++i) {
+        T *n = data + qsizetype(i) * componentStride;
+        // z holds the encoding of 1.0 minus the octahedral coordinates
+        float x = float(n[0]);
+        float y = float(n[1]);
+        const float z = float(n[2]) - std::fabs(x) - std::fabs(y);
+
+        // Unfold the lower hemisphere
+        const float t = z < 0.0f ? z : 0.0f;
+        x += x >= 0.0f ? t : -t;
+        y += y >= 0.0f ? t : -t;
+
+        const float scale = max / std::sqrt(x * x + y * y + z * z);
+        n[0] = T(std::lround(x * scale));
+        n[1] = T(std::lround(y * scale));
+        n[2] = T(std::lround(z * scale));
+    }
+}
+
+} // anonymous
+
+void applyOctahedralFilter(uchar *data, int count, int stride)
+{
+    if (stride == 4)
+        applyOctahedralFilter(reinterpret_cast<qint8 *>(data), count, 4);
+    else if (stride == 8)
+        applyOctahedralFilter(reinterpret_cast<qint16 *>(data), count, 4);
+}
+
+void applyQuaternionFilter(uchar *data, int count, int stride)
+{
+    if (stride != 8)
+        return;
+
+    const float scale = 1.0f / std::sqrt(2.0f);
+    qint16 *q = reinterpret_cast<qint16 *>(data);
+    for (int i = 0; i < count; ++i, q += 4) {
+        // The fourth component holds the scale in its high bits and the index
+        // of the omitted component, the largest one, in its two low bits
+        const int range = q[3] | 3;
+        const float s = scale / float(range);
+
+        const float x = float(q[0]) * s;
+        const float y = float(q[1]) * s;
+        const float z = float(q[2]) * s;
+        const float ww = 1.0f - x * x - y * y - z * z;
+        const float w = std::sqrt(ww >= 0.0f ? ww : 0.0f);
+
+        const int largest = q[3] & 3;
+        q[(largest + 1) & 3] = qint16(std::lround(x * 32767.0f));
+        q[(largest + 2) & 3] = qint16(std::lround(y * 32767.0f));
+        q[(largest + 3) & 3] = qint16(std::lround(z * 32767.0f));
+        q[(largest + 0) & 3] = qint16(std::lround(w * 32767.0f));
+    }
+}
+
+void applyExponentialFilter(uchar *data, int count, int stride)
+{
+    if (stride % 4 != 0)
+        return;
+
+    // Each 32 bit value holds a signed 24 bit mantissa and an 8 bit exponent
+    quint32 *values = reinterpret_cast<quint32 *>(data);
+    const qsizetype valueCount = qsizetype(count) * (stride / 4);
+    for (qsizetype i = 0; i < valueCount; ++i) {
+        const quint32 v = values[i];
+        const int mantissa = int(v << 8) >> 8;
+        const int exponent = int(v) >> 24;
+        const float f = std::ldexp(float(mantissa), exponent);
+        memcpy(&values[i], &f, sizeof(f));
+    }
+}
+
+} // namespace MeshoptDecoder
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
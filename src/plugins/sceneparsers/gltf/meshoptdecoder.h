@@ -0,0 +1,84 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB)
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QT3DRENDER_MESHOPTDECODER_H
+#define QT3DRENDER_MESHOPTDECODER_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+// Decoders for the buffer views compressed with the EXT_meshopt_compression
+// glTF extension. They return false when the data is malformed, leaving the
+// destination partially written.
+namespace MeshoptDecoder {
+
+// ATTRIBUTES mode, stride is a multiple of 4 up to 256
+bool decodeVertexBuffer(uchar *destination, int count, int stride, const uchar *data, qsizetype size);
+// TRIANGLES mode, indexSize is 2 or 4 and count a multiple of 3
+bool decodeIndexBuffer(uchar *destination, int count, int indexSize, const uchar *data, qsizetype size);
+// INDICES mode, indexSize is 2 or 4
+bool decodeIndexSequence(uchar *destination, int count, int indexSize, const uchar *data, qsizetype size);
+
+// Filters applied in place to decoded ATTRIBUTES data
+void applyOctahedralFilter(uchar *data, int count, int stride);
+void applyQuaternionFilter(uchar *data, int count, int stride);
+void applyExponentialFilter(uchar *data, int count, int stride);
+
+} // namespace MeshoptDecoder
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_MESHOPTDECODER_H
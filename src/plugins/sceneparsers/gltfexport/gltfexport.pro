@@ -1,5 +1,5 @@
 TARGET = gltfsceneexport
-QT += core-private 3dcore 3dcore-private 3drender 3drender-private 3dextras
+QT += core-private concurrent 3dcore 3dcore-private 3drender 3drender-private 3dextras
 
 HEADERS += \
     gltfexporter.h
@@ -53,6 +53,10 @@
 #include <QtCore/qtemporarydir.h>
 #include <QtCore/qregularexpression.h>
 #include <QtCore/qmetaobject.h>
+#include <QtCore/qendian.h>
+#include <QtCore/qthread.h>
+#include <QtConcurrent/qtconcurrentmap.h>
+#include <QtGui/qimagereader.h>
 #include <QtGui/qvector2d.h>
 #include <QtGui/qvector4d.h>
 #include <QtGui/qmatrix4x4.h>
@@ -115,6 +119,8 @@
 
 #include <private/qurlhelper_p.h>
 
+#include <limits>
+
 #ifndef qUtf16PrintableImpl
 #  define qUtf16PrintableImpl(string) \
     static_cast<const wchar_t*>(static_cast<const void*>(string.utf16()))
@@ -253,8 +259,21 @@ const QString TANGENT_ATTRIBUTE_NAME = QAttribute::defaultTangentAttributeName()
 const QString TEXTCOORD_ATTRIBUTE_NAME = QAttribute::defaultTextureCoordinateAttributeName();
 const QString COLOR_ATTRIBUTE_NAME = QAttribute::defaultColorAttributeName();
 
+// Binary glTF 1.0 container of the KHR_binary_glTF extension, the body
+// following the JSON content is the buffer named BINARY_BUFFER_NAME
+const quint32 GLB_MAGIC = 0x46546C67; // "glTF"
+const quint32 GLB_VERSION = 1;
+const quint32 GLB_HEADER_SIZE = 20;
+const quint32 GLB_CONTENT_FORMAT_JSON = 0;
+const QString BINARY_GLTF_EXTENSION = QStringLiteral("KHR_binary_glTF");
+const QString BINARY_BUFFER_NAME = QStringLiteral("binary_glTF");
+// Uri of the buffer, images and shaders of binary glTF files, which read
+// their content from the body instead
+const QString BINARY_EMPTY_URI = QStringLiteral("data:,");
+
 GLTFExporter::GLTFExporter() : QSceneExporter()
   , m_sceneRoot(nullptr)
+  , m_bufferSize(0)
   , m_rootNode(nullptr)
   , m_rootNodeEmpty(false)
 
@@ -283,6 +302,8 @@ GLTFExporter::~GLTFExporter()
 //
 // Supported options are:
 // "compactJson" (bool): Removes unnecessary whitespace from the generated JSON file.
+// "binary" (bool): Writes a single binary glTF 1.0 (.glb) file with the KHR_binary_glTF
+//                  extension. Its body holds the mesh data, the texture images and the shaders.
 
 /*!
     Exports the scene to the GLTF format
@@ -320,6 +341,7 @@ bool GLTFExporter::exportScene(QEntity *sceneRoot, const QString &outDir,
 
     m_gltfOpts.compactJson = options.value(QStringLiteral("compactJson"),
                                            QVariant(false)).toBool();
+    m_gltfOpts.binary = options.value(QStringLiteral("binary"), QVariant(false)).toBool();
 
     QFileInfo outDirFileInfo(outDir);
     QString absoluteOutDir = outDirFileInfo.absoluteFilePath();
@@ -363,10 +385,11 @@ bool GLTFExporter::exportScene(QEntity *sceneRoot, const QString &outDir,
     qCDebug(GLTFExporterLog, "Temp export dir: %ls", qUtf16PrintableImpl(m_exportDir));
     qCDebug(GLTFExporterLog, "Final export dir: %ls", qUtf16PrintableImpl(finalExportDir));
 
-    parseScene();
+    m_bufferFileName = m_exportDir + m_exportName + QStringLiteral(".bin");
+    m_bufferSize = 0;
 
     // Export scene to temporary directory
-    if (!saveScene()) {
+    if (!parseScene() || !saveScene()) {
         qCWarning(GLTFExporterLog, "Exporting GLTF scene failed");
         return false;
     }
@@ -385,8 +408,9 @@ bool GLTFExporter::exportScene(QEntity *sceneRoot, const QString &outDir,
     // Files copied from resources will have read-only permissions, which isn't ideal in cases
     // where export is done on top of an existing export.
     // Since different file systems handle permissions differently, we grab the target permissions
-    // from the qgltf file, which we created ourselves.
-    QFile gltfFile(m_exportDir + m_exportName + QStringLiteral(".qgltf"));
+    // from the qgltf or glb file, which we created ourselves.
+    QFile gltfFile(m_exportDir + m_exportName
+                   + (m_gltfOpts.binary ? QStringLiteral(".glb") : QStringLiteral(".qgltf")));
     QFile::Permissions targetPermissions = gltfFile.permissions();
 
     // Copy exported scene to actual export directory
@@ -415,13 +439,15 @@ bool GLTFExporter::exportScene(QEntity *sceneRoot, const QString &outDir,
 
     // Clean up after export
 
-    m_buffer.clear();
+    m_bufferFileName.clear();
     m_meshMap.clear();
     m_materialMap.clear();
     m_cameraMap.clear();
     m_lightMap.clear();
     m_transformMap.clear();
     m_imageMap.clear();
+    m_embeddedImages.clear();
+    m_embeddedViews.clear();
     m_textureIdMap.clear();
     m_meshInfo.clear();
     m_materialInfo.clear();
@@ -487,12 +513,28 @@ void GLTFExporter::cacheDefaultProperties(GLTFExporter::PropertyCacheType type)
     m_propertyCache.insert(type, properties);
 }
 
-// Copies textures from original locations to the temporary export directory.
-// If texture names conflict, they are renamed.
+// Copies textures from original locations to the temporary export directory,
+// or embeds them in the body of binary exports. Target names are chosen
+// first and the textures are then copied in parallel. Binary exports only
+// read the image headers in parallel, each texture is then streamed into the
+// body in turn. If texture names conflict, they are renamed.
 void GLTFExporter::copyTextures()
 {
     qCDebug(GLTFExporterLog, "Copying textures...");
-    QHash<QString, QString> copiedMap;
+
+    struct TextureCopy {
+        QString source;
+        QString fileName;
+        // Binary exports only
+        QString bufferView;
+        QString mimeType;
+        QSize size;
+    };
+
+    QHash<QString, int> copiedMap; // Absolute path -> index in copies
+    QHash<QString, int> textureCopies; // Texture URL -> index in copies
+    QSet<QString> reservedFiles;
+    QList<TextureCopy> copies;
     for (auto texIt = m_textureIdMap.constBegin(); texIt != m_textureIdMap.constEnd(); ++texIt) {
         QFileInfo fi(texIt.key());
         QString absoluteFilePath;
@@ -500,50 +542,121 @@ void GLTFExporter::copyTextures()
             absoluteFilePath = texIt.key();
         else
             absoluteFilePath = fi.absoluteFilePath();
-        if (copiedMap.contains(absoluteFilePath)) {
+        const auto copiedIt = copiedMap.constFind(absoluteFilePath);
+        if (copiedIt != copiedMap.cend()) {
             // Texture has already been copied
             qCDebug(GLTFExporterLog, "  Skipped copying duplicate texture: '%ls'",
                     qUtf16PrintableImpl(absoluteFilePath));
-            if (!m_imageMap.contains(texIt.key()))
-                m_imageMap.insert(texIt.key(), copiedMap.value(absoluteFilePath));
+            textureCopies.insert(texIt.key(), copiedIt.value());
         } else {
             QString fileName = fi.fileName();
-            QString outFile = m_exportDir;
-            outFile.append(fileName);
-            QFileInfo fiTry(outFile);
-            if (fiTry.exists()) {
-                static const QString outFileTemplate = QStringLiteral("%2_%3.%4");
-                int counter = 0;
-                QString tryFile = outFile;
-                QString suffix = fiTry.suffix();
-                QString base = fiTry.baseName();
-                while (fiTry.exists()) {
-                    fileName = outFileTemplate.arg(base).arg(counter++).arg(suffix);
-                    tryFile = m_exportDir;
-                    tryFile.append(fileName);
-                    fiTry.setFile(tryFile);
+            if (!m_gltfOpts.binary) {
+                auto isTaken = [this, &reservedFiles] (const QString &name) {
+                    return reservedFiles.contains(name) || QFileInfo::exists(m_exportDir + name);
+                };
+                if (isTaken(fileName)) {
+                    static const QString outFileTemplate = QStringLiteral("%2_%3.%4");
+                    int counter = 0;
+                    const QString suffix = fi.suffix();
+                    const QString base = fi.baseName();
+                    do {
+                        fileName = outFileTemplate.arg(base).arg(counter++).arg(suffix);
+                    } while (isTaken(fileName));
                 }
-                outFile = tryFile;
+                reservedFiles.insert(fileName);
             }
-            if (!QFile(absoluteFilePath).copy(outFile)) {
-                qCWarning(GLTFExporterLog, "  Failed to copy texture: '%ls' -> '%ls'",
-                          qUtf16PrintableImpl(absoluteFilePath), qUtf16PrintableImpl(outFile));
-            } else {
-                qCDebug(GLTFExporterLog, "  Copied texture: '%ls' -> '%ls'",
-                        qUtf16PrintableImpl(absoluteFilePath), qUtf16PrintableImpl(outFile));
+            copiedMap.insert(absoluteFilePath, copies.size());
+            textureCopies.insert(texIt.key(), copies.size());
+            copies.append({ absoluteFilePath, fileName, QString(), QString(), QSize() });
+        }
+    }
+
+    const bool binary = m_gltfOpts.binary;
+    const QString exportDir = m_exportDir;
+    QtConcurrent::blockingMap(copies, [binary, &exportDir] (TextureCopy &copy) {
+        if (binary) {
+            // KHR_binary_glTF images declare their type and size
+            QImageReader reader(copy.source);
+            copy.size = reader.size();
+            QByteArray format = reader.format();
+            if (format == "jpg")
+                format = "jpeg";
+            copy.mimeType = QStringLiteral("image/") + QString::fromLatin1(format);
+            return;
+        }
+
+        const QString outFile = exportDir + copy.fileName;
+        if (!QFile(copy.source).copy(outFile)) {
+            qCWarning(GLTFExporterLog, "  Failed to copy texture: '%ls' -> '%ls'",
+                      qUtf16PrintableImpl(copy.source), qUtf16PrintableImpl(outFile));
+        } else {
+            qCDebug(GLTFExporterLog, "  Copied texture: '%ls' -> '%ls'",
+                    qUtf16PrintableImpl(copy.source), qUtf16PrintableImpl(outFile));
+        }
+    });
+
+    if (binary) {
+        // Textures are appended to the body in the order of the copies
+        QFile bufferFile(m_bufferFileName);
+        if (!bufferFile.open(QIODevice::ReadWrite)) {
+            qCWarning(GLTFExporterLog, "  Opening buffers file '%ls' failed!",
+                      qUtf16PrintableImpl(m_bufferFileName));
+            return;
+        }
+        for (TextureCopy &copy : copies) {
+            QFile f(copy.source);
+            if (!f.open(QIODevice::ReadOnly)) {
+                qCWarning(GLTFExporterLog, "  Failed to read texture: '%ls'",
+                          qUtf16PrintableImpl(copy.source));
+                continue;
             }
+            copy.bufferView = embedData(&bufferFile, &f);
+            if (copy.bufferView.isEmpty()) {
+                qCWarning(GLTFExporterLog, "  Failed to embed texture: '%ls'",
+                          qUtf16PrintableImpl(copy.source));
+                continue;
+            }
+            qCDebug(GLTFExporterLog, "  Embedded texture: '%ls'", qUtf16PrintableImpl(copy.source));
+        }
+    }
+
+    for (auto it = textureCopies.constBegin(); it != textureCopies.constEnd(); ++it) {
+        const TextureCopy &copy = copies.at(it.value());
+        if (binary) {
+            if (!copy.bufferView.isEmpty())
+                m_embeddedImages.insert(it.key(), { copy.bufferView, copy.mimeType, copy.size });
+        } else {
             // Generate actual target file (as current exportDir is temp dir)
-            copiedMap.insert(absoluteFilePath, fileName);
-            m_exportedFiles.insert(fileName);
-            m_imageMap.insert(texIt.key(), fileName);
+            m_exportedFiles.insert(copy.fileName);
+            m_imageMap.insert(it.key(), copy.fileName);
         }
     }
 }
 
-// Creates shaders to the temporary export directory.
+// Creates shaders to the temporary export directory, or embeds them in the
+// body of binary exports.
 void GLTFExporter::createShaders()
 {
     qCDebug(GLTFExporterLog, "Creating shaders...");
+    if (m_gltfOpts.binary) {
+        if (m_shaderInfo.isEmpty())
+            return;
+        QFile bufferFile(m_bufferFileName);
+        if (!bufferFile.open(QIODevice::ReadWrite)) {
+            qCWarning(GLTFExporterLog, "  Opening buffers file '%ls' failed!",
+                      qUtf16PrintableImpl(m_bufferFileName));
+            return;
+        }
+        for (auto &si : m_shaderInfo) {
+            si.bufferView = embedData(&bufferFile, si.code);
+            if (si.bufferView.isEmpty()) {
+                qCWarning(GLTFExporterLog, "  Embedding shader '%ls' failed!",
+                          qUtf16PrintableImpl(si.name));
+            }
+        }
+        return;
+    }
+
     for (const auto &si : qAsConst(m_shaderInfo)) {
         const QString fileName = m_exportDir + si.uri;
         QFile f(fileName);
@@ -558,6 +671,52 @@ void GLTFExporter::createShaders()
     }
 }
 
+// Appends data to the buffer file of a binary export, in a buffer view of
+// its own kept 4 byte aligned. Returns the name of the view, or an empty
+// string if writing failed.
+QString GLTFExporter::embedData(QIODevice *device, const QByteArray &data)
+{
+    if (!device->seek(m_bufferSize) || device->write(data) != data.size())
+        return QString();
+    return addEmbeddedView(device, data.size());
+}
+
+// Same as above, reading source one block at a time so that large files
+// never get loaded at once.
+QString GLTFExporter::embedData(QIODevice *device, QIODevice *source)
+{
+    if (!device->seek(m_bufferSize))
+        return QString();
+
+    const qint64 blockSize = 1 << 20;
+    qint64 length = 0;
+    while (!source->atEnd()) {
+        const QByteArray block = source->read(blockSize);
+        if (block.isEmpty() || device->write(block) != block.size())
+            return QString();
+        length += block.size();
+    }
+    return addEmbeddedView(device, length);
+}
+
+// Pads the length bytes just appended to the buffer file and adds the view
+// holding them. Returns the name of the view, or an empty string if writing
+// failed.
+QString GLTFExporter::addEmbeddedView(QIODevice *device, qint64 length)
+{
+    const qint64 padding = (4 - length % 4) % 4;
+    if (device->write(QByteArray(padding, '\0')) != padding)
+        return QString();
+
+    MeshInfo::BufferView view;
+    view.name = newBufferViewName();
+    view.offset = uint(m_bufferSize);
+    view.length = uint(length);
+    m_embeddedViews.append(view);
+    m_bufferSize += length + padding;
+    return view.name;
+}
+
 
 void GLTFExporter::parseEntities(const QEntity *entity, Node *parentNode)
 {
@@ -597,13 +756,15 @@ void GLTFExporter::parseEntities(const QEntity *entity, Node *parentNode)
     }
 }
 
-void GLTFExporter::parseScene()
+bool GLTFExporter::parseScene()
 {
     parseEntities(m_sceneRoot, nullptr);
     parseMaterials();
-    parseMeshes();
+    if (!parseMeshes())
+        return false;
     parseCameras();
     parseLights();
+    return true;
 }
 
 void GLTFExporter::parseMaterials()
@@ -727,11 +888,13 @@ void GLTFExporter::parseMaterials()
     }
 }
 
-void GLTFExporter::parseMeshes()
+// Custom meshes are interleaved in parallel batches and streamed to the
+// buffer file, so that only the buffers of one batch are kept in memory
+bool GLTFExporter::parseMeshes()
 {
     qCDebug(GLTFExporterLog, "Parsing meshes...");
 
-    int meshCount = 0;
+    QList<GeometryData> geometries;
     for (auto it = m_meshMap.constBegin(); it != m_meshMap.constEnd(); ++it) {
         Node *node = it.key();
         QGeometryRenderer *renderer = it.value();
@@ -771,215 +934,254 @@ void GLTFExporter::parseMeshes()
             cacheDefaultProperties(meshInfo.meshType);
 
             if (GLTFExporterLog().isDebugEnabled()) {
-                qCDebug(GLTFExporterLog, "  Mesh #%i: (%ls/%ls)", meshCount,
+                qCDebug(GLTFExporterLog, "  Mesh #%i: (%ls/%ls)", int(m_meshInfo.size()),
                         qUtf16PrintableImpl(meshInfo.name), qUtf16PrintableImpl(meshInfo.originalName));
                 qCDebug(GLTFExporterLog, "    material: '%ls'",
                         qUtf16PrintableImpl(meshInfo.materialName));
                 qCDebug(GLTFExporterLog, "    basic mesh type: '%s'",
                         mesh->metaObject()->className());
             }
+            m_meshInfo.insert(renderer, meshInfo);
         } else {
             meshInfo.meshComponent = nullptr;
-            QGeometry *meshGeometry = mesh->geometry();
-
-            if (!meshGeometry) {
+            if (!mesh->geometry()) {
                 qCWarning(GLTFExporterLog, "Ignoring mesh without geometry!");
                 continue;
             }
 
-            QAttribute *indexAttrib = nullptr;
-            const quint16 *indexPtr = nullptr;
-
-            struct VertexAttrib {
-                QAttribute *att;
-                const float *ptr;
-                QString usage;
-                uint offset;
-                uint stride;
-                int index;
-            };
-
-            QList<VertexAttrib> vAttribs;
-            vAttribs.reserve(meshGeometry->attributes().size());
-
-            uint stride(0);
-
-            const auto attributes = meshGeometry->attributes();
-            for (QAttribute *att : attributes) {
-                if (att->attributeType() == QAttribute::IndexAttribute) {
-                    indexAttrib = att;
-                    indexPtr = reinterpret_cast<const quint16 *>(att->buffer()->data().constData());
-                } else {
-                    VertexAttrib vAtt;
-                    vAtt.att = att;
-                    vAtt.ptr = reinterpret_cast<const float *>(att->buffer()->data().constData());
-                    if (att->name() == VERTICES_ATTRIBUTE_NAME)
-                        vAtt.usage = QStringLiteral("POSITION");
-                    else if (att->name() == NORMAL_ATTRIBUTE_NAME)
-                        vAtt.usage = QStringLiteral("NORMAL");
-                    else if (att->name() == TEXTCOORD_ATTRIBUTE_NAME)
-                        vAtt.usage = QStringLiteral("TEXCOORD_0");
-                    else if (att->name() == COLOR_ATTRIBUTE_NAME)
-                        vAtt.usage = QStringLiteral("COLOR");
-                    else if (att->name() == TANGENT_ATTRIBUTE_NAME)
-                        vAtt.usage = QStringLiteral("TANGENT");
-                    else
-                        vAtt.usage = att->name();
-
-                    vAtt.offset = att->byteOffset() / sizeof(float);
-                    vAtt.index = vAtt.offset;
-                    vAtt.stride = att->byteStride() > 0
-                            ? att->byteStride() / sizeof(float) - att->vertexSize() : 0;
-                    stride += att->vertexSize();
-
-                    vAttribs << vAtt;
-                }
-            }
+            GeometryData data;
+            data.renderer = renderer;
+            data.geometry = mesh->geometry();
+            data.meshInfo = meshInfo;
+            geometries.append(data);
+        }
+    }
 
-            int attribCount(vAttribs.size());
-            if (!attribCount) {
-                qCWarning(GLTFExporterLog, "Ignoring mesh without any attributes!");
-                continue;
+    QFile f(m_bufferFileName);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(GLTFExporterLog, "  Creating buffers file '%ls' failed!",
+                  qUtf16PrintableImpl(m_bufferFileName));
+        return false;
+    }
+    qCDebug(GLTFExporterLog, "  Writing '%ls'", qUtf16PrintableImpl(m_bufferFileName));
+
+    const int batchSize = qMax(1, QThread::idealThreadCount());
+    for (auto batch = geometries.begin(); batch != geometries.end(); ) {
+        const auto batchEnd = geometries.end() - batch > batchSize ? batch + batchSize
+                                                                   : geometries.end();
+        QtConcurrent::blockingMap(batch, batchEnd, &GLTFExporter::interleaveGeometry);
+        for (; batch != batchEnd; ++batch) {
+            if (!writeGeometry(&f, *batch)) {
+                qCWarning(GLTFExporterLog, "  Writing buffers file '%ls' failed!",
+                          qUtf16PrintableImpl(m_bufferFileName));
+                return false;
             }
+        }
+    }
 
-            QByteArray vertexBuf;
-            const int vertexCount = vAttribs.at(0).att->count();
-            vertexBuf.resize(stride * vertexCount * sizeof(float));
-            float *p = reinterpret_cast<float *>(vertexBuf.data());
-
-            // Create interleaved buffer
-            for (int i = 0; i < vertexCount; ++i) {
-                for (int j = 0; j < attribCount; ++j) {
-                    VertexAttrib &vAtt = vAttribs[j];
-                    for (uint k = 0; k < vAtt.att->vertexSize(); ++k)
-                        *p++ = vAtt.ptr[vAtt.index++];
-                    vAtt.index += vAtt.stride;
-                }
-            }
+    qCDebug(GLTFExporterLog, "Total buffer size: %lld", m_bufferSize);
+    return true;
+}
 
-            MeshInfo::BufferView vertexBufView;
-            vertexBufView.name = newBufferViewName();
-            vertexBufView.length = vertexBuf.size();
-            vertexBufView.offset = m_buffer.size();
-            vertexBufView.componentType = GL_FLOAT;
-            vertexBufView.target = GL_ARRAY_BUFFER;
-            meshInfo.views.append(vertexBufView);
-
-            QByteArray indexBuf;
-            MeshInfo::BufferView indexBufView;
-            uint indexCount = 0;
-            if (indexAttrib) {
-                const uint indexSize = indexAttrib->vertexBaseType() == QAttribute::UnsignedShort
-                        ? sizeof(quint16) : sizeof(quint32);
-                indexCount = indexAttrib->count();
-                uint srcIndex = indexAttrib->byteOffset() / indexSize;
-                const uint indexStride = indexAttrib->byteStride()
-                        ? indexAttrib->byteStride() / indexSize - 1: 0;
-                indexBuf.resize(indexCount * indexSize);
-                if (indexSize == sizeof(quint32)) {
-                    quint32 *dst = reinterpret_cast<quint32 *>(indexBuf.data());
-                    const quint32 *src = reinterpret_cast<const quint32 *>(indexPtr);
-                    for (uint j = 0; j < indexCount; ++j) {
-                        *dst++ = src[srcIndex++];
-                        srcIndex += indexStride;
-                    }
-                } else {
-                    quint16 *dst = reinterpret_cast<quint16 *>(indexBuf.data());
-                    for (uint j = 0; j < indexCount; ++j) {
-                        *dst++ = indexPtr[srcIndex++];
-                        srcIndex += indexStride;
-                    }
-                }
+// Interleaves the float vertex attributes of data.geometry and copies its
+// indices. Only reads the geometry, so it can run for several meshes at once.
+void GLTFExporter::interleaveGeometry(GeometryData &data)
+{
+    struct VertexAttrib {
+        const float *ptr;
+        uint index;
+        uint stride;
+    };
+
+    QList<VertexAttrib> vAttribs;
+    const auto attributes = data.geometry->attributes();
+    vAttribs.reserve(attributes.size());
+    data.vertexSize = 0;
+    for (QAttribute *att : attributes) {
+        if (att->attributeType() == QAttribute::IndexAttribute) {
+            data.indexAttribute = att;
+        } else {
+            VertexAttrib vAtt;
+            vAtt.ptr = reinterpret_cast<const float *>(att->buffer()->data().constData());
+            vAtt.index = att->byteOffset() / sizeof(float);
+            vAtt.stride = att->byteStride() > 0
+                    ? att->byteStride() / sizeof(float) - att->vertexSize() : 0;
+            data.vertexSize += att->vertexSize();
+            data.vertexAttributes << att;
+            vAttribs << vAtt;
+        }
+    }
 
-                indexBufView.name = newBufferViewName();
-                indexBufView.length = indexBuf.size();
-                indexBufView.offset = vertexBufView.offset + vertexBufView.length;
-                indexBufView.componentType = indexSize == sizeof(quint32)
-                        ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
-                indexBufView.target = GL_ELEMENT_ARRAY_BUFFER;
-                meshInfo.views.append(indexBufView);
-            }
+    const int attribCount = vAttribs.size();
+    if (!attribCount)
+        return;
 
-            MeshInfo::Accessor acc;
-            uint startOffset = 0;
-
-            acc.bufferView = vertexBufView.name;
-            acc.stride = stride * sizeof(float);
-            acc.count = vertexCount;
-            acc.componentType = vertexBufView.componentType;
-            for (int i = 0; i < attribCount; ++i) {
-                const VertexAttrib &vAtt = vAttribs.at(i);
-                acc.name = newAccessorName();
-                acc.usage = vAtt.usage;
-                acc.offset = startOffset * sizeof(float);
-                switch (vAtt.att->vertexSize()) {
-                case 1:
-                    acc.type = QStringLiteral("SCALAR");
-                    break;
-                case 2:
-                    acc.type = QStringLiteral("VEC2");
-                    break;
-                case 3:
-                    acc.type = QStringLiteral("VEC3");
-                    break;
-                case 4:
-                    acc.type = QStringLiteral("VEC4");
-                    break;
-                case 9:
-                    acc.type = QStringLiteral("MAT3");
-                    break;
-                case 16:
-                    acc.type = QStringLiteral("MAT4");
-                    break;
-                default:
-                    qCWarning(GLTFExporterLog, "Invalid vertex size: %d", vAtt.att->vertexSize());
-                    break;
-                }
-                meshInfo.accessors.append(acc);
-                startOffset += vAtt.att->vertexSize();
-            }
+    data.vertexCount = data.vertexAttributes.at(0)->count();
+    data.vertexBuffer.resize(data.vertexSize * data.vertexCount * sizeof(float));
+    float *p = reinterpret_cast<float *>(data.vertexBuffer.data());
+
+    // Create interleaved buffer
+    for (int i = 0; i < data.vertexCount; ++i) {
+        for (int j = 0; j < attribCount; ++j) {
+            VertexAttrib &vAtt = vAttribs[j];
+            for (uint k = 0, m = data.vertexAttributes.at(j)->vertexSize(); k < m; ++k)
+                *p++ = vAtt.ptr[vAtt.index++];
+            vAtt.index += vAtt.stride;
+        }
+    }
 
-            // Index
-            if (indexAttrib) {
-                acc.name = newAccessorName();
-                acc.usage = QStringLiteral("INDEX");
-                acc.bufferView = indexBufView.name;
-                acc.offset = 0;
-                acc.stride = 0;
-                acc.count = indexCount;
-                acc.componentType = indexBufView.componentType;
-                acc.type = QStringLiteral("SCALAR");
-                meshInfo.accessors.append(acc);
+    QAttribute *indexAttrib = data.indexAttribute;
+    if (indexAttrib) {
+        const char *indexPtr = indexAttrib->buffer()->data().constData();
+        const uint indexSize = indexAttrib->vertexBaseType() == QAttribute::UnsignedShort
+                ? sizeof(quint16) : sizeof(quint32);
+        data.indexCount = indexAttrib->count();
+        uint srcIndex = indexAttrib->byteOffset() / indexSize;
+        const uint indexStride = indexAttrib->byteStride()
+                ? indexAttrib->byteStride() / indexSize - 1: 0;
+        data.indexBuffer.resize(data.indexCount * indexSize);
+        if (indexSize == sizeof(quint32)) {
+            quint32 *dst = reinterpret_cast<quint32 *>(data.indexBuffer.data());
+            const quint32 *src = reinterpret_cast<const quint32 *>(indexPtr);
+            for (uint j = 0; j < data.indexCount; ++j) {
+                *dst++ = src[srcIndex++];
+                srcIndex += indexStride;
             }
-            m_buffer.append(vertexBuf);
-            m_buffer.append(indexBuf);
-
-            if (GLTFExporterLog().isDebugEnabled()) {
-                qCDebug(GLTFExporterLog, "  Mesh #%i: (%ls/%ls)", meshCount,
-                        qUtf16PrintableImpl(meshInfo.name), qUtf16PrintableImpl(meshInfo.originalName));
-                qCDebug(GLTFExporterLog, "    Vertex count: %i", vertexCount);
-                qCDebug(GLTFExporterLog, "    Bytes per vertex: %i", stride);
-                qCDebug(GLTFExporterLog, "    Vertex buffer size (bytes): %i", vertexBuf.size());
-                qCDebug(GLTFExporterLog, "    Index buffer size (bytes): %i", indexBuf.size());
-                QStringList sl;
-                const auto views = meshInfo.views;
-                for (const auto &bv : views)
-                    sl << bv.name;
-                qCDebug(GLTFExporterLog) << "    buffer views:" << sl;
-                sl.clear();
-                for (const auto &acc : qAsConst(meshInfo.accessors))
-                    sl << acc.name;
-                qCDebug(GLTFExporterLog) << "    accessors:" << sl;
-                qCDebug(GLTFExporterLog, "    material: '%ls'",
-                        qUtf16PrintableImpl(meshInfo.materialName));
+        } else {
+            quint16 *dst = reinterpret_cast<quint16 *>(data.indexBuffer.data());
+            const quint16 *src = reinterpret_cast<const quint16 *>(indexPtr);
+            for (uint j = 0; j < data.indexCount; ++j) {
+                *dst++ = src[srcIndex++];
+                srcIndex += indexStride;
             }
         }
+    }
+}
+
+// Appends the buffers of data to the buffer file and creates the buffer
+// views and accessors of its mesh. The buffers are released once written.
+bool GLTFExporter::writeGeometry(QIODevice *device, GeometryData &data)
+{
+    MeshInfo &meshInfo = data.meshInfo;
+    const int attribCount = data.vertexAttributes.size();
+    if (!attribCount) {
+        qCWarning(GLTFExporterLog, "Ignoring mesh without any attributes!");
+        return true;
+    }
+
+    MeshInfo::BufferView vertexBufView;
+    vertexBufView.name = newBufferViewName();
+    vertexBufView.length = data.vertexBuffer.size();
+    vertexBufView.offset = m_bufferSize;
+    vertexBufView.componentType = GL_FLOAT;
+    vertexBufView.target = GL_ARRAY_BUFFER;
+    meshInfo.views.append(vertexBufView);
+
+    MeshInfo::BufferView indexBufView;
+    if (data.indexAttribute) {
+        indexBufView.name = newBufferViewName();
+        indexBufView.length = data.indexBuffer.size();
+        indexBufView.offset = vertexBufView.offset + vertexBufView.length;
+        indexBufView.componentType = data.indexAttribute->vertexBaseType() == QAttribute::UnsignedShort
+                ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+        indexBufView.target = GL_ELEMENT_ARRAY_BUFFER;
+        meshInfo.views.append(indexBufView);
+    }
+
+    MeshInfo::Accessor acc;
+    uint startOffset = 0;
+
+    acc.bufferView = vertexBufView.name;
+    acc.stride = data.vertexSize * sizeof(float);
+    acc.count = data.vertexCount;
+    acc.componentType = vertexBufView.componentType;
+    for (const QAttribute *att : qAsConst(data.vertexAttributes)) {
+        acc.name = newAccessorName();
+        if (att->name() == VERTICES_ATTRIBUTE_NAME)
+            acc.usage = QStringLiteral("POSITION");
+        else if (att->name() == NORMAL_ATTRIBUTE_NAME)
+            acc.usage = QStringLiteral("NORMAL");
+        else if (att->name() == TEXTCOORD_ATTRIBUTE_NAME)
+            acc.usage = QStringLiteral("TEXCOORD_0");
+        else if (att->name() == COLOR_ATTRIBUTE_NAME)
+            acc.usage = QStringLiteral("COLOR");
+        else if (att->name() == TANGENT_ATTRIBUTE_NAME)
+            acc.usage = QStringLiteral("TANGENT");
+        else
+            acc.usage = att->name();
+        acc.offset = startOffset * sizeof(float);
+        switch (att->vertexSize()) {
+        case 1:
+            acc.type = QStringLiteral("SCALAR");
+            break;
+        case 2:
+            acc.type = QStringLiteral("VEC2");
+            break;
+        case 3:
+            acc.type = QStringLiteral("VEC3");
+            break;
+        case 4:
+            acc.type = QStringLiteral("VEC4");
+            break;
+        case 9:
+            acc.type = QStringLiteral("MAT3");
+            break;
+        case 16:
+            acc.type = QStringLiteral("MAT4");
+            break;
+        default:
+            qCWarning(GLTFExporterLog, "Invalid vertex size: %d", att->vertexSize());
+            break;
+        }
+        meshInfo.accessors.append(acc);
+        startOffset += att->vertexSize();
+    }
+
+    // Index
+    if (data.indexAttribute) {
+        acc.name = newAccessorName();
+        acc.usage = QStringLiteral("INDEX");
+        acc.bufferView = indexBufView.name;
+        acc.offset = 0;
+        acc.stride = 0;
+        acc.count = data.indexCount;
+        acc.componentType = indexBufView.componentType;
+        acc.type = QStringLiteral("SCALAR");
+        meshInfo.accessors.append(acc);
+    }
 
-        meshCount++;
-        m_meshInfo.insert(renderer, meshInfo);
+    // Views are kept 4 byte aligned, for the float views following 16 bit indices
+    const qint64 padding = (4 - data.indexBuffer.size() % 4) % 4;
+    if (device->write(data.vertexBuffer) != data.vertexBuffer.size()
+            || device->write(data.indexBuffer) != data.indexBuffer.size()
+            || device->write(QByteArray(padding, '\0')) != padding) {
+        return false;
+    }
+    m_bufferSize += data.vertexBuffer.size() + data.indexBuffer.size() + padding;
+
+    if (GLTFExporterLog().isDebugEnabled()) {
+        qCDebug(GLTFExporterLog, "  Mesh #%i: (%ls/%ls)", int(m_meshInfo.size()),
+                qUtf16PrintableImpl(meshInfo.name), qUtf16PrintableImpl(meshInfo.originalName));
+        qCDebug(GLTFExporterLog, "    Vertex count: %i", data.vertexCount);
+        qCDebug(GLTFExporterLog, "    Bytes per vertex: %i", int(data.vertexSize * sizeof(float)));
+        qCDebug(GLTFExporterLog, "    Vertex buffer size (bytes): %i", int(data.vertexBuffer.size()));
+        qCDebug(GLTFExporterLog, "    Index buffer size (bytes): %i", int(data.indexBuffer.size()));
+        QStringList sl;
+        for (const auto &bv : qAsConst(meshInfo.views))
+            sl << bv.name;
+        qCDebug(GLTFExporterLog) << "    buffer views:" << sl;
+        sl.clear();
+        for (const auto &acc : qAsConst(meshInfo.accessors))
+            sl << acc.name;
+        qCDebug(GLTFExporterLog) << "    accessors:" << sl;
+        qCDebug(GLTFExporterLog, "    material: '%ls'",
+                qUtf16PrintableImpl(meshInfo.materialName));
     }
 
-    qCDebug(GLTFExporterLog, "Total buffer size: %i", m_buffer.size());
+    data.vertexBuffer.clear();
+    data.indexBuffer.clear();
+    m_meshInfo.insert(data.renderer, meshInfo);
+    return true;
 }
 
 void GLTFExporter::parseCameras()
@@ -1186,6 +1388,12 @@ bool GLTFExporter::saveScene()
             accList << acc;
     }
 
+    // Binary exports append textures and shaders to the buffer file, which
+    // needs to be done before its views and length are saved
+    copyTextures();
+    createShaders();
+    bvList << m_embeddedViews;
+
     m_obj = QJsonObject();
 
     QJsonObject asset;
@@ -1194,34 +1402,28 @@ bool GLTFExporter::saveScene()
     asset["premultipliedAlpha"] = true;
     m_obj["asset"] = asset;
 
-    QString bufName = m_exportName + QStringLiteral(".bin");
-    QString binFileName = m_exportDir + bufName;
-    QFile f(binFileName);
-    QFileInfo fiBin(binFileName);
-
-    if (f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-        qCDebug(GLTFExporterLog, "  Writing '%ls'", qUtf16PrintableImpl(binFileName));
-        m_exportedFiles.insert(fiBin.fileName());
-        f.write(m_buffer);
-        f.close();
-    } else {
-        qCWarning(GLTFExporterLog, "  Creating buffers file '%ls' failed!",
-                  qUtf16PrintableImpl(binFileName));
-        return false;
-    }
-
+    // The buffer file was written while parsing the meshes. Binary exports
+    // copy it to their body, which is the content of the binary_glTF buffer
+    const QString bufferName = m_gltfOpts.binary ? BINARY_BUFFER_NAME : QStringLiteral("buf");
     QJsonObject buffers;
     QJsonObject buffer;
-    buffer["byteLength"] = m_buffer.size();
+    buffer["byteLength"] = m_bufferSize;
     buffer["type"] = QStringLiteral("arraybuffer");
-    buffer["uri"] = bufName;
-    buffers["buf"] = buffer;
+    if (m_gltfOpts.binary) {
+        buffer["uri"] = BINARY_EMPTY_URI;
+        m_obj["extensionsUsed"] = QJsonArray({ BINARY_GLTF_EXTENSION });
+    } else {
+        const QString bufName = QFileInfo(m_bufferFileName).fileName();
+        m_exportedFiles.insert(bufName);
+        buffer["uri"] = bufName;
+    }
+    buffers[bufferName] = buffer;
     m_obj["buffers"] = buffers;
 
     QJsonObject bufferViews;
     for (const auto &bv : qAsConst(bvList)) {
         QJsonObject bufferView;
-        bufferView["buffer"] = QStringLiteral("buf");
+        bufferView["buffer"] = bufferName;
         bufferView["byteLength"] = int(bv.length);
         bufferView["byteOffset"] = int(bv.offset);
         if (bv.target)
@@ -1521,17 +1723,22 @@ bool GLTFExporter::saveScene()
     QJsonObject shaders;
     for (const auto &si : qAsConst(m_shaderInfo)) {
         QJsonObject shaderObj;
-        shaderObj["uri"] = si.uri;
+        if (m_gltfOpts.binary) {
+            QJsonObject binaryObj;
+            binaryObj["bufferView"] = si.bufferView;
+            QJsonObject extensions;
+            extensions[BINARY_GLTF_EXTENSION] = binaryObj;
+            shaderObj["extensions"] = extensions;
+            shaderObj["uri"] = BINARY_EMPTY_URI;
+        } else {
+            shaderObj["uri"] = si.uri;
+        }
         shaders[si.name] = shaderObj;
 
     }
     if (shaders.size())
         m_obj["shaders"] = shaders;
 
-    // Copy textures and shaders into temporary directory
-    copyTextures();
-    createShaders();
-
     QJsonObject textures;
     QHash<QString, QString> imageKeyMap; // uri -> key
     for (auto it = m_textureIdMap.constBegin(); it != m_textureIdMap.constEnd(); ++it) {
@@ -1561,7 +1768,22 @@ bool GLTFExporter::saveScene()
     QJsonObject images;
     for (auto it = imageKeyMap.constBegin(); it != imageKeyMap.constEnd(); ++it) {
         QJsonObject image;
-        image["uri"] = m_imageMap.value(it.key());
+        if (m_gltfOpts.binary) {
+            const EmbeddedImage embeddedImage = m_embeddedImages.value(it.key());
+            if (!embeddedImage.bufferView.isEmpty()) {
+                QJsonObject binaryObj;
+                binaryObj["bufferView"] = embeddedImage.bufferView;
+                binaryObj["mimeType"] = embeddedImage.mimeType;
+                binaryObj["width"] = embeddedImage.size.width();
+                binaryObj["height"] = embeddedImage.size.height();
+                QJsonObject extensions;
+                extensions[BINARY_GLTF_EXTENSION] = binaryObj;
+                image["extensions"] = extensions;
+            }
+            image["uri"] = BINARY_EMPTY_URI;
+        } else {
+            image["uri"] = m_imageMap.value(it.key());
+        }
         images[it.value()] = image;
     }
     if (images.size())
@@ -1569,20 +1791,35 @@ bool GLTFExporter::saveScene()
 
     m_doc.setObject(m_obj);
 
-    QString gltfName = m_exportDir + m_exportName + QStringLiteral(".qgltf");
-    f.setFileName(gltfName);
-    qCDebug(GLTFExporterLog, "  Writing JSON file: '%ls'", qUtf16PrintableImpl(gltfName));
+    const QByteArray json = m_doc.toJson(m_gltfOpts.compactJson ? QJsonDocument::Compact
+                                                                 : QJsonDocument::Indented);
+    m_doc = QJsonDocument();
+    m_obj = QJsonObject();
 
-    if (f.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
-        m_exportedFiles.insert(QFileInfo(f.fileName()).fileName());
-        QByteArray json = m_doc.toJson(m_gltfOpts.compactJson ? QJsonDocument::Compact
-                                                              : QJsonDocument::Indented);
-        f.write(json);
-        f.close();
+    QFile f;
+    if (m_gltfOpts.binary) {
+        const QString glbName = m_exportDir + m_exportName + QStringLiteral(".glb");
+        qCDebug(GLTFExporterLog, "  Writing binary file: '%ls'", qUtf16PrintableImpl(glbName));
+        if (!writeBinaryGLTF(glbName, json)) {
+            qCWarning(GLTFExporterLog, "  Writing binary file '%ls' failed!",
+                      qUtf16PrintableImpl(glbName));
+            return false;
+        }
+        m_exportedFiles.insert(QFileInfo(glbName).fileName());
     } else {
-        qCWarning(GLTFExporterLog, "  Writing JSON file '%ls' failed!",
-                  qUtf16PrintableImpl(gltfName));
-        return false;
+        QString gltfName = m_exportDir + m_exportName + QStringLiteral(".qgltf");
+        f.setFileName(gltfName);
+        qCDebug(GLTFExporterLog, "  Writing JSON file: '%ls'", qUtf16PrintableImpl(gltfName));
+
+        if (f.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+            m_exportedFiles.insert(QFileInfo(f.fileName()).fileName());
+            f.write(json);
+            f.close();
+        } else {
+            qCWarning(GLTFExporterLog, "  Writing JSON file '%ls' failed!",
+                      qUtf16PrintableImpl(gltfName));
+            return false;
+        }
     }
 
     QString qrcName = m_exportDir + m_exportName + QStringLiteral(".qrc");
@@ -1610,6 +1847,52 @@ bool GLTFExporter::saveScene()
     return true;
 }
 
+// Writes a binary glTF file holding the json and, as its body, the content of
+// the buffer file, which is copied in blocks rather than read into memory at once
+bool GLTFExporter::writeBinaryGLTF(const QString &fileName, const QByteArray &json)
+{
+    QFile bufferFile(m_bufferFileName);
+    if (!bufferFile.open(QIODevice::ReadOnly))
+        return false;
+
+    // The json is padded with spaces, so that the body is 4 byte aligned
+    const qint64 jsonPadding = (4 - json.size() % 4) % 4;
+    const qint64 contentLength = json.size() + jsonPadding;
+    const qint64 length = GLB_HEADER_SIZE + contentLength + m_bufferSize;
+    if (length > std::numeric_limits<quint32>::max()) {
+        qCWarning(GLTFExporterLog, "  Scene is too large for a binary glTF file");
+        return false;
+    }
+
+    QFile f(fileName);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    auto writeUInt32 = [&f] (quint32 value) {
+        const quint32 littleEndianValue = qToLittleEndian(value);
+        return f.write(reinterpret_cast<const char *>(&littleEndianValue), sizeof(quint32))
+                == sizeof(quint32);
+    };
+
+    if (!writeUInt32(GLB_MAGIC) || !writeUInt32(GLB_VERSION) || !writeUInt32(quint32(length))
+            || !writeUInt32(quint32(contentLength)) || !writeUInt32(GLB_CONTENT_FORMAT_JSON)
+            || f.write(json) != json.size()
+            || f.write(QByteArray(jsonPadding, ' ')) != jsonPadding) {
+        return false;
+    }
+
+    const qint64 blockSize = 1 << 20;
+    qint64 copied = 0;
+    while (copied < m_bufferSize) {
+        const QByteArray block = bufferFile.read(qMin(blockSize, m_bufferSize - copied));
+        if (block.isEmpty() || f.write(block) != block.size())
+            return false;
+        copied += block.size();
+    }
+
+    return true;
+}
+
 void GLTFExporter::delNode(GLTFExporter::Node *n)
 {
     if (!n)
@@ -54,6 +54,7 @@
 #include <QtCore/qjsondocument.h>
 #include <QtCore/qjsonobject.h>
 #include <QtCore/qhash.h>
+#include <QtCore/qsize.h>
 #include <QtGui/qvector3d.h>
 
 #include <Qt3DRender/qabstractlight.h>
@@ -64,9 +65,12 @@
 QT_BEGIN_NAMESPACE
 
 class QByteArray;
+class QIODevice;
 
 namespace Qt3DCore {
+class QAttribute;
 class QEntity;
+class QGeometry;
 class QTransform;
 }
 
@@ -95,6 +99,7 @@ public:
 
     struct GltfOptions {
         bool compactJson;
+        bool binary;
     };
 
 private:
@@ -139,6 +144,21 @@ private:
         QString meshTypeStr;
     };
 
+    // Interleaved buffers of a custom mesh, built in parallel with the
+    // buffers of other meshes before being written to the buffer file
+    struct GeometryData {
+        QGeometryRenderer *renderer = nullptr;
+        Qt3DCore::QGeometry *geometry = nullptr;
+        MeshInfo meshInfo;
+        QList<Qt3DCore::QAttribute *> vertexAttributes;
+        Qt3DCore::QAttribute *indexAttribute = nullptr;
+        QByteArray vertexBuffer;
+        QByteArray indexBuffer;
+        int vertexCount = 0;
+        uint vertexSize = 0; // in floats
+        uint indexCount = 0;
+    };
+
     struct MaterialInfo {
         enum MaterialType {
             TypeCustom,
@@ -178,10 +198,18 @@ private:
     struct ShaderInfo {
         QString name;
         QString uri;
+        QString bufferView; // Binary exports only
         QShaderProgram::ShaderType type;
         QByteArray code;
     };
 
+    // Texture image stored in the body of a binary export
+    struct EmbeddedImage {
+        QString bufferView;
+        QString mimeType;
+        QSize size;
+    };
+
     struct CameraInfo {
         QString name;
         QString originalName;
@@ -220,10 +248,15 @@ private:
     void cacheDefaultProperties(PropertyCacheType type);
     void copyTextures();
     void createShaders();
+    QString embedData(QIODevice *device, const QByteArray &data);
+    QString embedData(QIODevice *device, QIODevice *source);
+    QString addEmbeddedView(QIODevice *device, qint64 length);
     void parseEntities(const Qt3DCore::QEntity *entity, Node *parentNode);
-    void parseScene();
+    bool parseScene();
     void parseMaterials();
-    void parseMeshes();
+    bool parseMeshes();
+    static void interleaveGeometry(GeometryData &data);
+    bool writeGeometry(QIODevice *device, GeometryData &data);
     void parseCameras();
     void parseLights();
     void parseTechniques(QMaterial *material);
@@ -231,6 +264,7 @@ private:
     QString addShaderInfo(QShaderProgram::ShaderType type, QByteArray code);
 
     bool saveScene();
+    bool writeBinaryGLTF(const QString &fileName, const QByteArray &json);
     void delNode(Node *n);
     QString exportNodes(Node *n, QJsonObject &nodes);
     void exportMaterials(QJsonObject &materials);
@@ -281,13 +315,18 @@ private:
     QJsonObject m_obj;
     QJsonDocument m_doc;
 
-    QByteArray m_buffer;
+    // Mesh data is streamed to the buffer file as the meshes are parsed
+    QString m_bufferFileName;
+    qint64 m_bufferSize;
     QHash<Node *, Qt3DRender::QGeometryRenderer *> m_meshMap;
     QHash<Node *, Qt3DRender::QMaterial *> m_materialMap;
     QHash<Node *, Qt3DRender::QCameraLens *> m_cameraMap;
     QHash<Node *, Qt3DRender::QAbstractLight *> m_lightMap;
     QHash<Node *, Qt3DCore::QTransform *> m_transformMap;
     QHash<QString, QString> m_imageMap; // Original texture URL -> generated filename
+    QHash<QString, EmbeddedImage> m_embeddedImages; // Original texture URL -> embedded image
+    // Views of the textures and shaders appended to the buffer file of binary exports
+    QList<MeshInfo::BufferView> m_embeddedViews;
     QHash<QString, QString> m_textureIdMap;
     QHash<Qt3DRender::QRenderPass *, QString> m_renderPassIdMap;
     QHash<Qt3DRender::QEffect *, QString> m_effectIdMap;
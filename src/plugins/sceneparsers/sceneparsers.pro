@@ -5,8 +5,12 @@ QT_FOR_CONFIG += 3dcore-private
 !ios:!tvos:!qcc:qtConfig(assimp):if(qtConfig(system-assimp)|android-clang|clang|win32-msvc)|if(gcc:greaterThan(QT_GCC_MAJOR_VERSION, 4)) {
     SUBDIRS += assimp
 }
-SUBDIRS += gltf
+SUBDIRS += gltf binaryscene
 
 qtConfig(temporaryfile):qtConfig(regularexpression) {
     SUBDIRS += gltfexport
 }
+
+qtConfig(temporaryfile) {
+    SUBDIRS += binarysceneexport
+}
@@ -151,6 +151,13 @@ public:
 
     virtual void render(bool swapBuffers) = 0;
 
+    // Pipelined rendering only prepares the frame in render() and submits it
+    // in submitPendingFrame() while the jobs of the next frame are running,
+    // trading one frame of latency for throughput
+    virtual void setPipelinedRendering(bool pipelined) { Q_UNUSED(pipelined); }
+    virtual bool isPipelinedRendering() const { return false; }
+    virtual void submitPendingFrame() {}
+
     virtual void cleanGraphicsResources() = 0;
 
     virtual bool isRunning() const = 0;
@@ -130,19 +130,25 @@ void CameraLens::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstTim
 
     BackendNode::syncFromFrontEnd(frontEnd, firstTime);
 
-    const Matrix4x4 projectionMatrix(node->projectionMatrix());
-    if (projectionMatrix != m_projection) {
-        m_projection = projectionMatrix;
-        markDirty(AbstractRenderer::AllDirty);
+    // Only consume the fields the frontend recorded as changed
+    const QCameraLensPrivate *d = static_cast<const QCameraLensPrivate *>(QNodePrivate::get(node));
+    const quint32 changedFields = firstTime ? ~0u : d->m_changedFields;
+
+    if (changedFields & QCameraLensPrivate::ProjectionMatrixField) {
+        const Matrix4x4 projectionMatrix(d->m_projectionMatrix);
+        if (projectionMatrix != m_projection) {
+            m_projection = projectionMatrix;
+            markDirty(AbstractRenderer::AllDirty);
+        }
     }
 
-    if (!qFuzzyCompare(node->exposure(), m_exposure)) {
-        m_exposure = node->exposure();
+    if ((changedFields & QCameraLensPrivate::ExposureField) && !qFuzzyCompare(d->m_exposure, m_exposure)) {
+        m_exposure = d->m_exposure;
         markDirty(AbstractRenderer::AllDirty);
     }
 
-    const QCameraLensPrivate *d = static_cast<const QCameraLensPrivate *>(QNodePrivate::get(node));
-    if (d->m_pendingViewAllRequest != m_pendingViewAllRequest) {
+    if ((changedFields & QCameraLensPrivate::ViewAllRequestField)
+            && d->m_pendingViewAllRequest != m_pendingViewAllRequest) {
         m_pendingViewAllRequest = d->m_pendingViewAllRequest;
 
         if (m_pendingViewAllRequest)
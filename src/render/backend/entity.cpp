@@ -120,6 +120,7 @@ void Entity::cleanup()
         qCDebug(Render::RenderNodes) << Q_FUNC_INFO;
 
         removeFromParentChildHandles();
+        m_nodeManagers->renderNodesManager()->removeLightEntity(m_handle);
 
         for (auto &childHandle : qAsConst(m_childrenHandles)) {
             auto child = m_nodeManagers->renderNodesManager()->data(childHandle);
@@ -240,6 +241,7 @@ void Entity::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
             const auto idAndType = QNodeIdTypePair(c->id(), QNodePrivate::findStaticMetaObject(c->metaObject()));
             addComponent(idAndType);
         }
+        updateLightEntityRegistration();
     }
 
     BackendNode::syncFromFrontEnd(frontEnd, firstTime);
@@ -352,6 +354,7 @@ void Entity::addComponent(Qt3DCore::QNodeIdTypePair idAndType)
     } else if (type->inherits(&QArmature::staticMetaObject)) {
         m_armatureComponent = id;
     }
+    updateLightEntityRegistration();
     markDirty(AbstractRenderer::AllDirty);
 }
 
@@ -389,9 +392,22 @@ void Entity::removeComponent(Qt3DCore::QNodeId nodeId)
     } else if (m_armatureComponent == nodeId) {
         m_armatureComponent = QNodeId();
     }
+    updateLightEntityRegistration();
     markDirty(AbstractRenderer::AllDirty);
 }
 
+void Entity::updateLightEntityRegistration()
+{
+    if (m_nodeManagers == nullptr || m_handle.isNull())
+        return;
+
+    EntityManager *manager = m_nodeManagers->renderNodesManager();
+    if (m_lightComponents.isEmpty() && m_environmentLightComponents.isEmpty())
+        manager->removeLightEntity(m_handle);
+    else
+        manager->addLightEntity(m_handle);
+}
+
 bool Entity::isBoundingVolumeDirty() const
 {
     return m_boundingDirty;
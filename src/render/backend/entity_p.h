@@ -182,6 +182,8 @@ protected:
     Q_DECLARE_PRIVATE(Entity)
 
 private:
+    void updateLightEntityRegistration();
+
     NodeManagers *m_nodeManagers;
     HEntity m_handle;
     HEntity m_parentHandle;
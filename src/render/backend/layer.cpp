@@ -78,8 +78,10 @@ void Layer::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstTime)
     if (isEnabled() != oldEnabled || firstTime)
         markDirty(AbstractRenderer::LayersDirty);
 
-    if (node->recursive() != m_recursive) {
-        m_recursive = node->recursive();
+    const QLayerPrivate *d = static_cast<const QLayerPrivate *>(QNodePrivate::get(node));
+    const quint32 changedFields = firstTime ? ~0u : d->m_changedFields;
+    if ((changedFields & QLayerPrivate::RecursiveField) && d->m_recursive != m_recursive) {
+        m_recursive = d->m_recursive;
         markDirty(AbstractRenderer::LayersDirty);
     }
 }
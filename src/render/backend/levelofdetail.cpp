@@ -56,6 +56,7 @@ LevelOfDetail::LevelOfDetail()
     , m_currentIndex(0)
     , m_thresholdType(QLevelOfDetail::DistanceToCameraThreshold)
     , m_volumeOverride()
+    , m_filterValue(0.)
 {
 }
 
@@ -81,6 +82,7 @@ void LevelOfDetail::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool first
 
     if (node->currentIndex() != m_currentIndex) {
         m_currentIndex = node->currentIndex();
+        m_filterValue = m_currentIndex;
         markDirty(AbstractRenderer::GeometryDirty);
     }
 
@@ -106,6 +108,7 @@ void LevelOfDetail::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool first
 void LevelOfDetail::cleanup()
 {
     QBackendNode::setEnabled(false);
+    m_filterValue = 0.;
 }
 
 void LevelOfDetail::setCurrentIndex(int currentIndex)
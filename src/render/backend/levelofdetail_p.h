@@ -78,19 +78,24 @@ public:
     Qt3DCore::QNodeId camera() const { return m_camera; }
     int currentIndex() const { return m_currentIndex; }
     QLevelOfDetail::ThresholdType thresholdType() const { return m_thresholdType; }
-    QList<qreal> thresholds() const { return m_thresholds; }
+    const QList<qreal> &thresholds() const { return m_thresholds; }
     float radius() const { return m_volumeOverride.radius(); }
     QVector3D center() const { return m_volumeOverride.center(); }
     bool hasBoundingVolumeOverride() const { return !m_volumeOverride.isEmpty(); }
 
     void setCurrentIndex(int currentIndex);
 
+    // Filtered index used by UpdateLevelOfDetailJob to smooth out index changes
+    double filterValue() const { return m_filterValue; }
+    void setFilterValue(double filterValue) { m_filterValue = filterValue; }
+
 private:
     Qt3DCore::QNodeId m_camera;
     int m_currentIndex;
     QLevelOfDetail::ThresholdType m_thresholdType;
     QList<qreal> m_thresholds;
     QLevelOfDetailBoundingSphere m_volumeOverride;
+    double m_filterValue;
 };
 
 } // namespace Render
@@ -86,6 +86,9 @@
 #include <Qt3DRender/private/shaderimage_p.h>
 #include <Qt3DRender/private/pickingproxy_p.h>
 
+#include <algorithm>
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DRender {
@@ -143,6 +146,26 @@ public:
                 e->setNodeManagers(nullptr);
         });
     }
+
+    // Entities referencing Light or EnvironmentLight components, maintained
+    // by the entities as their components change so that gathering lights
+    // doesn't require visiting every entity of the scene
+    void addLightEntity(HEntity handle)
+    {
+        if (std::find(m_lightEntities.begin(), m_lightEntities.end(), handle) == m_lightEntities.end())
+            m_lightEntities.push_back(handle);
+    }
+
+    void removeLightEntity(HEntity handle)
+    {
+        m_lightEntities.erase(std::remove(m_lightEntities.begin(), m_lightEntities.end(), handle),
+                              m_lightEntities.end());
+    }
+
+    const std::vector<HEntity> &lightEntities() const { return m_lightEntities; }
+
+private:
+    std::vector<HEntity> m_lightEntities;
 };
 
 class FrameGraphNode;
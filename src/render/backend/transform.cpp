@@ -39,6 +39,7 @@
 
 #include "transform_p.h"
 
+#include <Qt3DCore/private/qbackendnode_p.h>
 #include <Qt3DCore/private/qchangearbiter_p.h>
 #include <Qt3DCore/qtransform.h>
 #include <Qt3DCore/private/qtransform_p.h>
@@ -55,7 +56,12 @@ Transform::Transform()
     , m_rotation()
     , m_scale(1.0f, 1.0f, 1.0f)
     , m_translation()
+    , m_worldMatrixUpdatesEnabled(true)
+    , m_worldMatrixRefreshRequested(false)
 {
+    // Syncing only updates this node and marks the renderer dirty, which
+    // is safe to do concurrently
+    Qt3DCore::QBackendNodePrivate::get(this)->m_threadSafeSync = true;
 }
 
 void Transform::cleanup()
@@ -64,6 +70,8 @@ void Transform::cleanup()
     m_scale = QVector3D();
     m_translation = QVector3D();
     m_transformMatrix = Matrix4x4();
+    m_worldMatrixUpdatesEnabled = true;
+    m_worldMatrixRefreshRequested = false;
     QBackendNode::setEnabled(false);
 }
 
@@ -93,12 +101,33 @@ void Transform::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
     if (!transform)
         return;
 
-    bool dirty = m_rotation != transform->rotation();
-    m_rotation = transform->rotation();
-    dirty |= m_scale != transform->scale3D();
-    m_scale = transform->scale3D();
-    dirty |= m_translation != transform->translation();
-    m_translation = transform->translation();
+    // Only consume the fields the frontend recorded as changed
+    const QTransformPrivate *d = static_cast<const QTransformPrivate *>(QNodePrivate::get(transform));
+    const quint32 changedFields = firstTime ? ~0u : d->m_changedFields;
+    bool dirty = false;
+    if (changedFields & QTransformPrivate::RotationField) {
+        dirty |= m_rotation != d->m_rotation;
+        m_rotation = d->m_rotation;
+    }
+    if (changedFields & QTransformPrivate::ScaleField) {
+        dirty |= m_scale != d->m_scale;
+        m_scale = d->m_scale;
+    }
+    if (changedFields & QTransformPrivate::TranslationField) {
+        dirty |= m_translation != d->m_translation;
+        m_translation = d->m_translation;
+    }
+
+    if (changedFields & QTransformPrivate::WorldMatrixUpdatesField
+            && m_worldMatrixUpdatesEnabled != d->m_worldMatrixUpdatesEnabled) {
+        m_worldMatrixUpdatesEnabled = d->m_worldMatrixUpdatesEnabled;
+        // The frontend world matrices of the subtree are stale, make sure
+        // they get written back even if the world transforms don't change
+        if (m_worldMatrixUpdatesEnabled && !firstTime) {
+            m_worldMatrixRefreshRequested = true;
+            markDirty(AbstractRenderer::TransformDirty);
+        }
+    }
 
     if (dirty || firstTime) {
         updateMatrix();
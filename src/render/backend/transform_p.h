@@ -75,6 +75,11 @@ public:
     QVector3D scale() const;
     QQuaternion rotation() const;
     QVector3D translation() const;
+    bool worldMatrixUpdatesEnabled() const { return m_worldMatrixUpdatesEnabled; }
+    // Set when world matrix updates get enabled again, until the world
+    // matrices of the subtree have been written back once
+    bool isWorldMatrixRefreshRequested() const { return m_worldMatrixRefreshRequested; }
+    void clearWorldMatrixRefreshRequest() { m_worldMatrixRefreshRequested = false; }
 
     void syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstTime) final;
 
@@ -84,6 +89,8 @@ private:
     QQuaternion m_rotation;
     QVector3D m_scale;
     QVector3D m_translation;
+    bool m_worldMatrixUpdatesEnabled;
+    bool m_worldMatrixRefreshRequested;
 };
 
 } // namespace Render
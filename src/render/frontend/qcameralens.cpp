@@ -234,6 +234,7 @@ void QCameraLens::viewAll(Qt3DCore::QNodeId cameraId)
     Q_D(QCameraLens);
     if (d->m_projectionType == PerspectiveProjection || d->m_projectionType == OrthographicProjection) {
         d->m_pendingViewAllRequest = {Qt3DCore::QNodeId::createId(), cameraId, {}};
+        d->markFieldsChanged(QCameraLensPrivate::ViewAllRequestField);
         d->update();
     }
 }
@@ -243,6 +244,7 @@ void QCameraLens::viewEntity(Qt3DCore::QNodeId entityId, Qt3DCore::QNodeId camer
     Q_D(QCameraLens);
     if (d->m_projectionType == PerspectiveProjection || d->m_projectionType == OrthographicProjection) {
         d->m_pendingViewAllRequest = {Qt3DCore::QNodeId::createId(), cameraId, entityId};
+        d->markFieldsChanged(QCameraLensPrivate::ViewAllRequestField);
         d->update();
     }
 }
@@ -589,6 +591,7 @@ void QCameraLens::setProjectionMatrix(const QMatrix4x4 &projectionMatrix)
     if (qFuzzyCompare(d->m_projectionMatrix, projectionMatrix))
         return;
     d->m_projectionMatrix = projectionMatrix;
+    d->markFieldsChanged(QCameraLensPrivate::ProjectionMatrixField);
     emit projectionMatrixChanged(projectionMatrix);
 }
 
@@ -607,6 +610,7 @@ void QCameraLens::setExposure(float exposure)
     if (qFuzzyCompare(d->m_exposure, exposure))
         return;
     d->m_exposure = exposure;
+    d->markFieldsChanged(QCameraLensPrivate::ExposureField);
 
     emit exposureChanged(exposure);
 }
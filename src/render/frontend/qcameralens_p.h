@@ -86,6 +86,13 @@ class Q_3DRENDERSHARED_PRIVATE_EXPORT QCameraLensPrivate : public Qt3DCore::QCom
 public:
     QCameraLensPrivate();
 
+    // Fields recorded with markFieldsChanged()
+    enum ChangedField : quint32 {
+        ProjectionMatrixField = 1 << 0,
+        ExposureField = 1 << 1,
+        ViewAllRequestField = 1 << 2
+    };
+
     inline void updateProjectionMatrix()
     {
         switch (m_projectionType) {
@@ -131,6 +138,7 @@ private:
         Q_Q(QCameraLens);
         m_projectionMatrix.setToIdentity();
         m_projectionMatrix.perspective(m_fieldOfView, m_aspectRatio, m_nearPlane, m_farPlane);
+        markFieldsChanged(ProjectionMatrixField);
         Q_EMIT q->projectionMatrixChanged(m_projectionMatrix);
     }
 
@@ -139,6 +147,7 @@ private:
         Q_Q(QCameraLens);
         m_projectionMatrix.setToIdentity();
         m_projectionMatrix.ortho(m_left, m_right, m_bottom, m_top, m_nearPlane, m_farPlane);
+        markFieldsChanged(ProjectionMatrixField);
         Q_EMIT q->projectionMatrixChanged(m_projectionMatrix);
     }
 
@@ -147,6 +156,7 @@ private:
         Q_Q(QCameraLens);
         m_projectionMatrix.setToIdentity();
         m_projectionMatrix.frustum(m_left, m_right, m_bottom, m_top, m_nearPlane, m_farPlane);
+        markFieldsChanged(ProjectionMatrixField);
         Q_EMIT q->projectionMatrixChanged(m_projectionMatrix);
     }
 };
@@ -177,6 +177,7 @@ void QLayer::setRecursive(bool recursive)
     Q_D(QLayer);
     if (d->m_recursive != recursive) {
         d->m_recursive = recursive;
+        d->markFieldsChanged(QLayerPrivate::RecursiveField);
         emit recursiveChanged();
     }
 }
@@ -64,6 +64,11 @@ class Q_3DRENDERSHARED_PRIVATE_EXPORT QLayerPrivate : public Qt3DCore::QComponen
 public:
     QLayerPrivate();
 
+    // Fields recorded with markFieldsChanged()
+    enum ChangedField : quint32 {
+        RecursiveField = 1 << 0
+    };
+
     bool m_recursive;
 
     Q_DECLARE_PUBLIC(QLayer)
@@ -134,6 +134,7 @@
 #include <Qt3DRender/private/buffermanager_p.h>
 #include <Qt3DRender/private/geometryrenderermanager_p.h>
 #include <Qt3DRender/private/loadgeometryjob_p.h>
+#include <Qt3DRender/private/backgroundgeometryloader_p.h>
 #include <Qt3DRender/private/qsceneimportfactory_p.h>
 #include <Qt3DRender/private/qsceneimporter_p.h>
 #include <Qt3DRender/private/frustumculling_p.h>
@@ -293,6 +294,7 @@ QRenderAspectPrivate::QRenderAspectPrivate(QRenderAspect::SubmissionType submiss
     , m_renderer(nullptr)
     , m_initialized(false)
     , m_renderAfterJobs(submissionType == QRenderAspect::Automatic || qEnvironmentVariableIsSet("QT3D_FORCE_SYNCHRONOUS_RENDER"))
+    , m_pipelinedRendering(qEnvironmentVariableIntValue("QT3D_PIPELINED_RENDERING") > 0)
     , m_offscreenHelper(nullptr)
     , m_updateTreeEnabledJob(Render::UpdateTreeEnabledJobPtr::create())
     , m_worldTransformJob(Render::UpdateWorldTransformJobPtr::create())
@@ -305,12 +307,25 @@ QRenderAspectPrivate::QRenderAspectPrivate(QRenderAspect::SubmissionType submiss
     , m_syncLoadingJobs(CreateSynchronizerJobPtr([] {}, Render::JobTypes::SyncLoadingJobs))
     , m_pickBoundingVolumeJob(Render::PickBoundingVolumeJobPtr::create())
     , m_rayCastingJob(Render::RayCastingJobPtr::create())
+    , m_integrateLoadedGeometryJob(Render::IntegrateLoadedGeometryJobPtr::create())
     , m_pickEventFilter(new Render::PickEventFilter(this))
     , m_submissionType(submissionType)
 {
     m_instances.append(this);
     loadSceneParsers();
 
+    // Mesh files are loaded in the background unless QT3D_ASYNC_GEOMETRY_LOADING=0
+    if (!qEnvironmentVariableIsSet("QT3D_ASYNC_GEOMETRY_LOADING")
+            || qEnvironmentVariableIntValue("QT3D_ASYNC_GEOMETRY_LOADING") > 0) {
+        m_backgroundGeometryLoader.reset(new Render::BackgroundGeometryLoader);
+        if (qEnvironmentVariableIsSet("QT3D_GEOMETRY_LOADER_THREADS"))
+            m_backgroundGeometryLoader->setMaxThreadCount(qEnvironmentVariableIntValue("QT3D_GEOMETRY_LOADER_THREADS"));
+        m_integrateLoadedGeometryJob->setBackgroundLoader(m_backgroundGeometryLoader.data());
+        m_integrateLoadedGeometryJob->setMaxResultsPerFrame(qEnvironmentVariableIsSet("QT3D_GEOMETRY_LOADS_PER_FRAME")
+                                                            ? qEnvironmentVariableIntValue("QT3D_GEOMETRY_LOADS_PER_FRAME")
+                                                            : 4);
+    }
+
     m_updateWorldBoundingVolumeJob->addDependency(m_worldTransformJob);
     m_updateWorldBoundingVolumeJob->addDependency(m_calculateBoundingVolumeJob);
     m_calculateBoundingVolumeJob->addDependency(m_updateTreeEnabledJob);
@@ -349,6 +364,22 @@ QRenderAspectPrivate *QRenderAspectPrivate::get(QRenderAspect *q)
     return q->d_func();
 }
 
+/*! \internal */
+void QRenderAspectPrivate::updatePipelinedRendering()
+{
+    // Submission can only overlap with the jobs when we render after them.
+    // A frame left pending when disabling it is submitted by the next render
+    m_renderer->setPipelinedRendering(m_renderAfterJobs && m_pipelinedRendering);
+}
+
+void QRenderAspectPrivate::jobsRunning()
+{
+    // When pipelined, the frame prepared at the end of the previous
+    // processFrame is submitted while the jobs of this one are running
+    if (m_renderer->isPipelinedRendering())
+        m_renderer->submitPendingFrame();
+}
+
 void QRenderAspectPrivate::jobsDone()
 {
     m_renderer->jobsDone(m_aspectManager);
@@ -581,6 +612,26 @@ void QRenderAspectPrivate::registerBackendType(const QMetaObject &obj,
     q->registerBackendType(obj, functor);
 }
 
+/*! \internal */
+void QRenderAspectPrivate::reserveBackendNodes(const QMetaObject *metaObj, int count) const
+{
+    // Preallocate storage for the node types large scenes are made of
+    if (metaObj->inherits(&Qt3DCore::QEntity::staticMetaObject))
+        m_nodeManagers->renderNodesManager()->reserve(count);
+    else if (metaObj->inherits(&Qt3DCore::QTransform::staticMetaObject))
+        m_nodeManagers->transformManager()->reserve(count);
+    else if (metaObj->inherits(&QGeometryRenderer::staticMetaObject))
+        m_nodeManagers->geometryRendererManager()->reserve(count);
+    else if (metaObj->inherits(&Qt3DCore::QGeometry::staticMetaObject))
+        m_nodeManagers->geometryManager()->reserve(count);
+    else if (metaObj->inherits(&Qt3DCore::QAttribute::staticMetaObject))
+        m_nodeManagers->attributeManager()->reserve(count);
+    else if (metaObj->inherits(&Qt3DCore::QBuffer::staticMetaObject))
+        m_nodeManagers->bufferManager()->reserve(count);
+    else if (metaObj->inherits(&QMaterial::staticMetaObject))
+        m_nodeManagers->materialManager()->reserve(count);
+}
+
 /*!
  * \enum QRenderAspect::SubmissionType
  *
@@ -618,6 +669,40 @@ QRenderAspect::QRenderAspect(QRenderAspect::SubmissionType submissionType,
 
 }
 
+/*!
+ * Sets whether the rendering commands of a frame are submitted while the jobs
+ * of the next frame are running, as specified by \a enabled. This trades one
+ * frame of latency for throughput in CPU bound scenes. It is only effective
+ * with the Automatic submission type and with renderers supporting it, the
+ * RHI one at the time of writing.
+ *
+ * Pipelined rendering is disabled by default, unless the
+ * QT3D_PIPELINED_RENDERING environment variable is set to 1.
+ *
+ * \since 6.0
+ */
+void QRenderAspect::setPipelinedRenderingEnabled(bool enabled)
+{
+    Q_D(QRenderAspect);
+    if (d->m_pipelinedRendering == enabled)
+        return;
+    d->m_pipelinedRendering = enabled;
+    if (d->m_renderer)
+        d->updatePipelinedRendering();
+}
+
+/*!
+ * Returns whether pipelined rendering was requested.
+ *
+ * \since 6.0
+ * \sa setPipelinedRenderingEnabled()
+ */
+bool QRenderAspect::isPipelinedRenderingEnabled() const
+{
+    Q_D(const QRenderAspect);
+    return d->m_pipelinedRendering;
+}
+
 /*! \internal */
 QRenderAspect::QRenderAspect(QRenderAspectPrivate &dd, QObject *parent)
     : QAbstractAspect(dd, parent)
@@ -685,6 +770,10 @@ std::vector<Qt3DCore::QAspectJobPtr> QRenderAspect::jobsToExecute(qint64 time)
         const std::vector<QAspectJobPtr> geometryJobs = d->createGeometryRendererJobs();
         jobs.insert(jobs.end(), std::make_move_iterator(geometryJobs.begin()), std::make_move_iterator(geometryJobs.end()));
 
+        // Geometries loaded in the background since the previous frame
+        if (d->m_backgroundGeometryLoader && d->m_backgroundGeometryLoader->hasCompletedResults())
+            jobs.push_back(d->m_integrateLoadedGeometryJob);
+
         const std::vector<QAspectJobPtr> preRenderingJobs = d->createPreRendererJobs();
         jobs.insert(jobs.end(), std::make_move_iterator(preRenderingJobs.begin()), std::make_move_iterator(preRenderingJobs.end()));
 
@@ -790,6 +879,7 @@ void QRenderAspect::onRegistered()
     // and started.
     Q_D(QRenderAspect);
     d->createNodeManagers();
+    d->m_integrateLoadedGeometryJob->setNodeManagers(d->m_nodeManagers);
 
     // Load proper Renderer class based on Qt configuration preferences
     d->m_renderer = d->loadRendererPlugin();
@@ -797,6 +887,7 @@ void QRenderAspect::onRegistered()
     d->m_renderer->setScreen(d->m_screen);
     d->m_renderer->setAspect(this);
     d->m_renderer->setNodeManagers(d->m_nodeManagers);
+    d->updatePipelinedRendering();
 
     // Create a helper for deferring creation of an offscreen surface used during cleanup
     // to the main thread, after we know what the surface format in use is.
@@ -840,6 +931,12 @@ void QRenderAspect::onUnregistered()
 
     d->m_renderer->releaseGraphicsResources();
 
+    // Running mesh loaders can still reference the node managers
+    if (d->m_backgroundGeometryLoader) {
+        d->m_backgroundGeometryLoader->cancelAll();
+        d->m_backgroundGeometryLoader->waitForDone();
+    }
+
     delete d->m_nodeManagers;
     d->m_nodeManagers = nullptr;
 
@@ -865,6 +962,7 @@ std::vector<Qt3DCore::QAspectJobPtr> QRenderAspectPrivate::createGeometryRendere
         if (!geometryRendererHandle.isNull()) {
             auto job = Render::LoadGeometryJobPtr::create(geometryRendererHandle);
             job->setNodeManagers(m_nodeManagers);
+            job->setBackgroundLoader(m_backgroundGeometryLoader.data());
             dirtyGeometryRendererJobs.push_back(job);
         }
     }
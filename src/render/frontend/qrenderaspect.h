@@ -78,6 +78,9 @@ public:
     explicit QRenderAspect(SubmissionType submissionType, QObject *parent = nullptr);
     ~QRenderAspect();
 
+    void setPipelinedRenderingEnabled(bool enabled);
+    bool isPipelinedRenderingEnabled() const;
+
 protected:
     QRenderAspect(QRenderAspectPrivate &dd, QObject *parent);
     Q_DECLARE_PRIVATE(QRenderAspect)
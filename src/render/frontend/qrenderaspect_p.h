@@ -64,6 +64,7 @@
 #include <Qt3DRender/private/genericlambdajob_p.h>
 #include <Qt3DRender/private/pickboundingvolumejob_p.h>
 #include <Qt3DRender/private/raycastingjob_p.h>
+#include <Qt3DRender/private/loadgeometryjob_p.h>
 
 #include <QtCore/qmutex.h>
 
@@ -78,6 +79,7 @@ class QSceneImporter;
 
 namespace Render {
 class AbstractRenderer;
+class BackgroundGeometryLoader;
 class NodeManagers;
 class QRenderPlugin;
 }
@@ -103,6 +105,8 @@ public:
     static QRenderAspectPrivate* findPrivate(Qt3DCore::QAspectEngine *engine);
     static QRenderAspectPrivate *get(QRenderAspect *q);
 
+    void updatePipelinedRendering();
+    void jobsRunning() override;
     void jobsDone() override;
     void frameDone() override;
 
@@ -114,6 +118,7 @@ public:
     void loadSceneParsers();
     void loadRenderPlugin(const QString &pluginName);
     void registerBackendType(const QMetaObject &, const Qt3DCore::QBackendNodeMapperPtr &functor);
+    void reserveBackendNodes(const QMetaObject *metaObj, int count) const override;
     std::vector<Qt3DCore::QAspectJobPtr> createGeometryRendererJobs() const;
     std::vector<Qt3DCore::QAspectJobPtr> createPreRendererJobs() const;
     std::vector<Qt3DCore::QAspectJobPtr> createRenderBufferJobs() const;
@@ -127,6 +132,7 @@ public:
 
     bool m_initialized;
     const bool m_renderAfterJobs;
+    bool m_pipelinedRendering;
     QList<QSceneImporter *> m_sceneImporter;
     QList<QString> m_loadedPlugins;
     QList<Render::QRenderPlugin *> m_renderPlugins;
@@ -144,6 +150,10 @@ public:
     Render::SynchronizerJobPtr m_syncLoadingJobs;
     Render::PickBoundingVolumeJobPtr m_pickBoundingVolumeJob;
     Render::RayCastingJobPtr m_rayCastingJob;
+    Render::IntegrateLoadedGeometryJobPtr m_integrateLoadedGeometryJob;
+
+    // Null when mesh files are loaded in the frame jobs
+    QScopedPointer<Render::BackgroundGeometryLoader> m_backgroundGeometryLoader;
 
     QScopedPointer<Render::PickEventFilter> m_pickEventFilter;
     QRenderAspect::SubmissionType m_submissionType;
@@ -0,0 +1,203 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB)
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "backgroundgeometryloader_p.h"
+#include <QtCore/QThread>
+#include <Qt3DCore/qgeometry.h>
+
+#include <algorithm>
+#include <iterator>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+BackgroundGeometryLoader::BackgroundGeometryLoader()
+{
+    // Leave most of the cores to the frame jobs
+    m_threadPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() / 4));
+    m_threadPool.setObjectName(QStringLiteral("Qt3D Geometry Loader"));
+}
+
+BackgroundGeometryLoader::~BackgroundGeometryLoader()
+{
+    cancelAll();
+    waitForDone();
+}
+
+void BackgroundGeometryLoader::setMaxThreadCount(int maxThreadCount)
+{
+    m_threadPool.setMaxThreadCount(qMax(1, maxThreadCount));
+}
+
+int BackgroundGeometryLoader::maxThreadCount() const
+{
+    return m_threadPool.maxThreadCount();
+}
+
+void BackgroundGeometryLoader::requestLoad(Qt3DCore::QNodeId geometryRendererId,
+                                           const Qt3DCore::QGeometryFactoryPtr &factory,
+                                           const Qt3DCore::QGeometryFactoryPtr &runner)
+{
+    cancel(geometryRendererId);
+
+    RequestPtr request = RequestPtr::create();
+    request->geometryRendererId = geometryRendererId;
+    request->factory = factory;
+    request->runner = runner ? runner : factory;
+    {
+        QMutexLocker lock(&m_mutex);
+        m_pendingRequests.insert(geometryRendererId, request);
+    }
+
+    m_threadPool.start([this, request] { execute(request); });
+}
+
+// A functor that is already running can't be interrupted, its result is
+// discarded once it completes
+void BackgroundGeometryLoader::cancel(Qt3DCore::QNodeId geometryRendererId)
+{
+    std::vector<Result> discardedResults;
+    {
+        QMutexLocker lock(&m_mutex);
+        const RequestPtr request = m_pendingRequests.take(geometryRendererId);
+        if (request)
+            request->cancelled.storeRelaxed(1);
+
+        const auto it = std::stable_partition(m_completedResults.begin(), m_completedResults.end(),
+                                              [geometryRendererId] (const Result &result) {
+            return result.geometryRendererId != geometryRendererId;
+        });
+        std::move(it, m_completedResults.end(), std::back_inserter(discardedResults));
+        m_completedResults.erase(it, m_completedResults.end());
+    }
+
+    for (const Result &result : discardedResults)
+        discardResult(result);
+}
+
+void BackgroundGeometryLoader::cancelAll()
+{
+    std::vector<Result> discardedResults;
+    {
+        QMutexLocker lock(&m_mutex);
+        for (const RequestPtr &request : qAsConst(m_pendingRequests))
+            request->cancelled.storeRelaxed(1);
+        m_pendingRequests.clear();
+        discardedResults.swap(m_completedResults);
+    }
+
+    for (const Result &result : discardedResults)
+        discardResult(result);
+}
+
+void BackgroundGeometryLoader::waitForDone()
+{
+    m_threadPool.waitForDone();
+}
+
+bool BackgroundGeometryLoader::isLoading(Qt3DCore::QNodeId geometryRendererId) const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_pendingRequests.contains(geometryRendererId);
+}
+
+int BackgroundGeometryLoader::pendingCount() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_pendingRequests.size();
+}
+
+bool BackgroundGeometryLoader::hasCompletedResults() const
+{
+    QMutexLocker lock(&m_mutex);
+    return !m_completedResults.empty();
+}
+
+std::vector<BackgroundGeometryLoader::Result> BackgroundGeometryLoader::takeCompletedResults(int maxResults)
+{
+    std::vector<Result> results;
+    QMutexLocker lock(&m_mutex);
+    if (maxResults <= 0 || size_t(maxResults) >= m_completedResults.size()) {
+        results.swap(m_completedResults);
+        return results;
+    }
+
+    results.assign(std::make_move_iterator(m_completedResults.begin()),
+                   std::make_move_iterator(m_completedResults.begin() + maxResults));
+    m_completedResults.erase(m_completedResults.begin(), m_completedResults.begin() + maxResults);
+    return results;
+}
+
+void BackgroundGeometryLoader::discardResult(const Result &result)
+{
+    // The geometry was moved to the main thread
+    if (result.result.geometry)
+        result.result.geometry->deleteLater();
+}
+
+// Loader threads
+void BackgroundGeometryLoader::execute(const RequestPtr &request)
+{
+    if (request->cancelled.loadRelaxed())
+        return;
+
+    Result result { request->geometryRendererId, request->factory,
+                    GeometryRenderer::runFunctor(request->runner) };
+
+    {
+        QMutexLocker lock(&m_mutex);
+        // Still the current request for that geometry renderer
+        if (!request->cancelled.loadRelaxed()) {
+            m_pendingRequests.remove(request->geometryRendererId);
+            m_completedResults.push_back(std::move(result));
+            return;
+        }
+    }
+    discardResult(result);
+}
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
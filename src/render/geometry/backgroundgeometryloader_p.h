@@ -0,0 +1,135 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB)
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QT3DRENDER_RENDER_BACKGROUNDGEOMETRYLOADER_P_H
+#define QT3DRENDER_RENDER_BACKGROUNDGEOMETRYLOADER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QThreadPool>
+#include <Qt3DCore/private/qgeometryfactory_p.h>
+#include <Qt3DCore/qnodeid.h>
+#include <Qt3DRender/private/geometryrenderer_p.h>
+#include <Qt3DRender/private/qt3drender_global_p.h>
+
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+// Executes geometry functors on a dedicated thread pool so that loading large
+// meshes never stalls the jobs of a frame. The results are picked up by a
+// later frame, a limited number at a time.
+class Q_3DRENDERSHARED_PRIVATE_EXPORT BackgroundGeometryLoader
+{
+public:
+    struct Result
+    {
+        Qt3DCore::QNodeId geometryRendererId;
+        Qt3DCore::QGeometryFactoryPtr factory; // To discard results of replaced functors
+        GeometryFunctorResult result;
+    };
+
+    BackgroundGeometryLoader();
+    ~BackgroundGeometryLoader();
+
+    void setMaxThreadCount(int maxThreadCount);
+    int maxThreadCount() const;
+
+    // Supersedes any pending request of the same geometry renderer. The
+    // runner, the factory itself if null, is what gets executed. The factory
+    // identifies the result.
+    void requestLoad(Qt3DCore::QNodeId geometryRendererId,
+                     const Qt3DCore::QGeometryFactoryPtr &factory,
+                     const Qt3DCore::QGeometryFactoryPtr &runner = {});
+    void cancel(Qt3DCore::QNodeId geometryRendererId);
+    void cancelAll();
+    void waitForDone();
+
+    bool isLoading(Qt3DCore::QNodeId geometryRendererId) const;
+    int pendingCount() const;
+    bool hasCompletedResults() const;
+
+    // Oldest results first, all of them when maxResults <= 0
+    std::vector<Result> takeCompletedResults(int maxResults);
+
+    static void discardResult(const Result &result);
+
+private:
+    struct Request
+    {
+        Qt3DCore::QNodeId geometryRendererId;
+        Qt3DCore::QGeometryFactoryPtr factory;
+        Qt3DCore::QGeometryFactoryPtr runner;
+        QAtomicInt cancelled;
+    };
+    using RequestPtr = QSharedPointer<Request>;
+
+    void execute(const RequestPtr &request);
+
+    QThreadPool m_threadPool;
+    mutable QMutex m_mutex;
+    QHash<Qt3DCore::QNodeId, RequestPtr> m_pendingRequests;
+    std::vector<Result> m_completedResults;
+};
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_RENDER_BACKGROUNDGEOMETRYLOADER_P_H
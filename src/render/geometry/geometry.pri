@@ -2,6 +2,7 @@ INCLUDEPATH += $$PWD
 
 HEADERS += \
     $$PWD/attribute_p.h \
+    $$PWD/backgroundgeometryloader_p.h \
     $$PWD/buffer_p.h \
     $$PWD/buffermanager_p.h \
     $$PWD/geometry_p.h \
@@ -16,12 +17,15 @@ HEADERS += \
     $$PWD/gltfskeletonloader_p.h \
     $$PWD/skeletondata_p.h \
     $$PWD/joint_p.h \
+    $$PWD/meshoptimizer_p.h \
     $$PWD/qpickingproxy.h \
     $$PWD/qpickingproxy_p.h \
-    $$PWD/pickingproxy_p.h
+    $$PWD/pickingproxy_p.h \
+    $$PWD/vertexattributegenerators_p.h
 
 SOURCES += \
     $$PWD/attribute.cpp \
+    $$PWD/backgroundgeometryloader.cpp \
     $$PWD/buffer.cpp \
     $$PWD/buffermanager.cpp \
     $$PWD/geometry.cpp \
@@ -34,5 +38,7 @@ SOURCES += \
     $$PWD/gltfskeletonloader.cpp \
     $$PWD/skeletondata.cpp \
     $$PWD/joint.cpp \
+    $$PWD/meshoptimizer.cpp \
     $$PWD/qpickingproxy.cpp \
-    $$PWD/pickingproxy.cpp
+    $$PWD/pickingproxy.cpp \
+    $$PWD/vertexattributegenerators.cpp
@@ -167,26 +167,46 @@ void GeometryRenderer::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
 
 GeometryFunctorResult GeometryRenderer::executeFunctor()
 {
-    Q_ASSERT(m_geometryFactory);
+    return runFunctor(prepareFunctor());
+}
 
-    // What kind of functor are we dealing with?
-    const bool isQMeshFunctor = m_geometryFactory->id() == Qt3DCore::functorTypeId<MeshLoaderFunctor>();
+bool GeometryRenderer::isMeshLoaderFunctor() const
+{
+    return m_geometryFactory && m_geometryFactory->id() == Qt3DCore::functorTypeId<MeshLoaderFunctor>();
+}
 
-    if (isQMeshFunctor) {
-        QSharedPointer<MeshLoaderFunctor> meshLoader = qSharedPointerCast<MeshLoaderFunctor>(m_geometryFactory);
+// Provides the functor with what it needs from the backend before it runs.
+// Mesh loaders run on a snapshot, as an earlier request may still be running
+// on a loader thread while the functor of this node is updated.
+Qt3DCore::QGeometryFactoryPtr GeometryRenderer::prepareFunctor()
+{
+    Q_ASSERT(m_geometryFactory);
+
+    if (isMeshLoaderFunctor()) {
+        QSharedPointer<MeshLoaderFunctor> meshLoader = qSharedPointerCast<MeshLoaderFunctor>(m_geometryFactory)->clone();
 
         // Set the aspect engine to allow remote downloads
         if (meshLoader->nodeManagers() == nullptr)
             meshLoader->setNodeManagers(m_renderer->nodeManagers());
 
-        if (meshLoader->downloaderService() == nullptr) {
-            Qt3DCore::QServiceLocator *services = m_renderer->services();
+        Qt3DCore::QServiceLocator *services = m_renderer->services();
+        if (meshLoader->downloaderService() == nullptr && services != nullptr)
             meshLoader->setDownloaderService(services->service<Qt3DCore::QDownloadHelperService>(Qt3DCore::QServiceLocator::DownloadHelperService));
-        }
+        return meshLoader;
     }
 
+    return m_geometryFactory;
+}
+
+GeometryFunctorResult GeometryRenderer::runFunctor(const Qt3DCore::QGeometryFactoryPtr &factory)
+{
+    Q_ASSERT(factory);
+
+    // What kind of functor are we dealing with?
+    const bool isQMeshFunctor = factory->id() == Qt3DCore::functorTypeId<MeshLoaderFunctor>();
+
     // Load geometry
-    QGeometry *geometry = (*m_geometryFactory)();
+    QGeometry *geometry = (*factory)();
     QMesh::Status meshLoaderStatus = QMesh::None;
 
     // If the geometry is null, then we were either unable to load it (Error)
@@ -200,7 +220,7 @@ GeometryFunctorResult GeometryRenderer::executeFunctor()
 
     // Send Status
     if (isQMeshFunctor) {
-        QSharedPointer<MeshLoaderFunctor> meshLoader = qSharedPointerCast<MeshLoaderFunctor>(m_geometryFactory);
+        QSharedPointer<MeshLoaderFunctor> meshLoader = qSharedPointerCast<MeshLoaderFunctor>(factory);
         meshLoaderStatus = meshLoader->status();
     }
 
@@ -83,6 +83,11 @@ public:
     void setManager(GeometryRendererManager *manager);
     void syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstTime) override;
     GeometryFunctorResult executeFunctor();
+    Qt3DCore::QGeometryFactoryPtr prepareFunctor();
+    bool isMeshLoaderFunctor() const;
+
+    // Any thread, the functor needs to have been prepared
+    static GeometryFunctorResult runFunctor(const Qt3DCore::QGeometryFactoryPtr &factory);
 
     inline Qt3DCore::QNodeId geometryId() const { return m_geometryId; }
     inline int instanceCount() const { return m_instanceCount; }
@@ -0,0 +1,466 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB)
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "meshoptimizer_p.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QSet>
+#include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/qbuffer.h>
+#include <Qt3DCore/qgeometry.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt3DCore;
+
+namespace Qt3DRender {
+
+namespace MeshOptimizer {
+
+namespace {
+
+const unsigned int UnusedVertex = ~0u;
+
+// Size of the simulated cache, larger than actual hardware caches as the
+// scoring favors recently used vertices anyway
+const int VertexCacheSize = 32;
+
+float vertexScore(int cachePosition, int remainingTriangles)
+{
+    if (remainingTriangles == 0)
+        return -1.0f;
+
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        // The vertices of the last triangle get a fixed score so that the
+        // next triangle does not simply reuse the last edge
+        if (cachePosition < 3)
+            score = 0.75f;
+        else
+            score = std::pow(1.0f - float(cachePosition - 3) / float(VertexCacheSize - 3), 1.5f);
+    }
+
+    // Favor vertices with few triangles left so that they leave the cache for good
+    return score + 2.0f / std::sqrt(float(remainingTriangles));
+}
+
+int typeSize(QAttribute::VertexBaseType type)
+{
+    switch (type) {
+    case QAttribute::Byte:
+    case QAttribute::UnsignedByte:
+        return 1;
+    case QAttribute::Short:
+    case QAttribute::UnsignedShort:
+    case QAttribute::HalfFloat:
+        return 2;
+    case QAttribute::Int:
+    case QAttribute::UnsignedInt:
+    case QAttribute::Float:
+        return 4;
+    case QAttribute::Double:
+        return 8;
+    }
+    return 0;
+}
+
+struct AttributeLayout
+{
+    QAttribute *attribute;
+    const char *data;
+    int elementSize;
+    int stride;
+    int packedOffset;
+};
+
+// Checks that count elements of the attribute fit in its buffer
+bool isInBuffer(const QAttribute *attribute, int elementSize, int stride, int count)
+{
+    if (count == 0)
+        return true;
+    const qint64 end = qint64(attribute->byteOffset()) + qint64(count - 1) * stride + elementSize;
+    return end <= attribute->buffer()->data().size();
+}
+
+struct VertexKey
+{
+    const char *data;
+    int size;
+
+    bool operator==(const VertexKey &other) const
+    {
+        return memcmp(data, other.data, size) == 0;
+    }
+};
+
+inline size_t qHash(const VertexKey &key, size_t seed = 0) noexcept
+{
+    return qHashBits(key.data, key.size, seed);
+}
+
+QByteArray remapVertices(const QByteArray &vertices, int vertexSize, const unsigned int *remap, int vertexCount, int newVertexCount)
+{
+    QByteArray remapped;
+    remapped.resize(qsizetype(newVertexCount) * vertexSize);
+    for (int i = 0; i < vertexCount; ++i) {
+        if (remap[i] != UnusedVertex)
+            memcpy(remapped.data() + qsizetype(remap[i]) * vertexSize, vertices.constData() + qsizetype(i) * vertexSize, vertexSize);
+    }
+    return remapped;
+}
+
+} // anonymous
+
+void optimizeVertexCache(unsigned int *indices, int indexCount, int vertexCount)
+{
+    const int triangleCount = indexCount / 3;
+    if (triangleCount < 2)
+        return;
+
+    for (int i = 0; i < triangleCount * 3; ++i) {
+        if (indices[i] >= unsigned(vertexCount))
+            return;
+    }
+
+    // Triangles using each vertex. The first remainingTriangles[v] entries
+    // of a vertex are the triangles not emitted yet
+    QList<int> offsets(vertexCount + 1, 0);
+    for (int i = 0; i < triangleCount * 3; ++i)
+        ++offsets[indices[i] + 1];
+    for (int v = 0; v < vertexCount; ++v)
+        offsets[v + 1] += offsets[v];
+    QList<int> remainingTriangles(vertexCount);
+    for (int v = 0; v < vertexCount; ++v)
+        remainingTriangles[v] = offsets[v + 1] - offsets[v];
+    QList<int> vertexTriangles(triangleCount * 3);
+    {
+        QList<int> cursors = offsets;
+        for (int i = 0; i < triangleCount * 3; ++i)
+            vertexTriangles[cursors[indices[i]]++] = i / 3;
+    }
+
+    QList<int> cachePositions(vertexCount, -1);
+    QList<float> vertexScores(vertexCount);
+    for (int v = 0; v < vertexCount; ++v)
+        vertexScores[v] = vertexScore(-1, remainingTriangles[v]);
+
+    const auto triangleScore = [&] (int triangle) {
+        const unsigned int *corners = indices + triangle * 3;
+        return vertexScores[corners[0]] + vertexScores[corners[1]] + vertexScores[corners[2]];
+    };
+
+    QList<float> triangleScores(triangleCount);
+    QList<bool> emitted(triangleCount, false);
+    int bestTriangle = 0;
+    for (int t = 0; t < triangleCount; ++t) {
+        triangleScores[t] = triangleScore(t);
+        if (triangleScores[t] > triangleScores[bestTriangle])
+            bestTriangle = t;
+    }
+
+    QList<unsigned int> output;
+    output.reserve(triangleCount * 3);
+    int cache[VertexCacheSize + 3];
+    int cacheSize = 0;
+    int nextUnemitted = 0;
+
+    for (int emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+        // When no triangle in the cache is left, restart from the first one not emitted
+        if (bestTriangle < 0) {
+            while (emitted[nextUnemitted])
+                ++nextUnemitted;
+            bestTriangle = nextUnemitted;
+        }
+
+        const unsigned int *corners = indices + bestTriangle * 3;
+        output.append(corners[0]);
+        output.append(corners[1]);
+        output.append(corners[2]);
+        emitted[bestTriangle] = true;
+
+        for (int k = 0; k < 3; ++k) {
+            const unsigned int v = corners[k];
+            int *begin = vertexTriangles.data() + offsets[v];
+            int *end = begin + remainingTriangles[v];
+            int *it = std::find(begin, end, bestTriangle);
+            if (it != end) {
+                std::swap(*it, *(end - 1));
+                --remainingTriangles[v];
+            }
+        }
+
+        // The vertices of the emitted triangle move to the front of the cache
+        int newCache[VertexCacheSize + 3];
+        int newCacheSize = 0;
+        for (int k = 0; k < 3; ++k) {
+            if (std::find(newCache, newCache + newCacheSize, int(corners[k])) == newCache + newCacheSize)
+                newCache[newCacheSize++] = corners[k];
+        }
+        const int triangleVertexCount = newCacheSize;
+        for (int i = 0; i < cacheSize; ++i) {
+            if (std::find(newCache, newCache + triangleVertexCount, cache[i]) == newCache + triangleVertexCount)
+                newCache[newCacheSize++] = cache[i];
+        }
+
+        for (int i = 0; i < newCacheSize; ++i) {
+            const int v = newCache[i];
+            cachePositions[v] = i < VertexCacheSize ? i : -1;
+            vertexScores[v] = vertexScore(cachePositions[v], remainingTriangles[v]);
+        }
+
+        // Only the triangles of the vertices that were in the cache changed score
+        bestTriangle = -1;
+        float bestScore = -1.0f;
+        for (int i = 0; i < newCacheSize; ++i) {
+            const int v = newCache[i];
+            for (int j = offsets[v], end = offsets[v] + remainingTriangles[v]; j < end; ++j) {
+                const int t = vertexTriangles[j];
+                triangleScores[t] = triangleScore(t);
+                if (triangleScores[t] > bestScore) {
+                    bestScore = triangleScores[t];
+                    bestTriangle = t;
+                }
+            }
+        }
+
+        cacheSize = qMin(newCacheSize, VertexCacheSize);
+        std::copy(newCache, newCache + cacheSize, cache);
+    }
+
+    std::copy(output.cbegin(), output.cend(), indices);
+}
+
+int vertexFetchRemap(unsigned int *remap, const unsigned int *indices, int indexCount, int vertexCount)
+{
+    std::fill(remap, remap + vertexCount, UnusedVertex);
+    int newVertexCount = 0;
+    for (int i = 0; i < indexCount; ++i) {
+        const unsigned int index = indices[i];
+        if (index < unsigned(vertexCount) && remap[index] == UnusedVertex)
+            remap[index] = newVertexCount++;
+    }
+    return newVertexCount;
+}
+
+int deduplicationRemap(unsigned int *remap, const char *vertices, int vertexCount, int vertexSize)
+{
+    QHash<VertexKey, unsigned int> uniqueVertices;
+    uniqueVertices.reserve(vertexCount);
+    for (int i = 0; i < vertexCount; ++i) {
+        const VertexKey key = { vertices + qsizetype(i) * vertexSize, vertexSize };
+        auto it = uniqueVertices.find(key);
+        if (it == uniqueVertices.end())
+            it = uniqueVertices.insert(key, unsigned(uniqueVertices.size()));
+        remap[i] = it.value();
+    }
+    return int(uniqueVertices.size());
+}
+
+bool optimizeGeometry(QGeometry *geometry,
+                      QGeometryRenderer::PrimitiveType primitiveType,
+                      QMesh::MeshOptimizations optimizations,
+                      bool ownsBuffers)
+{
+    if (!geometry || optimizations == QMesh::NoOptimization)
+        return false;
+
+    QAttribute *indexAttribute = nullptr;
+    QList<AttributeLayout> vertexAttributes;
+    int vertexCount = -1;
+    int packedSize = 0;
+
+    const QList<QAttribute *> attributes = geometry->attributes();
+    for (QAttribute *attribute : attributes) {
+        if (!attribute->buffer())
+            return false;
+
+        if (attribute->attributeType() == QAttribute::IndexAttribute) {
+            if (indexAttribute)
+                return false;
+            indexAttribute = attribute;
+            continue;
+        }
+
+        if (attribute->attributeType() != QAttribute::VertexAttribute || attribute->divisor() != 0)
+            return false;
+        if (vertexCount >= 0 && int(attribute->count()) != vertexCount)
+            return false;
+        vertexCount = int(attribute->count());
+
+        const int elementSize = typeSize(attribute->vertexBaseType()) * int(attribute->vertexSize());
+        const int stride = attribute->byteStride() ? int(attribute->byteStride()) : elementSize;
+        if (elementSize == 0 || !isInBuffer(attribute, elementSize, stride, vertexCount))
+            return false;
+
+        vertexAttributes.append({ attribute, attribute->buffer()->data().constData() + attribute->byteOffset(),
+                                  elementSize, stride, packedSize });
+        packedSize += (elementSize + 3) & ~3;
+    }
+
+    if (!indexAttribute || vertexAttributes.isEmpty())
+        return false;
+
+    const QAttribute::VertexBaseType indexType = indexAttribute->vertexBaseType();
+    if (indexType != QAttribute::UnsignedByte && indexType != QAttribute::UnsignedShort && indexType != QAttribute::UnsignedInt)
+        return false;
+    const int indexSize = typeSize(indexType);
+    const int indexStride = indexAttribute->byteStride() ? int(indexAttribute->byteStride()) : indexSize;
+    const int indexCount = int(indexAttribute->count());
+    if (!isInBuffer(indexAttribute, indexSize, indexStride, indexCount))
+        return false;
+
+    QList<unsigned int> indices(indexCount);
+    {
+        const char *data = indexAttribute->buffer()->data().constData() + indexAttribute->byteOffset();
+        for (int i = 0; i < indexCount; ++i, data += indexStride) {
+            switch (indexType) {
+            case QAttribute::UnsignedByte:
+                indices[i] = *reinterpret_cast<const quint8 *>(data);
+                break;
+            case QAttribute::UnsignedShort:
+                indices[i] = *reinterpret_cast<const quint16 *>(data);
+                break;
+            default:
+                indices[i] = *reinterpret_cast<const quint32 *>(data);
+                break;
+            }
+            if (indices[i] >= unsigned(vertexCount))
+                return false;
+        }
+    }
+
+    // Vertices are only rewritten when no other geometry can see the buffers,
+    // which also excludes index and vertex data sharing a buffer
+    bool rewriteVertices = ownsBuffers
+            && (optimizations & (QMesh::VertexFetchOptimization | QMesh::VertexDeduplication));
+    for (const AttributeLayout &layout : qAsConst(vertexAttributes)) {
+        if (layout.attribute->buffer() == indexAttribute->buffer())
+            rewriteVertices = false;
+    }
+
+    QByteArray vertices;
+    QList<unsigned int> remap(vertexCount);
+    if (rewriteVertices) {
+        vertices.resize(qsizetype(vertexCount) * packedSize);
+        for (const AttributeLayout &layout : qAsConst(vertexAttributes)) {
+            for (int v = 0; v < vertexCount; ++v) {
+                memcpy(vertices.data() + qsizetype(v) * packedSize + layout.packedOffset,
+                       layout.data + qsizetype(v) * layout.stride, layout.elementSize);
+            }
+        }
+
+        if (optimizations & QMesh::VertexDeduplication) {
+            const int uniqueCount = deduplicationRemap(remap.data(), vertices.constData(), vertexCount, packedSize);
+            if (uniqueCount < vertexCount) {
+                for (unsigned int &index : indices)
+                    index = remap[index];
+                vertices = remapVertices(vertices, packedSize, remap.constData(), vertexCount, uniqueCount);
+                vertexCount = uniqueCount;
+            }
+        }
+    }
+
+    if ((optimizations & QMesh::VertexCacheOptimization) && primitiveType == QGeometryRenderer::Triangles)
+        optimizeVertexCache(indices.data(), indexCount, vertexCount);
+
+    if (rewriteVertices && (optimizations & QMesh::VertexFetchOptimization)) {
+        const int usedCount = vertexFetchRemap(remap.data(), indices.constData(), indexCount, vertexCount);
+        for (unsigned int &index : indices)
+            index = remap[index];
+        vertices = remapVertices(vertices, packedSize, remap.constData(), vertexCount, usedCount);
+        vertexCount = usedCount;
+    }
+
+    QSet<Qt3DCore::QBuffer *> previousBuffers;
+    previousBuffers.insert(indexAttribute->buffer());
+
+    if (rewriteVertices) {
+        auto *vertexBuffer = new Qt3DCore::QBuffer(geometry);
+        vertexBuffer->setData(vertices);
+        for (const AttributeLayout &layout : qAsConst(vertexAttributes)) {
+            previousBuffers.insert(layout.attribute->buffer());
+            layout.attribute->setBuffer(vertexBuffer);
+            layout.attribute->setByteOffset(layout.packedOffset);
+            layout.attribute->setByteStride(packedSize);
+            layout.attribute->setCount(vertexCount);
+        }
+    }
+
+    // Indices keep their type, the vertex count never grows
+    QByteArray indexBytes;
+    indexBytes.resize(qsizetype(indexCount) * indexSize);
+    for (int i = 0; i < indexCount; ++i) {
+        switch (indexType) {
+        case QAttribute::UnsignedByte:
+            reinterpret_cast<quint8 *>(indexBytes.data())[i] = quint8(indices[i]);
+            break;
+        case QAttribute::UnsignedShort:
+            reinterpret_cast<quint16 *>(indexBytes.data())[i] = quint16(indices[i]);
+            break;
+        default:
+            reinterpret_cast<quint32 *>(indexBytes.data())[i] = indices[i];
+            break;
+        }
+    }
+    auto *indexBuffer = new Qt3DCore::QBuffer(geometry);
+    indexBuffer->setData(indexBytes);
+    indexAttribute->setBuffer(indexBuffer);
+    indexAttribute->setByteOffset(0);
+    indexAttribute->setByteStride(0);
+
+    if (ownsBuffers) {
+        for (const QAttribute *attribute : attributes)
+            previousBuffers.remove(attribute->buffer());
+        qDeleteAll(previousBuffers);
+    }
+
+    return true;
+}
+
+} // namespace MeshOptimizer
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
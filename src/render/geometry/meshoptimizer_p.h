@@ -0,0 +1,101 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB)
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QT3DRENDER_MESHOPTIMIZER_P_H
+#define QT3DRENDER_MESHOPTIMIZER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DRender/qgeometryrenderer.h>
+#include <Qt3DRender/qmesh.h>
+#include <Qt3DRender/private/qt3drender_global_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+class QGeometry;
+}
+
+namespace Qt3DRender {
+
+// Post load optimizations making indexed meshes cheaper to render: triangles
+// are reordered for post transform vertex cache reuse and vertices are
+// reordered in order of first use for memory fetch locality, optionally
+// merging vertices with identical attribute data first.
+namespace MeshOptimizer {
+
+// Remaps map old vertex indices to new ones, unused vertices are mapped to ~0u
+
+// Reorders the triangles of a triangle list using Forsyth's linear speed
+// vertex cache optimization
+Q_3DRENDERSHARED_PRIVATE_EXPORT void optimizeVertexCache(unsigned int *indices, int indexCount, int vertexCount);
+
+// Numbers vertices in order of first use, returns the number of vertices used
+Q_3DRENDERSHARED_PRIVATE_EXPORT int vertexFetchRemap(unsigned int *remap, const unsigned int *indices, int indexCount, int vertexCount);
+
+// Numbers vertices with identical bytes once, in order of first occurrence, and
+// returns the number of unique vertices
+Q_3DRENDERSHARED_PRIVATE_EXPORT int deduplicationRemap(unsigned int *remap, const char *vertices, int vertexCount, int vertexSize);
+
+// Applies the optimizations to an indexed geometry whose vertex attributes
+// all have the same count. Vertices are only rewritten when the geometry owns
+// its buffers, they are written to a new interleaved buffer and the buffers
+// left unused are deleted. Returns false if the geometry was left untouched.
+Q_3DRENDERSHARED_PRIVATE_EXPORT bool optimizeGeometry(Qt3DCore::QGeometry *geometry,
+                                                      QGeometryRenderer::PrimitiveType primitiveType,
+                                                      QMesh::MeshOptimizations optimizations,
+                                                      bool ownsBuffers);
+
+} // namespace MeshOptimizer
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_MESHOPTIMIZER_P_H
@@ -59,6 +59,7 @@
 #include <Qt3DRender/private/renderlogging_p.h>
 #include <Qt3DRender/private/qgeometryloaderfactory_p.h>
 #include <Qt3DRender/private/geometryrenderermanager_p.h>
+#include <Qt3DRender/private/meshoptimizer_p.h>
 
 #include <algorithm>
 
@@ -73,6 +74,7 @@ Q_GLOBAL_STATIC_WITH_ARGS(QFactoryLoader, geometryLoader, (QGeometryLoaderFactor
 QMeshPrivate::QMeshPrivate()
     : QGeometryRendererPrivate()
     , m_status(QMesh::None)
+    , m_optimizations(QMesh::NoOptimization)
 {
 }
 
@@ -94,6 +96,16 @@ void QMeshPrivate::updateFunctor()
     update();
 }
 
+// The optimizations depend on the primitive type the geometry is drawn with
+void QMeshPrivate::trackPrimitiveType()
+{
+    Q_Q(QMesh);
+    QObject::connect(q, &QGeometryRenderer::primitiveTypeChanged, q, [this] {
+        if (m_optimizations != QMesh::NoOptimization)
+            updateFunctor();
+    });
+}
+
 void QMeshPrivate::setStatus(QMesh::Status status)
 {
     if (m_status != status) {
@@ -149,6 +161,15 @@ void QMeshPrivate::setStatus(QMesh::Status status)
  * \sa QRegularExpression
  */
 
+/*!
+ * \qmlproperty enumeration Mesh::optimizations
+ *
+ * Holds the optimizations applied to the mesh once it has been loaded.
+ *
+ * \since 6.0
+ * \sa Qt3DRender::QMesh::MeshOptimization
+ */
+
 /*!
     \qmlproperty enumeration Mesh::status
 
@@ -198,12 +219,32 @@ void QMeshPrivate::setStatus(QMesh::Status status)
     \value Error             An error occurred while loading the mesh
 */
 
+/*!
+    \enum Qt3DRender::QMesh::MeshOptimization
+    \since 6.0
+
+    This enum identifies the optimizations applied to a mesh after loading it.
+    They cost some loading time and make the mesh cheaper to render every frame.
+    Triangles are only reordered for the primitive types made of triangles.
+
+    \value NoOptimization           The mesh is used as loaded
+    \value VertexCacheOptimization  Triangles are reordered to reuse the
+                                    vertices recently transformed by the GPU
+    \value VertexFetchOptimization  Vertices are reordered in the order the
+                                    triangles use them and unused vertices are
+                                    dropped
+    \value VertexDeduplication      Vertices with identical attributes are
+                                    merged
+*/
+
 /*!
  * Constructs a new QMesh with \a parent.
  */
 QMesh::QMesh(QNode *parent)
     : QGeometryRenderer(*new QMeshPrivate, parent)
 {
+    Q_D(QMesh);
+    d->trackPrimitiveType();
 }
 
 /*! \internal */
@@ -215,6 +256,8 @@ QMesh::~QMesh()
 QMesh::QMesh(QMeshPrivate &dd, QNode *parent)
     : QGeometryRenderer(dd, parent)
 {
+    Q_D(QMesh);
+    d->trackPrimitiveType();
 }
 
 void QMesh::setSource(const QUrl& source)
@@ -263,6 +306,34 @@ QString QMesh::meshName() const
     return d->m_meshName;
 }
 
+void QMesh::setOptimizations(MeshOptimizations optimizations)
+{
+    Q_D(QMesh);
+    if (d->m_optimizations == optimizations)
+        return;
+    d->m_optimizations = optimizations;
+    d->updateFunctor();
+    const bool blocked = blockNotifications(true);
+    emit optimizationsChanged(optimizations);
+    blockNotifications(blocked);
+}
+
+/*!
+ * \property QMesh::optimizations
+ *
+ * Holds the optimizations applied to the mesh once it has been loaded,
+ * NoOptimization by default. Changing them, or the primitive type while they
+ * are set, reloads the mesh.
+ *
+ * \since 6.0
+ * \sa Qt3DRender::QMesh::MeshOptimization
+ */
+QMesh::MeshOptimizations QMesh::optimizations() const
+{
+    Q_D(const QMesh);
+    return d->m_optimizations;
+}
+
 /*!
     \property QMesh::status
 
@@ -283,6 +354,8 @@ MeshLoaderFunctor::MeshLoaderFunctor(QMesh *mesh, const QByteArray &sourceData)
     , m_mesh(mesh->id())
     , m_sourcePath(mesh->source())
     , m_meshName(mesh->meshName())
+    , m_optimizations(mesh->optimizations())
+    , m_primitiveType(mesh->primitiveType())
     , m_sourceData(sourceData)
     , m_nodeManagers(nullptr)
     , m_downloaderService(nullptr)
@@ -290,6 +363,33 @@ MeshLoaderFunctor::MeshLoaderFunctor(QMesh *mesh, const QByteArray &sourceData)
 {
 }
 
+MeshLoaderFunctor::MeshLoaderFunctor()
+    : QGeometryFactory()
+    , m_optimizations(QMesh::NoOptimization)
+    , m_primitiveType(QGeometryRenderer::Triangles)
+    , m_nodeManagers(nullptr)
+    , m_downloaderService(nullptr)
+    , m_status(QMesh::None)
+{
+}
+
+/*!
+ * \internal
+ */
+QSharedPointer<MeshLoaderFunctor> MeshLoaderFunctor::clone() const
+{
+    QSharedPointer<MeshLoaderFunctor> functor(new MeshLoaderFunctor());
+    functor->m_mesh = m_mesh;
+    functor->m_sourcePath = m_sourcePath;
+    functor->m_meshName = m_meshName;
+    functor->m_optimizations = m_optimizations;
+    functor->m_primitiveType = m_primitiveType;
+    functor->m_sourceData = m_sourceData;
+    functor->m_nodeManagers = m_nodeManagers;
+    functor->m_downloaderService = m_downloaderService;
+    return functor;
+}
+
 /*!
  * \internal
  */
@@ -363,6 +463,7 @@ Qt3DCore::QGeometry *MeshLoaderFunctor::operator()()
         if (loader->load(&file, m_meshName)) {
             Qt3DCore::QGeometry *geometry = loader->geometry();
             m_status = geometry != nullptr ? QMesh::Ready : QMesh::Error;
+            MeshOptimizer::optimizeGeometry(geometry, m_primitiveType, m_optimizations, true);
             return geometry;
         }
         qCWarning(Render::Jobs) << Q_FUNC_INFO << "Mesh loading failure for:" << filePath;
@@ -376,6 +477,7 @@ Qt3DCore::QGeometry *MeshLoaderFunctor::operator()()
         if (loader->load(&buffer, m_meshName)) {
             Qt3DCore::QGeometry *geometry = loader->geometry();
             m_status = geometry != nullptr ? QMesh::Ready : QMesh::Error;
+            MeshOptimizer::optimizeGeometry(geometry, m_primitiveType, m_optimizations, true);
             return geometry;
         }
 
@@ -395,6 +497,8 @@ bool MeshLoaderFunctor::operator ==(const QGeometryFactory &other) const
         return (otherFunctor->m_sourcePath == m_sourcePath &&
                 otherFunctor->m_sourceData.isEmpty() == m_sourceData.isEmpty() &&
                 otherFunctor->m_meshName == m_meshName &&
+                otherFunctor->m_optimizations == m_optimizations &&
+                otherFunctor->m_primitiveType == m_primitiveType &&
                 otherFunctor->m_downloaderService == m_downloaderService &&
                 otherFunctor->m_nodeManagers == m_nodeManagers);
     return false;
@@ -60,6 +60,7 @@ class Q_3DRENDERSHARED_EXPORT QMesh : public QGeometryRenderer
     Q_PROPERTY(QUrl source READ source WRITE setSource NOTIFY sourceChanged)
     Q_PROPERTY(QString meshName READ meshName WRITE setMeshName NOTIFY meshNameChanged)
     Q_PROPERTY(Status status READ status NOTIFY statusChanged REVISION 11)
+    Q_PROPERTY(MeshOptimizations optimizations READ optimizations WRITE setOptimizations NOTIFY optimizationsChanged REVISION 16)
 public:
     explicit QMesh(Qt3DCore::QNode *parent = nullptr);
     ~QMesh();
@@ -72,19 +73,30 @@ public:
     };
     Q_ENUM(Status) // LCOV_EXCL_LINE
 
+    enum MeshOptimization {
+        NoOptimization = 0x0,
+        VertexCacheOptimization = 0x1,
+        VertexFetchOptimization = 0x2,
+        VertexDeduplication = 0x4
+    };
+    Q_DECLARE_FLAGS(MeshOptimizations, MeshOptimization)
+    Q_FLAG(MeshOptimizations)
 
     QUrl source() const;
     QString meshName() const;
     Status status() const;
+    MeshOptimizations optimizations() const;
 
 public Q_SLOTS:
     void setSource(const QUrl &source);
     void setMeshName(const QString &meshName);
+    Q_REVISION(16) void setOptimizations(MeshOptimizations optimizations);
 
 Q_SIGNALS:
     void sourceChanged(const QUrl &source);
     void meshNameChanged(const QString &meshName);
     void statusChanged(Status status);
+    Q_REVISION(16) void optimizationsChanged(MeshOptimizations optimizations);
 
 protected:
     explicit QMesh(QMeshPrivate &dd, Qt3DCore::QNode *parent = nullptr);
@@ -93,6 +105,8 @@ private:
     Q_DECLARE_PRIVATE(QMesh)
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(QMesh::MeshOptimizations)
+
 }
 
 QT_END_NAMESPACE
@@ -79,11 +79,13 @@ public:
 
     void setScene(Qt3DCore::QScene *scene) override;
     void updateFunctor();
+    void trackPrimitiveType();
     void setStatus(QMesh::Status status);
 
     QUrl m_source;
     QString m_meshName;
     QMesh::Status m_status;
+    QMesh::MeshOptimizations m_optimizations;
 };
 
 class Q_AUTOTEST_EXPORT MeshDownloadRequest : public Qt3DCore::QDownloadRequest
@@ -115,17 +117,26 @@ public :
     QUrl sourcePath() const { return m_sourcePath; }
     Qt3DCore::QNodeId mesh() const { return m_mesh; }
     QString meshName() const { return m_meshName; }
+    QMesh::MeshOptimizations optimizations() const { return m_optimizations; }
+    QGeometryRenderer::PrimitiveType primitiveType() const { return m_primitiveType; }
 
     QMesh::Status status() const { return m_status; }
 
+    // Copy to run without the functor of the backend node being mutated
+    QSharedPointer<MeshLoaderFunctor> clone() const;
+
     Qt3DCore::QGeometry *operator()() override;
     bool operator ==(const Qt3DCore::QGeometryFactory &other) const override;
     QT3D_FUNCTOR(MeshLoaderFunctor)
 
 private:
+    MeshLoaderFunctor();
+
     Qt3DCore::QNodeId m_mesh;
     QUrl m_sourcePath;
     QString m_meshName;
+    QMesh::MeshOptimizations m_optimizations;
+    QGeometryRenderer::PrimitiveType m_primitiveType;
     QByteArray m_sourceData;
     Render::NodeManagers *m_nodeManagers;
     Qt3DCore::QDownloadHelperService *m_downloaderService;
@@ -0,0 +1,244 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB)
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "vertexattributegenerators_p.h"
+
+#include <QtCore/QList>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtGui/QVector2D>
+#include <QtGui/QVector3D>
+
+#include <numeric>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace VertexAttributeGenerators {
+
+namespace {
+
+// Below this many items per block, spreading the work over threads costs more than it saves
+const int BlockSize = 16384;
+
+template<typename Function>
+void forEachBlock(int count, const Function &function)
+{
+    const int blockCount = (count + BlockSize - 1) / BlockSize;
+    if (blockCount <= 1) {
+        if (count > 0)
+            function(0, count);
+        return;
+    }
+
+    QList<int> blocks(blockCount);
+    std::iota(blocks.begin(), blocks.end(), 0);
+    QtConcurrent::blockingMap(blocks, [&] (int block) {
+        function(block * BlockSize, qMin(count, (block + 1) * BlockSize));
+    });
+}
+
+inline QVector3D vector3D(const float *data, int stride, unsigned int index)
+{
+    const float *v = data + size_t(index) * stride;
+    return QVector3D(v[0], v[1], v[2]);
+}
+
+inline QVector2D vector2D(const float *data, int stride, unsigned int index)
+{
+    const float *v = data + size_t(index) * stride;
+    return QVector2D(v[0], v[1]);
+}
+
+// Triangles using each vertex, once per corner and in index order. Triangles
+// referencing vertices out of range are left out
+struct VertexTriangles
+{
+    VertexTriangles(const unsigned int *indices, int triangleCount, int vertexCount)
+        : offsets(vertexCount + 1, 0)
+    {
+        const auto isValid = [=] (int triangle) {
+            const unsigned int *corners = indices + triangle * 3;
+            return corners[0] < unsigned(vertexCount)
+                    && corners[1] < unsigned(vertexCount)
+                    && corners[2] < unsigned(vertexCount);
+        };
+
+        for (int triangle = 0; triangle < triangleCount; ++triangle) {
+            if (!isValid(triangle))
+                continue;
+            for (int corner = 0; corner < 3; ++corner)
+                ++offsets[indices[triangle * 3 + corner] + 1];
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        triangles.resize(offsets.last());
+        QList<int> cursors = offsets;
+        for (int triangle = 0; triangle < triangleCount; ++triangle) {
+            if (!isValid(triangle))
+                continue;
+            for (int corner = 0; corner < 3; ++corner)
+                triangles[cursors[indices[triangle * 3 + corner]]++] = triangle;
+        }
+    }
+
+    template<typename Function>
+    void forEach(int vertex, const Function &function) const
+    {
+        for (int i = offsets.at(vertex), end = offsets.at(vertex + 1); i < end; ++i)
+            function(triangles.at(i));
+    }
+
+    QList<int> offsets;
+    QList<int> triangles;
+};
+
+} // anonymous
+
+void generateAveragedNormals(const float *positions, int positionStride,
+                             int vertexCount,
+                             const unsigned int *indices, int indexCount,
+                             float *normals, int normalStride)
+{
+    const int triangleCount = indexCount / 3;
+
+    QList<QVector3D> faceNormals(triangleCount);
+    QVector3D *faceNormalData = faceNormals.data();
+    forEachBlock(triangleCount, [&] (int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            const unsigned int *corners = indices + i * 3;
+            if (corners[0] >= unsigned(vertexCount) || corners[1] >= unsigned(vertexCount) || corners[2] >= unsigned(vertexCount))
+                continue;
+
+            const QVector3D p1 = vector3D(positions, positionStride, corners[0]);
+            const QVector3D p2 = vector3D(positions, positionStride, corners[1]);
+            const QVector3D p3 = vector3D(positions, positionStride, corners[2]);
+
+            const QVector3D a = p2 - p1;
+            const QVector3D b = p3 - p1;
+            faceNormalData[i] = QVector3D::crossProduct(a, b).normalized();
+        }
+    });
+
+    const VertexTriangles vertexTriangles(indices, triangleCount, vertexCount);
+    forEachBlock(vertexCount, [&] (int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            QVector3D normal;
+            vertexTriangles.forEach(i, [&] (int triangle) { normal += faceNormals.at(triangle); });
+            normal.normalize();
+
+            float *n = normals + size_t(i) * normalStride;
+            n[0] = normal.x();
+            n[1] = normal.y();
+            n[2] = normal.z();
+        }
+    });
+}
+
+void generateTangents(const float *positions, int positionStride,
+                      const float *normals, int normalStride,
+                      const float *texCoords, int texCoordStride,
+                      int vertexCount,
+                      const unsigned int *indices, int indexCount,
+                      float *tangents, int tangentStride)
+{
+    const int triangleCount = indexCount / 3;
+
+    // Tangent and bitangent directions of each triangle
+    QList<QVector3D> faceTangents(triangleCount * 2);
+    QVector3D *faceTangentData = faceTangents.data();
+    forEachBlock(triangleCount, [&] (int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            const unsigned int *corners = indices + i * 3;
+            if (corners[0] >= unsigned(vertexCount) || corners[1] >= unsigned(vertexCount) || corners[2] >= unsigned(vertexCount))
+                continue;
+
+            const QVector3D p1 = vector3D(positions, positionStride, corners[0]);
+            const QVector3D p2 = vector3D(positions, positionStride, corners[1]);
+            const QVector3D p3 = vector3D(positions, positionStride, corners[2]);
+
+            const QVector2D tc1 = vector2D(texCoords, texCoordStride, corners[0]);
+            const QVector2D tc2 = vector2D(texCoords, texCoordStride, corners[1]);
+            const QVector2D tc3 = vector2D(texCoords, texCoordStride, corners[2]);
+
+            const QVector3D q1 = p2 - p1;
+            const QVector3D q2 = p3 - p1;
+            const float s1 = tc2.x() - tc1.x(), s2 = tc3.x() - tc1.x();
+            const float t1 = tc2.y() - tc1.y(), t2 = tc3.y() - tc1.y();
+            const float r = 1.0f / (s1 * t2 - s2 * t1);
+            faceTangentData[i * 2] = QVector3D((t2 * q1.x() - t1 * q2.x()) * r,
+                                               (t2 * q1.y() - t1 * q2.y()) * r,
+                                               (t2 * q1.z() - t1 * q2.z()) * r);
+            faceTangentData[i * 2 + 1] = QVector3D((s1 * q2.x() - s2 * q1.x()) * r,
+                                                   (s1 * q2.y() - s2 * q1.y()) * r,
+                                                   (s1 * q2.z() - s2 * q1.z()) * r);
+        }
+    });
+
+    const VertexTriangles vertexTriangles(indices, triangleCount, vertexCount);
+    forEachBlock(vertexCount, [&] (int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            QVector3D t1;
+            QVector3D t2;
+            vertexTriangles.forEach(i, [&] (int triangle) {
+                t1 += faceTangents.at(triangle * 2);
+                t2 += faceTangents.at(triangle * 2 + 1);
+            });
+
+            const QVector3D n = vector3D(normals, normalStride, i);
+
+            // Gram-Schmidt orthogonalize
+            const QVector3D tangent = QVector3D(t1 - QVector3D::dotProduct(n, t1) * n).normalized();
+
+            float *t = tangents + size_t(i) * tangentStride;
+            t[0] = tangent.x();
+            t[1] = tangent.y();
+            t[2] = tangent.z();
+            // Store handedness in w
+            t[3] = (QVector3D::dotProduct(QVector3D::crossProduct(n, t1), t2) < 0.0f) ? -1.0f : 1.0f;
+        }
+    });
+}
+
+} // namespace VertexAttributeGenerators
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
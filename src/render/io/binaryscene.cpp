@@ -0,0 +1,347 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB)
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "binaryscene_p.h"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QIODevice>
+#include <QtCore/QtEndian>
+#include <Qt3DCore/qattribute.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace BinaryScene {
+
+namespace {
+
+const int HeaderSize = 40;
+
+quint64 alignedSize(quint64 size)
+{
+    return (size + DataAlignment - 1) & ~quint64(DataAlignment - 1);
+}
+
+template<typename T>
+bool isIndex(qint32 index, const QList<T> &list)
+{
+    return index >= 0 && index < list.size();
+}
+
+quint64 componentSize(qint32 vertexBaseType)
+{
+    switch (vertexBaseType) {
+    case Qt3DCore::QAttribute::Byte:
+    case Qt3DCore::QAttribute::UnsignedByte:
+        return 1;
+    case Qt3DCore::QAttribute::Short:
+    case Qt3DCore::QAttribute::UnsignedShort:
+    case Qt3DCore::QAttribute::HalfFloat:
+        return 2;
+    case Qt3DCore::QAttribute::Int:
+    case Qt3DCore::QAttribute::UnsignedInt:
+    case Qt3DCore::QAttribute::Float:
+        return 4;
+    case Qt3DCore::QAttribute::Double:
+        return 8;
+    }
+    return 0;
+}
+
+// Checks that the last element of the attribute ends within its buffer
+bool fitsInBuffer(const AttributeRecord &attribute, const BufferRecord &buffer)
+{
+    if (attribute.count == 0)
+        return true;
+    const quint64 elementSize = componentSize(attribute.vertexBaseType) * attribute.vertexSize;
+    if (elementSize == 0 || buffer.size < elementSize || attribute.byteOffset > buffer.size - elementSize)
+        return false;
+    const quint64 stride = attribute.byteStride > 0 ? attribute.byteStride : elementSize;
+    return attribute.count - 1 <= (buffer.size - elementSize - attribute.byteOffset) / stride;
+}
+
+// QDataStream reserves the size it reads for lists, which can be anything in
+// a corrupt file. Elements take at least one byte, so lists larger than the
+// rest of the description are rejected instead
+template<typename T>
+QDataStream &readList(QDataStream &stream, QList<T> &list)
+{
+    list.clear();
+    quint32 size = 0;
+    stream >> size;
+    if (stream.status() != QDataStream::Ok || size > quint64(stream.device()->bytesAvailable())) {
+        stream.setStatus(QDataStream::ReadCorruptData);
+        return stream;
+    }
+
+    list.reserve(size);
+    for (quint32 i = 0; i < size && stream.status() == QDataStream::Ok; ++i) {
+        T value;
+        stream >> value;
+        list.append(value);
+    }
+    return stream;
+}
+
+bool isValid(const SceneDescription &description, quint64 dataSize)
+{
+    for (const BufferRecord &buffer : description.buffers) {
+        if (buffer.offset > dataSize || buffer.size > dataSize - buffer.offset)
+            return false;
+    }
+
+    for (const GeometryRecord &geometry : description.geometries) {
+        for (const AttributeRecord &attribute : geometry.attributes) {
+            if (!isIndex(attribute.buffer, description.buffers)
+                    || !fitsInBuffer(attribute, description.buffers.at(attribute.buffer)))
+                return false;
+        }
+    }
+
+    for (const ComponentRecord &component : description.components) {
+        if (component.type > ComponentRecord::GeometryRenderer)
+            return false;
+        if (component.geometry != -1 && !isIndex(component.geometry, description.geometries))
+            return false;
+        for (const auto &texture : component.textures) {
+            if (!isIndex(texture.second, description.textures))
+                return false;
+        }
+    }
+
+    // The first entity is the root, others come after their parent
+    for (int i = 0, m = description.entities.size(); i < m; ++i) {
+        const EntityRecord &entity = description.entities.at(i);
+        if (i == 0 ? entity.parent != -1 : (entity.parent < 0 || entity.parent >= i))
+            return false;
+        for (qint32 component : entity.components) {
+            if (!isIndex(component, description.components))
+                return false;
+        }
+    }
+    return true;
+}
+
+} // anonymous
+
+// Found through ADL when streaming the record lists
+
+static QDataStream &operator<<(QDataStream &stream, const BufferRecord &buffer)
+{
+    return stream << buffer.offset << buffer.size << buffer.usage;
+}
+
+static QDataStream &operator>>(QDataStream &stream, BufferRecord &buffer)
+{
+    return stream >> buffer.offset >> buffer.size >> buffer.usage;
+}
+
+static QDataStream &operator<<(QDataStream &stream, const AttributeRecord &attribute)
+{
+    return stream << attribute.name << attribute.attributeType << attribute.vertexBaseType
+                  << attribute.vertexSize << attribute.count << attribute.byteStride
+                  << attribute.byteOffset << attribute.divisor << attribute.buffer;
+}
+
+static QDataStream &operator>>(QDataStream &stream, AttributeRecord &attribute)
+{
+    return stream >> attribute.name >> attribute.attributeType >> attribute.vertexBaseType
+                  >> attribute.vertexSize >> attribute.count >> attribute.byteStride
+                  >> attribute.byteOffset >> attribute.divisor >> attribute.buffer;
+}
+
+static QDataStream &operator<<(QDataStream &stream, const GeometryRecord &geometry)
+{
+    return stream << geometry.name << geometry.attributes;
+}
+
+static QDataStream &operator>>(QDataStream &stream, GeometryRecord &geometry)
+{
+    stream >> geometry.name;
+    return readList(stream, geometry.attributes);
+}
+
+static QDataStream &operator<<(QDataStream &stream, const TextureImageRecord &image)
+{
+    return stream << image.source << image.mirrored;
+}
+
+static QDataStream &operator>>(QDataStream &stream, TextureImageRecord &image)
+{
+    return stream >> image.source >> image.mirrored;
+}
+
+static QDataStream &operator<<(QDataStream &stream, const TextureRecord &texture)
+{
+    return stream << texture.className << texture.name << texture.properties
+                  << texture.wrapModeX << texture.wrapModeY << texture.wrapModeZ
+                  << texture.images;
+}
+
+static QDataStream &operator>>(QDataStream &stream, TextureRecord &texture)
+{
+    stream >> texture.className >> texture.name;
+    readList(stream, texture.properties);
+    stream >> texture.wrapModeX >> texture.wrapModeY >> texture.wrapModeZ;
+    return readList(stream, texture.images);
+}
+
+static QDataStream &operator<<(QDataStream &stream, const ComponentRecord &component)
+{
+    return stream << quint8(component.type) << component.className << component.name
+                  << component.properties << component.textures << component.geometry;
+}
+
+static QDataStream &operator>>(QDataStream &stream, ComponentRecord &component)
+{
+    quint8 type;
+    stream >> type >> component.className >> component.name;
+    readList(stream, component.properties);
+    readList(stream, component.textures);
+    stream >> component.geometry;
+    component.type = ComponentRecord::Type(type);
+    return stream;
+}
+
+static QDataStream &operator<<(QDataStream &stream, const EntityRecord &entity)
+{
+    return stream << entity.className << entity.name << entity.enabled << entity.parent
+                  << entity.properties << entity.components;
+}
+
+static QDataStream &operator>>(QDataStream &stream, EntityRecord &entity)
+{
+    stream >> entity.className >> entity.name >> entity.enabled >> entity.parent;
+    readList(stream, entity.properties);
+    return readList(stream, entity.components);
+}
+
+bool write(QIODevice *device, SceneDescription &description, const QList<QByteArray> &bufferData)
+{
+    Q_ASSERT(description.buffers.size() == bufferData.size());
+
+    quint64 dataSize = 0;
+    for (int i = 0, m = bufferData.size(); i < m; ++i) {
+        BufferRecord &buffer = description.buffers[i];
+        buffer.offset = dataSize;
+        buffer.size = quint64(bufferData.at(i).size());
+        dataSize = alignedSize(dataSize + buffer.size);
+    }
+
+    QByteArray serializedDescription;
+    {
+        QDataStream stream(&serializedDescription, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_6_0);
+        stream << description.entities << description.components << description.textures
+               << description.geometries << description.buffers;
+    }
+
+    const quint64 descriptionSize = quint64(serializedDescription.size());
+    const quint64 dataOffset = alignedSize(HeaderSize + descriptionSize);
+
+    uchar header[HeaderSize];
+    qToLittleEndian<quint32>(Magic, header);
+    qToLittleEndian<quint32>(Version, header + 4);
+    qToLittleEndian<quint64>(HeaderSize, header + 8);
+    qToLittleEndian<quint64>(descriptionSize, header + 16);
+    qToLittleEndian<quint64>(dataOffset, header + 24);
+    qToLittleEndian<quint64>(dataSize, header + 32);
+
+    const QByteArray padding(DataAlignment, '\0');
+    if (device->write(reinterpret_cast<const char *>(header), HeaderSize) != HeaderSize
+            || device->write(serializedDescription) != qint64(descriptionSize)
+            || device->write(padding.constData(), dataOffset - HeaderSize - descriptionSize) < 0)
+        return false;
+
+    for (const QByteArray &data : bufferData) {
+        if (device->write(data) != data.size()
+                || device->write(padding.constData(), alignedSize(data.size()) - data.size()) < 0)
+            return false;
+    }
+    return true;
+}
+
+bool read(const char *data, qint64 size, SceneDescription &description, qint64 &dataOffset)
+{
+    if (size < HeaderSize)
+        return false;
+
+    const uchar *header = reinterpret_cast<const uchar *>(data);
+    FileHeader fileHeader;
+    fileHeader.magic = qFromLittleEndian<quint32>(header);
+    fileHeader.version = qFromLittleEndian<quint32>(header + 4);
+    fileHeader.descriptionOffset = qFromLittleEndian<quint64>(header + 8);
+    fileHeader.descriptionSize = qFromLittleEndian<quint64>(header + 16);
+    fileHeader.dataOffset = qFromLittleEndian<quint64>(header + 24);
+    fileHeader.dataSize = qFromLittleEndian<quint64>(header + 32);
+
+    const quint64 fileSize = quint64(size);
+    if (fileHeader.magic != Magic || fileHeader.version != Version
+            || fileHeader.descriptionOffset > fileSize
+            || fileHeader.descriptionSize > fileSize - fileHeader.descriptionOffset
+            || fileHeader.dataOffset > fileSize
+            || fileHeader.dataSize > fileSize - fileHeader.dataOffset)
+        return false;
+
+    const QByteArray serializedDescription
+            = QByteArray::fromRawData(data + fileHeader.descriptionOffset,
+                                      qsizetype(fileHeader.descriptionSize));
+    QDataStream stream(serializedDescription);
+    stream.setVersion(QDataStream::Qt_6_0);
+    readList(stream, description.entities);
+    readList(stream, description.components);
+    readList(stream, description.textures);
+    readList(stream, description.geometries);
+    readList(stream, description.buffers);
+
+    if (stream.status() != QDataStream::Ok || !isValid(description, fileHeader.dataSize)) {
+        description = SceneDescription();
+        return false;
+    }
+
+    dataOffset = qint64(fileHeader.dataOffset);
+    return true;
+}
+
+} // namespace BinaryScene
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
@@ -0,0 +1,197 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB)
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DRENDER_BINARYSCENE_P_H
+#define QT3DRENDER_BINARYSCENE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QPair>
+#include <QtCore/QString>
+#include <QtCore/QUrl>
+#include <QtCore/QVariant>
+#include <Qt3DRender/private/qt3drender_global_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+
+namespace Qt3DRender {
+
+// The binary scene format stores an imported entity tree so that it can be
+// loaded back without going through a full scene importer.
+//
+// A file starts with a FileHeader in little endian, followed by the scene
+// description serialized with QDataStream and by the data section. The data
+// section holds the contents of the buffers as they are uploaded, each one
+// aligned to DataAlignment bytes, so that they can be used straight from a
+// mapping of the file.
+//
+// Entities are listed depth first, parents before their children, and refer
+// to their components by index. Components, textures and geometries keep
+// their writable properties by name, relative local file URLs are relative
+// to the directory of the file.
+namespace BinaryScene {
+
+constexpr quint32 Magic = 0x53443351; // "Q3DS"
+constexpr quint32 Version = 1;
+constexpr quint32 DataAlignment = 16;
+
+struct FileHeader
+{
+    quint32 magic;
+    quint32 version;
+    quint64 descriptionOffset;
+    quint64 descriptionSize;
+    quint64 dataOffset;
+    quint64 dataSize;
+};
+
+using Property = QPair<QByteArray, QVariant>;
+
+struct BufferRecord
+{
+    // Relative to the start of the data section
+    quint64 offset = 0;
+    quint64 size = 0;
+    qint32 usage = 0;
+};
+
+struct AttributeRecord
+{
+    QString name;
+    qint32 attributeType = 0;
+    qint32 vertexBaseType = 0;
+    quint32 vertexSize = 0;
+    quint32 count = 0;
+    quint32 byteStride = 0;
+    quint32 byteOffset = 0;
+    quint32 divisor = 0;
+    qint32 buffer = -1;
+};
+
+struct GeometryRecord
+{
+    QString name;
+    QList<AttributeRecord> attributes;
+};
+
+struct TextureImageRecord
+{
+    QUrl source;
+    bool mirrored = true;
+};
+
+struct TextureRecord
+{
+    QByteArray className;
+    QString name;
+    QList<Property> properties;
+    qint32 wrapModeX = 0;
+    qint32 wrapModeY = 0;
+    qint32 wrapModeZ = 0;
+    QList<TextureImageRecord> images;
+};
+
+struct ComponentRecord
+{
+    enum Type : quint8 {
+        Transform,
+        CameraLens,
+        Light,
+        Material,
+        GeometryRenderer
+    };
+
+    Type type = Transform;
+    QByteArray className;
+    QString name;
+    QList<Property> properties;
+    // Texture properties, referring to textures by index
+    QList<QPair<QByteArray, qint32>> textures;
+    qint32 geometry = -1;
+};
+
+struct EntityRecord
+{
+    QByteArray className;
+    QString name;
+    bool enabled = true;
+    qint32 parent = -1;
+    QList<Property> properties;
+    QList<qint32> components;
+};
+
+struct SceneDescription
+{
+    QList<EntityRecord> entities;
+    QList<ComponentRecord> components;
+    QList<TextureRecord> textures;
+    QList<GeometryRecord> geometries;
+    QList<BufferRecord> buffers;
+};
+
+// Writes the scene to device, with the contents of buffer i in bufferData[i].
+// The offsets and sizes of the buffer records are set while writing
+Q_3DRENDERSHARED_PRIVATE_EXPORT bool write(QIODevice *device, SceneDescription &description,
+                                           const QList<QByteArray> &bufferData);
+
+// Reads the scene description from the size bytes of file content at data,
+// and checks that it is consistent. The data section starts at dataOffset
+Q_3DRENDERSHARED_PRIVATE_EXPORT bool read(const char *data, qint64 size,
+                                          SceneDescription &description, qint64 &dataOffset);
+
+} // namespace BinaryScene
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_BINARYSCENE_P_H
@@ -1,6 +1,7 @@
 INCLUDEPATH += $$PWD
 
 HEADERS += \
+    $$PWD/binaryscene_p.h \
     $$PWD/qaxisalignedboundingbox_p.h \
     $$PWD/qsceneloader.h \
     $$PWD/qsceneloader_p.h \
@@ -16,6 +17,7 @@ HEADERS += \
     $$PWD/qgeometryloaderinterface_p.h
 
 SOURCES += \
+    $$PWD/binaryscene.cpp \
     $$PWD/qaxisalignedboundingbox.cpp \
     $$PWD/qsceneloader.cpp \
     $$PWD/scene.cpp \
@@ -188,6 +188,7 @@ namespace Qt3DRender {
 QSceneLoaderPrivate::QSceneLoaderPrivate()
     : QComponentPrivate()
     , m_status(QSceneLoader::None)
+    , m_meshOptimizations(QMesh::NoOptimization)
     , m_subTreeRoot(nullptr)
 {
     m_shareable = false;
@@ -280,6 +281,39 @@ QSceneLoader::Status QSceneLoader::status() const
     return d->m_status;
 }
 
+/*!
+    \property QSceneLoader::meshOptimizations
+
+    Holds the optimizations applied to the meshes of the scene once it has
+    been loaded, QMesh::NoOptimization by default. Changing them reloads the
+    scene.
+
+    \since 6.0
+    \sa Qt3DRender::QMesh::MeshOptimization
+*/
+/*!
+    \qmlproperty enumeration SceneLoader::meshOptimizations
+
+    Holds the optimizations applied to the meshes of the scene once it has
+    been loaded.
+
+    \since 6.0
+*/
+QMesh::MeshOptimizations QSceneLoader::meshOptimizations() const
+{
+    Q_D(const QSceneLoader);
+    return d->m_meshOptimizations;
+}
+
+void QSceneLoader::setMeshOptimizations(QMesh::MeshOptimizations meshOptimizations)
+{
+    Q_D(QSceneLoader);
+    if (d->m_meshOptimizations != meshOptimizations) {
+        d->m_meshOptimizations = meshOptimizations;
+        emit meshOptimizationsChanged(meshOptimizations);
+    }
+}
+
 /*!
     \qmlmethod Entity SceneLoader::entity(string entityName)
     Returns a loaded entity with the \c objectName matching the \a entityName parameter.
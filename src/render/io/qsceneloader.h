@@ -42,6 +42,7 @@
 
 #include <Qt3DCore/qcomponent.h>
 #include <Qt3DRender/qt3drender_global.h>
+#include <Qt3DRender/qmesh.h>
 #include <QtCore/QUrl>
 
 QT_BEGIN_NAMESPACE
@@ -55,6 +56,7 @@ class Q_3DRENDERSHARED_EXPORT QSceneLoader : public Qt3DCore::QComponent
     Q_OBJECT
     Q_PROPERTY(QUrl source READ source WRITE setSource NOTIFY sourceChanged)
     Q_PROPERTY(Status status READ status NOTIFY statusChanged)
+    Q_PROPERTY(Qt3DRender::QMesh::MeshOptimizations meshOptimizations READ meshOptimizations WRITE setMeshOptimizations NOTIFY meshOptimizationsChanged REVISION 16)
 public:
     explicit QSceneLoader(Qt3DCore::QNode *parent = nullptr);
     ~QSceneLoader();
@@ -79,6 +81,7 @@ public:
 
     QUrl source() const;
     Status status() const;
+    QMesh::MeshOptimizations meshOptimizations() const;
 
     Q_REVISION(9) Q_INVOKABLE Qt3DCore::QEntity *entity(const QString &entityName) const;
     Q_REVISION(9) Q_INVOKABLE QStringList entityNames() const;
@@ -87,10 +90,12 @@ public:
 
 public Q_SLOTS:
     void setSource(const QUrl &arg);
+    Q_REVISION(16) void setMeshOptimizations(QMesh::MeshOptimizations meshOptimizations);
 
 Q_SIGNALS:
     void sourceChanged(const QUrl &source);
     void statusChanged(Status status);
+    Q_REVISION(16) void meshOptimizationsChanged(QMesh::MeshOptimizations meshOptimizations);
 
 protected:
     explicit QSceneLoader(QSceneLoaderPrivate &dd, Qt3DCore::QNode *parent = nullptr);
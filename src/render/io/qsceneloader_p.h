@@ -75,6 +75,7 @@ public:
 
     QUrl m_source;
     QSceneLoader::Status m_status;
+    QMesh::MeshOptimizations m_meshOptimizations;
     Qt3DCore::QEntity *m_subTreeRoot;
     QHash<QString, Qt3DCore::QEntity *> m_entityMap;
 };
@@ -57,12 +57,14 @@ namespace Render {
 Scene::Scene()
     : BackendNode(QBackendNode::ReadWrite)
     , m_sceneManager(nullptr)
+    , m_meshOptimizations(QMesh::NoOptimization)
 {
 }
 
 void Scene::cleanup()
 {
     m_source.clear();
+    m_meshOptimizations = QMesh::NoOptimization;
 }
 
 void Scene::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstTime)
@@ -73,7 +75,12 @@ void Scene::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstTime)
 
     BackendNode::syncFromFrontEnd(frontEnd, firstTime);
 
-    if (node->source() != m_source) {
+    // The optimizations are applied while loading, so changing them reloads
+    // the scene
+    const bool optimizationsChanged = node->meshOptimizations() != m_meshOptimizations;
+    m_meshOptimizations = node->meshOptimizations();
+
+    if (node->source() != m_source || (optimizationsChanged && !m_source.isEmpty())) {
         m_source = node->source();
         if (m_source.isEmpty() || Qt3DCore::QDownloadHelperService::isLocal(m_source))
             m_sceneManager->addSceneData(m_source, peerId());
@@ -91,6 +98,11 @@ QUrl Scene::source() const
     return m_source;
 }
 
+QMesh::MeshOptimizations Scene::meshOptimizations() const
+{
+    return m_meshOptimizations;
+}
+
 void Scene::setSceneManager(SceneManager *manager)
 {
     if (m_sceneManager != manager)
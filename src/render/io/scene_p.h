@@ -74,6 +74,7 @@ public:
 
     void syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstTime) override;
     QUrl source() const;
+    QMesh::MeshOptimizations meshOptimizations() const;
     void setSceneManager(SceneManager *manager);
 
     void cleanup();
@@ -82,6 +83,7 @@ public:
 private:
     SceneManager *m_sceneManager;
     QUrl m_source;
+    QMesh::MeshOptimizations m_meshOptimizations;
 };
 
 class RenderSceneFunctor : public Qt3DCore::QBackendNodeMapper
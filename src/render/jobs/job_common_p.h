@@ -111,7 +111,8 @@ namespace JobTypes {
         SendSetFenceHandlesToFrontend,
         SendDisablesToFrontend,
         RenderViewCommandBuilder,
-        SyncRenderViewPreCommandBuilding
+        SyncRenderViewPreCommandBuilding,
+        IntegrateLoadedGeometry
     };
 
 } // JobTypes
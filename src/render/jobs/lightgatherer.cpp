@@ -62,18 +62,26 @@ void LightGatherer::run()
     m_lights.clear();
     m_environmentLight = nullptr;
 
-    const std::vector<HEntity> &handles = m_manager->activeHandles();
+    // Only visit the entities known to reference light components rather
+    // than every entity of the scene
+    const std::vector<HEntity> &handles = m_manager->lightEntities();
     size_t envLightCount = 0;
 
     for (const HEntity &handle : handles) {
         Entity *node = m_manager->data(handle);
-        std::vector<Light *> lights = node->renderComponents<Light>();
-        if (!lights.empty())
-            m_lights.push_back(LightSource(node, std::move(lights)));
-        const std::vector<EnvironmentLight *> &envLights = node->renderComponents<EnvironmentLight>();
-        envLightCount += envLights.size();
-        if (!envLights.empty() && !m_environmentLight)
-            m_environmentLight = envLights.front();
+        if (!node)
+            continue;
+        if (!node->componentsUuid<Light>().isEmpty()) {
+            std::vector<Light *> lights = node->renderComponents<Light>();
+            if (!lights.empty())
+                m_lights.push_back(LightSource(node, std::move(lights)));
+        }
+        if (!node->componentsUuid<EnvironmentLight>().isEmpty()) {
+            const std::vector<EnvironmentLight *> &envLights = node->renderComponents<EnvironmentLight>();
+            envLightCount += envLights.size();
+            if (!envLights.empty() && !m_environmentLight)
+                m_environmentLight = envLights.front();
+        }
     }
 
     if (envLightCount > 1)
@@ -40,6 +40,7 @@
 #include "loadgeometryjob_p.h"
 #include <Qt3DRender/private/nodemanagers_p.h>
 #include <Qt3DRender/private/geometryrenderermanager_p.h>
+#include <Qt3DRender/private/backgroundgeometryloader_p.h>
 #include <Qt3DRender/private/job_common_p.h>
 #include <Qt3DCore/private/qaspectmanager_p.h>
 #include <Qt3DRender/private/qmesh_p.h>
@@ -65,6 +66,7 @@ LoadGeometryJob::LoadGeometryJob(const HGeometryRenderer &handle)
     : QAspectJob(*new LoadGeometryJobPrivate)
     , m_handle(handle)
     , m_nodeManagers(nullptr)
+    , m_backgroundLoader(nullptr)
 {
     SET_JOB_RUN_STAT_TYPE(this, JobTypes::LoadGeometry, 0)
 }
@@ -77,8 +79,17 @@ void LoadGeometryJob::run()
 {
     Q_D(LoadGeometryJob);
     GeometryRenderer *geometryRenderer = m_nodeManagers->geometryRendererManager()->data(m_handle);
-    if (geometryRenderer != nullptr)
-        d->m_updates.push_back({ geometryRenderer->peerId(), geometryRenderer->executeFunctor() });
+    if (geometryRenderer == nullptr)
+        return;
+
+    // The QMesh stays in the Loading status until the result is integrated
+    if (m_backgroundLoader != nullptr && geometryRenderer->isMeshLoaderFunctor()) {
+        m_backgroundLoader->requestLoad(geometryRenderer->peerId(), geometryRenderer->geometryFactory(),
+                                        geometryRenderer->prepareFunctor());
+        return;
+    }
+
+    d->m_updates.push_back({ geometryRenderer->peerId(), geometryRenderer->executeFunctor() });
 }
 
 void LoadGeometryJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
@@ -87,6 +98,12 @@ void LoadGeometryJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
     for (const auto &update : updates) {
         QGeometryRenderer *gR = static_cast<decltype(gR)>(manager->lookupNode(update.first));
         const GeometryFunctorResult &result = update.second;
+        // Destroyed while the geometry was being loaded
+        if (gR == nullptr) {
+            if (result.geometry)
+                result.geometry->deleteLater();
+            continue;
+        }
         gR->setGeometry(result.geometry);
 
         // Set status if gR is a QMesh instance
@@ -98,6 +115,37 @@ void LoadGeometryJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
     }
 }
 
+IntegrateLoadedGeometryJob::IntegrateLoadedGeometryJob()
+    : QAspectJob(*new LoadGeometryJobPrivate)
+    , m_nodeManagers(nullptr)
+    , m_backgroundLoader(nullptr)
+    , m_maxResultsPerFrame(0)
+{
+    SET_JOB_RUN_STAT_TYPE(this, JobTypes::IntegrateLoadedGeometry, 0)
+}
+
+IntegrateLoadedGeometryJob::~IntegrateLoadedGeometryJob()
+{
+}
+
+void IntegrateLoadedGeometryJob::run()
+{
+    auto d = static_cast<LoadGeometryJobPrivate *>(Qt3DCore::QAspectJobPrivate::get(this));
+    const std::vector<BackgroundGeometryLoader::Result> results =
+            m_backgroundLoader->takeCompletedResults(m_maxResultsPerFrame);
+    GeometryRendererManager *manager = m_nodeManagers->geometryRendererManager();
+
+    for (const BackgroundGeometryLoader::Result &result : results) {
+        // Skip the results of functors replaced or removed while they were running
+        GeometryRenderer *geometryRenderer = manager->lookupResource(result.geometryRendererId);
+        if (geometryRenderer == nullptr || geometryRenderer->geometryFactory() != result.factory) {
+            BackgroundGeometryLoader::discardResult(result);
+            continue;
+        }
+        d->m_updates.push_back({ result.geometryRendererId, result.result });
+    }
+}
+
 } // namespace Render
 
 } // namespace Qt3DRender
@@ -63,6 +63,7 @@ namespace Qt3DRender {
 namespace Render {
 
 class NodeManagers;
+class BackgroundGeometryLoader;
 class LoadGeometryJobPrivate;
 
 class Q_3DRENDERSHARED_PRIVATE_EXPORT LoadGeometryJob : public Qt3DCore::QAspectJob
@@ -72,11 +73,14 @@ public:
     ~LoadGeometryJob();
 
     void setNodeManagers(NodeManagers *nodeManagers) { m_nodeManagers = nodeManagers; }
+    // Mesh files are handed over to the loader rather than loaded in the frame
+    void setBackgroundLoader(BackgroundGeometryLoader *loader) { m_backgroundLoader = loader; }
 
 protected:
     void run() override;
     HGeometryRenderer m_handle;
     NodeManagers *m_nodeManagers;
+    BackgroundGeometryLoader *m_backgroundLoader;
 
 private:
     Q_DECLARE_PRIVATE(LoadGeometryJob)
@@ -84,6 +88,30 @@ private:
 
 typedef QSharedPointer<LoadGeometryJob> LoadGeometryJobPtr;
 
+// Hands the geometries completed by the BackgroundGeometryLoader over to
+// their frontend nodes, at most m_maxResultsPerFrame of them per frame
+class Q_3DRENDERSHARED_PRIVATE_EXPORT IntegrateLoadedGeometryJob : public Qt3DCore::QAspectJob
+{
+public:
+    IntegrateLoadedGeometryJob();
+    ~IntegrateLoadedGeometryJob();
+
+    void setNodeManagers(NodeManagers *nodeManagers) { m_nodeManagers = nodeManagers; }
+    void setBackgroundLoader(BackgroundGeometryLoader *loader) { m_backgroundLoader = loader; }
+    void setMaxResultsPerFrame(int maxResults) { m_maxResultsPerFrame = maxResults; }
+    int maxResultsPerFrame() const { return m_maxResultsPerFrame; }
+
+protected:
+    void run() override;
+
+private:
+    NodeManagers *m_nodeManagers;
+    BackgroundGeometryLoader *m_backgroundLoader;
+    int m_maxResultsPerFrame;
+};
+
+typedef QSharedPointer<IntegrateLoadedGeometryJob> IntegrateLoadedGeometryJobPtr;
+
 } // namespace Render
 
 } // namespace Qt3DRender
@@ -41,22 +41,103 @@
 #include <private/nodemanagers_p.h>
 #include <private/scenemanager_p.h>
 #include <QCoreApplication>
+#include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/qbuffer.h>
 #include <Qt3DCore/qentity.h>
+#include <Qt3DCore/qgeometry.h>
 #include <Qt3DCore/private/qaspectmanager_p.h>
 #include <Qt3DCore/private/qurlhelper_p.h>
 #include <Qt3DRender/private/job_common_p.h>
+#include <Qt3DRender/private/meshoptimizer_p.h>
 #include <Qt3DRender/private/qsceneimporter_p.h>
+#include <Qt3DRender/qgeometryrenderer.h>
+#include <Qt3DRender/qmesh.h>
 #include <Qt3DRender/qsceneloader.h>
 #include <Qt3DRender/private/qsceneloader_p.h>
 #include <Qt3DRender/private/renderlogging_p.h>
 #include <QFileInfo>
+#include <QHash>
 #include <QMimeDatabase>
+#include <QSet>
+
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DRender {
 namespace Render {
 
+namespace {
+
+QSet<Qt3DCore::QBuffer *> geometryBuffers(const Qt3DCore::QGeometry *geometry)
+{
+    QSet<Qt3DCore::QBuffer *> buffers;
+    const auto attributes = geometry->attributes();
+    for (const Qt3DCore::QAttribute *attribute : attributes) {
+        if (attribute->buffer())
+            buffers.insert(attribute->buffer());
+    }
+    return buffers;
+}
+
+void optimizeMeshes(Qt3DCore::QEntity *sceneSubTree, QMesh::MeshOptimizations optimizations)
+{
+    const auto renderers = sceneSubTree->findChildren<QGeometryRenderer *>();
+
+    // Geometries shared by several renderers are optimized once, and only
+    // if none of them draws a sub range nor uses another primitive type
+    struct GeometryUse
+    {
+        QGeometryRenderer::PrimitiveType primitiveType;
+        bool optimizable;
+    };
+    QList<Qt3DCore::QGeometry *> geometries;
+    QHash<Qt3DCore::QGeometry *, GeometryUse> geometryUses;
+    for (QGeometryRenderer *renderer : renderers) {
+        if (QMesh *mesh = qobject_cast<QMesh *>(renderer)) {
+            mesh->setOptimizations(optimizations);
+            continue;
+        }
+        Qt3DCore::QGeometry *geometry = renderer->geometry();
+        if (!geometry)
+            continue;
+        // Draw ranges address the indices and vertices as laid out in the file
+        const bool drawsSubRange = renderer->indexOffset() != 0 || renderer->firstVertex() != 0
+                || renderer->indexBufferByteOffset() != 0;
+        const auto it = geometryUses.find(geometry);
+        if (it == geometryUses.end()) {
+            geometryUses.insert(geometry, { renderer->primitiveType(), !drawsSubRange });
+            geometries.push_back(geometry);
+        } else {
+            it->optimizable = it->optimizable && !drawsSubRange
+                    && it->primitiveType == renderer->primitiveType();
+        }
+    }
+
+    // Vertex buffers shared between geometries keep their layout, only
+    // geometries owning all their buffers have their vertices reordered
+    QHash<Qt3DCore::QBuffer *, int> bufferUseCount;
+    for (const Qt3DCore::QGeometry *geometry : qAsConst(geometries)) {
+        const auto buffers = geometryBuffers(geometry);
+        for (Qt3DCore::QBuffer *buffer : buffers)
+            ++bufferUseCount[buffer];
+    }
+
+    for (Qt3DCore::QGeometry *geometry : qAsConst(geometries)) {
+        const GeometryUse use = geometryUses.value(geometry);
+        if (!use.optimizable)
+            continue;
+        const auto buffers = geometryBuffers(geometry);
+        const bool ownsBuffers = std::all_of(buffers.cbegin(), buffers.cend(),
+                                             [&bufferUseCount] (Qt3DCore::QBuffer *buffer) {
+            return bufferUseCount.value(buffer) == 1;
+        });
+        MeshOptimizer::optimizeGeometry(geometry, use.primitiveType, optimizations, ownsBuffers);
+    }
+}
+
+} // anonymous
+
 LoadSceneJob::LoadSceneJob(const QUrl &source, Qt3DCore::QNodeId sceneComponent)
     : QAspectJob(*new LoadSceneJobPrivate(this))
     , m_source(source)
@@ -144,6 +225,9 @@ void LoadSceneJob::run()
     d->m_status = finalStatus;
 
     if (d->m_sceneSubtree) {
+        if (scene->meshOptimizations() != QMesh::NoOptimization)
+            optimizeMeshes(d->m_sceneSubtree, scene->meshOptimizations());
+
         // Move scene sub tree to the application thread so that it can be grafted in.
         const auto appThread = QCoreApplication::instance()->thread();
         d->m_sceneSubtree->moveToThread(appThread);
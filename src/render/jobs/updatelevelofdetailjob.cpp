@@ -47,6 +47,12 @@
 #include <Qt3DRender/private/sphere_p.h>
 #include <Qt3DRender/private/pickboundingvolumeutils_p.h>
 
+#include <algorithm>
+
+#if QT_CONFIG(concurrent)
+#include <QtConcurrent/QtConcurrent>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 namespace
@@ -59,19 +65,55 @@ double approxRollingAverage(double avg, double input) {
     return avg;
 }
 
-class LODUpdateVisitor : public Qt3DRender::Render::EntityVisitor
+// Below this number of LODs, evaluating them in parallel costs more than it saves
+const size_t parallelEvaluationThreshold = 256;
+
+// Camera data shared by all the LODs referencing the same camera
+struct LODCamera
+{
+    Matrix4x4 viewMatrix;
+    Matrix4x4 viewProjectionMatrix;
+    QRectF viewport;
+    QRect windowViewport;
+    bool valid = false;
+    bool viewportGathered = false;
+    bool hasViewport = false;
+};
+
+struct LODEvaluationData
+{
+    Qt3DRender::Render::Entity *entity;
+    Qt3DRender::Render::LevelOfDetail *lod;
+    int cameraIndex;
+    float metric;
+};
+
+QRect windowViewport(const QSize &area, const QRectF &relativeViewport)
+{
+    if (area.isValid()) {
+        const int areaWidth = area.width();
+        const int areaHeight = area.height();
+        return QRect(relativeViewport.x() * areaWidth,
+                     (1.0 - relativeViewport.y() - relativeViewport.height()) * areaHeight,
+                     relativeViewport.width() * areaWidth,
+                     relativeViewport.height() * areaHeight);
+    }
+    return relativeViewport.toRect();
+}
+
+// Gathers the enabled LODs of the scene and resolves their cameras once per camera
+class LODGatherer : public Qt3DRender::Render::EntityVisitor
 {
 public:
-    LODUpdateVisitor(double filterValue, Qt3DRender::Render::FrameGraphNode *frameGraphRoot, Qt3DRender::Render::NodeManagers *manager)
+    LODGatherer(Qt3DRender::Render::FrameGraphNode *frameGraphRoot, Qt3DRender::Render::NodeManagers *manager)
         : Qt3DRender::Render::EntityVisitor(manager)
-        , m_filterValue(filterValue)
         , m_frameGraphRoot(frameGraphRoot)
     {
-        m_updatedIndices.reserve(manager->levelOfDetailManager()->count());
+        m_lods.reserve(manager->levelOfDetailManager()->count());
     }
 
-    double filterValue() const { return m_filterValue; }
-    const QList<QPair<Qt3DCore::QNodeId, int>> &updatedIndices() const { return m_updatedIndices; }
+    std::vector<LODEvaluationData> &lods() { return m_lods; }
+    const std::vector<LODCamera> &cameras() const { return m_cameras; }
 
     Operation visit(Qt3DRender::Render::Entity *entity = nullptr) override {
         using namespace Qt3DRender;
@@ -85,17 +127,9 @@ public:
             LevelOfDetail* lod = lods.front();  // other lods are ignored
 
             if (lod->isEnabled() && !lod->thresholds().isEmpty()) {
-                switch (lod->thresholdType()) {
-                case QLevelOfDetail::DistanceToCameraThreshold:
-                    updateEntityLodByDistance(entity, lod);
-                    break;
-                case QLevelOfDetail::ProjectedScreenPixelSizeThreshold:
-                    updateEntityLodByScreenArea(entity, lod);
-                    break;
-                default:
-                    Q_ASSERT(false);
-                    break;
-                }
+                const int cameraIndex = cameraIndexForLod(lod);
+                if (cameraIndex >= 0)
+                    m_lods.push_back({ entity, lod, cameraIndex, 0.0f });
             }
         }
 
@@ -103,103 +137,121 @@ public:
     }
 
 private:
-    double m_filterValue = 0.;
     Qt3DRender::Render::FrameGraphNode *m_frameGraphRoot;
-    QList<QPair<Qt3DCore::QNodeId, int>> m_updatedIndices;
+    std::vector<LODEvaluationData> m_lods;
+    std::vector<LODCamera> m_cameras;
+    QHash<Qt3DCore::QNodeId, int> m_cameraIndices;
 
-    void updateEntityLodByDistance(Qt3DRender::Render::Entity *entity, Qt3DRender::Render::LevelOfDetail *lod)
+    int cameraIndexForLod(Qt3DRender::Render::LevelOfDetail *lod)
     {
         using namespace Qt3DRender;
         using namespace Qt3DRender::Render;
 
-        Matrix4x4 viewMatrix;
-        Matrix4x4 projectionMatrix;
-        if (!Render::CameraLens::viewMatrixForCamera(m_manager->renderNodesManager(), lod->camera(), viewMatrix, projectionMatrix))
-            return;
-
-        const QList<qreal> thresholds = lod->thresholds();
-        Vector3D center(lod->center());
-        if (lod->hasBoundingVolumeOverride() || entity->worldBoundingVolume() == nullptr) {
-            center = *entity->worldTransform() * center;
-        } else {
-            center = entity->worldBoundingVolume()->center();
+        auto it = m_cameraIndices.find(lod->camera());
+        if (it == m_cameraIndices.end()) {
+            LODCamera camera;
+            Matrix4x4 projectionMatrix;
+            camera.valid = Render::CameraLens::viewMatrixForCamera(m_manager->renderNodesManager(), lod->camera(),
+                                                                  camera.viewMatrix, projectionMatrix);
+            camera.viewProjectionMatrix = projectionMatrix * camera.viewMatrix;
+            it = m_cameraIndices.insert(lod->camera(), int(m_cameras.size()));
+            m_cameras.push_back(camera);
         }
 
-        const Vector3D tcenter = viewMatrix * center;
-        const float dist = tcenter.length();
-        const int n = thresholds.size();
-        for (int i=0; i<n; ++i) {
-            if (dist <= thresholds[i] || i == n -1) {
-                m_filterValue = approxRollingAverage<30>(m_filterValue, i);
-                i = qBound(0, static_cast<int>(qRound(m_filterValue)), n - 1);
-                if (lod->currentIndex() != i) {
-                    lod->setCurrentIndex(i);
-                    m_updatedIndices.push_back({lod->peerId(), i});
+        LODCamera &camera = m_cameras[it.value()];
+        if (!camera.valid)
+            return -1;
+
+        if (lod->thresholdType() == QLevelOfDetail::ProjectedScreenPixelSizeThreshold) {
+            // Walking the frame graph is costly, only do it once per camera
+            if (!camera.viewportGathered) {
+                PickingUtils::ViewportCameraAreaGatherer vcaGatherer(lod->camera());
+                const std::vector<PickingUtils::ViewportCameraAreaDetails> &vcaTriplets = vcaGatherer.gather(m_frameGraphRoot);
+                if (!vcaTriplets.empty()) {
+                    const PickingUtils::ViewportCameraAreaDetails &vca = vcaTriplets.front();
+                    camera.viewport = vca.viewport;
+                    camera.windowViewport = windowViewport(vca.area, vca.viewport);
+                    camera.hasViewport = true;
                 }
-                break;
+                camera.viewportGathered = true;
             }
+            if (!camera.hasViewport)
+                return -1;
         }
+
+        return it.value();
     }
+};
 
-    void updateEntityLodByScreenArea(Qt3DRender::Render::Entity *entity, Qt3DRender::Render::LevelOfDetail *lod)
+// Computes the metric (distance to the camera or projected size) compared
+// against the thresholds. Only reads from the backend, safe to run in parallel.
+struct LODMetricFunctor
+{
+    const std::vector<LODCamera> *cameras;
+
+    void operator ()(LODEvaluationData &data) const
     {
         using namespace Qt3DRender;
         using namespace Qt3DRender::Render;
 
-        Matrix4x4 viewMatrix;
-        Matrix4x4 projectionMatrix;
-        if (!Render::CameraLens::viewMatrixForCamera(m_manager->renderNodesManager(), lod->camera(), viewMatrix, projectionMatrix))
-            return;
-
-        PickingUtils::ViewportCameraAreaGatherer vcaGatherer(lod->camera());
-        const std::vector<PickingUtils::ViewportCameraAreaDetails> &vcaTriplets = vcaGatherer.gather(m_frameGraphRoot);
-        if (vcaTriplets.empty())
-            return;
-
-        const PickingUtils::ViewportCameraAreaDetails &vca = vcaTriplets.front();
-
-        const QList<qreal> thresholds = lod->thresholds();
-        Sphere bv(Vector3D(lod->center()), lod->radius());
-        if (!lod->hasBoundingVolumeOverride() && entity->worldBoundingVolume() != nullptr) {
-            bv = *(entity->worldBoundingVolume());
-        } else {
-            bv.transform(*entity->worldTransform());
+        const LODCamera &camera = (*cameras)[data.cameraIndex];
+        Entity *entity = data.entity;
+        const LevelOfDetail *lod = data.lod;
+
+        switch (lod->thresholdType()) {
+        case QLevelOfDetail::DistanceToCameraThreshold: {
+            Vector3D center(lod->center());
+            if (lod->hasBoundingVolumeOverride() || entity->worldBoundingVolume() == nullptr)
+                center = *entity->worldTransform() * center;
+            else
+                center = entity->worldBoundingVolume()->center();
+
+            const Vector3D tcenter = camera.viewMatrix * center;
+            data.metric = tcenter.length();
+            break;
         }
-
-        bv.transform(projectionMatrix * viewMatrix);
-        const float sideLength = bv.radius() * 2.f;
-        float area = vca.viewport.width() * sideLength * vca.viewport.height() * sideLength;
-
-        const QRect r = windowViewport(vca.area, vca.viewport);
-        area =  std::sqrt(area * r.width() * r.height());
-
-        const int n = thresholds.size();
-        for (int i = 0; i < n; ++i) {
-            if (thresholds[i] < area || i == n -1) {
-                m_filterValue = approxRollingAverage<30>(m_filterValue, i);
-                i = qBound(0, static_cast<int>(qRound(m_filterValue)), n - 1);
-                if (lod->currentIndex() != i) {
-                    lod->setCurrentIndex(i);
-                    m_updatedIndices.push_back({lod->peerId(), i});
-                }
-                break;
-            }
+        case QLevelOfDetail::ProjectedScreenPixelSizeThreshold: {
+            Sphere bv(Vector3D(lod->center()), lod->radius());
+            if (!lod->hasBoundingVolumeOverride() && entity->worldBoundingVolume() != nullptr)
+                bv = *(entity->worldBoundingVolume());
+            else
+                bv.transform(*entity->worldTransform());
+
+            bv.transform(camera.viewProjectionMatrix);
+            const float sideLength = bv.radius() * 2.f;
+            const float area = camera.viewport.width() * sideLength * camera.viewport.height() * sideLength;
+            data.metric = std::sqrt(area * camera.windowViewport.width() * camera.windowViewport.height());
+            break;
+        }
+        default:
+            Q_ASSERT(false);
+            break;
         }
     }
+};
 
-    QRect windowViewport(const QSize &area, const QRectF &relativeViewport) const
-    {
-        if (area.isValid()) {
-            const int areaWidth = area.width();
-            const int areaHeight = area.height();
-            return QRect(relativeViewport.x() * areaWidth,
-                         (1.0 - relativeViewport.y() - relativeViewport.height()) * areaHeight,
-                         relativeViewport.width() * areaWidth,
-                         relativeViewport.height() * areaHeight);
+// The metric is compared against the thresholds in double precision, as
+// the per LOD evaluation did, so that the same index is selected when the
+// metric lies right on a threshold
+int thresholdIndexForMetric(const Qt3DRender::Render::LevelOfDetail *lod, float metric)
+{
+    using namespace Qt3DRender;
+
+    const QList<qreal> &thresholds = lod->thresholds();
+    const int n = int(thresholds.size());
+    if (lod->thresholdType() == QLevelOfDetail::DistanceToCameraThreshold) {
+        for (int i = 0; i < n - 1; ++i) {
+            if (metric <= thresholds[i])
+                return i;
+        }
+    } else {
+        for (int i = 0; i < n - 1; ++i) {
+            if (thresholds[i] < metric)
+                return i;
         }
-        return relativeViewport.toRect();
     }
-};
+    return n - 1;
+}
 
 }
 
@@ -226,7 +278,6 @@ UpdateLevelOfDetailJob::UpdateLevelOfDetailJob()
     , m_manager(nullptr)
     , m_frameGraphRoot(nullptr)
     , m_root(nullptr)
-    , m_filterValue(0.)
 {
     SET_JOB_RUN_STAT_TYPE(this, JobTypes::UpdateLevelOfDetail, 0)
 }
@@ -260,10 +311,36 @@ void UpdateLevelOfDetailJob::run()
     if (m_manager->levelOfDetailManager()->count() == 0)
         return;
 
-    LODUpdateVisitor visitor(m_filterValue, m_frameGraphRoot, m_manager);
-    visitor.apply(m_root);
-    m_filterValue = visitor.filterValue();
-    d->m_updatedIndices = visitor.updatedIndices();
+    LODGatherer gatherer(m_frameGraphRoot, m_manager);
+    gatherer.apply(m_root);
+
+    std::vector<LODEvaluationData> &lods = gatherer.lods();
+    LODMetricFunctor functor;
+    functor.cameras = &gatherer.cameras();
+
+#if QT_CONFIG(concurrent)
+    if (lods.size() > parallelEvaluationThreshold)
+        QtConcurrent::blockingMap(lods, functor);
+    else
+#endif
+        std::for_each(lods.begin(), lods.end(), functor);
+
+    // Select the new indices. Each LOD filters its own index over time
+    // to avoid switching back and forth around a threshold.
+    QList<QPair<Qt3DCore::QNodeId, int>> updatedIndices;
+    for (const LODEvaluationData &data : lods) {
+        LevelOfDetail *lod = data.lod;
+        const int n = int(lod->thresholds().size());
+        const double filterValue = approxRollingAverage<30>(lod->filterValue(),
+                                                            thresholdIndexForMetric(lod, data.metric));
+        lod->setFilterValue(filterValue);
+        const int i = qBound(0, static_cast<int>(qRound(filterValue)), n - 1);
+        if (lod->currentIndex() != i) {
+            lod->setCurrentIndex(i);
+            updatedIndices.push_back({lod->peerId(), i});
+        }
+    }
+    d->m_updatedIndices = std::move(updatedIndices);
 }
 
 bool UpdateLevelOfDetailJobPrivate::isRequired() const
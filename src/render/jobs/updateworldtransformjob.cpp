@@ -49,6 +49,7 @@
 #include <Qt3DRender/private/managers_p.h>
 #include <Qt3DRender/private/nodemanagers_p.h>
 
+#include <QPointer>
 #include <QThread>
 
 QT_BEGIN_NAMESPACE
@@ -64,7 +65,8 @@ struct TransformUpdate
     QMatrix4x4 worldTransformMatrix;
 };
 
-void updateWorldTransformAndBounds(NodeManagers *manager, Entity *node, const Matrix4x4 &parentTransform, QList<TransformUpdate> &updatedTransforms)
+void updateWorldTransformAndBounds(NodeManagers *manager, Entity *node, const Matrix4x4 &parentTransform,
+                                   bool writeBack, bool forceWriteBack, QList<TransformUpdate> &updatedTransforms)
 {
     if (!node->isEnabled())
         return;
@@ -73,23 +75,43 @@ void updateWorldTransformAndBounds(NodeManagers *manager, Entity *node, const Ma
     Transform *nodeTransform = node->renderComponent<Transform>();
 
     const bool hasTransformComponent = nodeTransform != nullptr && nodeTransform->isEnabled();
-    if (hasTransformComponent)
+    if (hasTransformComponent) {
         worldTransform = worldTransform * nodeTransform->transformMatrix();
+        // Opting out of world matrix updates applies to the whole subtree
+        writeBack = writeBack && nodeTransform->worldMatrixUpdatesEnabled();
+        // Updates were enabled again, refresh the whole subtree once
+        if (nodeTransform->isWorldMatrixRefreshRequested()) {
+            forceWriteBack = true;
+            nodeTransform->clearWorldMatrixRefreshRequest();
+        }
+    }
 
+    bool worldTransformChanged = false;
     if (*(node->worldTransform()) != worldTransform) {
         *(node->worldTransform()) = worldTransform;
-        if (hasTransformComponent)
-            updatedTransforms.push_back({nodeTransform->peerId(), convertToQMatrix4x4(worldTransform)});
+        worldTransformChanged = true;
     }
+    if (hasTransformComponent && writeBack && (worldTransformChanged || forceWriteBack))
+        updatedTransforms.push_back({nodeTransform->peerId(), convertToQMatrix4x4(worldTransform)});
 
     const auto &childrenHandles = node->childrenHandles();
     for (const HEntity &handle : childrenHandles) {
         Entity *child = manager->renderNodesManager()->data(handle);
         if (child)
-            updateWorldTransformAndBounds(manager, child, worldTransform, updatedTransforms);
+            updateWorldTransformAndBounds(manager, child, worldTransform, writeBack, forceWriteBack, updatedTransforms);
     }
 }
 
+bool isWorldMatrixWrittenBack(Entity *node)
+{
+    for (; node != nullptr; node = node->parent()) {
+        const Transform *transform = node->renderComponent<Transform>();
+        if (transform != nullptr && transform->isEnabled() && !transform->worldMatrixUpdatesEnabled())
+            return false;
+    }
+    return true;
+}
+
 }
 
 class Q_3DRENDERSHARED_PRIVATE_EXPORT UpdateWorldTransformJobPrivate : public Qt3DCore::QAspectJobPrivate
@@ -137,22 +159,59 @@ void UpdateWorldTransformJob::run()
     Entity *parent = m_node->parent();
     if (parent != nullptr)
         parentTransform = *(parent->worldTransform());
-    updateWorldTransformAndBounds(m_manager, m_node, parentTransform, d->m_updatedTransforms);
+    updateWorldTransformAndBounds(m_manager, m_node, parentTransform, isWorldMatrixWrittenBack(parent),
+                                  false, d->m_updatedTransforms);
 
     qCDebug(Jobs) << "Exiting" << Q_FUNC_INFO << QThread::currentThread();
 }
 
+QList<Qt3DCore::QNodeId> UpdateWorldTransformJob::pendingWorldMatrixUpdates() const
+{
+    Q_D(const UpdateWorldTransformJob);
+    QList<Qt3DCore::QNodeId> peerIds;
+    peerIds.reserve(d->m_updatedTransforms.size());
+    for (const TransformUpdate &t : d->m_updatedTransforms)
+        peerIds.push_back(t.peerId);
+    return peerIds;
+}
+
 void UpdateWorldTransformJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
 {
     const QList<TransformUpdate> updatedTransforms = std::move(m_updatedTransforms);
-    for (const TransformUpdate &t : updatedTransforms) {
-        Qt3DCore::QTransform *node =
-                qobject_cast<Qt3DCore::QTransform *>(manager->lookupNode(t.peerId));
+    if (updatedTransforms.isEmpty())
+        return;
+
+    // Resolve all the frontend nodes in a single lookup
+    QList<Qt3DCore::QNodeId> peerIds;
+    peerIds.reserve(updatedTransforms.size());
+    for (const TransformUpdate &t : updatedTransforms)
+        peerIds.push_back(t.peerId);
+    const QList<Qt3DCore::QNode *> nodes = manager->lookupNodes(peerIds);
+
+    // Store every world matrix before emitting any notification so that
+    // observers of worldMatrixChanged always see the complete frame. Slots
+    // may destroy other transforms, hence the guarded pointers
+    QList<QPointer<Qt3DCore::QTransform>> changedTransforms;
+    changedTransforms.reserve(updatedTransforms.size());
+    for (int i = 0, m = int(updatedTransforms.size()); i < m; ++i) {
+        Qt3DCore::QNode *node = nodes.at(i);
         if (!node)
             continue;
+        // Transform backends are only ever created for QTransform peers
+        Q_ASSERT(qobject_cast<Qt3DCore::QTransform *>(node));
+        Qt3DCore::QTransform *transform = static_cast<Qt3DCore::QTransform *>(node);
         Qt3DCore::QTransformPrivate *dNode =
-                static_cast<Qt3DCore::QTransformPrivate *>(Qt3DCore::QNodePrivate::get(node));
-        dNode->setWorldMatrix(t.worldTransformMatrix);
+                static_cast<Qt3DCore::QTransformPrivate *>(Qt3DCore::QNodePrivate::get(transform));
+        const QMatrix4x4 &worldMatrix = updatedTransforms.at(i).worldTransformMatrix;
+        if (dNode->m_worldMatrix == worldMatrix)
+            continue;
+        dNode->m_worldMatrix = worldMatrix;
+        changedTransforms.push_back(transform);
+    }
+
+    for (const QPointer<Qt3DCore::QTransform> &transform : qAsConst(changedTransforms)) {
+        if (transform)
+            static_cast<Qt3DCore::QTransformPrivate *>(Qt3DCore::QNodePrivate::get(transform.data()))->notifyWorldMatrixChanged();
     }
 }
 
@@ -52,6 +52,7 @@
 //
 
 #include <Qt3DCore/qaspectjob.h>
+#include <Qt3DCore/qnodeid.h>
 #include <Qt3DRender/private/qt3drender_global_p.h>
 
 #include <QSharedPointer>
@@ -75,6 +76,9 @@ public:
 
     void run() override;
 
+    // Transforms whose world matrix will be written back to the frontend
+    QList<Qt3DCore::QNodeId> pendingWorldMatrixUpdates() const;
+
 private:
     Entity *m_node;
     NodeManagers *m_manager;
@@ -0,0 +1,221 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB)
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "lightgrid_p.h"
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/sphere_p.h>
+#include <QtCore/qvarlengtharray.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+namespace {
+
+// Aim for a couple of lights per cell while keeping the grid small enough
+// that rebuilding it every frame stays negligible
+const int LightsPerCell = 2;
+const int MaxGridResolution = 16;
+
+} // anonymous
+
+LightGrid::LightGrid()
+    : m_resolution(0)
+    , m_min{0.0f, 0.0f, 0.0f}
+    , m_cellSize{1.0f, 1.0f, 1.0f}
+    , m_inverseCellSize{1.0f, 1.0f, 1.0f}
+{
+}
+
+void LightGrid::clear()
+{
+    m_resolution = 0;
+    m_positions.clear();
+    m_cellStarts.clear();
+    m_cellLights.clear();
+}
+
+void LightGrid::build(const std::vector<LightSource> &lightSources)
+{
+    clear();
+
+    const size_t lightCount = lightSources.size();
+    if (lightCount == 0)
+        return;
+
+    m_positions.reserve(lightCount);
+    float minimum[3] = { std::numeric_limits<float>::max(),
+                         std::numeric_limits<float>::max(),
+                         std::numeric_limits<float>::max() };
+    float maximum[3] = { std::numeric_limits<float>::lowest(),
+                         std::numeric_limits<float>::lowest(),
+                         std::numeric_limits<float>::lowest() };
+    for (const LightSource &lightSource : lightSources) {
+        const Vector3D position = lightSource.entity->worldBoundingVolume()->center();
+        m_positions.push_back(position);
+        for (int axis = 0; axis < 3; ++axis) {
+            minimum[axis] = std::min(minimum[axis], position[axis]);
+            maximum[axis] = std::max(maximum[axis], position[axis]);
+        }
+    }
+
+    m_resolution = std::clamp(int(std::ceil(std::cbrt(double(lightCount) / LightsPerCell))),
+                              1, MaxGridResolution);
+    for (int axis = 0; axis < 3; ++axis) {
+        const float extent = maximum[axis] - minimum[axis];
+        m_min[axis] = minimum[axis];
+        m_cellSize[axis] = extent > 0.0f ? extent / m_resolution : 1.0f;
+        m_inverseCellSize[axis] = 1.0f / m_cellSize[axis];
+    }
+
+    // Counting sort of the light indices by cell
+    const int cellCount = m_resolution * m_resolution * m_resolution;
+    std::vector<int> lightCells(lightCount);
+    m_cellStarts.assign(cellCount + 1, 0);
+    for (size_t i = 0; i < lightCount; ++i) {
+        const Vector3D &position = m_positions[i];
+        const int cell = cellCoordinate(position[0], 0)
+                + m_resolution * (cellCoordinate(position[1], 1)
+                                  + m_resolution * cellCoordinate(position[2], 2));
+        lightCells[i] = cell;
+        ++m_cellStarts[cell + 1];
+    }
+    for (int cell = 0; cell < cellCount; ++cell)
+        m_cellStarts[cell + 1] += m_cellStarts[cell];
+
+    std::vector<int> insertionOffsets(m_cellStarts.begin(), m_cellStarts.end() - 1);
+    m_cellLights.resize(lightCount);
+    for (size_t i = 0; i < lightCount; ++i)
+        m_cellLights[insertionOffsets[lightCells[i]]++] = int(i);
+}
+
+int LightGrid::cellCoordinate(float value, int axis) const
+{
+    const int coordinate = int((value - m_min[axis]) * m_inverseCellSize[axis]);
+    return std::clamp(coordinate, 0, m_resolution - 1);
+}
+
+int LightGrid::closestLights(const Vector3D &position, int maxCount, int *indices) const
+{
+    maxCount = std::min(maxCount, lightCount());
+    if (maxCount <= 0)
+        return 0;
+
+    const float p[3] = { position[0], position[1], position[2] };
+    const int center[3] = { cellCoordinate(p[0], 0), cellCoordinate(p[1], 1), cellCoordinate(p[2], 2) };
+    QVarLengthArray<float, 16> squaredDistances(maxCount);
+    int found = 0;
+
+    const auto visitCell = [&] (int x, int y, int z) {
+        const int cell = x + m_resolution * (y + m_resolution * z);
+        for (int i = m_cellStarts[cell], end = m_cellStarts[cell + 1]; i < end; ++i) {
+            const int lightIndex = m_cellLights[i];
+            const float squaredDistance = (m_positions[lightIndex] - position).lengthSquared();
+            if (found == maxCount && squaredDistance >= squaredDistances[found - 1])
+                continue;
+
+            // Insertion into the sorted list of the closest lights found so far
+            int slot = std::min(found, maxCount - 1);
+            while (slot > 0 && squaredDistances[slot - 1] > squaredDistance) {
+                squaredDistances[slot] = squaredDistances[slot - 1];
+                indices[slot] = indices[slot - 1];
+                --slot;
+            }
+            squaredDistances[slot] = squaredDistance;
+            indices[slot] = lightIndex;
+            found = std::min(found + 1, maxCount);
+        }
+    };
+
+    // Visit shells of cells at increasing Chebyshev distance from the cell
+    // containing position until no unvisited cell can hold a closer light
+    for (int ring = 0; ring < m_resolution; ++ring) {
+        int low[3];
+        int high[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            low[axis] = std::max(center[axis] - ring, 0);
+            high[axis] = std::min(center[axis] + ring, m_resolution - 1);
+        }
+
+        for (int z = low[2]; z <= high[2]; ++z) {
+            for (int y = low[1]; y <= high[1]; ++y) {
+                const bool onShell = std::abs(z - center[2]) == ring || std::abs(y - center[1]) == ring;
+                if (onShell) {
+                    for (int x = low[0]; x <= high[0]; ++x)
+                        visitCell(x, y, z);
+                } else {
+                    if (center[0] - ring >= 0)
+                        visitCell(center[0] - ring, y, z);
+                    if (center[0] + ring < m_resolution)
+                        visitCell(center[0] + ring, y, z);
+                }
+            }
+        }
+
+        // Lower bound of the distance between position and any cell outside
+        // of the box visited so far
+        float bound = std::numeric_limits<float>::max();
+        bool allVisited = true;
+        for (int axis = 0; axis < 3; ++axis) {
+            if (low[axis] > 0) {
+                allVisited = false;
+                bound = std::min(bound, std::max(0.0f, p[axis] - (m_min[axis] + low[axis] * m_cellSize[axis])));
+            }
+            if (high[axis] < m_resolution - 1) {
+                allVisited = false;
+                bound = std::min(bound, std::max(0.0f, m_min[axis] + (high[axis] + 1) * m_cellSize[axis] - p[axis]));
+            }
+        }
+        if (allVisited || (found == maxCount && bound * bound >= squaredDistances[found - 1]))
+            break;
+    }
+
+    return found;
+}
+
+} // Render
+
+} // Qt3DRender
+
+QT_END_NAMESPACE
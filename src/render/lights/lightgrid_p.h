@@ -0,0 +1,101 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB)
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DRENDER_RENDER_LIGHTGRID_P_H
+#define QT3DRENDER_RENDER_LIGHTGRID_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DRender/private/qt3drender_global_p.h>
+#include <Qt3DRender/private/lightsource_p.h>
+#include <Qt3DCore/private/vector3d_p.h>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+// Uniform world space grid binning the light sources of a RenderView so that
+// the lights closest to a given position can be found without sorting all of
+// them for every RenderCommand.
+class Q_3DRENDERSHARED_PRIVATE_EXPORT LightGrid
+{
+public:
+    LightGrid();
+
+    void build(const std::vector<LightSource> &lightSources);
+    void clear();
+
+    // Writes the indices of the (at most) maxCount light sources closest to
+    // position into indices, nearest first, and returns how many were written
+    int closestLights(const Vector3D &position, int maxCount, int *indices) const;
+
+    int resolution() const { return m_resolution; }
+    int lightCount() const { return int(m_positions.size()); }
+
+private:
+    int cellCoordinate(float value, int axis) const;
+
+    int m_resolution;
+    float m_min[3];
+    float m_cellSize[3];
+    float m_inverseCellSize[3];
+    std::vector<Vector3D> m_positions;
+    std::vector<int> m_cellStarts;
+    std::vector<int> m_cellLights;
+};
+
+} // Render
+
+} // Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_RENDER_LIGHTGRID_P_H
@@ -13,6 +13,7 @@ HEADERS += \
     $$PWD/qspotlight_p.h \
     $$PWD/environmentlight_p.h \
     $$PWD/light_p.h \
+    $$PWD/lightgrid_p.h \
     $$PWD/lightsource_p.h
 
 SOURCES += \
@@ -23,4 +24,5 @@ SOURCES += \
     $$PWD/qspotlight.cpp \
     $$PWD/environmentlight.cpp \
     $$PWD/light.cpp \
+    $$PWD/lightgrid.cpp \
     $$PWD/lightsource.cpp
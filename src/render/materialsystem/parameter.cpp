@@ -79,14 +79,18 @@ void Parameter::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
     if (node->isEnabled() != isEnabled())
         dirty |= (AbstractRenderer::MaterialDirty | AbstractRenderer::ParameterDirty);
 
-    if (node->name() != m_name) {
-        m_name = node->name();
+    // Only consume the fields the frontend recorded as changed, which spares
+    // comparing and converting the value variant on every sync
+    const QParameterPrivate *d = static_cast<const QParameterPrivate *>(QNodePrivate::get(node));
+    const quint32 changedFields = firstTime ? ~0u : d->m_changedFields;
+
+    if ((changedFields & QParameterPrivate::NameField) && d->m_name != m_name) {
+        m_name = d->m_name;
         m_nameId = StringToInt::lookupId(m_name);
         dirty |= (AbstractRenderer::MaterialDirty | AbstractRenderer::ParameterDirty);
     }
 
-    QParameterPrivate* d = static_cast<QParameterPrivate *>(QParameterPrivate::get(const_cast<QParameter *>(node)));
-    if (d->m_backendValue != m_backendValue) {
+    if ((changedFields & QParameterPrivate::ValueField) && d->m_backendValue != m_backendValue) {
         m_backendValue = d->m_backendValue;
         m_uniformValue = UniformValue::fromVariant(m_backendValue);
         dirty |= (AbstractRenderer::ParameterDirty);
@@ -207,6 +207,7 @@ void QParameterPrivate::setValue(const QVariant &v)
         m_backendValue = toBackendValue(v);
     }
     m_value = v;
+    markFieldsChanged(ValueField);
 }
 
 /*! \internal */
@@ -267,6 +268,7 @@ void QParameter::setName(const QString &name)
     Q_D(QParameter);
     if (d->m_name != name) {
         d->m_name = name;
+        d->markFieldsChanged(QParameterPrivate::NameField);
         emit nameChanged(name);
     }
 }
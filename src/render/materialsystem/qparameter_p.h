@@ -67,6 +67,12 @@ public:
 
     Q_DECLARE_PUBLIC(QParameter)
 
+    // Fields recorded with markFieldsChanged()
+    enum ChangedField : quint32 {
+        NameField = 1 << 0,
+        ValueField = 1 << 1
+    };
+
     virtual void setValue(const QVariant &v);
 
     QString m_name;
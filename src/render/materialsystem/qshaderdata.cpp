@@ -39,6 +39,7 @@
 
 #include "qshaderdata.h"
 #include "qshaderdata_p.h"
+#include <QtCore/QMetaProperty>
 
 QT_BEGIN_NAMESPACE
 
@@ -60,6 +61,26 @@ QShaderDataPrivate::QShaderDataPrivate(PropertyReaderInterfacePtr reader)
 {
 }
 
+void QShaderDataPrivate::recordPropertyChange(const char *name)
+{
+    const QString propertyName = QString::fromLatin1(name);
+    if (!m_changedProperties.contains(propertyName))
+        m_changedProperties.push_back(propertyName);
+}
+
+void QShaderDataPrivate::propertyChanged(int propertyIndex)
+{
+    Q_Q(QShaderData);
+    recordPropertyChange(q->metaObject()->property(propertyIndex).name());
+    QComponentPrivate::propertyChanged(propertyIndex);
+}
+
+void QShaderDataPrivate::clearChangedFields()
+{
+    m_changedProperties.clear();
+    QComponentPrivate::clearChangedFields();
+}
+
 /*!
  * \class Qt3DRender::QShaderData
  * \inheaderfile Qt3DRender/QShaderData
@@ -117,6 +138,7 @@ bool QShaderData::event(QEvent *event)
     if (event->type() == QEvent::DynamicPropertyChange) {
         auto e = static_cast<QDynamicPropertyChangeEvent*>(event);
         const auto propertyName = e->propertyName();
+        d->recordPropertyChange(propertyName.constData());
 
         const QVariant data = property(propertyName);
         if (data.canConvert<Qt3DCore::QNode*>()) {
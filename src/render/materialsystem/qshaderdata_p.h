@@ -93,6 +93,13 @@ public:
     QShaderDataPrivate(PropertyReaderInterfacePtr reader);
     PropertyReaderInterfacePtr m_propertyReader;
 
+    // Names of the properties changed since the node was last synced
+    QList<QString> m_changedProperties;
+
+    void recordPropertyChange(const char *name);
+    void propertyChanged(int propertyIndex) override;
+    void clearChangedFields() override;
+
     Q_DECLARE_PUBLIC(QShaderData)
 };
 
@@ -138,13 +138,16 @@ void ShaderData::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
         }
         BackendNode::markDirty(AbstractRenderer::ParameterDirty);
     } else {
-        // Updates
+        // Updates, only reading back the properties recorded as changed
         if (!m_propertyReader.isNull()) {
-            auto it = m_originalProperties.begin();
+            const QShaderDataPrivate *d = static_cast<const QShaderDataPrivate *>(QNodePrivate::get(node));
             const auto end = m_originalProperties.end();
 
-            while (it != end) {
-                const QVariant newValue = m_propertyReader->readProperty(node->property(it.key().toLatin1()));
+            for (const QString &propertyName : d->m_changedProperties) {
+                const auto it = m_originalProperties.find(propertyName);
+                if (it == end)
+                    continue;
+                const QVariant newValue = m_propertyReader->readProperty(node->property(propertyName.toLatin1()));
                 PropertyValue &propValue = it.value();
                 if (propValue.value != newValue) {
                     // Note we aren't notified about nested QShaderData in this call
@@ -152,7 +155,6 @@ void ShaderData::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
                     propValue.value = newValue;
                     BackendNode::markDirty(AbstractRenderer::ParameterDirty);
                 }
-                ++it;
             }
         }
     }
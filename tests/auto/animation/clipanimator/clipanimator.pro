@@ -2,7 +2,7 @@ TEMPLATE = app
 
 TARGET = tst_clipanimator
 
-QT += core-private 3dcore 3dcore-private 3danimation 3danimation-private testlib
+QT += core-private 3dcore 3dcore-private 3danimation 3danimation-private 3drender testlib
 
 CONFIG += testcase
 
@@ -28,10 +28,13 @@
 
 #include <QtTest/QTest>
 #include <Qt3DAnimation/private/clipanimator_p.h>
+#include <Qt3DAnimation/private/handler_p.h>
+#include <Qt3DAnimation/private/managers_p.h>
 #include <Qt3DAnimation/qanimationcliploader.h>
 #include <Qt3DAnimation/qchannelmapper.h>
 #include <Qt3DAnimation/qclipanimator.h>
 #include <Qt3DAnimation/qclock.h>
+#include <Qt3DRender/qlevelofdetail.h>
 #include <Qt3DCore/private/qnode_p.h>
 #include <Qt3DCore/private/qscene_p.h>
 #include <Qt3DCore/private/qbackendnode_p.h>
@@ -173,6 +176,107 @@ private Q_SLOTS:
         // THEN
         QVERIFY(qFuzzyCompare(backendAnimator.normalizedLocalTime(), 0.5f));
     }
+
+    void checkLevelOfDetailEvaluationInterval()
+    {
+        // GIVEN
+        Qt3DAnimation::QClipAnimator animator;
+        Qt3DAnimation::Animation::Handler handler;
+        Qt3DAnimation::Animation::ClipAnimator backendAnimator;
+        backendAnimator.setHandler(&handler);
+        simulateInitializationSync(&animator, &backendAnimator);
+
+        // THEN
+        QVERIFY(backendAnimator.levelOfDetailId().isNull());
+        QVERIFY(backendAnimator.advanceEvaluationFrame());
+        QCOMPARE(backendAnimator.evaluationInterval(), 1);
+
+        // WHEN
+        auto lod = new Qt3DRender::QLevelOfDetail();
+        animator.setLevelOfDetail(lod);
+        animator.setLevelOfDetailFrameIntervals({ 1, 4, 0 });
+        backendAnimator.syncFromFrontEnd(&animator, false);
+        Qt3DAnimation::Animation::LevelOfDetail *backendLod
+                = handler.levelOfDetailManager()->getOrCreateResource(lod->id());
+
+        // THEN
+        QCOMPARE(backendAnimator.levelOfDetailId(), lod->id());
+        QCOMPARE(backendAnimator.levelOfDetailFrameIntervals(), QList<int>({ 1, 4, 0 }));
+        QVERIFY(backendAnimator.advanceEvaluationFrame());
+        QCOMPARE(backendAnimator.evaluationInterval(), 1);
+
+        // WHEN
+        // The index is only read from the backend level of detail,
+        // changing the frontend without a sync has no effect
+        lod->setCurrentIndex(2);
+        backendAnimator.advanceEvaluationFrame();
+
+        // THEN
+        QCOMPARE(backendAnimator.evaluationInterval(), 1);
+
+        // WHEN
+        backendLod->setCurrentIndex(1);
+        int evaluationCount = 0;
+        for (int i = 0; i < 16; ++i)
+            evaluationCount += backendAnimator.advanceEvaluationFrame() ? 1 : 0;
+
+        // THEN
+        QCOMPARE(backendAnimator.evaluationInterval(), 4);
+        QCOMPARE(evaluationCount, 4);
+
+        // WHEN
+        backendLod->setCurrentIndex(5);
+
+        // THEN
+        for (int i = 0; i < 16; ++i)
+            QVERIFY(!backendAnimator.advanceEvaluationFrame());
+        QCOMPARE(backendAnimator.evaluationInterval(), 0);
+
+        // WHEN
+        animator.setLevelOfDetail(nullptr);
+        backendAnimator.syncFromFrontEnd(&animator, false);
+
+        // THEN
+        QVERIFY(backendAnimator.levelOfDetailId().isNull());
+        QVERIFY(backendAnimator.advanceEvaluationFrame());
+        QCOMPARE(backendAnimator.evaluationInterval(), 1);
+    }
+
+    void checkStoppedFrozenAnimatorIsNotRunning()
+    {
+        // GIVEN
+        Qt3DAnimation::Animation::Handler handler;
+        Qt3DRender::QLevelOfDetail lod;
+        Qt3DAnimation::QClipAnimator animator;
+        animator.setLevelOfDetail(&lod);
+        animator.setLevelOfDetailFrameIntervals({ 0 });
+        animator.setRunning(true);
+
+        Qt3DAnimation::Animation::ClipAnimator *backendAnimator
+                = handler.clipAnimatorManager()->getOrCreateResource(animator.id());
+        backendAnimator->setHandler(&handler);
+        simulateInitializationSync(&animator, backendAnimator);
+        handler.levelOfDetailManager()->getOrCreateResource(lod.id());
+
+        const Qt3DAnimation::Animation::HClipAnimator handle
+                = handler.clipAnimatorManager()->lookupHandle(animator.id());
+        handler.setClipAnimatorRunning(handle, true);
+
+        // WHEN
+        handler.jobsToExecute(0);
+
+        // THEN
+        // Frozen but still running
+        QCOMPARE(handler.runningClipAnimators().size(), 1);
+        QCOMPARE(backendAnimator->evaluationInterval(), 0);
+
+        // WHEN
+        backendAnimator->setRunning(false);
+        handler.jobsToExecute(0);
+
+        // THEN
+        QVERIFY(handler.runningClipAnimators().isEmpty());
+    }
 };
 
 QTEST_APPLESS_MAIN(tst_ClipAnimator)
@@ -0,0 +1,15 @@
+TEMPLATE = app
+
+TARGET = tst_mappingcache
+
+QT += core-private 3dcore 3dcore-private 3danimation 3danimation-private testlib
+
+CONFIG += testcase
+
+SOURCES += \
+    tst_mappingcache.cpp
+
+include(../../core/common/common.pri)
+
+RESOURCES += \
+    mappingcache.qrc
@@ -0,0 +1,243 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <Qt3DAnimation/qchannelmapping.h>
+#include <Qt3DAnimation/private/animationclip_p.h>
+#include <Qt3DAnimation/private/channelmapper_p.h>
+#include <Qt3DAnimation/private/channelmapping_p.h>
+#include <Qt3DAnimation/private/handler_p.h>
+#include <Qt3DAnimation/private/managers_p.h>
+#include <Qt3DAnimation/private/mappingcache_p.h>
+#include <Qt3DCore/private/qbackendnode_p.h>
+#include <qbackendnodetester.h>
+
+using namespace Qt3DAnimation::Animation;
+
+class tst_MappingCache : public Qt3DCore::QBackendNodeTester
+{
+    Q_OBJECT
+public:
+    ChannelMapping *createChannelMapping(Handler *handler,
+                                         const QString &channelName,
+                                         const char *propertyName,
+                                         int type,
+                                         int componentCount)
+    {
+        auto channelMappingId = Qt3DCore::QNodeId::createId();
+        ChannelMapping *channelMapping = handler->channelMappingManager()->getOrCreateResource(channelMappingId);
+        setPeerId(channelMapping, channelMappingId);
+        channelMapping->setHandler(handler);
+        channelMapping->setTargetId(Qt3DCore::QNodeId::createId());
+        channelMapping->setPropertyName(propertyName);
+        channelMapping->setChannelName(channelName);
+        channelMapping->setType(type);
+        channelMapping->setComponentCount(componentCount);
+        channelMapping->setMappingType(ChannelMapping::ChannelMappingType);
+        return channelMapping;
+    }
+
+    ChannelMapper *createChannelMapper(Handler *handler,
+                                       const QList<Qt3DCore::QNodeId> &mappingIds)
+    {
+        auto channelMapperId = Qt3DCore::QNodeId::createId();
+        ChannelMapper *channelMapper = handler->channelMapperManager()->getOrCreateResource(channelMapperId);
+        setPeerId(channelMapper, channelMapperId);
+        channelMapper->setHandler(handler);
+        channelMapper->setMappingIds(mappingIds);
+        return channelMapper;
+    }
+
+    AnimationClip *createAnimationClipLoader(Handler *handler,
+                                             const QUrl &source)
+    {
+        auto clipId = Qt3DCore::QNodeId::createId();
+        AnimationClip *clip = handler->animationClipLoaderManager()->getOrCreateResource(clipId);
+        setPeerId(clip, clipId);
+        clip->setHandler(handler);
+        clip->setDataType(AnimationClip::File);
+        clip->setSource(source);
+        clip->loadAnimation();
+        return clip;
+    }
+
+private Q_SLOTS:
+    void checkResolvedMappingIsShared()
+    {
+        // GIVEN
+        Handler handler;
+        AnimationClip *clip = createAnimationClipLoader(&handler, QUrl("qrc:/clip1.json"));
+        auto channelMapping = createChannelMapping(&handler,
+                                                   QLatin1String("Location"),
+                                                   "translation",
+                                                   static_cast<int>(QVariant::Vector3D),
+                                                   3);
+        ChannelMapper *mapper = createChannelMapper(&handler, { channelMapping->peerId() });
+        MappingCache *cache = handler.mappingCache();
+
+        // THEN
+        QCOMPARE(cache->mapperLayoutCount(), 0);
+        QCOMPARE(cache->clipMappingCount(), 0);
+
+        // WHEN
+        const ClipMapping first = cache->clipMapping(mapper, clip);
+        const ClipMapping second = cache->clipMapping(mapper, clip);
+
+        // THEN
+        QCOMPARE(cache->mapperLayoutCount(), 1);
+        QCOMPARE(cache->clipMappingCount(), 1);
+        QCOMPARE(first.mappingData.size(), 1);
+        QCOMPARE(first.mappingData.first().targetId, channelMapping->targetId());
+        QCOMPARE(first.mappingData.first().channelIndices, ComponentIndices({ 0, 1, 2 }));
+        QCOMPARE(first.format.sourceClipIndices, second.format.sourceClipIndices);
+        // Resolved data is implicitly shared rather than rebuilt
+        QVERIFY(first.mappingData.constData() == second.mappingData.constData());
+        QVERIFY(first.format.sourceClipIndices.constData() == second.format.sourceClipIndices.constData());
+    }
+
+    void checkInvalidation()
+    {
+        // GIVEN
+        Handler handler;
+        AnimationClip *clip1 = createAnimationClipLoader(&handler, QUrl("qrc:/clip1.json"));
+        AnimationClip *clip2 = createAnimationClipLoader(&handler, QUrl("qrc:/clip1.json"));
+        auto channelMapping = createChannelMapping(&handler,
+                                                   QLatin1String("Location"),
+                                                   "translation",
+                                                   static_cast<int>(QVariant::Vector3D),
+                                                   3);
+        ChannelMapper *mapper = createChannelMapper(&handler, { channelMapping->peerId() });
+        MappingCache *cache = handler.mappingCache();
+        cache->clipMapping(mapper, clip1);
+        cache->clipFormat(mapper, clip2);
+
+        // THEN
+        QCOMPARE(cache->mapperLayoutCount(), 1);
+        QCOMPARE(cache->clipMappingCount(), 2);
+
+        // WHEN
+        handler.setDirty(Handler::AnimationClipDirty, clip1->peerId());
+
+        // THEN
+        QCOMPARE(cache->mapperLayoutCount(), 1);
+        QCOMPARE(cache->clipMappingCount(), 1);
+
+        // WHEN
+        handler.setDirty(Handler::ChannelMappingsDirty, channelMapping->peerId());
+
+        // THEN
+        QCOMPARE(cache->mapperLayoutCount(), 0);
+        QCOMPARE(cache->clipMappingCount(), 0);
+    }
+
+    void checkEvictionOnDestruction()
+    {
+        // GIVEN
+        Handler handler;
+        AnimationClip *clip1 = createAnimationClipLoader(&handler, QUrl("qrc:/clip1.json"));
+        AnimationClip *clip2 = createAnimationClipLoader(&handler, QUrl("qrc:/clip1.json"));
+        auto channelMapping = createChannelMapping(&handler,
+                                                   QLatin1String("Location"),
+                                                   "translation",
+                                                   static_cast<int>(QVariant::Vector3D),
+                                                   3);
+        ChannelMapper *mapper1 = createChannelMapper(&handler, { channelMapping->peerId() });
+        ChannelMapper *mapper2 = createChannelMapper(&handler, { channelMapping->peerId() });
+        MappingCache *cache = handler.mappingCache();
+        cache->clipMapping(mapper1, clip1);
+        cache->clipMapping(mapper1, clip2);
+        cache->clipMapping(mapper2, clip1);
+        cache->clipMapping(mapper2, clip2);
+
+        // THEN
+        QCOMPARE(cache->mapperLayoutCount(), 2);
+        QCOMPARE(cache->clipMappingCount(), 4);
+
+        // WHEN
+        clip1->cleanup();
+
+        // THEN
+        QCOMPARE(cache->mapperLayoutCount(), 2);
+        QCOMPARE(cache->clipMappingCount(), 2);
+
+        // WHEN
+        mapper1->cleanup();
+
+        // THEN
+        QCOMPARE(cache->mapperLayoutCount(), 1);
+        QCOMPARE(cache->clipMappingCount(), 1);
+        QCOMPARE(cache->clipMapping(mapper2, clip2).mappingData.size(), 1);
+    }
+
+    void checkMappingSyncOnlyInvalidatesOnChange()
+    {
+        // GIVEN
+        Handler handler;
+        AnimationClip *clip = createAnimationClipLoader(&handler, QUrl("qrc:/clip1.json"));
+        Qt3DAnimation::QChannelMapping mapping;
+        mapping.setChannelName(QLatin1String("Location"));
+        ChannelMapping *backendMapping = handler.channelMappingManager()->getOrCreateResource(mapping.id());
+        backendMapping->setHandler(&handler);
+        simulateInitializationSync(&mapping, backendMapping);
+        ChannelMapper *mapper = createChannelMapper(&handler, { mapping.id() });
+        MappingCache *cache = handler.mappingCache();
+        cache->clipMapping(mapper, clip);
+
+        // THEN
+        QCOMPARE(cache->mapperLayoutCount(), 1);
+        QCOMPARE(cache->clipMappingCount(), 1);
+
+        // WHEN
+        backendMapping->syncFromFrontEnd(&mapping, false);
+
+        // THEN
+        QCOMPARE(cache->mapperLayoutCount(), 1);
+        QCOMPARE(cache->clipMappingCount(), 1);
+
+        // WHEN
+        mapping.setEnabled(false);
+        backendMapping->syncFromFrontEnd(&mapping, false);
+
+        // THEN
+        QCOMPARE(cache->mapperLayoutCount(), 1);
+        QCOMPARE(cache->clipMappingCount(), 1);
+
+        // WHEN
+        mapping.setChannelName(QLatin1String("Rotation"));
+        backendMapping->syncFromFrontEnd(&mapping, false);
+
+        // THEN
+        QCOMPARE(cache->mapperLayoutCount(), 0);
+        QCOMPARE(cache->clipMappingCount(), 0);
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_MappingCache)
+
+#include "tst_mappingcache.moc"
@@ -51,12 +51,12 @@ public:
             setArbiterOnNode(n);
     }
 
-    QList<Qt3DCore::QNode *> dirtyNodes() const { return m_dirtyFrontEndNodes; }
+    QList<Qt3DCore::QNode *> dirtyNodes() const { return dirtyFrontEndNodes(); }
     QList<Qt3DCore::ComponentRelationshipChange> dirtyComponents() const { return m_dirtyEntityComponentNodeChanges; }
 
     void clear()
     {
-        m_dirtyFrontEndNodes.clear();
+        clearDirtyFrontEndNodes();
         m_dirtyEntityComponentNodeChanges.clear();
     }
 };
@@ -27,10 +27,13 @@
 ****************************************************************************/
 
 #include <QtTest/QtTest>
+#include <QtTest/QSignalSpy>
 #include <Qt3DCore/QAbstractAspect>
+#include <Qt3DCore/qbackendnode.h>
 #include <Qt3DCore/qaspectengine.h>
 #include <Qt3DCore/qentity.h>
 #include <Qt3DCore/qtransform.h>
+#include <Qt3DCore/private/qbackendnode_p.h>
 
 using namespace Qt3DCore;
 
@@ -72,6 +75,94 @@ private:
     QNodeId m_rootEntityId;
 };
 
+class ComponentTrackingNodePrivate : public QBackendNodePrivate
+{
+public:
+    ComponentTrackingNodePrivate()
+        : QBackendNodePrivate(QBackendNode::ReadOnly)
+    {}
+
+    void componentAdded(QNode *frontend) override { m_components.push_back(frontend->id()); }
+    void componentRemoved(QNode *frontend) override { m_components.removeAll(frontend->id()); }
+
+    QNodeIdVector m_components;
+};
+
+class ComponentTrackingNode : public QBackendNode
+{
+public:
+    ComponentTrackingNode()
+        : QBackendNode(*new ComponentTrackingNodePrivate)
+    {}
+
+    QNodeIdVector components() const
+    {
+        return static_cast<ComponentTrackingNodePrivate *>(QBackendNodePrivate::get(const_cast<ComponentTrackingNode *>(this)))->m_components;
+    }
+};
+
+class CountingMapper : public QBackendNodeMapper
+{
+public:
+    QBackendNode *create(QNodeId id) const override
+    {
+        auto node = new ComponentTrackingNode;
+        m_nodes.insert(id, node);
+        m_creationOrder.push_back(id);
+        return node;
+    }
+
+    QBackendNode *get(QNodeId id) const override
+    {
+        return m_nodes.value(id, nullptr);
+    }
+
+    void destroy(QNodeId id) const override
+    {
+        delete m_nodes.take(id);
+    }
+
+    int count() const { return int(m_nodes.size()); }
+    ComponentTrackingNode *node(QNodeId id) const { return m_nodes.value(id, nullptr); }
+    QNodeIdVector creationOrder() const { return m_creationOrder; }
+
+private:
+    mutable QHash<QNodeId, ComponentTrackingNode *> m_nodes;
+    mutable QNodeIdVector m_creationOrder;
+};
+
+class CountingAspect : public QAbstractAspect
+{
+    Q_OBJECT
+public:
+    explicit CountingAspect(QObject *parent = nullptr)
+        : QAbstractAspect(parent)
+        , m_mapper(QSharedPointer<CountingMapper>::create())
+        , m_transformMapper(QSharedPointer<CountingMapper>::create())
+    {
+        registerBackendType<QEntity>(m_mapper);
+        registerBackendType<Qt3DCore::QTransform>(m_transformMapper);
+    }
+
+    int backendNodeCount() const { return m_mapper->count(); }
+    QNodeIdVector backendCreationOrder() const { return m_mapper->creationOrder(); }
+    int transformBackendNodeCount() const { return m_transformMapper->count(); }
+    QNodeIdVector backendComponents(QNodeId entityId) const
+    {
+        ComponentTrackingNode *node = m_mapper->node(entityId);
+        return node ? node->components() : QNodeIdVector();
+    }
+
+private:
+    std::vector<QAspectJobPtr> jobsToExecute(qint64) override
+    {
+        return {};
+    }
+
+    QSharedPointer<CountingMapper> m_mapper;
+    QSharedPointer<CountingMapper> m_transformMapper;
+};
+
 #define FAKE_ASPECT(ClassName, dependAspects) \
 class ClassName : public QAbstractAspect \
 { \
@@ -302,6 +393,153 @@ private Q_SLOTS:
         QVERIFY(!output.isValid());
     }
 
+    void shouldInsertNodesWithinBudget()
+    {
+        // GIVEN
+        QAspectEngine engine;
+        CountingAspect *aspect = new CountingAspect;
+        engine.registerAspect(aspect);
+        engine.setRunMode(QAspectEngine::Manual);
+        engine.setNodeInsertionBudget(2);
+        QSignalSpy progressSpy(&engine, &QAspectEngine::nodeInsertionProgress);
+
+        QEntity *root = new QEntity;
+        engine.setRootEntity(QEntityPtr(root));
+
+        // THEN
+        QCOMPARE(engine.nodeInsertionBudget(), 2);
+        QCOMPARE(aspect->backendNodeCount(), 1);
+
+        // WHEN
+        for (int i = 0; i < 3; ++i)
+            new QEntity(root);
+        engine.processFrame();
+
+        // THEN
+        QCOMPARE(aspect->backendNodeCount(), 3);
+        QCOMPARE(engine.pendingNodeInsertionCount(), 1);
+        QCOMPARE(progressSpy.count(), 1);
+        QCOMPARE(progressSpy.last().at(0).toInt(), 2);
+        QCOMPARE(progressSpy.last().at(1).toInt(), 3);
+
+        // WHEN
+        engine.processFrame();
+
+        // THEN
+        QCOMPARE(aspect->backendNodeCount(), 4);
+        QCOMPARE(engine.pendingNodeInsertionCount(), 0);
+        QCOMPARE(progressSpy.count(), 2);
+        QCOMPARE(progressSpy.last().at(0).toInt(), 3);
+        QCOMPARE(progressSpy.last().at(1).toInt(), 3);
+
+        // WHEN
+        QEntity *subtree = new QEntity(root);
+        for (int i = 0; i < 4; ++i)
+            new QEntity(subtree);
+        engine.processFrame();
+
+        // THEN
+        // Subtrees are never split, even if larger than the budget
+        QCOMPARE(aspect->backendNodeCount(), 9);
+        QCOMPARE(engine.pendingNodeInsertionCount(), 0);
+    }
+
+    void shouldKeepQueueingWhileNodesArePending()
+    {
+        // GIVEN
+        QAspectEngine engine;
+        CountingAspect *aspect = new CountingAspect;
+        engine.registerAspect(aspect);
+        engine.setRunMode(QAspectEngine::Manual);
+        engine.setNodeInsertionBudget(1);
+
+        QEntity *root = new QEntity;
+        engine.setRootEntity(QEntityPtr(root));
+
+        // WHEN
+        new QEntity(root);
+        QEntity *pendingEntity = new QEntity(root);
+        QEntity *removedEntity = new QEntity(root);
+        engine.processFrame();
+
+        // THEN
+        QCOMPARE(aspect->backendNodeCount(), 2);
+        QCOMPARE(engine.pendingNodeInsertionCount(), 2);
+
+        // WHEN
+        // Destroyed pending nodes are never inserted
+        const QNodeId removedId = removedEntity->id();
+        delete removedEntity;
+
+        // THEN
+        QCOMPARE(engine.pendingNodeInsertionCount(), 1);
+
+        // WHEN
+        // Lifting the budget still creates the pending parent before its child
+        engine.setNodeInsertionBudget(0);
+        QEntity *child = new QEntity(pendingEntity);
+        engine.processFrame();
+
+        // THEN
+        QCOMPARE(aspect->backendNodeCount(), 4);
+        QCOMPARE(engine.pendingNodeInsertionCount(), 0);
+        const QNodeIdVector creationOrder = aspect->backendCreationOrder();
+        QVERIFY(!creationOrder.contains(removedId));
+        QVERIFY(creationOrder.indexOf(pendingEntity->id()) < creationOrder.indexOf(child->id()));
+    }
+
+    void shouldReplayComponentChangesOfPendingNodes()
+    {
+        // GIVEN
+        QAspectEngine engine;
+        CountingAspect *aspect = new CountingAspect;
+        engine.registerAspect(aspect);
+        engine.setRunMode(QAspectEngine::Manual);
+        engine.setNodeInsertionBudget(2);
+
+        QEntity *root = new QEntity;
+        engine.setRootEntity(QEntityPtr(root));
+
+        // WHEN
+        // The first subtree exhausts the budget, which leaves the
+        // transform pending while it is added to an existing entity
+        QEntity *subtree = new QEntity(root);
+        new QEntity(subtree);
+        new QEntity(subtree);
+        Qt3DCore::QTransform *transform = new Qt3DCore::QTransform;
+        root->addComponent(transform);
+        engine.processFrame();
+
+        // THEN
+        QCOMPARE(aspect->backendNodeCount(), 4);
+        QCOMPARE(aspect->transformBackendNodeCount(), 0);
+        QCOMPARE(engine.pendingNodeInsertionCount(), 1);
+        QVERIFY(aspect->backendComponents(root->id()).isEmpty());
+
+        // WHEN
+        engine.processFrame();
+
+        // THEN
+        QCOMPARE(aspect->transformBackendNodeCount(), 1);
+        QCOMPARE(engine.pendingNodeInsertionCount(), 0);
+        QCOMPARE(aspect->backendComponents(root->id()), QNodeIdVector({ transform->id() }));
+
+        // WHEN
+        // Removing the component of a pending node drops the queued change
+        QEntity *entity = new QEntity(subtree);
+        new QEntity(entity);
+        new QEntity(entity);
+        Qt3DCore::QTransform *otherTransform = new Qt3DCore::QTransform;
+        root->addComponent(otherTransform);
+        engine.processFrame();
+        delete otherTransform;
+        engine.processFrame();
+
+        // THEN
+        QCOMPARE(engine.pendingNodeInsertionCount(), 0);
+        QCOMPARE(aspect->backendComponents(root->id()), QNodeIdVector({ transform->id() }));
+    }
+
     void shouldRegisterDependentAspects()
     {
         // GIVEN
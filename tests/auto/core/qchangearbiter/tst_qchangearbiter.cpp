@@ -45,6 +45,7 @@ class tst_QChangeArbiter : public QObject
 
 private slots:
     void recordsDirtyNodes();
+    void removesAndTakesDirtyNodes();
 };
 
 
@@ -133,6 +134,51 @@ void tst_QChangeArbiter::recordsDirtyNodes()
     QCOMPARE(arbiter->dirtyNodes().size(), 2);
 }
 
+void tst_QChangeArbiter::removesAndTakesDirtyNodes()
+{
+    // GIVEN
+    QScopedPointer<TestArbiter> arbiter(new TestArbiter());
+    QScopedPointer<Qt3DCore::QScene> scene(new Qt3DCore::QScene());
+    arbiter->setScene(scene.data());
+    scene->setArbiter(arbiter.data());
+
+    QScopedPointer<PropertyTestNode> root(new PropertyTestNode());
+    auto *childA = new PropertyTestNode(root.data());
+    auto *childB = new PropertyTestNode(root.data());
+    arbiter->setArbiterOnNode(root.data());
+
+    // WHEN
+    root->setProp1(883);
+    childA->setProp1(883);
+    childB->setProp1(883);
+    childA->setProp2(1584);
+
+    // THEN
+    QCOMPARE(arbiter->dirtyNodes().size(), 3);
+
+    // WHEN
+    arbiter->removeDirtyFrontEndNode(childA);
+
+    // THEN
+    const QList<Qt3DCore::QNode *> expected = { root.data(), childB };
+    QCOMPARE(arbiter->dirtyNodes(), expected);
+
+    // WHEN
+    const QList<Qt3DCore::QNode *> taken = arbiter->takeDirtyFrontEndNodes();
+
+    // THEN
+    QCOMPARE(taken, expected);
+    QCOMPARE(arbiter->dirtyNodes().size(), 0);
+
+    // WHEN
+    childB->setProp1(884);
+    childA->setProp1(884);
+    childB->setProp2(1585);
+
+    // THEN
+    const QList<Qt3DCore::QNode *> expectedAfterTake = { childB, childA };
+    QCOMPARE(arbiter->dirtyNodes(), expectedAfterTake);
+}
 
 QTEST_MAIN(tst_QChangeArbiter)
 
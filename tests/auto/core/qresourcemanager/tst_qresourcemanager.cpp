@@ -51,6 +51,7 @@ private slots:
     void collectResources();
     void activeHandles();
     void checkCleanup();
+    void reserveResources();
 };
 
 class tst_ArrayResource
@@ -444,7 +445,54 @@ void tst_QResourceManager::checkCleanup()
 }
 
 
+void tst_QResourceManager::reserveResources()
+{
+    // GIVEN
+    Qt3DCore::QResourceManager<tst_ArrayResource, uint> manager;
+    const tHandle firstHandle = manager.getOrAcquireHandle(0U);
+
+    // WHEN
+    manager.reserve(1000);
+    QList<tHandle> handles;
+    for (uint i = 1; i <= 1000; ++i)
+        handles << manager.getOrAcquireHandle(i);
+
+    // THEN
+    QCOMPARE(manager.count(), 1001);
+    QCOMPARE(manager.activeHandles().size(), size_t(1001));
+    QCOMPARE(manager.lookupHandle(0U), firstHandle);
+    for (uint i = 1; i <= 1000; ++i) {
+        QVERIFY(!handles.at(i - 1).isNull());
+        QCOMPARE(manager.lookupHandle(i), handles.at(i - 1));
+        QVERIFY(manager.data(handles.at(i - 1)) != nullptr);
+    }
+
+    // WHEN
+    for (uint i = 1; i <= 1000; ++i)
+        manager.releaseResource(i);
+
+    // THEN
+    QCOMPARE(manager.count(), 1);
+    QVERIFY(manager.data(firstHandle) != nullptr);
+
+    // WHEN
+    // Reserving one resource at a time grows the storage geometrically
+    Qt3DCore::QResourceManager<tst_ArrayResource, uint> otherManager;
+    int reallocationCount = 0;
+    size_t capacity = otherManager.activeHandles().capacity();
+    for (uint i = 0; i < 1000; ++i) {
+        otherManager.reserve(1);
+        otherManager.getOrAcquireHandle(i);
+        if (otherManager.activeHandles().capacity() != capacity) {
+            capacity = otherManager.activeHandles().capacity();
+            ++reallocationCount;
+        }
+    }
 
+    // THEN
+    QCOMPARE(otherManager.count(), 1000);
+    QVERIFY(reallocationCount <= 11);
+}
 
 QTEST_APPLESS_MAIN(tst_QResourceManager)
 
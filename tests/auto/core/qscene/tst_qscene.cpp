@@ -50,6 +50,7 @@ private slots:
     void addEntityForComponent();
     void removeEntityForComponent();
     void hasEntityForComponent();
+    void lookupNodesWhileModified();
 };
 
 class tst_Node : public Qt3DCore::QNode
@@ -344,6 +345,56 @@ void tst_QScene::hasEntityForComponent()
         QVERIFY(scene->hasEntityForComponent(components.at(i)->id(), entities.at(i)->id()));
 }
 
+void tst_QScene::lookupNodesWhileModified()
+{
+    // GIVEN
+    Qt3DCore::QScene scene;
+    QList<Qt3DCore::QNode *> stableNodes;
+    QList<Qt3DCore::QNodeId> stableIds;
+    for (int i = 0; i < 100; i++) {
+        stableNodes.append(new tst_Node());
+        stableIds.append(stableNodes.last()->id());
+        scene.addObservable(stableNodes.last());
+    }
+
+    // WHEN
+    // Lookups from another thread while the main thread keeps adding and
+    // removing nodes, forcing the table to be rebuilt several times
+    QAtomicInt done(0);
+    QAtomicInt mismatches(0);
+    QScopedPointer<QThread> reader(QThread::create([&] {
+        while (!done.loadAcquire()) {
+            for (int i = 0; i < stableNodes.size(); i++) {
+                if (scene.lookupNode(stableIds.at(i)) != stableNodes.at(i))
+                    mismatches.ref();
+            }
+            if (scene.lookupNodes(stableIds) != stableNodes)
+                mismatches.ref();
+        }
+    }));
+    reader->start();
+
+    QList<Qt3DCore::QNode *> transientNodes;
+    for (int i = 0; i < 5000; i++) {
+        transientNodes.append(new tst_Node());
+        scene.addObservable(transientNodes.last());
+        if (i % 2 == 0)
+            scene.removeObservable(transientNodes.last());
+    }
+    done.storeRelease(1);
+    reader->wait();
+
+    // THEN
+    QCOMPARE(mismatches.loadRelaxed(), 0);
+    for (int i = 0; i < transientNodes.size(); i++) {
+        Qt3DCore::QNode *n = transientNodes.at(i);
+        QCOMPARE(scene.lookupNode(n->id()), i % 2 == 0 ? nullptr : n);
+    }
+
+    qDeleteAll(transientNodes);
+    qDeleteAll(stableNodes);
+}
+
 QTEST_MAIN(tst_QScene)
 
 #include "tst_qscene.moc"
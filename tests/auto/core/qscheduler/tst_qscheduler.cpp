@@ -88,11 +88,17 @@ using JobPtr = QSharedPointer<Job>;
 
 class AspectPrivate : public QAbstractAspectPrivate
 {
+    bool m_jobsRunningCalled = false;
     bool m_jobsDoneCalled = false;
     bool m_frameDoneCalled = false;
 
 public:
 
+    bool jobsRunningCalled() const
+    {
+        return m_jobsRunningCalled;
+    }
+
     bool jobsDoneCalled() const
     {
         return m_jobsDoneCalled;
@@ -104,6 +110,13 @@ public:
     }
 
     // QAspectJobProviderInterface interface
+    void jobsRunning() override
+    {
+        // Called before waiting for the jobs
+        Q_ASSERT(!m_jobsDoneCalled);
+        m_jobsRunningCalled = true;
+    }
+
     void jobsDone() override
     {
         m_jobsDoneCalled = true;
@@ -176,6 +189,7 @@ private Q_SLOTS:
         // THEN
         const JobPtr first = aspect.firstJob();
         const JobPtr second = aspect.secondJob();
+        QVERIFY(!aspectPriv->jobsRunningCalled());
         QVERIFY(!aspectPriv->jobsDoneCalled());
         QVERIFY(!aspectPriv->frameDoneCalled());
         QVERIFY(!first->wasExecuted());
@@ -192,6 +206,7 @@ private Q_SLOTS:
         QVERIFY(second->wasExecuted());
         QVERIFY(first->postFrameCalled());
         QVERIFY(second->postFrameCalled());
+        QVERIFY(aspectPriv->jobsRunningCalled());
         QVERIFY(aspectPriv->jobsDoneCalled());
         QVERIFY(!aspectPriv->frameDoneCalled());
 
@@ -30,6 +30,7 @@
 #include <Qt3DCore/private/qservicelocator_p.h>
 #include <Qt3DCore/private/qopenglinformationservice_p.h>
 #include <Qt3DCore/private/qsysteminformationservice_p.h>
+#include <Qt3DCore/private/qsysteminformationservice_p_p.h>
 
 #include <QScopedPointer>
 
@@ -70,6 +71,7 @@ private slots:
     void defaultServices();
     void addRemoveDefaultService();
     void addRemoveUserService();
+    void chromeTraceRingBuffer();
 };
 
 void tst_QServiceLocator::construction()
@@ -145,6 +147,66 @@ void tst_QServiceLocator::addRemoveUserService()
     QVERIFY(dummy->data() == 10);
 }
 
+void tst_QServiceLocator::chromeTraceRingBuffer()
+{
+    // GIVEN
+    QTemporaryDir traceDir;
+    QVERIFY(traceDir.isValid());
+    const QString previousDir = QDir::currentPath();
+    QDir::setCurrent(traceDir.path());
+
+    QSystemInformationService service(nullptr);
+    QSystemInformationServicePrivate *dservice = QSystemInformationServicePrivate::get(&service);
+    dservice->m_traceFormat = QSystemInformationServicePrivate::ChromeTrace;
+    dservice->m_maxFrameTraces = 2;
+    service.setTraceEnabled(true);
+
+    // WHEN
+    for (quint32 i = 0; i < 3; ++i) {
+        {
+            QTaskLogger logger(&service, JobId(1, i), QTaskLogger::AspectJob);
+        }
+        dservice->addJobDependency(JobId(1, i), JobId(2, i));
+        dservice->addCounterEntry("Entities", 10 + i);
+        service.writePreviousFrameTraces();
+    }
+
+    // THEN
+    QCOMPARE(dservice->m_frameTraces.size(), 2);
+
+    // WHEN
+    const QString fileName = dservice->writeChromeTrace();
+
+    // THEN
+    QVERIFY(!fileName.isEmpty());
+    QVERIFY(dservice->m_frameTraces.isEmpty());
+
+    QFile file(fileName);
+    QVERIFY(file.open(QFile::ReadOnly));
+    const QJsonArray events = QJsonDocument::fromJson(file.readAll()).object()
+            .value(QLatin1String("traceEvents")).toArray();
+    QStringList frameNames;
+    int jobSpanCount = 0;
+    int counterCount = 0;
+    for (const QJsonValue &value : events) {
+        const QJsonObject event = value.toObject();
+        const QString phase = event.value(QLatin1String("ph")).toString();
+        if (phase == QLatin1String("X") && event.value(QLatin1String("cat")).toString() == QLatin1String("frame"))
+            frameNames.push_back(event.value(QLatin1String("name")).toString());
+        else if (phase == QLatin1String("X"))
+            ++jobSpanCount;
+        else if (phase == QLatin1String("C"))
+            ++counterCount;
+    }
+    // Only the last two frames were kept, oldest first
+    QCOMPARE(frameNames, QStringList({ QStringLiteral("Frame 1"), QStringLiteral("Frame 2") }));
+    QCOMPARE(jobSpanCount, 2);
+    QCOMPARE(counterCount, 2);
+
+    file.close();
+    QDir::setCurrent(previousDir);
+}
+
 QTEST_MAIN(tst_QServiceLocator)
 
 #include "tst_qservicelocator.moc"
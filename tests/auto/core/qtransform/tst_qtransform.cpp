@@ -61,6 +61,7 @@ private Q_SLOTS:
         QCOMPARE(transform.rotationY(), 0.0f);
         QCOMPARE(transform.rotationZ(), 0.0f);
         QCOMPARE(transform.translation(), QVector3D(0.0f, 0.0f, 0.0f));
+        QCOMPARE(transform.worldMatrixUpdatesEnabled(), true);
     }
 
     void checkPropertyUpdates()
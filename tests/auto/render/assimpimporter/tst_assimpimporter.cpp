@@ -0,0 +1,362 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QThreadPool>
+#include <Qt3DCore/QAttribute>
+#include <Qt3DCore/QBuffer>
+#include <Qt3DCore/QEntity>
+#include <Qt3DCore/QGeometry>
+#include <Qt3DRender/QGeometryRenderer>
+#include <Qt3DExtras/QPhongMaterial>
+
+#include <private/qsceneimporter_p.h>
+#include <private/qsceneimportfactory_p.h>
+
+namespace {
+
+// Number of objects of the scene, each converted to its own mesh
+const int objectCount = 16;
+
+// Writes objectCount quads of two triangles sharing the texture
+// coordinates, the normal and a material defined in scene.mtl
+void writeScene(const QDir &dir, const QByteArray &diffuse)
+{
+    QByteArray obj("mtllib scene.mtl\n"
+                   "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+                   "vn 0 0 1\n");
+    for (int i = 0; i < objectCount; ++i) {
+        const QByteArray x = QByteArray::number(i * 2);
+        const QByteArray x1 = QByteArray::number(i * 2 + 1);
+        obj += "o Quad" + QByteArray::number(i) + "\n"
+                + "v " + x + " 0 0\nv " + x1 + " 0 0\nv " + x1 + " 1 0\nv " + x + " 1 0\n"
+                + "usemtl Material\n";
+        const auto corner = [i] (int c) {
+            const QByteArray index = QByteArray::number(i * 4 + c + 1);
+            return index + '/' + QByteArray::number(c + 1) + "/1";
+        };
+        obj += "f " + corner(0) + ' ' + corner(1) + ' ' + corner(2) + '\n';
+        obj += "f " + corner(0) + ' ' + corner(2) + ' ' + corner(3) + '\n';
+    }
+
+    QFile objFile(dir.filePath(QStringLiteral("scene.obj")));
+    QVERIFY(objFile.open(QIODevice::WriteOnly));
+    objFile.write(obj);
+    QFile mtlFile(dir.filePath(QStringLiteral("scene.mtl")));
+    QVERIFY(mtlFile.open(QIODevice::WriteOnly));
+    mtlFile.write("newmtl Material\nKd " + diffuse + "\n");
+}
+
+// The layout of the meshes the importer created before converting them in
+// parallel: interleaved positions, normals and flipped texture coordinates,
+// one vertex per face corner and 16 bit indices
+QByteArray expectedVertexData(int object)
+{
+    const float corners[4][4] = { { 0.0f, 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 1.0f, 0.0f },
+                                  { 1.0f, 1.0f, 1.0f, 1.0f }, { 0.0f, 1.0f, 0.0f, 1.0f } };
+    QList<float> vertices;
+    for (int c : { 0, 1, 2, 0, 2, 3 }) {
+        vertices << float(object * 2) + corners[c][0] << corners[c][1] << 0.0f
+                 << 0.0f << 0.0f << 1.0f
+                 << corners[c][2] << 1.0f - corners[c][3];
+    }
+    return QByteArray(reinterpret_cast<const char *>(vertices.constData()), vertices.size() * sizeof(float));
+}
+
+QByteArray expectedIndexData()
+{
+    const QList<quint16> indices = { 0, 1, 2, 3, 4, 5 };
+    return QByteArray(reinterpret_cast<const char *>(indices.constData()), indices.size() * sizeof(quint16));
+}
+
+Qt3DCore::QAttribute *findAttribute(Qt3DCore::QGeometry *geometry, const QString &name)
+{
+    const auto attributes = geometry->attributes();
+    for (Qt3DCore::QAttribute *attribute : attributes) {
+        if (attribute->name() == name)
+            return attribute;
+    }
+    return nullptr;
+}
+
+QList<Qt3DRender::QGeometryRenderer *> geometryRenderers(Qt3DCore::QEntity *root)
+{
+    QList<Qt3DCore::QEntity *> entities = root->findChildren<Qt3DCore::QEntity *>();
+    entities.prepend(root);
+    QList<Qt3DRender::QGeometryRenderer *> renderers;
+    for (Qt3DCore::QEntity *entity : qAsConst(entities))
+        renderers += entity->componentsOfType<Qt3DRender::QGeometryRenderer>();
+    return renderers;
+}
+
+QColor diffuseColor(Qt3DCore::QEntity *root)
+{
+    QList<Qt3DCore::QEntity *> entities = root->findChildren<Qt3DCore::QEntity *>();
+    entities.prepend(root);
+    for (Qt3DCore::QEntity *entity : qAsConst(entities)) {
+        const auto materials = entity->componentsOfType<Qt3DExtras::QPhongMaterial>();
+        if (!materials.empty())
+            return materials.first()->diffuse();
+    }
+    return QColor();
+}
+
+} // anonymous
+
+class tst_AssimpImporter : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        QScopedPointer<Qt3DRender::QSceneImporter> importer(
+                    Qt3DRender::QSceneImportFactory::create(QStringLiteral("assimp"), QStringList()));
+        if (!importer)
+            QSKIP("The Assimp scene parser isn't available");
+    }
+
+    void init()
+    {
+        m_dir.reset(new QTemporaryDir);
+        QVERIFY(m_dir->isValid());
+        writeScene(QDir(m_dir->path()), "1 0 0");
+        qunsetenv("QT3D_ASSIMP_CACHE_DIR");
+    }
+
+    void cleanup()
+    {
+        qunsetenv("QT3D_ASSIMP_CACHE_DIR");
+        QLoggingCategory::setFilterRules(QString());
+        QThreadPool::globalInstance()->setMaxThreadCount(QThread::idealThreadCount());
+        m_dir.reset();
+    }
+
+    void checkConversionMatchesSerialLayout_data()
+    {
+        QTest::addColumn<int>("threadCount");
+
+        QTest::newRow("serial") << 1;
+        QTest::newRow("parallel") << qMax(QThread::idealThreadCount(), 4);
+    }
+
+    void checkConversionMatchesSerialLayout()
+    {
+        QFETCH(int, threadCount);
+
+        // GIVEN
+        QThreadPool::globalInstance()->setMaxThreadCount(threadCount);
+
+        // WHEN
+        QScopedPointer<Qt3DCore::QEntity> scene(importScene());
+
+        // THEN
+        QVERIFY(scene);
+        checkScene(scene.data(), QColor::fromRgbF(1.0f, 0.0f, 0.0f));
+    }
+
+    void checkCacheRoundTrip()
+    {
+        // GIVEN
+        const QDir cacheDir(m_dir->filePath(QStringLiteral("cache")));
+        qputenv("QT3D_ASSIMP_CACHE_DIR", QFile::encodeName(cacheDir.path()));
+        QLoggingCategory::setFilterRules(QStringLiteral("Qt3D.AssimpImporter.debug=true"));
+
+        // WHEN
+        QScopedPointer<Qt3DCore::QEntity> imported(importScene());
+
+        // THEN -> the entry got populated
+        QVERIFY(imported);
+        QCOMPARE(cacheDir.entryList(QDir::Files).size(), 1);
+
+        // WHEN
+        QTest::ignoreMessage(QtDebugMsg, QRegularExpression(QStringLiteral("^Read scene from the cache")));
+        QScopedPointer<Qt3DCore::QEntity> cached(importScene());
+
+        // THEN -> the same scene gets read back
+        QVERIFY(cached);
+        checkScene(cached.data(), QColor::fromRgbF(1.0f, 0.0f, 0.0f));
+    }
+
+    void checkCorruptEntryIsRejected_data()
+    {
+        QTest::addColumn<int>("keptSize");
+
+        QTest::newRow("header only") << 8;
+        QTest::newRow("truncated") << -64;
+    }
+
+    void checkCorruptEntryIsRejected()
+    {
+        QFETCH(int, keptSize);
+
+        // GIVEN
+        const QDir cacheDir(m_dir->filePath(QStringLiteral("cache")));
+        qputenv("QT3D_ASSIMP_CACHE_DIR", QFile::encodeName(cacheDir.path()));
+        QScopedPointer<Qt3DCore::QEntity> imported(importScene());
+        QVERIFY(imported);
+        const QStringList entries = cacheDir.entryList(QDir::Files);
+        QCOMPARE(entries.size(), 1);
+        QFile entry(cacheDir.filePath(entries.first()));
+        QVERIFY(entry.resize(keptSize > 0 ? keptSize : entry.size() + keptSize));
+
+        // WHEN
+        QTest::ignoreMessage(QtWarningMsg, QRegularExpression(QStringLiteral("Ignoring invalid cache entry")));
+        QScopedPointer<Qt3DCore::QEntity> reimported(importScene());
+
+        // THEN -> the scene is imported again and the entry replaced
+        QVERIFY(reimported);
+        checkScene(reimported.data(), QColor::fromRgbF(1.0f, 0.0f, 0.0f));
+
+        // WHEN
+        QLoggingCategory::setFilterRules(QStringLiteral("Qt3D.AssimpImporter.debug=true"));
+        QTest::ignoreMessage(QtDebugMsg, QRegularExpression(QStringLiteral("^Read scene from the cache")));
+        QScopedPointer<Qt3DCore::QEntity> cached(importScene());
+
+        // THEN
+        QVERIFY(cached);
+        checkScene(cached.data(), QColor::fromRgbF(1.0f, 0.0f, 0.0f));
+    }
+
+    void checkChangedDependencyIsRejected()
+    {
+        // GIVEN
+        const QDir cacheDir(m_dir->filePath(QStringLiteral("cache")));
+        qputenv("QT3D_ASSIMP_CACHE_DIR", QFile::encodeName(cacheDir.path()));
+        QScopedPointer<Qt3DCore::QEntity> imported(importScene());
+        QVERIFY(imported);
+
+        // WHEN -> only the material file changes, the key stays the same
+        writeScene(QDir(m_dir->path()), "0 0.5 0");
+        QScopedPointer<Qt3DCore::QEntity> reimported(importScene());
+
+        // THEN
+        QVERIFY(reimported);
+        checkScene(reimported.data(), QColor::fromRgbF(0.0f, 0.5f, 0.0f));
+        QCOMPARE(cacheDir.entryList(QDir::Files).size(), 1);
+    }
+
+    void checkSameContentInOtherDirectoryIsNotShared()
+    {
+        // GIVEN
+        const QDir cacheDir(m_dir->filePath(QStringLiteral("cache")));
+        qputenv("QT3D_ASSIMP_CACHE_DIR", QFile::encodeName(cacheDir.path()));
+        QScopedPointer<Qt3DCore::QEntity> imported(importScene());
+        QVERIFY(imported);
+
+        // WHEN -> an identical scene next to another material file
+        QDir otherDir(m_dir->path());
+        QVERIFY(otherDir.mkdir(QStringLiteral("other")));
+        QVERIFY(otherDir.cd(QStringLiteral("other")));
+        writeScene(otherDir, "0 0 1");
+        QScopedPointer<Qt3DCore::QEntity> otherImported(importScene(otherDir));
+
+        // THEN -> it gets its own entry and its own material
+        QVERIFY(otherImported);
+        checkScene(otherImported.data(), QColor::fromRgbF(0.0f, 0.0f, 1.0f));
+        QCOMPARE(cacheDir.entryList(QDir::Files).size(), 2);
+    }
+
+private:
+    Qt3DCore::QEntity *importScene()
+    {
+        return importScene(QDir(m_dir->path()));
+    }
+
+    Qt3DCore::QEntity *importScene(const QDir &dir)
+    {
+        QScopedPointer<Qt3DRender::QSceneImporter> importer(
+                    Qt3DRender::QSceneImportFactory::create(QStringLiteral("assimp"), QStringList()));
+        if (!importer)
+            return nullptr;
+        importer->setSource(QUrl::fromLocalFile(dir.filePath(QStringLiteral("scene.obj"))));
+        return importer->scene();
+    }
+
+    void checkScene(Qt3DCore::QEntity *scene, const QColor &diffuse)
+    {
+        QCOMPARE(diffuseColor(scene), diffuse);
+
+        const QList<Qt3DRender::QGeometryRenderer *> renderers = geometryRenderers(scene);
+        QCOMPARE(renderers.size(), objectCount);
+
+        QList<bool> found(objectCount, false);
+        for (Qt3DRender::QGeometryRenderer *renderer : renderers) {
+            Qt3DCore::QGeometry *geometry = renderer->view()->geometry();
+            QVERIFY(geometry != nullptr);
+
+            Qt3DCore::QAttribute *position = findAttribute(geometry, Qt3DCore::QAttribute::defaultPositionAttributeName());
+            Qt3DCore::QAttribute *normal = findAttribute(geometry, Qt3DCore::QAttribute::defaultNormalAttributeName());
+            Qt3DCore::QAttribute *texCoord = findAttribute(geometry, Qt3DCore::QAttribute::defaultTextureCoordinateAttributeName());
+            Qt3DCore::QAttribute *index = nullptr;
+            const auto attributes = geometry->attributes();
+            for (Qt3DCore::QAttribute *attribute : attributes) {
+                if (attribute->attributeType() == Qt3DCore::QAttribute::IndexAttribute)
+                    index = attribute;
+            }
+            QVERIFY(position && normal && texCoord && index);
+            QCOMPARE(attributes.size(), 4);
+
+            const uint stride = 8 * sizeof(float);
+            QCOMPARE(position->byteOffset(), 0U);
+            QCOMPARE(normal->byteOffset(), uint(3 * sizeof(float)));
+            QCOMPARE(texCoord->byteOffset(), uint(6 * sizeof(float)));
+            for (Qt3DCore::QAttribute *attribute : { position, normal, texCoord }) {
+                QCOMPARE(attribute->vertexBaseType(), Qt3DCore::QAttribute::Float);
+                QCOMPARE(attribute->byteStride(), stride);
+                QCOMPARE(attribute->count(), 6U);
+            }
+
+            // Meshes are identified by their first vertex
+            const QByteArray vertexData = position->buffer()->data();
+            QCOMPARE(vertexData.size(), qsizetype(6 * stride));
+            const int object = int(reinterpret_cast<const float *>(vertexData.constData())[0]) / 2;
+            QVERIFY(object >= 0 && object < objectCount);
+            QVERIFY(!found.at(object));
+            found[object] = true;
+            QCOMPARE(vertexData, expectedVertexData(object));
+
+            QCOMPARE(index->vertexBaseType(), Qt3DCore::QAttribute::UnsignedShort);
+            QCOMPARE(index->count(), 6U);
+            QCOMPARE(index->buffer()->data(), expectedIndexData());
+        }
+    }
+
+    QScopedPointer<QTemporaryDir> m_dir;
+};
+
+QTEST_MAIN(tst_AssimpImporter)
+
+#include "tst_assimpimporter.moc"
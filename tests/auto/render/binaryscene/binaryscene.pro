@@ -0,0 +1,9 @@
+TEMPLATE = app
+
+TARGET = tst_binaryscene
+
+QT += 3dcore 3dcore-private 3drender 3drender-private testlib 3dextras
+
+CONFIG += testcase
+
+SOURCES += tst_binaryscene.cpp
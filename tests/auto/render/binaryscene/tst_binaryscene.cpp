@@ -0,0 +1,455 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <QtCore/QBuffer>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QTemporaryDir>
+#include <Qt3DCore/QAttribute>
+#include <Qt3DCore/QBuffer>
+#include <Qt3DCore/QEntity>
+#include <Qt3DCore/QGeometry>
+#include <Qt3DCore/QTransform>
+#include <Qt3DRender/QCamera>
+#include <Qt3DRender/QGeometryRenderer>
+#include <Qt3DRender/QMesh>
+#include <Qt3DRender/QPointLight>
+#include <Qt3DRender/QTexture>
+#include <Qt3DRender/QTextureImage>
+#include <Qt3DExtras/QDiffuseMapMaterial>
+#include <Qt3DExtras/QPhongMaterial>
+
+#include <private/binaryscene_p.h>
+#include <private/qsceneexporter_p.h>
+#include <private/qsceneexportfactory_p.h>
+#include <private/qsceneimporter_p.h>
+#include <private/qsceneimportfactory_p.h>
+
+using namespace Qt3DRender;
+
+namespace {
+
+// Two vertices with interleaved positions and normals, so that the normals
+// of the last one end with the buffer
+const QList<float> vertices = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+                                1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+const QList<quint16> indices = { 0, 1 };
+
+template<typename T>
+QByteArray toByteArray(const QList<T> &values)
+{
+    return QByteArray(reinterpret_cast<const char *>(values.constData()), values.size() * sizeof(T));
+}
+
+Qt3DCore::QAttribute *createAttribute(Qt3DCore::QBuffer *buffer, const QString &name, uint vertexSize,
+                                      uint count, uint byteOffset, uint byteStride)
+{
+    return new Qt3DCore::QAttribute(buffer, name, Qt3DCore::QAttribute::Float,
+                                    vertexSize, count, byteOffset, byteStride);
+}
+
+Qt3DCore::QEntity *createScene(const QDir &dir)
+{
+    Qt3DCore::QEntity *root = new Qt3DCore::QEntity();
+    root->setObjectName(QStringLiteral("Root"));
+
+    Qt3DCore::QEntity *lines = new Qt3DCore::QEntity(root);
+    lines->setObjectName(QStringLiteral("Lines"));
+    Qt3DCore::QTransform *transform = new Qt3DCore::QTransform();
+    transform->setTranslation(QVector3D(1.0f, 2.0f, 3.0f));
+    transform->setRotationY(30.0f);
+    lines->addComponent(transform);
+    Qt3DExtras::QPhongMaterial *phong = new Qt3DExtras::QPhongMaterial();
+    phong->setDiffuse(Qt::red);
+    phong->setShininess(20.0f);
+    lines->addComponent(phong);
+
+    Qt3DRender::QGeometryRenderer *renderer = new Qt3DRender::QGeometryRenderer();
+    renderer->setPrimitiveType(Qt3DRender::QGeometryRenderer::Lines);
+    Qt3DCore::QGeometry *geometry = new Qt3DCore::QGeometry(renderer);
+    Qt3DCore::QBuffer *vertexBuffer = new Qt3DCore::QBuffer(geometry);
+    vertexBuffer->setData(toByteArray(vertices));
+    Qt3DCore::QBuffer *indexBuffer = new Qt3DCore::QBuffer(geometry);
+    indexBuffer->setData(toByteArray(indices));
+    geometry->addAttribute(createAttribute(vertexBuffer, Qt3DCore::QAttribute::defaultPositionAttributeName(),
+                                           3, 2, 0, 6 * sizeof(float)));
+    geometry->addAttribute(createAttribute(vertexBuffer, Qt3DCore::QAttribute::defaultNormalAttributeName(),
+                                           3, 2, 3 * sizeof(float), 6 * sizeof(float)));
+    Qt3DCore::QAttribute *indexAttribute = new Qt3DCore::QAttribute(indexBuffer, Qt3DCore::QAttribute::UnsignedShort,
+                                                                    1, indices.size());
+    indexAttribute->setAttributeType(Qt3DCore::QAttribute::IndexAttribute);
+    geometry->addAttribute(indexAttribute);
+    renderer->setGeometry(geometry);
+    lines->addComponent(renderer);
+
+    Qt3DCore::QEntity *textured = new Qt3DCore::QEntity(root);
+    textured->setObjectName(QStringLiteral("Textured"));
+    Qt3DRender::QMesh *mesh = new Qt3DRender::QMesh();
+    mesh->setSource(QUrl::fromLocalFile(dir.filePath(QStringLiteral("mesh.obj"))));
+    textured->addComponent(mesh);
+    Qt3DExtras::QDiffuseMapMaterial *diffuseMap = new Qt3DExtras::QDiffuseMapMaterial();
+    Qt3DRender::QTexture2D *texture = new Qt3DRender::QTexture2D();
+    Qt3DRender::QTextureImage *image = new Qt3DRender::QTextureImage();
+    image->setSource(QUrl::fromLocalFile(dir.filePath(QStringLiteral("texture.png"))));
+    texture->addTextureImage(image);
+    diffuseMap->setDiffuse(texture);
+    textured->addComponent(diffuseMap);
+
+    Qt3DRender::QCamera *camera = new Qt3DRender::QCamera(root);
+    camera->setObjectName(QStringLiteral("Camera"));
+    camera->setPosition(QVector3D(0.0f, 0.0f, 10.0f));
+    camera->setViewCenter(QVector3D(0.0f, 1.0f, 0.0f));
+
+    Qt3DCore::QEntity *lit = new Qt3DCore::QEntity(root);
+    lit->setObjectName(QStringLiteral("Light"));
+    Qt3DRender::QPointLight *light = new Qt3DRender::QPointLight();
+    light->setColor(Qt::blue);
+    light->setIntensity(0.5f);
+    lit->addComponent(light);
+
+    return root;
+}
+
+template<typename T>
+T *findComponent(Qt3DCore::QEntity *entity)
+{
+    return entity ? entity->componentsOfType<T>().value(0) : nullptr;
+}
+
+Qt3DCore::QAttribute *findAttribute(Qt3DCore::QGeometry *geometry, const QString &name,
+                                    Qt3DCore::QAttribute::AttributeType type)
+{
+    const auto attributes = geometry->attributes();
+    for (Qt3DCore::QAttribute *attribute : attributes) {
+        if (attribute->attributeType() == type
+                && (type == Qt3DCore::QAttribute::IndexAttribute || attribute->name() == name))
+            return attribute;
+    }
+    return nullptr;
+}
+
+// A scene with a single entity holding a diffuse map material, whose
+// textures are set through textureProperties
+QByteArray materialScene(const QList<QByteArray> &textureProperties)
+{
+    BinaryScene::SceneDescription description;
+
+    BinaryScene::EntityRecord entity;
+    entity.className = Qt3DCore::QEntity::staticMetaObject.className();
+    entity.name = QStringLiteral("Root");
+    entity.components.append(0);
+    description.entities.append(entity);
+
+    BinaryScene::ComponentRecord material;
+    material.type = BinaryScene::ComponentRecord::Material;
+    material.className = Qt3DExtras::QDiffuseMapMaterial::staticMetaObject.className();
+    for (const QByteArray &property : textureProperties)
+        material.textures.append({ property, 0 });
+    description.components.append(material);
+
+    BinaryScene::TextureRecord texture;
+    texture.className = Qt3DRender::QTexture2D::staticMetaObject.className();
+    texture.name = QStringLiteral("Texture");
+    description.textures.append(texture);
+
+    QByteArray data;
+    ::QBuffer device(&data);
+    device.open(QIODevice::WriteOnly);
+    if (!BinaryScene::write(&device, description, {}))
+        return QByteArray();
+    return data;
+}
+
+} // anonymous
+
+class tst_BinaryScene : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void init()
+    {
+        m_dir.reset(new QTemporaryDir);
+        QVERIFY(m_dir->isValid());
+    }
+
+    void cleanup()
+    {
+        m_dir.reset();
+    }
+
+    void exportAndImport()
+    {
+        // GIVEN
+        QScopedPointer<Qt3DCore::QEntity> scene(createScene(QDir(m_dir->path())));
+
+        // WHEN
+        QScopedPointer<Qt3DCore::QEntity> imported(importScene(exportScene(scene.data())));
+
+        // THEN
+        QVERIFY(imported);
+        QCOMPARE(imported->objectName(), QStringLiteral("Root"));
+
+        Qt3DCore::QEntity *lines = imported->findChild<Qt3DCore::QEntity *>(QStringLiteral("Lines"));
+        QVERIFY(lines != nullptr);
+        Qt3DCore::QTransform *transform = findComponent<Qt3DCore::QTransform>(lines);
+        QVERIFY(transform != nullptr);
+        QCOMPARE(transform->matrix(), findComponent<Qt3DCore::QTransform>(
+                     scene->findChild<Qt3DCore::QEntity *>(QStringLiteral("Lines")))->matrix());
+        Qt3DExtras::QPhongMaterial *phong = findComponent<Qt3DExtras::QPhongMaterial>(lines);
+        QVERIFY(phong != nullptr);
+        QCOMPARE(phong->diffuse(), QColor(Qt::red));
+        QCOMPARE(phong->shininess(), 20.0f);
+
+        Qt3DRender::QGeometryRenderer *renderer = findComponent<Qt3DRender::QGeometryRenderer>(lines);
+        QVERIFY(renderer != nullptr);
+        QCOMPARE(renderer->primitiveType(), Qt3DRender::QGeometryRenderer::Lines);
+        Qt3DCore::QGeometry *geometry = renderer->geometry();
+        QVERIFY(geometry != nullptr);
+        QCOMPARE(geometry->attributes().size(), 3);
+        Qt3DCore::QAttribute *normal = findAttribute(geometry, Qt3DCore::QAttribute::defaultNormalAttributeName(),
+                                                     Qt3DCore::QAttribute::VertexAttribute);
+        QVERIFY(normal != nullptr);
+        QCOMPARE(normal->vertexBaseType(), Qt3DCore::QAttribute::Float);
+        QCOMPARE(normal->vertexSize(), 3U);
+        QCOMPARE(normal->count(), 2U);
+        QCOMPARE(normal->byteOffset(), uint(3 * sizeof(float)));
+        QCOMPARE(normal->byteStride(), uint(6 * sizeof(float)));
+        QCOMPARE(normal->buffer()->data(), toByteArray(vertices));
+        Qt3DCore::QAttribute *position = findAttribute(geometry, Qt3DCore::QAttribute::defaultPositionAttributeName(),
+                                                       Qt3DCore::QAttribute::VertexAttribute);
+        QVERIFY(position != nullptr);
+        QCOMPARE(position->buffer(), normal->buffer());
+        Qt3DCore::QAttribute *index = findAttribute(geometry, QString(), Qt3DCore::QAttribute::IndexAttribute);
+        QVERIFY(index != nullptr);
+        QCOMPARE(index->vertexBaseType(), Qt3DCore::QAttribute::UnsignedShort);
+        QCOMPARE(index->count(), uint(indices.size()));
+        QCOMPARE(index->buffer()->data(), toByteArray(indices));
+
+        Qt3DCore::QEntity *textured = imported->findChild<Qt3DCore::QEntity *>(QStringLiteral("Textured"));
+        QVERIFY(textured != nullptr);
+        Qt3DRender::QMesh *mesh = findComponent<Qt3DRender::QMesh>(textured);
+        QVERIFY(mesh != nullptr);
+        QCOMPARE(mesh->source(), QUrl::fromLocalFile(m_dir->filePath(QStringLiteral("mesh.obj"))));
+        Qt3DExtras::QDiffuseMapMaterial *diffuseMap = findComponent<Qt3DExtras::QDiffuseMapMaterial>(textured);
+        QVERIFY(diffuseMap != nullptr);
+        Qt3DRender::QAbstractTexture *texture = diffuseMap->diffuse();
+        QVERIFY(qobject_cast<Qt3DRender::QTexture2D *>(texture) != nullptr);
+        QCOMPARE(texture->textureImages().size(), 1);
+        Qt3DRender::QTextureImage *image = qobject_cast<Qt3DRender::QTextureImage *>(texture->textureImages().first());
+        QVERIFY(image != nullptr);
+        QCOMPARE(image->source(), QUrl::fromLocalFile(m_dir->filePath(QStringLiteral("texture.png"))));
+
+        Qt3DRender::QCamera *camera = imported->findChild<Qt3DRender::QCamera *>(QStringLiteral("Camera"));
+        QVERIFY(camera != nullptr);
+        QCOMPARE(camera->position(), QVector3D(0.0f, 0.0f, 10.0f));
+        QCOMPARE(camera->viewCenter(), QVector3D(0.0f, 1.0f, 0.0f));
+
+        Qt3DRender::QPointLight *light = findComponent<Qt3DRender::QPointLight>(
+                    imported->findChild<Qt3DCore::QEntity *>(QStringLiteral("Light")));
+        QVERIFY(light != nullptr);
+        QCOMPARE(light->color(), QColor(Qt::blue));
+        QCOMPARE(light->intensity(), 0.5f);
+    }
+
+    void importTruncatedFile_data()
+    {
+        // Negative sizes are relative to the end of the file
+        QTest::addColumn<int>("size");
+
+        QTest::newRow("empty") << 0;
+        QTest::newRow("partial header") << 20;
+        QTest::newRow("header only") << 40;
+        QTest::newRow("partial description") << 64;
+        QTest::newRow("partial data") << -1;
+    }
+
+    void importTruncatedFile()
+    {
+        QFETCH(int, size);
+
+        // GIVEN
+        QScopedPointer<Qt3DCore::QEntity> scene(createScene(QDir(m_dir->path())));
+        QByteArray data = exportScene(scene.data());
+        QVERIFY(!data.isEmpty());
+        data.truncate(size >= 0 ? size : data.size() + size);
+
+        // WHEN
+        QTest::ignoreMessage(QtWarningMsg, QRegularExpression(QStringLiteral("^Not a valid binary scene")));
+        QScopedPointer<Qt3DCore::QEntity> imported(importScene(data));
+
+        // THEN
+        QVERIFY(!imported);
+    }
+
+    void importCorruptFile_data()
+    {
+        QTest::addColumn<int>("offset");
+        QTest::addColumn<QByteArray>("bytes");
+
+        QTest::newRow("magic") << 0 << QByteArray("Q3DX");
+        QTest::newRow("version") << 4 << QByteArray(4, '\xff');
+        QTest::newRow("description offset") << 8 << QByteArray(8, '\xff');
+        QTest::newRow("data size") << 32 << QByteArray(8, '\x7f');
+        // Number of entities, right after the header
+        QTest::newRow("list size") << 40 << QByteArray(4, '\x7f');
+    }
+
+    void importCorruptFile()
+    {
+        QFETCH(int, offset);
+        QFETCH(QByteArray, bytes);
+
+        // GIVEN
+        QScopedPointer<Qt3DCore::QEntity> scene(createScene(QDir(m_dir->path())));
+        QByteArray data = exportScene(scene.data());
+        QVERIFY(data.size() > offset + bytes.size());
+        data.replace(offset, bytes.size(), bytes);
+
+        // WHEN
+        QTest::ignoreMessage(QtWarningMsg, QRegularExpression(QStringLiteral("^Not a valid binary scene")));
+        QScopedPointer<Qt3DCore::QEntity> imported(importScene(data));
+
+        // THEN
+        QVERIFY(!imported);
+    }
+
+    void checkAttributesFitInTheirBuffer_data()
+    {
+        QTest::addColumn<qint32>("vertexBaseType");
+        QTest::addColumn<quint32>("count");
+        QTest::addColumn<quint32>("byteOffset");
+        QTest::addColumn<quint32>("byteStride");
+        QTest::addColumn<bool>("valid");
+
+        const qint32 floatType = Qt3DCore::QAttribute::Float;
+        QTest::newRow("last element ends the buffer") << floatType << 2U << 12U << 24U << true;
+        QTest::newRow("tightly packed") << floatType << 4U << 0U << 0U << true;
+        QTest::newRow("no elements") << floatType << 0U << 1000U << 24U << true;
+        QTest::newRow("count") << floatType << 3U << 12U << 24U << false;
+        QTest::newRow("offset") << floatType << 1U << 40U << 24U << false;
+        QTest::newRow("stride") << floatType << 2U << 12U << 28U << false;
+        QTest::newRow("overflowing count") << floatType << 0xffffffffU << 0U << 0xffffffffU << false;
+        QTest::newRow("unknown type") << qint32(0xff) << 1U << 0U << 0U << false;
+    }
+
+    void checkAttributesFitInTheirBuffer()
+    {
+        QFETCH(qint32, vertexBaseType);
+        QFETCH(quint32, count);
+        QFETCH(quint32, byteOffset);
+        QFETCH(quint32, byteStride);
+        QFETCH(bool, valid);
+
+        // GIVEN
+        BinaryScene::SceneDescription description;
+        description.entities.append(BinaryScene::EntityRecord());
+        BinaryScene::AttributeRecord attribute;
+        attribute.vertexBaseType = vertexBaseType;
+        attribute.vertexSize = 3;
+        attribute.count = count;
+        attribute.byteOffset = byteOffset;
+        attribute.byteStride = byteStride;
+        attribute.buffer = 0;
+        description.geometries.append({ QStringLiteral("Geometry"), { attribute } });
+        description.buffers.append(BinaryScene::BufferRecord());
+
+        QByteArray data;
+        ::QBuffer device(&data);
+        device.open(QIODevice::WriteOnly);
+        QVERIFY(BinaryScene::write(&device, description, { toByteArray(vertices) }));
+
+        // WHEN
+        BinaryScene::SceneDescription readDescription;
+        qint64 dataOffset = 0;
+        const bool read = BinaryScene::read(data.constData(), data.size(), readDescription, dataOffset);
+
+        // THEN
+        QCOMPARE(read, valid);
+    }
+
+    void checkUnknownTexturePropertiesAreIgnored()
+    {
+        // GIVEN
+        const QByteArray data = materialScene({ QByteArrayLiteral("bogus"), QByteArrayLiteral("diffuse") });
+        QVERIFY(!data.isEmpty());
+
+        // WHEN
+        QScopedPointer<Qt3DCore::QEntity> imported(importScene(data));
+
+        // THEN
+        QVERIFY(imported);
+        Qt3DExtras::QDiffuseMapMaterial *material = findComponent<Qt3DExtras::QDiffuseMapMaterial>(imported.data());
+        QVERIFY(material != nullptr);
+        QVERIFY(material->dynamicPropertyNames().isEmpty());
+        QVERIFY(!material->property("bogus").isValid());
+        QVERIFY(material->diffuse() != nullptr);
+        QCOMPARE(material->diffuse()->objectName(), QStringLiteral("Texture"));
+    }
+
+private:
+    QByteArray exportScene(Qt3DCore::QEntity *root)
+    {
+        QScopedPointer<Qt3DRender::QSceneExporter> exporter(
+                    Qt3DRender::QSceneExportFactory::create(QStringLiteral("binarysceneexport"), QStringList()));
+        if (!exporter || !exporter->exportScene(root, m_dir->path(), QStringLiteral("scene"), QVariantHash()))
+            return QByteArray();
+
+        QFile file(m_dir->filePath(QStringLiteral("scene.qt3dscene")));
+        if (!file.open(QIODevice::ReadOnly))
+            return QByteArray();
+        return file.readAll();
+    }
+
+    // Imports from a file, so that the scene is read from a mapping of it
+    Qt3DCore::QEntity *importScene(const QByteArray &data)
+    {
+        const QString path = m_dir->filePath(QStringLiteral("imported.qt3dscene"));
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size())
+            return nullptr;
+        file.close();
+
+        QScopedPointer<Qt3DRender::QSceneImporter> importer(
+                    Qt3DRender::QSceneImportFactory::create(QStringLiteral("binaryscene"), QStringList()));
+        if (!importer || !importer->areFileTypesSupported({ QStringLiteral("qt3dscene") }))
+            return nullptr;
+        importer->setSource(QUrl::fromLocalFile(path));
+        return importer->scene();
+    }
+
+    QScopedPointer<QTemporaryDir> m_dir;
+};
+
+QTEST_MAIN(tst_BinaryScene)
+
+#include "tst_binaryscene.moc"
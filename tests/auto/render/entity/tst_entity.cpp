@@ -361,6 +361,51 @@ private slots:
         renderer.resetDirty();
     }
 
+    void checkLightEntityRegistration()
+    {
+        // GIVEN
+        TestRenderer renderer;
+        NodeManagers nodeManagers;
+        Qt3DCore::QEntity frontendEntityA, frontendEntityB;
+        QEnvironmentLight environmentLight;
+        QShaderData shaderData;
+
+        auto backendA = createEntity(renderer, nodeManagers, frontendEntityA);
+        auto backendB = createEntity(renderer, nodeManagers, frontendEntityB);
+        EntityManager *entityManager = nodeManagers.renderNodesManager();
+
+        // THEN
+        QVERIFY(entityManager->lightEntities().empty());
+
+        // WHEN
+        EntityPrivate::get(backendA)->componentAdded(&shaderData);
+
+        // THEN
+        QVERIFY(entityManager->lightEntities().empty());
+
+        // WHEN
+        EntityPrivate::get(backendA)->componentAdded(&environmentLight);
+        EntityPrivate::get(backendB)->componentAdded(&environmentLight);
+
+        // THEN
+        QCOMPARE(entityManager->lightEntities().size(), size_t(2));
+        QCOMPARE(entityManager->lightEntities().front(), backendA->handle());
+        QCOMPARE(entityManager->lightEntities().back(), backendB->handle());
+
+        // WHEN
+        EntityPrivate::get(backendA)->componentRemoved(&environmentLight);
+
+        // THEN
+        QCOMPARE(entityManager->lightEntities().size(), size_t(1));
+        QCOMPARE(entityManager->lightEntities().front(), backendB->handle());
+
+        // WHEN
+        backendB->cleanup();
+
+        // THEN
+        QVERIFY(entityManager->lightEntities().empty());
+    }
+
     void shouldHandleSingleComponentEvents_data()
     {
         QTest::addColumn<QComponent*>("component");
@@ -39,10 +39,13 @@
 
 #include <QtTest/qtest.h>
 
+#include <QtCore/QBuffer>
+#include <QtCore/QDataStream>
 #include <QtCore/QScopedPointer>
 #include <QtCore/private/qfactoryloader_p.h>
 
 #include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/qbuffer.h>
 #include <Qt3DCore/qgeometry.h>
 
 #include <Qt3DRender/private/qgeometryloaderfactory_p.h>
@@ -63,7 +66,11 @@ class tst_geometryloaders : public QObject
 private Q_SLOTS:
     void testOBJLoader_data();
     void testOBJLoader();
+    void testOBJLoaderLargeFile_data();
+    void testOBJLoaderLargeFile();
     void testPLYLoader();
+    void testBinaryPLYLoader_data();
+    void testBinaryPLYLoader();
     void testSTLLoader();
 #ifdef QT_3DGEOMETRYLOADERS_FBX
     void testFBXLoader();
@@ -119,6 +126,81 @@ void tst_geometryloaders::testOBJLoader()
     file.close();
 }
 
+void tst_geometryloaders::testOBJLoaderLargeFile_data()
+{
+    QTest::addColumn<QString>("subMesh");
+    QTest::addColumn<int>("vertexCount");
+    QTest::addColumn<float>("firstX");
+
+    const int gridSize = 200;
+    QTest::newRow("all submeshes") << QString() << 2 * gridSize * gridSize << 0.0f;
+    QTest::newRow("second submesh") << QStringLiteral("Second") << gridSize * gridSize << 1000.0f;
+}
+
+void tst_geometryloaders::testOBJLoaderLargeFile()
+{
+    // GIVEN a file large enough to be parsed in several chunks, made of
+    // two grids of quads in their own submeshes
+    QScopedPointer<QGeometryLoaderInterface> loader;
+    loader.reset(qLoadPlugin<QGeometryLoaderInterface, QGeometryLoaderFactory>(geometryLoader(), QStringLiteral("obj")));
+    QVERIFY(loader);
+
+    const int gridSize = 200;
+    QByteArray content;
+    for (int object = 0; object < 2; ++object) {
+        const int firstIndex = object * gridSize * gridSize + 1;
+        content += object == 0 ? "o First\n" : "o Second\n";
+        for (int y = 0; y < gridSize; ++y) {
+            for (int x = 0; x < gridSize; ++x)
+                content += "v " + QByteArray::number(object * 1000 + x) + ".0 " + QByteArray::number(y) + ".0 0.0\n";
+        }
+        content += "vn 0.0 0.0 1.0\n";
+        const QByteArray normal = "//" + QByteArray::number(object + 1);
+        for (int y = 0; y < gridSize - 1; ++y) {
+            for (int x = 0; x < gridSize - 1; ++x) {
+                const int i = firstIndex + y * gridSize + x;
+                content += "f " + QByteArray::number(i) + normal
+                        + ' ' + QByteArray::number(i + 1) + normal
+                        + ' ' + QByteArray::number(i + gridSize + 1) + normal
+                        + ' ' + QByteArray::number(i + gridSize) + normal + '\n';
+            }
+        }
+    }
+    QVERIFY(content.size() > 4 * 1024 * 1024);
+
+    ::QBuffer buffer(&content);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    // WHEN
+    QFETCH(QString, subMesh);
+    QVERIFY(loader->load(&buffer, subMesh));
+
+    // THEN
+    QFETCH(int, vertexCount);
+    QFETCH(float, firstX);
+    QGeometry *geometry = loader->geometry();
+    QVERIFY(geometry);
+    QCOMPARE(geometry->attributes().count(), 3);
+
+    const int triangleCount = 2 * (gridSize - 1) * (gridSize - 1) * vertexCount / (gridSize * gridSize);
+    for (QAttribute *attr : geometry->attributes()) {
+        if (attr->attributeType() == QAttribute::IndexAttribute) {
+            QCOMPARE(attr->count(), uint(triangleCount * 3));
+            const uint *indices = reinterpret_cast<const uint *>(attr->buffer()->data().constData());
+            QCOMPARE(indices[0], 0u);
+            QCOMPARE(indices[1], 1u);
+            QCOMPARE(indices[2], 2u);
+        } else {
+            QCOMPARE(attr->count(), uint(vertexCount));
+        }
+
+        if (attr->name() == QAttribute::defaultPositionAttributeName()) {
+            const float *vertices = reinterpret_cast<const float *>(attr->buffer()->data().constData() + attr->byteOffset());
+            QCOMPARE(vertices[0], firstX);
+        }
+    }
+}
+
 void tst_geometryloaders::testPLYLoader()
 {
     QScopedPointer<QGeometryLoaderInterface> loader;
@@ -161,6 +243,81 @@ void tst_geometryloaders::testPLYLoader()
     file.close();
 }
 
+void tst_geometryloaders::testBinaryPLYLoader_data()
+{
+    QTest::addColumn<int>("byteOrder");
+    QTest::addColumn<bool>("hasColors");
+
+    QTest::newRow("little endian") << int(QDataStream::LittleEndian) << false;
+    QTest::newRow("big endian") << int(QDataStream::BigEndian) << false;
+    QTest::newRow("little endian with colors") << int(QDataStream::LittleEndian) << true;
+    QTest::newRow("big endian with colors") << int(QDataStream::BigEndian) << true;
+}
+
+void tst_geometryloaders::testBinaryPLYLoader()
+{
+    // GIVEN a binary file with a single quad
+    QScopedPointer<QGeometryLoaderInterface> loader;
+    loader.reset(qLoadPlugin<QGeometryLoaderInterface, QGeometryLoaderFactory>(geometryLoader(), QStringLiteral("ply")));
+    QVERIFY(loader);
+
+    QFETCH(int, byteOrder);
+    QFETCH(bool, hasColors);
+
+    QByteArray content = "ply\n";
+    content += byteOrder == QDataStream::LittleEndian ? "format binary_little_endian 1.0\n" : "format binary_big_endian 1.0\n";
+    content += "element vertex 4\n"
+               "property float x\nproperty float y\nproperty float z\n"
+               "property float nx\nproperty float ny\nproperty float nz\n";
+    if (hasColors)
+        content += "property uchar red\nproperty uchar green\nproperty uchar blue\nproperty uchar alpha\n";
+    content += "element face 1\n"
+               "property list uchar uint vertex_indices\n"
+               "end_header\n";
+    {
+        QDataStream stream(&content, QIODevice::Append);
+        stream.setByteOrder(QDataStream::ByteOrder(byteOrder));
+        stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+        for (int i = 0; i < 4; ++i) {
+            stream << float(i + 1) << float(i % 2) << float(i / 2) << 0.0f << 0.0f << 1.0f;
+            if (hasColors)
+                stream << quint8(255) << quint8(0) << quint8(0) << quint8(255);
+        }
+        stream << quint8(4) << quint32(0) << quint32(1) << quint32(3) << quint32(2);
+    }
+
+    ::QBuffer buffer(&content);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    // WHEN
+    QVERIFY(loader->load(&buffer));
+
+    // THEN
+    QGeometry *geometry = loader->geometry();
+    QVERIFY(geometry);
+    QCOMPARE(geometry->attributes().count(), 3);
+
+    for (QAttribute *attr : geometry->attributes()) {
+        if (attr->attributeType() == QAttribute::IndexAttribute) {
+            QCOMPARE(attr->count(), 6u);
+            continue;
+        }
+
+        QCOMPARE(attr->count(), 4u);
+        const char *vertices = attr->buffer()->data().constData() + attr->byteOffset();
+        const uint stride = attr->byteStride();
+        const float *lastVertex = reinterpret_cast<const float *>(vertices + 3 * stride);
+        if (attr->name() == QAttribute::defaultPositionAttributeName()) {
+            QCOMPARE(lastVertex[0], 4.0f);
+            QCOMPARE(lastVertex[1], 1.0f);
+            QCOMPARE(lastVertex[2], 1.0f);
+        } else {
+            QCOMPARE(attr->name(), QAttribute::defaultNormalAttributeName());
+            QCOMPARE(lastVertex[2], 1.0f);
+        }
+    }
+}
+
 void tst_geometryloaders::testSTLLoader()
 {
     QScopedPointer<QGeometryLoaderInterface> loader;
@@ -27,9 +27,13 @@
 ****************************************************************************/
 
 #include <QtTest/QTest>
+#include <QtCore/QSemaphore>
 #include <qbackendnodetester.h>
 #include <Qt3DRender/private/geometryrenderer_p.h>
 #include <Qt3DRender/private/geometryrenderermanager_p.h>
+#include <Qt3DRender/private/backgroundgeometryloader_p.h>
+#include <Qt3DRender/private/qmesh_p.h>
+#include <Qt3DRender/qmesh.h>
 #include <Qt3DCore/qgeometry.h>
 #include "testrenderer.h"
 
@@ -42,6 +46,31 @@ public:
     {}
 };
 
+class DummyGeometryFactory : public Qt3DCore::QGeometryFactory
+{
+public:
+    explicit DummyGeometryFactory(QSemaphore *blocker = nullptr)
+        : m_blocker(blocker)
+    {}
+
+    Qt3DCore::QGeometry *operator ()() override
+    {
+        if (m_blocker)
+            m_blocker->acquire();
+        return new DummyGeometry();
+    }
+
+    bool operator ==(const Qt3DCore::QGeometryFactory &other) const override
+    {
+        return Qt3DCore::functor_cast<DummyGeometryFactory>(&other) == this;
+    }
+
+    QT3D_FUNCTOR(DummyGeometryFactory)
+
+private:
+    QSemaphore *m_blocker;
+};
+
 class tst_RenderGeometryRenderer : public Qt3DCore::QBackendNodeTester
 {
     Q_OBJECT
@@ -325,8 +354,111 @@ private Q_SLOTS:
         // THEN
         QCOMPARE(renderer.dirtyBits(), Qt3DRender::Render::AbstractRenderer::GeometryDirty);
     }
+
+    void checkBackgroundLoading()
+    {
+        // GIVEN
+        Qt3DRender::Render::BackgroundGeometryLoader loader;
+        const Qt3DCore::QNodeId idA = Qt3DCore::QNodeId::createId();
+        const Qt3DCore::QNodeId idB = Qt3DCore::QNodeId::createId();
+        const Qt3DCore::QGeometryFactoryPtr factoryA(new DummyGeometryFactory);
+        const Qt3DCore::QGeometryFactoryPtr factoryB(new DummyGeometryFactory);
+
+        // WHEN
+        loader.requestLoad(idA, factoryA);
+        loader.requestLoad(idB, factoryB);
+        loader.waitForDone();
+
+        // THEN
+        QCOMPARE(loader.pendingCount(), 0);
+        QVERIFY(loader.hasCompletedResults());
+
+        // WHEN
+        const auto firstResults = loader.takeCompletedResults(1);
+        const auto secondResults = loader.takeCompletedResults(1);
+
+        // THEN
+        QCOMPARE(firstResults.size(), size_t(1));
+        QCOMPARE(secondResults.size(), size_t(1));
+        QVERIFY(!loader.hasCompletedResults());
+        QVERIFY(firstResults.front().result.geometry != nullptr);
+        QCOMPARE(firstResults.front().geometryRendererId == idA ? firstResults.front().factory : secondResults.front().factory,
+                 factoryA);
+        delete firstResults.front().result.geometry;
+        delete secondResults.front().result.geometry;
+    }
+
+    void checkBackgroundLoadingCancellation()
+    {
+        // GIVEN
+        Qt3DRender::Render::BackgroundGeometryLoader loader;
+        loader.setMaxThreadCount(1);
+        QSemaphore blocker;
+        const Qt3DCore::QNodeId id = Qt3DCore::QNodeId::createId();
+        const Qt3DCore::QGeometryFactoryPtr slowFactory(new DummyGeometryFactory(&blocker));
+        const Qt3DCore::QGeometryFactoryPtr factory(new DummyGeometryFactory);
+
+        // WHEN
+        loader.requestLoad(id, slowFactory);
+
+        // THEN
+        QVERIFY(loader.isLoading(id));
+
+        // WHEN
+        loader.requestLoad(id, factory);
+        blocker.release();
+        loader.waitForDone();
+
+        // THEN -> only the result of the latest request is kept
+        auto results = loader.takeCompletedResults(0);
+        QCOMPARE(results.size(), size_t(1));
+        QCOMPARE(results.front().factory, factory);
+        delete results.front().result.geometry;
+
+        // WHEN
+        loader.requestLoad(id, factory);
+        loader.waitForDone();
+        loader.cancel(id);
+
+        // THEN
+        QVERIFY(!loader.hasCompletedResults());
+        QVERIFY(!loader.isLoading(id));
+    }
+
+    void checkMeshLoaderRunsOnSnapshot()
+    {
+        // GIVEN
+        Qt3DRender::Render::GeometryRendererManager geometryRendererManager;
+        Qt3DRender::Render::GeometryRenderer backendMesh;
+        Qt3DRender::QMesh mesh;
+        TestRenderer renderer;
+        mesh.setSource(QUrl(QStringLiteral("file:///doesnotexist.obj")));
+        backendMesh.setRenderer(&renderer);
+        backendMesh.setManager(&geometryRendererManager);
+        simulateInitializationSync(&mesh, &backendMesh);
+
+        // WHEN
+        const Qt3DCore::QGeometryFactoryPtr first = backendMesh.prepareFunctor();
+        const Qt3DCore::QGeometryFactoryPtr second = backendMesh.prepareFunctor();
+
+        // THEN -> each request gets its own copy of the functor
+        QVERIFY(backendMesh.isMeshLoaderFunctor());
+        QVERIFY(first != backendMesh.geometryFactory());
+        QVERIFY(first != second);
+        QCOMPARE(qSharedPointerCast<Qt3DRender::MeshLoaderFunctor>(first)->sourcePath(), mesh.source());
+
+        // WHEN
+        Qt3DCore::QGeometry *geometry = (*first)();
+
+        // THEN -> running it leaves the others untouched
+        QVERIFY(geometry == nullptr);
+        QCOMPARE(qSharedPointerCast<Qt3DRender::MeshLoaderFunctor>(first)->status(), Qt3DRender::QMesh::Error);
+        QCOMPARE(qSharedPointerCast<Qt3DRender::MeshLoaderFunctor>(second)->status(), Qt3DRender::QMesh::None);
+        QCOMPARE(qSharedPointerCast<Qt3DRender::MeshLoaderFunctor>(backendMesh.geometryFactory())->status(),
+                 Qt3DRender::QMesh::None);
+    }
 };
 
-QTEST_APPLESS_MAIN(tst_RenderGeometryRenderer)
+QTEST_GUILESS_MAIN(tst_RenderGeometryRenderer)
 
 #include "tst_geometryrenderer.moc"
@@ -38,6 +38,13 @@
 ****************************************************************************/
 
 #include <QtTest/qtest.h>
+#include <QtCore/qbuffer.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qendian.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
 #include <QtCore/qtemporarydir.h>
 #include <QtGui/qimage.h>
 
@@ -85,6 +92,7 @@
 #include <Qt3DExtras/qnormaldiffusespecularmapmaterial.h>
 #include <Qt3DExtras/qgoochmaterial.h>
 #include <Qt3DExtras/qpervertexcolormaterial.h>
+#include <Qt3DExtras/qmetalroughmaterial.h>
 #include <Qt3DExtras/qforwardrenderer.h>
 
 //#define VISUAL_CHECK 5000  // The value indicates the time for visual check in ms
@@ -101,8 +109,14 @@ private Q_SLOTS:
     void cleanup();
     void exportAndImport_data();
     void exportAndImport();
+    void exportBinaryGLTF();
+    void importBuffersAndImages_data();
+    void importBuffersAndImages();
+    void importCompressedGeometry();
+    void importNormalizedGeometry();
 
 private:
+    static QByteArray binaryGLTF(QByteArray json, const QByteArray &binaryChunk);
     void createTestScene();
     Qt3DCore::QEntity *findCameraChild(Qt3DCore::QEntity *entity,
                                        Qt3DRender::QCameraLens::ProjectionType type);
@@ -1153,16 +1167,19 @@ Qt3DCore::QEntity *tst_gltfPlugins::findCameraChild(Qt3DCore::QEntity *entity,
 void tst_gltfPlugins::exportAndImport_data()
 {
     QTest::addColumn<bool>("compactJson");
+    QTest::addColumn<bool>("binary");
 
-    QTest::newRow("No options") << false;
+    QTest::newRow("No options") << false << false;
 #ifndef VISUAL_CHECK
-    QTest::newRow("Compact json") << true;
+    QTest::newRow("Compact json") << true << false;
+    QTest::newRow("Binary") << false << true;
 #endif
 }
 
 void tst_gltfPlugins::exportAndImport()
 {
     QFETCH(bool, compactJson);
+    QFETCH(bool, binary);
 
     createTestScene();
 
@@ -1182,6 +1199,7 @@ void tst_gltfPlugins::exportAndImport()
         if (exporter != nullptr && key == QStringLiteral("gltfexport")) {
             QVariantHash options;
             options.insert(QStringLiteral("compactJson"), QVariant(compactJson));
+            options.insert(QStringLiteral("binary"), QVariant(binary));
             exporter->exportScene(m_sceneRoot1, exportDir, sceneName, options);
             break;
         }
@@ -1202,7 +1220,7 @@ void tst_gltfPlugins::exportAndImport()
             sceneSource += sceneName;
             sceneSource += QLatin1Char('/');
             sceneSource += sceneName;
-            sceneSource += QStringLiteral(".qgltf");
+            sceneSource += binary ? QStringLiteral(".glb") : QStringLiteral(".qgltf");
             importer->setSource(QUrl::fromLocalFile(sceneSource));
             importedScene = importer->scene();
             break;
@@ -1261,6 +1279,477 @@ void tst_gltfPlugins::exportAndImport()
 #endif
 }
 
+void tst_gltfPlugins::exportBinaryGLTF()
+{
+    // GIVEN
+    createTestScene();
+    const QString sceneName = QStringLiteral("MyBinaryGLTFScene");
+    QScopedPointer<Qt3DRender::QSceneExporter> exporter(
+                Qt3DRender::QSceneExportFactory::create(QStringLiteral("gltfexport"), QStringList()));
+    QVERIFY(exporter != nullptr);
+
+    // WHEN
+    QVariantHash options;
+    options.insert(QStringLiteral("binary"), QVariant(true));
+    QVERIFY(exporter->exportScene(m_sceneRoot1, m_exportDir->path(), sceneName, options));
+
+    // THEN
+    // Shaders and images are part of the binary file
+    const QDir sceneDir(m_exportDir->filePath(sceneName));
+    QCOMPARE(sceneDir.entryList(QDir::Files, QDir::Name),
+             QStringList({ sceneName + QStringLiteral(".glb"), sceneName + QStringLiteral(".qrc") }));
+
+    QFile file(sceneDir.filePath(sceneName + QStringLiteral(".glb")));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray fileData = file.readAll();
+    QVERIFY(fileData.size() > 20);
+    const char *header = fileData.constData();
+    QCOMPARE(qFromLittleEndian<quint32>(header), quint32(0x46546C67));
+    QCOMPARE(qFromLittleEndian<quint32>(header + 4), 1U);
+    QCOMPARE(qFromLittleEndian<quint32>(header + 8), quint32(fileData.size()));
+    QCOMPARE(qFromLittleEndian<quint32>(header + 16), 0U);
+    const int contentLength = int(qFromLittleEndian<quint32>(header + 12));
+    QCOMPARE((20 + contentLength) % 4, 0);
+    QVERIFY(20 + contentLength <= fileData.size());
+
+    QJsonParseError error;
+    const QJsonObject json = QJsonDocument::fromJson(fileData.mid(20, contentLength), &error).object();
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    QCOMPARE(json.value(QLatin1String("asset")).toObject().value(QLatin1String("version")).toString(),
+             QStringLiteral("1.0"));
+    QVERIFY(json.value(QLatin1String("extensionsUsed")).toArray().contains(QStringLiteral("KHR_binary_glTF")));
+
+    const QJsonObject buffers = json.value(QLatin1String("buffers")).toObject();
+    QCOMPARE(buffers.keys(), QStringList(QStringLiteral("binary_glTF")));
+    const int bodyLength = fileData.size() - 20 - contentLength;
+    QCOMPARE(buffers.value(QLatin1String("binary_glTF")).toObject().value(QLatin1String("byteLength")).toInt(),
+             bodyLength);
+
+    const QJsonObject bufferViews = json.value(QLatin1String("bufferViews")).toObject();
+    for (const QJsonValue &view : bufferViews) {
+        const QJsonObject viewObject = view.toObject();
+        QCOMPARE(viewObject.value(QLatin1String("buffer")).toString(), QStringLiteral("binary_glTF"));
+        QVERIFY(viewObject.value(QLatin1String("byteOffset")).toInt()
+                + viewObject.value(QLatin1String("byteLength")).toInt() <= bodyLength);
+    }
+
+    // Each shader and image reads its content from a view of the body
+    const auto binaryView = [&bufferViews] (const QJsonValue &value) {
+        const QJsonObject extension = value.toObject().value(QLatin1String("extensions")).toObject()
+                .value(QLatin1String("KHR_binary_glTF")).toObject();
+        return bufferViews.value(extension.value(QLatin1String("bufferView")).toString()).toObject();
+    };
+    const QJsonObject shaders = json.value(QLatin1String("shaders")).toObject();
+    QVERIFY(!shaders.isEmpty());
+    for (const QJsonValue &shader : shaders)
+        QVERIFY(!binaryView(shader).isEmpty());
+
+    const QJsonObject images = json.value(QLatin1String("images")).toObject();
+    QVERIFY(!images.isEmpty());
+    for (const QJsonValue &image : images) {
+        const QJsonObject view = binaryView(image);
+        QVERIFY(!view.isEmpty());
+        const QJsonObject extension = image.toObject().value(QLatin1String("extensions")).toObject()
+                .value(QLatin1String("KHR_binary_glTF")).toObject();
+        QCOMPARE(extension.value(QLatin1String("mimeType")).toString(), QStringLiteral("image/png"));
+        const QImage decoded = QImage::fromData(fileData.mid(20 + contentLength
+                                                             + view.value(QLatin1String("byteOffset")).toInt(),
+                                                             view.value(QLatin1String("byteLength")).toInt()));
+        QVERIFY(!decoded.isNull());
+        QCOMPARE(extension.value(QLatin1String("width")).toInt(), decoded.width());
+        QCOMPARE(extension.value(QLatin1String("height")).toInt(), decoded.height());
+    }
+}
+
+void tst_gltfPlugins::importBuffersAndImages_data()
+{
+    QTest::addColumn<bool>("binary");
+    QTest::addColumn<bool>("fromData");
+
+    QTest::newRow("Binary file") << true << false;
+    QTest::newRow("Binary data") << true << true;
+    QTest::newRow("External buffer file") << false << false;
+}
+
+void tst_gltfPlugins::importBuffersAndImages()
+{
+    QFETCH(bool, binary);
+    QFETCH(bool, fromData);
+
+    m_sceneRoot1 = new Qt3DCore::QEntity();
+    m_sceneRoot2 = nullptr;
+
+    // A textured triangle, its vertices, indices and, for binary files, its
+    // image stored in one buffer
+    const QList<float> positions = { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+    const QList<quint16> indices = { 0, 1, 2 };
+    QImage image(4, 4, QImage::Format_RGB32);
+    image.fill(Qt::red);
+    QByteArray png;
+    {
+        QBuffer pngBuffer(&png);
+        pngBuffer.open(QIODevice::WriteOnly);
+        image.save(&pngBuffer, "PNG");
+    }
+
+    QByteArray bufferData(reinterpret_cast<const char *>(positions.constData()), positions.size() * sizeof(float));
+    bufferData += QByteArray(reinterpret_cast<const char *>(indices.constData()), indices.size() * sizeof(quint16));
+    bufferData += QByteArray(2, '\0');
+    const int imageOffset = bufferData.size();
+    if (binary)
+        bufferData += png;
+
+    QJsonArray bufferViews;
+    bufferViews.append(QJsonObject { { "buffer", 0 }, { "byteOffset", 0 }, { "byteLength", 36 } });
+    bufferViews.append(QJsonObject { { "buffer", 0 }, { "byteOffset", 36 }, { "byteLength", 6 } });
+    QJsonObject imageObject;
+    if (binary) {
+        bufferViews.append(QJsonObject { { "buffer", 0 }, { "byteOffset", imageOffset }, { "byteLength", png.size() } });
+        imageObject = QJsonObject { { "bufferView", 2 }, { "mimeType", "image/png" } };
+    } else {
+        imageObject = QJsonObject { { "uri", QString::fromLatin1("data:image/png;base64," + png.toBase64()) } };
+    }
+
+    QJsonObject bufferObject { { "byteLength", bufferData.size() } };
+    if (!binary)
+        bufferObject.insert("uri", "triangle.bin");
+
+    const QJsonObject primitive {
+        { "attributes", QJsonObject { { "POSITION", 0 } } },
+        { "indices", 1 },
+        { "material", 0 }
+    };
+    const QJsonObject material {
+        { "pbrMetallicRoughness", QJsonObject { { "baseColorTexture", QJsonObject { { "index", 0 } } } } }
+    };
+    const QJsonObject root {
+        { "asset", QJsonObject { { "version", "2.0" } } },
+        { "scene", 0 },
+        { "scenes", QJsonArray { QJsonObject { { "nodes", QJsonArray { 0 } } } } },
+        { "nodes", QJsonArray { QJsonObject { { "mesh", 0 }, { "name", "Triangle" } } } },
+        { "meshes", QJsonArray { QJsonObject { { "primitives", QJsonArray { primitive } } } } },
+        { "materials", QJsonArray { material } },
+        { "textures", QJsonArray { QJsonObject { { "source", 0 } } } },
+        { "images", QJsonArray { imageObject } },
+        { "buffers", QJsonArray { bufferObject } },
+        { "bufferViews", bufferViews },
+        { "accessors", QJsonArray {
+                QJsonObject { { "bufferView", 0 }, { "componentType", 5126 }, { "count", 3 }, { "type", "VEC3" } },
+                QJsonObject { { "bufferView", 1 }, { "componentType", 5123 }, { "count", 3 }, { "type", "SCALAR" } } } }
+    };
+
+    const QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Compact);
+    QByteArray fileData;
+    if (binary) {
+        fileData = binaryGLTF(json, bufferData);
+    } else {
+        fileData = json;
+        QFile binFile(m_exportDir->filePath(QStringLiteral("triangle.bin")));
+        QVERIFY(binFile.open(QIODevice::WriteOnly));
+        binFile.write(bufferData);
+    }
+
+    const QString sceneSource = m_exportDir->filePath(binary ? QStringLiteral("triangle.glb")
+                                                             : QStringLiteral("triangle.gltf"));
+    {
+        QFile sceneFile(sceneSource);
+        QVERIFY(sceneFile.open(QIODevice::WriteOnly));
+        sceneFile.write(fileData);
+    }
+
+    // WHEN
+    Qt3DRender::QSceneImporter *importer = Qt3DRender::QSceneImportFactory::create(QStringLiteral("gltf"), QStringList());
+    QVERIFY(importer != nullptr);
+    QVERIFY(importer->areFileTypesSupported(QStringList(binary ? QStringLiteral("glb") : QStringLiteral("gltf"))));
+    if (fromData)
+        importer->setData(fileData, m_exportDir->path());
+    else
+        importer->setSource(QUrl::fromLocalFile(sceneSource));
+    Qt3DCore::QEntity *importedScene = importer->scene();
+    delete importer;
+
+    // THEN
+    QVERIFY(importedScene != nullptr);
+    importedScene->setParent(m_sceneRoot1);
+
+    Qt3DCore::QEntity *triangle = findChildEntity(importedScene, QStringLiteral("Triangle"));
+    QVERIFY(triangle != nullptr);
+    Qt3DRender::QGeometryRenderer *renderer = triangle->componentsOfType<Qt3DRender::QGeometryRenderer>().value(0);
+    QVERIFY(renderer != nullptr);
+    Qt3DCore::QGeometry *geometry = renderer->view()->geometry();
+    QVERIFY(geometry != nullptr);
+
+    const QList<Qt3DCore::QAttribute *> attributes = geometry->attributes();
+    QCOMPARE(attributes.size(), 2);
+    for (Qt3DCore::QAttribute *attribute : attributes) {
+        QCOMPARE(attribute->count(), 3U);
+        if (attribute->attributeType() == Qt3DCore::QAttribute::IndexAttribute) {
+            QCOMPARE(attribute->buffer()->data(),
+                     QByteArray(reinterpret_cast<const char *>(indices.constData()), indices.size() * sizeof(quint16)));
+        } else {
+            QCOMPARE(attribute->name(), Qt3DCore::QAttribute::defaultPositionAttributeName());
+            QCOMPARE(attribute->buffer()->data(),
+                     QByteArray(reinterpret_cast<const char *>(positions.constData()), positions.size() * sizeof(float)));
+        }
+    }
+
+    Qt3DExtras::QMetalRoughMaterial *material
+            = triangle->componentsOfType<Qt3DExtras::QMetalRoughMaterial>().value(0);
+    QVERIFY(material != nullptr);
+    Qt3DRender::QAbstractTexture *texture = material->baseColor().value<Qt3DRender::QAbstractTexture *>();
+    QVERIFY(texture != nullptr);
+    QCOMPARE(texture->textureImages().size(), 1);
+}
+
+void tst_gltfPlugins::importCompressedGeometry()
+{
+    m_sceneRoot1 = new Qt3DCore::QEntity();
+    m_sceneRoot2 = nullptr;
+
+    // Two triangles with quantized positions padded to 8 bytes and compressed
+    // as attributes, normalized byte normals and indices compressed as triangles
+    const QList<quint16> positions = { 0, 0, 0, 0,  2, 0, 0, 0,  0, 3, 0, 0,  2, 3, 0, 0 };
+    const QList<qint8> normals = { 0, 0, 127, 0,  0, 0, 127, 0,  0, 0, 127, 0,  0, 0, 127, 0 };
+    const QList<quint16> indices = { 0, 1, 2, 2, 1, 3 };
+    const int vertexCount = 4;
+    const int positionStride = 8;
+
+    // Each byte of the vertices is stored as one group of 16 zigzag encoded
+    // deltas, with a zero baseline vertex at the end of the tail
+    QByteArray encodedPositions(1, char(0xa0));
+    const uchar *vertexBytes = reinterpret_cast<const uchar *>(positions.constData());
+    for (int k = 0; k < positionStride; ++k) {
+        encodedPositions.append(char(0x03));
+        uchar previous = 0;
+        for (int i = 0; i < 16; ++i) {
+            const uchar value = i < vertexCount ? vertexBytes[i * positionStride + k] : previous;
+            const uchar delta = uchar(value - previous);
+            encodedPositions.append(char((delta << 1) ^ (qint8(delta) >> 7)));
+            previous = value;
+        }
+    }
+    encodedPositions.append(QByteArray(32, '\0'));
+
+    // Version 1 triangle codes: a new triangle with its codes in the data,
+    // then one sharing an edge of it with the next vertex
+    QByteArray encodedIndices = QByteArray::fromHex("e1fe1000");
+    encodedIndices.append(QByteArray(16, '\0'));
+
+    QByteArray bufferData = encodedPositions;
+    bufferData.append(QByteArray((4 - bufferData.size() % 4) % 4, '\0'));
+    const int normalsOffset = bufferData.size();
+    bufferData += QByteArray(reinterpret_cast<const char *>(normals.constData()), normals.size());
+    const int indicesOffset = bufferData.size();
+    bufferData += encodedIndices;
+
+    const QJsonObject positionsCompression {
+        { "buffer", 0 }, { "byteOffset", 0 }, { "byteLength", encodedPositions.size() },
+        { "byteStride", positionStride }, { "mode", "ATTRIBUTES" }, { "count", vertexCount }
+    };
+    const QJsonObject indicesCompression {
+        { "buffer", 0 }, { "byteOffset", indicesOffset }, { "byteLength", encodedIndices.size() },
+        { "byteStride", 2 }, { "mode", "TRIANGLES" }, { "count", indices.size() }
+    };
+    const QJsonArray bufferViews {
+        QJsonObject { { "buffer", 1 }, { "byteOffset", 0 }, { "byteLength", 32 }, { "byteStride", positionStride },
+                      { "extensions", QJsonObject { { "EXT_meshopt_compression", positionsCompression } } } },
+        QJsonObject { { "buffer", 0 }, { "byteOffset", normalsOffset }, { "byteLength", 16 }, { "byteStride", 4 } },
+        QJsonObject { { "buffer", 1 }, { "byteOffset", 32 }, { "byteLength", 12 },
+                      { "extensions", QJsonObject { { "EXT_meshopt_compression", indicesCompression } } } }
+    };
+    const QJsonArray buffers {
+        QJsonObject { { "byteLength", bufferData.size() } },
+        QJsonObject { { "byteLength", 44 },
+                      { "extensions", QJsonObject { { "EXT_meshopt_compression", QJsonObject { { "fallback", true } } } } } }
+    };
+
+    const QJsonObject primitive {
+        { "attributes", QJsonObject { { "POSITION", 0 }, { "NORMAL", 1 } } },
+        { "indices", 2 }
+    };
+    const QJsonArray extensions { "EXT_meshopt_compression", "KHR_mesh_quantization" };
+    const QJsonObject root {
+        { "asset", QJsonObject { { "version", "2.0" } } },
+        { "extensionsUsed", extensions },
+        { "extensionsRequired", extensions },
+        { "scene", 0 },
+        { "scenes", QJsonArray { QJsonObject { { "nodes", QJsonArray { 0 } } } } },
+        { "nodes", QJsonArray { QJsonObject { { "mesh", 0 }, { "name", "Quad" } } } },
+        { "meshes", QJsonArray { QJsonObject { { "primitives", QJsonArray { primitive } } } } },
+        { "buffers", buffers },
+        { "bufferViews", bufferViews },
+        { "accessors", QJsonArray {
+                QJsonObject { { "bufferView", 0 }, { "componentType", 5123 }, { "count", vertexCount }, { "type", "VEC3" } },
+                QJsonObject { { "bufferView", 1 }, { "componentType", 5120 }, { "count", vertexCount }, { "type", "VEC3" },
+                              { "normalized", true } },
+                QJsonObject { { "bufferView", 2 }, { "componentType", 5123 }, { "count", indices.size() }, { "type", "SCALAR" } } } }
+    };
+
+    // WHEN
+    Qt3DRender::QSceneImporter *importer = Qt3DRender::QSceneImportFactory::create(QStringLiteral("gltf"), QStringList());
+    QVERIFY(importer != nullptr);
+    importer->setData(binaryGLTF(QJsonDocument(root).toJson(QJsonDocument::Compact), bufferData),
+                      m_exportDir->path());
+    Qt3DCore::QEntity *importedScene = importer->scene();
+    delete importer;
+
+    // THEN
+    QVERIFY(importedScene != nullptr);
+    importedScene->setParent(m_sceneRoot1);
+
+    Qt3DCore::QEntity *quad = findChildEntity(importedScene, QStringLiteral("Quad"));
+    QVERIFY(quad != nullptr);
+    Qt3DRender::QGeometryRenderer *renderer = quad->componentsOfType<Qt3DRender::QGeometryRenderer>().value(0);
+    QVERIFY(renderer != nullptr);
+    Qt3DCore::QGeometry *geometry = renderer->view()->geometry();
+    QVERIFY(geometry != nullptr);
+
+    const QList<Qt3DCore::QAttribute *> attributes = geometry->attributes();
+    QCOMPARE(attributes.size(), 3);
+    for (Qt3DCore::QAttribute *attribute : attributes) {
+        if (attribute->attributeType() == Qt3DCore::QAttribute::IndexAttribute) {
+            QCOMPARE(attribute->count(), uint(indices.size()));
+            QCOMPARE(attribute->buffer()->data(),
+                     QByteArray(reinterpret_cast<const char *>(indices.constData()), indices.size() * sizeof(quint16)));
+        } else if (attribute->name() == Qt3DCore::QAttribute::defaultPositionAttributeName()) {
+            // Positions which aren't normalized are converted to floats
+            QCOMPARE(attribute->vertexBaseType(), Qt3DCore::QAttribute::Float);
+            QCOMPARE(attribute->vertexSize(), 3U);
+            QCOMPARE(attribute->byteStride(), 0U);
+            QList<float> expectedPositions;
+            for (int i = 0; i < vertexCount; ++i) {
+                for (int c = 0; c < 3; ++c)
+                    expectedPositions.append(float(positions.at(i * 4 + c)));
+            }
+            QCOMPARE(attribute->buffer()->data(),
+                     QByteArray(reinterpret_cast<const char *>(expectedPositions.constData()),
+                                expectedPositions.size() * sizeof(float)));
+        } else {
+            // Normalized normals are kept as they are
+            QCOMPARE(attribute->name(), Qt3DCore::QAttribute::defaultNormalAttributeName());
+            QCOMPARE(attribute->vertexBaseType(), Qt3DCore::QAttribute::Byte);
+            QCOMPARE(attribute->byteStride(), 4U);
+            QCOMPARE(attribute->buffer()->data(),
+                     QByteArray(reinterpret_cast<const char *>(normals.constData()), normals.size()));
+        }
+    }
+}
+
+void tst_gltfPlugins::importNormalizedGeometry()
+{
+    m_sceneRoot1 = new Qt3DCore::QEntity();
+    m_sceneRoot2 = nullptr;
+
+    // One triangle with the normalized formats the RHI renderer expands,
+    // 3 components vertices padded to 4 byte strides
+    const QList<float> positions = { 0.0f, 0.0f, 0.0f,  1.0f, 0.0f, 0.0f,  0.0f, 1.0f, 0.0f };
+    const QList<qint16> normals = { 0, 0, 32767, 0,  0, -32768, 0, 0,  16384, -16384, 0, 0 };
+    const QList<qint8> tangents = { 127, 0, 0, 127,  -128, 0, 0, -127,  0, 64, 0, 127 };
+    const QList<quint16> texCoords = { 0, 65535,  65535, 0,  32768, 32768 };
+    const QList<quint8> colors = { 255, 0, 0, 0,  0, 255, 0, 0,  0, 0, 51, 0 };
+    const int vertexCount = 3;
+
+    QByteArray bufferData;
+    QJsonArray bufferViews;
+    const auto appendView = [&] (const void *data, int size, int stride) {
+        QJsonObject view { { "buffer", 0 }, { "byteOffset", bufferData.size() }, { "byteLength", size } };
+        if (stride > 0)
+            view.insert(QLatin1String("byteStride"), stride);
+        bufferViews.append(view);
+        bufferData += QByteArray(static_cast<const char *>(data), size);
+    };
+    appendView(positions.constData(), positions.size() * sizeof(float), 0);
+    appendView(normals.constData(), normals.size() * sizeof(qint16), 8);
+    appendView(tangents.constData(), tangents.size(), 0);
+    appendView(texCoords.constData(), texCoords.size() * sizeof(quint16), 0);
+    appendView(colors.constData(), colors.size(), 4);
+
+    const auto accessor = [vertexCount] (int view, int componentType, const char *type) {
+        return QJsonObject { { "bufferView", view }, { "componentType", componentType },
+                             { "count", vertexCount }, { "type", type }, { "normalized", view > 0 } };
+    };
+    const QJsonObject primitive {
+        { "attributes", QJsonObject { { "POSITION", 0 }, { "NORMAL", 1 }, { "TANGENT", 2 },
+                                      { "TEXCOORD_0", 3 }, { "COLOR_0", 4 } } }
+    };
+    const QJsonArray extensions { "KHR_mesh_quantization" };
+    const QJsonObject root {
+        { "asset", QJsonObject { { "version", "2.0" } } },
+        { "extensionsUsed", extensions },
+        { "extensionsRequired", extensions },
+        { "scene", 0 },
+        { "scenes", QJsonArray { QJsonObject { { "nodes", QJsonArray { 0 } } } } },
+        { "nodes", QJsonArray { QJsonObject { { "mesh", 0 }, { "name", "Quantized" } } } },
+        { "meshes", QJsonArray { QJsonObject { { "primitives", QJsonArray { primitive } } } } },
+        { "buffers", QJsonArray { QJsonObject { { "byteLength", bufferData.size() } } } },
+        { "bufferViews", bufferViews },
+        { "accessors", QJsonArray { accessor(0, 5126, "VEC3"), accessor(1, 5122, "VEC3"),
+                                    accessor(2, 5120, "VEC4"), accessor(3, 5123, "VEC2"),
+                                    accessor(4, 5121, "VEC3") } }
+    };
+
+    // WHEN
+    Qt3DRender::QSceneImporter *importer = Qt3DRender::QSceneImportFactory::create(QStringLiteral("gltf"), QStringList());
+    QVERIFY(importer != nullptr);
+    importer->setData(binaryGLTF(QJsonDocument(root).toJson(QJsonDocument::Compact), bufferData),
+                      m_exportDir->path());
+    Qt3DCore::QEntity *importedScene = importer->scene();
+    delete importer;
+
+    // THEN
+    QVERIFY(importedScene != nullptr);
+    importedScene->setParent(m_sceneRoot1);
+
+    Qt3DCore::QEntity *entity = findChildEntity(importedScene, QStringLiteral("Quantized"));
+    QVERIFY(entity != nullptr);
+    Qt3DRender::QGeometryRenderer *renderer =
+            entity->componentsOfType<Qt3DRender::QGeometryRenderer>().value(0);
+    QVERIFY(renderer != nullptr);
+    Qt3DCore::QGeometry *geometry = renderer->view()->geometry();
+    QVERIFY(geometry != nullptr);
+
+    // Every normalized attribute is kept as it is, whatever the renderer
+    const auto checkKept = [this, geometry] (const QString &name, Qt3DCore::QAttribute::VertexBaseType type,
+                                       uint vertexSize, uint byteStride, const QByteArray &data) {
+        Qt3DCore::QAttribute *attribute =
+                findAttribute(name, Qt3DCore::QAttribute::VertexAttribute, geometry);
+        QVERIFY(attribute != nullptr);
+        QCOMPARE(attribute->vertexBaseType(), type);
+        QCOMPARE(attribute->vertexSize(), vertexSize);
+        QCOMPARE(attribute->byteStride(), byteStride);
+        QCOMPARE(attribute->buffer()->data().mid(attribute->byteOffset(), data.size()), data);
+    };
+    checkKept(Qt3DCore::QAttribute::defaultNormalAttributeName(), Qt3DCore::QAttribute::Short, 3U, 8U,
+              QByteArray(reinterpret_cast<const char *>(normals.constData()), normals.size() * sizeof(qint16)));
+    checkKept(Qt3DCore::QAttribute::defaultTangentAttributeName(), Qt3DCore::QAttribute::Byte, 4U, 0U,
+              QByteArray(reinterpret_cast<const char *>(tangents.constData()), tangents.size()));
+    checkKept(Qt3DCore::QAttribute::defaultTextureCoordinateAttributeName(), Qt3DCore::QAttribute::UnsignedShort, 2U, 0U,
+              QByteArray(reinterpret_cast<const char *>(texCoords.constData()), texCoords.size() * sizeof(quint16)));
+    checkKept(Qt3DCore::QAttribute::defaultColorAttributeName(), Qt3DCore::QAttribute::UnsignedByte, 3U, 4U,
+              QByteArray(reinterpret_cast<const char *>(colors.constData()), colors.size()));
+}
+
+QByteArray tst_gltfPlugins::binaryGLTF(QByteArray json, const QByteArray &binaryChunk)
+{
+    json.append(QByteArray((4 - json.size() % 4) % 4, ' '));
+
+    QByteArray fileData;
+    const auto appendUInt32 = [&fileData] (quint32 value) {
+        const quint32 le = qToLittleEndian(value);
+        fileData.append(reinterpret_cast<const char *>(&le), sizeof(le));
+    };
+    appendUInt32(0x46546C67);
+    appendUInt32(2);
+    appendUInt32(12 + 8 + json.size() + 8 + binaryChunk.size());
+    appendUInt32(json.size());
+    appendUInt32(0x4E4F534A);
+    fileData += json;
+    appendUInt32(binaryChunk.size());
+    appendUInt32(0x004E4942);
+    fileData += binaryChunk;
+    return fileData;
+}
+
 QTEST_MAIN(tst_gltfPlugins)
 
 #include "tst_gltfplugins.moc"
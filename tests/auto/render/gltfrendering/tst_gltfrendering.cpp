@@ -0,0 +1,259 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutex>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QtEndian>
+#include <QtGui/QWindow>
+#include <Qt3DCore/QAspectEngine>
+#include <Qt3DCore/QAttribute>
+#include <Qt3DCore/QEntity>
+#include <Qt3DCore/QGeometry>
+#include <Qt3DRender/QCamera>
+#include <Qt3DRender/QGeometryRenderer>
+#include <Qt3DRender/QRenderAspect>
+#include <Qt3DRender/QRenderSettings>
+#include <Qt3DExtras/QForwardRenderer>
+#include <Qt3DExtras/QNormalDiffuseMapMaterial>
+#include <Qt3DExtras/QPerVertexColorMaterial>
+
+#include <private/qsceneimporter_p.h>
+#include <private/qsceneimportfactory_p.h>
+
+namespace {
+
+QMutex warningsMutex;
+QStringList warnings;
+QtMessageHandler defaultHandler = nullptr;
+
+void recordWarnings(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    if (type == QtWarningMsg) {
+        QMutexLocker lock(&warningsMutex);
+        warnings.push_back(message);
+    }
+    if (defaultHandler)
+        defaultHandler(type, context, message);
+}
+
+QByteArray binaryGLTF(QByteArray json, const QByteArray &binaryChunk)
+{
+    json.append(QByteArray((4 - json.size() % 4) % 4, ' '));
+
+    QByteArray fileData;
+    const auto appendUInt32 = [&fileData] (quint32 value) {
+        const quint32 le = qToLittleEndian(value);
+        fileData.append(reinterpret_cast<const char *>(&le), sizeof(le));
+    };
+    appendUInt32(0x46546C67);
+    appendUInt32(2);
+    appendUInt32(12 + 8 + json.size() + 8 + binaryChunk.size());
+    appendUInt32(json.size());
+    appendUInt32(0x4E4F534A);
+    fileData += json;
+    appendUInt32(binaryChunk.size());
+    appendUInt32(0x004E4942);
+    fileData += binaryChunk;
+    return fileData;
+}
+
+// One triangle using the KHR_mesh_quantization normalized formats QRhi has
+// no vertex input format for: signed bytes and shorts, unsigned shorts and 3
+// components unsigned bytes
+QByteArray quantizedTriangle()
+{
+    const QList<float> positions = { -1.0f, -1.0f, 0.0f,  1.0f, -1.0f, 0.0f,  0.0f, 1.0f, 0.0f };
+    const QList<qint16> normals = { 0, 0, 32767, 0,  0, 0, 32767, 0,  0, 0, 32767, 0 };
+    const QList<qint8> tangents = { 127, 0, 0, 127,  127, 0, 0, 127,  127, 0, 0, 127 };
+    const QList<quint16> texCoords = { 0, 0,  65535, 0,  32768, 65535 };
+    const QList<quint8> colors = { 255, 0, 0, 0,  0, 255, 0, 0,  0, 0, 255, 0 };
+
+    QByteArray bufferData;
+    QJsonArray bufferViews;
+    const auto appendView = [&] (const void *data, int size, int stride) {
+        QJsonObject view { { "buffer", 0 }, { "byteOffset", bufferData.size() }, { "byteLength", size } };
+        if (stride > 0)
+            view.insert(QLatin1String("byteStride"), stride);
+        bufferViews.append(view);
+        bufferData += QByteArray(static_cast<const char *>(data), size);
+    };
+    appendView(positions.constData(), positions.size() * sizeof(float), 0);
+    appendView(normals.constData(), normals.size() * sizeof(qint16), 8);
+    appendView(tangents.constData(), tangents.size(), 0);
+    appendView(texCoords.constData(), texCoords.size() * sizeof(quint16), 0);
+    appendView(colors.constData(), colors.size(), 4);
+
+    const auto accessor = [] (int view, int componentType, const char *type) {
+        return QJsonObject { { "bufferView", view }, { "componentType", componentType },
+                             { "count", 3 }, { "type", type }, { "normalized", view > 0 } };
+    };
+    const QJsonObject primitive {
+        { "attributes", QJsonObject { { "POSITION", 0 }, { "NORMAL", 1 }, { "TANGENT", 2 },
+                                      { "TEXCOORD_0", 3 }, { "COLOR_0", 4 } } }
+    };
+    const QJsonArray extensions { "KHR_mesh_quantization" };
+    const QJsonObject root {
+        { "asset", QJsonObject { { "version", "2.0" } } },
+        { "extensionsUsed", extensions },
+        { "extensionsRequired", extensions },
+        { "scene", 0 },
+        { "scenes", QJsonArray { QJsonObject { { "nodes", QJsonArray { 0 } } } } },
+        { "nodes", QJsonArray { QJsonObject { { "mesh", 0 }, { "name", "Triangle" } } } },
+        { "meshes", QJsonArray { QJsonObject { { "primitives", QJsonArray { primitive } } } } },
+        { "buffers", QJsonArray { QJsonObject { { "byteLength", bufferData.size() } } } },
+        { "bufferViews", bufferViews },
+        { "accessors", QJsonArray { accessor(0, 5126, "VEC3"), accessor(1, 5122, "VEC3"),
+                                    accessor(2, 5120, "VEC4"), accessor(3, 5123, "VEC2"),
+                                    accessor(4, 5121, "VEC3") } }
+    };
+    return binaryGLTF(QJsonDocument(root).toJson(QJsonDocument::Compact), bufferData);
+}
+
+Qt3DRender::QGeometryRenderer *findGeometryRenderer(Qt3DCore::QNode *node)
+{
+    if (auto entity = qobject_cast<Qt3DCore::QEntity *>(node)) {
+        const auto renderers = entity->componentsOfType<Qt3DRender::QGeometryRenderer>();
+        if (!renderers.empty())
+            return renderers.first();
+    }
+    for (QObject *child : node->children()) {
+        if (auto childNode = qobject_cast<Qt3DCore::QNode *>(child)) {
+            if (Qt3DRender::QGeometryRenderer *renderer = findGeometryRenderer(childNode))
+                return renderer;
+        }
+    }
+    return nullptr;
+}
+
+} // anonymous
+
+class tst_GLTFRendering : public QObject
+{
+    Q_OBJECT
+
+public:
+    static void initMain()
+    {
+        // Renders on the Null QRhi backend, no GPU nor windowing system needed
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+        qputenv("QT3D_RENDERER", "rhi");
+        qputenv("QT3D_RHI_DEFAULT_API", "null");
+    }
+
+private Q_SLOTS:
+
+    void init()
+    {
+        {
+            QMutexLocker lock(&warningsMutex);
+            warnings.clear();
+        }
+        defaultHandler = qInstallMessageHandler(recordWarnings);
+    }
+
+    void cleanup()
+    {
+        qInstallMessageHandler(defaultHandler);
+    }
+
+    void checkQuantizedGeometryBuildsPipelines()
+    {
+        // GIVEN
+        QTemporaryDir dir;
+        Qt3DRender::QSceneImporter *importer =
+                Qt3DRender::QSceneImportFactory::create(QStringLiteral("gltf"), QStringList());
+        QVERIFY(importer != nullptr);
+        importer->setData(quantizedTriangle(), dir.path());
+        Qt3DCore::QEntity *importedScene = importer->scene();
+        delete importer;
+        QVERIFY(importedScene != nullptr);
+        Qt3DRender::QGeometryRenderer *mesh = findGeometryRenderer(importedScene);
+        QVERIFY(mesh != nullptr);
+
+        // The importer keeps them as they are, the renderer expands them
+        const auto attributes = mesh->view()->geometry()->attributes();
+        for (Qt3DCore::QAttribute *attribute : attributes) {
+            if (attribute->name() != Qt3DCore::QAttribute::defaultPositionAttributeName())
+                QVERIFY(attribute->vertexBaseType() != Qt3DCore::QAttribute::Float);
+        }
+
+        QWindow surface;
+        surface.resize(256, 256);
+        surface.create();
+
+        Qt3DCore::QEntity *root = new Qt3DCore::QEntity();
+        importedScene->setParent(root);
+
+        Qt3DRender::QCamera *camera = new Qt3DRender::QCamera(root);
+        camera->lens()->setPerspectiveProjection(45.0f, 1.0f, 0.1f, 100.0f);
+        camera->setPosition(QVector3D(0.0f, 0.0f, 5.0f));
+        camera->setViewCenter(QVector3D(0.0f, 0.0f, 0.0f));
+
+        Qt3DRender::QRenderSettings *renderSettings = new Qt3DRender::QRenderSettings();
+        Qt3DExtras::QForwardRenderer *forwardRenderer = new Qt3DExtras::QForwardRenderer();
+        forwardRenderer->setCamera(camera);
+        forwardRenderer->setSurface(&surface);
+        renderSettings->setActiveFrameGraph(forwardRenderer);
+        root->addComponent(renderSettings);
+
+        // Between them, these shaders consume every attribute of the triangle
+        Qt3DCore::QEntity *normalMapped = new Qt3DCore::QEntity(root);
+        normalMapped->addComponent(mesh);
+        normalMapped->addComponent(new Qt3DExtras::QNormalDiffuseMapMaterial());
+        Qt3DCore::QEntity *colored = new Qt3DCore::QEntity(root);
+        colored->addComponent(mesh);
+        colored->addComponent(new Qt3DExtras::QPerVertexColorMaterial());
+
+        // WHEN
+        {
+            Qt3DCore::QAspectEngine engine;
+            engine.setRunMode(Qt3DCore::QAspectEngine::Manual);
+            engine.registerAspect(new Qt3DRender::QRenderAspect(Qt3DRender::QRenderAspect::Automatic));
+            engine.setRootEntity(Qt3DCore::QEntityPtr(root));
+
+            // Backend creation, shader and geometry loading, then the
+            // pipelines get built with the first commands
+            for (int i = 0; i < 10; ++i)
+                engine.processFrame();
+        }
+
+        // THEN
+        QMutexLocker lock(&warningsMutex);
+        for (const QString &warning : qAsConst(warnings))
+            QVERIFY2(!warning.contains(QLatin1String("attribute type is not supported")), qPrintable(warning));
+    }
+};
+
+QTEST_MAIN(tst_GLTFRendering)
+
+#include "tst_gltfrendering.moc"
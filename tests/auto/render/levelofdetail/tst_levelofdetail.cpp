@@ -122,6 +122,17 @@ private Q_SLOTS:
             QCOMPARE(renderLod.thresholds(), thresholds);
         }
 
+        {
+            // WHEN
+            renderLod.setFilterValue(1.4);
+            lod.setCurrentIndex(2);
+            renderLod.syncFromFrontEnd(&lod, false);
+
+            // THEN
+            QCOMPARE(renderLod.currentIndex(), 2);
+            QCOMPARE(renderLod.filterValue(), 2.);
+        }
+
         {
             // WHEN
             const Qt3DRender::QLevelOfDetailBoundingSphere sphere(QVector3D(1.0f, 2.0f, 3.0f), 1.0f);
@@ -0,0 +1,12 @@
+TEMPLATE = app
+
+TARGET = tst_lightgrid
+
+QT += 3dcore 3dcore-private 3drender 3drender-private testlib
+
+CONFIG += testcase
+
+SOURCES += tst_lightgrid.cpp
+
+include(../../core/common/common.pri)
+include(../commons/commons.pri)
@@ -0,0 +1,198 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB)
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QTest>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/lightgrid_p.h>
+#include <Qt3DRender/private/lightsource_p.h>
+#include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/sphere_p.h>
+#include <QRandomGenerator>
+#include "qbackendnodetester.h"
+#include "testrenderer.h"
+
+#include <algorithm>
+#include <memory>
+
+using namespace Qt3DRender::Render;
+
+class tst_LightGrid : public Qt3DCore::QBackendNodeTester
+{
+    Q_OBJECT
+
+private:
+    TestRenderer m_renderer;
+    NodeManagers m_nodeManagers;
+    std::vector<std::unique_ptr<Entity>> m_backendEntities;
+    std::vector<std::unique_ptr<Qt3DCore::QEntity>> m_frontendEntities;
+
+    std::vector<LightSource> createLightSources(const std::vector<Vector3D> &positions)
+    {
+        std::vector<LightSource> lightSources;
+        for (const Vector3D &position : positions) {
+            m_frontendEntities.emplace_back(new Qt3DCore::QEntity());
+            m_backendEntities.emplace_back(new Entity());
+            Entity *backendEntity = m_backendEntities.back().get();
+            backendEntity->setRenderer(&m_renderer);
+            backendEntity->setNodeManagers(&m_nodeManagers);
+            simulateInitializationSync(m_frontendEntities.back().get(), backendEntity);
+            backendEntity->worldBoundingVolume()->setCenter(position);
+            lightSources.push_back(LightSource(backendEntity, {}));
+        }
+        return lightSources;
+    }
+
+    std::vector<int> bruteForceClosestLights(const std::vector<LightSource> &lightSources,
+                                             const Vector3D &position, int maxCount)
+    {
+        std::vector<int> indices(lightSources.size());
+        for (size_t i = 0; i < indices.size(); ++i)
+            indices[i] = int(i);
+        std::stable_sort(indices.begin(), indices.end(), [&] (int a, int b) {
+            return (lightSources[a].entity->worldBoundingVolume()->center() - position).lengthSquared()
+                    < (lightSources[b].entity->worldBoundingVolume()->center() - position).lengthSquared();
+        });
+        indices.resize(std::min(indices.size(), size_t(maxCount)));
+        return indices;
+    }
+
+private Q_SLOTS:
+
+    void cleanup()
+    {
+        m_backendEntities.clear();
+        m_frontendEntities.clear();
+    }
+
+    void checkInitialState()
+    {
+        // GIVEN
+        LightGrid grid;
+        int indices[8];
+
+        // THEN
+        QCOMPARE(grid.lightCount(), 0);
+        QCOMPARE(grid.resolution(), 0);
+        QCOMPARE(grid.closestLights(Vector3D(0.0f, 0.0f, 0.0f), 8, indices), 0);
+    }
+
+    void checkSingleLight()
+    {
+        // GIVEN
+        LightGrid grid;
+        const std::vector<LightSource> lightSources = createLightSources({ Vector3D(1.0f, 2.0f, 3.0f) });
+        int indices[8];
+
+        // WHEN
+        grid.build(lightSources);
+
+        // THEN
+        QCOMPARE(grid.lightCount(), 1);
+        QCOMPARE(grid.resolution(), 1);
+        QCOMPARE(grid.closestLights(Vector3D(-50.0f, 0.0f, 0.0f), 8, indices), 1);
+        QCOMPARE(indices[0], 0);
+    }
+
+    void checkClosestLightsMatchBruteForce_data()
+    {
+        QTest::addColumn<int>("lightCount");
+        QTest::addColumn<int>("maxCount");
+
+        QTest::newRow("few lights") << 5 << 8;
+        QTest::newRow("as many lights as slots") << 8 << 8;
+        QTest::newRow("many lights") << 500 << 8;
+        QTest::newRow("single slot") << 200 << 1;
+    }
+
+    void checkClosestLightsMatchBruteForce()
+    {
+        QFETCH(int, lightCount);
+        QFETCH(int, maxCount);
+
+        // GIVEN
+        QRandomGenerator generator(883);
+        std::vector<Vector3D> positions;
+        for (int i = 0; i < lightCount; ++i)
+            positions.push_back(Vector3D(float(generator.bounded(200.0) - 100.0),
+                                         float(generator.bounded(20.0)),
+                                         float(generator.bounded(200.0) - 100.0)));
+        const std::vector<LightSource> lightSources = createLightSources(positions);
+        LightGrid grid;
+
+        // WHEN
+        grid.build(lightSources);
+
+        // THEN
+        QCOMPARE(grid.lightCount(), lightCount);
+        for (int i = 0; i < 100; ++i) {
+            // Query positions also fall outside of the lights bounds
+            const Vector3D position(float(generator.bounded(300.0) - 150.0),
+                                    float(generator.bounded(60.0) - 20.0),
+                                    float(generator.bounded(300.0) - 150.0));
+            int indices[8];
+            const int count = grid.closestLights(position, maxCount, indices);
+            const std::vector<int> expected = bruteForceClosestLights(lightSources, position, maxCount);
+
+            QCOMPARE(count, int(expected.size()));
+            for (int j = 0; j < count; ++j) {
+                // Compare distances rather than indices to be insensitive to ties
+                const float actualDistance = (positions[indices[j]] - position).lengthSquared();
+                const float expectedDistance = (positions[expected[j]] - position).lengthSquared();
+                QCOMPARE(actualDistance, expectedDistance);
+            }
+        }
+    }
+
+    void checkRebuildReplacesLights()
+    {
+        // GIVEN
+        LightGrid grid;
+        grid.build(createLightSources({ Vector3D(0.0f, 0.0f, 0.0f), Vector3D(10.0f, 0.0f, 0.0f) }));
+        int indices[8];
+
+        // WHEN
+        grid.build(createLightSources({ Vector3D(5.0f, 5.0f, 5.0f) }));
+
+        // THEN
+        QCOMPARE(grid.lightCount(), 1);
+        QCOMPARE(grid.closestLights(Vector3D(0.0f, 0.0f, 0.0f), 8, indices), 1);
+        QCOMPARE(indices[0], 0);
+
+        // WHEN
+        grid.clear();
+
+        // THEN
+        QCOMPARE(grid.lightCount(), 0);
+        QCOMPARE(grid.closestLights(Vector3D(0.0f, 0.0f, 0.0f), 8, indices), 0);
+    }
+};
+
+QTEST_MAIN(tst_LightGrid)
+
+#include "tst_lightgrid.moc"
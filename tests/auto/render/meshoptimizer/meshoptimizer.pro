@@ -0,0 +1,9 @@
+TEMPLATE = app
+
+TARGET = meshoptimizer
+
+QT += 3dcore 3drender 3drender-private testlib
+
+CONFIG += testcase
+
+SOURCES += tst_meshoptimizer.cpp
@@ -0,0 +1,274 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <QtGui/QVector3D>
+#include <Qt3DCore/qattribute.h>
+#include <Qt3DCore/qbuffer.h>
+#include <Qt3DCore/qgeometry.h>
+#include <Qt3DRender/private/meshoptimizer_p.h>
+
+#include <algorithm>
+#include <array>
+#include <tuple>
+
+using namespace Qt3DRender;
+
+namespace {
+
+using Triangle = std::array<unsigned int, 3>;
+
+// A grid whose triangles are listed column by column, a poor order for the
+// vertex cache
+QList<unsigned int> gridIndices(int size)
+{
+    QList<unsigned int> indices;
+    for (int x = 0; x < size - 1; ++x) {
+        for (int y = 0; y < size - 1; ++y) {
+            const unsigned int i = y * size + x;
+            indices << i << i + 1 << i + size + 1;
+            indices << i << i + size + 1 << i + size;
+        }
+    }
+    return indices;
+}
+
+// Triangles rotated to start at their smallest index, so that reordering
+// the vertices of a triangle while preserving its winding compares equal
+QList<Triangle> sortedTriangles(const QList<unsigned int> &indices)
+{
+    QList<Triangle> triangles;
+    for (int i = 0; i + 2 < indices.size(); i += 3) {
+        Triangle t = { indices[i], indices[i + 1], indices[i + 2] };
+        std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+        triangles.append(t);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+// Average number of vertices transformed per triangle with a FIFO cache
+float averageCacheMissRatio(const QList<unsigned int> &indices, int cacheSize)
+{
+    QList<unsigned int> cache;
+    int misses = 0;
+    for (unsigned int index : indices) {
+        if (cache.contains(index))
+            continue;
+        ++misses;
+        cache.append(index);
+        if (cache.size() > cacheSize)
+            cache.removeFirst();
+    }
+    return float(misses) / (indices.size() / 3);
+}
+
+} // anonymous
+
+class tst_MeshOptimizer : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void checkVertexCacheOptimization()
+    {
+        // GIVEN
+        const int size = 32;
+        const QList<unsigned int> original = gridIndices(size);
+        QList<unsigned int> indices = original;
+
+        // WHEN
+        MeshOptimizer::optimizeVertexCache(indices.data(), indices.size(), size * size);
+
+        // THEN
+        QCOMPARE(sortedTriangles(indices), sortedTriangles(original));
+        QVERIFY(averageCacheMissRatio(indices, 16) < averageCacheMissRatio(original, 16));
+    }
+
+    void checkVertexFetchRemap()
+    {
+        // GIVEN
+        const QList<unsigned int> indices = { 4, 2, 0, 0, 2, 5 };
+        QList<unsigned int> remap(6);
+
+        // WHEN
+        const int usedCount = MeshOptimizer::vertexFetchRemap(remap.data(), indices.constData(), indices.size(), 6);
+
+        // THEN
+        QCOMPARE(usedCount, 4);
+        QCOMPARE(remap, QList<unsigned int>({ 2, ~0u, 1, ~0u, 0, 3 }));
+    }
+
+    void checkDeduplicationRemap()
+    {
+        // GIVEN
+        const QList<QVector3D> vertices = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 0, 0 }, { 0, 1, 0 }, { 1, 0, 0 } };
+        QList<unsigned int> remap(vertices.size());
+
+        // WHEN
+        const int uniqueCount = MeshOptimizer::deduplicationRemap(remap.data(),
+                                                                  reinterpret_cast<const char *>(vertices.constData()),
+                                                                  vertices.size(), sizeof(QVector3D));
+
+        // THEN
+        QCOMPARE(uniqueCount, 3);
+        QCOMPARE(remap, QList<unsigned int>({ 0, 1, 0, 2, 1 }));
+    }
+
+    void checkOptimizeGeometry()
+    {
+        // GIVEN
+        // Two triangles sharing an edge, with duplicated and unused vertices
+        // in separate position and normal buffers
+        const QList<QVector3D> positions = { { 9, 9, 9 }, { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 1, 0, 0 }, { 1, 1, 0 } };
+        const QList<QVector3D> normals(positions.size(), QVector3D(0, 0, 1));
+        const QList<quint16> indices = { 1, 2, 3, 4, 5, 3 };
+
+        Qt3DCore::QGeometry geometry;
+        auto positionBuffer = new Qt3DCore::QBuffer(&geometry);
+        positionBuffer->setData(QByteArray(reinterpret_cast<const char *>(positions.constData()),
+                                           positions.size() * sizeof(QVector3D)));
+        auto normalBuffer = new Qt3DCore::QBuffer(&geometry);
+        normalBuffer->setData(QByteArray(reinterpret_cast<const char *>(normals.constData()),
+                                         normals.size() * sizeof(QVector3D)));
+        auto indexBuffer = new Qt3DCore::QBuffer(&geometry);
+        indexBuffer->setData(QByteArray(reinterpret_cast<const char *>(indices.constData()),
+                                        indices.size() * sizeof(quint16)));
+
+        auto positionAttribute = new Qt3DCore::QAttribute(positionBuffer, Qt3DCore::QAttribute::defaultPositionAttributeName(),
+                                                          Qt3DCore::QAttribute::Float, 3, positions.size());
+        auto normalAttribute = new Qt3DCore::QAttribute(normalBuffer, Qt3DCore::QAttribute::defaultNormalAttributeName(),
+                                                        Qt3DCore::QAttribute::Float, 3, normals.size());
+        auto indexAttribute = new Qt3DCore::QAttribute(indexBuffer, Qt3DCore::QAttribute::UnsignedShort, 1, indices.size());
+        indexAttribute->setAttributeType(Qt3DCore::QAttribute::IndexAttribute);
+        geometry.addAttribute(positionAttribute);
+        geometry.addAttribute(normalAttribute);
+        geometry.addAttribute(indexAttribute);
+
+        // WHEN
+        const bool optimized = MeshOptimizer::optimizeGeometry(&geometry, QGeometryRenderer::Triangles,
+                                                               QMesh::VertexCacheOptimization
+                                                               | QMesh::VertexFetchOptimization
+                                                               | QMesh::VertexDeduplication,
+                                                               true);
+
+        // THEN
+        QVERIFY(optimized);
+        QCOMPARE(positionAttribute->count(), 4U);
+        QCOMPARE(normalAttribute->count(), 4U);
+        QCOMPARE(positionAttribute->buffer(), normalAttribute->buffer());
+        QCOMPARE(positionAttribute->byteStride(), uint(6 * sizeof(float)));
+        QCOMPARE(normalAttribute->byteOffset(), uint(3 * sizeof(float)));
+        QCOMPARE(indexAttribute->vertexBaseType(), Qt3DCore::QAttribute::UnsignedShort);
+        QCOMPARE(indexAttribute->count(), 6U);
+
+        // The replaced buffers were deleted
+        QCOMPARE(geometry.findChildren<Qt3DCore::QBuffer *>().size(), 2);
+
+        // Vertices are numbered in order of first use
+        const QByteArray indexData = indexAttribute->buffer()->data();
+        const quint16 *newIndices = reinterpret_cast<const quint16 *>(indexData.constData());
+        QCOMPARE(newIndices[0], quint16(0));
+
+        // The same triangles are drawn
+        const QByteArray vertexData = positionAttribute->buffer()->data();
+        const float *vertices = reinterpret_cast<const float *>(vertexData.constData());
+        QList<QVector3D> drawnBefore;
+        QList<QVector3D> drawnAfter;
+        for (int i = 0; i < indices.size(); ++i) {
+            drawnBefore.append(positions[indices[i]]);
+            const float *v = vertices + newIndices[i] * 6;
+            drawnAfter.append(QVector3D(v[0], v[1], v[2]));
+            QCOMPARE(QVector3D(v[3], v[4], v[5]), QVector3D(0, 0, 1));
+        }
+        const auto lessThan = [] (const QVector3D &a, const QVector3D &b) {
+            return std::make_tuple(a.x(), a.y(), a.z()) < std::make_tuple(b.x(), b.y(), b.z());
+        };
+        std::sort(drawnBefore.begin(), drawnBefore.end(), lessThan);
+        std::sort(drawnAfter.begin(), drawnAfter.end(), lessThan);
+        QCOMPARE(drawnAfter, drawnBefore);
+    }
+
+    void checkSharedBuffersOnlyReorderIndices()
+    {
+        // GIVEN
+        const QList<QVector3D> positions = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 1, 1, 0 } };
+        const QList<quint32> indices = { 0, 1, 2, 1, 3, 2 };
+
+        Qt3DCore::QGeometry geometry;
+        auto vertexBuffer = new Qt3DCore::QBuffer(&geometry);
+        vertexBuffer->setData(QByteArray(reinterpret_cast<const char *>(positions.constData()),
+                                         positions.size() * sizeof(QVector3D)));
+        auto indexBuffer = new Qt3DCore::QBuffer(&geometry);
+        indexBuffer->setData(QByteArray(reinterpret_cast<const char *>(indices.constData()),
+                                        indices.size() * sizeof(quint32)));
+        auto positionAttribute = new Qt3DCore::QAttribute(vertexBuffer, Qt3DCore::QAttribute::defaultPositionAttributeName(),
+                                                          Qt3DCore::QAttribute::Float, 3, positions.size());
+        auto indexAttribute = new Qt3DCore::QAttribute(indexBuffer, Qt3DCore::QAttribute::UnsignedInt, 1, indices.size());
+        indexAttribute->setAttributeType(Qt3DCore::QAttribute::IndexAttribute);
+        geometry.addAttribute(positionAttribute);
+        geometry.addAttribute(indexAttribute);
+
+        // WHEN
+        const bool optimized = MeshOptimizer::optimizeGeometry(&geometry, QGeometryRenderer::Triangles,
+                                                               QMesh::VertexCacheOptimization
+                                                               | QMesh::VertexFetchOptimization,
+                                                               false);
+
+        // THEN
+        QVERIFY(optimized);
+        QCOMPARE(positionAttribute->buffer(), vertexBuffer);
+        QCOMPARE(positionAttribute->count(), 4U);
+        QVERIFY(indexAttribute->buffer() != indexBuffer);
+        const QByteArray indexData = indexAttribute->buffer()->data();
+        const quint32 *newIndices = reinterpret_cast<const quint32 *>(indexData.constData());
+        QCOMPARE(sortedTriangles(QList<unsigned int>(newIndices, newIndices + indices.size())),
+                 sortedTriangles(QList<unsigned int>(indices.cbegin(), indices.cend())));
+    }
+
+    void checkNonIndexedGeometryIsUntouched()
+    {
+        // GIVEN
+        Qt3DCore::QGeometry geometry;
+        auto vertexBuffer = new Qt3DCore::QBuffer(&geometry);
+        vertexBuffer->setData(QByteArray(9 * sizeof(float), 0));
+        geometry.addAttribute(new Qt3DCore::QAttribute(vertexBuffer, Qt3DCore::QAttribute::defaultPositionAttributeName(),
+                                                       Qt3DCore::QAttribute::Float, 3, 3));
+
+        // THEN
+        QVERIFY(!MeshOptimizer::optimizeGeometry(&geometry, QGeometryRenderer::Triangles,
+                                                 QMesh::VertexCacheOptimization, true));
+        QVERIFY(!MeshOptimizer::optimizeGeometry(&geometry, QGeometryRenderer::Triangles,
+                                                 QMesh::NoOptimization, true));
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_MeshOptimizer)
+
+#include "tst_meshoptimizer.moc"
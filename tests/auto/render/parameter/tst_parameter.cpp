@@ -163,6 +163,45 @@ private Q_SLOTS:
         }
     }
 
+    void checkOnlyChangedFieldsAreSynced()
+    {
+        // GIVEN
+        Qt3DRender::Render::Parameter backendParameter;
+        TestRenderer renderer;
+        backendParameter.setRenderer(&renderer);
+
+        Qt3DRender::QParameter parameter;
+        parameter.setName(QStringLiteral("Camaro"));
+        parameter.setValue(QVariant(454.0f));
+        simulateInitializationSync(&parameter, &backendParameter);
+        renderer.clearDirtyBits(Qt3DRender::Render::AbstractRenderer::AllDirty);
+
+        Qt3DRender::QParameterPrivate *d = static_cast<Qt3DRender::QParameterPrivate *>(
+                    Qt3DCore::QNodePrivate::get(&parameter));
+        d->clearChangedFields();
+
+        {
+            // WHEN
+            d->m_backendValue = QVariant(350.0f);
+            backendParameter.syncFromFrontEnd(&parameter, false);
+
+            // THEN
+            QCOMPARE(backendParameter.backendValue(), QVariant(454.0f));
+            QVERIFY(renderer.dirtyBits() == 0);
+        }
+        {
+            // WHEN
+            d->markFieldsChanged(Qt3DRender::QParameterPrivate::ValueField);
+            backendParameter.syncFromFrontEnd(&parameter, false);
+
+            // THEN
+            QCOMPARE(backendParameter.backendValue(), QVariant(350.0f));
+            QCOMPARE(backendParameter.uniformValue(), Qt3DRender::Render::UniformValue::fromVariant(QVariant(350.0f)));
+            QCOMPARE(backendParameter.name(), QStringLiteral("Camaro"));
+            QVERIFY(renderer.dirtyBits() & Qt3DRender::Render::AbstractRenderer::ParameterDirty);
+        }
+    }
+
 };
 
 QTEST_MAIN(tst_Parameter)
@@ -0,0 +1,9 @@
+TEMPLATE = app
+
+TARGET = tst_pipelinedrendering
+
+QT += core gui 3dcore 3dcore-private 3drender 3drender-private 3dextras testlib
+
+CONFIG += testcase
+
+SOURCES += tst_pipelinedrendering.cpp
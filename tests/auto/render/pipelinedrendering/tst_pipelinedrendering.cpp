@@ -0,0 +1,250 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <QtGui/QWindow>
+#include <Qt3DCore/QAspectEngine>
+#include <Qt3DCore/QEntity>
+#include <Qt3DCore/QTransform>
+#include <Qt3DRender/QCamera>
+#include <Qt3DRender/QRenderAspect>
+#include <Qt3DRender/QRenderSettings>
+#include <Qt3DExtras/QForwardRenderer>
+#include <Qt3DExtras/QPhongMaterial>
+#include <Qt3DExtras/QSphereMesh>
+
+#include <Qt3DCore/private/qaspectengine_p.h>
+#include <Qt3DCore/private/qaspectmanager_p.h>
+#include <Qt3DCore/private/qservicelocator_p.h>
+#include <Qt3DCore/private/qsysteminformationservice_p.h>
+#include <Qt3DCore/private/qsysteminformationservice_p_p.h>
+#include <Qt3DRender/private/job_common_p.h>
+
+namespace {
+
+Qt3DCore::QEntity *createScene(QWindow *surface, QList<Qt3DCore::QTransform *> &transforms)
+{
+    Qt3DCore::QEntity *root = new Qt3DCore::QEntity();
+
+    Qt3DRender::QCamera *camera = new Qt3DRender::QCamera(root);
+    camera->lens()->setPerspectiveProjection(45.0f, 16.0f/9.0f, 0.1f, 1000.0f);
+    camera->setPosition(QVector3D(0.0f, 0.0f, 40.0f));
+    camera->setViewCenter(QVector3D(0.0f, 0.0f, 0.0f));
+
+    Qt3DRender::QRenderSettings *renderSettings = new Qt3DRender::QRenderSettings();
+    Qt3DExtras::QForwardRenderer *forwardRenderer = new Qt3DExtras::QForwardRenderer();
+    forwardRenderer->setCamera(camera);
+    forwardRenderer->setSurface(surface);
+    renderSettings->setActiveFrameGraph(forwardRenderer);
+    root->addComponent(renderSettings);
+
+    Qt3DExtras::QSphereMesh *mesh = new Qt3DExtras::QSphereMesh(root);
+    Qt3DExtras::QPhongMaterial *material = new Qt3DExtras::QPhongMaterial(root);
+    for (int i = 0; i < 10; ++i) {
+        Qt3DCore::QEntity *e = new Qt3DCore::QEntity(root);
+        Qt3DCore::QTransform *transform = new Qt3DCore::QTransform();
+        transform->setTranslation(QVector3D(float(i) * 3.0f - 15.0f, 0.0f, 0.0f));
+        e->addComponent(transform);
+        e->addComponent(mesh);
+        e->addComponent(material);
+        transforms.push_back(transform);
+    }
+
+    return root;
+}
+
+// Counts the frames submitted during each processFrame call
+class SubmissionCounter
+{
+public:
+    using JobRunStats = Qt3DCore::QSystemInformationServicePrivate::JobRunStats;
+
+    explicit SubmissionCounter(Qt3DCore::QSystemInformationService *service)
+        : m_service(service)
+    {
+        Qt3DCore::QSystemInformationServicePrivate::get(m_service)->m_frameStatsHandler =
+                [this] (quint32, const QList<JobRunStats> &, const QList<JobRunStats> &submissionStats) {
+            for (const JobRunStats &stats : submissionStats)
+                m_submitted += stats.jobId.typeAndInstance[0] == Qt3DRender::Render::JobTypes::FrameSubmissionPart2;
+        };
+    }
+
+    ~SubmissionCounter()
+    {
+        Qt3DCore::QSystemInformationServicePrivate::get(m_service)->m_frameStatsHandler = nullptr;
+    }
+
+    // The stats are otherwise only handed over when the jobs of the next
+    // frame get enqueued
+    void frameDone()
+    {
+        m_service->writePreviousFrameTraces();
+        m_submittedPerFrame.push_back(m_submitted - m_lastSubmitted);
+        m_lastSubmitted = m_submitted;
+    }
+
+    void reset() { m_submittedPerFrame.clear(); }
+    QList<int> submittedPerFrame() const { return m_submittedPerFrame; }
+
+private:
+    Qt3DCore::QSystemInformationService *m_service;
+    QList<int> m_submittedPerFrame;
+    int m_submitted = 0;
+    int m_lastSubmitted = 0;
+};
+
+} // anonymous
+
+class tst_PipelinedRendering : public QObject
+{
+    Q_OBJECT
+
+public:
+    static void initMain()
+    {
+        // Renders on the Null QRhi backend, no GPU nor windowing system needed
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+        qputenv("QT3D_RENDERER", "rhi");
+        qputenv("QT3D_RHI_DEFAULT_API", "null");
+        qunsetenv("QT3D_PIPELINED_RENDERING");
+    }
+
+private Q_SLOTS:
+
+    void init()
+    {
+        m_surface.reset(new QWindow());
+        m_surface->resize(512, 512);
+        m_surface->create();
+
+        m_renderAspect = new Qt3DRender::QRenderAspect(Qt3DRender::QRenderAspect::Automatic);
+        m_engine.reset(new Qt3DCore::QAspectEngine());
+        m_engine->setRunMode(Qt3DCore::QAspectEngine::Manual);
+        m_engine->registerAspect(m_renderAspect);
+
+        Qt3DCore::QSystemInformationService *service =
+                Qt3DCore::QAspectEnginePrivate::get(m_engine.data())->m_aspectManager->serviceLocator()->systemInformation();
+        service->setTraceEnabled(true);
+        m_counter.reset(new SubmissionCounter(service));
+
+        m_transforms.clear();
+        m_engine->setRootEntity(Qt3DCore::QEntityPtr(createScene(m_surface.data(), m_transforms)));
+    }
+
+    void cleanup()
+    {
+        // A frame may still be pending, it has to be submitted on shutdown
+        m_counter.reset();
+        m_engine.reset();
+        m_surface.reset();
+    }
+
+    void checkPipelinedRenderingIsDisabledByDefault()
+    {
+        // THEN
+        QVERIFY(!m_renderAspect->isPipelinedRenderingEnabled());
+
+        // WHEN
+        m_renderAspect->setPipelinedRenderingEnabled(true);
+
+        // THEN
+        QVERIFY(m_renderAspect->isPipelinedRenderingEnabled());
+    }
+
+    void checkEveryFrameIsSubmitted_data()
+    {
+        QTest::addColumn<bool>("pipelined");
+
+        QTest::newRow("serialized") << false;
+        QTest::newRow("pipelined") << true;
+    }
+
+    void checkEveryFrameIsSubmitted()
+    {
+        QFETCH(bool, pipelined);
+
+        // GIVEN
+        m_renderAspect->setPipelinedRenderingEnabled(pipelined);
+        warmUp();
+
+        // WHEN
+        processFrames(5);
+
+        // THEN -> when pipelined, each frame submits the one prepared by the
+        // previous processFrame
+        QCOMPARE(m_counter->submittedPerFrame(), QList<int>({ 1, 1, 1, 1, 1 }));
+    }
+
+    void checkPipelinedRenderingCanBeToggled()
+    {
+        // GIVEN
+        m_renderAspect->setPipelinedRenderingEnabled(true);
+        warmUp();
+
+        // WHEN
+        processFrames(2);
+        m_renderAspect->setPipelinedRenderingEnabled(false);
+        processFrames(2);
+        m_renderAspect->setPipelinedRenderingEnabled(true);
+        processFrames(2);
+
+        // THEN -> the pending frame gets submitted before the next one is
+        // prepared once disabled, no frame is submitted while the jobs run
+        // once enabled again
+        QCOMPARE(m_counter->submittedPerFrame(), QList<int>({ 1, 1, 2, 1, 0, 1 }));
+    }
+
+private:
+    void warmUp()
+    {
+        // Backend creation, shader and geometry loading
+        processFrames(10);
+        m_counter->reset();
+    }
+
+    void processFrames(int count)
+    {
+        for (int i = 0; i < count; ++i) {
+            for (Qt3DCore::QTransform *transform : qAsConst(m_transforms))
+                transform->setRotationY(transform->rotationY() + 1.0f);
+            m_engine->processFrame();
+            m_counter->frameDone();
+        }
+    }
+
+    QScopedPointer<QWindow> m_surface;
+    QScopedPointer<Qt3DCore::QAspectEngine> m_engine;
+    QScopedPointer<SubmissionCounter> m_counter;
+    Qt3DRender::QRenderAspect *m_renderAspect = nullptr;
+    QList<Qt3DCore::QTransform *> m_transforms;
+};
+
+QTEST_MAIN(tst_PipelinedRendering)
+
+#include "tst_pipelinedrendering.moc"
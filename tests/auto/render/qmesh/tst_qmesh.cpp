@@ -62,6 +62,7 @@ private Q_SLOTS:
         QCOMPARE(mesh.source(), QUrl());
         QCOMPARE(mesh.meshName(), QString());
         QCOMPARE(mesh.status(), Qt3DRender::QMesh::None);
+        QCOMPARE(mesh.optimizations(), Qt3DRender::QMesh::NoOptimization);
     }
 
     void checkPropertyChanges()
@@ -107,6 +108,26 @@ private Q_SLOTS:
             QCOMPARE(mesh.meshName(), newValue);
             QCOMPARE(spy.count(), 0);
         }
+        {
+            // WHEN
+            QSignalSpy spy(&mesh, &Qt3DRender::QMesh::optimizationsChanged);
+            const Qt3DRender::QMesh::MeshOptimizations newValue = Qt3DRender::QMesh::VertexCacheOptimization
+                    | Qt3DRender::QMesh::VertexFetchOptimization;
+            mesh.setOptimizations(newValue);
+
+            // THEN
+            QVERIFY(spy.isValid());
+            QCOMPARE(mesh.optimizations(), newValue);
+            QCOMPARE(spy.count(), 1);
+
+            // WHEN
+            spy.clear();
+            mesh.setOptimizations(newValue);
+
+            // THEN
+            QCOMPARE(mesh.optimizations(), newValue);
+            QCOMPARE(spy.count(), 0);
+        }
     }
 
     void checkSourceUpdate()
@@ -194,6 +215,37 @@ private Q_SLOTS:
         // THEN
         QVERIFY(!Qt3DRender::QMeshPrivate::get(&mesh)->m_geometryFactory.isNull());
     }
+
+    void checkOptimizationsFollowPrimitiveType()
+    {
+        // GIVEN
+        Qt3DRender::QMesh mesh;
+        Qt3DRender::QMeshPrivate *dMesh = Qt3DRender::QMeshPrivate::get(&mesh);
+        mesh.setSource(QUrl(QStringLiteral("some_path")));
+        const auto functor = [dMesh] {
+            return qSharedPointerCast<Qt3DRender::MeshLoaderFunctor>(dMesh->m_geometryFactory);
+        };
+
+        // THEN
+        QCOMPARE(functor()->primitiveType(), Qt3DRender::QGeometryRenderer::Triangles);
+
+        // WHEN
+        Qt3DCore::QGeometryFactoryPtr previousFunctor = dMesh->m_geometryFactory;
+        mesh.setPrimitiveType(Qt3DRender::QGeometryRenderer::TriangleStrip);
+
+        // THEN -> nothing to reload without optimizations
+        QCOMPARE(dMesh->m_geometryFactory, previousFunctor);
+
+        // WHEN
+        mesh.setOptimizations(Qt3DRender::QMesh::VertexCacheOptimization);
+        previousFunctor = dMesh->m_geometryFactory;
+        mesh.setPrimitiveType(Qt3DRender::QGeometryRenderer::Lines);
+
+        // THEN
+        QVERIFY(dMesh->m_geometryFactory != previousFunctor);
+        QCOMPARE(functor()->primitiveType(), Qt3DRender::QGeometryRenderer::Lines);
+        QVERIFY(!(*dMesh->m_geometryFactory == *previousFunctor));
+    }
 };
 
 QTEST_MAIN(tst_QMesh)
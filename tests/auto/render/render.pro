@@ -23,10 +23,12 @@ qtConfig(private_tests) {
         ktxtextures \
         layerfiltering \
         levelofdetail \
+        lightgrid \
         loadscenejob \
         material \
         memorybarrier \
         meshfunctors \
+        meshoptimizer \
         objectpicker \
         parameter \
         proximityfilter \
@@ -102,6 +104,9 @@ qtConfig(private_tests) {
         transform \
         trianglevisitor \
         uniform \
+        updatelevelofdetailjob \
+        updateworldtransformjob \
+        vertexattributegenerators \
         vsyncframeadvanceservice \
         waitfence
 
@@ -141,7 +146,9 @@ qtConfig(qt3d-opengl-renderer):qtConfig(private_tests) {
             qmaterial \
             geometryloaders \
             picking \
-            gltfplugins
+            gltfplugins \
+            assimpimporter \
+            binaryscene
     }
 
     qtConfig(qt3d-input) {
@@ -160,4 +167,6 @@ qtConfig(qt3d-rhi-renderer):qtConfig(private_tests) {
 
     SUBDIRS += \
         rhi
+
+    qtConfig(qt3d-extras): SUBDIRS += pipelinedrendering gltfrendering
 }
@@ -52,6 +52,8 @@ private Q_SLOTS:
         QCOMPARE(backendTransform.isEnabled(), false);
         QVERIFY(backendTransform.peerId().isNull());
         QCOMPARE(convertToQMatrix4x4(backendTransform.transformMatrix()), QMatrix4x4());
+        QCOMPARE(backendTransform.worldMatrixUpdatesEnabled(), true);
+        QVERIFY(Qt3DCore::QBackendNodePrivate::get(&backendTransform)->m_threadSafeSync);
     }
 
     void checkCleanupState()
@@ -178,6 +180,28 @@ private Q_SLOTS:
             QVERIFY(renderer.dirtyBits() & Qt3DRender::Render::AbstractRenderer::TransformDirty);
             renderer.clearDirtyBits(Qt3DRender::Render::AbstractRenderer::AllDirty);
         }
+        {
+            // WHEN
+            const bool newValue = false;
+            frontendTranform.setWorldMatrixUpdatesEnabled(newValue);
+            backendTransform.syncFromFrontEnd(&frontendTranform, false);
+
+            // THEN
+            QCOMPARE(backendTransform.worldMatrixUpdatesEnabled(), newValue);
+            QVERIFY(!backendTransform.isWorldMatrixRefreshRequested());
+            renderer.clearDirtyBits(Qt3DRender::Render::AbstractRenderer::AllDirty);
+        }
+        {
+            // WHEN
+            const bool newValue = true;
+            frontendTranform.setWorldMatrixUpdatesEnabled(newValue);
+            backendTransform.syncFromFrontEnd(&frontendTranform, false);
+
+            // THEN
+            QCOMPARE(backendTransform.worldMatrixUpdatesEnabled(), newValue);
+            QVERIFY(backendTransform.isWorldMatrixRefreshRequested());
+            QVERIFY(renderer.dirtyBits() & Qt3DRender::Render::AbstractRenderer::TransformDirty);
+        }
     }
 };
 
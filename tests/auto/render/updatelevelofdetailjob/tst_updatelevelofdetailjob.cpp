@@ -0,0 +1,301 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DCore/qtransform.h>
+#include <Qt3DRender/qcamera.h>
+#include <Qt3DRender/qcameraselector.h>
+#include <Qt3DRender/qlevelofdetail.h>
+#include <Qt3DRender/qviewport.h>
+#include <Qt3DRender/private/cameralens_p.h>
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/levelofdetail_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/pickboundingvolumeutils_p.h>
+#include <Qt3DRender/private/sphere_p.h>
+#include <Qt3DRender/private/transform_p.h>
+#include <Qt3DRender/private/updatelevelofdetailjob_p.h>
+#include <Qt3DRender/private/updateworldtransformjob_p.h>
+
+#include "testaspect.h"
+
+namespace {
+
+// Mirrors the evaluation UpdateLevelOfDetailJob performed for each LOD before
+// the LODs were gathered and evaluated in batches. The rolling average is kept
+// per LOD, as the job now does.
+struct ReferenceLod
+{
+    double filterValue = 0.;
+    int currentIndex = 0;
+
+    void evaluate(Qt3DRender::Render::NodeManagers *managers,
+                  Qt3DRender::Render::FrameGraphNode *frameGraphRoot,
+                  Qt3DRender::Render::Entity *entity,
+                  Qt3DRender::Render::LevelOfDetail *lod)
+    {
+        using namespace Qt3DRender;
+        using namespace Qt3DRender::Render;
+
+        Matrix4x4 viewMatrix;
+        Matrix4x4 projectionMatrix;
+        if (!CameraLens::viewMatrixForCamera(managers->renderNodesManager(), lod->camera(), viewMatrix, projectionMatrix))
+            return;
+
+        const QList<qreal> thresholds = lod->thresholds();
+        const int n = thresholds.size();
+        float metric = 0.0f;
+
+        if (lod->thresholdType() == QLevelOfDetail::DistanceToCameraThreshold) {
+            Vector3D center(lod->center());
+            if (lod->hasBoundingVolumeOverride() || entity->worldBoundingVolume() == nullptr)
+                center = *entity->worldTransform() * center;
+            else
+                center = entity->worldBoundingVolume()->center();
+            metric = (viewMatrix * center).length();
+        } else {
+            PickingUtils::ViewportCameraAreaGatherer vcaGatherer(lod->camera());
+            const std::vector<PickingUtils::ViewportCameraAreaDetails> &vcaTriplets = vcaGatherer.gather(frameGraphRoot);
+            if (vcaTriplets.empty())
+                return;
+            const PickingUtils::ViewportCameraAreaDetails &vca = vcaTriplets.front();
+
+            Sphere bv(Vector3D(lod->center()), lod->radius());
+            if (!lod->hasBoundingVolumeOverride() && entity->worldBoundingVolume() != nullptr)
+                bv = *(entity->worldBoundingVolume());
+            else
+                bv.transform(*entity->worldTransform());
+            bv.transform(projectionMatrix * viewMatrix);
+            const float sideLength = bv.radius() * 2.f;
+            const float area = vca.viewport.width() * sideLength * vca.viewport.height() * sideLength;
+            const QRect r = vca.viewport.toRect();
+            metric = std::sqrt(area * r.width() * r.height());
+        }
+
+        for (int i = 0; i < n; ++i) {
+            const bool selected = lod->thresholdType() == QLevelOfDetail::DistanceToCameraThreshold
+                    ? metric <= thresholds[i]
+                    : thresholds[i] < metric;
+            if (selected || i == n - 1) {
+                filterValue -= filterValue / 30;
+                filterValue += double(i) / 30;
+                currentIndex = qBound(0, static_cast<int>(qRound(filterValue)), n - 1);
+                break;
+            }
+        }
+    }
+};
+
+struct TestScene
+{
+    Qt3DCore::QEntity *root;
+    Qt3DRender::QCamera *camera;
+    Qt3DRender::QViewport *viewport;
+    QList<Qt3DCore::QTransform *> transforms;
+    QList<Qt3DRender::QLevelOfDetail *> lods;
+};
+
+TestScene buildScene(const QList<float> &distances,
+                     const QList<qreal> &thresholds,
+                     Qt3DRender::QLevelOfDetail::ThresholdType thresholdType)
+{
+    TestScene scene;
+    scene.root = new Qt3DCore::QEntity();
+
+    scene.camera = new Qt3DRender::QCamera(scene.root);
+    scene.camera->setPosition(QVector3D(0.0f, 0.0f, 0.0f));
+    scene.camera->setViewCenter(QVector3D(0.0f, 0.0f, -1.0f));
+    scene.camera->setUpVector(QVector3D(0.0f, 1.0f, 0.0f));
+
+    scene.viewport = new Qt3DRender::QViewport(scene.root);
+    auto cameraSelector = new Qt3DRender::QCameraSelector(scene.viewport);
+    cameraSelector->setCamera(scene.camera);
+
+    for (float distance : distances) {
+        auto entity = new Qt3DCore::QEntity(scene.root);
+
+        auto transform = new Qt3DCore::QTransform(entity);
+        transform->setTranslation(QVector3D(0.0f, 0.0f, -distance));
+        entity->addComponent(transform);
+
+        auto lod = new Qt3DRender::QLevelOfDetail(entity);
+        lod->setCamera(scene.camera);
+        lod->setThresholdType(thresholdType);
+        lod->setThresholds(thresholds);
+        lod->setVolumeOverride(Qt3DRender::QLevelOfDetailBoundingSphere(QVector3D(), 1.0f));
+        entity->addComponent(lod);
+
+        scene.transforms.push_back(transform);
+        scene.lods.push_back(lod);
+    }
+
+    return scene;
+}
+
+} // anonymous
+
+class tst_UpdateLevelOfDetailJob : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+
+    void checkSameIndicesAsPerLodEvaluation_data()
+    {
+        QTest::addColumn<QList<float>>("distances");
+        QTest::addColumn<QList<qreal>>("thresholds");
+        QTest::addColumn<int>("thresholdType");
+
+        // Values right on the thresholds, including ones that can't be
+        // represented exactly as floats
+        const QList<qreal> thresholds = { 10.1, 20.0, 30.0 };
+        const QList<float> edges = { 0.5f, 10.1f, 10.2f, 20.0f, 20.01f, 30.0f, 30.5f, 45.0f };
+
+        QTest::newRow("distance-serial")
+                << edges << thresholds << int(Qt3DRender::QLevelOfDetail::DistanceToCameraThreshold);
+
+        // Enough LODs for the metrics to be computed in parallel
+        QList<float> distances;
+        for (int i = 0; i < 300; ++i)
+            distances.push_back(i % 3 == 0 ? edges.at(i % edges.size()) : float(i) * 0.15f);
+        QTest::newRow("distance-parallel")
+                << distances << thresholds << int(Qt3DRender::QLevelOfDetail::DistanceToCameraThreshold);
+
+        QTest::newRow("projected-size-serial")
+                << edges << QList<qreal>({ 1.0, 0.2, 0.05 }) << int(Qt3DRender::QLevelOfDetail::ProjectedScreenPixelSizeThreshold);
+        QTest::newRow("projected-size-parallel")
+                << distances << QList<qreal>({ 1.0, 0.2, 0.05 }) << int(Qt3DRender::QLevelOfDetail::ProjectedScreenPixelSizeThreshold);
+    }
+
+    void checkSameIndicesAsPerLodEvaluation()
+    {
+        QFETCH(QList<float>, distances);
+        QFETCH(QList<qreal>, thresholds);
+        QFETCH(int, thresholdType);
+
+        // GIVEN
+        TestScene scene = buildScene(distances, thresholds,
+                                     static_cast<Qt3DRender::QLevelOfDetail::ThresholdType>(thresholdType));
+        QScopedPointer<Qt3DCore::QEntity> root(scene.root);
+        QScopedPointer<Qt3DRender::TestAspect> aspect(new Qt3DRender::TestAspect(scene.root));
+        Qt3DRender::Render::NodeManagers *managers = aspect->nodeManagers();
+        Qt3DRender::Render::Entity *backendRoot = managers->renderNodesManager()->lookupResource(scene.root->id());
+        Qt3DRender::Render::FrameGraphNode *frameGraphRoot = managers->frameGraphManager()->lookupNode(scene.viewport->id());
+        QVERIFY(backendRoot);
+        QVERIFY(frameGraphRoot);
+
+        Qt3DRender::Render::UpdateWorldTransformJob updateWorldTransform;
+        updateWorldTransform.setRoot(backendRoot);
+        updateWorldTransform.setManagers(managers);
+        updateWorldTransform.run();
+
+        Qt3DRender::Render::UpdateLevelOfDetailJob updateLevelOfDetail;
+        updateLevelOfDetail.setRoot(backendRoot);
+        updateLevelOfDetail.setManagers(managers);
+        updateLevelOfDetail.setFrameGraphRoot(frameGraphRoot);
+
+        QList<ReferenceLod> references(scene.lods.size());
+
+        // WHEN
+        // Long enough for the rolling average of every LOD to settle
+        for (int frame = 0; frame < 120; ++frame) {
+            updateLevelOfDetail.run();
+
+            // THEN
+            for (int i = 0, m = scene.lods.size(); i < m; ++i) {
+                Qt3DRender::Render::LevelOfDetail *lod = managers->levelOfDetailManager()->lookupResource(scene.lods.at(i)->id());
+                Qt3DRender::Render::Entity *entity = managers->renderNodesManager()->lookupResource(scene.lods.at(i)->parentNode()->id());
+                references[i].evaluate(managers, frameGraphRoot, entity, lod);
+                QCOMPARE(lod->currentIndex(), references.at(i).currentIndex);
+            }
+        }
+
+    }
+
+    void checkIndexChangesAreFilteredPerLod()
+    {
+        // GIVEN
+        TestScene scene = buildScene({ 15.0f, 5.0f }, { 10.0, 20.0 },
+                                     Qt3DRender::QLevelOfDetail::DistanceToCameraThreshold);
+        QScopedPointer<Qt3DCore::QEntity> root(scene.root);
+        QScopedPointer<Qt3DRender::TestAspect> aspect(new Qt3DRender::TestAspect(scene.root));
+        Qt3DRender::Render::NodeManagers *managers = aspect->nodeManagers();
+        Qt3DRender::Render::Entity *backendRoot = managers->renderNodesManager()->lookupResource(scene.root->id());
+        Qt3DRender::Render::FrameGraphNode *frameGraphRoot = managers->frameGraphManager()->lookupNode(scene.viewport->id());
+        Qt3DRender::Render::LevelOfDetail *farLod = managers->levelOfDetailManager()->lookupResource(scene.lods.at(0)->id());
+        Qt3DRender::Render::LevelOfDetail *nearLod = managers->levelOfDetailManager()->lookupResource(scene.lods.at(1)->id());
+
+        Qt3DRender::Render::UpdateWorldTransformJob updateWorldTransform;
+        updateWorldTransform.setRoot(backendRoot);
+        updateWorldTransform.setManagers(managers);
+        updateWorldTransform.run();
+
+        Qt3DRender::Render::UpdateLevelOfDetailJob updateLevelOfDetail;
+        updateLevelOfDetail.setRoot(backendRoot);
+        updateLevelOfDetail.setManagers(managers);
+        updateLevelOfDetail.setFrameGraphRoot(frameGraphRoot);
+
+        // WHEN
+        // The filter value after k frames is 1 - (29/30)^k, which
+        // first rounds to 1 after 21 frames
+        for (int frame = 1; frame <= 20; ++frame) {
+            updateLevelOfDetail.run();
+
+            // THEN
+            QCOMPARE(farLod->currentIndex(), 0);
+        }
+
+        // WHEN
+        updateLevelOfDetail.run();
+
+        // THEN
+        QCOMPARE(farLod->currentIndex(), 1);
+        // The near LOD is not dragged along by the far one
+        QCOMPARE(nearLod->currentIndex(), 0);
+        QCOMPARE(nearLod->filterValue(), 0.);
+
+        // WHEN
+        // Moving back below the threshold, the filter value decays from
+        // just above 0.5 and the index switches back on the next frame
+        scene.transforms.at(0)->setTranslation(QVector3D(0.0f, 0.0f, -5.0f));
+        Qt3DRender::Render::Transform *backendTransform = managers->transformManager()->lookupResource(scene.transforms.at(0)->id());
+        backendTransform->syncFromFrontEnd(scene.transforms.at(0), false);
+        updateWorldTransform.run();
+        updateLevelOfDetail.run();
+
+        // THEN
+        QCOMPARE(farLod->currentIndex(), 0);
+
+    }
+};
+
+QTEST_MAIN(tst_UpdateLevelOfDetailJob)
+
+#include "tst_updatelevelofdetailjob.moc"
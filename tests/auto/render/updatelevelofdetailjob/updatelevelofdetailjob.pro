@@ -0,0 +1,13 @@
+TEMPLATE = app
+
+TARGET = tst_updatelevelofdetailjob
+
+QT += core-private 3dcore 3dcore-private 3drender 3drender-private testlib
+
+CONFIG += testcase
+
+SOURCES += tst_updatelevelofdetailjob.cpp
+
+CONFIG += useCommonTestAspect
+
+include(../commons/commons.pri)
@@ -0,0 +1,134 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DCore/qtransform.h>
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/transform_p.h>
+#include <Qt3DRender/private/updateworldtransformjob_p.h>
+
+#include "testaspect.h"
+
+namespace {
+
+// The job accumulates the updates until they are written back to the
+// frontend, only return the ones added by this run
+QList<Qt3DCore::QNodeId> runAndGatherUpdates(Qt3DRender::Render::UpdateWorldTransformJob &job)
+{
+    const int alreadyPending = job.pendingWorldMatrixUpdates().size();
+    job.run();
+    return job.pendingWorldMatrixUpdates().mid(alreadyPending);
+}
+
+void syncBackend(Qt3DRender::Render::NodeManagers *managers, Qt3DCore::QTransform *transform)
+{
+    Qt3DRender::Render::Transform *backendTransform = managers->transformManager()->lookupResource(transform->id());
+    QVERIFY(backendTransform);
+    backendTransform->syncFromFrontEnd(transform, false);
+}
+
+} // anonymous
+
+class tst_UpdateWorldTransformJob : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+
+    void checkWorldMatricesAreRefreshedWhenUpdatesAreEnabledAgain()
+    {
+        // GIVEN
+        QScopedPointer<Qt3DCore::QEntity> root(new Qt3DCore::QEntity());
+        auto rootTransform = new Qt3DCore::QTransform(root.data());
+        rootTransform->setTranslation(QVector3D(1.0f, 0.0f, 0.0f));
+        root->addComponent(rootTransform);
+
+        auto child = new Qt3DCore::QEntity(root.data());
+        auto childTransform = new Qt3DCore::QTransform(child);
+        childTransform->setTranslation(QVector3D(0.0f, 2.0f, 0.0f));
+        child->addComponent(childTransform);
+
+        QScopedPointer<Qt3DRender::TestAspect> aspect(new Qt3DRender::TestAspect(root.data()));
+        Qt3DRender::Render::NodeManagers *managers = aspect->nodeManagers();
+        Qt3DRender::Render::Entity *backendRoot = managers->renderNodesManager()->lookupResource(root->id());
+        Qt3DRender::Render::Entity *backendChild = managers->renderNodesManager()->lookupResource(child->id());
+        QVERIFY(backendRoot);
+        QVERIFY(backendChild);
+
+        Qt3DRender::Render::UpdateWorldTransformJob updateWorldTransform;
+        updateWorldTransform.setRoot(backendRoot);
+        updateWorldTransform.setManagers(managers);
+
+        // WHEN
+        QList<Qt3DCore::QNodeId> updates = runAndGatherUpdates(updateWorldTransform);
+
+        // THEN
+        QCOMPARE(updates.size(), 2);
+        QVERIFY(updates.contains(rootTransform->id()));
+        QVERIFY(updates.contains(childTransform->id()));
+
+        // WHEN
+        updates = runAndGatherUpdates(updateWorldTransform);
+
+        // THEN -> nothing changed, nothing to write back
+        QVERIFY(updates.isEmpty());
+
+        // WHEN
+        rootTransform->setWorldMatrixUpdatesEnabled(false);
+        rootTransform->setTranslation(QVector3D(5.0f, 0.0f, 0.0f));
+        syncBackend(managers, rootTransform);
+        updates = runAndGatherUpdates(updateWorldTransform);
+
+        // THEN -> the subtree opted out of the write back
+        QVERIFY(updates.isEmpty());
+        QCOMPARE((*backendChild->worldTransform() * Qt3DCore::Vector3D()).toQVector3D(), QVector3D(5.0f, 2.0f, 0.0f));
+
+        // WHEN
+        rootTransform->setWorldMatrixUpdatesEnabled(true);
+        syncBackend(managers, rootTransform);
+        updates = runAndGatherUpdates(updateWorldTransform);
+
+        // THEN -> the world transforms didn't change but the frontend ones are stale
+        QCOMPARE(updates.size(), 2);
+        QVERIFY(updates.contains(rootTransform->id()));
+        QVERIFY(updates.contains(childTransform->id()));
+
+        // WHEN
+        updates = runAndGatherUpdates(updateWorldTransform);
+
+        // THEN -> refreshed only once
+        QVERIFY(updates.isEmpty());
+    }
+};
+
+QTEST_MAIN(tst_UpdateWorldTransformJob)
+
+#include "tst_updateworldtransformjob.moc"
@@ -0,0 +1,190 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <QtGui/QVector2D>
+#include <QtGui/QVector3D>
+#include <QtGui/QVector4D>
+#include <Qt3DRender/private/vertexattributegenerators_p.h>
+
+#include <cmath>
+
+using namespace Qt3DRender;
+
+namespace {
+
+struct Mesh
+{
+    QList<QVector3D> positions;
+    QList<QVector2D> texCoords;
+    QList<unsigned int> indices;
+};
+
+// A bumpy grid, large enough to be processed by several threads
+Mesh gridMesh(int size)
+{
+    Mesh mesh;
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            mesh.positions.append(QVector3D(x, y, std::sin(x * 0.3f) * std::cos(y * 0.2f)));
+            mesh.texCoords.append(QVector2D(float(x) / size, float(y) / size));
+        }
+    }
+    for (int y = 0; y < size - 1; ++y) {
+        for (int x = 0; x < size - 1; ++x) {
+            const unsigned int i = y * size + x;
+            mesh.indices << i << i + 1 << i + size + 1;
+            mesh.indices << i << i + size + 1 << i + size;
+        }
+    }
+    return mesh;
+}
+
+// Single threaded reference accumulating per vertex in index order
+QList<QVector3D> referenceNormals(const Mesh &mesh)
+{
+    QList<QVector3D> normals(mesh.positions.size());
+    for (int i = 0; i < mesh.indices.size(); i += 3) {
+        const QVector3D &p1 = mesh.positions[mesh.indices[i]];
+        const QVector3D &p2 = mesh.positions[mesh.indices[i + 1]];
+        const QVector3D &p3 = mesh.positions[mesh.indices[i + 2]];
+        const QVector3D n = QVector3D::crossProduct(p2 - p1, p3 - p1).normalized();
+        normals[mesh.indices[i]] += n;
+        normals[mesh.indices[i + 1]] += n;
+        normals[mesh.indices[i + 2]] += n;
+    }
+    for (QVector3D &normal : normals)
+        normal.normalize();
+    return normals;
+}
+
+QList<QVector3D> generateNormals(const Mesh &mesh)
+{
+    QList<QVector3D> normals(mesh.positions.size());
+    VertexAttributeGenerators::generateAveragedNormals(reinterpret_cast<const float *>(mesh.positions.constData()), 3,
+                                                       mesh.positions.size(),
+                                                       mesh.indices.constData(), mesh.indices.size(),
+                                                       reinterpret_cast<float *>(normals.data()), 3);
+    return normals;
+}
+
+QList<QVector4D> generateTangents(const Mesh &mesh, const QList<QVector3D> &normals)
+{
+    QList<QVector4D> tangents(mesh.positions.size());
+    VertexAttributeGenerators::generateTangents(reinterpret_cast<const float *>(mesh.positions.constData()), 3,
+                                                reinterpret_cast<const float *>(normals.constData()), 3,
+                                                reinterpret_cast<const float *>(mesh.texCoords.constData()), 2,
+                                                mesh.positions.size(),
+                                                mesh.indices.constData(), mesh.indices.size(),
+                                                reinterpret_cast<float *>(tangents.data()), 4);
+    return tangents;
+}
+
+} // anonymous
+
+class tst_VertexAttributeGenerators : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void checkQuad()
+    {
+        // GIVEN
+        const Mesh quad = { { QVector3D(0, 0, 0), QVector3D(1, 0, 0), QVector3D(1, 1, 0), QVector3D(0, 1, 0) },
+                            { QVector2D(0, 0), QVector2D(1, 0), QVector2D(1, 1), QVector2D(0, 1) },
+                            { 0, 1, 2, 0, 2, 3 } };
+
+        // WHEN
+        const QList<QVector3D> normals = generateNormals(quad);
+        const QList<QVector4D> tangents = generateTangents(quad, normals);
+
+        // THEN
+        for (int i = 0; i < 4; ++i) {
+            QCOMPARE(normals.at(i), QVector3D(0, 0, 1));
+            QCOMPARE(tangents.at(i), QVector4D(1, 0, 0, 1));
+        }
+    }
+
+    void checkInterleavedBuffer()
+    {
+        // GIVEN a position, normal vertex layout
+        const float vertices[] = { 0, 0, 0,  9, 9, 9,
+                                   0, 1, 0,  9, 9, 9,
+                                   0, 0, 1,  9, 9, 9 };
+        const unsigned int indices[] = { 0, 1, 2 };
+        float normals[sizeof(vertices) / sizeof(float)];
+        std::copy(std::begin(vertices), std::end(vertices), std::begin(normals));
+
+        // WHEN
+        VertexAttributeGenerators::generateAveragedNormals(vertices, 6, 3, indices, 3, normals + 3, 6);
+
+        // THEN
+        for (int i = 0; i < 3; ++i) {
+            QCOMPARE(QVector3D(normals[i * 6], normals[i * 6 + 1], normals[i * 6 + 2]),
+                     QVector3D(vertices[i * 6], vertices[i * 6 + 1], vertices[i * 6 + 2]));
+            QCOMPARE(QVector3D(normals[i * 6 + 3], normals[i * 6 + 4], normals[i * 6 + 5]), QVector3D(1, 0, 0));
+        }
+    }
+
+    void checkOutOfRangeIndicesAreIgnored()
+    {
+        // GIVEN
+        const Mesh mesh = { { QVector3D(0, 0, 0), QVector3D(1, 0, 0), QVector3D(0, 1, 0) },
+                            {},
+                            { 0, 1, 2, 0, 2, 3 } };
+
+        // WHEN
+        const QList<QVector3D> normals = generateNormals(mesh);
+
+        // THEN
+        for (const QVector3D &normal : normals)
+            QCOMPARE(normal, QVector3D(0, 0, 1));
+    }
+
+    void checkLargeMeshMatchesSequentialResult()
+    {
+        // GIVEN
+        const Mesh mesh = gridMesh(300);
+
+        // WHEN
+        const QList<QVector3D> normals = generateNormals(mesh);
+        const QList<QVector4D> tangents = generateTangents(mesh, normals);
+
+        // THEN results are the same bit for bit
+        QCOMPARE(normals, referenceNormals(mesh));
+        QCOMPARE(generateNormals(mesh), normals);
+        QCOMPARE(generateTangents(mesh, normals), tangents);
+        for (const QVector4D &tangent : tangents)
+            QVERIFY(tangent.w() == 1.0f || tangent.w() == -1.0f);
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_VertexAttributeGenerators)
+
+#include "tst_vertexattributegenerators.moc"
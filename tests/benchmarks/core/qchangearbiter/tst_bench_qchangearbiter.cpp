@@ -0,0 +1,126 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DCore/qtransform.h>
+#include <Qt3DCore/private/qchangearbiter_p.h>
+#include <Qt3DCore/private/qnode_p.h>
+
+class tst_QChangeArbiter : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkMarkDirty_data();
+    void benchmarkMarkDirty();
+    void benchmarkPropertyUpdates_data();
+    void benchmarkPropertyUpdates();
+};
+
+namespace {
+
+void setArbiterOnNode(Qt3DCore::QNode *node, Qt3DCore::QChangeArbiter *arbiter)
+{
+    Qt3DCore::QNodePrivate::get(node)->setArbiter(arbiter);
+    const auto childNodes = node->childNodes();
+    for (Qt3DCore::QNode *n : childNodes)
+        setArbiterOnNode(n, arbiter);
+}
+
+void addNodeCountRows()
+{
+    QTest::addColumn<int>("nodeCount");
+
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+    QTest::newRow("20000") << 20000;
+}
+
+} // anonymous
+
+void tst_QChangeArbiter::benchmarkMarkDirty_data()
+{
+    addNodeCountRows();
+}
+
+void tst_QChangeArbiter::benchmarkMarkDirty()
+{
+    QFETCH(int, nodeCount);
+
+    Qt3DCore::QChangeArbiter arbiter;
+    Qt3DCore::QEntity root;
+    QList<Qt3DCore::QNode *> nodes;
+    for (int i = 0; i < nodeCount; ++i)
+        nodes.push_back(new Qt3DCore::QEntity(&root));
+    setArbiterOnNode(&root, &arbiter);
+
+    QBENCHMARK {
+        // Marking a node twice per frame must not add it twice
+        for (Qt3DCore::QNode *node : qAsConst(nodes))
+            arbiter.addDirtyFrontEndNode(node);
+        for (Qt3DCore::QNode *node : qAsConst(nodes))
+            arbiter.addDirtyFrontEndNode(node);
+        QCOMPARE(int(arbiter.takeDirtyFrontEndNodes().size()), nodeCount);
+    }
+}
+
+void tst_QChangeArbiter::benchmarkPropertyUpdates_data()
+{
+    addNodeCountRows();
+}
+
+void tst_QChangeArbiter::benchmarkPropertyUpdates()
+{
+    QFETCH(int, nodeCount);
+
+    Qt3DCore::QChangeArbiter arbiter;
+    Qt3DCore::QEntity root;
+    QList<Qt3DCore::QTransform *> transforms;
+    for (int i = 0; i < nodeCount; ++i) {
+        auto *entity = new Qt3DCore::QEntity(&root);
+        auto *transform = new Qt3DCore::QTransform(entity);
+        entity->addComponent(transform);
+        transforms.push_back(transform);
+    }
+    setArbiterOnNode(&root, &arbiter);
+
+    float offset = 0.0f;
+    QBENCHMARK {
+        // Mimics a data driven scene updating every transform each frame
+        offset += 1.0f;
+        for (Qt3DCore::QTransform *transform : qAsConst(transforms)) {
+            transform->setTranslation(QVector3D(offset, 0.0f, 0.0f));
+            transform->setScale(offset);
+        }
+        arbiter.takeDirtyFrontEndNodes();
+    }
+}
+
+QTEST_MAIN(tst_QChangeArbiter)
+
+#include "tst_bench_qchangearbiter.moc"
@@ -0,0 +1,7 @@
+TARGET = tst_bench_frames
+
+TEMPLATE = app
+
+QT += testlib core gui 3dcore 3dcore-private 3drender 3drender-private 3dextras
+
+SOURCES += tst_bench_frames.cpp
@@ -0,0 +1,300 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QtTest/QtTest>
+#include <QtGui/QWindow>
+#include <Qt3DCore/QAspectEngine>
+#include <Qt3DCore/QEntity>
+#include <Qt3DCore/QTransform>
+#include <Qt3DRender/QCamera>
+#include <Qt3DRender/QPointLight>
+#include <Qt3DRender/QRenderAspect>
+#include <Qt3DRender/QRenderSettings>
+#include <Qt3DExtras/QForwardRenderer>
+#include <Qt3DExtras/QPhongMaterial>
+#include <Qt3DExtras/QSphereMesh>
+
+#include <Qt3DCore/private/qaspectengine_p.h>
+#include <Qt3DCore/private/qaspectmanager_p.h>
+#include <Qt3DCore/private/qservicelocator_p.h>
+#include <Qt3DCore/private/qsysteminformationservice_p.h>
+#include <Qt3DCore/private/qsysteminformationservice_p_p.h>
+#include <Qt3DRender/private/job_common_p.h>
+
+#include <limits>
+
+// Runs complete frames of synthetic scenes through the aspect engine, using
+// the RHI renderer on the Null QRhi backend so that no GPU is needed. The
+// per job and per phase timings are gathered by the system information service.
+
+struct SceneConfig
+{
+    int entities;
+    int materials;
+    int lights;
+    int depth;
+    int animatedPercent;
+};
+
+struct SceneContent
+{
+    Qt3DCore::QEntity *root = nullptr;
+    QList<Qt3DCore::QTransform *> animatedTransforms;
+};
+
+SceneContent buildScene(const SceneConfig &config, QWindow *surface)
+{
+    SceneContent scene;
+    Qt3DCore::QEntity *root = new Qt3DCore::QEntity();
+    scene.root = root;
+
+    // Camera
+    Qt3DRender::QCamera *camera = new Qt3DRender::QCamera(root);
+    camera->lens()->setPerspectiveProjection(45.0f, 16.0f/9.0f, 0.1f, 1000.0f);
+    camera->setPosition(QVector3D(0.0f, 0.0f, 250.0f));
+    camera->setUpVector(QVector3D(0.0f, 1.0f, 0.0f));
+    camera->setViewCenter(QVector3D(0.0f, 0.0f, 0.0f));
+
+    // FrameGraph
+    Qt3DRender::QRenderSettings *renderSettings = new Qt3DRender::QRenderSettings();
+    Qt3DExtras::QForwardRenderer *forwardRenderer = new Qt3DExtras::QForwardRenderer();
+    forwardRenderer->setCamera(camera);
+    forwardRenderer->setSurface(surface);
+    forwardRenderer->setClearColor(Qt::black);
+    renderSettings->setActiveFrameGraph(forwardRenderer);
+    root->addComponent(renderSettings);
+
+    // Lights
+    for (int i = 0; i < config.lights; ++i) {
+        Qt3DCore::QEntity *lightEntity = new Qt3DCore::QEntity(root);
+        Qt3DRender::QPointLight *light = new Qt3DRender::QPointLight();
+        Qt3DCore::QTransform *lightTransform = new Qt3DCore::QTransform();
+        const float angle = float(M_PI) * 2.0f * i / config.lights;
+        lightTransform->setTranslation(QVector3D(150.0f * qCos(angle), 50.0f, 150.0f * qSin(angle)));
+        lightEntity->addComponent(light);
+        lightEntity->addComponent(lightTransform);
+    }
+
+    // Shared resources
+    Qt3DExtras::QSphereMesh *mesh = new Qt3DExtras::QSphereMesh(root);
+    mesh->setRadius(1.5f);
+
+    QList<Qt3DExtras::QPhongMaterial *> materials;
+    for (int i = 0; i < config.materials; ++i) {
+        Qt3DExtras::QPhongMaterial *material = new Qt3DExtras::QPhongMaterial(root);
+        material->setDiffuse(QColor::fromHsv((i * 360) / config.materials, 200, 200));
+        materials.push_back(material);
+    }
+
+    // Entities are laid out as chains of config.depth nodes under the root
+    const int animatedCount = (config.entities * config.animatedPercent) / 100;
+    const float radius = 100.0f;
+    Qt3DCore::QEntity *parent = root;
+    for (int i = 0; i < config.entities; ++i) {
+        if (i % config.depth == 0)
+            parent = root;
+
+        Qt3DCore::QEntity *e = new Qt3DCore::QEntity(parent);
+        Qt3DCore::QTransform *transform = new Qt3DCore::QTransform();
+        const float angle = float(M_PI) * 2.0f * i / config.entities;
+        if (parent == root)
+            transform->setTranslation(QVector3D(radius * qCos(angle), radius * qSin(angle), 0.0f));
+        else
+            transform->setTranslation(QVector3D(0.0f, 0.0f, -2.0f));
+
+        e->addComponent(transform);
+        e->addComponent(mesh);
+        e->addComponent(materials.at(i % materials.size()));
+
+        if (i < animatedCount)
+            scene.animatedTransforms.push_back(transform);
+        parent = e;
+    }
+
+    return scene;
+}
+
+class FrameStatsCollector
+{
+public:
+    using JobRunStats = Qt3DCore::QSystemInformationServicePrivate::JobRunStats;
+
+    explicit FrameStatsCollector(Qt3DCore::QSystemInformationServicePrivate *service)
+        : m_service(service)
+    {
+        m_service->m_frameStatsHandler = [this] (quint32,
+                                                 const QList<JobRunStats> &jobStats,
+                                                 const QList<JobRunStats> &submissionStats) {
+            collect(jobStats, submissionStats);
+        };
+    }
+
+    ~FrameStatsCollector()
+    {
+        m_service->m_frameStatsHandler = nullptr;
+    }
+
+    void reset()
+    {
+        m_frameCount = 0;
+        m_jobsPhaseTime = 0;
+        m_jobTimes.clear();
+        m_submissionTimes.clear();
+    }
+
+    void report() const
+    {
+        if (m_frameCount == 0)
+            return;
+
+        const auto average = [this] (qint64 nsecs) {
+            return QString::number(double(nsecs) / (m_frameCount * 1000000.0), 'f', 3);
+        };
+
+        qInfo().noquote() << "Frames:" << m_frameCount;
+        qInfo().noquote() << "Phase Jobs:" << average(m_jobsPhaseTime) << "ms/frame";
+        for (auto it = m_submissionTimes.cbegin(), end = m_submissionTimes.cend(); it != end; ++it) {
+            const QString name = it.key() == Qt3DRender::Render::JobTypes::FrameSubmissionPart1
+                    ? QStringLiteral("FrameSubmissionPart1")
+                    : it.key() == Qt3DRender::Render::JobTypes::FrameSubmissionPart2
+                      ? QStringLiteral("FrameSubmissionPart2")
+                      : m_service->jobTypeName(it.key());
+            qInfo().noquote() << "Phase" << name + QLatin1Char(':') << average(it.value()) << "ms/frame";
+        }
+        for (auto it = m_jobTimes.cbegin(), end = m_jobTimes.cend(); it != end; ++it)
+            qInfo().noquote() << "Job" << m_service->jobTypeName(it.key()) + QLatin1Char(':')
+                              << average(it.value()) << "ms/frame";
+    }
+
+private:
+    void collect(const QList<JobRunStats> &jobStats, const QList<JobRunStats> &submissionStats)
+    {
+        if (jobStats.isEmpty() && submissionStats.isEmpty())
+            return;
+
+        ++m_frameCount;
+
+        // The jobs phase spans from the first job started to the last one finished
+        qint64 firstStart = std::numeric_limits<qint64>::max();
+        qint64 lastEnd = 0;
+        for (const JobRunStats &stats : jobStats) {
+            m_jobTimes[stats.jobId.typeAndInstance[0]] += stats.endTime - stats.startTime;
+            firstStart = std::min(firstStart, stats.startTime);
+            lastEnd = std::max(lastEnd, stats.endTime);
+        }
+        if (lastEnd > firstStart)
+            m_jobsPhaseTime += lastEnd - firstStart;
+
+        for (const JobRunStats &stats : submissionStats)
+            m_submissionTimes[stats.jobId.typeAndInstance[0]] += stats.endTime - stats.startTime;
+    }
+
+    Qt3DCore::QSystemInformationServicePrivate *m_service;
+    int m_frameCount = 0;
+    qint64 m_jobsPhaseTime = 0;
+    QMap<quint32, qint64> m_jobTimes;
+    QMap<quint32, qint64> m_submissionTimes;
+};
+
+Q_DECLARE_METATYPE(SceneConfig)
+
+class tst_benchFrames : public QObject
+{
+    Q_OBJECT
+
+public:
+    static void initMain()
+    {
+        // No GPU nor windowing system is needed for the CPU side of the pipeline
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+        qputenv("QT3D_RENDERER", "rhi");
+        qputenv("QT3D_RHI_DEFAULT_API", "null");
+    }
+
+private Q_SLOTS:
+
+    void processFrame_data()
+    {
+        QTest::addColumn<SceneConfig>("config");
+        QTest::addColumn<bool>("pipelined");
+
+        QTest::newRow("static-1000") << SceneConfig{1000, 10, 1, 1, 0} << false;
+        QTest::newRow("animated-1000") << SceneConfig{1000, 10, 1, 1, 100} << false;
+        QTest::newRow("deep-1000") << SceneConfig{1000, 10, 1, 10, 10} << false;
+        QTest::newRow("lights-1000") << SceneConfig{1000, 10, 8, 1, 10} << false;
+        QTest::newRow("materials-1000") << SceneConfig{1000, 500, 1, 1, 10} << false;
+        QTest::newRow("animated-10000") << SceneConfig{10000, 50, 4, 5, 10} << false;
+        QTest::newRow("animated-10000-pipelined") << SceneConfig{10000, 50, 4, 5, 10} << true;
+    }
+
+    void processFrame()
+    {
+        // GIVEN
+        QFETCH(SceneConfig, config);
+        QFETCH(bool, pipelined);
+
+        QWindow surface;
+        surface.resize(1024, 768);
+        surface.create();
+
+        QScopedPointer<Qt3DCore::QAspectEngine> engine(new Qt3DCore::QAspectEngine());
+        engine->setRunMode(Qt3DCore::QAspectEngine::Manual);
+        Qt3DRender::QRenderAspect *renderAspect = new Qt3DRender::QRenderAspect(Qt3DRender::QRenderAspect::Automatic);
+        renderAspect->setPipelinedRenderingEnabled(pipelined);
+        engine->registerAspect(renderAspect);
+
+        Qt3DCore::QSystemInformationService *service =
+                Qt3DCore::QAspectEnginePrivate::get(engine.data())->m_aspectManager->serviceLocator()->systemInformation();
+        service->setTraceEnabled(true);
+        FrameStatsCollector collector(Qt3DCore::QSystemInformationServicePrivate::get(service));
+
+        const SceneContent scene = buildScene(config, &surface);
+        engine->setRootEntity(Qt3DCore::QEntityPtr(scene.root));
+
+        // Warm up: backend creation, shader and geometry loading
+        for (int i = 0; i < 10; ++i)
+            engine->processFrame();
+        collector.reset();
+
+        // WHEN
+        int frame = 0;
+        QBENCHMARK {
+            const float angle = float(++frame);
+            for (Qt3DCore::QTransform *transform : scene.animatedTransforms)
+                transform->setRotationY(angle);
+            engine->processFrame();
+        }
+
+        // THEN
+        collector.report();
+        service->setTraceEnabled(false);
+    }
+};
+
+QTEST_MAIN(tst_benchFrames)
+
+#include "tst_bench_frames.moc"
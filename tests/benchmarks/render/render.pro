@@ -1,7 +1,8 @@
 TEMPLATE=subdirs
 
 qtConfig(private_tests) {
-    SUBDIRS += jobs \
+    SUBDIRS += frames \
+               jobs \
                layerfiltering \
                materialparametergathering \
                opengl